@@ -276,3 +276,36 @@ int CBSDSocketInterface::receiveDataFromUDP(TSocketDescriptor pa_nSockD, char* p
   }
   return nRetVal;
 }
+
+#ifdef FORTE_COM_ETH_UDP_BATCHING
+int CBSDSocketInterface::sendBatchOnUDP(TSocketDescriptor pa_nSockD, struct mmsghdr *pa_pstMessages, unsigned int pa_unNumMessages){
+  unsigned int unSent = 0;
+  while(unSent < pa_unNumMessages){
+    // sendmmsg stops at the first message that could not be sent, so the remaining ones are retried
+    int nRetVal = sendmmsg(pa_nSockD, &pa_pstMessages[unSent], pa_unNumMessages - unSent, 0);
+    if(0 < nRetVal){
+      unSent += static_cast<unsigned int>(nRetVal);
+    }
+    else if((-1 == nRetVal) && (EINTR == errno)){
+      continue;
+    }
+    else{
+      DEVLOG_ERROR("CBSDSocketInterface: UDP-Socket sendmmsg() failed: %s\n", strerror(errno));
+      break;
+    }
+  }
+  return (0 == unSent) ? -1 : static_cast<int>(unSent);
+}
+
+int CBSDSocketInterface::receiveBatchFromUDP(TSocketDescriptor pa_nSockD, struct mmsghdr *pa_pstMessages, unsigned int pa_unNumMessages){
+  int nRetVal;
+  do{
+    nRetVal = recvmmsg(pa_nSockD, pa_pstMessages, pa_unNumMessages, MSG_DONTWAIT, 0);
+  } while((-1 == nRetVal) && (EINTR == errno));
+
+  if(nRetVal == -1){
+    DEVLOG_ERROR("CBSDSocketInterface: UDP-Socket recvmmsg() failed: %s\n", strerror(errno));
+  }
+  return nRetVal;
+}
+#endif
@@ -13,6 +13,7 @@
 #define BSDSOCKETINTERF_H_
 
 #include <sockhand.h>
+#include <forte_config.h>
 
 class CBSDSocketInterface{
   public:
@@ -31,6 +32,21 @@ class CBSDSocketInterface{
     static int sendDataOnUDP(TSocketDescriptor pa_nSockD, TUDPDestAddr *pa_ptDestAddr, char* pa_pcData, unsigned int pa_unSize);
     static int receiveDataFromUDP(TSocketDescriptor pa_nSockD, char* pa_pcData, unsigned int pa_unBufSize);
 
+#ifdef FORTE_COM_ETH_UDP_BATCHING
+    /*!\brief Sends several datagrams with as few system calls as possible
+     *
+     * Each message has to contain its destination address.
+     * @return number of messages sent, -1 if the first message could not be sent
+     */
+    static int sendBatchOnUDP(TSocketDescriptor pa_nSockD, struct mmsghdr *pa_pstMessages, unsigned int pa_unNumMessages);
+
+    /*!\brief Receives all datagrams waiting on the socket up to the number of messages given without blocking
+     *
+     * @return number of messages received, their sizes are stored in msg_len, -1 on error
+     */
+    static int receiveBatchFromUDP(TSocketDescriptor pa_nSockD, struct mmsghdr *pa_pstMessages, unsigned int pa_unNumMessages);
+#endif
+
   private:
     CBSDSocketInterface(); //this function is not implemented as we don't want instances of this class
 };
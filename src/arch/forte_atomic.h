@@ -0,0 +1,146 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+
+#ifndef SRC_ARCH_FORTE_ATOMIC_H_
+#define SRC_ARCH_FORTE_ATOMIC_H_
+
+#include "datatype.h"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#elif !defined(__GNUC__)
+#error "No atomic operations available for this compiler, add them to forte_atomic.h"
+#endif
+
+namespace forte {
+  namespace arch {
+
+    /*!\brief 32 bit unsigned integer shared between threads without a lock
+     *
+     * Loads have acquire and stores release semantics, so data written before a store is visible to the thread
+     * loading the stored value. Read-modify-write operations are full barriers.
+     */
+    class CAtomicUInt32{
+      public:
+        explicit CAtomicUInt32(TForteUInt32 paValue = 0) :
+            mValue(paValue){
+        }
+
+        TForteUInt32 load() const {
+#if defined(_MSC_VER) && !defined(__clang__)
+          return static_cast<TForteUInt32>(_InterlockedOr(const_cast<volatile long*>(&mValue), 0));
+#else
+          return __atomic_load_n(&mValue, __ATOMIC_ACQUIRE);
+#endif
+        }
+
+        void store(TForteUInt32 paValue){
+#if defined(_MSC_VER) && !defined(__clang__)
+          _InterlockedExchange(&mValue, static_cast<long>(paValue));
+#else
+          __atomic_store_n(&mValue, paValue, __ATOMIC_RELEASE);
+#endif
+        }
+
+        //! @return the value before the addition
+        TForteUInt32 fetchAdd(TForteUInt32 paValue){
+#if defined(_MSC_VER) && !defined(__clang__)
+          return static_cast<TForteUInt32>(_InterlockedExchangeAdd(&mValue, static_cast<long>(paValue)));
+#else
+          return __atomic_fetch_add(&mValue, paValue, __ATOMIC_SEQ_CST);
+#endif
+        }
+
+        //! @return the value before the exchange
+        TForteUInt32 exchange(TForteUInt32 paValue){
+#if defined(_MSC_VER) && !defined(__clang__)
+          return static_cast<TForteUInt32>(_InterlockedExchange(&mValue, static_cast<long>(paValue)));
+#else
+          return __atomic_exchange_n(&mValue, paValue, __ATOMIC_SEQ_CST);
+#endif
+        }
+
+      private:
+#if defined(_MSC_VER) && !defined(__clang__)
+        volatile long mValue;
+#else
+        TForteUInt32 mValue;
+#endif
+
+        CAtomicUInt32(const CAtomicUInt32&);
+        CAtomicUInt32& operator =(const CAtomicUInt32 &);
+    };
+
+    //! Pointer shared between threads without a lock, with the same memory ordering as CAtomicUInt32
+    template<typename T>
+    class CAtomicPointer{
+      public:
+        explicit CAtomicPointer(T *paValue = 0) :
+            mValue(paValue){
+        }
+
+        T *load() const {
+#if defined(_MSC_VER) && !defined(__clang__)
+          return static_cast<T*>(_InterlockedCompareExchangePointer(const_cast<void * volatile *>(&mValue), 0, 0));
+#else
+          return __atomic_load_n(&mValue, __ATOMIC_ACQUIRE);
+#endif
+        }
+
+        void store(T *paValue){
+#if defined(_MSC_VER) && !defined(__clang__)
+          _InterlockedExchangePointer(&mValue, paValue);
+#else
+          __atomic_store_n(&mValue, paValue, __ATOMIC_RELEASE);
+#endif
+        }
+
+        //! @return the value before the exchange
+        T *exchange(T *paValue){
+#if defined(_MSC_VER) && !defined(__clang__)
+          return static_cast<T*>(_InterlockedExchangePointer(&mValue, paValue));
+#else
+          return __atomic_exchange_n(&mValue, paValue, __ATOMIC_SEQ_CST);
+#endif
+        }
+
+        /*!\brief Replaces the value if it still equals paExpected
+         *
+         * @param paExpected the expected value, receives the current value if the exchange failed
+         * @return true if the value has been replaced
+         */
+        bool compareExchange(T *&paExpected, T *paValue){
+#if defined(_MSC_VER) && !defined(__clang__)
+          T *current = static_cast<T*>(_InterlockedCompareExchangePointer(&mValue, paValue, paExpected));
+          bool exchanged = (current == paExpected);
+          paExpected = current;
+          return exchanged;
+#else
+          return __atomic_compare_exchange_n(&mValue, &paExpected, paValue, false, __ATOMIC_SEQ_CST, __ATOMIC_ACQUIRE);
+#endif
+        }
+
+      private:
+#if defined(_MSC_VER) && !defined(__clang__)
+        void * volatile mValue;
+#else
+        T *mValue;
+#endif
+
+        CAtomicPointer(const CAtomicPointer&);
+        CAtomicPointer& operator =(const CAtomicPointer &);
+    };
+
+  }
+}
+
+#endif /* SRC_ARCH_FORTE_ATOMIC_H_ */
@@ -8,9 +8,12 @@
  *
  * Contributors:
  *  Alois Zoitl - initial API and implementation and/or initial documentation
+ *  agent - non-blocking reads into the receive ring of the framing base
+ *  agent - bound the wait for an idle line
  *******************************************************************************/
 #include "posixsercommlayer.h"
 #include "../devlog.h"
+#include "../forte_architecture_time.h"
 #include "../../core/cominfra/commfb.h"
 #include <unistd.h>
 #include <errno.h>
@@ -18,6 +21,7 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <sockhand.h>
 #include <criticalregion.h>
 
@@ -30,10 +34,21 @@ CPosixSerCommLayer::~CPosixSerCommLayer(){
 }
 
 forte::com_infra::EComResponse CPosixSerCommLayer::sendData(void *paData, unsigned int paSize){
-  if(CFDSelectHandler::scmInvalidFileDescriptor != getSerialHandler()){
+  if(CIPComSocketHandler::scmInvalidFileDescriptor != getSerialHandler()){
     ssize_t nToSend = paSize;
     while(0 < nToSend){
       ssize_t nSentBytes = write(getSerialHandler(), paData, nToSend);
+      if((0 > nSentBytes) && ((EAGAIN == errno) || (EWOULDBLOCK == errno) || (EINTR == errno))){
+        //the line is opened non-blocking, wait until the output buffer has space again
+        struct pollfd pollDescriptor;
+        pollDescriptor.fd = getSerialHandler();
+        pollDescriptor.events = POLLOUT;
+        pollDescriptor.revents = 0;
+        int nReady = poll(&pollDescriptor, 1, scmSendTimeout);
+        if((0 < nReady) || ((0 > nReady) && (EINTR == errno))){
+          continue;
+        }
+      }
       if(nSentBytes <= 0){
         DEVLOG_ERROR("CSerCommLayer: Send failed: %s\n", strerror(errno));
         return forte::com_infra::e_ProcessDataSendFailed;
@@ -47,37 +62,88 @@ forte::com_infra::EComResponse CPosixSerCommLayer::sendData(void *paData, unsign
 }
 
 forte::com_infra::EComResponse CPosixSerCommLayer::recvData(const void *, unsigned int){
-  CCriticalRegion lock(mRecvLock);
-  ssize_t nReadCount = read(getSerialHandler(), &mRecvBuffer[mBufFillSize], cg_unIPLayerRecvBufferSize - mBufFillSize);
+  if(readAvailableBytes()){
+    unsigned int idleTimeout = getFramer()->getIdleTimeout();
+    if((0 == idleTimeout) || waitForIdleLine(idleTimeout)){
+      CCriticalRegion lock(mRecvLock);
+      return handleReceivedBytes();
+    }
+  }
+  m_poFb->interruptCommFB(this);
+  return mInterruptResp;
+}
 
-  switch (nReadCount){
-    case 0:
+bool CPosixSerCommLayer::readAvailableBytes(){
+  CCriticalRegion lock(mRecvLock);
+  for(;;){
+    unsigned int spaceSize;
+    char *space = getRecvSpace(spaceSize);
+    ssize_t nReadCount = read(getSerialHandler(), space, spaceSize);
+    if(0 < nReadCount){
+      addReceivedBytes(static_cast<unsigned int>(nReadCount));
+      if(static_cast<unsigned int>(nReadCount) < spaceSize){
+        //the line is drained
+        return true;
+      }
+    }
+    else if(0 == nReadCount){
       DEVLOG_INFO("Connection closed by peer\n");
       mInterruptResp = forte::com_infra::e_InitTerminated;
       closeConnection();
-      break;
-    case -1:
+      return false;
+    }
+    else if((EAGAIN == errno) || (EWOULDBLOCK == errno)){
+      return true;
+    }
+    else if(EINTR != errno){
       DEVLOG_ERROR("CSerCommLayer: read failed: %s\n", strerror(errno));
       mInterruptResp = forte::com_infra::e_ProcessDataRecvFaild;
-      break;
-    default:
-      //we successfully received data
-      mBufFillSize += nReadCount;
-      mInterruptResp = forte::com_infra::e_ProcessDataOk;
-      break;
+      return false;
+    }
   }
+}
 
-  m_poFb->interruptCommFB(this);
-  return mInterruptResp;
+bool CPosixSerCommLayer::waitForIdleLine(unsigned int paIdleTimeout){
+  struct pollfd pollDescriptor;
+  pollDescriptor.fd = getSerialHandler();
+  pollDescriptor.events = POLLIN;
+  {
+    CCriticalRegion lock(mRecvLock);
+    if(0 == mRecvRing.size()){
+      return true;
+    }
+  }
+  //a line which never gets idle must not block the socket handler thread
+  uint_fast64_t deadline = getNanoSecondsMonotonic() + (static_cast<uint_fast64_t>(scmMaxIdleWait) * 1000U + paIdleTimeout) * 1000U;
+  for(;;){
+    if(getNanoSecondsMonotonic() >= deadline){
+      DEVLOG_WARNING("CSerCommLayer: line did not get idle within %d ms\n", scmMaxIdleWait);
+      return true;
+    }
+    pollDescriptor.revents = 0;
+    int nReady = poll(&pollDescriptor, 1, static_cast<int>((paIdleTimeout + 999) / 1000));
+    if(0 == nReady){
+      CCriticalRegion lock(mRecvLock);
+      handleIdleLine();
+      return true;
+    }
+    if((0 > nReady) && (EINTR != errno)){
+      //reading will report the problem with the next readable event
+      return true;
+    }
+    if((0 < nReady) && !readAvailableBytes()){
+      return false;
+    }
+  }
 }
 
 forte::com_infra::EComResponse CPosixSerCommLayer::openSerialConnection(const SSerialParameters& paSerialParameters, CSerialComLayerBase<FORTE_SOCKET_TYPE, FORTE_INVALID_SOCKET>::TSerialHandleType* paHandleResult){
   forte::com_infra::EComResponse eRetVal = forte::com_infra::e_ProcessDataNoSocket;
 
   //as first shot take the serial interface device as param (e.g., /dev/ttyS0 )
-  CFDSelectHandler::TFileDescriptor fileDescriptor = open(paSerialParameters.interfaceName.getValue(), O_RDWR | O_NOCTTY);
+  CIPComSocketHandler::TFileDescriptor fileDescriptor = open(paSerialParameters.interfaceName.getValue(), O_RDWR | O_NOCTTY | O_NONBLOCK);
 
-  if(CFDSelectHandler::scmInvalidFileDescriptor != fileDescriptor){
+  if(CIPComSocketHandler::scmInvalidFileDescriptor != fileDescriptor){
     tcgetattr(fileDescriptor, &mOldTIO);
     struct termios stNewTIO;
     memset(&stNewTIO, 0, sizeof(stNewTIO));
@@ -155,8 +221,8 @@ forte::com_infra::EComResponse CPosixSerCommLayer::openSerialConnection(const SS
     stNewTIO.c_cc[VERASE] = _POSIX_VDISABLE; /* del */
     stNewTIO.c_cc[VKILL] = _POSIX_VDISABLE; /* @ */
     stNewTIO.c_cc[VEOF] = _POSIX_VDISABLE; /* Ctrl-d */
-    stNewTIO.c_cc[VTIME] = 10; /* inter-character timer unused */
-    stNewTIO.c_cc[VMIN] = 1; /* blocking read until 1 character arrives */
+    stNewTIO.c_cc[VTIME] = 0; /* inter-character timing is done by the framer */
+    stNewTIO.c_cc[VMIN] = 0; /* reads return the available bytes, the line is only read when it is readable */
     stNewTIO.c_cc[VSWTC] = _POSIX_VDISABLE; /* '\0' */
     stNewTIO.c_cc[VSTART] = _POSIX_VDISABLE; /* Ctrl-q */
     stNewTIO.c_cc[VSTOP] = _POSIX_VDISABLE; /* Ctrl-s */
@@ -171,7 +237,7 @@ forte::com_infra::EComResponse CPosixSerCommLayer::openSerialConnection(const SS
     tcflush(fileDescriptor, TCIFLUSH);
     tcsetattr(fileDescriptor, TCSANOW, &stNewTIO);
 
-    getExtEvHandler<CFDSelectHandler>().addComCallback(fileDescriptor, this);
+    getExtEvHandler<CIPComSocketHandler>().addComCallback(fileDescriptor, this);
     *paHandleResult = fileDescriptor;
     eRetVal = forte::com_infra::e_InitOk;
 
@@ -185,11 +251,13 @@ forte::com_infra::EComResponse CPosixSerCommLayer::openSerialConnection(const SS
 }
 
 void CPosixSerCommLayer::closeConnection(){
-  CFDSelectHandler::TFileDescriptor fileDescriptor = getSerialHandler();
-  if(CFDSelectHandler::scmInvalidFileDescriptor != fileDescriptor){
-    getExtEvHandler<CFDSelectHandler>().removeComCallback(fileDescriptor);
+  CIPComSocketHandler::TFileDescriptor fileDescriptor = getSerialHandler();
+  if(CIPComSocketHandler::scmInvalidFileDescriptor != fileDescriptor){
+    getExtEvHandler<CIPComSocketHandler>().removeComCallback(fileDescriptor);
     tcsetattr(fileDescriptor, TCSANOW, &mOldTIO);
     close(fileDescriptor);
+    mSerialHandle = CIPComSocketHandler::scmInvalidFileDescriptor;
+    m_eConnectionState = forte::com_infra::e_Disconnected;
   }
 }
 
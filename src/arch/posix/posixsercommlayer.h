@@ -8,6 +8,7 @@
  *
  * Contributors:
  *  Alois Zoitl - initial API and implementation and/or initial documentation
+ *  agent - non-blocking reads into the receive ring of the framing base
  *******************************************************************************/
 #ifndef _SERCOMMLAYER_H_
 #define _SERCOMMLAYER_H_
@@ -26,9 +27,25 @@ class CPosixSerCommLayer : public CSerialComLayerBase<FORTE_SOCKET_TYPE, FORTE_I
 
   protected:
   private:
+    static const int scmSendTimeout = 1000; //!< ms to wait for space in the output buffer of the line
+    static const int scmMaxIdleWait = 100; //!< ms to wait for an idle line in addition to the idle timeout of the framer
+
     virtual forte::com_infra::EComResponse openSerialConnection(const SSerialParameters& paSerialParameters, CSerialComLayerBase<FORTE_SOCKET_TYPE, FORTE_INVALID_SOCKET>::TSerialHandleType* paHandleResult);
     virtual void closeConnection();
 
+    /*!\brief Reads all bytes available on the line into the receive ring
+     *
+     * @return false if the line got closed or reading failed, mInterruptResp holds the reason
+     */
+    bool readAvailableBytes();
+
+    /*!\brief Reads until the line was idle for the idle timeout of the framer
+     *
+     * Gives up after scmMaxIdleWait ms more than the idle timeout so that the handler thread serves the other
+     * descriptors. The bytes stay in the receive ring and are dropped by the framing base if it gets full.
+     */
+    bool waitForIdleLine(unsigned int paIdleTimeout);
+
     struct termios mOldTIO;    //!< buffer for the existing sercom settings
 };
 
@@ -34,9 +34,12 @@ template <typename TThreadHandle, TThreadHandle nullHandle, typename ThreadDelet
 void CThreadBase<TThreadHandle, nullHandle, ThreadDeletePolicy>::start(void){
   CCriticalRegion criticalRegion(mThreadMutex);
   if(nullHandle == mThreadHandle){
+    //set before the thread runs so that an end() directly after start() is not lost
+    setAlive(true);
     mThreadHandle = createThread(mStackSize);
     if(nullHandle == mThreadHandle){
       DEVLOG_ERROR("Error could not create the thread!\n");
+      setAlive(false);
       mJoinSem.inc();
     }
   }
@@ -65,7 +68,6 @@ template <typename TThreadHandle, TThreadHandle nullHandle, typename ThreadDelet
 void CThreadBase<TThreadHandle, nullHandle, ThreadDeletePolicy>::runThread(CThreadBase *paThread) {
   // if pointer is ok
   if (0 != paThread) {
-    paThread->setAlive(true);
     paThread->run();
     paThread->setAlive(false);
     paThread->mJoinSem.inc();
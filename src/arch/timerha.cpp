@@ -12,14 +12,13 @@
  *      - initial API and implementation and/or initial documentation
  *   Alois Zoitl - worked on reducing the jitter and overhead of timer handler
  *                 Bug #568902
+ *   agent - unregister timed FBs synchronously
  *******************************************************************************/
 #include "timerha.h"
 #include "../core/datatypes/forte_time.h"
 #include "../core/devexec.h"
 #include "../core/esfb.h"
 #include "../core/utils/criticalregion.h"
-#include <algorithm>
-#include <functional>
 
 DEFINE_HANDLER(CTimerHandler)
 
@@ -70,8 +69,23 @@ void CTimerHandler::addTimedFBEntry(STimedFBListEntry *paTimerListEntry) {
 }
 
 void CTimerHandler::unregisterTimedFB(CEventSourceFB *paTimedFB) {
-  CCriticalRegion criticalRegion(mRemoveListSync);
-  mRemoveFBList.push_back(paTimedFB);
+  {
+    CCriticalRegion criticalRegion(mAddListSync);
+    STimedFBListEntry **runner = &mAddFBList;
+    while(0 != *runner) {
+      if((*runner)->mTimedFB == paTimedFB) {
+        STimedFBListEntry *buffer = *runner;
+        *runner = buffer->mNext;
+        buffer->mNext = 0;
+        buffer->mTimeOut = 0;
+      } else {
+        runner = &((*runner)->mNext);
+      }
+    }
+  }
+  //an entry taken from the add list in the meantime is in the timed list when the lock is acquired
+  CCriticalRegion criticalRegion(mTimedListSync);
+  removeTimedFB(paTimedFB);
 }
 
 void CTimerHandler::removeTimedFB(CEventSourceFB *paTimedFB) {
@@ -102,10 +116,7 @@ void CTimerHandler::nextTick(void) {
   ++mForteTime;
   mDeviceExecution.notifyTime(mForteTime); //notify the device execution that one tick passed by.
 
-  if(!mRemoveFBList.empty()){
-    processRemoveList();
-  }
-
+  CCriticalRegion criticalRegion(mTimedListSync);
   processTimedFBList();
 
   if(0 != mAddFBList){
@@ -156,10 +167,5 @@ void CTimerHandler::processAddList(){
   }
 }
 
-void CTimerHandler::processRemoveList(){
-  CCriticalRegion criticalRegion(mRemoveListSync);
-  std::for_each(mRemoveFBList.begin(), mRemoveFBList.end(), std::bind1st(std::mem_fun(&CTimerHandler::removeTimedFB), this));
-  mRemoveFBList.clear();
-}
 
 
@@ -13,6 +13,7 @@
  *    - initial API and implementation and/or initial documentation
  *   Alois Zoitl - worked on reducing the jitter and overhead of timer handler
  *                 Bug #568902
+ *   agent - unregister timed FBs synchronously
  *******************************************************************************/
 #ifndef _TIMERHA_H_
 #define _TIMERHA_H_
@@ -20,7 +21,6 @@
 #include <forte_config.h>
 #include "../core/extevhan.h"
 #include <forte_sync.h>
-#include <vector>
 
 class CEventSourceFB;
 class CIEC_TIME;
@@ -80,6 +80,8 @@ class CTimerHandler : public CExternalEventHandler{
     void registerTimedFB(STimedFBListEntry *paTimerListEntry, const CIEC_TIME &paTimeInterval);
 
     /*!\brief  Unregister an FB from an the timmer
+     *
+     * The FB is removed before the function returns, so it may be deleted right afterwards.
      *
      * \param paTimedFB FB to unregister from this external event handler
      */
@@ -99,7 +101,6 @@ class CTimerHandler : public CExternalEventHandler{
 
     void processTimedFBList();
     void processAddList();
-    void processRemoveList();
 
     //!Remove an entry from the timed list.
     void removeTimedFB(CEventSourceFB *paTimedFB);
@@ -117,9 +118,8 @@ class CTimerHandler : public CExternalEventHandler{
     STimedFBListEntry *mAddFBList;
     CSyncObject mAddListSync;
 
-    //! List of function blocks to be removed from the timer handler
-    std::vector<CEventSourceFB *> mRemoveFBList;
-    CSyncObject mRemoveListSync;
+    //! Protects mTimedFBList, held while the timed FBs of a tick are processed
+    CSyncObject mTimedListSync;
 
 };
 
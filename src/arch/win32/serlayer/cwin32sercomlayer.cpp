@@ -8,10 +8,12 @@
  *
  * Contributors:
  *   Martin Melik-Merkumians, Alois Zoitl - initial API and implementation and/or initial documentation
+ *   agent - read into the receive ring of the framing base
  *******************************************************************************/
 #include "cwin32sercomlayer.h"
 #include "cwin32sercomhandler.h"
 #include "../../../core/cominfra/commfb.h"
+#include <criticalregion.h>
 
 CWin32SerComLayer::CWin32SerComLayer(forte::com_infra::CComLayer* paUpperLayer,
     forte::com_infra::CBaseCommFB* paFB) :
@@ -23,20 +25,21 @@ CWin32SerComLayer::~CWin32SerComLayer() {
 }
 
 forte::com_infra::EComResponse CWin32SerComLayer::recvData(const void *, unsigned int )  {
-  mInterruptResp = forte::com_infra::e_Nothing;
+  CCriticalRegion lock(mRecvLock);
+  unsigned int spaceSize;
+  char *space = getRecvSpace(spaceSize);
 
   DWORD dwBytesRead = 0;
-  if(ReadFile(static_cast<HANDLE>(mSerialHandle), mRecvBuffer, mMaxRecvBuffer - 1, &dwBytesRead, NULL)){ //TODO: Failure handling and send INITO-
+  if(ReadFile(static_cast<HANDLE>(mSerialHandle), space, spaceSize, &dwBytesRead, NULL)){ //TODO: Failure handling and send INITO-
     if(0 < dwBytesRead){
-      mBufFillSize = dwBytesRead;
-      mInterruptResp = forte::com_infra::e_ProcessDataOk;
-      m_poFb->interruptCommFB(this);
-    }
-    else{
-      mInterruptResp = forte::com_infra::e_ProcessDataRecvFaild;
+      addReceivedBytes(dwBytesRead);
+      return handleReceivedBytes();
     }
+    mInterruptResp = forte::com_infra::e_ProcessDataRecvFaild;
+    m_poFb->interruptCommFB(this);
+    return mInterruptResp;
   }
-  return mInterruptResp;
+  return forte::com_infra::e_Nothing;
 }
 
 forte::com_infra::EComResponse CWin32SerComLayer::sendData(void *paData, unsigned int paSize)
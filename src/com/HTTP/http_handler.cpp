@@ -27,16 +27,14 @@ TForteUInt16 gHTTPServerPort = FORTE_COM_HTTP_LISTENING_PORT;
 
 CIPComSocketHandler::TSocketDescriptor CHTTP_Handler::smServerListeningSocket = CIPComSocketHandler::scmInvalidSocketDescriptor;
 
-char CHTTP_Handler::sRecvBuffer[];
-unsigned int CHTTP_Handler::sBufFillSize = 0;
 const unsigned int CHTTP_Handler::scmSendTimeout = 20;
 const unsigned int CHTTP_Handler::scmAcceptedTimeout = 5;
+const unsigned int CHTTP_Handler::scmClientIdleTimeout = 20;
 
 DEFINE_HANDLER(CHTTP_Handler);
 
 CHTTP_Handler::CHTTP_Handler(CDeviceExecution& pa_poDeviceExecution) :
-    CExternalEventHandler(pa_poDeviceExecution) {
-  memset(sRecvBuffer, 0, cg_unIPLayerRecvBufferSize);
+    CExternalEventHandler(pa_poDeviceExecution), mNumberOfServerPaths(0) {
 }
 
 CHTTP_Handler::~CHTTP_Handler() {
@@ -44,7 +42,7 @@ CHTTP_Handler::~CHTTP_Handler() {
   closeHTTPServer();
   clearServerLayers();
   clearClientLayers();
-  clearAcceptedSockets();
+  clearServerConnections();
 }
 
 void CHTTP_Handler::enableHandler(void) {
@@ -57,32 +55,36 @@ void CHTTP_Handler::disableHandler(void) {
 
 void CHTTP_Handler::clearServerLayers() {
   CCriticalRegion criticalRegion(mServerMutex);
-  for(CSinglyLinkedList<HTTPServerWaiting *>::Iterator iter = mServerLayers.begin(); iter != mServerLayers.end(); ++iter) {
-    for(CSinglyLinkedList<CIPComSocketHandler::TSocketDescriptor>::Iterator iter1 = (*iter)->mSockets.begin(); iter1 != (*iter)->mSockets.end(); ++iter1) {
-      removeAndCloseSocket(*iter1);
+  for(size_t i = 0; i < scmNumberOfPathBuckets; i++) {
+    for(CSinglyLinkedList<HTTPServerWaiting *>::Iterator iter = mServerLayers[i].begin(); iter != mServerLayers[i].end(); ++iter) {
+      for(CSinglyLinkedList<HTTPServerConnection *>::Iterator iter1 = (*iter)->mConnections.begin(); iter1 != (*iter)->mConnections.end(); ++iter1) {
+        (*iter1)->mWaitingAt = 0;
+        closeServerConnection(*iter1);
+      }
+      delete (*iter);
     }
-    (*iter)->mSockets.clearAll();
-    delete (*iter);
+    mServerLayers[i].clearAll();
   }
-  mServerLayers.clearAll();
+  mNumberOfServerPaths = 0;
 }
 
 void CHTTP_Handler::clearClientLayers() {
   CCriticalRegion criticalRegion(mClientMutex);
-  for(CSinglyLinkedList<HTTPClientWaiting *>::Iterator iter = mClientLayers.begin(); iter != mClientLayers.end(); ++iter) {
+  for(CSinglyLinkedList<HTTPClientConnection *>::Iterator iter = mClientLayers.begin(); iter != mClientLayers.end(); ++iter) {
     removeAndCloseSocket((*iter)->mSocket);
     delete (*iter);
   }
   mClientLayers.clearAll();
 }
 
-void CHTTP_Handler::clearAcceptedSockets() {
-  CCriticalRegion criticalRegion(mAcceptedMutex);
-  for(CSinglyLinkedList<HTTPAcceptedSockets *>::Iterator iter = mAcceptedSockets.begin(); iter != mAcceptedSockets.end(); ++iter) {
+void CHTTP_Handler::clearServerConnections() {
+  CCriticalRegion criticalRegion(mServerMutex);
+  for(CSinglyLinkedList<HTTPServerConnection *>::Iterator iter = mServerConnections.begin(); iter != mServerConnections.end(); ++iter) {
     removeAndCloseSocket((*iter)->mSocket);
     delete (*iter);
   }
-  mAcceptedSockets.clearAll();
+  mServerConnections.clearAll();
+  mPipelinedConnections.clearAll();
 }
 
 void CHTTP_Handler::setPriority(int) {
@@ -94,140 +96,293 @@ int CHTTP_Handler::getPriority(void) const {
   return 0;
 }
 
-forte::com_infra::EComResponse CHTTP_Handler::recvData(const void* paData, unsigned int) { //TODO: do something with the size parameter of the received data?
+forte::com_infra::EComResponse CHTTP_Handler::recvData(const void* paData, unsigned int) {
   CIPComSocketHandler::TSocketDescriptor socket = *(static_cast<const CIPComSocketHandler::TSocketDescriptor*>(paData));
 
   if(socket == smServerListeningSocket) {
     CIPComSocketHandler::TSocketDescriptor newConnection = CIPComSocketHandler::acceptTCPConnection(socket);
     if(CIPComSocketHandler::scmInvalidSocketDescriptor != newConnection) {
-      CCriticalRegion criticalRegion(mAcceptedMutex);
-      HTTPAcceptedSockets* accepted = new HTTPAcceptedSockets();
-      accepted->mSocket = newConnection;
-      accepted->mStartTime = NOW();
-      mAcceptedSockets.pushBack(accepted);
+      CCriticalRegion criticalRegion(mServerMutex);
+      mServerConnections.pushBack(new HTTPServerConnection(newConnection));
       getExtEvHandler<CIPComSocketHandler>().addComCallback(newConnection, this);
       resumeSelfsuspend();
     } else {
       DEVLOG_ERROR("[HTTP Handler] Couldn't accept new HTTP connection\n");
     }
-  } else {
-    int recvLen = CIPComSocketHandler::receiveDataFromTCP(socket, &sRecvBuffer[sBufFillSize], cg_unIPLayerRecvBufferSize - sBufFillSize);
-    if(0 == recvLen) {
-      removeAndCloseSocket(socket);
-    } else if(-1 == recvLen) {
-      removeAndCloseSocket(socket);
-      DEVLOG_ERROR("[HTTP handler] Error receiving packet\n");
-    } else {
-      if(!recvClients(socket, recvLen) && !recvServers(socket)) {
-        DEVLOG_WARNING("[HTTP Handler]: A packet arrived to the wrong place\n");
-      }
-    }
+  } else if(!recvClients(socket) && !recvServers(socket)) {
+    DEVLOG_WARNING("[HTTP Handler]: A packet arrived to the wrong place\n");
+    removeAndCloseSocket(socket);
   }
 
   return e_Nothing;
 }
 
-bool CHTTP_Handler::recvClients(const CIPComSocketHandler::TSocketDescriptor paSocket, const int paRecvLength) { //check clients
+bool CHTTP_Handler::recvClients(const CIPComSocketHandler::TSocketDescriptor paSocket) {
   CCriticalRegion criticalRegion(mClientMutex);
-  for(CSinglyLinkedList<HTTPClientWaiting *>::Iterator iter = mClientLayers.begin(); iter != mClientLayers.end(); ++iter) {
-    if((*iter)->mSocket == paSocket) {
-      if(e_ProcessDataOk == (*iter)->mLayer->recvData(sRecvBuffer, paRecvLength)) {
-        startNewEventChain((*iter)->mLayer->getCommFB());
-      }
-      removeAndCloseSocket(paSocket);
-      HTTPClientWaiting * toDelete = *iter;
-      mClientLayers.erase(toDelete);
-      delete toDelete;
+  HTTPClientConnection *connection = findClientConnection(0, paSocket);
+  if(0 == connection) {
+    return false;
+  }
+
+  int recvLen = CIPComSocketHandler::receiveDataFromTCP(paSocket, connection->mParser.getFreeBuffer(),
+    static_cast<unsigned int>(connection->mParser.getFreeBufferSize()));
+  if(0 < recvLen) {
+    connection->mParser.receivedData(static_cast<size_t>(recvLen));
+    connection->mLastActivity = getNanoSecondsMonotonic();
+    handleClientResponses(*connection);
+  } else {
+    if(-1 == recvLen) {
+      DEVLOG_ERROR("[HTTP handler] Error receiving packet\n");
+    } else if(0 != connection->mPendingResponses && forte::com_infra::CHttpStreamParser::e_MessageComplete == connection->mParser.endOfStream()) {
+      //response whose end is given by closing the connection
+      handleClientResponses(*connection);
       return true;
     }
+    if(0 != connection->mPendingResponses) {
+      connection->mLayer->recvData(0, 0); //indicates that the response is lost
+    }
+    closeClientConnection(connection);
   }
-
-  return false;
+  return true;
 }
 
-bool CHTTP_Handler::recvServers(const CIPComSocketHandler::TSocketDescriptor paSocket) {
-  CCriticalRegion criticalRegion(mServerMutex);
-  removeSocketFromAccepted(paSocket);
-
-  bool found = false;
-  if(!mServerLayers.isEmpty()) {
-    CIEC_STRING path;
-    CSinglyLinkedList<CIEC_STRING> parameterNames;
-    CSinglyLinkedList<CIEC_STRING> parameterValues;
-    bool noParsingError = false;
-    switch(CHttpParser::getTypeOfRequest(sRecvBuffer)){
-      case CHttpComLayer::e_GET:
-        noParsingError = CHttpParser::parseGetRequest(path, parameterNames, parameterValues, sRecvBuffer);
-        break;
-      case CHttpComLayer::e_POST:
-      case CHttpComLayer::e_PUT: {
-        CIEC_STRING content;
-        noParsingError = CHttpParser::parsePutPostRequest(path, content, sRecvBuffer);
-        parameterValues.pushBack(content);
+void CHTTP_Handler::handleClientResponses(HTTPClientConnection &paConnection) {
+  for(;;) {
+    switch(paConnection.mParser.parse()){
+      case forte::com_infra::CHttpStreamParser::e_NeedMoreData:
+        return;
+      case forte::com_infra::CHttpStreamParser::e_MessageComplete: {
+        if(0 != paConnection.mPendingResponses) {
+          paConnection.mPendingResponses--;
+          if(e_ProcessDataOk == paConnection.mLayer->recvClientData(paConnection.mParser)) {
+            startNewEventChain(paConnection.mLayer->getCommFB());
+          }
+        } else {
+          DEVLOG_WARNING("[HTTP Handler]: Client %s:%u received an unrequested response\n", paConnection.mLayer->getHost().getValue(), paConnection.mLayer->getPort());
+        }
+        if(!paConnection.mParser.isKeepAlive()) {
+          closeClientConnection(&paConnection);
+          return;
+        }
+        paConnection.mParser.consumeMessage();
         break;
       }
       default:
-        break;
-    }
-
-    if(noParsingError) {
-      for(CSinglyLinkedList<HTTPServerWaiting *>::Iterator iter = mServerLayers.begin(); iter != mServerLayers.end(); ++iter) {
-        if((*iter)->mPath == path) {
-          (*iter)->mSockets.pushBack(paSocket);
-          if(e_ProcessDataOk == (*iter)->mLayer->recvServerData(parameterNames, parameterValues)) {
-            startNewEventChain((*iter)->mLayer->getCommFB());
-          }
-          found = true;
-          break;
+        DEVLOG_ERROR("[HTTP Handler]: Invalid response for client %s:%u\n", paConnection.mLayer->getHost().getValue(), paConnection.mLayer->getPort());
+        if(0 != paConnection.mPendingResponses) {
+          paConnection.mLayer->recvData(0, 0);
         }
-      }
-    } else {
-      DEVLOG_ERROR("[HTTP Handler] Wrong HTTP request\n");
+        closeClientConnection(&paConnection);
+        return;
     }
+  }
+}
+
+void CHTTP_Handler::closeClientConnection(HTTPClientConnection *paConnection) {
+  removeAndCloseSocket(paConnection->mSocket);
+  mClientLayers.erase(paConnection);
+  delete paConnection;
+}
 
-    if(!found) {
-      handlerReceivedWrongPath(paSocket, path);
+CHTTP_Handler::HTTPClientConnection *CHTTP_Handler::findClientConnection(const forte::com_infra::CHttpComLayer* paLayer,
+    CIPComSocketHandler::TSocketDescriptor paSocket) {
+  for(CSinglyLinkedList<HTTPClientConnection *>::Iterator iter = mClientLayers.begin(); iter != mClientLayers.end(); ++iter) {
+    if((0 != paLayer) ? ((*iter)->mLayer == paLayer) : ((*iter)->mSocket == paSocket)) {
+      return *iter;
     }
   }
-
-  return found;
+  return 0;
 }
 
-void CHTTP_Handler::removeSocketFromAccepted(const CIPComSocketHandler::TSocketDescriptor paSocket) {
-  CCriticalRegion criticalRegion(mAcceptedMutex);
-  for(CSinglyLinkedList<HTTPAcceptedSockets *>::Iterator iter = mAcceptedSockets.begin(); iter != mAcceptedSockets.end(); ++iter) {
+bool CHTTP_Handler::recvServers(const CIPComSocketHandler::TSocketDescriptor paSocket) {
+  CCriticalRegion criticalRegion(mServerMutex);
+  HTTPServerConnection *connection = 0;
+  for(CSinglyLinkedList<HTTPServerConnection *>::Iterator iter = mServerConnections.begin(); iter != mServerConnections.end(); ++iter) {
     if((*iter)->mSocket == paSocket) {
-      HTTPAcceptedSockets *toDelete = *iter;
-      mAcceptedSockets.erase(toDelete);
-      delete toDelete;
+      connection = *iter;
       break;
     }
   }
+  if(0 == connection) {
+    return false;
+  }
+
+  if(0 == connection->mParser.getFreeBufferSize()) {
+    //the client sent more pipelined requests than can be buffered while the current one is processed
+    DEVLOG_ERROR("[HTTP Handler] Receive buffer of connection is full\n");
+    closeServerConnection(connection);
+    return true;
+  }
+
+  int recvLen = CIPComSocketHandler::receiveDataFromTCP(paSocket, connection->mParser.getFreeBuffer(),
+    static_cast<unsigned int>(connection->mParser.getFreeBufferSize()));
+  if(0 < recvLen) {
+    connection->mParser.receivedData(static_cast<size_t>(recvLen));
+    connection->mLastActivity = getNanoSecondsMonotonic();
+    if(0 == connection->mWaitingAt) {
+      handleServerRequests(*connection);
+    }
+  } else {
+    if(-1 == recvLen) {
+      DEVLOG_ERROR("[HTTP handler] Error receiving packet\n");
+    }
+    closeServerConnection(connection);
+  }
+  return true;
+}
+
+void CHTTP_Handler::handleServerRequests(HTTPServerConnection &paConnection) {
+  mPipelinedConnections.erase(&paConnection);
+  while(0 == paConnection.mWaitingAt) {
+    switch(paConnection.mParser.parse()){
+      case forte::com_infra::CHttpStreamParser::e_NeedMoreData:
+        return;
+      case forte::com_infra::CHttpStreamParser::e_MessageComplete:
+        dispatchServerRequest(paConnection);
+        if(!isServerConnectionOpen(&paConnection)) {
+          //the connection was closed while answering, e.g., because the client requested it
+          return;
+        }
+        break;
+      case forte::com_infra::CHttpStreamParser::e_MessageTooLarge:
+        sendServerError(paConnection, "HTTP/1.1 413 Payload Too Large");
+        closeServerConnection(&paConnection);
+        return;
+      default:
+        DEVLOG_ERROR("[HTTP Handler] Wrong HTTP request\n");
+        sendServerError(paConnection, "HTTP/1.1 400 Bad Request");
+        closeServerConnection(&paConnection);
+        return;
+    }
+  }
 }
 
-void CHTTP_Handler::handlerReceivedWrongPath(const CIPComSocketHandler::TSocketDescriptor paSocket, CIEC_STRING& paPath) {
-  DEVLOG_ERROR("[HTTP Handler] Path %s has no FB registered\n", paPath.getValue());
+void CHTTP_Handler::dispatchServerRequest(HTTPServerConnection &paConnection) {
+  const forte::com_infra::CHttpStreamParser::SSpan &path = paConnection.mParser.getPath();
+  if(CHttpComLayer::e_NOTSET == paConnection.mParser.getRequestType()) {
+    DEVLOG_ERROR("[HTTP Handler] Unsupported HTTP request\n");
+    sendServerError(paConnection, "HTTP/1.1 400 Bad Request");
+    finishServerRequest(paConnection, true);
+    return;
+  }
 
+  HTTPServerWaiting *serverPath = findServerPath(path.mData, path.mLength);
+  if(0 == serverPath) {
+    DEVLOG_ERROR("[HTTP Handler] Path %.*s has no FB registered\n", static_cast<int>(path.mLength), path.mData);
+    sendServerError(paConnection, "HTTP/1.1 404 Not Found");
+    finishServerRequest(paConnection, true);
+    return;
+  }
+
+  paConnection.mWaitingAt = serverPath;
+  serverPath->mConnections.pushBack(&paConnection);
+  if(e_ProcessDataOk == serverPath->mLayer->recvServerData(paConnection.mParser)) {
+    startNewEventChain(serverPath->mLayer->getCommFB());
+  }
+}
+
+void CHTTP_Handler::finishServerRequest(HTTPServerConnection &paConnection, bool paKeepAlive) {
+  paConnection.mWaitingAt = 0;
+  if(paKeepAlive && paConnection.mParser.isKeepAlive()) {
+    paConnection.mParser.consumeMessage();
+    paConnection.mLastActivity = getNanoSecondsMonotonic();
+    if(paConnection.mParser.hasBufferedData()) {
+      //further pipelined requests are handled by the handler thread, so that the answering FB is not called recursively
+      mPipelinedConnections.erase(&paConnection);
+      mPipelinedConnections.pushBack(&paConnection);
+      resumeSelfsuspend();
+    }
+  } else {
+    closeServerConnection(&paConnection);
+  }
+}
+
+void CHTTP_Handler::sendServerError(HTTPServerConnection &paConnection, const char* paStatusLine) {
   CIEC_STRING toSend;
-  CIEC_STRING result = "HTTP/1.1 404 Not Found";
-  CIEC_STRING mContentType = "text/html";
-  CIEC_STRING mReqData = "";
-  CHttpParser::createResponse(toSend, result, mContentType, mReqData);
-  if(toSend.length() != CIPComSocketHandler::sendDataOnTCP(paSocket, toSend.getValue(), toSend.length())) {
+  CIEC_STRING result = paStatusLine;
+  CIEC_STRING contentType = "text/html";
+  CIEC_STRING reqData = "";
+  CHttpParser::createResponse(toSend, result, contentType, reqData);
+  if(toSend.length() != CIPComSocketHandler::sendDataOnTCP(paConnection.mSocket, toSend.getValue(), toSend.length())) {
     DEVLOG_ERROR("[HTTP Handler]: Error sending back the answer %s \n", toSend.getValue());
   }
-  removeAndCloseSocket(paSocket);
+}
+
+void CHTTP_Handler::closeServerConnection(HTTPServerConnection *paConnection) {
+  if(CIPComSocketHandler::scmInvalidSocketDescriptor != paConnection->mSocket) {
+    removeAndCloseSocket(paConnection->mSocket);
+    paConnection->mSocket = CIPComSocketHandler::scmInvalidSocketDescriptor;
+    mServerConnections.erase(paConnection);
+    mPipelinedConnections.erase(paConnection);
+  }
+  if(0 == paConnection->mWaitingAt) {
+    delete paConnection;
+  }
+  //otherwise the connection stays in the queue of its path until the FB answers, so that the answers keep their order
+}
+
+bool CHTTP_Handler::isServerConnectionOpen(const HTTPServerConnection *paConnection) {
+  for(CSinglyLinkedList<HTTPServerConnection *>::Iterator iter = mServerConnections.begin(); iter != mServerConnections.end(); ++iter) {
+    if(*iter == paConnection) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void CHTTP_Handler::handlePipelinedRequests() {
+  CCriticalRegion criticalRegion(mServerMutex);
+  while(!mPipelinedConnections.isEmpty()) {
+    CSinglyLinkedList<HTTPServerConnection *>::Iterator iter = mPipelinedConnections.begin();
+    HTTPServerConnection *connection = *iter;
+    handleServerRequests(*connection); //removes the connection from the list
+  }
+}
+
+CHTTP_Handler::HTTPServerWaiting *CHTTP_Handler::findServerPath(const char* paPath, size_t paLength) {
+  CSinglyLinkedList<HTTPServerWaiting *> &bucket(mServerLayers[getServerPathBucket(paPath, paLength)]);
+  for(CSinglyLinkedList<HTTPServerWaiting *>::Iterator iter = bucket.begin(); iter != bucket.end(); ++iter) {
+    if((*iter)->mPath.length() == paLength && 0 == memcmp((*iter)->mPath.getValue(), paPath, paLength)) {
+      return *iter;
+    }
+  }
+  return 0;
+}
+
+size_t CHTTP_Handler::getServerPathBucket(const char* paPath, size_t paLength) {
+  //FNV-1a
+  TForteUInt32 hash = 2166136261U;
+  for(size_t i = 0; i < paLength; i++) {
+    hash ^= static_cast<unsigned char>(paPath[i]);
+    hash *= 16777619U;
+  }
+  return hash % scmNumberOfPathBuckets;
 }
 
 bool CHTTP_Handler::sendClientData(forte::com_infra::CHttpComLayer* paLayer, CIEC_STRING& paToSend) {
+  CCriticalRegion criticalRegion(mClientMutex);
+  HTTPClientConnection *connection = findClientConnection(paLayer, CIPComSocketHandler::scmInvalidSocketDescriptor);
+  if(0 != connection) {
+    //reuse the persistent connection, requests are pipelined if the previous response didn't arrive yet
+    if(paToSend.length() == CIPComSocketHandler::sendDataOnTCP(connection->mSocket, paToSend.getValue(), paToSend.length())) {
+      if(0 == connection->mPendingResponses++) {
+        connection->mLastActivity = getNanoSecondsMonotonic();
+      }
+      return true;
+    }
+    DEVLOG_INFO("[HTTP Handler]: Connection to %s:%u was closed, reconnecting\n", paLayer->getHost().getValue(), paLayer->getPort());
+    if(0 != connection->mPendingResponses) {
+      paLayer->recvData(0, 0);
+    }
+    closeClientConnection(connection);
+  }
+
   CIPComSocketHandler::TSocketDescriptor newSocket = CIPComSocketHandler::openTCPClientConnection(paLayer->getHost().getValue(), paLayer->getPort());
   if(CIPComSocketHandler::scmInvalidSocketDescriptor != newSocket) {
     if(paToSend.length() == CIPComSocketHandler::sendDataOnTCP(newSocket, paToSend.getValue(), paToSend.length())) {
-      CCriticalRegion criticalRegion(mClientMutex);
-      HTTPClientWaiting* toAdd = new HTTPClientWaiting();
-      toAdd->mLayer = paLayer;
+      HTTPClientConnection* toAdd = new HTTPClientConnection(paLayer);
       toAdd->mSocket = newSocket;
-      toAdd->mStartTime = NOW();
+      toAdd->mPendingResponses = 1;
       startTimeoutThread();
       mClientLayers.pushBack(toAdd);
       getExtEvHandler<CIPComSocketHandler>().addComCallback(newSocket, this);
@@ -246,18 +401,17 @@ bool CHTTP_Handler::sendClientData(forte::com_infra::CHttpComLayer* paLayer, CIE
 bool CHTTP_Handler::addServerPath(forte::com_infra::CHttpComLayer* paLayer, CIEC_STRING& paPath) {
   CCriticalRegion criticalRegion(mServerMutex);
 
-  for(CSinglyLinkedList<HTTPServerWaiting *>::Iterator iter = mServerLayers.begin(); iter != mServerLayers.end(); ++iter) {
-    if((*iter)->mPath == paPath) {
-      DEVLOG_ERROR("[HTTP Handler]: The listening  path \"%s\" was already added to the http server. Cannot add it again\n", paPath.getValue());
-      return false;
-    }
+  if(0 != findServerPath(paPath.getValue(), paPath.length())) {
+    DEVLOG_ERROR("[HTTP Handler]: The listening  path \"%s\" was already added to the http server. Cannot add it again\n", paPath.getValue());
+    return false;
   }
 
   openHTTPServer();
   HTTPServerWaiting* toAdd = new HTTPServerWaiting();
   toAdd->mLayer = paLayer;
   toAdd->mPath = paPath;
-  mServerLayers.pushBack(toAdd);
+  mServerLayers[getServerPathBucket(paPath.getValue(), paPath.length())].pushBack(toAdd);
+  mNumberOfServerPaths++;
   DEVLOG_INFO("[HTTP Handler]: The listening  path \"%s\" was added to the http server\n", paPath.getValue());
   return true;
 }
@@ -265,19 +419,18 @@ bool CHTTP_Handler::addServerPath(forte::com_infra::CHttpComLayer* paLayer, CIEC
 void CHTTP_Handler::removeServerPath(CIEC_STRING& paPath) {
   CCriticalRegion criticalRegion(mServerMutex);
 
-  for(CSinglyLinkedList<HTTPServerWaiting *>::Iterator iter = mServerLayers.begin(); iter != mServerLayers.end(); ++iter) {
-    if((*iter)->mPath == paPath) {
-      for(CSinglyLinkedList<CIPComSocketHandler::TSocketDescriptor>::Iterator iter_ = (*iter)->mSockets.begin(); iter_ != (*iter)->mSockets.end(); ++iter_) {
-        removeAndCloseSocket(*iter_);
-      }
-      HTTPServerWaiting * toDelete = *iter;
-      mServerLayers.erase(toDelete);
-      delete toDelete;
-      break;
+  HTTPServerWaiting *toDelete = findServerPath(paPath.getValue(), paPath.length());
+  if(0 != toDelete) {
+    for(CSinglyLinkedList<HTTPServerConnection *>::Iterator iter = toDelete->mConnections.begin(); iter != toDelete->mConnections.end(); ++iter) {
+      (*iter)->mWaitingAt = 0;
+      closeServerConnection(*iter);
     }
+    mServerLayers[getServerPathBucket(paPath.getValue(), paPath.length())].erase(toDelete);
+    delete toDelete;
+    mNumberOfServerPaths--;
   }
 
-  if(mServerLayers.isEmpty()) {
+  if(0 == mNumberOfServerPaths) {
     closeHTTPServer();
   }
 }
@@ -303,68 +456,60 @@ void CHTTP_Handler::run() {
 
   mThreadStarted.inc();
   while(isAlive()) {
-    if(mClientLayers.isEmpty() && mAcceptedSockets.isEmpty()) {
+    if(mClientLayers.isEmpty() && mServerConnections.isEmpty() && mPipelinedConnections.isEmpty()) {
       selfSuspend();
     }
     if(!isAlive()) {
       break;
     }
 
+    handlePipelinedRequests();
     checkClientLayers();
-    checkAcceptedSockets();
+    checkServerConnections();
     sleepThread(100);
 
   }
 }
 
+bool CHTTP_Handler::isTimedOut(uint_fast64_t paStartTime, unsigned int paTimeoutInSeconds) {
+  return (getNanoSecondsMonotonic() - paStartTime) > static_cast<uint_fast64_t>(paTimeoutInSeconds) * 1000000000ULL;
+}
+
 void CHTTP_Handler::checkClientLayers() {
   CCriticalRegion criticalRegion(mClientMutex);
   if(!mClientLayers.isEmpty()) {
-    CSinglyLinkedList<HTTPClientWaiting *> clientsToDelete;
-    for(CSinglyLinkedList<HTTPClientWaiting *>::Iterator iter = mClientLayers.begin(); iter != mClientLayers.end(); ++iter) {
-      // wait until result is ready
-      CIEC_DATE_AND_TIME currentTime(NOW());
-      if(currentTime.getMilliSeconds() - (*iter)->mStartTime.getMilliSeconds() > scmSendTimeout * 1000) {
-        DEVLOG_ERROR("[HTTP Handler]: Timeout at client %s:%u \n", (*iter)->mLayer->getHost().getValue(), (*iter)->mLayer->getPort());
-        removeAndCloseSocket((*iter)->mSocket);
+    CSinglyLinkedList<HTTPClientConnection *> clientsToDelete;
+    for(CSinglyLinkedList<HTTPClientConnection *>::Iterator iter = mClientLayers.begin(); iter != mClientLayers.end(); ++iter) {
+      if(0 != (*iter)->mPendingResponses) {
+        // wait until result is ready
+        if(isTimedOut((*iter)->mLastActivity, scmSendTimeout)) {
+          DEVLOG_ERROR("[HTTP Handler]: Timeout at client %s:%u \n", (*iter)->mLayer->getHost().getValue(), (*iter)->mLayer->getPort());
+          clientsToDelete.pushBack(*iter);
+          (*iter)->mLayer->recvData(0, 0); //indicates timeout
+        }
+      } else if(isTimedOut((*iter)->mLastActivity, scmClientIdleTimeout)) {
         clientsToDelete.pushBack(*iter);
-        (*iter)->mLayer->recvData(0, 0); //indicates timeout
       }
     }
-    for(CSinglyLinkedList<HTTPClientWaiting *>::Iterator iter = clientsToDelete.begin(); iter != clientsToDelete.end(); ++iter) {
-      for(CSinglyLinkedList<HTTPClientWaiting *>::Iterator iter_ = mClientLayers.begin(); iter_ != mClientLayers.end(); ++iter_) {
-        if(*iter_ == *iter) {
-          mClientLayers.erase(*iter_);
-          delete (*iter);
-          break;
-        }
-      }
+    for(CSinglyLinkedList<HTTPClientConnection *>::Iterator iter = clientsToDelete.begin(); iter != clientsToDelete.end(); ++iter) {
+      closeClientConnection(*iter);
     }
   }
 }
 
-void CHTTP_Handler::checkAcceptedSockets() {
-  CCriticalRegion criticalRegion(mAcceptedMutex);
-  if(!mAcceptedSockets.isEmpty()) {
-    CSinglyLinkedList<HTTPAcceptedSockets *> acceptedToDelete;
-    for(CSinglyLinkedList<HTTPAcceptedSockets *>::Iterator iter = mAcceptedSockets.begin(); iter != mAcceptedSockets.end(); ++iter) {
-      // wait until result is ready
-      CIEC_DATE_AND_TIME currentTime(NOW());
-      if(currentTime.getMilliSeconds() - (*iter)->mStartTime.getMilliSeconds() > scmAcceptedTimeout * 1000) {
-        DEVLOG_ERROR("[HTTP Handler]: Timeout at accepted socket\n");
-        removeAndCloseSocket((*iter)->mSocket);
-        acceptedToDelete.pushBack(*iter);
+void CHTTP_Handler::checkServerConnections() {
+  CCriticalRegion criticalRegion(mServerMutex);
+  if(!mServerConnections.isEmpty()) {
+    CSinglyLinkedList<HTTPServerConnection *> connectionsToClose;
+    for(CSinglyLinkedList<HTTPServerConnection *>::Iterator iter = mServerConnections.begin(); iter != mServerConnections.end(); ++iter) {
+      //connections waiting for the answer of a FB don't time out
+      if(0 == (*iter)->mWaitingAt && isTimedOut((*iter)->mLastActivity, scmAcceptedTimeout)) {
+        connectionsToClose.pushBack(*iter);
       }
     }
 
-    for(CSinglyLinkedList<HTTPAcceptedSockets *>::Iterator iter = acceptedToDelete.begin(); iter != acceptedToDelete.end(); ++iter) {
-      for(CSinglyLinkedList<HTTPAcceptedSockets *>::Iterator iter_ = mAcceptedSockets.begin(); iter_ != mAcceptedSockets.end(); ++iter_) {
-        if(*iter_ == *iter) {
-          mAcceptedSockets.erase(*iter_);
-          delete (*iter);
-          break;
-        }
-      }
+    for(CSinglyLinkedList<HTTPServerConnection *>::Iterator iter = connectionsToClose.begin(); iter != connectionsToClose.end(); ++iter) {
+      closeServerConnection(*iter);
     }
   }
 }
@@ -389,6 +534,7 @@ void CHTTP_Handler::openHTTPServer() {
     smServerListeningSocket = CIPComSocketHandler::openTCPServerConnection(address, gHTTPServerPort);
     if(CIPComSocketHandler::scmInvalidSocketDescriptor != smServerListeningSocket) {
       getExtEvHandler<CIPComSocketHandler>().addComCallback(smServerListeningSocket, this);
+      startTimeoutThread();
       DEVLOG_INFO("[HTTP Handler] HTTP server listening on port %u\n", gHTTPServerPort);
     } else {
       DEVLOG_ERROR("[HTTP Handler] Couldn't start HTTP server on port %u\n", gHTTPServerPort);
@@ -424,15 +570,20 @@ void CHTTP_Handler::sendServerAnswerHelper(forte::com_infra::CHttpComLayer* paLa
     mServerMutex.lock();
   }
 
-  for(CSinglyLinkedList<HTTPServerWaiting *>::Iterator iter = mServerLayers.begin(); iter != mServerLayers.end(); ++iter) {
-    if((*iter)->mLayer == paLayer) {
-      CSinglyLinkedList<CIPComSocketHandler::TSocketDescriptor>::Iterator iterSocket = (*iter)->mSockets.begin();
-      if(paAnswer.length() != CIPComSocketHandler::sendDataOnTCP(*iterSocket, paAnswer.getValue(), paAnswer.length())) {
+  HTTPServerWaiting *serverPath = findServerPath(paLayer->getPath().getValue(), paLayer->getPath().length());
+  if(0 != serverPath && !serverPath->mConnections.isEmpty()) {
+    CSinglyLinkedList<HTTPServerConnection *>::Iterator iter = serverPath->mConnections.begin();
+    HTTPServerConnection *connection = *iter;
+    serverPath->mConnections.popFront();
+    if(CIPComSocketHandler::scmInvalidSocketDescriptor != connection->mSocket) {
+      bool sent = (paAnswer.length() == CIPComSocketHandler::sendDataOnTCP(connection->mSocket, paAnswer.getValue(), paAnswer.length()));
+      if(!sent) {
         DEVLOG_ERROR("[HTTP Handler]: Error sending back the answer %s \n", paAnswer.getValue());
       }
-      removeAndCloseSocket(*iterSocket);
-      (*iter)->mSockets.popFront();
-      break;
+      finishServerRequest(*connection, sent);
+    } else {
+      //the client closed the connection while the FB was processing the request
+      delete connection;
     }
   }
 
@@ -448,16 +599,16 @@ void CHTTP_Handler::forceCloseHelper(forte::com_infra::CHttpComLayer* paLayer, b
 
   bool found = false;
 
-  for(CSinglyLinkedList<HTTPServerWaiting *>::Iterator iter = mServerLayers.begin(); iter != mServerLayers.end(); ++iter) {
-    if((*iter)->mLayer == paLayer) {
-      if(!(*iter)->mSockets.isEmpty()) {
-        CSinglyLinkedList<CIPComSocketHandler::TSocketDescriptor>::Iterator itSocket = (*iter)->mSockets.begin();
-        removeAndCloseSocket(*itSocket);
-        (*iter)->mSockets.popFront();
-      }
-      found = true;
-      break;
+  HTTPServerWaiting *serverPath = findServerPath(paLayer->getPath().getValue(), paLayer->getPath().length());
+  if(0 != serverPath && serverPath->mLayer == paLayer) {
+    if(!serverPath->mConnections.isEmpty()) {
+      CSinglyLinkedList<HTTPServerConnection *>::Iterator iter = serverPath->mConnections.begin();
+    HTTPServerConnection *connection = *iter;
+      serverPath->mConnections.popFront();
+      connection->mWaitingAt = 0;
+      closeServerConnection(connection);
     }
+    found = true;
   }
 
   if(!paFromRecv) {
@@ -465,11 +616,10 @@ void CHTTP_Handler::forceCloseHelper(forte::com_infra::CHttpComLayer* paLayer, b
     mClientMutex.lock();
   }
 
-  if(!found && !mClientLayers.isEmpty()) {
-    for(CSinglyLinkedList<HTTPClientWaiting *>::Iterator iter = mClientLayers.begin(); iter != mClientLayers.end(); ++iter) {
-      if((*iter)->mLayer == paLayer) {
-        removeAndCloseSocket((*iter)->mSocket);
-      }
+  if(!found) {
+    HTTPClientConnection *connection = findClientConnection(paLayer, CIPComSocketHandler::scmInvalidSocketDescriptor);
+    if(0 != connection) {
+      closeClientConnection(connection);
     }
   }
 
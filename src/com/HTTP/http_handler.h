@@ -21,7 +21,8 @@
 #include "forte_string.h"
 #include "httplayer.h"
 #include "comCallback.h"
-#include "forte_date_and_time.h"
+#include "httpstreamparser.h"
+#include <forte_architecture_time.h>
 
 // cppcheck-suppress noConstructor
 class CHTTP_Handler : public CExternalEventHandler, public CThread, public forte::com_infra::CComCallback {
@@ -55,6 +56,42 @@ class CHTTP_Handler : public CExternalEventHandler, public CThread, public forte
 
   private:
 
+    struct HTTPServerWaiting;
+
+    //! A connection accepted by the HTTP server. It is kept open between requests unless the client asks to close it
+    struct HTTPServerConnection {
+        explicit HTTPServerConnection(CIPComSocketHandler::TSocketDescriptor paSocket) :
+            mSocket(paSocket), mParser(forte::com_infra::CHttpStreamParser::e_Request), mWaitingAt(0), mLastActivity(getNanoSecondsMonotonic()) {
+        }
+
+        CIPComSocketHandler::TSocketDescriptor mSocket;
+        forte::com_infra::CHttpStreamParser mParser;
+        //! path whose FB has to answer the current request of this connection, 0 if the connection is idle
+        HTTPServerWaiting *mWaitingAt;
+        uint_fast64_t mLastActivity;
+    };
+
+    struct HTTPServerWaiting {
+        forte::com_infra::CHttpComLayer* mLayer;
+        CIEC_STRING mPath;
+        CSinglyLinkedList<HTTPServerConnection*> mConnections; //to handle many connections to the same path, in the order of the requests
+    };
+
+    //! The persistent connection of a client layer to its server
+    struct HTTPClientConnection {
+        explicit HTTPClientConnection(forte::com_infra::CHttpComLayer* paLayer) :
+            mLayer(paLayer), mSocket(CIPComSocketHandler::scmInvalidSocketDescriptor), mParser(forte::com_infra::CHttpStreamParser::e_Response),
+                mPendingResponses(0), mLastActivity(getNanoSecondsMonotonic()) {
+        }
+
+        forte::com_infra::CHttpComLayer* mLayer;
+        CIPComSocketHandler::TSocketDescriptor mSocket;
+        forte::com_infra::CHttpStreamParser mParser;
+        //! number of requests sent on this connection which were not answered yet
+        unsigned int mPendingResponses;
+        uint_fast64_t mLastActivity;
+    };
+
     /**
      * Overridden run() from CThread which loops the UA Server.
      */
@@ -62,7 +99,7 @@ class CHTTP_Handler : public CExternalEventHandler, public CThread, public forte
 
     void checkClientLayers();
 
-    void checkAcceptedSockets();
+    void checkServerConnections();
 
     void startTimeoutThread();
 
@@ -82,55 +119,67 @@ class CHTTP_Handler : public CExternalEventHandler, public CThread, public forte
 
     void forceCloseHelper(forte::com_infra::CHttpComLayer* paLayer, bool paFromRecv);
 
-    bool recvClients(const CIPComSocketHandler::TSocketDescriptor paSocket, const int paRecvLength);
+    bool recvClients(const CIPComSocketHandler::TSocketDescriptor paSocket);
 
     bool recvServers(const CIPComSocketHandler::TSocketDescriptor paSocket);
 
-    void removeSocketFromAccepted(const CIPComSocketHandler::TSocketDescriptor paSocket);
+    void handleClientResponses(HTTPClientConnection &paConnection);
+
+    void closeClientConnection(HTTPClientConnection *paConnection);
+
+    HTTPClientConnection *findClientConnection(const forte::com_infra::CHttpComLayer* paLayer, CIPComSocketHandler::TSocketDescriptor paSocket);
+
+    void handleServerRequests(HTTPServerConnection &paConnection);
+
+    void dispatchServerRequest(HTTPServerConnection &paConnection);
 
-    void handlerReceivedWrongPath(const CIPComSocketHandler::TSocketDescriptor paSocket, CIEC_STRING& paPath);
+    void finishServerRequest(HTTPServerConnection &paConnection, bool paKeepAlive);
+
+    void sendServerError(HTTPServerConnection &paConnection, const char* paStatusLine);
+
+    void closeServerConnection(HTTPServerConnection *paConnection);
+
+    bool isServerConnectionOpen(const HTTPServerConnection *paConnection);
+
+    void handlePipelinedRequests();
+
+    //! Find the entry for a path in the hash table of the server paths
+    HTTPServerWaiting *findServerPath(const char* paPath, size_t paLength);
+
+    static size_t getServerPathBucket(const char* paPath, size_t paLength);
 
     void clearServerLayers();
 
     void clearClientLayers();
 
-    void clearAcceptedSockets();
+    void clearServerConnections();
 
-    struct HTTPServerWaiting {
-        forte::com_infra::CHttpComLayer* mLayer;
-        CIEC_STRING mPath;
-        CSinglyLinkedList<CIPComSocketHandler::TSocketDescriptor> mSockets; //to handle many connections to the same path
-    };
+    static bool isTimedOut(uint_fast64_t paStartTime, unsigned int paTimeoutInSeconds);
 
-    struct HTTPClientWaiting {
-        forte::com_infra::CHttpComLayer* mLayer;
-        CIPComSocketHandler::TSocketDescriptor mSocket;
-        CIEC_DATE_AND_TIME mStartTime;
-    };
+    static const size_t scmNumberOfPathBuckets = 64;
 
-    struct HTTPAcceptedSockets {
-        CIPComSocketHandler::TSocketDescriptor mSocket;
-        CIEC_DATE_AND_TIME mStartTime;
-    };
+    //! hash table of the server paths
+    CSinglyLinkedList<HTTPServerWaiting*> mServerLayers[scmNumberOfPathBuckets];
+    size_t mNumberOfServerPaths;
+
+    //! all connections accepted by the server
+    CSinglyLinkedList<HTTPServerConnection*> mServerConnections;
+
+    //! connections which have further requests buffered after an answer was sent
+    CSinglyLinkedList<HTTPServerConnection*> mPipelinedConnections;
 
-    CSinglyLinkedList<HTTPServerWaiting*> mServerLayers;
     CSyncObject mServerMutex;
 
-    CSinglyLinkedList<HTTPClientWaiting*> mClientLayers;
+    CSinglyLinkedList<HTTPClientConnection*> mClientLayers;
     CSyncObject mClientMutex;
 
-    CSinglyLinkedList<HTTPAcceptedSockets*> mAcceptedSockets;
-    CSyncObject mAcceptedMutex;
-
     CSemaphore mSuspendSemaphore;
 
     static CIPComSocketHandler::TSocketDescriptor smServerListeningSocket;
 
-    static char sRecvBuffer[cg_unIPLayerRecvBufferSize];
-    static unsigned int sBufFillSize;
-
     static const unsigned int scmSendTimeout;
     static const unsigned int scmAcceptedTimeout;
+    static const unsigned int scmClientIdleTimeout;
 
     CSemaphore mThreadStarted;
 };
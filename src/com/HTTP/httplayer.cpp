@@ -9,10 +9,12 @@
  * Contributors:
  *    Marc Jakobi - initial implementation for HTTP clients
  *    Jose Cabral - Merge old HTTPIpLayer to this one and use CIEC_STRING
+ *    agent - transport the data of an upper layer as message body
  ********************************************************************************/
 
 #include "httplayer.h"
 #include "httpparser.h"
+#include "httpstreamparser.h"
 #include "../../arch/devlog.h"
 #include <string.h>
 #include "basecommfb.h"
@@ -22,9 +24,8 @@
 using namespace forte::com_infra;
 
 CHttpComLayer::CHttpComLayer(CComLayer* paUpperLayer, CBaseCommFB* paComFB) :
-    CComLayer(paUpperLayer, paComFB), mInterruptResp(e_Nothing), mRequestType(e_NOTSET), mPort(80), mBufFillSize(0), mCorrectlyInitialized(false),
+    CComLayer(paUpperLayer, paComFB), mInterruptResp(e_Nothing), mRequestType(e_NOTSET), mPort(80), mCorrectlyInitialized(false),
         mHasParameterInSD(false) {
-  memset(mRecvBuffer, 0, sizeof(mRecvBuffer));
 }
 
 CHttpComLayer::~CHttpComLayer() {
@@ -34,10 +35,10 @@ CHttpComLayer::~CHttpComLayer() {
 EComResponse CHttpComLayer::openConnection(char *paLayerParameter) {
   EComResponse eRetVal = e_InitInvalidId;
 
-  if(checkSDsAndRDsType()) {
+  if((0 != m_poTopLayer) || checkSDsAndRDsType()) {
     switch(m_poFb->getComServiceType()){
       case e_Server:
-        if(1 == m_poFb->getNumSD()) {
+        if((0 != m_poTopLayer) || (1 == m_poFb->getNumSD())) {
           mPath = paLayerParameter;
           if(getExtEvHandler<CHTTP_Handler>().addServerPath(this, mPath)) {
             eRetVal = e_InitOk;
@@ -65,7 +66,8 @@ EComResponse CHttpComLayer::openClientConnection(char* paLayerParameter) {
   EComResponse eRetVal = e_InitInvalidId;
   unsigned int numberOfSD = m_poFb->getNumSD();
 
-  if(2 == m_poFb->getNumRD()) {
+  //with an upper layer the SDs and RDs are serialized by it into the request and out of the response body
+  if((0 != m_poTopLayer) || (2 == m_poFb->getNumRD())) {
     CParameterParser parser(paLayerParameter, ';', 3); //IP:PORT;POST|PUT|GET;[content-type]
 
     if(handleContentAndRequestType(parser, parser.parseParameters()) && handleAddress(parser[0], numberOfSD)) {
@@ -73,7 +75,7 @@ EComResponse CHttpComLayer::openClientConnection(char* paLayerParameter) {
       switch(mRequestType){
         case e_PUT:
         case e_POST:
-          if(checkSDInPOSTAndPUT(numberOfSD)) {
+          if(checkSDInPOSTAndPUT((0 != m_poTopLayer) ? 1 : numberOfSD)) {
             CHttpParser::createPutPostRequest(mRequest, mHost, mPath, mReqData, mContentType, mRequestType);
             eRetVal = e_InitOk;
             DEVLOG_INFO("[HTTP Layer] FB with PUT/POST request initialized. Host: %s, Path: %s\n", mHost.getValue(), mPath.getValue());
@@ -206,15 +208,15 @@ bool CHttpComLayer::handleAddress(const char* paAddress, size_t paNoOfSDs) {
   return everythingOK;
 }
 
-EComResponse CHttpComLayer::sendData(void *paData, unsigned int) {
+EComResponse CHttpComLayer::sendData(void *paData, unsigned int paSize) {
   mInterruptResp = e_Nothing;
   if(mCorrectlyInitialized) {
     switch(m_poFb->getComServiceType()){
       case e_Server:
-        sendDataAsServer(paData);
+        sendDataAsServer(paData, paSize);
         break;
       case e_Client:
-        sendDataAsClient(paData);
+        sendDataAsClient(paData, paSize);
         break;
       default:
         // e_Publisher and e_Subscriber
@@ -227,28 +229,27 @@ EComResponse CHttpComLayer::sendData(void *paData, unsigned int) {
   return mInterruptResp;
 }
 
-void CHttpComLayer::sendDataAsServer(const void *paData) {
+void CHttpComLayer::sendDataAsServer(const void *paData, unsigned int paSize) {
   bool error = false;
-  TConstIEC_ANYPtr apoSDs = static_cast<TConstIEC_ANYPtr>(paData);
-  if(!serializeData(apoSDs[0])) {
+  if(0 != m_poTopLayer) {
+    error = !takeUpperLayerData(paData, paSize);
+  } else if(!serializeData(static_cast<TConstIEC_ANYPtr>(paData)[0])) {
     error = true;
-  } else {
-    CHttpParser::createResponse(mRequest, "HTTP/1.1 200 OK", mContentType, mReqData);
   }
   if(error) {
     getExtEvHandler<CHTTP_Handler>().forceClose(this);
     mInterruptResp = e_ProcessDataDataTypeError;
   } else {
+    CHttpParser::createResponse(mRequest, "HTTP/1.1 200 OK", mContentType, mReqData);
     getExtEvHandler<CHTTP_Handler>().sendServerAnswer(this, mRequest);
     mInterruptResp = e_ProcessDataOk;
   }
 }
 
-void CHttpComLayer::sendDataAsClient(const void *paData) {
+void CHttpComLayer::sendDataAsClient(const void *paData, unsigned int paSize) {
   bool error = false;
   if(mHasParameterInSD) {
-    TConstIEC_ANYPtr apoSDs = static_cast<TConstIEC_ANYPtr>(paData);
-    if(!serializeData(apoSDs[0])) {
+    if((0 != m_poTopLayer) ? !takeUpperLayerData(paData, paSize) : !serializeData(static_cast<TConstIEC_ANYPtr>(paData)[0])) {
       error = true;
       DEVLOG_ERROR("[HTTP Layer] Error in data serialization\n");
     } else {
@@ -274,7 +275,6 @@ void CHttpComLayer::sendDataAsClient(const void *paData) {
 EComResponse CHttpComLayer::recvData(const void *paData, unsigned int paSize) {
   mInterruptResp = e_Nothing;
   if(mCorrectlyInitialized) {
-    memcpy(mRecvBuffer, paData, (paSize > cg_unIPLayerRecvBufferSize) ? cg_unIPLayerRecvBufferSize : paSize);
     switch(m_poFb->getComServiceType()){
       case e_Server:
         DEVLOG_ERROR("[HTTP Layer] Receiving raw data as a Server? That's wrong, use the recvServerData function\n");
@@ -283,11 +283,17 @@ EComResponse CHttpComLayer::recvData(const void *paData, unsigned int paSize) {
         if(0 == paData) { //timeout occurred
           mInterruptResp = e_ProcessDataRecvFaild;
         } else {
-          if(e_ProcessDataOk != (mInterruptResp = handleHTTPResponse(mRecvBuffer))) {
-            DEVLOG_ERROR("[HTTP Layer] FB with host: %s:%u couldn't handle the HTTP response\n", mHost.getValue(), mPort);
-          } else {
-            //TODO Trigger event?
+          //a complete response given as raw data
+          CHttpStreamParser parser(CHttpStreamParser::e_Response, paSize);
+          CHttpStreamParser::EParseResult result = parser.append(static_cast<const char *>(paData), paSize);
+          if(CHttpStreamParser::e_NeedMoreData == result) {
+            result = parser.endOfStream();
+          }
+          if(CHttpStreamParser::e_MessageComplete == result) {
+            return recvClientData(parser);
           }
+          DEVLOG_ERROR("[HTTP Layer] FB with host: %s:%u couldn't handle the HTTP response\n", mHost.getValue(), mPort);
+          mInterruptResp = e_ProcessDataRecvFaild;
         }
         break;
       default:
@@ -296,27 +302,61 @@ EComResponse CHttpComLayer::recvData(const void *paData, unsigned int paSize) {
   } else {
     DEVLOG_ERROR("[HTTP Layer]The FB is not initialized\n");
   }
+  return mInterruptResp;
+}
+
+EComResponse CHttpComLayer::recvClientData(const CHttpStreamParser &paResponse) {
+  mInterruptResp = e_Nothing;
+  if(mCorrectlyInitialized) {
+    if(e_ProcessDataOk != (mInterruptResp = handleHTTPResponse(paResponse))) {
+      DEVLOG_ERROR("[HTTP Layer] FB with host: %s:%u couldn't handle the HTTP response\n", mHost.getValue(), mPort);
+    }
+  } else {
+    DEVLOG_ERROR("[HTTP Layer]The FB is not initialized\n");
+  }
   if(e_ProcessDataOk == mInterruptResp) {
     m_poFb->interruptCommFB(this);
   }
   return mInterruptResp;
 }
 
-EComResponse forte::com_infra::CHttpComLayer::recvServerData(CSinglyLinkedList<CIEC_STRING>&, CSinglyLinkedList<CIEC_STRING>& paParameterValues) {
-  //for now, the parameterNames are not taken in account, and the parameters are put in the same order they arrived
+EComResponse CHttpComLayer::recvServerData(const CHttpStreamParser &paRequest) {
+  //for now, the parameter names are not taken in account, and the parameters are put in the same order they arrived
 
   mInterruptResp = e_Nothing;
   bool failed = false;
   if(0 < m_poFb->getNumSD()) {
+    CHttpStreamParser::SSpan query = paRequest.getQuery();
+    CHttpStreamParser::SSpan name;
+    CHttpStreamParser::SSpan value;
     unsigned int noOfParameters = 0;
-    for(CSinglyLinkedList<CIEC_STRING>::Iterator iter = paParameterValues.begin(); iter != paParameterValues.end(); ++iter) {
-      noOfParameters++;
+    if(CHttpComLayer::e_GET == paRequest.getRequestType()) {
+      while(CHttpStreamParser::getNextQueryParameter(query, name, value)) {
+        if(0 == value.mData) { //parameters without value are treated as wrong parameters
+          noOfParameters = 0;
+          break;
+        }
+        noOfParameters++;
+      }
+    } else {
+      noOfParameters = 1; //the content of PUT and POST requests
     }
 
-    if(noOfParameters == m_poFb->getNumRD()) {
-      noOfParameters = 0;
-      for(CSinglyLinkedList<CIEC_STRING>::Iterator iter = paParameterValues.begin(); iter != paParameterValues.end(); ++iter) {
-        m_poFb->getRDs()[noOfParameters++].setValue(*iter);
+    if(0 != m_poTopLayer) {
+      //the upper layer deserializes the body into the RDs
+      if(CHttpComLayer::e_GET != paRequest.getRequestType()
+        && e_ProcessDataOk != m_poTopLayer->recvData(paRequest.getBody().mData, static_cast<unsigned int>(paRequest.getBody().mLength))) {
+        DEVLOG_ERROR("[HTTP Layer] FB with path %s couldn't take the request body\n", mPath.getValue());
+        failed = true;
+      }
+    } else if(noOfParameters == m_poFb->getNumRD()) {
+      if(CHttpComLayer::e_GET == paRequest.getRequestType()) {
+        query = paRequest.getQuery();
+        for(unsigned int i = 0; CHttpStreamParser::getNextQueryParameter(query, name, value); i++) {
+          setReceivedValue(m_poFb->getRDs()[i], value.mData, value.mLength);
+        }
+      } else {
+        setReceivedValue(m_poFb->getRDs()[0], paRequest.getBody().mData, paRequest.getBody().mLength);
       }
     } else {
       DEVLOG_ERROR("[HTTP Layer] FB with path %s received a number of parameters of %u, while it has %u SDs\n", mPath.getValue(),
@@ -341,23 +381,38 @@ EComResponse forte::com_infra::CHttpComLayer::recvServerData(CSinglyLinkedList<C
   return mInterruptResp;
 }
 
-EComResponse CHttpComLayer::handleHTTPResponse(char *paData) {
+EComResponse CHttpComLayer::handleHTTPResponse(const CHttpStreamParser &paResponse) {
   DEVLOG_DEBUG("[HTTP Layer] Handling received HTTP response\n");
   EComResponse eRetVal = e_ProcessDataRecvFaild;
-  if(m_poFb != 0) {
+  if((m_poFb != 0) && (0 != m_poTopLayer)) {
+    const CHttpStreamParser::SSpan &statusCode = paResponse.getStatusCode();
+    if((0 != statusCode.mLength) && ('2' == statusCode.mData[0])) {
+      eRetVal = m_poTopLayer->recvData(paResponse.getBody().mData, static_cast<unsigned int>(paResponse.getBody().mLength));
+    } else {
+      DEVLOG_ERROR("[HTTP Layer] Request failed with status %.*s\n", static_cast<int>(statusCode.mLength), statusCode.mData);
+    }
+  } else if(m_poFb != 0) {
     CIEC_ANY* apoRDs = m_poFb->getRDs();
-    // Interpret HTTP response and set output status according to success/failure.
-    CIEC_STRING responseCode;
-    CIEC_STRING output;
-    CHttpParser::parseResponse(output, responseCode, paData) ? eRetVal = e_ProcessDataOk : eRetVal = e_ProcessDataRecvFaild;
-    apoRDs[0].fromString(responseCode.getValue());
-    apoRDs[1].fromString(output.getValue());
+    setReceivedValue(apoRDs[0], paResponse.getStatusCode().mData, paResponse.getStatusCode().mLength);
+    setReceivedValue(apoRDs[1], paResponse.getBody().mData, paResponse.getBody().mLength);
+    eRetVal = e_ProcessDataOk;
   } else {
     DEVLOG_ERROR("[HTTP Layer] No FB defined\n");
   }
   return eRetVal;
 }
 
+void CHttpComLayer::setReceivedValue(CIEC_ANY &paRD, const char *paValue, size_t paLength) {
+  TForteUInt16 length = static_cast<TForteUInt16>((paLength > CIEC_STRING::scm_unMaxStringLen) ? CIEC_STRING::scm_unMaxStringLen : paLength);
+  if(CIEC_ANY::e_STRING == paRD.getDataTypeID()) {
+    static_cast<CIEC_STRING &>(paRD).assign(paValue, length);
+  } else {
+    CIEC_STRING value;
+    value.assign(paValue, length);
+    paRD.fromString(value.getValue());
+  }
+}
+
 EComResponse CHttpComLayer::processInterrupt() {
   mInterruptResp = e_ProcessDataOk;
   return mInterruptResp;
@@ -370,6 +425,15 @@ void CHttpComLayer::closeConnection() {
   getExtEvHandler<CHTTP_Handler>().forceClose(this);
 }
 
+bool CHttpComLayer::takeUpperLayerData(const void *paData, unsigned int paSize) {
+  if(paSize > CIEC_STRING::scm_unMaxStringLen) {
+    DEVLOG_ERROR("[HTTP Layer] The data of %u bytes is too large for a message body\n", paSize);
+    return false;
+  }
+  mReqData.assign(static_cast<const char *>(paData), static_cast<TForteUInt16>(paSize));
+  return true;
+}
+
 bool CHttpComLayer::serializeData(const CIEC_ANY& paCIECData) {
   size_t bufferSize = paCIECData.getToStringBufferSize();
   mReqData.reserve(static_cast<TForteUInt16>(bufferSize));
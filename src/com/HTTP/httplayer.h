@@ -9,6 +9,7 @@
  * Contributors:
  *    Marc Jakobi - initial implementation for HTTP clients
  *    Jose Cabral - Merge old HTTPIpLayer to this one and use CIEC_STRING
+ *    agent - transport the data of an upper layer as message body
  ********************************************************************************/
 
 #ifndef _HTTPCOMLAYER_H_
@@ -25,6 +26,13 @@ namespace forte {
 
   namespace com_infra {
 
+    class CHttpStreamParser;
+
+    /**
+     * HTTP client and server layer. On top of the stack the SDs and RDs are STRINGs taking the message bodies, the
+     * client has the status code as first RD. With an upper layer (e.g., json[].http[...]) the layer instead
+     * transports the data serialized by the upper layer as body and hands received bodies to it.
+     */
     class CHttpComLayer : public CComLayer {
       public:
         CHttpComLayer(CComLayer* paUpperLayer, CBaseCommFB* paComFB);
@@ -33,7 +41,17 @@ namespace forte {
         EComResponse sendData(void *paData, unsigned int paSize); // top interface, called from top
         EComResponse recvData(const void *paData, unsigned int paSize);
 
-        EComResponse recvServerData(CSinglyLinkedList<CIEC_STRING>& paParameterNames, CSinglyLinkedList<CIEC_STRING>& paParameterValues);
+        /**
+         * Handle a request received by the HTTP server for the path of this layer
+         * @param paRequest the parsed request, the GET parameters or the PUT/POST body are set to the RDs
+         */
+        EComResponse recvServerData(const CHttpStreamParser &paRequest);
+
+        /**
+         * Handle the response to a request sent by this client
+         * @param paResponse the parsed response, status code and body are set to the RDs
+         */
+        EComResponse recvClientData(const CHttpStreamParser &paResponse);
 
         EComResponse openConnection(char* paLayerParameter);
 
@@ -57,21 +75,31 @@ namespace forte {
 
         TForteUInt16 getPort() const;
 
+        const CIEC_STRING& getPath() const {
+          return mPath;
+        }
+
       private:
 
         /**
-         * Parse the HTTP response and checks the returned code
-         * @param paData buffer with the HTTP response
-         * @return OK if return code is as expected
+         * Set the RDs from the parsed HTTP response
+         * @param paResponse the complete HTTP response
+         * @return OK if the FB could take the response
          */
-        EComResponse handleHTTPResponse(char *paData);
+        EComResponse handleHTTPResponse(const CHttpStreamParser &paResponse);
+
+        /** Set a received value, which is not null terminated, to an RD */
+        static void setReceivedValue(CIEC_ANY &paRD, const char *paValue, size_t paLength);
 
         /** Serializes the data to a char* */
         bool serializeData(const CIEC_ANY& paCIECData);
 
-        void sendDataAsServer(const void *paData);
+        /** Takes the serialized data of the upper layer as data to be sent */
+        bool takeUpperLayerData(const void *paData, unsigned int paSize);
 
-        void sendDataAsClient(const void *paData);
+        void sendDataAsServer(const void *paData, unsigned int paSize);
+
+        void sendDataAsClient(const void *paData, unsigned int paSize);
 
         EComResponse openClientConnection(char* paLayerParameter);
 
@@ -100,9 +128,6 @@ namespace forte {
         /** Request  to be sent to Host */
         CIEC_STRING mRequest;
 
-        char mRecvBuffer[cg_unIPLayerRecvBufferSize];
-        unsigned int mBufFillSize;
-
         CIEC_STRING mContentType;
 
         bool mCorrectlyInitialized;
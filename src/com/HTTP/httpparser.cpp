@@ -140,7 +140,9 @@ void forte::com_infra::CHttpParser::createResponse(CIEC_STRING& paDest, const CI
     const CIEC_STRING& paData) {
   paDest = paResult;
   if(paData.empty()) {
-    paDest.append("\r\n");
+    //the length is needed so that the client finds the end of the response on a persistent connection
+    paDest.append("\r\nContent-length: 0");
+    CHttpParser::addHeaderEnding(paDest);
   } else {
     paDest.append("\r\nContent-type: ");
     paDest.append(paContentType.getValue());
@@ -0,0 +1,451 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *    agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+
+#include "httpstreamparser.h"
+#include <string.h>
+#include <ctype.h>
+#include "devlog.h"
+
+using namespace forte::com_infra;
+
+namespace {
+  bool equalsIgnoreCase(const char *paData, size_t paLength, const char *paLowerCase) {
+    for(size_t i = 0; i < paLength; i++) {
+      if('\0' == paLowerCase[i] || tolower(static_cast<unsigned char>(paData[i])) != paLowerCase[i]) {
+        return false;
+      }
+    }
+    return '\0' == paLowerCase[paLength];
+  }
+
+  bool endsWithIgnoreCase(const char *paData, size_t paLength, const char *paLowerCase) {
+    size_t suffixLength = strlen(paLowerCase);
+    return (paLength >= suffixLength) && equalsIgnoreCase(paData + paLength - suffixLength, suffixLength, paLowerCase);
+  }
+
+  //! parse a decimal or hexadecimal size, returns false on invalid characters or overflow
+  bool parseSize(const char *paData, size_t paLength, unsigned int paBase, size_t &paResult) {
+    paResult = 0;
+    if(0 == paLength) {
+      return false;
+    }
+    for(size_t i = 0; i < paLength; i++) {
+      unsigned int digit;
+      char current = static_cast<char>(tolower(static_cast<unsigned char>(paData[i])));
+      if('0' <= current && '9' >= current) {
+        digit = static_cast<unsigned int>(current - '0');
+      } else if(16 == paBase && 'a' <= current && 'f' >= current) {
+        digit = static_cast<unsigned int>(current - 'a' + 10);
+      } else {
+        return false;
+      }
+      if(paResult > (static_cast<size_t>(-1) - digit) / paBase) {
+        return false;
+      }
+      paResult = paResult * paBase + digit;
+    }
+    return true;
+  }
+}
+
+bool CHttpStreamParser::SSpan::equals(const char *paString) const {
+  return (0 != mData) && (strlen(paString) == mLength) && (0 == memcmp(mData, paString, mLength));
+}
+
+CHttpStreamParser::CHttpStreamParser(EMessageType paType, size_t paBufferSize) :
+    mType(paType), mBuffer(new char[paBufferSize]), mBufferSize(paBufferSize), mFillSize(0) {
+  clearMessage();
+}
+
+CHttpStreamParser::~CHttpStreamParser() {
+  delete[] mBuffer;
+}
+
+void CHttpStreamParser::receivedData(size_t paSize) {
+  mFillSize += (paSize > getFreeBufferSize()) ? getFreeBufferSize() : paSize;
+}
+
+CHttpStreamParser::EParseResult CHttpStreamParser::append(const char *paData, size_t paSize) {
+  if(paSize > getFreeBufferSize()) {
+    return e_MessageTooLarge;
+  }
+  memcpy(getFreeBuffer(), paData, paSize);
+  receivedData(paSize);
+  return parse();
+}
+
+CHttpStreamParser::EParseResult CHttpStreamParser::parse() {
+  EParseResult result = e_NeedMoreData;
+  if(e_Header == mState) {
+    result = parseHeader();
+  }
+
+  switch(mState){
+    case e_Header:
+      break;
+    case e_Body:
+      if(mFillSize - mBodyStart >= mContentLength) {
+        mBodyEnd = mBodyStart + mContentLength;
+        completeMessage(mBodyEnd);
+        result = e_MessageComplete;
+      } else {
+        result = e_NeedMoreData;
+      }
+      break;
+    case e_BodyUntilClose:
+      result = (0 == getFreeBufferSize()) ? e_MessageTooLarge : e_NeedMoreData;
+      break;
+    case e_ChunkSize:
+    case e_ChunkData:
+    case e_ChunkDataEnd:
+    case e_ChunkTrailer:
+      result = parseChunked();
+      break;
+    case e_Complete:
+      result = e_MessageComplete;
+      break;
+    case e_Error:
+      if(e_MessageTooLarge != result) {
+        result = e_ParseError;
+      }
+      break;
+  }
+  return result;
+}
+
+CHttpStreamParser::EParseResult CHttpStreamParser::endOfStream() {
+  if(e_BodyUntilClose == mState) {
+    mBodyEnd = mFillSize;
+    completeMessage(mFillSize);
+  }
+  EParseResult result = parse();
+  if(e_NeedMoreData == result && hasBufferedData()) {
+    //the connection was closed in the middle of a message
+    result = e_ParseError;
+  }
+  return result;
+}
+
+void CHttpStreamParser::consumeMessage() {
+  if(e_Complete == mState) {
+    removeFromBuffer(0, mMessageEnd);
+    clearMessage();
+  } else {
+    reset();
+  }
+}
+
+void CHttpStreamParser::reset() {
+  mFillSize = 0;
+  clearMessage();
+}
+
+bool CHttpStreamParser::getNextQueryParameter(SSpan &paQuery, SSpan &paName, SSpan &paValue) {
+  if(0 == paQuery.mLength) {
+    return false;
+  }
+  const char *queryEnd = paQuery.mData + paQuery.mLength;
+  const char *parameterEnd = static_cast<const char *>(memchr(paQuery.mData, '&', paQuery.mLength));
+  if(0 == parameterEnd) {
+    parameterEnd = queryEnd;
+  }
+
+  paName.mData = paQuery.mData;
+  paName.mLength = static_cast<size_t>(parameterEnd - paQuery.mData);
+  const char *equalSign = static_cast<const char *>(memchr(paName.mData, '=', paName.mLength));
+  if(0 != equalSign) {
+    paName.mLength = static_cast<size_t>(equalSign - paName.mData);
+    paValue.mData = equalSign + 1;
+    paValue.mLength = static_cast<size_t>(parameterEnd - paValue.mData);
+  } else {
+    paValue.mData = 0;
+    paValue.mLength = 0;
+  }
+
+  paQuery.mData = (parameterEnd == queryEnd) ? queryEnd : parameterEnd + 1;
+  paQuery.mLength = static_cast<size_t>(queryEnd - paQuery.mData);
+  return true;
+}
+
+CHttpStreamParser::EParseResult CHttpStreamParser::parseHeader() {
+  //empty lines before the start line are ignored (e.g., a CRLF sent by clients after a request body)
+  while(0 == mScanPosition && 2 <= mFillSize && '\r' == mBuffer[0] && '\n' == mBuffer[1]) {
+    removeFromBuffer(0, 2);
+  }
+
+  size_t headerEnd = 0;
+  for(size_t i = mScanPosition; i + 3 < mFillSize; i++) {
+    if('\r' == mBuffer[i] && '\n' == mBuffer[i + 1] && '\r' == mBuffer[i + 2] && '\n' == mBuffer[i + 3]) {
+      headerEnd = i + 2;
+      break;
+    }
+  }
+
+  if(0 == headerEnd) {
+    mScanPosition = (3 < mFillSize) ? mFillSize - 3 : 0;
+    return (0 == getFreeBufferSize()) ? e_MessageTooLarge : e_NeedMoreData;
+  }
+
+  char *lineStart = mBuffer;
+  char *lineEnd = findLineEnd(0);
+  if(!parseStartLine(lineStart, static_cast<size_t>(lineEnd - lineStart))) {
+    mState = e_Error;
+    return e_ParseError;
+  }
+  lineStart = lineEnd + 2;
+  while(lineStart < mBuffer + headerEnd) {
+    lineEnd = findLineEnd(static_cast<size_t>(lineStart - mBuffer));
+    if(!parseHeaderField(lineStart, static_cast<size_t>(lineEnd - lineStart))) {
+      mState = e_Error;
+      return e_ParseError;
+    }
+    lineStart = lineEnd + 2;
+  }
+
+  mBodyStart = headerEnd + 2;
+  mBodyEnd = mBodyStart;
+  if(!startBody()) {
+    mState = e_Error;
+    return e_MessageTooLarge;
+  }
+  return e_NeedMoreData;
+}
+
+bool CHttpStreamParser::parseStartLine(char *paLine, size_t paLength) {
+  char *lineEnd = paLine + paLength;
+  char *firstSpace = static_cast<char *>(memchr(paLine, ' ', paLength));
+  if(0 == firstSpace) {
+    DEVLOG_ERROR("[HTTP Parser] Invalid HTTP start line. No space found\n");
+    return false;
+  }
+
+  const char *version;
+  size_t versionLength;
+  if(e_Request == mType) {
+    size_t methodLength = static_cast<size_t>(firstSpace - paLine);
+    if(3 == methodLength && 0 == memcmp(paLine, "GET", 3)) {
+      mRequestType = CHttpComLayer::e_GET;
+    } else if(3 == methodLength && 0 == memcmp(paLine, "PUT", 3)) {
+      mRequestType = CHttpComLayer::e_PUT;
+    } else if(4 == methodLength && 0 == memcmp(paLine, "POST", 4)) {
+      mRequestType = CHttpComLayer::e_POST;
+    } else {
+      mRequestType = CHttpComLayer::e_NOTSET;
+    }
+
+    char *target = firstSpace + 1;
+    char *targetEnd = static_cast<char *>(memchr(target, ' ', static_cast<size_t>(lineEnd - target)));
+    if(0 == targetEnd || target == targetEnd) {
+      DEVLOG_ERROR("[HTTP Parser] Invalid HTTP request. No space after path found\n");
+      return false;
+    }
+    char *queryStart = static_cast<char *>(memchr(target, '?', static_cast<size_t>(targetEnd - target)));
+    mPath.mData = target;
+    if(0 != queryStart) {
+      mPath.mLength = static_cast<size_t>(queryStart - target);
+      mQuery.mData = queryStart + 1;
+      mQuery.mLength = static_cast<size_t>(targetEnd - mQuery.mData);
+    } else {
+      mPath.mLength = static_cast<size_t>(targetEnd - target);
+    }
+    version = targetEnd + 1;
+    versionLength = static_cast<size_t>(lineEnd - version);
+  } else {
+    //HTTP-Version SP Status-Code SP Reason-Phrase
+    version = paLine;
+    versionLength = static_cast<size_t>(firstSpace - paLine);
+    mStatusCode.mData = firstSpace + 1;
+    mStatusCode.mLength = 3;
+    if(mStatusCode.mData + 3 > lineEnd || !isdigit(static_cast<unsigned char>(mStatusCode.mData[0])) || !isdigit(static_cast<unsigned char>(mStatusCode.mData[1]))
+      || !isdigit(static_cast<unsigned char>(mStatusCode.mData[2])) || (mStatusCode.mData + 3 != lineEnd && ' ' != mStatusCode.mData[3])) {
+      DEVLOG_ERROR("[HTTP Parser] Invalid HTTP response. The status line is not well defined\n");
+      return false;
+    }
+  }
+
+  if(versionLength < 8 || 0 != memcmp(version, "HTTP/1.", 7)) {
+    DEVLOG_ERROR("[HTTP Parser] Unsupported HTTP version\n");
+    return false;
+  }
+  //HTTP/1.0 connections are closed after each message unless keep-alive is requested
+  mKeepAlive = ('0' != version[7]);
+  return true;
+}
+
+bool CHttpStreamParser::parseHeaderField(char *paLine, size_t paLength) {
+  char *colon = static_cast<char *>(memchr(paLine, ':', paLength));
+  if(0 == colon) {
+    DEVLOG_ERROR("[HTTP Parser] Invalid HTTP header field\n");
+    return false;
+  }
+  size_t nameLength = static_cast<size_t>(colon - paLine);
+  const char *value = colon + 1;
+  const char *valueEnd = paLine + paLength;
+  while(value < valueEnd && (' ' == *value || '\t' == *value)) {
+    value++;
+  }
+  while(valueEnd > value && (' ' == valueEnd[-1] || '\t' == valueEnd[-1])) {
+    valueEnd--;
+  }
+  size_t valueLength = static_cast<size_t>(valueEnd - value);
+
+  if(equalsIgnoreCase(paLine, nameLength, "content-length")) {
+    if(!parseSize(value, valueLength, 10, mContentLength)) {
+      DEVLOG_ERROR("[HTTP Parser] Invalid Content-Length\n");
+      return false;
+    }
+    mHasContentLength = true;
+  } else if(equalsIgnoreCase(paLine, nameLength, "transfer-encoding")) {
+    mChunked = endsWithIgnoreCase(value, valueLength, "chunked");
+  } else if(equalsIgnoreCase(paLine, nameLength, "connection")) {
+    if(equalsIgnoreCase(value, valueLength, "close")) {
+      mKeepAlive = false;
+    } else if(equalsIgnoreCase(value, valueLength, "keep-alive")) {
+      mKeepAlive = true;
+    }
+  }
+  return true;
+}
+
+bool CHttpStreamParser::startBody() {
+  if(mChunked) {
+    mState = e_ChunkSize;
+  } else if(mHasContentLength) {
+    if(mContentLength > mBufferSize - mBodyStart) {
+      DEVLOG_ERROR("[HTTP Parser] HTTP message with a body of %u bytes doesn't fit in the receive buffer\n", static_cast<unsigned int>(mContentLength));
+      return false;
+    }
+    mState = e_Body;
+  } else if(e_Request == mType || '1' == mStatusCode.mData[0] || mStatusCode.equals("204") || mStatusCode.equals("304")) {
+    completeMessage(mBodyStart);
+  } else {
+    //the end of the body is given by the end of the connection
+    mKeepAlive = false;
+    mState = e_BodyUntilClose;
+  }
+  return true;
+}
+
+CHttpStreamParser::EParseResult CHttpStreamParser::parseChunked() {
+  //the chunk framing is removed from the buffer while parsing, so the body is contiguous from mBodyStart to mBodyEnd
+  while(e_Complete != mState) {
+    switch(mState){
+      case e_ChunkSize: {
+        char *lineEnd = findLineEnd(mBodyEnd);
+        if(0 == lineEnd) {
+          return (0 == getFreeBufferSize()) ? e_MessageTooLarge : e_NeedMoreData;
+        }
+        const char *sizeStart = mBuffer + mBodyEnd;
+        size_t sizeLength = 0;
+        while(sizeStart + sizeLength < lineEnd && ';' != sizeStart[sizeLength] && ' ' != sizeStart[sizeLength]) {
+          sizeLength++;
+        }
+        if(!parseSize(sizeStart, sizeLength, 16, mContentLength)) {
+          DEVLOG_ERROR("[HTTP Parser] Invalid chunk size\n");
+          mState = e_Error;
+          return e_ParseError;
+        }
+        removeFromBuffer(mBodyEnd, static_cast<size_t>(lineEnd - sizeStart) + 2);
+        if(0 == mContentLength) {
+          mState = e_ChunkTrailer;
+        } else if(mContentLength > mBufferSize - mBodyEnd) {
+          mState = e_Error;
+          return e_MessageTooLarge;
+        } else {
+          mState = e_ChunkData;
+        }
+        break;
+      }
+      case e_ChunkData: {
+        size_t available = mFillSize - mBodyEnd;
+        if(available < mContentLength) {
+          mBodyEnd += available;
+          mContentLength -= available;
+          return (0 == getFreeBufferSize()) ? e_MessageTooLarge : e_NeedMoreData;
+        }
+        mBodyEnd += mContentLength;
+        mContentLength = 0;
+        mState = e_ChunkDataEnd;
+        break;
+      }
+      case e_ChunkDataEnd:
+        if(mFillSize - mBodyEnd < 2) {
+          return e_NeedMoreData;
+        }
+        if('\r' != mBuffer[mBodyEnd] || '\n' != mBuffer[mBodyEnd + 1]) {
+          DEVLOG_ERROR("[HTTP Parser] Chunk data is not terminated by CRLF\n");
+          mState = e_Error;
+          return e_ParseError;
+        }
+        removeFromBuffer(mBodyEnd, 2);
+        mState = e_ChunkSize;
+        break;
+      case e_ChunkTrailer: {
+        char *lineEnd = findLineEnd(mBodyEnd);
+        if(0 == lineEnd) {
+          return (0 == getFreeBufferSize()) ? e_MessageTooLarge : e_NeedMoreData;
+        }
+        bool emptyLine = (lineEnd == mBuffer + mBodyEnd);
+        removeFromBuffer(mBodyEnd, static_cast<size_t>(lineEnd - (mBuffer + mBodyEnd)) + 2);
+        if(emptyLine) {
+          completeMessage(mBodyEnd);
+        }
+        break;
+      }
+      default:
+        return e_ParseError;
+    }
+  }
+  return e_MessageComplete;
+}
+
+void CHttpStreamParser::removeFromBuffer(size_t paStart, size_t paLength) {
+  memmove(mBuffer + paStart, mBuffer + paStart + paLength, mFillSize - paStart - paLength);
+  mFillSize -= paLength;
+}
+
+char *CHttpStreamParser::findLineEnd(size_t paStart) const {
+  for(size_t i = paStart; i + 1 < mFillSize; i++) {
+    if('\r' == mBuffer[i] && '\n' == mBuffer[i + 1]) {
+      return mBuffer + i;
+    }
+  }
+  return 0;
+}
+
+void CHttpStreamParser::completeMessage(size_t paMessageEnd) {
+  mMessageEnd = paMessageEnd;
+  mBody.mData = mBuffer + mBodyStart;
+  mBody.mLength = mBodyEnd - mBodyStart;
+  mState = e_Complete;
+}
+
+void CHttpStreamParser::clearMessage() {
+  mState = e_Header;
+  mScanPosition = 0;
+  mBodyStart = 0;
+  mBodyEnd = 0;
+  mContentLength = 0;
+  mMessageEnd = 0;
+  mChunked = false;
+  mHasContentLength = false;
+  mKeepAlive = true;
+  mRequestType = CHttpComLayer::e_NOTSET;
+  mPath.mData = 0;
+  mPath.mLength = 0;
+  mQuery.mData = 0;
+  mQuery.mLength = 0;
+  mStatusCode.mData = 0;
+  mStatusCode.mLength = 0;
+  mBody.mData = 0;
+  mBody.mLength = 0;
+}
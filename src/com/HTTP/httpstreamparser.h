@@ -0,0 +1,207 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *    agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+
+#ifndef _HTTPSTREAMPARSER_H_
+#define _HTTPSTREAMPARSER_H_
+
+#include <forte_config.h>
+#include <stddef.h>
+#include "httplayer.h"
+
+namespace forte {
+
+  namespace com_infra {
+
+    /**
+     * Incremental parser for the HTTP/1.x messages received on one connection.
+     *
+     * The parser owns the receive buffer of the connection. Data is received directly into the free part of the buffer
+     * and the message is parsed in place, so that partial reads, pipelined messages, Content-Length and chunked bodies
+     * are handled without copying the message. The parsed elements are given as spans pointing into the buffer, which
+     * are valid until consumeMessage() is called.
+     */
+    class CHttpStreamParser {
+      public:
+        enum EMessageType {
+          e_Request,
+          e_Response
+        };
+
+        enum EParseResult {
+          /** The message is not complete yet */
+          e_NeedMoreData,
+          /** A complete message is available */
+          e_MessageComplete,
+          /** The received data is not a valid HTTP message */
+          e_ParseError,
+          /** The message doesn't fit into the buffer */
+          e_MessageTooLarge
+        };
+
+        /** A part of the received message. Not null terminated */
+        struct SSpan {
+            const char *mData;
+            size_t mLength;
+
+            bool equals(const char *paString) const;
+        };
+
+        explicit CHttpStreamParser(EMessageType paType, size_t paBufferSize = cg_unIPLayerRecvBufferSize);
+        ~CHttpStreamParser();
+
+        /** Place where new data should be received to */
+        char *getFreeBuffer() {
+          return mBuffer + mFillSize;
+        }
+
+        size_t getFreeBufferSize() const {
+          return mBufferSize - mFillSize;
+        }
+
+        /**
+         * Inform the parser that data was written to the free buffer
+         * @param paSize number of bytes written to getFreeBuffer()
+         */
+        void receivedData(size_t paSize);
+
+        /**
+         * Copy data into the buffer and parse it
+         * @param paData received data
+         * @param paSize size of the received data
+         * @return state of the current message
+         */
+        EParseResult append(const char *paData, size_t paSize);
+
+        /**
+         * Continue parsing the buffered data
+         * @return state of the current message
+         */
+        EParseResult parse();
+
+        /**
+         * Inform the parser that the peer closed the connection. This completes responses whose body is delimited by
+         * the end of the connection
+         * @return state of the current message
+         */
+        EParseResult endOfStream();
+
+        /** Remove the current complete message from the buffer, keeping any data received after it */
+        void consumeMessage();
+
+        /** Drop all buffered data */
+        void reset();
+
+        bool hasBufferedData() const {
+          return 0 != mFillSize;
+        }
+
+        /** Request type of a parsed request */
+        CHttpComLayer::ERequestType getRequestType() const {
+          return mRequestType;
+        }
+
+        /** Path of a parsed request without the query */
+        const SSpan &getPath() const {
+          return mPath;
+        }
+
+        /** Query of a parsed request without the leading '?' */
+        const SSpan &getQuery() const {
+          return mQuery;
+        }
+
+        /** Status code of a parsed response as text */
+        const SSpan &getStatusCode() const {
+          return mStatusCode;
+        }
+
+        /** Body of the message with the chunked encoding already removed */
+        const SSpan &getBody() const {
+          return mBody;
+        }
+
+        /** If the connection can be used for further messages after this one */
+        bool isKeepAlive() const {
+          return mKeepAlive;
+        }
+
+        /**
+         * Split the next name=value pair from a query
+         * @param paQuery the remaining query, which is advanced to the next parameter
+         * @param paName place to store the name of the parameter
+         * @param paValue place to store the value of the parameter. mData is 0 if the parameter has no '='
+         * @return false if the query has no more parameters
+         */
+        static bool getNextQueryParameter(SSpan &paQuery, SSpan &paName, SSpan &paValue);
+
+      private:
+        enum EState {
+          e_Header,
+          e_Body,
+          e_BodyUntilClose,
+          e_ChunkSize,
+          e_ChunkData,
+          e_ChunkDataEnd,
+          e_ChunkTrailer,
+          e_Complete,
+          e_Error
+        };
+
+        EParseResult parseHeader();
+        EParseResult parseChunked();
+
+        bool parseStartLine(char *paLine, size_t paLength);
+        bool parseHeaderField(char *paLine, size_t paLength);
+        bool startBody();
+
+        /** Removes paLength bytes at position paStart of the buffer */
+        void removeFromBuffer(size_t paStart, size_t paLength);
+
+        /** Find a "\r\n" in the buffer starting at paStart, returns 0 if not found */
+        char *findLineEnd(size_t paStart) const;
+
+        void completeMessage(size_t paMessageEnd);
+
+        void clearMessage();
+
+        EMessageType mType;
+
+        char *mBuffer;
+        size_t mBufferSize;
+        size_t mFillSize;
+
+        EState mState;
+        /** position up to where the data was already searched for the end of the header */
+        size_t mScanPosition;
+        size_t mBodyStart;
+        /** end of the (dechunked) body received so far */
+        size_t mBodyEnd;
+        size_t mContentLength;
+        size_t mMessageEnd;
+
+        bool mChunked;
+        bool mHasContentLength;
+        bool mKeepAlive;
+
+        CHttpComLayer::ERequestType mRequestType;
+        SSpan mPath;
+        SSpan mQuery;
+        SSpan mStatusCode;
+        SSpan mBody;
+
+        CHttpStreamParser(const CHttpStreamParser&);
+        CHttpStreamParser& operator=(const CHttpStreamParser&);
+    };
+  }
+}
+
+#endif /* _HTTPSTREAMPARSER_H_ */
@@ -22,7 +22,6 @@ using namespace modbus_connection_event;
 
 CModbusClientConnection::CModbusClientConnection(CModbusHandler* pa_modbusHandler) :
     CModbusConnection(pa_modbusHandler), m_pModbusConnEvent(NULL), m_nNrOfPolls(0), m_nSlaveId(0xFF), m_unBufFillSize(0){
-  memset(m_anRecvBuffPosition, 0, sizeof(m_anRecvBuffPosition)); //TODO change this to  m_anRecvBuffPosition{0} in the extended list when fully switching to C++11
   memset(m_acRecvBuffer, 0, sizeof(m_acRecvBuffer)); //TODO change this to  m_acRecvBuffer{0} in the extended list when fully switching to C++11
 }
 
@@ -78,6 +77,8 @@ int CModbusClientConnection::connect(){
 }
 
 void CModbusClientConnection::disconnect(){
+  setAlive(false);
+  m_oWakeUp.inc();
   this->end();
   if (m_bConnected){
     modbus_close(m_pModbusConn);
@@ -89,32 +90,22 @@ void CModbusClientConnection::disconnect(){
 void CModbusClientConnection::addNewPoll(TForteUInt32 pa_nPollInterval, unsigned int pa_nFunctionCode, unsigned int pa_nStartAddress, unsigned int pa_nNrAddresses){
   CModbusPoll *newPoll = NULL;
 
+  // The values of each range are placed in the receive buffer in the order the ranges are configured, independent of
+  // how the polls merge the ranges into requests
   TModbusPollList::Iterator itEnd = m_lstPollList.end();
   for(TModbusPollList::Iterator it = m_lstPollList.begin(); it != itEnd; ++it){
     if(it->getUpdateInterval() == pa_nPollInterval && it->getFunctionCode() == pa_nFunctionCode){
-      it->addPollAddresses(pa_nStartAddress, pa_nNrAddresses);
+      it->addPollAddresses(pa_nStartAddress, pa_nNrAddresses, m_unBufFillSize);
       newPoll = *it;
       break;
     }
   }
   if(newPoll == NULL){
-    m_lstPollList.pushBack(new CModbusPoll(pa_nPollInterval, pa_nFunctionCode, pa_nStartAddress, pa_nNrAddresses));
+    m_lstPollList.pushBack(new CModbusPoll(pa_nPollInterval, pa_nFunctionCode, pa_nStartAddress, pa_nNrAddresses, m_unBufFillSize));
     m_nNrOfPolls++;
-    m_anRecvBuffPosition[m_nNrOfPolls - 1] = m_unBufFillSize;
   }
 
-  // Count bytes
-  unsigned int nrBytes = 0;
-  switch (pa_nFunctionCode){
-    case 1:
-    case 2:
-      nrBytes = pa_nNrAddresses;
-      break;
-    case 3:
-    case 4:
-      nrBytes = pa_nNrAddresses * 2;
-      break;
-  }
+  unsigned int nrBytes = pa_nNrAddresses * CModbusPoll::getValueSize(pa_nFunctionCode);
   for(unsigned int i = m_unBufFillSize; i < m_unBufFillSize + nrBytes; i++){
     m_acRecvBuffer[i] = 0;
   }
@@ -141,19 +132,45 @@ void CModbusClientConnection::run(){
       tryConnect();
     }
 
-    CThread::sleepThread(1);
+    uint_fast64_t sleepTime = getTimeToNextEvent();
+    if(0 == sleepTime){
+      // a poll with an update interval of 0 is due all the time, don't let it take the whole CPU
+      sleepTime = 1;
+    }
+    m_oWakeUp.timedWait(sleepTime * 1000000ULL);
+  }
+}
+
+uint_fast64_t CModbusClientConnection::getTimeToNextEvent() const{
+  uint_fast64_t retVal = scm_nMaxSleepTime;
+  if(m_bConnected){
+    TModbusPollList::Iterator itEnd(m_lstPollList.end());
+    for(TModbusPollList::Iterator itPoll = m_lstPollList.begin(); itPoll != itEnd; ++itPoll){
+      if(itPoll->isStarted()){
+        uint_fast64_t timeToNextPoll = itPoll->getTimeToNextExecution();
+        if(timeToNextPoll < retVal){
+          retVal = timeToNextPoll;
+        }
+      }
+    }
+  }
+  else if(m_pModbusConnEvent != NULL && m_pModbusConnEvent->isStarted()){
+    uint_fast64_t timeToNextTry = m_pModbusConnEvent->getTimeToNextExecution();
+    if(timeToNextTry < retVal){
+      retVal = timeToNextTry;
+    }
   }
+  return retVal;
 }
 
 void CModbusClientConnection::tryPolling(){
   unsigned int nrErrors = 0;
   bool dataReturned = false;
 
-  unsigned int index = 0;
   TModbusPollList::Iterator itEnd(m_lstPollList.end());
-  for(TModbusPollList::Iterator itPoll = m_lstPollList.begin(); itPoll != itEnd; ++itPoll, ++index){
+  for(TModbusPollList::Iterator itPoll = m_lstPollList.begin(); itPoll != itEnd; ++itPoll){
     if(itPoll->readyToExecute()){
-      int nrVals = itPoll->executeEvent(m_pModbusConn, (void*) &m_acRecvBuffer[m_anRecvBuffPosition[index]]); // retVal);
+      int nrVals = itPoll->executeEvent(m_pModbusConn, (void*) &m_acRecvBuffer[0]);
 
       if(nrVals < 0){
         DEVLOG_ERROR("Error reading input status :: %s\n", modbus_strerror(errno));
@@ -161,7 +178,7 @@ void CModbusClientConnection::tryPolling(){
 
         nrErrors++;
       }
-      else if(nrVals > 0){
+      else if(nrVals > 0 && itPoll->hasChanged()){
         dataReturned = true;
       }
     }
@@ -15,6 +15,7 @@
 #include "modbusconnection.h"
 #include "modbustimedevent.h"
 #include "fortelist.h"
+#include <forte_sem.h>
 
 class CModbusPoll;
 
@@ -52,6 +53,9 @@ class CModbusClientConnection : public CModbusConnection{
     void tryConnect();
     void tryPolling();
 
+    //! Milliseconds until the next poll or connection attempt is due
+    uint_fast64_t getTimeToNextEvent() const;
+
     struct SSendInformation {
       unsigned int m_nStartAddress;
       unsigned int m_nNrAddresses;
@@ -66,13 +70,18 @@ class CModbusClientConnection : public CModbusConnection{
     TModbusSendList m_lstSendList;
 
     unsigned int m_nNrOfPolls;
-    unsigned int m_anRecvBuffPosition[100];
 
     unsigned int m_nSlaveId;
 
     uint8_t m_acRecvBuffer[cg_unIPLayerRecvBufferSize];
     unsigned int m_unBufFillSize;
 
+    //! Used to sleep until the next deadline, signaled to stop the thread early on disconnect
+    forte::arch::CSemaphore m_oWakeUp;
+
+    //! Upper bound for sleeping if no poll or connection attempt is pending
+    static const uint_fast64_t scm_nMaxSleepTime = 1000;
+
 };
 
 #endif
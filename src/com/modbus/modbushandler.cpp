@@ -8,12 +8,17 @@
  *
  * Contributors:
  *   Filip Andren, Alois Zoitl - initial API and implementation and/or initial documentation
+ *   agent - Modbus RTU server
  *******************************************************************************/
 #include "modbushandler.h"
 #include "devlog.h"
 #include "../core/devexec.h"
 #include <criticalregion.h>
 #include <commfb.h>
+#ifdef FORTE_COM_MODBUS_SERVER
+#include "modbustcpserverconnection.h"
+#include "modbusrtuserverconnection.h"
+#endif
 
 DEFINE_HANDLER(CModbusHandler);
 
@@ -23,6 +28,13 @@ CModbusHandler::CModbusHandler(CDeviceExecution& pa_poDeviceExecution) : CExtern
 }
 
 CModbusHandler::~CModbusHandler(){
+#ifdef FORTE_COM_MODBUS_SERVER
+  TServerList::Iterator itEnd(m_lstServers.end());
+  for(TServerList::Iterator itRunner = m_lstServers.begin(); itRunner != itEnd; ++itRunner){
+    delete (*itRunner)->m_poServer;
+    delete *itRunner;
+  }
+#endif
 
 }
 
@@ -77,3 +89,65 @@ void CModbusHandler::executeComCallback(CModbusHandler::TCallbackDescriptor pa_n
   }
   m_oSync.unlock();
 }
+
+#ifdef FORTE_COM_MODBUS_SERVER
+CModbusServerConnection* CModbusHandler::getTcpServer(const char *pa_acIp, unsigned int pa_nPort){
+  CCriticalRegion criticalRegion(m_oSync);
+
+  TServerList::Iterator itEnd(m_lstServers.end());
+  for(TServerList::Iterator itRunner = m_lstServers.begin(); itRunner != itEnd; ++itRunner){
+    if((*itRunner)->m_poServer->isTcpEndpoint(pa_acIp, pa_nPort)){
+      (*itRunner)->m_nUseCount++;
+      return (*itRunner)->m_poServer;
+    }
+  }
+  return startServer(new CModbusTcpServerConnection(pa_acIp, pa_nPort));
+}
+
+CModbusServerConnection* CModbusHandler::getRtuServer(const char *pa_acDevice, int pa_nBaud, char pa_cParity, int pa_nDataBit, int pa_nStopBit, unsigned int pa_nSlaveId){
+  CCriticalRegion criticalRegion(m_oSync);
+
+  TServerList::Iterator itEnd(m_lstServers.end());
+  for(TServerList::Iterator itRunner = m_lstServers.begin(); itRunner != itEnd; ++itRunner){
+    if((*itRunner)->m_poServer->isRtuDevice(pa_acDevice)){
+      if(!static_cast<CModbusRtuServerConnection*>((*itRunner)->m_poServer)->hasSettings(pa_nBaud, pa_cParity, pa_nDataBit, pa_nStopBit, pa_nSlaveId)){
+        DEVLOG_ERROR("CModbusHandler: Modbus RTU server on %s is already running with different settings\n", pa_acDevice);
+        return 0;
+      }
+      (*itRunner)->m_nUseCount++;
+      return (*itRunner)->m_poServer;
+    }
+  }
+  return startServer(new CModbusRtuServerConnection(pa_acDevice, pa_nBaud, pa_cParity, pa_nDataBit, pa_nStopBit, pa_nSlaveId));
+}
+
+CModbusServerConnection* CModbusHandler::startServer(CModbusServerConnection *pa_poServer){
+  if(pa_poServer->listen() < 0){
+    delete pa_poServer;
+    return 0;
+  }
+  SServerEntry *entry = new SServerEntry;
+  entry->m_poServer = pa_poServer;
+  entry->m_nUseCount = 1;
+  m_lstServers.pushBack(entry);
+  return pa_poServer;
+}
+
+void CModbusHandler::releaseServer(CModbusServerConnection *pa_poServer){
+  CCriticalRegion criticalRegion(m_oSync);
+
+  TServerList::Iterator itEnd(m_lstServers.end());
+  for(TServerList::Iterator itRunner = m_lstServers.begin(); itRunner != itEnd; ++itRunner){
+    SServerEntry *entry = *itRunner;
+    if(entry->m_poServer == pa_poServer){
+      entry->m_nUseCount--;
+      if(0 == entry->m_nUseCount){
+        m_lstServers.erase(entry);
+        delete entry->m_poServer;
+        delete entry;
+      }
+      break;
+    }
+  }
+}
+#endif
@@ -8,6 +8,7 @@
  *
  * Contributors:
  *   Filip Andren, Alois Zoitl - initial API and implementation and/or initial documentation
+ *   agent - Modbus RTU server
  *******************************************************************************/
 #ifndef _MODBUSHANDLER_H_
 #define _MODBUSHANDLER_H_
@@ -18,6 +19,10 @@
 #include <comlayer.h>
 #include <fortelist.h>
 
+#ifdef FORTE_COM_MODBUS_SERVER
+class CModbusServerConnection;
+#endif
+
 class CModbusHandler : public CExternalEventHandler{
     DECLARE_HANDLER(CModbusHandler)
   public:
@@ -45,6 +50,26 @@ class CModbusHandler : public CExternalEventHandler{
 
     void executeComCallback(TCallbackDescriptor pa_nCallbackDesc);
 
+#ifdef FORTE_COM_MODBUS_SERVER
+    /*! \brief Gets the Modbus TCP server of an endpoint, the server is started if it is not running yet
+     *
+     *  All layers using the same endpoint share the server and so its register image.
+     *  \return the server or 0 if the endpoint could not be opened
+     */
+    CModbusServerConnection* getTcpServer(const char *pa_acIp, unsigned int pa_nPort);
+
+    /*! \brief Gets the Modbus RTU server of a serial device, the server is started if it is not running yet
+     *
+     *  All layers using the same device share the server and so its register image. They have to use the same line
+     *  settings and slave id.
+     *  \return the server or 0 if the device could not be opened or is used with other settings
+     */
+    CModbusServerConnection* getRtuServer(const char *pa_acDevice, int pa_nBaud, char pa_cParity, int pa_nDataBit, int pa_nStopBit, unsigned int pa_nSlaveId);
+
+    //! Releases a server retrieved with getTcpServer or getRtuServer, it is stopped when no layer uses it anymore
+    void releaseServer(CModbusServerConnection *pa_poServer);
+#endif
+
   private:
     struct TComContainer{
         TCallbackDescriptor m_nCallbackDesc;
@@ -56,6 +81,19 @@ class CModbusHandler : public CExternalEventHandler{
 
     CSyncObject m_oSync;
 
+#ifdef FORTE_COM_MODBUS_SERVER
+    struct SServerEntry{
+        CModbusServerConnection *m_poServer;
+        unsigned int m_nUseCount;
+    };
+
+    //! Starts the server and registers it, deletes it if it can not be started
+    CModbusServerConnection* startServer(CModbusServerConnection *pa_poServer);
+
+    typedef CSinglyLinkedList<SServerEntry*> TServerList;
+    TServerList m_lstServers;
+#endif
+
     static TCallbackDescriptor m_nCallbackDescCount;
 };
 
@@ -8,16 +8,21 @@
  *
  * Contributors:
  *   Filip Andren, Patrick Smejkal, Alois Zoitl, Martin Melik-Merkumians - initial API and implementation and/or initial documentation
+ *   agent - Modbus RTU server
  *******************************************************************************/
 #include "modbuslayer.h"
 #include "commfb.h"
 #include "modbusclientconnection.h"
+#ifdef FORTE_COM_MODBUS_SERVER
+#include "modbusserverconnection.h"
+#endif
 
 using namespace forte::com_infra;
 
 CModbusComLayer::CModbusComLayer(CComLayer* pa_poUpperLayer, CBaseCommFB* pa_poComFB) :
-    CComLayer(pa_poUpperLayer, pa_poComFB), m_pModbusConnection(0), m_unBufFillSize(0){
+    CComLayer(pa_poUpperLayer, pa_poComFB), m_pModbusConnection(0), m_pModbusServer(0), m_unBufFillSize(0){
   m_eConnectionState = e_Disconnected;
+  memset(&m_stServerParams, 0, sizeof(m_stServerParams));
 }
 
 CModbusComLayer::~CModbusComLayer(){
@@ -26,11 +31,16 @@ CModbusComLayer::~CModbusComLayer(){
 EComResponse CModbusComLayer::sendData(void *pa_pvData, unsigned int pa_unSize){
   EComResponse eRetVal = e_ProcessDataOk;
 
-  if(m_eConnectionState == e_Connected){
+  if(m_eConnectionState == e_Connected || m_eConnectionState == e_Listening){
     switch (m_poFb->getComServiceType()){
       case e_Server:
-        // todo
+      case e_Publisher: {
+        TForteUInt16 *convertedData = new TForteUInt16[pa_unSize * 4];
+        unsigned int dataSize = convertDataInput(pa_pvData, pa_unSize, convertedData);
+        writeToRegisterImage(convertedData, dataSize);
+        delete[] convertedData;
         break;
+      }
       case e_Client: {
         TForteUInt16 *convertedData = new TForteUInt16[pa_unSize * 4];
         unsigned int sendLength = convertDataInput(pa_pvData, pa_unSize, convertedData);
@@ -40,9 +50,6 @@ EComResponse CModbusComLayer::sendData(void *pa_pvData, unsigned int pa_unSize){
         delete[] convertedData;
         break;
       }
-      case e_Publisher:
-        // todo
-        break;
       case e_Subscriber:
         //do nothing as subscribers do not send data
         break;
@@ -259,9 +266,7 @@ EComResponse CModbusComLayer::recvData(const void *, unsigned int){
 
   switch (m_eConnectionState){
     case e_Listening:
-
-      //TODO accept incoming connection
-
+      // the server connection accepts and answers the Modbus masters by itself, nothing is forwarded to the FB
       break;
     case e_Connected: {
       int nRetVal = 0;
@@ -337,8 +342,8 @@ EComResponse CModbusComLayer::openConnection(char *pa_acLayerParameter){
   EComResponse eRetVal = e_InitInvalidId;
   switch (m_poFb->getComServiceType()){
     case e_Server:
-      //TODO open server connection
-      m_eConnectionState = e_Listening;
+    case e_Publisher:
+      eRetVal = openServerConnection(pa_acLayerParameter);
       break;
     case e_Client: {
       STcpParams tcpParams;
@@ -386,9 +391,6 @@ EComResponse CModbusComLayer::openConnection(char *pa_acLayerParameter){
       }
     }
       break;
-    case e_Publisher:
-      //do nothing as modbus cannot be publisher
-      break;
     case e_Subscriber:
       //do nothing as modbus cannot be subscriber
       break;
@@ -405,6 +407,132 @@ void CModbusComLayer::closeConnection(){
     m_pModbusConnection->disconnect();
     delete m_pModbusConnection;
   }
+#ifdef FORTE_COM_MODBUS_SERVER
+  if(m_pModbusServer != NULL){
+    getExtEvHandler<CModbusHandler>().releaseServer(m_pModbusServer);
+    m_pModbusServer = NULL;
+  }
+#endif
+}
+
+EComResponse CModbusComLayer::openServerConnection(char *pa_acLayerParameter){
+#ifdef FORTE_COM_MODBUS_SERVER
+  if(processServerParams(pa_acLayerParameter, &m_stServerParams) != 0){
+    DEVLOG_ERROR("CModbusComLayer:: Invalid server parameters\n");
+    return e_InitInvalidId;
+  }
+  if(m_stServerParams.m_bRtu){
+    const SRtuParams &rtuParams(m_stServerParams.m_stRtuParams);
+    m_pModbusServer = getExtEvHandler<CModbusHandler>().getRtuServer(rtuParams.m_acDevice, rtuParams.m_nBaud, rtuParams.m_cParity,
+      rtuParams.m_nDataBit, rtuParams.m_nStopBit, m_stServerParams.m_nSlaveId);
+  }
+  else{
+    m_pModbusServer = getExtEvHandler<CModbusHandler>().getTcpServer(m_stServerParams.m_acIp, m_stServerParams.m_nPort);
+  }
+  if(m_pModbusServer == NULL){
+    return e_InitInvalidId;
+  }
+  m_eConnectionState = e_Listening;
+  return e_InitOk;
+#else
+  (void) pa_acLayerParameter;
+  DEVLOG_ERROR("CModbusComLayer:: Modbus server is not supported on this architecture\n");
+  return e_InitInvalidId;
+#endif
+}
+
+void CModbusComLayer::writeToRegisterImage(const TForteUInt16 *pa_pData, unsigned int pa_nDataSize){
+#ifdef FORTE_COM_MODBUS_SERVER
+  CModbusRegisterImage::ETable table = CModbusRegisterImage::getTableForFunctionCode(m_stServerParams.m_nFuncCode);
+  unsigned int dataIndex = 0;
+  for(unsigned int i = 0; i < m_stServerParams.m_nNrAreas && dataIndex < pa_nDataSize; i++){
+    unsigned int nrValues = m_stServerParams.m_nNrAddresses[i];
+    if(nrValues > pa_nDataSize - dataIndex){
+      nrValues = pa_nDataSize - dataIndex;
+    }
+    m_pModbusServer->getRegisterImage().write(table, m_stServerParams.m_nStartAddress[i], nrValues, &pa_pData[dataIndex]);
+    dataIndex += nrValues;
+  }
+#else
+  (void) pa_pData;
+  (void) pa_nDataSize;
+#endif
+}
+
+int CModbusComLayer::processServerParams(const char* pa_acLayerParams, SServerParams* pa_pServerParams){
+  const char *params = pa_acLayerParams;
+  char *end;
+  pa_pServerParams->m_bRtu = (strncmp(params, "rtu:", 4) == 0 || strncmp(params, "RTU:", 4) == 0);
+  if(pa_pServerParams->m_bRtu){
+    SRtuParams &rtuParams(pa_pServerParams->m_stRtuParams);
+    params += 4;
+    const char *deviceEnd = strchr(params, ':');
+    if(deviceEnd == 0 || static_cast<size_t>(deviceEnd - params) >= sizeof(rtuParams.m_acDevice)){
+      return -1;
+    }
+    memcpy(rtuParams.m_acDevice, params, static_cast<size_t>(deviceEnd - params));
+    rtuParams.m_acDevice[deviceEnd - params] = '\0';
+
+    rtuParams.m_nBaud = (int) forte::core::util::strtol(deviceEnd + 1, &end, 10);
+    if(*end != ':' || end[1] == '\0' || end[2] != ':'){
+      return -1;
+    }
+    rtuParams.m_cParity = end[1];
+    rtuParams.m_nDataBit = (int) forte::core::util::strtol(end + 3, &end, 10);
+    if(*end != ':'){
+      return -1;
+    }
+    rtuParams.m_nStopBit = (int) forte::core::util::strtol(end + 1, &end, 10);
+    if(*end != ':'){
+      return -1;
+    }
+    pa_pServerParams->m_nSlaveId = (unsigned int) forte::core::util::strtoul(end + 1, &end, 10);
+    if(*end != ':'){
+      return -1;
+    }
+  }
+  else{
+    if(strncmp(params, "tcp:", 4) == 0 || strncmp(params, "TCP:", 4) == 0){
+      params += 4;
+    }
+
+    const char *ipEnd = strchr(params, ':');
+    if(ipEnd == 0 || static_cast<size_t>(ipEnd - params) >= sizeof(pa_pServerParams->m_acIp)){
+      return -1;
+    }
+    memcpy(pa_pServerParams->m_acIp, params, static_cast<size_t>(ipEnd - params));
+    pa_pServerParams->m_acIp[ipEnd - params] = '\0';
+    if(!isIp(pa_pServerParams->m_acIp)){
+      return -1;
+    }
+
+    pa_pServerParams->m_nPort = (unsigned int) forte::core::util::strtoul(ipEnd + 1, &end, 10);
+    if(*end != ':'){
+      return -1;
+    }
+  }
+  pa_pServerParams->m_nFuncCode = (unsigned int) forte::core::util::strtoul(end + 1, &end, 10);
+  if(*end != ':' || pa_pServerParams->m_nFuncCode < 1 || pa_pServerParams->m_nFuncCode > 4){
+    return -1;
+  }
+
+  const char *addresses = end + 1;
+  int paramLen = (int) strlen(addresses);
+  unsigned int nrAreas = 0;
+  int strIndex = -1;
+  while(strIndex < paramLen - 1 && nrAreas < 100){
+    strIndex = findNextStartAddress(addresses, ++strIndex);
+    if(strIndex < 0){
+      break;
+    }
+    pa_pServerParams->m_nStartAddress[nrAreas] = (unsigned int) forte::core::util::strtoul(&addresses[strIndex], 0, 10);
+    strIndex = findNextStopAddress(addresses, strIndex);
+    pa_pServerParams->m_nNrAddresses[nrAreas] = (unsigned int) forte::core::util::strtoul(&addresses[strIndex], 0, 10) - pa_pServerParams->m_nStartAddress[nrAreas] + 1;
+    nrAreas++;
+  }
+  pa_pServerParams->m_nNrAreas = nrAreas;
+
+  return (nrAreas == 0) ? -1 : 0;
 }
 
 int CModbusComLayer::processClientParams(char* pa_acLayerParams, STcpParams* pa_pTcpParams, SRtuParams* pa_pRtuParams, SCommonParams* pa_pCommonParams){
@@ -8,6 +8,7 @@
  *
  * Contributors:
  *   Filip Andren, Alois Zoitl - initial API and implementation and/or initial documentation
+ *   agent - Modbus RTU server
  *******************************************************************************/
 #ifndef MODBUSCOMLAYER_H_
 #define MODBUSCOMLAYER_H_
@@ -17,6 +18,7 @@
 #include <stdint.h>
 
 class CModbusConnection;
+class CModbusServerConnection;
 class CIEC_ANY;
 
 namespace forte {
@@ -58,6 +60,17 @@ namespace forte {
           unsigned int m_nResponseTimeout;
           unsigned int m_nByteTimeout;
         };
+        struct SServerParams {
+          bool m_bRtu;
+          char m_acIp[16];
+          unsigned int m_nPort;
+          SRtuParams m_stRtuParams;
+          unsigned int m_nSlaveId;
+          unsigned int m_nFuncCode;
+          unsigned int m_nNrAreas;
+          unsigned int m_nStartAddress[100];
+          unsigned int m_nNrAddresses[100];
+        };
 
         template<typename T>
         T convertFBOutput(TForteByte *pa_acDataArray, unsigned int pa_nDataSize);
@@ -65,10 +78,21 @@ namespace forte {
         unsigned int convertDataInput(void *pa_poInData, unsigned int pa_nDataSize, TForteUInt16 *pa_poConvertedData);
 
         EComResponse openConnection(char *pa_acLayerParameter);
+        EComResponse openServerConnection(char *pa_acLayerParameter);
         void closeConnection();
 
+        //! Writes the converted send data to the configured areas of the server's register image
+        void writeToRegisterImage(const TForteUInt16 *pa_pData, unsigned int pa_nDataSize);
+
         //int processClientParams(char* pa_acLayerParams, char* pa_acIp, unsigned int &pa_nPort, long &pa_nPollFrequency, unsigned int &pa_nFuncCode, unsigned int &pa_nSlaveId, unsigned int *pa_nStartAddress, unsigned int *pa_nNrAddresses);
         int processClientParams(char* pa_acLayerParams, STcpParams* pa_pTcpParams, SRtuParams* pa_pRtuParams, SCommonParams* pa_pCommonParams);
+        /*! \brief Parses the parameters of a Modbus server
+         *
+         *  "[tcp:]ip:port:function code:addresses" for a TCP server or
+         *  "rtu:device:baud:parity:data bits:stop bits:slave id:function code:addresses" for an RTU server,
+         *  where the function code (1 - 4) selects the served table
+         */
+        int processServerParams(const char* pa_acLayerParams, SServerParams* pa_pServerParams);
         int findNextStartAddress(const char* pa_acString, int pa_nStartIndex);
         int findNextStopAddress(const char* pa_acString, int pa_nStartIndex);
         bool isIp(const char* pa_acIp);
@@ -77,6 +101,9 @@ namespace forte {
 
         CModbusConnection *m_pModbusConnection;
 
+        CModbusServerConnection *m_pModbusServer;
+        SServerParams m_stServerParams;
+
         TForteByte m_acRecvBuffer[cg_unIPLayerRecvBufferSize];
         unsigned int m_unBufFillSize;
     };
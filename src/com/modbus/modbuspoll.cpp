@@ -14,11 +14,19 @@
 #include <devlog.h>
 
 #include <modbus.h>
+#include <string.h>
 
-CModbusPoll::CModbusPoll(TForteUInt32 pa_nPollInterval, unsigned int pa_nFunctionCode, unsigned int pa_nStartAddress, unsigned int pa_nNrAddresses) :
-    CModbusTimedEvent(pa_nPollInterval){
+namespace {
+  unsigned int getMaxBlockSize(unsigned int pa_nFunctionCode){
+    return (pa_nFunctionCode < 3) ? MODBUS_MAX_READ_BITS : MODBUS_MAX_READ_REGISTERS;
+  }
+}
+
+CModbusPoll::CModbusPoll(TForteUInt32 pa_nPollInterval, unsigned int pa_nFunctionCode, unsigned int pa_nStartAddress, unsigned int pa_nNrAddresses, unsigned int pa_nBufferPosition) :
+    CModbusTimedEvent(pa_nPollInterval), m_oOptimizer(FORTE_COM_MODBUS_MAX_READ_GAP, getMaxBlockSize(pa_nFunctionCode)), m_pReadBuffer(0),
+    m_bReadPlanValid(false), m_bFirstRead(true), m_bChanged(false){
   setFunctionCode(pa_nFunctionCode);
-  addPollAddresses(pa_nStartAddress, pa_nNrAddresses);
+  addPollAddresses(pa_nStartAddress, pa_nNrAddresses, pa_nBufferPosition);
 }
 
 CModbusPoll::~CModbusPoll(){
@@ -27,35 +35,83 @@ CModbusPoll::~CModbusPoll(){
     delete *it;
   }
   m_lPolls.clearAll();
+  delete[] m_pReadBuffer;
+}
+
+void CModbusPoll::addPollAddresses(unsigned int pa_nStartAddress, unsigned int pa_nNrAddresses, unsigned int pa_nBufferPosition){
+  unsigned int rangeIndex = m_oOptimizer.addRange(pa_nStartAddress, pa_nNrAddresses);
+  m_lPolls.pushBack(new SModbusPollData(pa_nStartAddress, pa_nNrAddresses, pa_nBufferPosition, rangeIndex));
+  m_bReadPlanValid = false;
+  m_bFirstRead = true;
+}
+
+unsigned int CModbusPoll::getValueSize(unsigned int pa_nFunctionCode){
+  return (pa_nFunctionCode < 3) ? sizeof(uint8_t) : sizeof(uint16_t);
+}
+
+void CModbusPoll::updateReadPlan(){
+  m_oOptimizer.optimize();
+  delete[] m_pReadBuffer;
+  // bits are stored as one byte each, so a register sized buffer fits both
+  m_pReadBuffer = new uint16_t[m_oOptimizer.getNrOfReadValues()];
+  m_bReadPlanValid = true;
 }
 
-void CModbusPoll::addPollAddresses(unsigned int pa_nStartAddress, unsigned int pa_nNrAddresses){
-  m_lPolls.pushBack(new SModbusPollData(pa_nStartAddress, pa_nNrAddresses));
+int CModbusPoll::readBlock(modbus_t *pa_pModbusConn, const CModbusPollOptimizer::SReadBlock &pa_roBlock, uint8_t *pa_pDest){
+  int nrVals = -1;
+  switch (m_nFunctionCode){
+    case 1:
+      nrVals = modbus_read_bits(pa_pModbusConn, pa_roBlock.m_nStartAddress, pa_roBlock.m_nNrAddresses, pa_pDest);
+      break;
+    case 2:
+      nrVals = modbus_read_input_bits(pa_pModbusConn, pa_roBlock.m_nStartAddress, pa_roBlock.m_nNrAddresses, pa_pDest);
+      break;
+    case 3:
+      nrVals = modbus_read_registers(pa_pModbusConn, pa_roBlock.m_nStartAddress, pa_roBlock.m_nNrAddresses, reinterpret_cast<uint16_t*>(pa_pDest));
+      break;
+    case 4:
+      nrVals = modbus_read_input_registers(pa_pModbusConn, pa_roBlock.m_nStartAddress, pa_roBlock.m_nNrAddresses, reinterpret_cast<uint16_t*>(pa_pDest));
+      break;
+    default:
+      DEVLOG_ERROR("CModbusPoll: unsupported function code %u\n", m_nFunctionCode);
+      break;
+  }
+  return nrVals;
 }
 
 int CModbusPoll::executeEvent(modbus_t *pa_pModbusConn, void *pa_pRetVal){
   restartTimer();
+  m_bChanged = false;
+
+  if(!m_bReadPlanValid){
+    updateReadPlan();
+  }
+
+  const unsigned int valueSize = getValueSize(m_nFunctionCode);
+  uint8_t *readBuffer = reinterpret_cast<uint8_t*>(m_pReadBuffer);
+  unsigned int readPosition = 0;
+  for(unsigned int i = 0; i < m_oOptimizer.getNrOfBlocks(); i++){
+    const CModbusPollOptimizer::SReadBlock &block = m_oOptimizer.getBlock(i);
+    if(readBlock(pa_pModbusConn, block, &readBuffer[readPosition * valueSize]) != static_cast<int>(block.m_nNrAddresses)){
+      return -1;
+    }
+    readPosition += block.m_nNrAddresses;
+  }
 
+  // only touch the receive buffer where the values differ, so that unchanged polls don't trigger any event
   int nrVals = 0;
+  uint8_t *recvBuffer = static_cast<uint8_t*>(pa_pRetVal);
   CSinglyLinkedList<SModbusPollData*>::Iterator itEnd = m_lPolls.end();
   for(CSinglyLinkedList<SModbusPollData*>::Iterator it = m_lPolls.begin(); it != itEnd; ++it){
-    switch (m_nFunctionCode){
-      case 1:
-        nrVals += modbus_read_bits(pa_pModbusConn, it->m_nStartAddress, it->m_nNrAddresses, &((uint8_t*) pa_pRetVal)[nrVals]);
-        break;
-      case 2:
-        nrVals += modbus_read_input_bits(pa_pModbusConn, it->m_nStartAddress, it->m_nNrAddresses, &((uint8_t*) pa_pRetVal)[nrVals]);
-        break;
-      case 3:
-        nrVals += modbus_read_registers(pa_pModbusConn, it->m_nStartAddress, it->m_nNrAddresses, &((uint16_t*) pa_pRetVal)[nrVals]);
-        break;
-      case 4:
-        nrVals += modbus_read_input_registers(pa_pModbusConn, it->m_nStartAddress, it->m_nNrAddresses, &((uint16_t*) pa_pRetVal)[nrVals]);
-        break;
-      default:
-        //TODO Error
-        break;
+    const uint8_t *source = &readBuffer[m_oOptimizer.getReadPosition(it->m_nRangeIndex) * valueSize];
+    uint8_t *dest = &recvBuffer[it->m_nBufferPosition];
+    size_t size = it->m_nNrAddresses * valueSize;
+    if(m_bFirstRead || 0 != memcmp(dest, source, size)){
+      memcpy(dest, source, size);
+      m_bChanged = true;
     }
+    nrVals += static_cast<int>(it->m_nNrAddresses);
   }
+  m_bFirstRead = false;
   return nrVals;
 }
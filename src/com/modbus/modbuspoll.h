@@ -12,16 +12,28 @@
 #ifndef MODBUSPOLL_H_
 #define MODBUSPOLL_H_
 
+#include <forte_config.h>
 #include "modbustimedevent.h"
+#include "modbuspolloptimizer.h"
 #include <fortelist.h>
 
 class CModbusPoll : public CModbusTimedEvent{
   public:
-    CModbusPoll(TForteUInt32 pa_nPollInterval, unsigned int pa_nFunctionCode, unsigned int pa_nStartAddress, unsigned int pa_nNrAddresses);
+    CModbusPoll(TForteUInt32 pa_nPollInterval, unsigned int pa_nFunctionCode, unsigned int pa_nStartAddress, unsigned int pa_nNrAddresses, unsigned int pa_nBufferPosition);
     ~CModbusPoll();
 
+    /*! \brief Reads all poll addresses with as few requests as possible
+     *
+     *  \param pa_pRetVal receive buffer, the values of each poll range are stored at the buffer position given for it
+     *  \return number of values read or -1 on error
+     */
     int executeEvent(modbus_t *pa_pModbusConn, void *pa_pRetVal);
 
+    //! If the last executeEvent changed any value in the receive buffer
+    bool hasChanged() const{
+      return m_bChanged;
+    }
+
     void setFunctionCode(unsigned int pa_nFunctionCode){
       m_nFunctionCode = pa_nFunctionCode;
     }
@@ -29,23 +41,45 @@ class CModbusPoll : public CModbusTimedEvent{
       return m_nFunctionCode;
     }
 
-    void addPollAddresses(unsigned int pa_nStartAddress, unsigned int pa_nNrAddresses);
+    /*! \brief Adds an address range to this poll
+     *
+     *  \param pa_nBufferPosition byte offset in the receive buffer where the values of this range are stored
+     */
+    void addPollAddresses(unsigned int pa_nStartAddress, unsigned int pa_nNrAddresses, unsigned int pa_nBufferPosition);
+
+    //! Number of bytes a single value of the given function code needs in the receive buffer
+    static unsigned int getValueSize(unsigned int pa_nFunctionCode);
 
   private:
 
     struct SModbusPollData{
         unsigned int m_nStartAddress;
         unsigned int m_nNrAddresses;
+        unsigned int m_nBufferPosition;
+        unsigned int m_nRangeIndex;
 
-        SModbusPollData(unsigned int pa_nStartAddress, unsigned int pa_nNrAddresses) :
-            m_nStartAddress(pa_nStartAddress), m_nNrAddresses(pa_nNrAddresses){
+        SModbusPollData(unsigned int pa_nStartAddress, unsigned int pa_nNrAddresses, unsigned int pa_nBufferPosition, unsigned int pa_nRangeIndex) :
+            m_nStartAddress(pa_nStartAddress), m_nNrAddresses(pa_nNrAddresses), m_nBufferPosition(pa_nBufferPosition), m_nRangeIndex(pa_nRangeIndex){
         }
         ;
     };
 
+    int readBlock(modbus_t *pa_pModbusConn, const CModbusPollOptimizer::SReadBlock &pa_roBlock, uint8_t *pa_pDest);
+
+    void updateReadPlan();
+
     unsigned int m_nFunctionCode;
 
     CSinglyLinkedList<SModbusPollData*> m_lPolls;
+
+    CModbusPollOptimizer m_oOptimizer;
+
+    //! Values of all read blocks, received before they are compared with and copied to the receive buffer
+    uint16_t *m_pReadBuffer;
+
+    bool m_bReadPlanValid;
+    bool m_bFirstRead;
+    bool m_bChanged;
 };
 
 #endif /* MODBUSPOLL_H_ */
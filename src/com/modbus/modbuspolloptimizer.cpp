@@ -0,0 +1,101 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include "modbuspolloptimizer.h"
+
+CModbusPollOptimizer::CModbusPollOptimizer(unsigned int pa_nMaxGap, unsigned int pa_nMaxBlockSize) :
+    m_nMaxGap(pa_nMaxGap), m_nMaxBlockSize((0 != pa_nMaxBlockSize) ? pa_nMaxBlockSize : 1), m_pRanges(0), m_pOrder(0), m_nNrOfRanges(0),
+    m_nRangeCapacity(0), m_pBlocks(0), m_nNrOfBlocks(0), m_nNrOfReadValues(0){
+}
+
+CModbusPollOptimizer::~CModbusPollOptimizer(){
+  delete[] m_pRanges;
+  delete[] m_pOrder;
+  delete[] m_pBlocks;
+}
+
+unsigned int CModbusPollOptimizer::addRange(unsigned int pa_nStartAddress, unsigned int pa_nNrAddresses){
+  if(m_nNrOfRanges == m_nRangeCapacity){
+    m_nRangeCapacity = (0 != m_nRangeCapacity) ? 2 * m_nRangeCapacity : 8;
+    SRange *newRanges = new SRange[m_nRangeCapacity];
+    for(unsigned int i = 0; i < m_nNrOfRanges; i++){
+      newRanges[i] = m_pRanges[i];
+    }
+    delete[] m_pRanges;
+    m_pRanges = newRanges;
+  }
+  m_pRanges[m_nNrOfRanges].m_nStartAddress = pa_nStartAddress;
+  m_pRanges[m_nNrOfRanges].m_nNrAddresses = pa_nNrAddresses;
+  m_pRanges[m_nNrOfRanges].m_nReadPosition = 0;
+  return m_nNrOfRanges++;
+}
+
+void CModbusPollOptimizer::optimize(){
+  delete[] m_pOrder;
+  delete[] m_pBlocks;
+  m_pOrder = new unsigned int[m_nNrOfRanges];
+  m_nNrOfBlocks = 0;
+  m_nNrOfReadValues = 0;
+
+  // Without any merging every range needs its own requests, so this is the upper bound for the number of blocks
+  unsigned int maxNrOfBlocks = 0;
+  for(unsigned int i = 0; i < m_nNrOfRanges; i++){
+    maxNrOfBlocks += getNrOfRequests(m_pRanges[i].m_nNrAddresses);
+  }
+  m_pBlocks = new SReadBlock[(0 != maxNrOfBlocks) ? maxNrOfBlocks : 1];
+
+  // Sort the ranges by start address, the number of ranges is small enough for an insertion sort
+  for(unsigned int i = 0; i < m_nNrOfRanges; i++){
+    unsigned int j = i;
+    for(; j > 0 && m_pRanges[m_pOrder[j - 1]].m_nStartAddress > m_pRanges[i].m_nStartAddress; j--){
+      m_pOrder[j] = m_pOrder[j - 1];
+    }
+    m_pOrder[j] = i;
+  }
+
+  unsigned int groupFirst = 0;
+  unsigned int groupStart = 0;
+  unsigned int groupEnd = 0;
+  for(unsigned int i = 0; i < m_nNrOfRanges; i++){
+    const SRange &range = m_pRanges[m_pOrder[i]];
+    unsigned int rangeEnd = range.m_nStartAddress + range.m_nNrAddresses;
+    if(0 != i){
+      unsigned int mergedEnd = (rangeEnd > groupEnd) ? rangeEnd : groupEnd;
+      if(range.m_nStartAddress <= groupEnd
+          || (range.m_nStartAddress - groupEnd <= m_nMaxGap
+              && getNrOfRequests(mergedEnd - groupStart) <= getNrOfRequests(groupEnd - groupStart) + getNrOfRequests(range.m_nNrAddresses))){
+        groupEnd = mergedEnd;
+        continue;
+      }
+      addGroup(groupFirst, i, groupStart, groupEnd);
+    }
+    groupFirst = i;
+    groupStart = range.m_nStartAddress;
+    groupEnd = rangeEnd;
+  }
+  if(0 != m_nNrOfRanges){
+    addGroup(groupFirst, m_nNrOfRanges, groupStart, groupEnd);
+  }
+}
+
+void CModbusPollOptimizer::addGroup(unsigned int pa_nFirst, unsigned int pa_nLast, unsigned int pa_nStartAddress, unsigned int pa_nEndAddress){
+  for(unsigned int i = pa_nFirst; i < pa_nLast; i++){
+    SRange &range = m_pRanges[m_pOrder[i]];
+    range.m_nReadPosition = m_nNrOfReadValues + range.m_nStartAddress - pa_nStartAddress;
+  }
+
+  for(unsigned int address = pa_nStartAddress; address < pa_nEndAddress; address += m_nMaxBlockSize){
+    SReadBlock &block = m_pBlocks[m_nNrOfBlocks++];
+    block.m_nStartAddress = address;
+    block.m_nNrAddresses = (pa_nEndAddress - address < m_nMaxBlockSize) ? pa_nEndAddress - address : m_nMaxBlockSize;
+  }
+  m_nNrOfReadValues += pa_nEndAddress - pa_nStartAddress;
+}
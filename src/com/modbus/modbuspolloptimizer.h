@@ -0,0 +1,93 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#ifndef _MODBUSPOLLOPTIMIZER_H_
+#define _MODBUSPOLLOPTIMIZER_H_
+
+/*! \brief Plans the read requests needed for a set of Modbus address ranges
+ *
+ *  Overlapping and adjacent ranges are always merged into one read block. Ranges separated by at most the given gap
+ *  are merged as well, as long as this does not increase the number of requests. Blocks are split so that no block
+ *  exceeds the number of values a single request may return. The values read by all blocks are placed one after the
+ *  other, and every added range maps to a contiguous part of them.
+ */
+class CModbusPollOptimizer{
+  public:
+    struct SReadBlock{
+        unsigned int m_nStartAddress;
+        unsigned int m_nNrAddresses;
+    };
+
+    CModbusPollOptimizer(unsigned int pa_nMaxGap, unsigned int pa_nMaxBlockSize);
+    ~CModbusPollOptimizer();
+
+    /*! \brief Adds an address range which has to be read
+     *
+     *  \return index of the range, used for getReadPosition
+     */
+    unsigned int addRange(unsigned int pa_nStartAddress, unsigned int pa_nNrAddresses);
+
+    //! Calculates the read blocks for all ranges added so far
+    void optimize();
+
+    unsigned int getNrOfBlocks() const{
+      return m_nNrOfBlocks;
+    }
+
+    const SReadBlock& getBlock(unsigned int pa_nIndex) const{
+      return m_pBlocks[pa_nIndex];
+    }
+
+    //! Number of values read by all blocks together
+    unsigned int getNrOfReadValues() const{
+      return m_nNrOfReadValues;
+    }
+
+    unsigned int getNrOfRanges() const{
+      return m_nNrOfRanges;
+    }
+
+    //! Position of the first value of the range within the values read by all blocks
+    unsigned int getReadPosition(unsigned int pa_nRangeIndex) const{
+      return m_pRanges[pa_nRangeIndex].m_nReadPosition;
+    }
+
+  private:
+    struct SRange{
+        unsigned int m_nStartAddress;
+        unsigned int m_nNrAddresses;
+        unsigned int m_nReadPosition;
+    };
+
+    unsigned int getNrOfRequests(unsigned int pa_nNrAddresses) const{
+      return (pa_nNrAddresses + m_nMaxBlockSize - 1) / m_nMaxBlockSize;
+    }
+
+    //! Creates the blocks for the merged ranges m_pOrder[pa_nFirst] to m_pOrder[pa_nLast - 1]
+    void addGroup(unsigned int pa_nFirst, unsigned int pa_nLast, unsigned int pa_nStartAddress, unsigned int pa_nEndAddress);
+
+    unsigned int m_nMaxGap;
+    unsigned int m_nMaxBlockSize;
+
+    SRange *m_pRanges;
+    unsigned int *m_pOrder;
+    unsigned int m_nNrOfRanges;
+    unsigned int m_nRangeCapacity;
+
+    SReadBlock *m_pBlocks;
+    unsigned int m_nNrOfBlocks;
+    unsigned int m_nNrOfReadValues;
+
+    CModbusPollOptimizer(const CModbusPollOptimizer&);
+    CModbusPollOptimizer& operator=(const CModbusPollOptimizer&);
+};
+
+#endif /* _MODBUSPOLLOPTIMIZER_H_ */
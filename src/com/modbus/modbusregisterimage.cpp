@@ -0,0 +1,123 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include "modbusregisterimage.h"
+#include <criticalregion.h>
+#include <string.h>
+
+CModbusRegisterImage::CModbusRegisterImage(){
+  for(unsigned int i = 0; i < 2; i++){
+    m_apBits[i] = new TForteUInt8[scm_nNrOfAddresses];
+    memset(m_apBits[i], 0, scm_nNrOfAddresses * sizeof(TForteUInt8));
+    m_apRegisters[i] = new TForteUInt16[scm_nNrOfAddresses];
+    memset(m_apRegisters[i], 0, scm_nNrOfAddresses * sizeof(TForteUInt16));
+  }
+  for(unsigned int i = 0; i < e_NrOfTables; i++){
+    m_apSequences[i] = new TForteUInt32[scm_nNrOfBlocks];
+    memset(m_apSequences[i], 0, scm_nNrOfBlocks * sizeof(TForteUInt32));
+  }
+}
+
+CModbusRegisterImage::~CModbusRegisterImage(){
+  for(unsigned int i = 0; i < 2; i++){
+    delete[] m_apBits[i];
+    delete[] m_apRegisters[i];
+  }
+  for(unsigned int i = 0; i < e_NrOfTables; i++){
+    delete[] m_apSequences[i];
+  }
+}
+
+CModbusRegisterImage::ETable CModbusRegisterImage::getTableForFunctionCode(unsigned int pa_nFunctionCode){
+  switch (pa_nFunctionCode){
+    case 1:
+      return e_Coils;
+    case 2:
+      return e_DiscreteInputs;
+    case 3:
+      return e_HoldingRegisters;
+    case 4:
+      return e_InputRegisters;
+    default:
+      return e_NrOfTables;
+  }
+}
+
+void CModbusRegisterImage::write(ETable pa_eTable, unsigned int pa_nStartAddress, unsigned int pa_nNrAddresses, const TForteUInt16 *pa_pValues){
+  if(e_NrOfTables <= pa_eTable || !isValidRange(pa_nStartAddress, pa_nNrAddresses)){
+    return;
+  }
+  CCriticalRegion criticalRegion(m_oWriteSync);
+  if(isBitTable(pa_eTable)){
+    writeValues(m_apBits[pa_eTable - e_Coils], m_apSequences[pa_eTable], pa_nStartAddress, pa_nNrAddresses, pa_pValues);
+  }
+  else{
+    writeValues(m_apRegisters[pa_eTable - e_HoldingRegisters], m_apSequences[pa_eTable], pa_nStartAddress, pa_nNrAddresses, pa_pValues);
+  }
+}
+
+void CModbusRegisterImage::readBits(ETable pa_eTable, unsigned int pa_nStartAddress, unsigned int pa_nNrAddresses, TForteUInt8 *pa_pDest) const{
+  if(isBitTable(pa_eTable) && isValidRange(pa_nStartAddress, pa_nNrAddresses)){
+    readValues(m_apBits[pa_eTable - e_Coils], m_apSequences[pa_eTable], pa_nStartAddress, pa_nNrAddresses, pa_pDest);
+  }
+}
+
+void CModbusRegisterImage::readRegisters(ETable pa_eTable, unsigned int pa_nStartAddress, unsigned int pa_nNrAddresses, TForteUInt16 *pa_pDest) const{
+  if((e_HoldingRegisters == pa_eTable || e_InputRegisters == pa_eTable) && isValidRange(pa_nStartAddress, pa_nNrAddresses)){
+    readValues(m_apRegisters[pa_eTable - e_HoldingRegisters], m_apSequences[pa_eTable], pa_nStartAddress, pa_nNrAddresses, pa_pDest);
+  }
+}
+
+template<typename T>
+void CModbusRegisterImage::writeValues(T *pa_pTable, TForteUInt32 *pa_pSequences, unsigned int pa_nStartAddress, unsigned int pa_nNrAddresses, const TForteUInt16 *pa_pValues){
+  unsigned int endAddress = pa_nStartAddress + pa_nNrAddresses;
+  for(unsigned int address = pa_nStartAddress; address < endAddress;){
+    unsigned int block = address / scm_nBlockSize;
+    unsigned int blockEnd = (block + 1) * scm_nBlockSize;
+    if(blockEnd > endAddress){
+      blockEnd = endAddress;
+    }
+
+    // writers are serialized by m_oWriteSync, so only the readers have to be informed about the ongoing write
+    TForteUInt32 sequence = pa_pSequences[block];
+    __atomic_store_n(&pa_pSequences[block], sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    for(; address < blockEnd; address++, pa_pValues++){
+      pa_pTable[address] = (sizeof(T) == sizeof(TForteUInt8)) ? static_cast<T>(0 != *pa_pValues) : static_cast<T>(*pa_pValues);
+    }
+    __atomic_store_n(&pa_pSequences[block], sequence + 2, __ATOMIC_RELEASE);
+  }
+}
+
+template<typename T>
+void CModbusRegisterImage::readValues(const T *pa_pTable, const TForteUInt32 *pa_pSequences, unsigned int pa_nStartAddress, unsigned int pa_nNrAddresses, T *pa_pDest){
+  unsigned int endAddress = pa_nStartAddress + pa_nNrAddresses;
+  for(unsigned int address = pa_nStartAddress; address < endAddress;){
+    unsigned int block = address / scm_nBlockSize;
+    unsigned int blockEnd = (block + 1) * scm_nBlockSize;
+    if(blockEnd > endAddress){
+      blockEnd = endAddress;
+    }
+    size_t size = (blockEnd - address) * sizeof(T);
+
+    TForteUInt32 sequenceBefore;
+    TForteUInt32 sequenceAfter;
+    do{
+      sequenceBefore = __atomic_load_n(&pa_pSequences[block], __ATOMIC_ACQUIRE);
+      memcpy(pa_pDest, &pa_pTable[address], size);
+      __atomic_thread_fence(__ATOMIC_ACQUIRE);
+      sequenceAfter = __atomic_load_n(&pa_pSequences[block], __ATOMIC_RELAXED);
+    } while(0 != (sequenceBefore & 1) || sequenceBefore != sequenceAfter);
+
+    pa_pDest += blockEnd - address;
+    address = blockEnd;
+  }
+}
@@ -0,0 +1,85 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#ifndef _MODBUSREGISTERIMAGE_H_
+#define _MODBUSREGISTERIMAGE_H_
+
+#include <forte_config.h>
+#include <datatype.h>
+#include <forte_sync.h>
+
+/*! \brief Coils and registers served by a Modbus server
+ *
+ *  The image covers the whole Modbus address space of all four tables. Each table is split into blocks guarded by a
+ *  sequence counter (seqlock): writers are serialized by a mutex and make the counter odd while they change a block,
+ *  readers never block and retry copying a block until they got it without a concurrent write. So a read never
+ *  returns values of a block that are half updated, while the serving thread never waits for the FBs.
+ */
+class CModbusRegisterImage{
+  public:
+    enum ETable{
+      e_Coils,
+      e_DiscreteInputs,
+      e_HoldingRegisters,
+      e_InputRegisters,
+      e_NrOfTables
+    };
+
+    static const unsigned int scm_nNrOfAddresses = 65536;
+    //! Number of addresses guarded by one sequence counter
+    static const unsigned int scm_nBlockSize = 64;
+
+    CModbusRegisterImage();
+    ~CModbusRegisterImage();
+
+    //! Table served for the given Modbus read function code (1 - 4), e_NrOfTables if there is none
+    static ETable getTableForFunctionCode(unsigned int pa_nFunctionCode);
+
+    static bool isBitTable(ETable pa_eTable){
+      return (e_Coils == pa_eTable || e_DiscreteInputs == pa_eTable);
+    }
+
+    static bool isValidRange(unsigned int pa_nStartAddress, unsigned int pa_nNrAddresses){
+      return (pa_nStartAddress < scm_nNrOfAddresses && pa_nNrAddresses <= scm_nNrOfAddresses - pa_nStartAddress);
+    }
+
+    /*! \brief Writes values into a table
+     *
+     *  For the bit tables every value not equal to 0 sets the bit.
+     */
+    void write(ETable pa_eTable, unsigned int pa_nStartAddress, unsigned int pa_nNrAddresses, const TForteUInt16 *pa_pValues);
+
+    //! Reads the bits of a bit table, one byte per bit
+    void readBits(ETable pa_eTable, unsigned int pa_nStartAddress, unsigned int pa_nNrAddresses, TForteUInt8 *pa_pDest) const;
+
+    //! Reads the registers of a register table
+    void readRegisters(ETable pa_eTable, unsigned int pa_nStartAddress, unsigned int pa_nNrAddresses, TForteUInt16 *pa_pDest) const;
+
+  private:
+    static const unsigned int scm_nNrOfBlocks = scm_nNrOfAddresses / scm_nBlockSize;
+
+    template<typename T>
+    void writeValues(T *pa_pTable, TForteUInt32 *pa_pSequences, unsigned int pa_nStartAddress, unsigned int pa_nNrAddresses, const TForteUInt16 *pa_pValues);
+
+    template<typename T>
+    static void readValues(const T *pa_pTable, const TForteUInt32 *pa_pSequences, unsigned int pa_nStartAddress, unsigned int pa_nNrAddresses, T *pa_pDest);
+
+    TForteUInt8 *m_apBits[2];
+    TForteUInt16 *m_apRegisters[2];
+    TForteUInt32 *m_apSequences[e_NrOfTables];
+
+    CSyncObject m_oWriteSync;
+
+    CModbusRegisterImage(const CModbusRegisterImage&);
+    CModbusRegisterImage& operator=(const CModbusRegisterImage&);
+};
+
+#endif /* _MODBUSREGISTERIMAGE_H_ */
@@ -0,0 +1,314 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include "modbusrtuserverconnection.h"
+#include <devlog.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace {
+  //! Slave id, function code and CRC
+  const unsigned int scm_nMinFrameSize = 4;
+  const unsigned int scm_nBroadcastId = 0;
+
+  void closeDescriptor(int &pa_rnDescriptor){
+    if(-1 != pa_rnDescriptor){
+      close(pa_rnDescriptor);
+      pa_rnDescriptor = -1;
+    }
+  }
+
+  bool getSpeed(int pa_nBaud, speed_t &pa_rnSpeed){
+    switch (pa_nBaud){
+      case 1200:
+        pa_rnSpeed = B1200;
+        break;
+      case 2400:
+        pa_rnSpeed = B2400;
+        break;
+      case 4800:
+        pa_rnSpeed = B4800;
+        break;
+      case 9600:
+        pa_rnSpeed = B9600;
+        break;
+      case 19200:
+        pa_rnSpeed = B19200;
+        break;
+      case 38400:
+        pa_rnSpeed = B38400;
+        break;
+      case 57600:
+        pa_rnSpeed = B57600;
+        break;
+      case 115200:
+        pa_rnSpeed = B115200;
+        break;
+      case 230400:
+        pa_rnSpeed = B230400;
+        break;
+      default:
+        return false;
+    }
+    return true;
+  }
+}
+
+CModbusRtuServerConnection::CModbusRtuServerConnection(const char *pa_acDevice, int pa_nBaud, char pa_cParity, int pa_nDataBit, int pa_nStopBit,
+    unsigned int pa_nSlaveId) :
+    m_nBaud(pa_nBaud), m_cParity(pa_cParity), m_nDataBit(pa_nDataBit), m_nStopBit(pa_nStopBit), m_nSlaveId(pa_nSlaveId), m_nFrameTimeout(2),
+    m_nDeviceFd(-1), m_nWakeUpFd(-1), m_nFillSize(0){
+  strncpy(m_acDevice, pa_acDevice, sizeof(m_acDevice) - 1);
+  m_acDevice[sizeof(m_acDevice) - 1] = '\0';
+  // above 19200 baud the silent interval is fixed to 1.75 ms, otherwise it is 3.5 characters of 11 bits
+  if(0 < m_nBaud && m_nBaud <= 19200){
+    m_nFrameTimeout = (38500 + m_nBaud - 1) / m_nBaud;
+  }
+}
+
+CModbusRtuServerConnection::~CModbusRtuServerConnection(){
+  stop();
+}
+
+bool CModbusRtuServerConnection::isRtuDevice(const char *pa_acDevice) const{
+  return (0 == strcmp(m_acDevice, pa_acDevice));
+}
+
+bool CModbusRtuServerConnection::hasSettings(int pa_nBaud, char pa_cParity, int pa_nDataBit, int pa_nStopBit, unsigned int pa_nSlaveId) const{
+  return (m_nBaud == pa_nBaud && m_cParity == pa_cParity && m_nDataBit == pa_nDataBit && m_nStopBit == pa_nStopBit && m_nSlaveId == pa_nSlaveId);
+}
+
+int CModbusRtuServerConnection::listen(){
+  if(m_nSlaveId < 1 || m_nSlaveId > 247){
+    DEVLOG_ERROR("CModbusRtuServerConnection: invalid slave id %u, it has to be between 1 and 247\n", m_nSlaveId);
+    return -1;
+  }
+
+  // O_NONBLOCK only for opening, so that a missing carrier does not block
+  m_nDeviceFd = open(m_acDevice, O_RDWR | O_NOCTTY | O_NONBLOCK);
+  if(-1 == m_nDeviceFd){
+    DEVLOG_ERROR("CModbusRtuServerConnection: could not open %s: %s\n", m_acDevice, strerror(errno));
+    return -1;
+  }
+  if(!configureDevice()){
+    stop();
+    return -1;
+  }
+
+  m_nWakeUpFd = eventfd(0, EFD_NONBLOCK);
+  if(-1 == m_nWakeUpFd){
+    DEVLOG_ERROR("CModbusRtuServerConnection: could not create eventfd: %s\n", strerror(errno));
+    stop();
+    return -1;
+  }
+
+  DEVLOG_INFO("CModbusRtuServerConnection: serving Modbus RTU slave %u on %s\n", m_nSlaveId, m_acDevice);
+  start();
+  return 0;
+}
+
+bool CModbusRtuServerConnection::configureDevice(){
+  speed_t speed;
+  if(!getSpeed(m_nBaud, speed)){
+    DEVLOG_ERROR("CModbusRtuServerConnection: unsupported baud rate %d\n", m_nBaud);
+    return false;
+  }
+
+  struct termios settings;
+  if(0 != tcgetattr(m_nDeviceFd, &settings)){
+    DEVLOG_ERROR("CModbusRtuServerConnection: %s is not a serial device: %s\n", m_acDevice, strerror(errno));
+    return false;
+  }
+  cfmakeraw(&settings);
+  cfsetispeed(&settings, speed);
+  cfsetospeed(&settings, speed);
+  settings.c_cflag |= (CLOCAL | CREAD);
+
+  settings.c_cflag &= ~CSIZE;
+  switch (m_nDataBit){
+    case 5:
+      settings.c_cflag |= CS5;
+      break;
+    case 6:
+      settings.c_cflag |= CS6;
+      break;
+    case 7:
+      settings.c_cflag |= CS7;
+      break;
+    case 8:
+      settings.c_cflag |= CS8;
+      break;
+    default:
+      DEVLOG_ERROR("CModbusRtuServerConnection: unsupported number of data bits %d\n", m_nDataBit);
+      return false;
+  }
+
+  switch (m_cParity){
+    case 'N':
+      settings.c_cflag &= ~(PARENB | PARODD);
+      break;
+    case 'E':
+      settings.c_cflag |= PARENB;
+      settings.c_cflag &= ~PARODD;
+      break;
+    case 'O':
+      settings.c_cflag |= (PARENB | PARODD);
+      break;
+    default:
+      DEVLOG_ERROR("CModbusRtuServerConnection: unsupported parity %c\n", m_cParity);
+      return false;
+  }
+
+  if(2 == m_nStopBit){
+    settings.c_cflag |= CSTOPB;
+  }
+  else{
+    settings.c_cflag &= ~CSTOPB;
+  }
+
+  // reads return immediately, the serving thread waits with poll
+  settings.c_cc[VMIN] = 0;
+  settings.c_cc[VTIME] = 0;
+
+  if(0 != tcsetattr(m_nDeviceFd, TCSANOW, &settings) || 0 != fcntl(m_nDeviceFd, F_SETFL, 0)){
+    DEVLOG_ERROR("CModbusRtuServerConnection: could not configure %s: %s\n", m_acDevice, strerror(errno));
+    return false;
+  }
+  tcflush(m_nDeviceFd, TCIOFLUSH);
+  return true;
+}
+
+void CModbusRtuServerConnection::stop(){
+  setAlive(false);
+  if(-1 != m_nWakeUpFd){
+    eventfd_write(m_nWakeUpFd, 1);
+  }
+  end();
+
+  closeDescriptor(m_nDeviceFd);
+  closeDescriptor(m_nWakeUpFd);
+  m_nFillSize = 0;
+}
+
+void CModbusRtuServerConnection::run(){
+  struct pollfd descriptors[2];
+  descriptors[0].fd = m_nDeviceFd;
+  descriptors[0].events = POLLIN;
+  descriptors[1].fd = m_nWakeUpFd;
+  descriptors[1].events = POLLIN;
+
+  while(isAlive()){
+    int nrEvents = poll(descriptors, 2, (0 == m_nFillSize) ? -1 : m_nFrameTimeout);
+    if(nrEvents < 0){
+      if(EINTR == errno){
+        continue;
+      }
+      DEVLOG_ERROR("CModbusRtuServerConnection: poll failed: %s\n", strerror(errno));
+      break;
+    }
+    if(0 == nrEvents){
+      // silent interval, the received bytes are one frame
+      handleFrame(m_nFillSize);
+    }
+    else if(0 != (descriptors[0].revents & (POLLIN | POLLERR | POLLHUP | POLLNVAL)) && !receive()){
+      // e.g., an USB adapter was unplugged, don't spin on the error
+      CThread::sleepThread(100);
+    }
+  }
+}
+
+bool CModbusRtuServerConnection::receive(){
+  ssize_t nrBytes = read(m_nDeviceFd, &m_acRecvBuffer[m_nFillSize], scm_nMaxAduSize - m_nFillSize);
+  if(nrBytes <= 0){
+    return (0 > nrBytes && (EAGAIN == errno || EINTR == errno));
+  }
+  m_nFillSize += static_cast<unsigned int>(nrBytes);
+
+  for(unsigned int frameSize = getRequestSize(m_acRecvBuffer, m_nFillSize); 0 != frameSize && frameSize <= m_nFillSize;
+      frameSize = getRequestSize(m_acRecvBuffer, m_nFillSize)){
+    handleFrame(frameSize);
+  }
+
+  if(scm_nMaxAduSize == m_nFillSize || scm_nMaxAduSize < getRequestSize(m_acRecvBuffer, m_nFillSize)){
+    // no valid request, drop the bytes and resynchronize with the next silent interval
+    m_nFillSize = 0;
+  }
+  return true;
+}
+
+void CModbusRtuServerConnection::handleFrame(unsigned int pa_nFrameSize){
+  unsigned int responseSize = processFrame(m_acRecvBuffer, pa_nFrameSize, m_acResponse);
+  if(0 != responseSize && write(m_nDeviceFd, m_acResponse, responseSize) != static_cast<ssize_t>(responseSize)){
+    DEVLOG_ERROR("CModbusRtuServerConnection: could not send response on %s: %s\n", m_acDevice, strerror(errno));
+  }
+  m_nFillSize -= pa_nFrameSize;
+  if(0 != m_nFillSize){
+    memmove(m_acRecvBuffer, &m_acRecvBuffer[pa_nFrameSize], m_nFillSize);
+  }
+}
+
+unsigned int CModbusRtuServerConnection::processFrame(const TForteUInt8 *pa_pFrame, unsigned int pa_nFrameSize, TForteUInt8 *pa_pResponse){
+  if(pa_nFrameSize < scm_nMinFrameSize || scm_nMaxAduSize < pa_nFrameSize){
+    return 0;
+  }
+  // the CRC is sent low byte first
+  TForteUInt16 crc = static_cast<TForteUInt16>(pa_pFrame[pa_nFrameSize - 2] | (pa_pFrame[pa_nFrameSize - 1] << 8));
+  if(crc != calculateCrc(pa_pFrame, pa_nFrameSize - 2)){
+    return 0;
+  }
+  unsigned int slaveId = pa_pFrame[0];
+  if(slaveId != m_nSlaveId && scm_nBroadcastId != slaveId){
+    return 0;
+  }
+
+  unsigned int responsePduSize = processPdu(&pa_pFrame[1], pa_nFrameSize - 3, &pa_pResponse[1]);
+  if(scm_nBroadcastId == slaveId){
+    return 0;
+  }
+  pa_pResponse[0] = static_cast<TForteUInt8>(slaveId);
+  crc = calculateCrc(pa_pResponse, responsePduSize + 1);
+  pa_pResponse[responsePduSize + 1] = static_cast<TForteUInt8>(crc);
+  pa_pResponse[responsePduSize + 2] = static_cast<TForteUInt8>(crc >> 8);
+  return responsePduSize + 3;
+}
+
+unsigned int CModbusRtuServerConnection::getRequestSize(const TForteUInt8 *pa_pFrame, unsigned int pa_nFillSize){
+  if(pa_nFillSize < 2){
+    return 0;
+  }
+  TForteUInt8 functionCode = pa_pFrame[1];
+  if(1 <= functionCode && functionCode <= 6){
+    // slave id, function code, address, quantity or value and CRC
+    return 8;
+  }
+  if(15 == functionCode || 16 == functionCode){
+    // slave id, function code, address, quantity, byte count, values and CRC
+    return (pa_nFillSize < 7) ? 0 : 9U + pa_pFrame[6];
+  }
+  return 0;
+}
+
+TForteUInt16 CModbusRtuServerConnection::calculateCrc(const TForteUInt8 *pa_pData, unsigned int pa_nSize){
+  TForteUInt16 crc = 0xFFFF;
+  for(unsigned int i = 0; i < pa_nSize; i++){
+    crc = static_cast<TForteUInt16>(crc ^ pa_pData[i]);
+    for(unsigned int bit = 0; bit < 8; bit++){
+      crc = static_cast<TForteUInt16>((0 != (crc & 1)) ? ((crc >> 1) ^ 0xA001) : (crc >> 1));
+    }
+  }
+  return crc;
+}
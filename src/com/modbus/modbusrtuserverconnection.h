@@ -0,0 +1,85 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#ifndef _MODBUSRTUSERVERCONNECTION_H_
+#define _MODBUSRTUSERVERCONNECTION_H_
+
+#include "modbusserverconnection.h"
+
+/*! \brief Modbus RTU server on a serial device
+ *
+ *  The server answers requests addressed to its slave id and executes broadcasts (slave id 0) without answering
+ *  them. The end of a request is taken from its size for the supported function codes. Other frames end with the
+ *  silent interval of 3.5 characters, which is rounded up to full milliseconds.
+ */
+class CModbusRtuServerConnection : public CModbusServerConnection{
+  public:
+    //! Maximum size of a Modbus RTU ADU (slave id, PDU and CRC)
+    static const unsigned int scm_nMaxAduSize = 256;
+
+    CModbusRtuServerConnection(const char *pa_acDevice, int pa_nBaud, char pa_cParity, int pa_nDataBit, int pa_nStopBit, unsigned int pa_nSlaveId);
+    ~CModbusRtuServerConnection();
+
+    int listen();
+
+    void stop();
+
+    bool isRtuDevice(const char *pa_acDevice) const;
+
+    //! \return true if the server uses the given line settings and slave id
+    bool hasSettings(int pa_nBaud, char pa_cParity, int pa_nDataBit, int pa_nStopBit, unsigned int pa_nSlaveId) const;
+
+    /*! \brief Handles a complete Modbus RTU frame
+     *
+     *  \param pa_pFrame the frame including slave id and CRC
+     *  \param pa_nFrameSize size of the frame
+     *  \param pa_pResponse buffer of scm_nMaxAduSize bytes for the response
+     *  \return size of the response, 0 if the frame is not answered because it is corrupted, addressed to another slave or a broadcast
+     */
+    unsigned int processFrame(const TForteUInt8 *pa_pFrame, unsigned int pa_nFrameSize, TForteUInt8 *pa_pResponse);
+
+    /*! \brief Determines the size of a request from its first bytes
+     *
+     *  \return size of the request or 0 if it can not be determined (yet) from the received bytes
+     */
+    static unsigned int getRequestSize(const TForteUInt8 *pa_pFrame, unsigned int pa_nFillSize);
+
+    static TForteUInt16 calculateCrc(const TForteUInt8 *pa_pData, unsigned int pa_nSize);
+
+  protected:
+    virtual void run();
+
+  private:
+    bool configureDevice();
+    //! \return false if the device reported an error
+    bool receive();
+    //! Handles the first pa_nFrameSize received bytes as one frame and removes them from the receive buffer
+    void handleFrame(unsigned int pa_nFrameSize);
+
+    char m_acDevice[256];
+    int m_nBaud;
+    char m_cParity;
+    int m_nDataBit;
+    int m_nStopBit;
+    unsigned int m_nSlaveId;
+    //! Silent interval of 3.5 characters ending a frame, in milliseconds
+    int m_nFrameTimeout;
+
+    int m_nDeviceFd;
+    //! eventfd used to wake up the serving thread when it should stop
+    int m_nWakeUpFd;
+
+    unsigned int m_nFillSize;
+    TForteUInt8 m_acRecvBuffer[scm_nMaxAduSize];
+    TForteUInt8 m_acResponse[scm_nMaxAduSize];
+};
+
+#endif /* _MODBUSRTUSERVERCONNECTION_H_ */
@@ -0,0 +1,170 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include "modbusserverconnection.h"
+#include <string.h>
+
+namespace {
+  const unsigned int scm_nMaxReadBits = 2000;
+  const unsigned int scm_nMaxReadRegisters = 125;
+  const unsigned int scm_nMaxWriteBits = 1968;
+  const unsigned int scm_nMaxWriteRegisters = 123;
+}
+
+CModbusServerConnection::CModbusServerConnection(){
+}
+
+CModbusServerConnection::~CModbusServerConnection(){
+}
+
+unsigned int CModbusServerConnection::processPdu(const TForteUInt8 *pa_pPdu, unsigned int pa_nPduSize, TForteUInt8 *pa_pResponsePdu){
+  unsigned int responsePduSize;
+
+  if(1 <= pa_pPdu[0] && pa_pPdu[0] <= 6 && 5 != pa_nPduSize){
+    responsePduSize = exceptionResponse(pa_pPdu, e_IllegalDataValue, pa_pResponsePdu);
+  }
+  else{
+    switch (pa_pPdu[0]){
+      case 1:
+        responsePduSize = readBits(CModbusRegisterImage::e_Coils, pa_pPdu, pa_pResponsePdu);
+        break;
+      case 2:
+        responsePduSize = readBits(CModbusRegisterImage::e_DiscreteInputs, pa_pPdu, pa_pResponsePdu);
+        break;
+      case 3:
+        responsePduSize = readRegisters(CModbusRegisterImage::e_HoldingRegisters, pa_pPdu, pa_pResponsePdu);
+        break;
+      case 4:
+        responsePduSize = readRegisters(CModbusRegisterImage::e_InputRegisters, pa_pPdu, pa_pResponsePdu);
+        break;
+      case 5: {
+        TForteUInt16 value = getUInt16(&pa_pPdu[3]);
+        if(0xFF00 != value && 0x0000 != value){
+          responsePduSize = exceptionResponse(pa_pPdu, e_IllegalDataValue, pa_pResponsePdu);
+          break;
+        }
+        m_oRegisterImage.write(CModbusRegisterImage::e_Coils, getUInt16(&pa_pPdu[1]), 1, &value);
+        memcpy(pa_pResponsePdu, pa_pPdu, pa_nPduSize);
+        responsePduSize = pa_nPduSize;
+        break;
+      }
+      case 6: {
+        TForteUInt16 value = getUInt16(&pa_pPdu[3]);
+        m_oRegisterImage.write(CModbusRegisterImage::e_HoldingRegisters, getUInt16(&pa_pPdu[1]), 1, &value);
+        memcpy(pa_pResponsePdu, pa_pPdu, pa_nPduSize);
+        responsePduSize = pa_nPduSize;
+        break;
+      }
+      case 15:
+        responsePduSize = writeCoils(pa_pPdu, pa_nPduSize, pa_pResponsePdu);
+        break;
+      case 16:
+        responsePduSize = writeRegisters(pa_pPdu, pa_nPduSize, pa_pResponsePdu);
+        break;
+      default:
+        responsePduSize = exceptionResponse(pa_pPdu, e_IllegalFunction, pa_pResponsePdu);
+        break;
+    }
+  }
+  return responsePduSize;
+}
+
+unsigned int CModbusServerConnection::readBits(CModbusRegisterImage::ETable pa_eTable, const TForteUInt8 *pa_pPdu, TForteUInt8 *pa_pResponsePdu){
+  unsigned int startAddress = getUInt16(&pa_pPdu[1]);
+  unsigned int nrBits = getUInt16(&pa_pPdu[3]);
+  if(0 == nrBits || scm_nMaxReadBits < nrBits){
+    return exceptionResponse(pa_pPdu, e_IllegalDataValue, pa_pResponsePdu);
+  }
+  if(!CModbusRegisterImage::isValidRange(startAddress, nrBits)){
+    return exceptionResponse(pa_pPdu, e_IllegalDataAddress, pa_pResponsePdu);
+  }
+
+  m_oRegisterImage.readBits(pa_eTable, startAddress, nrBits, m_acBits);
+  unsigned int nrBytes = (nrBits + 7) / 8;
+  pa_pResponsePdu[0] = pa_pPdu[0];
+  pa_pResponsePdu[1] = static_cast<TForteUInt8>(nrBytes);
+  memset(&pa_pResponsePdu[2], 0, nrBytes);
+  for(unsigned int i = 0; i < nrBits; i++){
+    if(0 != m_acBits[i]){
+      pa_pResponsePdu[2 + i / 8] = static_cast<TForteUInt8>(pa_pResponsePdu[2 + i / 8] | (1 << (i % 8)));
+    }
+  }
+  return 2 + nrBytes;
+}
+
+unsigned int CModbusServerConnection::readRegisters(CModbusRegisterImage::ETable pa_eTable, const TForteUInt8 *pa_pPdu, TForteUInt8 *pa_pResponsePdu){
+  unsigned int startAddress = getUInt16(&pa_pPdu[1]);
+  unsigned int nrRegisters = getUInt16(&pa_pPdu[3]);
+  if(0 == nrRegisters || scm_nMaxReadRegisters < nrRegisters){
+    return exceptionResponse(pa_pPdu, e_IllegalDataValue, pa_pResponsePdu);
+  }
+  if(!CModbusRegisterImage::isValidRange(startAddress, nrRegisters)){
+    return exceptionResponse(pa_pPdu, e_IllegalDataAddress, pa_pResponsePdu);
+  }
+
+  m_oRegisterImage.readRegisters(pa_eTable, startAddress, nrRegisters, m_anValues);
+  pa_pResponsePdu[0] = pa_pPdu[0];
+  pa_pResponsePdu[1] = static_cast<TForteUInt8>(nrRegisters * 2);
+  for(unsigned int i = 0; i < nrRegisters; i++){
+    setUInt16(&pa_pResponsePdu[2 + 2 * i], m_anValues[i]);
+  }
+  return 2 + nrRegisters * 2;
+}
+
+unsigned int CModbusServerConnection::writeCoils(const TForteUInt8 *pa_pPdu, unsigned int pa_nPduSize, TForteUInt8 *pa_pResponsePdu){
+  if(pa_nPduSize < 6){
+    return exceptionResponse(pa_pPdu, e_IllegalDataValue, pa_pResponsePdu);
+  }
+  unsigned int startAddress = getUInt16(&pa_pPdu[1]);
+  unsigned int nrBits = getUInt16(&pa_pPdu[3]);
+  unsigned int nrBytes = pa_pPdu[5];
+  if(0 == nrBits || scm_nMaxWriteBits < nrBits || (nrBits + 7) / 8 != nrBytes || pa_nPduSize != 6 + nrBytes){
+    return exceptionResponse(pa_pPdu, e_IllegalDataValue, pa_pResponsePdu);
+  }
+  if(!CModbusRegisterImage::isValidRange(startAddress, nrBits)){
+    return exceptionResponse(pa_pPdu, e_IllegalDataAddress, pa_pResponsePdu);
+  }
+
+  for(unsigned int i = 0; i < nrBits; i++){
+    m_anValues[i] = static_cast<TForteUInt16>((pa_pPdu[6 + i / 8] >> (i % 8)) & 1);
+  }
+  m_oRegisterImage.write(CModbusRegisterImage::e_Coils, startAddress, nrBits, m_anValues);
+  memcpy(pa_pResponsePdu, pa_pPdu, 5);
+  return 5;
+}
+
+unsigned int CModbusServerConnection::writeRegisters(const TForteUInt8 *pa_pPdu, unsigned int pa_nPduSize, TForteUInt8 *pa_pResponsePdu){
+  if(pa_nPduSize < 6){
+    return exceptionResponse(pa_pPdu, e_IllegalDataValue, pa_pResponsePdu);
+  }
+  unsigned int startAddress = getUInt16(&pa_pPdu[1]);
+  unsigned int nrRegisters = getUInt16(&pa_pPdu[3]);
+  unsigned int nrBytes = pa_pPdu[5];
+  if(0 == nrRegisters || scm_nMaxWriteRegisters < nrRegisters || nrRegisters * 2 != nrBytes || pa_nPduSize != 6 + nrBytes){
+    return exceptionResponse(pa_pPdu, e_IllegalDataValue, pa_pResponsePdu);
+  }
+  if(!CModbusRegisterImage::isValidRange(startAddress, nrRegisters)){
+    return exceptionResponse(pa_pPdu, e_IllegalDataAddress, pa_pResponsePdu);
+  }
+
+  for(unsigned int i = 0; i < nrRegisters; i++){
+    m_anValues[i] = getUInt16(&pa_pPdu[6 + 2 * i]);
+  }
+  m_oRegisterImage.write(CModbusRegisterImage::e_HoldingRegisters, startAddress, nrRegisters, m_anValues);
+  memcpy(pa_pResponsePdu, pa_pPdu, 5);
+  return 5;
+}
+
+unsigned int CModbusServerConnection::exceptionResponse(const TForteUInt8 *pa_pPdu, EExceptionCode pa_eCode, TForteUInt8 *pa_pResponsePdu){
+  pa_pResponsePdu[0] = static_cast<TForteUInt8>(pa_pPdu[0] | 0x80);
+  pa_pResponsePdu[1] = static_cast<TForteUInt8>(pa_eCode);
+  return 2;
+}
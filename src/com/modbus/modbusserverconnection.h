@@ -0,0 +1,100 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#ifndef _MODBUSSERVERCONNECTION_H_
+#define _MODBUSSERVERCONNECTION_H_
+
+#include <forte_config.h>
+#include <forte_thread.h>
+#include "modbusregisterimage.h"
+
+/*! \brief Base of the Modbus servers answering requests from the register image of a device
+ *
+ *  The server handles the Modbus PDUs, the derived classes receive the requests and send the responses with the framing
+ *  of their transport. Each server is served by its own thread.
+ *
+ *  Supported function codes are 1 - 6, 15 and 16. Values written by a master are stored in the register image.
+ */
+class CModbusServerConnection : public CThread{
+  public:
+    //! Maximum size of a Modbus PDU (function code and data)
+    static const unsigned int scm_nMaxPduSize = 253;
+
+    CModbusServerConnection();
+    virtual ~CModbusServerConnection();
+
+    /*! \brief Opens the endpoint and starts serving
+     *
+     *  \return 0 on success, -1 if the endpoint could not be opened
+     */
+    virtual int listen() = 0;
+
+    //! Stops serving and closes the endpoint
+    virtual void stop() = 0;
+
+    //! \return true if the server is a Modbus TCP server listening on the given address
+    virtual bool isTcpEndpoint(const char *, unsigned int) const {
+      return false;
+    }
+
+    //! \return true if the server is a Modbus RTU server on the given serial device
+    virtual bool isRtuDevice(const char *) const {
+      return false;
+    }
+
+    CModbusRegisterImage &getRegisterImage(){
+      return m_oRegisterImage;
+    }
+
+    /*! \brief Handles a request PDU
+     *
+     *  \param pa_pPdu function code and data of the request
+     *  \param pa_nPduSize size of the request PDU, at least one byte for the function code
+     *  \param pa_pResponsePdu buffer of scm_nMaxPduSize bytes for the response PDU
+     *  \return size of the response PDU
+     */
+    unsigned int processPdu(const TForteUInt8 *pa_pPdu, unsigned int pa_nPduSize, TForteUInt8 *pa_pResponsePdu);
+
+  protected:
+    static TForteUInt16 getUInt16(const TForteUInt8 *pa_pData){
+      return static_cast<TForteUInt16>((pa_pData[0] << 8) | pa_pData[1]);
+    }
+
+    static void setUInt16(TForteUInt8 *pa_pData, TForteUInt16 pa_nValue){
+      pa_pData[0] = static_cast<TForteUInt8>(pa_nValue >> 8);
+      pa_pData[1] = static_cast<TForteUInt8>(pa_nValue);
+    }
+
+  private:
+    enum EExceptionCode{
+      e_IllegalFunction = 1,
+      e_IllegalDataAddress = 2,
+      e_IllegalDataValue = 3
+    };
+
+    unsigned int readBits(CModbusRegisterImage::ETable pa_eTable, const TForteUInt8 *pa_pPdu, TForteUInt8 *pa_pResponsePdu);
+    unsigned int readRegisters(CModbusRegisterImage::ETable pa_eTable, const TForteUInt8 *pa_pPdu, TForteUInt8 *pa_pResponsePdu);
+    unsigned int writeCoils(const TForteUInt8 *pa_pPdu, unsigned int pa_nPduSize, TForteUInt8 *pa_pResponsePdu);
+    unsigned int writeRegisters(const TForteUInt8 *pa_pPdu, unsigned int pa_nPduSize, TForteUInt8 *pa_pResponsePdu);
+
+    static unsigned int exceptionResponse(const TForteUInt8 *pa_pPdu, EExceptionCode pa_eCode, TForteUInt8 *pa_pResponsePdu);
+
+    CModbusRegisterImage m_oRegisterImage;
+
+    //! Values of a request converted from or to the PDU representation
+    TForteUInt16 m_anValues[2000];
+    TForteUInt8 m_acBits[2000];
+
+    CModbusServerConnection(const CModbusServerConnection&);
+    CModbusServerConnection& operator=(const CModbusServerConnection&);
+};
+
+#endif /* _MODBUSSERVERCONNECTION_H_ */
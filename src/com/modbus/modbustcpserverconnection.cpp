@@ -0,0 +1,233 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include "modbustcpserverconnection.h"
+#include <devlog.h>
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+  //! Transaction id, protocol id, length and unit id
+  const unsigned int scm_nMbapHeaderSize = 7;
+
+  const TForteUInt32 scm_nListenSocketIndex = CModbusTcpServerConnection::scm_nMaxClients;
+  const TForteUInt32 scm_nWakeUpIndex = CModbusTcpServerConnection::scm_nMaxClients + 1;
+
+  void closeDescriptor(int &pa_rnDescriptor){
+    if(-1 != pa_rnDescriptor){
+      close(pa_rnDescriptor);
+      pa_rnDescriptor = -1;
+    }
+  }
+
+  bool addToEpoll(int pa_nEpollFd, int pa_nDescriptor, TForteUInt32 pa_nIndex){
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.u32 = pa_nIndex;
+    return (0 == epoll_ctl(pa_nEpollFd, EPOLL_CTL_ADD, pa_nDescriptor, &event));
+  }
+}
+
+CModbusTcpServerConnection::CModbusTcpServerConnection(const char *pa_acIp, unsigned int pa_nPort) :
+    m_nPort(pa_nPort), m_nListenSocket(-1), m_nEpollFd(-1), m_nWakeUpFd(-1){
+  strncpy(m_acIp, pa_acIp, sizeof(m_acIp) - 1);
+  m_acIp[sizeof(m_acIp) - 1] = '\0';
+  for(unsigned int i = 0; i < scm_nMaxClients; i++){
+    m_astClients[i].m_nSocket = -1;
+    m_astClients[i].m_nFillSize = 0;
+  }
+}
+
+CModbusTcpServerConnection::~CModbusTcpServerConnection(){
+  stop();
+}
+
+bool CModbusTcpServerConnection::isTcpEndpoint(const char *pa_acIp, unsigned int pa_nPort) const{
+  return (m_nPort == pa_nPort && 0 == strcmp(m_acIp, pa_acIp));
+}
+
+int CModbusTcpServerConnection::listen(){
+  struct sockaddr_in address;
+  memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_port = htons(static_cast<uint16_t>(m_nPort));
+  if(1 != inet_pton(AF_INET, m_acIp, &address.sin_addr)){
+    DEVLOG_ERROR("CModbusTcpServerConnection: invalid IP address %s\n", m_acIp);
+    return -1;
+  }
+
+  m_nListenSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+  if(-1 == m_nListenSocket){
+    DEVLOG_ERROR("CModbusTcpServerConnection: could not create socket: %s\n", strerror(errno));
+    return -1;
+  }
+  int optionValue = 1;
+  setsockopt(m_nListenSocket, SOL_SOCKET, SO_REUSEADDR, &optionValue, sizeof(optionValue));
+
+  if(0 != bind(m_nListenSocket, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) || 0 != ::listen(m_nListenSocket, SOMAXCONN)
+      || 0 != fcntl(m_nListenSocket, F_SETFL, O_NONBLOCK)){
+    DEVLOG_ERROR("CModbusTcpServerConnection: could not listen on %s:%u: %s\n", m_acIp, m_nPort, strerror(errno));
+    stop();
+    return -1;
+  }
+
+  m_nEpollFd = epoll_create(scm_nMaxClients + 2);
+  m_nWakeUpFd = eventfd(0, EFD_NONBLOCK);
+  if(-1 == m_nEpollFd || -1 == m_nWakeUpFd || !addToEpoll(m_nEpollFd, m_nListenSocket, scm_nListenSocketIndex)
+      || !addToEpoll(m_nEpollFd, m_nWakeUpFd, scm_nWakeUpIndex)){
+    DEVLOG_ERROR("CModbusTcpServerConnection: could not set up epoll: %s\n", strerror(errno));
+    stop();
+    return -1;
+  }
+
+  DEVLOG_INFO("CModbusTcpServerConnection: serving Modbus TCP on %s:%u\n", m_acIp, m_nPort);
+  start();
+  return 0;
+}
+
+void CModbusTcpServerConnection::stop(){
+  setAlive(false);
+  if(-1 != m_nWakeUpFd){
+    eventfd_write(m_nWakeUpFd, 1);
+  }
+  end();
+
+  for(unsigned int i = 0; i < scm_nMaxClients; i++){
+    closeClient(m_astClients[i]);
+  }
+  closeDescriptor(m_nListenSocket);
+  closeDescriptor(m_nEpollFd);
+  closeDescriptor(m_nWakeUpFd);
+}
+
+void CModbusTcpServerConnection::run(){
+  struct epoll_event events[scm_nMaxClients + 2];
+
+  while(isAlive()){
+    int nrEvents = epoll_wait(m_nEpollFd, events, scm_nMaxClients + 2, -1);
+    if(nrEvents < 0){
+      if(EINTR == errno){
+        continue;
+      }
+      DEVLOG_ERROR("CModbusTcpServerConnection: epoll_wait failed: %s\n", strerror(errno));
+      break;
+    }
+    for(int i = 0; i < nrEvents && isAlive(); i++){
+      TForteUInt32 index = events[i].data.u32;
+      if(scm_nListenSocketIndex == index){
+        acceptClients();
+      }
+      else if(index < scm_nMaxClients){
+        receiveFromClient(m_astClients[index]);
+      }
+    }
+  }
+}
+
+void CModbusTcpServerConnection::acceptClients(){
+  for(;;){
+    int clientSocket = accept(m_nListenSocket, 0, 0);
+    if(-1 == clientSocket){
+      if(EAGAIN != errno && EWOULDBLOCK != errno && EINTR != errno){
+        DEVLOG_ERROR("CModbusTcpServerConnection: accept failed: %s\n", strerror(errno));
+      }
+      return;
+    }
+
+    TForteUInt32 index = 0;
+    while(index < scm_nMaxClients && -1 != m_astClients[index].m_nSocket){
+      index++;
+    }
+    if(scm_nMaxClients == index){
+      DEVLOG_WARNING("CModbusTcpServerConnection: too many Modbus masters connected, rejecting a new connection\n");
+      close(clientSocket);
+      continue;
+    }
+
+    int optionValue = 1;
+    setsockopt(clientSocket, IPPROTO_TCP, TCP_NODELAY, &optionValue, sizeof(optionValue));
+    if(0 != fcntl(clientSocket, F_SETFL, O_NONBLOCK) || !addToEpoll(m_nEpollFd, clientSocket, index)){
+      DEVLOG_ERROR("CModbusTcpServerConnection: could not add new connection: %s\n", strerror(errno));
+      close(clientSocket);
+      continue;
+    }
+    m_astClients[index].m_nSocket = clientSocket;
+    m_astClients[index].m_nFillSize = 0;
+  }
+}
+
+void CModbusTcpServerConnection::receiveFromClient(SClient &pa_roClient){
+  ssize_t nrBytes = recv(pa_roClient.m_nSocket, &pa_roClient.m_acRecvBuffer[pa_roClient.m_nFillSize], scm_nMaxAduSize - pa_roClient.m_nFillSize, 0);
+  if(nrBytes <= 0){
+    if(0 == nrBytes || (EAGAIN != errno && EWOULDBLOCK != errno && EINTR != errno)){
+      closeClient(pa_roClient);
+    }
+    return;
+  }
+  pa_roClient.m_nFillSize += static_cast<unsigned int>(nrBytes);
+
+  unsigned int position = 0;
+  while(pa_roClient.m_nFillSize - position >= scm_nMbapHeaderSize){
+    const TForteUInt8 *request = &pa_roClient.m_acRecvBuffer[position];
+    unsigned int length = getUInt16(&request[4]);
+    if(0 != getUInt16(&request[2]) || length < 2 || length > scm_nMaxAduSize - (scm_nMbapHeaderSize - 1)){
+      // not a Modbus TCP frame, we can't find the start of the next request anymore
+      closeClient(pa_roClient);
+      return;
+    }
+    unsigned int requestSize = scm_nMbapHeaderSize - 1 + length;
+    if(pa_roClient.m_nFillSize - position < requestSize){
+      break;
+    }
+
+    unsigned int responseSize = processRequest(request, m_acResponse);
+    if(send(pa_roClient.m_nSocket, m_acResponse, responseSize, MSG_NOSIGNAL) != static_cast<ssize_t>(responseSize)){
+      closeClient(pa_roClient);
+      return;
+    }
+    position += requestSize;
+  }
+
+  if(0 != position){
+    memmove(pa_roClient.m_acRecvBuffer, &pa_roClient.m_acRecvBuffer[position], pa_roClient.m_nFillSize - position);
+    pa_roClient.m_nFillSize -= position;
+  }
+}
+
+void CModbusTcpServerConnection::closeClient(SClient &pa_roClient){
+  if(-1 != pa_roClient.m_nSocket){
+    if(-1 != m_nEpollFd){
+      epoll_ctl(m_nEpollFd, EPOLL_CTL_DEL, pa_roClient.m_nSocket, 0);
+    }
+    closeDescriptor(pa_roClient.m_nSocket);
+  }
+  pa_roClient.m_nFillSize = 0;
+}
+
+unsigned int CModbusTcpServerConnection::processRequest(const TForteUInt8 *pa_pRequest, TForteUInt8 *pa_pResponse){
+  unsigned int responsePduSize = processPdu(&pa_pRequest[scm_nMbapHeaderSize], getUInt16(&pa_pRequest[4]) - 1U, &pa_pResponse[scm_nMbapHeaderSize]);
+
+  // transaction id, protocol id and unit id are taken from the request
+  memcpy(pa_pResponse, pa_pRequest, 4);
+  setUInt16(&pa_pResponse[4], static_cast<TForteUInt16>(responsePduSize + 1));
+  pa_pResponse[6] = pa_pRequest[6];
+  return scm_nMbapHeaderSize + responsePduSize;
+}
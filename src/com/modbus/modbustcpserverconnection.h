@@ -0,0 +1,74 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#ifndef _MODBUSTCPSERVERCONNECTION_H_
+#define _MODBUSTCPSERVERCONNECTION_H_
+
+#include "modbusserverconnection.h"
+
+/*! \brief Modbus TCP server
+ *
+ *  All masters connected to one endpoint are served by a single thread waiting with epoll on the listening socket
+ *  and all client sockets. Each client has a fixed receive buffer, requests are handled in place and answered from a
+ *  shared response buffer, so no memory is allocated while serving. Pipelined requests are processed in order.
+ */
+class CModbusTcpServerConnection : public CModbusServerConnection{
+  public:
+    //! Maximum size of a Modbus TCP ADU (MBAP header and PDU)
+    static const unsigned int scm_nMaxAduSize = 260;
+    //! Number of masters which can be connected at the same time
+    static const unsigned int scm_nMaxClients = 32;
+
+    CModbusTcpServerConnection(const char *pa_acIp, unsigned int pa_nPort);
+    ~CModbusTcpServerConnection();
+
+    int listen();
+
+    void stop();
+
+    bool isTcpEndpoint(const char *pa_acIp, unsigned int pa_nPort) const;
+
+    /*! \brief Handles a complete Modbus TCP request
+     *
+     *  \param pa_pRequest the request including the MBAP header
+     *  \param pa_pResponse buffer of scm_nMaxAduSize bytes for the response
+     *  \return size of the response
+     */
+    unsigned int processRequest(const TForteUInt8 *pa_pRequest, TForteUInt8 *pa_pResponse);
+
+  protected:
+    virtual void run();
+
+  private:
+    struct SClient{
+        int m_nSocket;
+        unsigned int m_nFillSize;
+        TForteUInt8 m_acRecvBuffer[scm_nMaxAduSize];
+    };
+
+    void acceptClients();
+    void receiveFromClient(SClient &pa_roClient);
+    void closeClient(SClient &pa_roClient);
+
+    char m_acIp[16];
+    unsigned int m_nPort;
+
+    int m_nListenSocket;
+    int m_nEpollFd;
+    //! eventfd used to wake up the serving thread when it should stop
+    int m_nWakeUpFd;
+
+    SClient m_astClients[scm_nMaxClients];
+
+    TForteUInt8 m_acResponse[scm_nMaxAduSize];
+};
+
+#endif /* _MODBUSTCPSERVERCONNECTION_H_ */
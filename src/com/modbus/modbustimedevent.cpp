@@ -52,6 +52,12 @@ bool CModbusTimedEvent::readyToExecute() const{
   return false;
 }
 
+uint_fast64_t CModbusTimedEvent::getTimeToNextExecution() const{
+  uint_fast64_t currentTime = NOW_MONOTONIC().getInMilliSeconds();
+  uint_fast64_t nextExecution = m_nStartTime + m_nUpdateInterval;
+  return (nextExecution > currentTime) ? nextExecution - currentTime : 0;
+}
+
 void CModbusTimedEvent::restartTimer(){
 
   activate();
@@ -35,6 +35,9 @@ class CModbusTimedEvent{
 
     bool readyToExecute() const;
 
+    //! Milliseconds until the event is ready to be executed, 0 if it is ready already
+    uint_fast64_t getTimeToNextExecution() const;
+
     // Classes impementing this should call restartTimer in executeEvent
     virtual int executeEvent(modbus_t* pa_pModbusConn, void* pa_pRetVal) = 0;
 
@@ -8,6 +8,7 @@
  *
  * Contributors:
  * Martin Melik Merkumians - initial API and implementation and/or initial documentation
+ * agent - publish pipeline with in-flight window and statistics topic
  *******************************************************************************/
 
 
@@ -15,11 +16,16 @@
 #include "../../core/utils/parameterParser.h"
 #include "MQTTHandler.h"
 #include "commfb.h"
+#include <criticalregion.h>
+#include <devlog.h>
+#include "../../core/utils/string_utils.h"
+#include <stdio.h>
 
 using namespace forte::com_infra;
 
 MQTTComLayer::MQTTComLayer(CComLayer* paUpperLayer, CBaseCommFB * pFB) : CComLayer(paUpperLayer, pFB),
-    mUsedBuffer(0), mInterruptResp(e_Nothing){
+    mBrokerConnection(0), mQoS(QOS), mCallbackContext(0), mStatisticsInterval(0), mLastStatistics(0), mUsedBuffer(0),
+    mInterruptResp(e_Nothing){
   memset(mDataBuffer, 0, mBufferSize); //TODO change this to  dataBuffer{0} in the extended list when fully switching to C++11
 }
 
@@ -27,17 +33,85 @@ MQTTComLayer::~MQTTComLayer() {
 }
 
 EComResponse MQTTComLayer::sendData(void* paData, unsigned int paSize) {
+  if(0 == mBrokerConnection) {
+    return e_ProcessDataNoSocket;
+  }
+  CCriticalRegion section(mSendLock);
+  EComResponse retVal = e_ProcessDataOk;
+  if(!mPipeline.isWindowFull()) {
+    if(!publish(paData, paSize)) {
+      retVal = e_ProcessDataSendFailed;
+    }
+  } else {
+    //the in-flight window is full, keep the value until an acknowledgment frees a slot
+    mPipeline.enqueue(paData, paSize);
+  }
+  publishStatistics(getNanoSecondsMonotonic());
+  return retVal;
+}
+
+MQTTComLayer::SPublishStatistics MQTTComLayer::getPublishStatistics() {
+  CCriticalRegion section(mSendLock);
+  return mPipeline.getStatistics();
+}
+
+bool MQTTComLayer::publish(const void* paData, unsigned int paSize) {
   MQTTAsync_message message = MQTTAsync_message_initializer;
-  message.payload = paData;
-  message.payloadlen = paSize;
-  message.qos = QOS;
+  message.payload = const_cast<void*>(paData); //Paho copies the payload
+  message.payloadlen = static_cast<int>(paSize);
+  message.qos = mQoS;
   message.retained = 0;
-  int errorCode = MQTTAsync_sendMessage(getExtEvHandler<MQTTHandler>().getClient(), mTopicName.getValue(), &message, NULL);
-  if (0 != errorCode) {
-    return e_ProcessDataSendFailed;
+  MQTTAsync_responseOptions opts = MQTTAsync_responseOptions_initializer;
+  //the acknowledgments may arrive after the layer is deleted, the handler only passes them on while it is registered
+  opts.onSuccess = MQTTHandler::onPublishSucceeded;
+  opts.onFailure = MQTTHandler::onPublishFailed;
+  opts.context = mCallbackContext;
+  if (0 != MQTTAsync_sendMessage(mBrokerConnection->getClient(), mTopicName.getValue(), &message, &opts)) {
+    mPipeline.sendFailed();
+    return false;
+  }
+  mPipeline.sent(getNanoSecondsMonotonic());
+  return true;
+}
+
+void MQTTComLayer::publishStatistics(uint_fast64_t paNow) {
+  if(0 == mStatisticsInterval || (paNow - mLastStatistics) < mStatisticsInterval) {
+    return;
+  }
+  mLastStatistics = paNow;
+  const SPublishStatistics &statistics(mPipeline.getStatistics());
+  char payload[320];
+  int size = snprintf(payload, sizeof(payload),
+      "{\"sent\":%u,\"acknowledged\":%u,\"failed\":%u,\"dropped\":%u,\"inFlight\":%u,\"queueDepth\":%u,"
+      "\"maxQueueDepth\":%u,\"lastAckLatency\":%llu,\"maxAckLatency\":%llu,\"avgAckLatency\":%llu}",
+      static_cast<unsigned int>(statistics.mSent), static_cast<unsigned int>(statistics.mAcknowledged),
+      static_cast<unsigned int>(statistics.mFailed), static_cast<unsigned int>(statistics.mDropped), statistics.mInFlight,
+      statistics.mQueueDepth, statistics.mMaxQueueDepth, static_cast<unsigned long long>(statistics.mLastAckLatency),
+      static_cast<unsigned long long>(statistics.mMaxAckLatency),
+      static_cast<unsigned long long>((0 != statistics.mAcknowledged) ? statistics.mSumAckLatency / statistics.mAcknowledged : 0));
+  if(0 >= size || sizeof(payload) <= static_cast<size_t>(size)) {
+    return;
+  }
+  MQTTAsync_message message = MQTTAsync_message_initializer;
+  message.payload = payload;
+  message.payloadlen = size;
+  message.qos = 0;
+  message.retained = 1; //so that a client subscribing later gets the current values right away
+  //the statistics are not part of the publish pipeline and need no acknowledgment
+  MQTTAsync_responseOptions opts = MQTTAsync_responseOptions_initializer;
+  MQTTAsync_sendMessage(mBrokerConnection->getClient(), mStatisticsTopic.c_str(), &message, &opts);
+}
+
+void MQTTComLayer::publishFinished(bool paSuccess) {
+  CCriticalRegion section(mSendLock);
+  if(!mPipeline.acknowledged(paSuccess, getNanoSecondsMonotonic())) {
+    return;
+  }
+  if(0 != mBrokerConnection) {
+    for(const forte::core::util::CPublishPipeline::SMessage *message = mPipeline.takeNext(); 0 != message; message = mPipeline.takeNext()) {
+      publish(message->mData, message->mSize);
+    }
   }
-  //while(deliveredtoken != token);
-  return e_ProcessDataOk;
 }
 
 EComResponse MQTTComLayer::recvData(const void* paData,  unsigned int paSize) {
@@ -64,9 +138,30 @@ EComResponse MQTTComLayer::processInterrupt() {
 
 EComResponse MQTTComLayer::openConnection(char* paLayerParameter) {
   EComResponse eRetVal = e_InitInvalidId;
-  CParameterParser parser(paLayerParameter, ',', mNoOfParameters);
-  if(mNoOfParameters == parser.parseParameters()){
+  CParameterParser parser(paLayerParameter, ',', mMaxNoOfParameters);
+  size_t noOfParameters = parser.parseParameters();
+  if(mMinNoOfParameters <= noOfParameters && mMaxNoOfParameters >= noOfParameters){
     mTopicName = parser[Topic];
+    if(QoS < noOfParameters){
+      mQoS = static_cast<int>(forte::core::util::strtol(parser[QoS], 0, 10));
+    }
+    unsigned int inFlightWindow = scmDefaultInFlightWindow;
+    unsigned int sendQueueSize = scmDefaultSendQueueSize;
+    if(InFlightWindow < noOfParameters){
+      inFlightWindow = static_cast<unsigned int>(forte::core::util::strtoul(parser[InFlightWindow], 0, 10));
+    }
+    if(SendQueueSize < noOfParameters){
+      sendQueueSize = static_cast<unsigned int>(forte::core::util::strtoul(parser[SendQueueSize], 0, 10));
+    }
+    if(StatisticsInterval < noOfParameters){
+      mStatisticsInterval = forte::core::util::strtoul(parser[StatisticsInterval], 0, 10) * 1000000ULL;
+      mStatisticsTopic = std::string(mTopicName.getValue()) + "/$statistics";
+    }
+    if(0 > mQoS || 2 < mQoS || !mPipeline.init(inFlightWindow, sendQueueSize)){
+      DEVLOG_ERROR("MQTT: invalid QoS (%d), in-flight window (%u), or send queue size (%u) for topic %s\n", mQoS, inFlightWindow, sendQueueSize, mTopicName.getValue());
+      return e_InitInvalidId;
+    }
+
     if( MQTTHandler::eRegisterLayerSucceeded ==
         getExtEvHandler<MQTTHandler>().registerLayer(parser[Address], parser[ClientID], this)) {
       eRetVal = e_InitOk;
@@ -96,5 +191,8 @@ EComResponse MQTTComLayer::openConnection(char* paLayerParameter) {
 }
 
 void MQTTComLayer::closeConnection() {
+  //publishes still in flight are acknowledged to the callback context which stays with the broker connection
   getExtEvHandler<MQTTHandler>().unregisterLayer(this);
+  CCriticalRegion section(mSendLock);
+  mPipeline.clearQueue();
 }
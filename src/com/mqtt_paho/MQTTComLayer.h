@@ -8,6 +8,7 @@
  *
  * Contributors:
  * Martin Melik Merkumians - initial API and implementation and/or initial documentation
+ * agent - publish pipeline with in-flight window and statistics topic
  *******************************************************************************/
 
 
@@ -16,6 +17,10 @@
 
 #include "comlayer.h"
 #include "../../core/datatypes/forte_string.h"
+#include <forte_sync.h>
+#include <forte_architecture_time.h>
+#include <publishpipeline.h>
+#include <string>
 extern "C" {
 #include <MQTTAsync.h>
 }
@@ -23,9 +28,14 @@ extern "C" {
 #define QOS 0
 
 //raw[].mqtt[tcp://localhost:1883, ClientID, Topic]
+//optional parameters: raw[].mqtt[tcp://localhost:1883, ClientID, Topic, QoS, InFlightWindow, SendQueueSize, StatisticsInterval]
+//a StatisticsInterval in ms publishes the statistics of the publish pipeline as JSON to the topic Topic/$statistics
 
 using namespace forte::com_infra;
 
+class CMQTTBrokerConnection;
+struct SMQTTLayerContext;
+
 class MQTTComLayer: public forte::com_infra::CComLayer{
 public:
   MQTTComLayer(CComLayer* paUpperLayer, CBaseCommFB * paFB);
@@ -41,12 +51,62 @@ public:
     return mTopicName.getValue();
   }
 
+  CMQTTBrokerConnection *getBrokerConnection() const {
+    return mBrokerConnection;
+  }
+
+  void setBrokerConnection(CMQTTBrokerConnection *paBrokerConnection) {
+    mBrokerConnection = paBrokerConnection;
+  }
+
+  int getQoS() const {
+    return mQoS;
+  }
+
+  //! Context of the Paho callbacks of this layer, owned by the broker connection
+  SMQTTLayerContext *getCallbackContext() const {
+    return mCallbackContext;
+  }
+
+  void setCallbackContext(SMQTTLayerContext *paCallbackContext) {
+    mCallbackContext = paCallbackContext;
+  }
+
+  //! Metrics of the publish pipeline of this layer, latencies are in nanoseconds
+  typedef forte::core::util::CPublishPipeline::SStatistics SPublishStatistics;
+
+  SPublishStatistics getPublishStatistics();
+
+  //! Called by the handler for the acknowledgment of the oldest publish in flight, the broker connection's mutex is held
+  void publishFinished(bool paSuccess);
+
 private:
   CIEC_STRING mTopicName;
 
-  static const unsigned int mNoOfParameters = 3;
+  CMQTTBrokerConnection *mBrokerConnection;
+
+  static const unsigned int mMinNoOfParameters = 3;
+  static const unsigned int mMaxNoOfParameters = 7;
   static const unsigned int mBufferSize = 255;
 
+  static const unsigned int scmDefaultInFlightWindow = 10;
+  static const unsigned int scmDefaultSendQueueSize = 1;
+
+  bool publish(const void* paData, unsigned int paSize);
+  //! Publishes the statistics if the statistics interval has passed since the last time, mSendLock has to be held
+  void publishStatistics(uint_fast64_t paNow);
+
+  int mQoS;
+
+  SMQTTLayerContext *mCallbackContext;
+
+  CSyncObject mSendLock;
+  forte::core::util::CPublishPipeline mPipeline;
+
+  uint_fast64_t mStatisticsInterval; //!< in ns, 0 if no statistics are published
+  uint_fast64_t mLastStatistics;
+  std::string mStatisticsTopic;
+
   char mDataBuffer[mBufferSize];
   unsigned int mUsedBuffer;
   EComResponse mInterruptResp;
@@ -57,7 +117,11 @@ private:
   enum Parameters {
     Address,
     ClientID,
-    Topic
+    Topic,
+    QoS,
+    InFlightWindow,
+    SendQueueSize,
+    StatisticsInterval
   };
 
 };
@@ -8,6 +8,8 @@
  *
  * Contributors:
  * Martin Melik Merkumians - initial API and implementation and/or initial documentation
+ * agent - callback contexts outliving their layers
+ * agent - delete broker connections without layers
  *******************************************************************************/
 
 
@@ -22,69 +24,70 @@ std::string gMqttClientConfigFile;
 
 DEFINE_HANDLER(MQTTHandler);
 
-MQTTAsync_connectOptions MQTTHandler::smClientConnectionOptions =
-    MQTTAsync_connectOptions_initializer;
-
-CSyncObject MQTTHandler::smMQTTMutex;
-
-MQTTAsync MQTTHandler::smClient = 0;
-CIEC_STRING MQTTHandler::smClientId;
-CIEC_STRING MQTTHandler::smAddress;
-std::string MQTTHandler::scmUsername;
-std::string MQTTHandler::scmPassword;
-
+CMQTTBrokerConnection::CMQTTBrokerConnection(MQTTHandler &paHandler, const char *paAddress, const char *paClientId) :
+    mHandler(paHandler), mClient(0), mState(NOT_CONNECTED){
+  mClientId = paClientId;
+  mAddress = paAddress;
+  MQTTAsync_connectOptions initialOptions = MQTTAsync_connectOptions_initializer;
+  mClientConnectionOptions = initialOptions;
+}
 
-MQTTStates MQTTHandler::smMQTTS_STATE = NOT_CONNECTED;
-forte::arch::CSemaphore MQTTHandler::mStateSemaphore;
-bool MQTTHandler::mIsSemaphoreEmpty = true;
+CMQTTBrokerConnection::~CMQTTBrokerConnection(){
+  if(0 != mClient){
+    MQTTAsync_disconnectOptions disconnectOptions = MQTTAsync_disconnectOptions_initializer;
+    disconnectOptions.timeout = 10000;
+    MQTTAsync_disconnect(mClient, &disconnectOptions);
+    MQTTAsync_destroy(&mClient);
+  }
+  //no callbacks can arrive anymore
+  for(CSinglyLinkedList<SMQTTLayerContext*>::Iterator it = mLayerContexts.begin(); it != mLayerContexts.end(); ++it){
+    delete *it;
+  }
+}
 
-MQTTHandler::MQTTHandler(CDeviceExecution& paDeviceExecution) : CExternalEventHandler(paDeviceExecution)  {
+MQTTHandler::MQTTHandler(CDeviceExecution& paDeviceExecution) : CExternalEventHandler(paDeviceExecution), mIsSemaphoreEmpty(true)  {
   if(!isAlive()){
     start();
   }
 }
 
 MQTTHandler::~MQTTHandler(){
-  CCriticalRegion sectionState(smMQTTMutex);
   if(isAlive()){
     setAlive(false);
     resumeSelfSuspend();
+    end();
   }
-  if(0 != smClient){
-    MQTTAsync_disconnectOptions disconnectOptions = MQTTAsync_disconnectOptions_initializer;
-    disconnectOptions.timeout = 10000;
-    MQTTAsync_disconnect(smClient, &disconnectOptions);
-    MQTTAsync_destroy(&smClient);
+  CCriticalRegion section(mBrokersMutex);
+  for(CSinglyLinkedList<CMQTTBrokerConnection*>::Iterator it = mBrokers.begin(); it != mBrokers.end(); ++it){
+    delete *it;
   }
+  mBrokers.clearAll();
 }
 
 /*
  * START OF CALLBACKS
  */
 
+void MQTTHandler::CMessageDispatcher::operator()(MQTTComLayer *paLayer){
+  if(forte::com_infra::e_Nothing != paLayer->recvData(mPayload, mPayloadSize)){
+    mHandler.startNewEventChain(paLayer->getCommFB());
+  }
+}
+
 /** Callback for handling message reception.
  *
- * For convenience and performance it would be great to have the paContext param set subscribing topic.
- * However Paho only allows one callback per client. Therefore we have to search for the layers attached to this topic.
- * For details see discussion in Bug 545111.
+ * Paho only allows one callback per client. Therefore the subscribed layers of the broker connection are looked up
+ * in its topic trie, which also resolves the wildcards of the subscriptions. For details see discussion in Bug 545111.
  *
  */
 int MQTTHandler::onMqttMessageArrived(void* paContext, char* paTopicName, int, MQTTAsync_message* paMessage){
   //TODO: Check if handler allowed
   if(0 != paContext){
-    CCriticalRegion section(smMQTTMutex);
-
-    MQTTHandler *handler = static_cast<MQTTHandler *>(paContext);
-    void* pPayLoad = paMessage->payload;
-    unsigned int payLoadSize = static_cast<unsigned int>(paMessage->payloadlen);
+    CMQTTBrokerConnection *broker = static_cast<CMQTTBrokerConnection *>(paContext);
+    CCriticalRegion section(broker->mMutex);
 
-    for(CSinglyLinkedList<MQTTComLayer*>::Iterator it = handler->mlayers.begin(); it != handler->mlayers.end(); ++it){
-      if(0 == strcmp((*it)->getTopicName(), paTopicName)){
-        if(forte::com_infra::e_Nothing != (*it)->recvData(pPayLoad, payLoadSize)){
-          handler->startNewEventChain((*it)->getCommFB());
-        }
-      }
-    }
+    CMessageDispatcher dispatcher(broker->mHandler, paMessage->payload, static_cast<unsigned int>(paMessage->payloadlen));
+    broker->mSubscriptions.match(paTopicName, dispatcher);
     //End critical section
   }
   MQTTAsync_freeMessage(&paMessage);
@@ -96,64 +99,88 @@ int MQTTHandler::onMqttMessageArrived(void* paContext, char* paTopicName, int, M
 void MQTTHandler::onMqttConnectionLost(void* paContext, char* paCause){
   DEVLOG_ERROR("MQTT: Disconnected from broker. Cause: %s\n", paCause);
   if(0 != paContext){
-    CCriticalRegion section(smMQTTMutex);
-
-    MQTTHandler *handler = static_cast<MQTTHandler *>(paContext);
-    smMQTTS_STATE = NOT_CONNECTED;
+    CMQTTBrokerConnection *broker = static_cast<CMQTTBrokerConnection *>(paContext);
+    CCriticalRegion section(broker->mMutex);
+    broker->mState = NOT_CONNECTED;
 
-    handler->mToResubscribe.clearAll();
-    for(CSinglyLinkedList<MQTTComLayer*>::Iterator it = handler->mlayers.begin(); it != handler->mlayers.end(); ++it){
+    broker->mToResubscribe.clearAll();
+    for(CSinglyLinkedList<MQTTComLayer*>::Iterator it = broker->mLayers.begin(); it != broker->mLayers.end(); ++it){
       if(e_Subscriber == (*it)->getCommFB()->getComServiceType()){
-        handler->mToResubscribe.pushBack((*it));
+        broker->mToResubscribe.pushBack((*it));
       }
     }
-    handler->resumeSelfSuspend();
+    broker->mHandler.resumeSelfSuspend();
   }
 }
 
 void MQTTHandler::onMqttConnectionSucceed(void *paContext, MQTTAsync_successData *){
   DEVLOG_INFO("MQTT: successfully connected\n");
   {
-    MQTTHandler *handler = static_cast<MQTTHandler *>(paContext);
-    CCriticalRegion sectionState(smMQTTMutex);
-    smMQTTS_STATE = SUBSCRIBING;
-    handler->resumeSelfSuspend();
+    CMQTTBrokerConnection *broker = static_cast<CMQTTBrokerConnection *>(paContext);
+    CCriticalRegion sectionState(broker->mMutex);
+    broker->mState = SUBSCRIBING;
+    broker->mHandler.resumeSelfSuspend();
   }
 }
 
 void MQTTHandler::onMqttConnectionFailed(void *paContext, MQTTAsync_failureData *){
   DEVLOG_ERROR("MQTT connection failed.\n");
   {
-    MQTTHandler *handler = static_cast<MQTTHandler *>(paContext);
-    CCriticalRegion sectionState(smMQTTMutex);
-    smMQTTS_STATE = NOT_CONNECTED;
-    handler->resumeSelfSuspend();
+    CMQTTBrokerConnection *broker = static_cast<CMQTTBrokerConnection *>(paContext);
+    CCriticalRegion sectionState(broker->mMutex);
+    broker->mState = NOT_CONNECTED;
+    broker->mHandler.resumeSelfSuspend();
   }
 }
 
 void MQTTHandler::onSubscribeSucceed(void* paContext, MQTTAsync_successData* ){
   if(0 != paContext){
-    CCriticalRegion sectionState(smMQTTMutex);
-    MQTTComLayer* layer = static_cast<MQTTComLayer*>(paContext);
-    MQTTHandler& handler = ::getExtEvHandler<MQTTHandler>(*layer->getCommFB());
-    DEVLOG_INFO("MQTT: Subscription succeed. Topic: -%s-\n", layer->getTopicName());
-
-    handler.mToResubscribe.erase(layer);
-    if(handler.mToResubscribe.isEmpty()){
-      smMQTTS_STATE = ALL_SUBSCRIBED;
+    SMQTTLayerContext *context = static_cast<SMQTTLayerContext *>(paContext);
+    CMQTTBrokerConnection *broker = context->mBroker;
+    CCriticalRegion sectionState(broker->mMutex);
+    if(0 == context->mLayer){
+      return; //layer was closed in the meantime
+    }
+    DEVLOG_INFO("MQTT: Subscription succeed. Topic: -%s-\n", context->mLayer->getTopicName());
+
+    broker->mToResubscribe.erase(context->mLayer);
+    if(broker->mToResubscribe.isEmpty()){
+      broker->mState = ALL_SUBSCRIBED;
     }
     else{
-      handler.resumeSelfSuspend();
+      broker->mHandler.resumeSelfSuspend();
     }
   }
 }
 
 void MQTTHandler::onSubscribeFailed(void* paContext, MQTTAsync_failureData*){
   if(0 != paContext){
-    CCriticalRegion sectionState(smMQTTMutex);
-    MQTTComLayer* layer = static_cast<MQTTComLayer*>(paContext);
-    DEVLOG_ERROR("MQTT: Subscription failed. Topic: -%s-\n", layer->getTopicName());
-    ::getExtEvHandler<MQTTHandler>(*layer->getCommFB()).resumeSelfSuspend();
+    SMQTTLayerContext *context = static_cast<SMQTTLayerContext *>(paContext);
+    CMQTTBrokerConnection *broker = context->mBroker;
+    CCriticalRegion sectionState(broker->mMutex);
+    if(0 != context->mLayer){
+      DEVLOG_ERROR("MQTT: Subscription failed. Topic: -%s-\n", context->mLayer->getTopicName());
+    }
+    broker->mHandler.resumeSelfSuspend();
+  }
+}
+
+void MQTTHandler::onPublishSucceeded(void* paContext, MQTTAsync_successData*){
+  publishFinished(paContext, true);
+}
+
+void MQTTHandler::onPublishFailed(void* paContext, MQTTAsync_failureData*){
+  publishFinished(paContext, false);
+}
+
+void MQTTHandler::publishFinished(void* paContext, bool paSuccess){
+  if(0 != paContext){
+    SMQTTLayerContext *context = static_cast<SMQTTLayerContext *>(paContext);
+    //holding the mutex keeps the layer from being unregistered and deleted meanwhile
+    CCriticalRegion section(context->mBroker->mMutex);
+    if(0 != context->mLayer){
+      context->mLayer->publishFinished(paSuccess);
+    }
   }
 }
 
@@ -161,9 +188,9 @@ void MQTTHandler::onSubscribeFailed(void* paContext, MQTTAsync_failureData*){
  * END OF CALLBACKS AND START OF HELPER FUNCTIONS
  */
 
-int MQTTHandler::mqttConnect(){
-  DEVLOG_INFO("MQTT: Requesting connection to broker\n");
-  int rc = MQTTAsync_connect(smClient, &smClientConnectionOptions);
+int MQTTHandler::mqttConnect(CMQTTBrokerConnection &paBroker){
+  DEVLOG_INFO("MQTT: Requesting connection to broker %s\n", paBroker.mAddress.getValue());
+  int rc = MQTTAsync_connect(paBroker.mClient, &paBroker.mClientConnectionOptions);
   if(MQTTASYNC_SUCCESS != rc){
     DEVLOG_ERROR("MQTT: Request to mqtt library failed\n");
   }else{
@@ -172,15 +199,14 @@ int MQTTHandler::mqttConnect(){
   return rc;
 }
 
-int MQTTHandler::mqttSubscribe(const MQTTComLayer* paLayer){
-  DEVLOG_INFO("MQTT: subscribing to topic -%s-\n", paLayer->getTopicName());
+int MQTTHandler::mqttSubscribe(CMQTTBrokerConnection &paBroker, SMQTTLayerContext *paContext, const char *paTopicName, int paQoS){
+  DEVLOG_INFO("MQTT: subscribing to topic -%s-\n", paTopicName);
   MQTTAsync_responseOptions opts = MQTTAsync_responseOptions_initializer;
   opts.onSuccess = onSubscribeSucceed;
   opts.onFailure = onSubscribeFailed;
-  opts.context = (void*)paLayer;
-  int rc = MQTTAsync_subscribe(smClient, paLayer->getTopicName(), QOS, &opts);
+  opts.context = paContext;
+  int rc = MQTTAsync_subscribe(paBroker.mClient, paTopicName, paQoS, &opts);
   if(MQTTASYNC_SUCCESS != rc){ //call failed
-    CCriticalRegion sectionState(smMQTTMutex);
     DEVLOG_INFO("MQTT: subscribe request failed with val = %d\n", rc);
     resumeSelfSuspend();
   }else{
@@ -189,52 +215,84 @@ int MQTTHandler::mqttSubscribe(const MQTTComLayer* paLayer){
   return rc;
 }
 
-int MQTTHandler::registerLayer(const char* paAddress, const char* paClientId, MQTTComLayer* paLayer){
-  if(smClient == 0){
-    smClientId = paClientId;
-    smAddress = paAddress;
-    MQTTAsync_create(&smClient, smAddress.getValue(), smClientId.getValue(), MQTTCLIENT_PERSISTENCE_NONE, NULL);
-    smClientConnectionOptions.keepAliveInterval = 20;
-    smClientConnectionOptions.cleansession = 1;
-    smClientConnectionOptions.onSuccess = onMqttConnectionSucceed;
-    smClientConnectionOptions.onFailure = onMqttConnectionFailed;
-    smClientConnectionOptions.context = this;
-
-    if("" != gMqttClientConfigFile) { //file was provided
-
-      CMQTTClientConfigFileParser::MQTTConfigFromFile result = CMQTTClientConfigFileParser::MQTTConfigFromFile(scmUsername, scmPassword);
-      std::string endpoint = smAddress.getValue();
-
-      if(CMQTTClientConfigFileParser::loadConfig(gMqttClientConfigFile, endpoint, result)) {
-        smClientConnectionOptions.username = scmUsername.c_str();
-        smClientConnectionOptions.password = scmPassword.c_str();
-      } else {
-        return eWrongClientID;
-      }
+CMQTTBrokerConnection *MQTTHandler::getBrokerConnection(const char* paAddress, const char* paClientId, int &paResult){
+  for(CSinglyLinkedList<CMQTTBrokerConnection*>::Iterator it = mBrokers.begin(); it != mBrokers.end(); ++it){
+    if((*it)->isSameBroker(paAddress, paClientId)){
+      paResult = eRegisterLayerSucceeded;
+      return *it;
     }
+  }
 
-    if(MQTTASYNC_SUCCESS != MQTTAsync_setCallbacks(smClient, this, MQTTHandler::onMqttConnectionLost, onMqttMessageArrived, NULL)){
-      return eConnectionFailed;
+  CMQTTBrokerConnection *broker = new CMQTTBrokerConnection(*this, paAddress, paClientId);
+  paResult = initBrokerConnection(*broker);
+  if(eRegisterLayerSucceeded != paResult){
+    delete broker;
+    return 0;
+  }
+  mBrokers.pushBack(broker);
+  return broker;
+}
+
+int MQTTHandler::initBrokerConnection(CMQTTBrokerConnection &paBroker){
+  if(MQTTASYNC_SUCCESS != MQTTAsync_create(&paBroker.mClient, paBroker.mAddress.getValue(), paBroker.mClientId.getValue(), MQTTCLIENT_PERSISTENCE_NONE, NULL)){
+    paBroker.mClient = 0;
+    return eWrongClientID;
+  }
+  paBroker.mClientConnectionOptions.keepAliveInterval = 20;
+  paBroker.mClientConnectionOptions.cleansession = 1;
+  paBroker.mClientConnectionOptions.onSuccess = onMqttConnectionSucceed;
+  paBroker.mClientConnectionOptions.onFailure = onMqttConnectionFailed;
+  paBroker.mClientConnectionOptions.context = &paBroker;
+
+  if("" != gMqttClientConfigFile) { //file was provided
+
+    CMQTTClientConfigFileParser::MQTTConfigFromFile result = CMQTTClientConfigFileParser::MQTTConfigFromFile(paBroker.mUsername, paBroker.mPassword);
+    std::string endpoint = paBroker.mAddress.getValue();
+
+    if(CMQTTClientConfigFileParser::loadConfig(gMqttClientConfigFile, endpoint, result)) {
+      paBroker.mClientConnectionOptions.username = paBroker.mUsername.c_str();
+      paBroker.mClientConnectionOptions.password = paBroker.mPassword.c_str();
+    } else {
+      return eWrongClientID;
     }
-    {
-      CCriticalRegion sectionState(smMQTTMutex);
-      if(MQTTASYNC_SUCCESS != mqttConnect()){
-        return eConnectionFailed;
-      }
-      smMQTTS_STATE = CONNECTION_ASKED;
+  }
+
+  if(MQTTASYNC_SUCCESS != MQTTAsync_setCallbacks(paBroker.mClient, &paBroker, MQTTHandler::onMqttConnectionLost, onMqttMessageArrived, NULL)){
+    return eConnectionFailed;
+  }
+  {
+    CCriticalRegion sectionState(paBroker.mMutex);
+    if(MQTTASYNC_SUCCESS != mqttConnect(paBroker)){
+      return eConnectionFailed;
     }
+    paBroker.mState = CONNECTION_ASKED;
   }
-  else if((smClientId != paClientId) || (smAddress != paAddress)){
-    return eWrongClientID;
+  return eRegisterLayerSucceeded;
+}
+
+int MQTTHandler::registerLayer(const char* paAddress, const char* paClientId, MQTTComLayer* paLayer){
+  int retVal;
+  //held until the layer is registered, so that the broker connection can not lose its last layer meanwhile
+  CCriticalRegion brokersSection(mBrokersMutex);
+  CMQTTBrokerConnection *broker = getBrokerConnection(paAddress, paClientId, retVal);
+  if(0 == broker){
+    return retVal;
   }
   {
-    CCriticalRegion section(smMQTTMutex);
-    mlayers.pushBack(paLayer);
+    CCriticalRegion section(broker->mMutex);
+    SMQTTLayerContext *context = new SMQTTLayerContext;
+    context->mBroker = broker;
+    context->mLayer = paLayer;
+    broker->mLayerContexts.pushBack(context);
+    paLayer->setCallbackContext(context);
+    paLayer->setBrokerConnection(broker);
+    broker->mLayers.pushBack(paLayer);
     if (e_Subscriber == paLayer->getCommFB()->getComServiceType()){
-      mToResubscribe.pushBack(paLayer);
-      if(ALL_SUBSCRIBED == smMQTTS_STATE){
-        smMQTTS_STATE = SUBSCRIBING;
-        this->resumeSelfSuspend();
+      broker->mSubscriptions.insert(paLayer->getTopicName(), paLayer);
+      broker->mToResubscribe.pushBack(paLayer);
+      if(ALL_SUBSCRIBED == broker->mState){
+        broker->mState = SUBSCRIBING;
+        resumeSelfSuspend();
       }
     }
 
@@ -243,8 +301,26 @@ int MQTTHandler::registerLayer(const char* paAddress, const char* paClientId, MQ
 }
 
 void MQTTHandler::unregisterLayer(MQTTComLayer* paLayer){
-  CCriticalRegion section(smMQTTMutex);
-  mlayers.erase(paLayer);
+  CCriticalRegion brokersSection(mBrokersMutex);
+  CMQTTBrokerConnection *broker = paLayer->getBrokerConnection();
+  if(0 != broker){
+    bool unused;
+    {
+      CCriticalRegion section(broker->mMutex);
+      broker->mLayers.erase(paLayer);
+      broker->mToResubscribe.erase(paLayer);
+      broker->mSubscriptions.remove(paLayer->getTopicName(), paLayer);
+      paLayer->getCallbackContext()->mLayer = 0;
+      paLayer->setCallbackContext(0);
+      paLayer->setBrokerConnection(0);
+      unused = broker->mLayers.isEmpty();
+    }
+    if(unused){
+      //nobody uses the connection anymore, deleting it disconnects and destroys its Paho client
+      mBrokers.erase(broker);
+      delete broker;
+    }
+  }
 }
 
 void MQTTHandler::enableHandler(void){
@@ -277,30 +353,9 @@ void MQTTHandler::run(){
       break;
     }
     {
-      CCriticalRegion sectionState(smMQTTMutex);
-      switch(smMQTTS_STATE){
-        case NOT_CONNECTED:
-          if (MQTTASYNC_SUCCESS == mqttConnect()){
-             smMQTTS_STATE = CONNECTION_ASKED;
-          }
-          break;
-        case SUBSCRIBING:{
-          if(!mToResubscribe.isEmpty()){
-            //only try subscribe one at a time. There were some problems in some cases when subscribing one after the other, because the MQTTAsync_subscribe hangs.
-            const MQTTComLayer *layer = *mToResubscribe.begin();
-            smMQTTMutex.unlock();
-            if(MQTTASYNC_SUCCESS != mqttSubscribe(layer)){
-              needSleep = true;
-            }
-            smMQTTMutex.lock();
-          }
-          else{
-            smMQTTS_STATE = ALL_SUBSCRIBED;
-          }
-          break;
-        }
-        default:
-          break;
+      CCriticalRegion section(mBrokersMutex);
+      for(CSinglyLinkedList<CMQTTBrokerConnection*>::Iterator it = mBrokers.begin(); it != mBrokers.end(); ++it){
+        handleBrokerState(**it, needSleep);
       }
     }
     if(needSleep){
@@ -311,7 +366,40 @@ void MQTTHandler::run(){
   }
 }
 
+void MQTTHandler::handleBrokerState(CMQTTBrokerConnection &paBroker, bool &paNeedSleep){
+  CCriticalRegion sectionState(paBroker.mMutex);
+  switch(paBroker.mState){
+    case NOT_CONNECTED:
+      if (MQTTASYNC_SUCCESS == mqttConnect(paBroker)){
+         paBroker.mState = CONNECTION_ASKED;
+      }
+      break;
+    case SUBSCRIBING:{
+      if(!paBroker.mToResubscribe.isEmpty()){
+        //only try subscribe one at a time. There were some problems in some cases when subscribing one after the other, because the MQTTAsync_subscribe hangs.
+        //the layer may be closed while the mutex is released, so everything needed for the subscription is copied
+        const MQTTComLayer *layer = *paBroker.mToResubscribe.begin();
+        SMQTTLayerContext *context = layer->getCallbackContext();
+        std::string topicName(layer->getTopicName());
+        int qos = layer->getQoS();
+        paBroker.mMutex.unlock();
+        if(MQTTASYNC_SUCCESS != mqttSubscribe(paBroker, context, topicName.c_str(), qos)){
+          paNeedSleep = true;
+        }
+        paBroker.mMutex.lock();
+      }
+      else{
+        paBroker.mState = ALL_SUBSCRIBED;
+      }
+      break;
+    }
+    default:
+      break;
+  }
+}
+
 void MQTTHandler::resumeSelfSuspend(){
+  CCriticalRegion section(mSuspendMutex);
   if(mIsSemaphoreEmpty){ //avoid incrementing many times
     mStateSemaphore.inc();
     mIsSemaphoreEmpty = false;
@@ -321,7 +409,7 @@ void MQTTHandler::resumeSelfSuspend(){
 void MQTTHandler::selfSuspend(){
   mStateSemaphore.waitIndefinitely();
   {
-    CCriticalRegion section(smMQTTMutex);
+    CCriticalRegion section(mSuspendMutex);
     mIsSemaphoreEmpty = true;
   }
 }
@@ -8,6 +8,7 @@
  *
  * Contributors:
  * Martin Melik Merkumians - initial API and implementation and/or initial documentation
+ * agent - callback contexts outliving their layers
  *******************************************************************************/
 
 
@@ -17,11 +18,13 @@
 #include <extevhan.h>
 #include <fortelist.h>
 #include <MQTTComLayer.h>
+#include <topictrie.h>
 #include <forte_sync.h>
 #include <forte_string.h>
 #include <forte_thread.h>
 #include <forte_sem.h>
 #include <string>
+#include <string.h>
 
 extern "C" {
 #include <MQTTAsync.h>
@@ -34,6 +37,68 @@ enum MQTTStates {
   ALL_SUBSCRIBED,
 };
 
+class MQTTHandler;
+
+/*!\brief Context of the Paho callbacks of a layer
+ *
+ * Paho may call back after a layer has been closed and deleted, e.g., for publishes still in flight. The context is
+ * therefore owned by the broker connection and lives as long as its Paho client, the callbacks only reach the layer
+ * while it is registered.
+ */
+struct SMQTTLayerContext {
+    CMQTTBrokerConnection *mBroker;
+    MQTTComLayer *mLayer; //!< 0 after the layer has been unregistered, guarded by the mutex of the broker connection
+};
+
+/*!\brief The connection to one broker identified by its address and client id
+ *
+ * Each broker connection has its own Paho client, and therefore its own callback thread, and its own lock. Incoming
+ * messages are dispatched through a topic trie so that the costs of a message do not depend on the number of
+ * subscribed topics.
+ */
+class CMQTTBrokerConnection {
+  public:
+    CMQTTBrokerConnection(MQTTHandler &paHandler, const char *paAddress, const char *paClientId);
+    ~CMQTTBrokerConnection();
+
+    MQTTAsync& getClient(void) {
+      return mClient;
+    }
+
+    bool isSameBroker(const char *paAddress, const char *paClientId) const {
+      return (0 == strcmp(mAddress.getValue(), paAddress)) && (0 == strcmp(mClientId.getValue(), paClientId));
+    }
+
+  private:
+    friend class MQTTHandler;
+
+    MQTTHandler &mHandler;
+
+    CIEC_STRING mClientId;
+    CIEC_STRING mAddress;
+    std::string mUsername;
+    std::string mPassword;
+
+    CSyncObject mMutex;
+
+    MQTTAsync mClient;
+    MQTTAsync_connectOptions mClientConnectionOptions;
+
+    MQTTStates mState;
+
+    CSinglyLinkedList<MQTTComLayer*> mLayers;
+
+    CSinglyLinkedList<MQTTComLayer*> mToResubscribe;
+
+    forte::core::util::CTopicTrie<MQTTComLayer> mSubscriptions;
+
+    //! contexts of all layers registered so far, a context is not reused as Paho may still call back for its old layer
+    CSinglyLinkedList<SMQTTLayerContext*> mLayerContexts;
+
+    CMQTTBrokerConnection(const CMQTTBrokerConnection&);
+    CMQTTBrokerConnection& operator=(const CMQTTBrokerConnection&);
+};
+
 class MQTTHandler : public CExternalEventHandler, public CThread {
     DECLARE_HANDLER(MQTTHandler)
 public:
@@ -44,11 +109,15 @@ public:
   };
   int registerLayer(const char* paAddress, const char* paClientId, MQTTComLayer* paLayer);
 
+  //! Removes the layer from its broker connection, the broker connection is deleted with its last layer
   void unregisterLayer(MQTTComLayer* paLayer);
 
-  MQTTAsync& getClient(void) {
-    return smClient;
-  }
+  /*!\brief Paho callbacks for publishes, the context has to be the callback context of the publishing layer
+   *
+   * The acknowledgment is passed on to the layer only if it is still registered.
+   */
+  static void onPublishSucceeded(void* paContext, MQTTAsync_successData* paResponse);
+  static void onPublishFailed(void* paContext, MQTTAsync_failureData* paResponse);
 
   //void mqttMessageProcessed(void);
 
@@ -71,9 +140,29 @@ protected:
     virtual void run();
 
 private:
+    //! Functor handing a received message to all layers subscribed to the message's topic
+    class CMessageDispatcher {
+      public:
+        CMessageDispatcher(MQTTHandler &paHandler, const void *paPayload, unsigned int paPayloadSize) :
+            mHandler(paHandler), mPayload(paPayload), mPayloadSize(paPayloadSize) {
+        }
 
-    int mqttSubscribe(const MQTTComLayer* paLayer);
-    int mqttConnect();
+        void operator()(MQTTComLayer *paLayer);
+
+      private:
+        MQTTHandler &mHandler;
+        const void *mPayload;
+        unsigned int mPayloadSize;
+    };
+
+    //! Looks up or creates the broker connection, has to be called with mBrokersMutex held
+    CMQTTBrokerConnection *getBrokerConnection(const char* paAddress, const char* paClientId, int &paResult);
+    int initBrokerConnection(CMQTTBrokerConnection &paBroker);
+
+    void handleBrokerState(CMQTTBrokerConnection &paBroker, bool &paNeedSleep);
+
+    int mqttSubscribe(CMQTTBrokerConnection &paBroker, SMQTTLayerContext *paContext, const char *paTopicName, int paQoS);
+    int mqttConnect(CMQTTBrokerConnection &paBroker);
 
     void resumeSelfSuspend();
     void selfSuspend();
@@ -88,25 +177,18 @@ private:
     static void onSubscribeSucceed(void* paContext, MQTTAsync_successData* paResponse);
     static void onSubscribeFailed(void* paContext, MQTTAsync_failureData* paResponse);
 
-    static CIEC_STRING smClientId;
-    static CIEC_STRING smAddress;
-    static std::string scmUsername;
-    static std::string scmPassword;
+    static void publishFinished(void* paContext, bool paSuccess);
 
-    static CSyncObject smMQTTMutex;
+    //! protects the list of broker connections, a broker connection's own data is protected by its mutex
+    CSyncObject mBrokersMutex;
 
-    static MQTTAsync smClient;
-    static MQTTAsync_connectOptions smClientConnectionOptions;
-
-    CSinglyLinkedList<MQTTComLayer*> mlayers;
-
-    CSinglyLinkedList<MQTTComLayer*> mToResubscribe;
+    CSinglyLinkedList<CMQTTBrokerConnection*> mBrokers;
 
-    static forte::arch::CSemaphore mStateSemaphore;
+    CSyncObject mSuspendMutex;
 
-    static bool mIsSemaphoreEmpty;
+    forte::arch::CSemaphore mStateSemaphore;
 
-    static MQTTStates smMQTTS_STATE;
+    bool mIsSemaphoreEmpty;
 
 };
 
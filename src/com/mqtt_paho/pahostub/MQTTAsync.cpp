@@ -0,0 +1,437 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ * agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+
+#include "MQTTAsync.h"
+#include <forte_thread.h>
+#include <forte_sync.h>
+#include <forte_sem.h>
+#include <forte_atomic.h>
+#include <forte_architecture_time.h>
+#include <fortelist.h>
+#include <criticalregion.h>
+#include <deque>
+#include <set>
+#include <string>
+#include <vector>
+#include <stdlib.h>
+#include <string.h>
+
+namespace {
+
+  //! Checks an MQTT topic filter with the wildcards + and # against a topic name
+  bool filterMatches(const char *paFilter, const char *paTopic) {
+    while('\0' != *paFilter) {
+      if('#' == *paFilter) {
+        return true;
+      }
+      if('+' == *paFilter) {
+        while('\0' != *paTopic && '/' != *paTopic) {
+          ++paTopic;
+        }
+        ++paFilter;
+        continue;
+      }
+      if(*paFilter != *paTopic) {
+        //a/# also matches a
+        return ('\0' == *paTopic) && (0 == strcmp(paFilter, "/#"));
+      }
+      ++paFilter;
+      ++paTopic;
+    }
+    return '\0' == *paTopic;
+  }
+
+  //! A callback requested from a client, executed in the client's callback thread
+  struct SJob {
+      enum EType {
+        eSuccess,
+        eFailure,
+        eMessage
+      };
+
+      EType mType;
+      MQTTAsync_onSuccess *mOnSuccess;
+      MQTTAsync_onFailure *mOnFailure;
+      void *mContext;
+      MQTTAsync_token mToken;
+      char *mTopic;
+      MQTTAsync_message *mMessage;
+  };
+
+  class CStubClient;
+
+  /*!\brief The in-process broker all stub clients are connected to
+   *
+   * Clients keep their subscriptions and connection state under the broker's lock, so that a publish sees a consistent
+   * set of receivers.
+   */
+  class CStubBroker {
+    public:
+      static CStubBroker &getInstance() {
+        static CStubBroker broker;
+        return broker;
+      }
+
+      CSyncObject &getSync() {
+        return mSync;
+      }
+
+      void addClient(CStubClient *paClient) {
+        CCriticalRegion section(mSync);
+        mClients.pushBack(paClient);
+      }
+
+      void removeClient(CStubClient *paClient) {
+        CCriticalRegion section(mSync);
+        mClients.erase(paClient);
+      }
+
+      //! Hands a copy of the message to every connected client with a matching subscription
+      void publish(const char *paTopic, const MQTTAsync_message &paMessage);
+
+      unsigned int getNrOfSubscriptions();
+
+      void jobQueued() {
+        mPendingJobs.fetchAdd(1);
+      }
+
+      void jobDone() {
+        mPendingJobs.fetchAdd(static_cast<TForteUInt32>(-1));
+      }
+
+      bool isIdle() const {
+        return 0 == mPendingJobs.load();
+      }
+
+    private:
+      CStubBroker() :
+          mPendingJobs(0) {
+      }
+
+      CSyncObject mSync;
+      CSinglyLinkedList<CStubClient*> mClients;
+      forte::arch::CAtomicUInt32 mPendingJobs;
+  };
+
+  /*!\brief A stub client with its own callback thread like a Paho client
+   *
+   * Subscriptions without wildcards are looked up in a set, so that the broker does not limit the throughput of
+   * clients with many subscriptions.
+   */
+  class CStubClient : public CThread {
+    public:
+      CStubClient() :
+          mConnected(false), mCallbackContext(0), mConnectionLost(0), mMessageArrived(0), mNextToken(1) {
+      }
+
+      virtual ~CStubClient() {
+        //callbacks not yet executed are dropped as with Paho
+        for(std::deque<SJob>::iterator it = mJobs.begin(); it != mJobs.end(); ++it) {
+          if(SJob::eMessage == it->mType) {
+            MQTTAsync_freeMessage(&it->mMessage);
+            MQTTAsync_free(it->mTopic);
+          }
+          CStubBroker::getInstance().jobDone();
+        }
+      }
+
+      void stop() {
+        if(isAlive()) {
+          setAlive(false);
+          mJobsAvailable.inc();
+          end();
+        }
+      }
+
+      void setCallbacks(void *paContext, MQTTAsync_connectionLost *paConnectionLost, MQTTAsync_messageArrived *paMessageArrived) {
+        mCallbackContext = paContext;
+        mConnectionLost = paConnectionLost;
+        mMessageArrived = paMessageArrived;
+      }
+
+      //! The connection state and the subscriptions may only be accessed with the broker's lock held
+      bool mConnected;
+      std::set<std::string> mTopics;
+      std::vector<std::string> mFilters;
+
+      bool isSubscribed(const char *paTopic) const {
+        if(mTopics.end() != mTopics.find(paTopic)) {
+          return true;
+        }
+        for(std::vector<std::string>::const_iterator it = mFilters.begin(); it != mFilters.end(); ++it) {
+          if(filterMatches(it->c_str(), paTopic)) {
+            return true;
+          }
+        }
+        return false;
+      }
+
+      void subscribe(const char *paTopicFilter) {
+        if(0 != strpbrk(paTopicFilter, "+#")) {
+          mFilters.push_back(paTopicFilter);
+        } else {
+          mTopics.insert(paTopicFilter);
+        }
+      }
+
+      //! Requests the success or failure callback of the response options, returns the token of the request
+      MQTTAsync_token respond(const MQTTAsync_responseOptions *paResponse, bool paSuccess) {
+        return (0 != paResponse) ? respond(paResponse->onSuccess, paResponse->onFailure, paResponse->context, paSuccess) : respond(0, 0, 0, paSuccess);
+      }
+
+      MQTTAsync_token respond(MQTTAsync_onSuccess *paOnSuccess, MQTTAsync_onFailure *paOnFailure, void *paContext, bool paSuccess) {
+        SJob job = { paSuccess ? SJob::eSuccess : SJob::eFailure, paOnSuccess, paOnFailure, paContext, 0, 0, 0 };
+        CCriticalRegion section(mJobsSync);
+        job.mToken = mNextToken++;
+        if((paSuccess && 0 != paOnSuccess) || (!paSuccess && 0 != paOnFailure)) {
+          queue(job);
+        }
+        return job.mToken;
+      }
+
+      void deliver(char *paTopic, MQTTAsync_message *paMessage) {
+        SJob job = { SJob::eMessage, 0, 0, 0, 0, paTopic, paMessage };
+        CCriticalRegion section(mJobsSync);
+        queue(job);
+      }
+
+    protected:
+      virtual void run() {
+        while(isAlive()) {
+          mJobsAvailable.waitIndefinitely();
+          SJob job;
+          while(isAlive() && takeJob(job)) {
+            execute(job);
+          }
+        }
+      }
+
+    private:
+      //! Has to be called with mJobsSync held
+      void queue(const SJob &paJob) {
+        CStubBroker::getInstance().jobQueued();
+        mJobs.push_back(paJob);
+        mJobsAvailable.inc();
+      }
+
+      bool takeJob(SJob &paJob) {
+        CCriticalRegion section(mJobsSync);
+        if(mJobs.empty()) {
+          return false;
+        }
+        paJob = mJobs.front();
+        mJobs.pop_front();
+        return true;
+      }
+
+      void execute(SJob &paJob) {
+        switch(paJob.mType){
+          case SJob::eSuccess: {
+            MQTTAsync_successData data = { paJob.mToken };
+            paJob.mOnSuccess(paJob.mContext, &data);
+            break;
+          }
+          case SJob::eFailure: {
+            MQTTAsync_failureData data = { paJob.mToken, MQTTASYNC_FAILURE, 0 };
+            paJob.mOnFailure(paJob.mContext, &data);
+            break;
+          }
+          case SJob::eMessage:
+            if(0 == mMessageArrived) {
+              MQTTAsync_freeMessage(&paJob.mMessage);
+              MQTTAsync_free(paJob.mTopic);
+            } else if(!mMessageArrived(mCallbackContext, paJob.mTopic, 0, paJob.mMessage)) {
+              //the application could not take the message, Paho delivers it again later
+              CThread::sleepThread(1);
+              CCriticalRegion section(mJobsSync);
+              mJobs.push_back(paJob);
+              return;
+            }
+            break;
+        }
+        CStubBroker::getInstance().jobDone();
+      }
+
+      void *mCallbackContext;
+      MQTTAsync_connectionLost *mConnectionLost;
+      MQTTAsync_messageArrived *mMessageArrived;
+
+      CSyncObject mJobsSync;
+      std::deque<SJob> mJobs;
+      forte::arch::CSemaphore mJobsAvailable;
+      MQTTAsync_token mNextToken;
+  };
+
+  void CStubBroker::publish(const char *paTopic, const MQTTAsync_message &paMessage) {
+    CCriticalRegion section(mSync);
+    for(CSinglyLinkedList<CStubClient*>::Iterator it = mClients.begin(); it != mClients.end(); ++it) {
+      if((*it)->mConnected && (*it)->isSubscribed(paTopic)) {
+        MQTTAsync_message *message = static_cast<MQTTAsync_message*>(malloc(sizeof(MQTTAsync_message)));
+        *message = paMessage;
+        message->payload = malloc((0 < paMessage.payloadlen) ? static_cast<size_t>(paMessage.payloadlen) : 1);
+        if(0 < paMessage.payloadlen) {
+          memcpy(message->payload, paMessage.payload, static_cast<size_t>(paMessage.payloadlen));
+        }
+        size_t topicSize = strlen(paTopic) + 1;
+        char *topic = static_cast<char*>(malloc(topicSize));
+        memcpy(topic, paTopic, topicSize);
+        (*it)->deliver(topic, message);
+      }
+    }
+  }
+
+  unsigned int CStubBroker::getNrOfSubscriptions() {
+    CCriticalRegion section(mSync);
+    size_t nrOfSubscriptions = 0;
+    for(CSinglyLinkedList<CStubClient*>::Iterator it = mClients.begin(); it != mClients.end(); ++it) {
+      if((*it)->mConnected) {
+        nrOfSubscriptions += (*it)->mTopics.size() + (*it)->mFilters.size();
+      }
+    }
+    return static_cast<unsigned int>(nrOfSubscriptions);
+  }
+
+  CStubClient *getClient(MQTTAsync paHandle) {
+    return static_cast<CStubClient*>(paHandle);
+  }
+}
+
+int MQTTAsync_create(MQTTAsync *handle, const char *serverURI, const char *clientId, int, void*) {
+  if(0 == handle || 0 == serverURI || 0 == clientId) {
+    return MQTTASYNC_NULL_PARAMETER;
+  }
+  CStubClient *client = new CStubClient();
+  client->start();
+  CStubBroker::getInstance().addClient(client);
+  *handle = client;
+  return MQTTASYNC_SUCCESS;
+}
+
+int MQTTAsync_setCallbacks(MQTTAsync handle, void *context, MQTTAsync_connectionLost *cl, MQTTAsync_messageArrived *ma, MQTTAsync_deliveryComplete*) {
+  if(0 == handle) {
+    return MQTTASYNC_FAILURE;
+  }
+  getClient(handle)->setCallbacks(context, cl, ma);
+  return MQTTASYNC_SUCCESS;
+}
+
+int MQTTAsync_connect(MQTTAsync handle, const MQTTAsync_connectOptions *options) {
+  if(0 == handle || 0 == options) {
+    return MQTTASYNC_NULL_PARAMETER;
+  }
+  CStubClient *client = getClient(handle);
+  {
+    CCriticalRegion section(CStubBroker::getInstance().getSync());
+    client->mConnected = true;
+  }
+  client->respond(options->onSuccess, options->onFailure, options->context, true);
+  return MQTTASYNC_SUCCESS;
+}
+
+int MQTTAsync_disconnect(MQTTAsync handle, const MQTTAsync_disconnectOptions *options) {
+  if(0 == handle) {
+    return MQTTASYNC_FAILURE;
+  }
+  CStubClient *client = getClient(handle);
+  {
+    CCriticalRegion section(CStubBroker::getInstance().getSync());
+    if(!client->mConnected) {
+      return MQTTASYNC_DISCONNECTED;
+    }
+    //the stub only has clean sessions
+    client->mConnected = false;
+    client->mTopics.clear();
+    client->mFilters.clear();
+  }
+  if(0 != options) {
+    client->respond(options->onSuccess, options->onFailure, options->context, true);
+  }
+  return MQTTASYNC_SUCCESS;
+}
+
+int MQTTAsync_subscribe(MQTTAsync handle, const char *topic, int, MQTTAsync_responseOptions *response) {
+  if(0 == handle || 0 == topic) {
+    return MQTTASYNC_NULL_PARAMETER;
+  }
+  CStubClient *client = getClient(handle);
+  {
+    CCriticalRegion section(CStubBroker::getInstance().getSync());
+    if(!client->mConnected) {
+      return MQTTASYNC_DISCONNECTED;
+    }
+    client->subscribe(topic);
+  }
+  MQTTAsync_token token = client->respond(response, true);
+  if(0 != response) {
+    response->token = token;
+  }
+  return MQTTASYNC_SUCCESS;
+}
+
+int MQTTAsync_sendMessage(MQTTAsync handle, const char *destinationName, const MQTTAsync_message *msg, MQTTAsync_responseOptions *response) {
+  if(0 == handle || 0 == destinationName || 0 == msg) {
+    return MQTTASYNC_NULL_PARAMETER;
+  }
+  if(0 != strpbrk(destinationName, "+#")) {
+    return MQTTASYNC_BAD_UTF8_STRING;
+  }
+  CStubClient *client = getClient(handle);
+  {
+    CCriticalRegion section(CStubBroker::getInstance().getSync());
+    if(!client->mConnected) {
+      return MQTTASYNC_DISCONNECTED;
+    }
+  }
+  CStubBroker::getInstance().publish(destinationName, *msg);
+  MQTTAsync_token token = client->respond(response, true);
+  if(0 != response) {
+    response->token = token;
+  }
+  return MQTTASYNC_SUCCESS;
+}
+
+void MQTTAsync_destroy(MQTTAsync *handle) {
+  if(0 != handle && 0 != *handle) {
+    CStubClient *client = getClient(*handle);
+    CStubBroker::getInstance().removeClient(client);
+    client->stop();
+    delete client;
+    *handle = 0;
+  }
+}
+
+void MQTTAsync_freeMessage(MQTTAsync_message **msg) {
+  if(0 != msg && 0 != *msg) {
+    free((*msg)->payload);
+    free(*msg);
+    *msg = 0;
+  }
+}
+
+void MQTTAsync_free(void *ptr) {
+  free(ptr);
+}
+
+int MQTTAsyncStub_waitUntilIdle(unsigned int paTimeoutMs) {
+  uint_fast64_t deadline = getNanoSecondsMonotonic() + paTimeoutMs * 1000000ULL;
+  while(!CStubBroker::getInstance().isIdle()) {
+    if(getNanoSecondsMonotonic() > deadline) {
+      return MQTTASYNC_FAILURE;
+    }
+    CThread::sleepThread(1);
+  }
+  return MQTTASYNC_SUCCESS;
+}
+
+unsigned int MQTTAsyncStub_getNrOfSubscriptions(void) {
+  return CStubBroker::getInstance().getNrOfSubscriptions();
+}
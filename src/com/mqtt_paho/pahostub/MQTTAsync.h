@@ -0,0 +1,140 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ * agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+
+/*!\file
+ * \brief In-process stand-in for the asynchronous Paho MQTT C client
+ *
+ * Only the part of the MQTTAsync API used by the MQTT com layer is provided. All clients of the process are connected
+ * to one in-process broker, so that the MQTT handler can be tested without the Paho library and without a broker.
+ * As with Paho every client calls back from its own thread.
+ *
+ * The broker delivers every message at most once to a client, no matter how many of its subscriptions match. QoS,
+ * retained messages, and persistence are not supported, connections are never lost.
+ */
+
+#ifndef MQTTASYNC_STUB_H_
+#define MQTTASYNC_STUB_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void* MQTTAsync;
+typedef int MQTTAsync_token;
+
+#define MQTTASYNC_SUCCESS 0
+#define MQTTASYNC_FAILURE -1
+#define MQTTASYNC_DISCONNECTED -3
+#define MQTTASYNC_BAD_UTF8_STRING -5
+#define MQTTASYNC_NULL_PARAMETER -6
+
+#define MQTTCLIENT_PERSISTENCE_NONE 1
+
+typedef struct {
+    char struct_id[4];
+    int struct_version;
+    int payloadlen;
+    void *payload;
+    int qos;
+    int retained;
+    int dup;
+    int msgid;
+} MQTTAsync_message;
+
+#define MQTTAsync_message_initializer { {'M', 'Q', 'T', 'M'}, 0, 0, NULL, 0, 0, 0, 0 }
+
+typedef struct {
+    MQTTAsync_token token;
+} MQTTAsync_successData;
+
+typedef struct {
+    MQTTAsync_token token;
+    int code;
+    const char *message;
+} MQTTAsync_failureData;
+
+typedef void MQTTAsync_onSuccess(void *context, MQTTAsync_successData *response);
+typedef void MQTTAsync_onFailure(void *context, MQTTAsync_failureData *response);
+
+typedef int MQTTAsync_messageArrived(void *context, char *topicName, int topicLen, MQTTAsync_message *message);
+typedef void MQTTAsync_deliveryComplete(void *context, MQTTAsync_token token);
+typedef void MQTTAsync_connectionLost(void *context, char *cause);
+
+typedef struct {
+    char struct_id[4];
+    int struct_version;
+    MQTTAsync_onSuccess *onSuccess;
+    MQTTAsync_onFailure *onFailure;
+    void *context;
+    MQTTAsync_token token;
+} MQTTAsync_responseOptions;
+
+#define MQTTAsync_responseOptions_initializer { {'M', 'Q', 'T', 'R'}, 0, NULL, NULL, 0, 0 }
+
+typedef struct {
+    char struct_id[4];
+    int struct_version;
+    int keepAliveInterval;
+    int cleansession;
+    const char *username;
+    const char *password;
+    MQTTAsync_onSuccess *onSuccess;
+    MQTTAsync_onFailure *onFailure;
+    void *context;
+} MQTTAsync_connectOptions;
+
+#define MQTTAsync_connectOptions_initializer { {'M', 'Q', 'T', 'C'}, 0, 60, 1, NULL, NULL, NULL, NULL, NULL }
+
+typedef struct {
+    char struct_id[4];
+    int struct_version;
+    int timeout;
+    MQTTAsync_onSuccess *onSuccess;
+    MQTTAsync_onFailure *onFailure;
+    void *context;
+} MQTTAsync_disconnectOptions;
+
+#define MQTTAsync_disconnectOptions_initializer { {'M', 'Q', 'T', 'D'}, 0, 0, NULL, NULL, NULL }
+
+int MQTTAsync_create(MQTTAsync *handle, const char *serverURI, const char *clientId, int persistence_type, void *persistence_context);
+
+int MQTTAsync_setCallbacks(MQTTAsync handle, void *context, MQTTAsync_connectionLost *cl, MQTTAsync_messageArrived *ma, MQTTAsync_deliveryComplete *dc);
+
+int MQTTAsync_connect(MQTTAsync handle, const MQTTAsync_connectOptions *options);
+
+int MQTTAsync_disconnect(MQTTAsync handle, const MQTTAsync_disconnectOptions *options);
+
+int MQTTAsync_subscribe(MQTTAsync handle, const char *topic, int qos, MQTTAsync_responseOptions *response);
+
+int MQTTAsync_sendMessage(MQTTAsync handle, const char *destinationName, const MQTTAsync_message *msg, MQTTAsync_responseOptions *response);
+
+void MQTTAsync_destroy(MQTTAsync *handle);
+
+void MQTTAsync_freeMessage(MQTTAsync_message **msg);
+
+void MQTTAsync_free(void *ptr);
+
+/*!\brief Waits until all callbacks requested so far have returned, only provided by the stub
+ *
+ * \param paTimeoutMs maximum time to wait in milliseconds
+ * \return MQTTASYNC_SUCCESS if no callback is pending anymore, MQTTASYNC_FAILURE on timeout
+ */
+int MQTTAsyncStub_waitUntilIdle(unsigned int paTimeoutMs);
+
+//! Number of subscriptions of all connected clients of the in-process broker, only provided by the stub
+unsigned int MQTTAsyncStub_getNrOfSubscriptions(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MQTTASYNC_STUB_H_ */
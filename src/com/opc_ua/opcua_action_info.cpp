@@ -19,7 +19,7 @@ const char *const CActionInfo::mActionNames[] = { "READ", "WRITE", "CREATE_METHO
   "DELETE_OBJECT", "DELETE_VARIABLE" };
 
 CActionInfo::CActionInfo(COPC_UA_Layer &paLayer, UA_ActionType paAction, const CIEC_STRING &paEndpoint) :
-    mAction(paAction), mLayer(paLayer), mEndpoint(paEndpoint) {
+    mAction(paAction), mLayer(paLayer), mEndpoint(paEndpoint), mHandlerStorage(0) {
 }
 
 CActionInfo::~CActionInfo() {
@@ -9,6 +9,7 @@
  *
  * Contributors:
  *    Jose Cabral - initial implementation
+ *    agent - storage the handler binds to the action
  *******************************************************************************/
 
 #ifndef SRC_MODULES_OPC_UA_OPCUA_ACTION_INFO_H_
@@ -89,6 +90,22 @@ class CActionInfo {
       return mEndpoint;
     }
 
+    /**
+     * Getter of the storage the handler bound to the action when initializing it
+     * @return Storage of the handler, 0 if the handler didn't bind any
+     */
+    void* getHandlerStorage() const {
+      return mHandlerStorage;
+    }
+
+    /**
+     * Binds storage of the handler to the action, so that executing the action doesn't need to look it up
+     * @param paHandlerStorage Storage of the handler, 0 to unbind it
+     */
+    void setHandlerStorage(void *paHandlerStorage) {
+      mHandlerStorage = paHandlerStorage;
+    }
+
     /**
      * Getter of the list of node pair information
      * @return List of node pair information
@@ -268,6 +285,11 @@ class CActionInfo {
      */
     CSinglyLinkedList<CNodePairInfo*> mNodePair;
 
+    /**
+     * Storage bound by the handler executing the action, owned by the handler
+     */
+    void *mHandlerStorage;
+
     static const size_t scmMinimumAmounOfParameters = 2; //at least two are needed
 
     /**
@@ -9,6 +9,7 @@
  *
  * Contributors:
  *    Jose Cabral - initial implementation
+ *    agent - coalescing bookkeeping moved to core utils
  *******************************************************************************/
 
 #include <forte_architecture_time.h>
@@ -17,18 +18,23 @@
 #include "opcua_handler_abstract.h" //for logger
 #include "opcua_client_config_parser.h"
 #include <stdio.h>
+#include <string.h>
 
 std::string gOpcuaClientConfigFile;
 
 CUA_ClientInformation::CUA_ClientInformation(const CIEC_STRING &paEndpoint) :
     mEndpointUrl(paEndpoint), mClient(0), mSubscriptionInfo(0), mMissingAsyncCalls(0), mNeedsReconnection(false), mWaitToInitializeActions(false),
         mIsClientValid(true),
-        mLastReconnectionTry(0), mLastActionInitializationTry(0), mSomeActionWasInitialized(false) {
+        mLastReconnectionTry(0), mLastActionInitializationTry(0), mSomeActionWasInitialized(false), mReadCoalescer(scmCoalescingWindowNano),
+        mWriteCoalescer(scmCoalescingWindowNano), mReadRequestBuffer(0),
+        mReadRequestBufferSize(0), mWriteRequestBuffer(0), mWriteRequestBufferSize(0) {
 }
 
 CUA_ClientInformation::~CUA_ClientInformation() {
   CCriticalRegion clientRegion(mClientMutex);
   uninitializeClient();
+  delete[] mReadRequestBuffer;
+  delete[] mWriteRequestBuffer;
 }
 
 bool CUA_ClientInformation::configureClient() {
@@ -81,6 +87,13 @@ void CUA_ClientInformation::uninitializeClient() {
     UA_Client_delete(mClient);
     mClient = 0;
   }
+  //the stack informs about the requests without response when the client is deleted, this is only for safety
+  for(CSinglyLinkedList<UA_CoalescedCallHandle*>::Iterator itCallHandle = mCoalescedCalls.begin(); itCallHandle != mCoalescedCalls.end(); ++itCallHandle) {
+    delete *itCallHandle;
+  }
+  mCoalescedCalls.clearAll();
+  mReadCoalescer.clearRequests();
+  mWriteCoalescer.clearRequests();
   mWaitToInitializeActions = false;
   mNeedsReconnection = false;
   mSomeActionWasInitialized = false;
@@ -138,81 +151,188 @@ bool CUA_ClientInformation::handleClientState() {
 }
 
 bool CUA_ClientInformation::executeAsyncCalls() {
+  uint_fast64_t now = getNanoSecondsMonotonic();
+  if(0 == mReadCoalescer.getTimeToSend(now)) {
+    sendPendingReads();
+  }
+  if(0 == mWriteCoalescer.getTimeToSend(now)) {
+    sendPendingWrites();
+  }
   return (UA_STATUSCODE_GOOD ==
     UA_Client_run_iterate(mClient, 10));
 }
 
+uint_fast64_t CUA_ClientInformation::getTimeToNextSend() const {
+  uint_fast64_t now = getNanoSecondsMonotonic();
+  uint_fast64_t retVal = mReadCoalescer.getTimeToSend(now);
+  if(mReadCoalescer.isEmpty()) {
+    retVal = mWriteCoalescer.getTimeToSend(now);
+  } else if(!mWriteCoalescer.isEmpty()) {
+    uint_fast64_t timeToSendWrites = mWriteCoalescer.getTimeToSend(now);
+    if(timeToSendWrites < retVal) {
+      retVal = timeToSendWrites;
+    }
+  }
+  return retVal;
+}
+
 UA_StatusCode CUA_ClientInformation::executeRead(CActionInfo& paActionInfo) {
   CCriticalRegion clientRegion(mClientMutex);
 
-  UA_ReadRequest request;
-  UA_ReadRequest_init(&request);
-  request.nodesToReadSize = paActionInfo.getNoOfNodePairs();
+  UA_StatusCode retVal = UA_STATUSCODE_BADINTERNALERROR;
+  UA_CoalescedActionInfo *coalescedAction = getCoalescedActionInfo(paActionInfo);
+  if(coalescedAction) {
+    mReadCoalescer.queue(*coalescedAction, getNanoSecondsMonotonic());
+    retVal = UA_STATUSCODE_GOOD;
+  } else {
+    DEVLOG_ERROR("[OPC UA CLIENT]: Couldn't dispatch read action for FB %s. The action has no node information\n",
+      paActionInfo.getLayer().getCommFB()->getInstanceName());
+  }
+  return retVal;
+}
 
-  UA_ReadValueId *ids = static_cast<UA_ReadValueId *>(UA_Array_new(request.nodesToReadSize, &UA_TYPES[UA_TYPES_READVALUEID]));
-  request.nodesToRead = ids;
+UA_StatusCode CUA_ClientInformation::executeWrite(CActionInfo& paActionInfo) {
+  CCriticalRegion clientRegion(mClientMutex);
 
-  size_t indexOfNodePair = 0;
-  for(CSinglyLinkedList<CActionInfo::CNodePairInfo*>::Iterator itNodePair = paActionInfo.getNodePairInfo().begin();
-      itNodePair != paActionInfo.getNodePairInfo().end(); ++itNodePair, indexOfNodePair++) {
-    UA_ReadValueId_init(&ids[indexOfNodePair]);
-    ids[indexOfNodePair].attributeId = UA_ATTRIBUTEID_VALUE;
-    UA_NodeId_copy((*itNodePair)->mNodeId, &ids[indexOfNodePair].nodeId);
+  UA_StatusCode retVal = UA_STATUSCODE_BADINTERNALERROR;
+  UA_CoalescedActionInfo *coalescedAction = getCoalescedActionInfo(paActionInfo);
+  if(coalescedAction) {
+    const CIEC_ANY *dataToSend = paActionInfo.getDataToSend();
+    for(size_t i = 0; i < coalescedAction->mNoOfElements; i++) {
+      UA_Variant_deleteMembers(&coalescedAction->mWriteValues[i].value.value); //value of a previous write
+      COPC_UA_Helper::fillVariant(coalescedAction->mWriteValues[i].value.value, dataToSend[i]);
+    }
+    mWriteCoalescer.queue(*coalescedAction, getNanoSecondsMonotonic());
+    retVal = UA_STATUSCODE_GOOD;
+  } else {
+    DEVLOG_ERROR("[OPC UA CLIENT]: Couldn't dispatch write action for FB %s. The action has no node information\n",
+      paActionInfo.getLayer().getCommFB()->getInstanceName());
   }
+  return retVal;
+}
 
-  UA_RemoteCallHandle *remoteCallHandle = new UA_RemoteCallHandle(paActionInfo, *this);
+CUA_ClientInformation::UA_CoalescedActionInfo* CUA_ClientInformation::getCoalescedActionInfo(const CActionInfo& paActionInfo) {
+  UA_CoalescedActionInfo *retVal = 0;
+  for(CSinglyLinkedList<UA_CoalescedActionInfo*>::Iterator itCoalescedAction = mCoalescedActions.begin(); itCoalescedAction != mCoalescedActions.end();
+      ++itCoalescedAction) {
+    if(&(*itCoalescedAction)->mActionInfo == &paActionInfo) {
+      retVal = *itCoalescedAction;
+      break;
+    }
+  }
+  return retVal;
+}
 
-  UA_StatusCode retVal = UA_Client_sendAsyncReadRequest(mClient, &request, CUA_RemoteCallbackFunctions::readAsyncCallback, remoteCallHandle, 0);
+void CUA_ClientInformation::sendPendingReads() {
+  forte::core::util::CCoalescedRequest *coalescedRequest = mReadCoalescer.take();
+  if(0 == coalescedRequest) {
+    return;
+  }
 
-  if(UA_STATUSCODE_GOOD != retVal) {
-    DEVLOG_ERROR("[OPC UA CLIENT]: Couldn't dispatch read action for FB %s. Error: %s\n", paActionInfo.getLayer().getCommFB()->getInstanceName(), UA_StatusCode_name(retVal));
-    delete remoteCallHandle;
-  } else {
-    addAsyncCall();
+  UA_CoalescedCallHandle *callHandle = new UA_CoalescedCallHandle(*this, mReadCoalescer, *coalescedRequest);
+  ensureRequestBufferSize(mReadRequestBuffer, mReadRequestBufferSize, coalescedRequest->getNoOfElements());
+  for(size_t i = 0; i < coalescedRequest->getNoOfParts(); i++) {
+    const forte::core::util::CCoalescedRequest::SPart &part = coalescedRequest->getPart(i);
+    memcpy(&mReadRequestBuffer[part.mOffset], callHandle->getAction(i)->mReadValueIds, part.mSize * sizeof(UA_ReadValueId));
   }
 
-  UA_ReadRequest_deleteMembers(&request);
+  //the request only references the node information of the actions, so it's not deleted afterwards. The stack encodes it before returning
+  UA_ReadRequest request;
+  UA_ReadRequest_init(&request);
+  request.nodesToReadSize = coalescedRequest->getNoOfElements();
+  request.nodesToRead = mReadRequestBuffer;
 
-  return retVal;
+  UA_StatusCode retVal = UA_Client_sendAsyncReadRequest(mClient, &request, CUA_RemoteCallbackFunctions::readAsyncCallback, callHandle, 0);
+  if(UA_STATUSCODE_GOOD == retVal) {
+    mCoalescedCalls.pushBack(callHandle);
+    addAsyncCall();
+  } else {
+    failCoalescedCall(callHandle, retVal, "read");
+  }
 }
 
-UA_StatusCode CUA_ClientInformation::executeWrite(CActionInfo& paActionInfo) {
-  CCriticalRegion clientRegion(mClientMutex);
+void CUA_ClientInformation::sendPendingWrites() {
+  forte::core::util::CCoalescedRequest *coalescedRequest = mWriteCoalescer.take();
+  if(0 == coalescedRequest) {
+    return;
+  }
 
-  UA_StatusCode retVal = UA_STATUSCODE_BADINTERNALERROR;
+  UA_CoalescedCallHandle *callHandle = new UA_CoalescedCallHandle(*this, mWriteCoalescer, *coalescedRequest);
+  ensureRequestBufferSize(mWriteRequestBuffer, mWriteRequestBufferSize, coalescedRequest->getNoOfElements());
+  for(size_t i = 0; i < coalescedRequest->getNoOfParts(); i++) {
+    const forte::core::util::CCoalescedRequest::SPart &part = coalescedRequest->getPart(i);
+    memcpy(&mWriteRequestBuffer[part.mOffset], callHandle->getAction(i)->mWriteValues, part.mSize * sizeof(UA_WriteValue));
+  }
+
+  //the request only references the node information and values of the actions, so it's not deleted afterwards. The stack encodes it before returning
   UA_WriteRequest request;
   UA_WriteRequest_init(&request);
-  request.nodesToWriteSize = paActionInfo.getNoOfNodePairs();
+  request.nodesToWriteSize = coalescedRequest->getNoOfElements();
+  request.nodesToWrite = mWriteRequestBuffer;
 
-  UA_WriteValue *ids = static_cast<UA_WriteValue *>(UA_Array_new(request.nodesToWriteSize, &UA_TYPES[UA_TYPES_WRITEVALUE]));
-  request.nodesToWrite = ids;
-
-  size_t indexOfNodePair = 0;
-  const CIEC_ANY *dataToSend = paActionInfo.getDataToSend();
-  for(CSinglyLinkedList<CActionInfo::CNodePairInfo*>::Iterator itNodePair = paActionInfo.getNodePairInfo().begin();
-      itNodePair != paActionInfo.getNodePairInfo().end(); ++itNodePair, indexOfNodePair++) {
+  UA_StatusCode retVal = UA_Client_sendAsyncWriteRequest(mClient, &request, CUA_RemoteCallbackFunctions::writeAsyncCallback, callHandle, 0);
+  if(UA_STATUSCODE_GOOD == retVal) {
+    mCoalescedCalls.pushBack(callHandle);
+    addAsyncCall();
+  } else {
+    failCoalescedCall(callHandle, retVal, "write");
+  }
+}
 
-    UA_WriteValue_init(&ids[indexOfNodePair]);
-    ids[indexOfNodePair].attributeId = UA_ATTRIBUTEID_VALUE;
-    UA_NodeId_copy((*itNodePair)->mNodeId, &ids[indexOfNodePair].nodeId);
-    ids[indexOfNodePair].value.hasValue = true;
+void CUA_ClientInformation::finishCoalescedCall(UA_CoalescedCallHandle* paCallHandle) {
+  mCoalescedCalls.erase(paCallHandle);
+  paCallHandle->mCoalescer.finished(&paCallHandle->mRequest);
+  delete paCallHandle;
+}
 
-    COPC_UA_Helper::fillVariant(ids[indexOfNodePair].value.value, dataToSend[indexOfNodePair]);
+void CUA_ClientInformation::failCoalescedCall(UA_CoalescedCallHandle* paCallHandle, UA_StatusCode paRetVal, const char* paRequestName) {
+  const forte::core::util::CCoalescedRequest &coalescedRequest = paCallHandle->mRequest;
+  DEVLOG_ERROR("[OPC UA CLIENT]: Couldn't dispatch %s request of %u actions in client %s. Error: %s\n", paRequestName,
+    static_cast<unsigned int>(coalescedRequest.getNoOfParts()), mEndpointUrl.getValue(), UA_StatusCode_name(paRetVal));
+  for(size_t i = 0; i < coalescedRequest.getNoOfParts(); i++) {
+    UA_CoalescedActionInfo *action = paCallHandle->getAction(i);
+    COPC_UA_Helper::UA_RecvVariable_handle varHandle(0 != action->mReadValueIds ? coalescedRequest.getPart(i).mSize : 0);
+    varHandle.mFailed = true;
+    deliverResponse(action->mActionInfo, varHandle);
   }
+  finishCoalescedCall(paCallHandle);
+}
 
-  UA_RemoteCallHandle *remoteCallHandle = new UA_RemoteCallHandle(paActionInfo, *this);
-  retVal = UA_Client_sendAsyncWriteRequest(mClient, &request, CUA_RemoteCallbackFunctions::writeAsyncCallback, remoteCallHandle, 0);
+void CUA_ClientInformation::deliverResponse(CActionInfo& paActionInfo, COPC_UA_Helper::UA_RecvVariable_handle& paVarHandle) {
+  paActionInfo.getLayer().recvData(static_cast<const void *>(&paVarHandle), 0);
+  paActionInfo.getLayer().getCommFB()->interruptCommFB(&paActionInfo.getLayer());
+  paActionInfo.getLayer().triggerNewEvent();
+}
 
-  if(UA_STATUSCODE_GOOD != retVal) {
-    DEVLOG_ERROR("[OPC UA CLIENT]: Couldn't dispatch write action for FB %s. Error: %s\n", paActionInfo.getLayer().getCommFB()->getInstanceName(), UA_StatusCode_name(retVal));
-    delete remoteCallHandle;
+CUA_ClientInformation::UA_CoalescedActionInfo::UA_CoalescedActionInfo(CActionInfo& paActionInfo) :
+    forte::core::util::SCoalescedAction(paActionInfo.getNoOfNodePairs()), mActionInfo(paActionInfo), mReadValueIds(0), mWriteValues(0) {
+  if(CActionInfo::eRead == paActionInfo.getAction()) {
+    mReadValueIds = static_cast<UA_ReadValueId *>(UA_Array_new(mNoOfElements, &UA_TYPES[UA_TYPES_READVALUEID]));
   } else {
-    addAsyncCall();
+    mWriteValues = static_cast<UA_WriteValue *>(UA_Array_new(mNoOfElements, &UA_TYPES[UA_TYPES_WRITEVALUE]));
   }
 
-  UA_WriteRequest_deleteMembers(&request);
+  size_t indexOfNodePair = 0;
+  for(CSinglyLinkedList<CActionInfo::CNodePairInfo*>::Iterator itNodePair = paActionInfo.getNodePairInfo().begin();
+      itNodePair != paActionInfo.getNodePairInfo().end(); ++itNodePair, indexOfNodePair++) {
+    if(mReadValueIds) {
+      mReadValueIds[indexOfNodePair].attributeId = UA_ATTRIBUTEID_VALUE;
+      UA_NodeId_copy((*itNodePair)->mNodeId, &mReadValueIds[indexOfNodePair].nodeId);
+    } else {
+      mWriteValues[indexOfNodePair].attributeId = UA_ATTRIBUTEID_VALUE;
+      UA_NodeId_copy((*itNodePair)->mNodeId, &mWriteValues[indexOfNodePair].nodeId);
+      mWriteValues[indexOfNodePair].value.hasValue = true;
+    }
+  }
+}
 
-  return retVal;
+CUA_ClientInformation::UA_CoalescedActionInfo::~UA_CoalescedActionInfo() {
+  if(mReadValueIds) {
+    UA_Array_delete(mReadValueIds, mNoOfElements, &UA_TYPES[UA_TYPES_READVALUEID]);
+  }
+  if(mWriteValues) {
+    UA_Array_delete(mWriteValues, mNoOfElements, &UA_TYPES[UA_TYPES_WRITEVALUE]);
+  }
 }
 
 UA_StatusCode CUA_ClientInformation::executeCallMethod(CActionInfo& paActionInfo) {
@@ -331,7 +451,7 @@ bool CUA_ClientInformation::initializeAction(CActionInfo& paActionInfo) {
 
         if(UA_STATUSCODE_GOOD != retVal) {
           DEVLOG_ERROR("[OPC UA CLIENT]: The index %u of the FB %s could not be initialized because the requested nodeId was not found. Error: %s\n",
-            runnerHelper, paActionInfo.getLayer().getCommFB()->getInstanceName(), UA_StatusCode_name(retVal));
+            static_cast<unsigned int>(runnerHelper), paActionInfo.getLayer().getCommFB()->getInstanceName(), UA_StatusCode_name(retVal));
           somethingFailed = true;
         } else {
           if((*itNodePair)->mNodeId) {
@@ -352,6 +472,11 @@ bool CUA_ClientInformation::initializeAction(CActionInfo& paActionInfo) {
     if(!somethingFailed && !initializeSubscription(paActionInfo)) { //won't initialize subscription if some nodeID is missing
       somethingFailed = true;
     }
+
+    //read and write prebuild the node information for their requests
+    if(!somethingFailed && (CActionInfo::eRead == paActionInfo.getAction() || CActionInfo::eWrite == paActionInfo.getAction())) {
+      mCoalescedActions.pushBack(new UA_CoalescedActionInfo(paActionInfo));
+    }
   }
   return somethingFailed;
 }
@@ -478,12 +603,14 @@ bool CUA_ClientInformation::addMonitoringItem(UA_MonitoringItemInfo &paMonitorin
     monRequest, static_cast<void *>(&paMonitoringInfo.mVariableInfo), CUA_RemoteCallbackFunctions::subscriptionValueChangedCallback, 0);
   if(UA_STATUSCODE_GOOD == monResponse.statusCode) {
     DEVLOG_INFO("[OPC UA CLIENT]: Monitoring of FB %s at index %u succeeded. The monitoring item id is %u\n",
-      paMonitoringInfo.mVariableInfo.mActionInfo.getLayer().getCommFB()->getInstanceName(), paMonitoringInfo.mVariableInfo.mPortIndex,
+      paMonitoringInfo.mVariableInfo.mActionInfo.getLayer().getCommFB()->getInstanceName(),
+      static_cast<unsigned int>(paMonitoringInfo.mVariableInfo.mPortIndex),
       monResponse.monitoredItemId);
     paMonitoringInfo.mMonitoringItemId = monResponse.monitoredItemId;
   } else {
     DEVLOG_ERROR("[OPC UA CLIENT]: Monitoring of FB %s at index %u failed. Error: %s\n",
-      paMonitoringInfo.mVariableInfo.mActionInfo.getLayer().getCommFB()->getInstanceName(), paMonitoringInfo.mVariableInfo.mPortIndex,
+      paMonitoringInfo.mVariableInfo.mActionInfo.getLayer().getCommFB()->getInstanceName(),
+      static_cast<unsigned int>(paMonitoringInfo.mVariableInfo.mPortIndex),
       UA_StatusCode_name(monResponse.statusCode));
   }
 
@@ -500,8 +627,24 @@ void CUA_ClientInformation::removeAsyncCall() {
 
 void CUA_ClientInformation::uninitializeAction(CActionInfo& paActionInfo) {
   mActionsToBeInitialized.erase(&paActionInfo); //remove in case it is still not initialized
-  if(CActionInfo::eSubscribe == paActionInfo.getAction()) { //only subscription has something to release
+  if(CActionInfo::eSubscribe == paActionInfo.getAction()) {
     uninitializeSubscribeAction(paActionInfo);
+  } else if(CActionInfo::eRead == paActionInfo.getAction() || CActionInfo::eWrite == paActionInfo.getAction()) {
+    uninitializeCoalescedAction(paActionInfo);
+  }
+}
+
+void CUA_ClientInformation::uninitializeCoalescedAction(const CActionInfo &paActionInfo) {
+  UA_CoalescedActionInfo *coalescedAction = getCoalescedActionInfo(paActionInfo);
+  if(coalescedAction) {
+    //requests already sent won't deliver their response to this action
+    if(CActionInfo::eRead == paActionInfo.getAction()) {
+      mReadCoalescer.remove(*coalescedAction);
+    } else {
+      mWriteCoalescer.remove(*coalescedAction);
+    }
+    mCoalescedActions.erase(coalescedAction);
+    delete coalescedAction;
   }
 }
 
@@ -556,82 +699,84 @@ void CUA_ClientInformation::resetSubscription(bool paDeleteSubscription) {
 // ******************** CALLBACKS *************************
 
 void CUA_ClientInformation::CUA_RemoteCallbackFunctions::readAsyncCallback(UA_Client *, void *paUserdata, UA_UInt32, UA_ReadResponse *paResponse) { //NOSONAR
-  UA_RemoteCallHandle *remoteCallHandle = static_cast<UA_RemoteCallHandle*>(paUserdata);
-  remoteCallHandle->mClientInformation.removeAsyncCall();
+  UA_CoalescedCallHandle *callHandle = static_cast<UA_CoalescedCallHandle*>(paUserdata);
+  CUA_ClientInformation &clientInformation = callHandle->mClientInformation;
+  clientInformation.removeAsyncCall();
 
-  COPC_UA_Helper::UA_RecvVariable_handle varHandle(paResponse->resultsSize);
-  if(UA_STATUSCODE_GOOD == paResponse->responseHeader.serviceResult) {
-    if(paResponse->resultsSize == remoteCallHandle->mActionInfo.getNoOfNodePairs()) {
-      //check if all results are OK first
-      for(size_t i = 0; i < paResponse->resultsSize; i++) {
-        if(paResponse->results[i].hasStatus && UA_STATUSCODE_GOOD != paResponse->results[i].status) {
-          DEVLOG_ERROR("[OPC UA CLIENT]: Reading for FB %s in client %s failed because the response for index %u has status %s\n",
-            remoteCallHandle->mActionInfo.getLayer().getCommFB()->getInstanceName(), remoteCallHandle->mActionInfo.getEndpoint().getValue(), i,
-            UA_StatusCode_name(paResponse->results[i].status));
-          varHandle.mFailed = true;
-          break;
-        }
-      }
+  bool requestFailed = true;
+  if(UA_STATUSCODE_GOOD != paResponse->responseHeader.serviceResult) {
+    DEVLOG_ERROR("[OPC UA CLIENT]: Reading for %u FBs in client %s failed. Error: %s\n", static_cast<unsigned int>(callHandle->mRequest.getNoOfParts()), clientInformation.mEndpointUrl.getValue(),
+      UA_StatusCode_name(paResponse->responseHeader.serviceResult));
+  } else if(paResponse->resultsSize != callHandle->mRequest.getNoOfElements()) {
+    DEVLOG_ERROR("[OPC UA CLIENT]: Reading in client %s failed because the response size is %u but %u values were requested\n",
+      clientInformation.mEndpointUrl.getValue(), static_cast<unsigned int>(paResponse->resultsSize),
+      static_cast<unsigned int>(callHandle->mRequest.getNoOfElements()));
+  } else {
+    requestFailed = false;
+  }
 
-      if(!varHandle.mFailed) {
-        size_t indexOfPair = 0;
-        for(CSinglyLinkedList<CActionInfo::CNodePairInfo*>::Iterator itNodePairs = remoteCallHandle->mActionInfo.getNodePairInfo().begin();
-            itNodePairs != remoteCallHandle->mActionInfo.getNodePairInfo().end(); ++itNodePairs, indexOfPair++) {
-          varHandle.mData[indexOfPair] = &paResponse->results[indexOfPair].value;
-        }
+  for(size_t i = 0; i < callHandle->mRequest.getNoOfParts(); i++) {
+    const forte::core::util::CCoalescedRequest::SPart &part = callHandle->mRequest.getPart(i);
+    if(0 == part.mAction) { //action was removed meanwhile
+      continue;
+    }
+    CActionInfo &actionInfo = callHandle->getAction(i)->mActionInfo;
+    COPC_UA_Helper::UA_RecvVariable_handle varHandle(part.mSize);
+    varHandle.mFailed = requestFailed;
+    for(size_t j = 0; j < part.mSize && !varHandle.mFailed; j++) {
+      const UA_DataValue &result = paResponse->results[part.mOffset + j];
+      if(result.hasStatus && UA_STATUSCODE_GOOD != result.status) {
+        DEVLOG_ERROR("[OPC UA CLIENT]: Reading for FB %s in client %s failed because the response for index %u has status %s\n",
+          actionInfo.getLayer().getCommFB()->getInstanceName(), actionInfo.getEndpoint().getValue(), static_cast<unsigned int>(j),
+          UA_StatusCode_name(result.status));
+        varHandle.mFailed = true;
+      } else {
+        varHandle.mData[j] = &result.value;
       }
-    } else {
-      DEVLOG_ERROR("[OPC UA CLIENT]: Reading for FB %s in client %s failed because the response size is %u but the FB has %u values to read\n",
-        remoteCallHandle->mActionInfo.getLayer().getCommFB()->getInstanceName(), remoteCallHandle->mActionInfo.getEndpoint().getValue(),
-        paResponse->resultsSize, remoteCallHandle->mActionInfo.getNoOfNodePairs());
-      varHandle.mFailed = true;
     }
-  } else {
-    DEVLOG_ERROR("[OPC UA CLIENT]: Reading for FB %s in client %s failed. Error: %s\n",
-      remoteCallHandle->mActionInfo.getLayer().getCommFB()->getInstanceName(), remoteCallHandle->mActionInfo.getEndpoint().getValue(),
-      UA_StatusCode_name(paResponse->responseHeader.serviceResult));
-    varHandle.mFailed = true;
+    deliverResponse(actionInfo, varHandle);
   }
 
-  remoteCallHandle->mActionInfo.getLayer().recvData(static_cast<const void *>(&varHandle), 0);
-  remoteCallHandle->mActionInfo.getLayer().getCommFB()->interruptCommFB(&remoteCallHandle->mActionInfo.getLayer());
-  remoteCallHandle->mActionInfo.getLayer().triggerNewEvent();
-  delete remoteCallHandle;
+  clientInformation.finishCoalescedCall(callHandle);
 }
 
 void CUA_ClientInformation::CUA_RemoteCallbackFunctions::writeAsyncCallback(UA_Client *, void *paUserdata, UA_UInt32, UA_WriteResponse *paResponse) { //NOSONAR
-  UA_RemoteCallHandle *remoteCallHandle = static_cast<UA_RemoteCallHandle*>(paUserdata);
-  remoteCallHandle->mClientInformation.removeAsyncCall();
-  COPC_UA_Helper::UA_RecvVariable_handle varHandle(0);
-  if(UA_STATUSCODE_GOOD == paResponse->responseHeader.serviceResult) {
-    if(paResponse->resultsSize == remoteCallHandle->mActionInfo.getNoOfNodePairs()) {
-      for(size_t i = 0; i < paResponse->resultsSize; i++) {
-        if(UA_STATUSCODE_GOOD != paResponse->results[i]) {
-          DEVLOG_ERROR("[OPC UA CLIENT]: Writing for FB %s in client %s failed because the response for index %u has status %s\n",
-            remoteCallHandle->mActionInfo.getLayer().getCommFB()->getInstanceName(), remoteCallHandle->mActionInfo.getEndpoint().getValue(), i,
-            UA_StatusCode_name(paResponse->results[i]));
-          varHandle.mFailed = true;
-          break;
-        }
-      }
-    } else {
-      DEVLOG_ERROR("[OPC UA CLIENT]: Writing for FB %s in client %s failed because the response size is %u but the FB has %u values to write\n",
-        remoteCallHandle->mActionInfo.getLayer().getCommFB()->getInstanceName(), remoteCallHandle->mActionInfo.getEndpoint().getValue(),
-        paResponse->resultsSize, remoteCallHandle->mActionInfo.getNoOfNodePairs());
-      varHandle.mFailed = true;
-    }
-  } else {
-    DEVLOG_ERROR("[OPC UA CLIENT]: Writing for FB %s in client %s failed. Error: %s\n",
-      remoteCallHandle->mActionInfo.getLayer().getCommFB()->getInstanceName(), remoteCallHandle->mActionInfo.getEndpoint().getValue(),
+  UA_CoalescedCallHandle *callHandle = static_cast<UA_CoalescedCallHandle*>(paUserdata);
+  CUA_ClientInformation &clientInformation = callHandle->mClientInformation;
+  clientInformation.removeAsyncCall();
+
+  bool requestFailed = true;
+  if(UA_STATUSCODE_GOOD != paResponse->responseHeader.serviceResult) {
+    DEVLOG_ERROR("[OPC UA CLIENT]: Writing for %u FBs in client %s failed. Error: %s\n", static_cast<unsigned int>(callHandle->mRequest.getNoOfParts()), clientInformation.mEndpointUrl.getValue(),
       UA_StatusCode_name(paResponse->responseHeader.serviceResult));
-    varHandle.mFailed = true;
+  } else if(paResponse->resultsSize != callHandle->mRequest.getNoOfElements()) {
+    DEVLOG_ERROR("[OPC UA CLIENT]: Writing in client %s failed because the response size is %u but %u values were written\n",
+      clientInformation.mEndpointUrl.getValue(), static_cast<unsigned int>(paResponse->resultsSize),
+      static_cast<unsigned int>(callHandle->mRequest.getNoOfElements()));
+  } else {
+    requestFailed = false;
   }
 
-  remoteCallHandle->mActionInfo.getLayer().recvData(static_cast<const void *>(&varHandle), 0);
-  remoteCallHandle->mActionInfo.getLayer().getCommFB()->interruptCommFB(&remoteCallHandle->mActionInfo.getLayer());
-  remoteCallHandle->mActionInfo.getLayer().triggerNewEvent();
+  for(size_t i = 0; i < callHandle->mRequest.getNoOfParts(); i++) {
+    const forte::core::util::CCoalescedRequest::SPart &part = callHandle->mRequest.getPart(i);
+    if(0 == part.mAction) { //action was removed meanwhile
+      continue;
+    }
+    CActionInfo &actionInfo = callHandle->getAction(i)->mActionInfo;
+    COPC_UA_Helper::UA_RecvVariable_handle varHandle(0);
+    varHandle.mFailed = requestFailed;
+    for(size_t j = 0; j < part.mSize && !varHandle.mFailed; j++) {
+      if(UA_STATUSCODE_GOOD != paResponse->results[part.mOffset + j]) {
+        DEVLOG_ERROR("[OPC UA CLIENT]: Writing for FB %s in client %s failed because the response for index %u has status %s\n",
+          actionInfo.getLayer().getCommFB()->getInstanceName(), actionInfo.getEndpoint().getValue(), static_cast<unsigned int>(j),
+          UA_StatusCode_name(paResponse->results[part.mOffset + j]));
+        varHandle.mFailed = true;
+      }
+    }
+    deliverResponse(actionInfo, varHandle);
+  }
 
-  delete remoteCallHandle;
+  clientInformation.finishCoalescedCall(callHandle);
 }
 
 void CUA_ClientInformation::CUA_RemoteCallbackFunctions::callMethodAsyncCallback( //We omit SONAR only for the parameters
@@ -651,14 +796,14 @@ void CUA_ClientInformation::CUA_RemoteCallbackFunctions::callMethodAsyncCallback
           DEVLOG_ERROR(
             "[OPC UA CLIENT]: Calling for FB %s in client %s failed because the number of RD connectors of the client %u does not match the number of returned values %u from the method call\n",
             remoteCallHandle->mActionInfo.getLayer().getCommFB()->getInstanceName(), remoteCallHandle->mActionInfo.getEndpoint().getValue(),
-            remoteCallHandle->mActionInfo.getLayer().getCommFB()->getNumRD(), response->results->outputArgumentsSize);
+            remoteCallHandle->mActionInfo.getLayer().getCommFB()->getNumRD(), static_cast<unsigned int>(response->results->outputArgumentsSize));
           somethingFailed = true;
         } else {
           for(size_t i = 0; i < response->results->inputArgumentResultsSize; i++) {
             if(UA_STATUSCODE_GOOD != response->results->inputArgumentResults[i]) {
               DEVLOG_ERROR("[OPC UA CLIENT]: Calling for FB %s in client %s failed because the input response for index %u has status %s\n",
-                remoteCallHandle->mActionInfo.getLayer().getCommFB()->getInstanceName(), remoteCallHandle->mActionInfo.getEndpoint().getValue(), i,
-                UA_StatusCode_name(response->results->inputArgumentResults[i]));
+                remoteCallHandle->mActionInfo.getLayer().getCommFB()->getInstanceName(), remoteCallHandle->mActionInfo.getEndpoint().getValue(),
+                static_cast<unsigned int>(i), UA_StatusCode_name(response->results->inputArgumentResults[i]));
               somethingFailed = true;
               break;
             }
@@ -673,7 +818,7 @@ void CUA_ClientInformation::CUA_RemoteCallbackFunctions::callMethodAsyncCallback
     } else {
       DEVLOG_ERROR("[OPC UA CLIENT]: Calling for FB %s in client %s failed because the response size is %u, different from 1\n",
         remoteCallHandle->mActionInfo.getLayer().getCommFB()->getInstanceName(), remoteCallHandle->mActionInfo.getEndpoint().getValue(),
-        response->resultsSize);
+        static_cast<unsigned int>(response->resultsSize));
       somethingFailed = true;
     }
   } else {
@@ -9,6 +9,7 @@
  *
  * Contributors:
  *    Jose Cabral - initial implementation
+ *    agent - coalescing bookkeeping moved to core utils
  *******************************************************************************/
 
 #ifndef SRC_MODULES_OPC_UA_OPCUA_CLIENT_INFORMATION_H_
@@ -18,6 +19,7 @@
 #include <fortelist.h>
 #include <forte_sync.h>
 #include <criticalregion.h>
+#include <requestcoalescer.h>
 #include <string>
 
 /**
@@ -66,9 +68,15 @@ class CUA_ClientInformation {
      * @return True if a new async call is needed, false otherwise
      */
     inline bool isAsyncNeeded() const {
-      return (0 != mMissingAsyncCalls);
+      return (0 != mMissingAsyncCalls || !mReadCoalescer.isEmpty() || !mWriteCoalescer.isEmpty());
     }
 
+    /**
+     * Get the time until the queued read and write actions are sent
+     * @return Time in nanoseconds until the coalescing window of the queued actions is over, 0 if they are due or nothing is queued
+     */
+    uint_fast64_t getTimeToNextSend() const;
+
     /**
      * Check if an action is present in the client
      * @return True if an action is present in the client, false otherwise
@@ -110,14 +118,16 @@ class CUA_ClientInformation {
     }
 
     /**
-     * Place the request to the OPC UA API for an asynchronous read of a remote variable
+     * Queue an asynchronous read of remote variables. All read actions queued within the coalescing window are sent to the server in one read request.
+     * A read action already waiting to be sent is not queued again
      * @param paActionInfo Action to be performed
      * @return UA_STATUSCODE_GOOD is no problem occurred, other value otherwise
      */
     UA_StatusCode executeRead(CActionInfo& paActionInfo);
 
     /**
-     * Place the request to the OPC UA API for an asynchronous write of a remote variable
+     * Queue an asynchronous write of remote variables. All write actions queued within the coalescing window are sent to the server in one write request.
+     * If the action is already waiting to be sent, only its values are updated
      * @param paActionInfo Action to be performed
      * @return UA_STATUSCODE_GOOD is no problem occurred, other value otherwise
      */
@@ -156,12 +166,12 @@ class CUA_ClientInformation {
       public:
 
         /**
-         * Async callback for read action
+         * Async callback for a read request sent for one or many read actions
          */
         static void readAsyncCallback(UA_Client *paClient, void *paUserdata, UA_UInt32 paRequestId, UA_ReadResponse *paResponse);
 
         /**
-         * Async callback for write action
+         * Async callback for a write request sent for one or many write actions
          */
         static void writeAsyncCallback(UA_Client *paClient, void *paUserdata, UA_UInt32 paRequestId, UA_WriteResponse *paResponse);
 
@@ -258,6 +268,104 @@ class CUA_ClientInformation {
         UA_RemoteCallHandle& operator=(const UA_RemoteCallHandle& other);
     };
 
+    /**
+     * Node information of a read or write action, prebuilt when the action is initialized. The node IDs are copied only once here,
+     * and the requests sent to the server reference them. For write actions, the values to be sent are also stored here.
+     * The elements of the coalesced action are the nodes
+     */
+    class UA_CoalescedActionInfo : public forte::core::util::SCoalescedAction {
+      public:
+        explicit UA_CoalescedActionInfo(CActionInfo& paActionInfo);
+        ~UA_CoalescedActionInfo();
+
+        CActionInfo& mActionInfo;
+        UA_ReadValueId *mReadValueIds;
+        UA_WriteValue *mWriteValues;
+      private:
+        UA_CoalescedActionInfo(const UA_CoalescedActionInfo &paObj);
+        UA_CoalescedActionInfo& operator=(const UA_CoalescedActionInfo& other);
+    };
+
+    /**
+     * Context of a request sent for many actions. The request stores which part of the results belongs to which action
+     */
+    class UA_CoalescedCallHandle {
+      public:
+        UA_CoalescedCallHandle(CUA_ClientInformation& paClientInformation, forte::core::util::CRequestCoalescer& paCoalescer,
+            forte::core::util::CCoalescedRequest& paRequest) :
+            mClientInformation(paClientInformation), mCoalescer(paCoalescer), mRequest(paRequest) {
+        }
+
+        /**
+         * Get the action of a part of the request
+         * @param paIndex Index of the part
+         * @return The action, or 0 if the action was uninitialized while the request was being executed
+         */
+        UA_CoalescedActionInfo* getAction(size_t paIndex) const {
+          return static_cast<UA_CoalescedActionInfo*>(mRequest.getPart(paIndex).mAction);
+        }
+
+        CUA_ClientInformation& mClientInformation;
+        forte::core::util::CRequestCoalescer& mCoalescer;
+        forte::core::util::CCoalescedRequest& mRequest;
+      private:
+        UA_CoalescedCallHandle(const UA_CoalescedCallHandle &paObj);
+        UA_CoalescedCallHandle& operator=(const UA_CoalescedCallHandle& other);
+    };
+
+    /**
+     * Get the prebuilt node information of an action
+     * @param paActionInfo Action to look for
+     * @return The node information, 0 if the action was not initialized
+     */
+    UA_CoalescedActionInfo* getCoalescedActionInfo(const CActionInfo& paActionInfo);
+
+    /**
+     * Send all queued read actions in one read request
+     */
+    void sendPendingReads();
+
+    /**
+     * Send all queued write actions in one write request
+     */
+    void sendPendingWrites();
+
+    /**
+     * Forget a finished request and its call handle
+     * @param paCallHandle Handle of the finished request
+     */
+    void finishCoalescedCall(UA_CoalescedCallHandle* paCallHandle);
+
+    /**
+     * Inform all actions of a request that it couldn't be sent and forget the request
+     * @param paCallHandle Handle of the request
+     * @param paRetVal Error returned when sending the request
+     * @param paRequestName Kind of the request, used for logging
+     */
+    void failCoalescedCall(UA_CoalescedCallHandle* paCallHandle, UA_StatusCode paRetVal, const char* paRequestName);
+
+    /**
+     * Inform the layer of the action that the response arrived
+     * @param paActionInfo Action which receives the response
+     * @param paVarHandle Received values, or mFailed set if the request failed
+     */
+    static void deliverResponse(CActionInfo& paActionInfo, COPC_UA_Helper::UA_RecvVariable_handle& paVarHandle);
+
+    /**
+     * Make sure the buffer used to build requests can hold the given amount of elements
+     * @param paBuffer Buffer to be checked and resized
+     * @param paCapacity Current capacity of the buffer, updated if resized
+     * @param paSize Needed size
+     */
+    template<typename T>
+    static void ensureRequestBufferSize(T *&paBuffer, size_t &paCapacity, size_t paSize) {
+      if(paCapacity < paSize) {
+        delete[] paBuffer;
+        paBuffer = new T[paSize];
+        paCapacity = paSize;
+      }
+    }
+
     /**
      * Look for the configuration file and load the configuration from it, otherwise it loads the default configuration
      * @param paConfigPointer Place to store the configuration
@@ -340,6 +448,12 @@ class CUA_ClientInformation {
      */
     void uninitializeSubscribeAction(const CActionInfo &paActionInfo);
 
+    /**
+     * Uninitialze a read or write action
+     * @param paActionInfo Action to be uninitialized
+     */
+    void uninitializeCoalescedAction(const CActionInfo &paActionInfo);
+
     /**
      * Reset the subscription information.
      * @param paDeleteSubscription The subscription must be deleted from the OPC UA stack
@@ -441,6 +555,34 @@ class CUA_ClientInformation {
      */
     bool mSomeActionWasInitialized;
 
+    /**
+     * Prebuilt node information of all initialized read and write actions
+     */
+    CSinglyLinkedList<UA_CoalescedActionInfo*> mCoalescedActions;
+
+    /**
+     * Read actions waiting to be sent and read requests waiting for their response
+     */
+    forte::core::util::CRequestCoalescer mReadCoalescer;
+
+    /**
+     * Write actions waiting to be sent and write requests waiting for their response
+     */
+    forte::core::util::CRequestCoalescer mWriteCoalescer;
+
+    /**
+     * Call handles of the requests sent to the server whose response didn't arrive yet
+     */
+    CSinglyLinkedList<UA_CoalescedCallHandle*> mCoalescedCalls;
+
+    /**
+     * Buffers where the requests are built. They reference the node information of the actions without copying it
+     */
+    UA_ReadValueId *mReadRequestBuffer;
+    size_t mReadRequestBufferSize;
+    UA_WriteValue *mWriteRequestBuffer;
+    size_t mWriteRequestBufferSize;
+
     /**
      * Time in nanoseconds that the client should wait before another reconnection try
      */
@@ -456,6 +598,11 @@ class CUA_ClientInformation {
      */
     static const UA_UInt32 scmClientTimeoutInMilli = 5E3; //5s
 
+    /**
+     * Time in nanoseconds that read and write actions are collected before they are sent together
+     */
+    static const uint_fast64_t scmCoalescingWindowNano = static_cast<uint_fast64_t>(FORTE_COM_OPC_UA_CLIENT_COALESCING_WINDOW * 1E6); //ms to nanoseconds
+
 };
 
 #endif /* SRC_MODULES_OPC_UA_OPCUA_CLIENT_INFORMATION_H_ */
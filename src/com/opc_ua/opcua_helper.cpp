@@ -141,6 +141,14 @@ size_t COPC_UA_Helper::convertToOPCUAType(const CIEC_ANY& paSrcAny, void *paDest
   return retVal;
 }
 
+COPC_UA_Helper::convertFromIECToOPCUA COPC_UA_Helper::getConverterToOPCUAType(const CIEC_ANY& paAnyType) {
+  CIEC_ANY::EDataTypeID typeId = paAnyType.getDataTypeID();
+  if(typeId >= CIEC_ANY::e_BOOL && typeId <= CIEC_ANY::e_WSTRING) { //basic type
+    return scmMapForteTypeIdToOpcUa[typeId].mToOPCUA;
+  }
+  return &COPC_UA_Helper::convertToOPCUAType;
+}
+
 size_t COPC_UA_Helper::convertFromOPCUAType(const void *paSrc, CIEC_ANY &paDestAny) {
   size_t retVal = 0;
 
@@ -21,6 +21,11 @@
 class COPC_UA_Helper {
   public:
 
+    /**
+     * Function pointer definition to convert a IEC 61131-3 type to an OPC UA Type
+     */
+    typedef size_t (*convertFromIECToOPCUA)(const CIEC_ANY &, void *);
+
     /**
      * Returns the OPC UA data type that correspond to the IEC 61131-3 type
      * @param paAnyType IEC 61131-3 type
@@ -36,6 +41,14 @@ class COPC_UA_Helper {
      */
     static size_t convertToOPCUAType(const CIEC_ANY& paSrcAny, void* paDest);
 
+    /**
+     * Get the function that converts values of the given IEC 61131-3 type to its OPC UA type. The function can be stored
+     * and called for every new value of the same type without looking up the type again
+     * @param paAnyType IEC 61131-3 type
+     * @return The conversion function for basic types, convertToOPCUAType for arrays and structures
+     */
+    static convertFromIECToOPCUA getConverterToOPCUAType(const CIEC_ANY& paAnyType);
+
     /**
      * Converts an OPC UA Type into its IEC 61131-3 type
      * @param paSrc Input to be converted
@@ -167,11 +180,6 @@ class COPC_UA_Helper {
 
   private:
 
-    /**
-     * Function pointer definition to convert a IEC 61131-3 type to an OPC UA Type
-     */
-    typedef size_t (*convertFromIECToOPCUA)(const CIEC_ANY &, void *);
-
     /**
      * Function pointer definition to convert an OPC UA type to an IEC 61131-3 Type
      */
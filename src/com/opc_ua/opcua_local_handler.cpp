@@ -47,6 +47,10 @@ COPC_UA_Local_Handler::COPC_UA_Local_Handler(CDeviceExecution &paDeviceExecution
 COPC_UA_Local_Handler::~COPC_UA_Local_Handler() {
   stopServer();
 
+  while(!mWriteActionUpdates.isEmpty()) {
+    uninitializeNodeValueUpdates(*(*mWriteActionUpdates.begin())->mActionInfo);
+  }
+
   for(CSinglyLinkedList<nodesReferencedByActions*>::Iterator iter = mNodesReferences.begin(); iter != mNodesReferences.end(); ++iter) {
     UA_NodeId_delete(const_cast<UA_NodeId*>((*iter)->mNodeId));
     delete *iter;
@@ -92,6 +96,7 @@ void COPC_UA_Local_Handler::run() {
           UA_UInt16 timeToSleepMs;
           {
             CCriticalRegion criticalRegion(mServerAccessMutex);
+            applyNodeValueUpdates();
             timeToSleepMs = UA_Server_run_iterate(mUaServer, false);
           }
           if(timeToSleepMs < scmMinimumIterationWaitTime) {
@@ -389,11 +394,15 @@ UA_StatusCode COPC_UA_Local_Handler::initializeAction(CActionInfo &paActionInfo)
 UA_StatusCode COPC_UA_Local_Handler::executeAction(CActionInfo &paActionInfo) {
   UA_StatusCode retVal = UA_STATUSCODE_BADINTERNALERROR;
 
+  if(CActionInfo::eWrite == paActionInfo.getAction()) {
+    //writes are applied by the server thread, so the server doesn't need to be locked here
+    retVal = executeWrite(paActionInfo);
+    mServerNeedsIteration.inc();
+    return retVal;
+  }
+
   CCriticalRegion criticalRegion(mServerAccessMutex);
   switch(paActionInfo.getAction()){
-    case CActionInfo::eWrite:
-      retVal = executeWrite(paActionInfo);
-      break;
     case CActionInfo::eCreateMethod:
       retVal = executeCreateMethod(paActionInfo);
       break;
@@ -421,8 +430,12 @@ UA_StatusCode COPC_UA_Local_Handler::uninitializeAction(CActionInfo &paActionInf
   UA_StatusCode retVal = UA_STATUSCODE_BADINTERNALERROR;
   CCriticalRegion criticalRegion(mServerAccessMutex);
   switch(paActionInfo.getAction()){
-    case CActionInfo::eRead:
     case CActionInfo::eWrite:
+      uninitializeNodeValueUpdates(paActionInfo);
+      referencedNodesDecrement(paActionInfo);
+      retVal = UA_STATUSCODE_GOOD;
+      break;
+    case CActionInfo::eRead:
     case CActionInfo::eCreateMethod:
     case CActionInfo::eCreateObject:
     case CActionInfo::eCreateVariable:
@@ -471,6 +484,10 @@ UA_StatusCode COPC_UA_Local_Handler::initializeVariable(CActionInfo &paActionInf
   //the referencedNodesDecrement function later
   referencedNodesIncrement(referencedNodes, paActionInfo);
 
+  if(UA_STATUSCODE_GOOD == retVal && paWrite) {
+    retVal = initializeNodeValueUpdates(paActionInfo);
+  }
+
   if(UA_STATUSCODE_GOOD != retVal) {
     referencedNodesDecrement(paActionInfo);
   }
@@ -617,20 +634,86 @@ UA_StatusCode COPC_UA_Local_Handler::createVariableNode(const CCreateVariableInf
   return retVal;
 }
 
-UA_StatusCode COPC_UA_Local_Handler::updateNodeValue(const UA_NodeId &paNodeId, const CIEC_ANY *paData) {
-  UA_Variant *nodeValue = UA_Variant_new();
-  UA_Variant_init(nodeValue);
-
-  const UA_DataType *dataType = COPC_UA_Helper::getOPCUATypeFromAny(*paData);
-  void *varValue = UA_new(dataType);
-  COPC_UA_Helper::convertToOPCUAType(*paData, varValue);
-  UA_Variant_setScalarCopy(nodeValue, varValue, dataType);
-  UA_StatusCode retVal = UA_Server_writeValue(mUaServer, paNodeId, *nodeValue);
-  UA_delete(varValue, dataType);
-  UA_Variant_delete(nodeValue);
+UA_StatusCode COPC_UA_Local_Handler::initializeNodeValueUpdates(CActionInfo &paActionInfo) {
+  UA_WriteActionUpdates *actionUpdates = new UA_WriteActionUpdates();
+  actionUpdates->mActionInfo = &paActionInfo;
+  actionUpdates->mNoOfNodes = paActionInfo.getNoOfNodePairs();
+  actionUpdates->mNodes = new UA_NodeValueUpdate[actionUpdates->mNoOfNodes];
+  mWriteActionUpdates.pushBack(actionUpdates);
+  paActionInfo.setHandlerStorage(actionUpdates);
+
+  UA_StatusCode retVal = UA_STATUSCODE_GOOD;
+  const CIEC_ANY *dataToSend = paActionInfo.getDataToSend();
+  size_t indexOfNodePair = 0;
+  for(CSinglyLinkedList<CActionInfo::CNodePairInfo*>::Iterator it = paActionInfo.getNodePairInfo().begin(); it != paActionInfo.getNodePairInfo().end();
+      ++it, indexOfNodePair++) {
+    UA_NodeValueUpdate &nodeUpdate = actionUpdates->mNodes[indexOfNodePair];
+    nodeUpdate.mType = COPC_UA_Helper::getOPCUATypeFromAny(dataToSend[indexOfNodePair]);
+    nodeUpdate.mConvert = COPC_UA_Helper::getConverterToOPCUAType(dataToSend[indexOfNodePair]);
+    UA_NodeId_init(&nodeUpdate.mNodeId);
+    bool allocated = true;
+    for(size_t slot = 0; slot < scmNoOfWriteSlots; slot++) {
+      nodeUpdate.mValues[slot] = nodeUpdate.mType ? UA_new(nodeUpdate.mType) : 0;
+      allocated = allocated && (0 != nodeUpdate.mValues[slot]);
+    }
+    if(!allocated || UA_STATUSCODE_GOOD != UA_NodeId_copy((*it)->mNodeId, &nodeUpdate.mNodeId)) {
+      DEVLOG_ERROR("[OPC UA LOCAL]: Could not allocate the value of port %d at FB %s\n", indexOfNodePair,
+        paActionInfo.getLayer().getCommFB()->getInstanceName());
+      retVal = UA_STATUSCODE_BADOUTOFMEMORY;
+    }
+  }
+
+  if(UA_STATUSCODE_GOOD != retVal) {
+    uninitializeNodeValueUpdates(paActionInfo);
+  }
   return retVal;
 }
 
+void COPC_UA_Local_Handler::uninitializeNodeValueUpdates(CActionInfo &paActionInfo) {
+  UA_WriteActionUpdates *actionUpdates = static_cast<UA_WriteActionUpdates*>(paActionInfo.getHandlerStorage());
+  if(0 == actionUpdates) {
+    return;
+  }
+  //writes still waiting in the slots are dropped with the storage
+  mWriteActionUpdates.erase(actionUpdates);
+  paActionInfo.setHandlerStorage(0);
+
+  for(size_t i = 0; i < actionUpdates->mNoOfNodes; i++) {
+    UA_NodeValueUpdate &nodeUpdate = actionUpdates->mNodes[i];
+    for(size_t j = 0; j < scmNoOfWriteSlots; j++) {
+      if(0 != nodeUpdate.mValues[j]) {
+        UA_delete(nodeUpdate.mValues[j], nodeUpdate.mType);
+      }
+    }
+    UA_NodeId_deleteMembers(&nodeUpdate.mNodeId);
+  }
+  delete[] actionUpdates->mNodes;
+  delete actionUpdates;
+}
+
+void COPC_UA_Local_Handler::applyNodeValueUpdates() {
+  //the actions cannot be removed meanwhile since uninitializing an action needs mServerAccessMutex, which is hold by the caller
+  for(CSinglyLinkedList<UA_WriteActionUpdates*>::Iterator it = mWriteActionUpdates.begin(); it != mWriteActionUpdates.end(); ++it) {
+    UA_WriteActionUpdates &actionUpdates = **it;
+    while(!actionUpdates.mSlots.isEmpty()) {
+      unsigned int slot = actionUpdates.mSlots.getReadSlot();
+      for(size_t i = 0; i < actionUpdates.mNoOfNodes; i++) {
+        UA_NodeValueUpdate &nodeUpdate = actionUpdates.mNodes[i];
+        UA_Variant nodeValue;
+        UA_Variant_init(&nodeValue);
+        UA_Variant_setScalar(&nodeValue, nodeUpdate.mValues[slot], nodeUpdate.mType);
+        nodeValue.storageType = UA_VARIANT_DATA_NODELETE;
+        UA_StatusCode retVal = UA_Server_writeValue(mUaServer, nodeUpdate.mNodeId, nodeValue);
+        if(UA_STATUSCODE_GOOD != retVal) {
+          DEVLOG_ERROR("[OPC UA LOCAL]: Could not write value to a local node. Error: %s\n", UA_StatusCode_name(retVal));
+          actionUpdates.mWriteStatus.store(retVal);
+        }
+      }
+      actionUpdates.mSlots.commitRead();
+    }
+  }
+}
+
 UA_StatusCode COPC_UA_Local_Handler::registerVariableCallBack(const UA_NodeId &paNodeId, CActionInfo &paActionInfo, size_t paPortIndex) {
 
   const UA_ValueCallback writeCallback = {
@@ -869,20 +952,28 @@ UA_StatusCode COPC_UA_Local_Handler::initializeDeleteNode(const CActionInfo&) co
 }
 
 UA_StatusCode COPC_UA_Local_Handler::executeWrite(CActionInfo &paActionInfo) {
-  UA_StatusCode retVal = UA_STATUSCODE_GOOD;
-  const CIEC_ANY *dataToSend = paActionInfo.getDataToSend();
-  size_t indexOfNodePair = 0;
-  for(CSinglyLinkedList<CActionInfo::CNodePairInfo*>::Iterator it = paActionInfo.getNodePairInfo().begin(); it != paActionInfo.getNodePairInfo().end();
-      ++it, indexOfNodePair++) {
+  UA_WriteActionUpdates *actionUpdates = static_cast<UA_WriteActionUpdates*>(paActionInfo.getHandlerStorage());
+  if(0 == actionUpdates) {
+    DEVLOG_ERROR("[OPC UA LOCAL]: The write action at FB %s was not initialized\n", paActionInfo.getLayer().getCommFB()->getInstanceName());
+    return UA_STATUSCODE_BADINTERNALERROR;
+  }
 
-    retVal = updateNodeValue(*(*it)->mNodeId, &dataToSend[indexOfNodePair]);
-    if(UA_STATUSCODE_GOOD != retVal) {
-      DEVLOG_ERROR("[OPC UA LOCAL]: Could not convert value to write for port %d at FB %s. Error: %s\n", indexOfNodePair,
-        paActionInfo.getLayer().getCommFB()->getInstanceName(), UA_StatusCode_name(retVal));
-      break;
-    }
+  UA_StatusCode retVal = actionUpdates->mWriteStatus.exchange(UA_STATUSCODE_GOOD);
+  if(actionUpdates->mSlots.isFull()) {
+    DEVLOG_ERROR("[OPC UA LOCAL]: The server didn't apply the previous writes of FB %s yet, the new values are dropped\n",
+      paActionInfo.getLayer().getCommFB()->getInstanceName());
+    return (UA_STATUSCODE_GOOD != retVal) ? retVal : UA_STATUSCODE_BADTOOMANYOPERATIONS;
+  }
 
+  //the FB is the only writer of the slots of its action
+  unsigned int slot = actionUpdates->mSlots.getWriteSlot();
+  const CIEC_ANY *dataToSend = paActionInfo.getDataToSend();
+  for(size_t i = 0; i < actionUpdates->mNoOfNodes; i++) {
+    UA_NodeValueUpdate &nodeUpdate = actionUpdates->mNodes[i];
+    UA_deleteMembers(nodeUpdate.mValues[slot], nodeUpdate.mType); //only strings have allocated members to be released here
+    nodeUpdate.mConvert(dataToSend[i], nodeUpdate.mValues[slot]);
   }
+  actionUpdates->mSlots.commitWrite();
   return retVal;
 }
 
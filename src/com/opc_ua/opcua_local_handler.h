@@ -25,6 +25,8 @@
 #include <forte_sem.h>
 #include <forte_sync.h>
 #include "../../core/fortelist.h"
+#include <forte_atomic.h>
+#include "../../core/utils/spscslotring.h"
 #include "opcua_handler_abstract.h"
 #include "opcua_helper.h"
 
@@ -405,12 +407,64 @@ class COPC_UA_Local_Handler : public COPC_UA_HandlerAbstract, public CThread {
     UA_StatusCode createVariableNode(const CCreateVariableInfo &paCreateVariableInfo);
 
     /**
-     * Update a variable node value from a IEC61499 data object.
-     * @param paNodeId Node Id of the node to be updated
-     * @param paData Source data for the new value
+     * Number of writes of an action that can wait for the server thread
+     */
+    static const unsigned int scmNoOfWriteSlots = 4;
+
+    /**
+     * Preallocated value storage of a variable node written by a local write action, one value per write slot of the action. The type and
+     * the conversion function are bound when the action is initialized, so no memory is allocated for values of basic types
+     */
+    struct UA_NodeValueUpdate {
+        UA_NodeId mNodeId;
+        const UA_DataType *mType;
+        COPC_UA_Helper::convertFromIECToOPCUA mConvert;
+        void *mValues[scmNoOfWriteSlots];
+    };
+
+    /**
+     * Value storage of all nodes written by a local write action, bound to the action when it is initialized.
+     * The FB of the action converts new values into a write slot while the server thread writes the filled slots to the nodes. The
+     * slots are handed over through a lock-free ring, so neither the server nor the FB waits for the other
+     */
+    struct UA_WriteActionUpdates {
+        UA_WriteActionUpdates() :
+            mActionInfo(0), mNodes(0), mNoOfNodes(0), mSlots(scmNoOfWriteSlots), mWriteStatus(UA_STATUSCODE_GOOD) {
+        }
+
+        CActionInfo *mActionInfo;
+        UA_NodeValueUpdate *mNodes;
+        size_t mNoOfNodes;
+        forte::core::util::CSPSCSlotRing mSlots;
+        /**
+         * Result of the last failed write of the server thread, reported with the next write of the action
+         */
+        forte::arch::CAtomicUInt32 mWriteStatus;
+    };
+
+    /**
+     * Value storages of all initialized write actions. It's only changed and walked with mServerAccessMutex locked
+     */
+    CSinglyLinkedList<UA_WriteActionUpdates*> mWriteActionUpdates;
+
+    /**
+     * Allocate the value storage of the nodes of a write action and bind it to the action. The nodes must have been already created or found.
+     * It must be called with mServerAccessMutex locked
+     * @param paActionInfo Write action being initialized
      * @return UA_STATUSCODE_GOOD on success, other value otherwise
      */
-    UA_StatusCode updateNodeValue(const UA_NodeId &paNodeId, const CIEC_ANY *paData);
+    UA_StatusCode initializeNodeValueUpdates(CActionInfo &paActionInfo);
+
+    /**
+     * Remove the value storage of a write action, including its writes waiting to be applied. It must be called with mServerAccessMutex locked
+     * @param paActionInfo Write action being uninitialized
+     */
+    void uninitializeNodeValueUpdates(CActionInfo &paActionInfo);
+
+    /**
+     * Write the filled write slots of all actions to their nodes. It's called from the server thread with mServerAccessMutex locked before each iteration
+     */
+    void applyNodeValueUpdates();
 
     /**
      * Register the onWrite function as callback routine when a variable is written and also the context that is passed back
@@ -475,9 +529,11 @@ class COPC_UA_Local_Handler : public COPC_UA_HandlerAbstract, public CThread {
     UA_StatusCode initializeDeleteNode(const CActionInfo &paActionInfo) const;
 
     /**
-     * Execute the write action to a local variable
+     * Execute the write action to a local variable. The values are converted into a write slot of the action and written by the server thread,
+     * so a write the server fails at is reported by the next write of the action
      * @param paActionInfo Action to be executed
-     * @return UA_STATUSCODE_GOOD is no problem occurred, other value otherwise
+     * @return UA_STATUSCODE_GOOD is no problem occurred, the status of the last failed write of the server, or UA_STATUSCODE_BADTOOMANYOPERATIONS
+     * if all write slots of the action are still waiting for the server
      */
     UA_StatusCode executeWrite(CActionInfo &paActionInfo);
 
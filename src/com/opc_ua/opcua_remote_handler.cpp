@@ -66,7 +66,7 @@ void COPC_UA_Client_IterationList::run() {
     bool needsRetry = handleClients();
     if(isAlive()) {
       if(needsRetry) {
-        mNeedsIteration.timedWait(scmNanosecondsToSleep);
+        mNeedsIteration.timedWait(getNanosecondsToSleep());
       } else {
         mNeedsIteration.waitIndefinitely();
       }
@@ -106,7 +106,7 @@ void COPC_UA_Client_IterationList::updateClientList() {
 // ***************** CLIENT HANDLER ************* //
 
 COPC_UA_Remote_Handler::COPC_UA_Remote_Handler(CDeviceExecution& paDeviceExecution) :
-    COPC_UA_HandlerAbstract(paDeviceExecution), mConnectionHandler(*this) {
+    COPC_UA_HandlerAbstract(paDeviceExecution), mNanosecondsToNextSend(0), mConnectionHandler(*this) {
 }
 
 COPC_UA_Remote_Handler::~COPC_UA_Remote_Handler() {
@@ -289,6 +289,7 @@ bool COPC_UA_Remote_Handler::handleClients() {
   CCriticalRegion iterationCriticalRegion(getIterationClientsMutex()); //this is needed because removing a client from the list could cause trouble
   CSinglyLinkedList<CUA_ClientInformation *> failedClients;
   bool asyncIsNeeded = false;
+  mNanosecondsToNextSend = 0;
   for(CSinglyLinkedList<CUA_ClientInformation*>::Iterator itClientInformation = getIterationClients().begin();
       itClientInformation != getIterationClients().end();
       ++itClientInformation) {
@@ -298,6 +299,10 @@ bool COPC_UA_Remote_Handler::handleClients() {
         failedClients.pushBack(*itClientInformation);
       } else {
         asyncIsNeeded = (*itClientInformation)->isAsyncNeeded();
+        TForteUInt64 timeToNextSend = static_cast<TForteUInt64>((*itClientInformation)->getTimeToNextSend());
+        if(0 != timeToNextSend && (0 == mNanosecondsToNextSend || timeToNextSend < mNanosecondsToNextSend)) {
+          mNanosecondsToNextSend = timeToNextSend;
+        }
       }
     }
     if(!isAlive()) {
@@ -323,6 +328,13 @@ bool COPC_UA_Remote_Handler::handleClients() {
   return asyncIsNeeded;
 }
 
+TForteUInt64 COPC_UA_Remote_Handler::getNanosecondsToSleep() const {
+  if(0 != mNanosecondsToNextSend && mNanosecondsToNextSend < scmNanosecondsToSleep) {
+    return mNanosecondsToNextSend;
+  }
+  return scmNanosecondsToSleep;
+}
+
 //************************** CONECTION HANDLER ************** //
 
 COPC_UA_Remote_Handler::UA_ConnectionHandler::UA_ConnectionHandler(COPC_UA_Remote_Handler& paClientHandler) :
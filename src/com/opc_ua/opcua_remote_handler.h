@@ -78,6 +78,14 @@ class COPC_UA_Client_IterationList : public CThread {
      */
     void resumeIterationLoop();
 
+    /**
+     * Get the time to wait until the next iteration when handleClients() needs another iteration
+     * @return Time in nanoseconds to wait
+     */
+    virtual TForteUInt64 getNanosecondsToSleep() const {
+      return scmNanosecondsToSleep;
+    }
+
     /**
      * Access to private member mIterationClients
      * @return mIterationClients
@@ -156,6 +164,7 @@ class COPC_UA_Client_IterationList : public CThread {
      */
     CSemaphore mNeedsIteration;
 
+  protected:
     /**
      * Cyclic time to sleep if another iteration is needed. This is the period at which the iteration occurs normally
      */
@@ -289,6 +298,17 @@ class COPC_UA_Remote_Handler : public COPC_UA_HandlerAbstract, public COPC_UA_Cl
      */
     bool handleClients();
 
+    /**
+     * The iteration waits less than the normal period when a client has queued read or write actions whose coalescing window is over before
+     * @return Time in nanoseconds to wait
+     */
+    TForteUInt64 getNanosecondsToSleep() const;
+
+    /**
+     * Time until the first client has to send its queued read and write actions, 0 if no actions are queued. Calculated in handleClients()
+     */
+    TForteUInt64 mNanosecondsToNextSend;
+
     /**
      * Connection handler to pass the clients that aren't fully initialized yet
      */
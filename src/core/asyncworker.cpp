@@ -0,0 +1,186 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *    agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include "asyncworker.h"
+#include "esfb.h"
+#include <criticalregion.h>
+#include <string.h>
+
+DEFINE_HANDLER(CAsyncWorkerHandler);
+
+CAsyncJob::CAsyncJob(CEventSourceFB &paOwner) :
+    mOwner(paOwner), mState(eIdle), mNotify(false), mSubmitTime(0), mStartTime(0), mEndTime(0){
+}
+
+CAsyncWorkerHandler::CAsyncWorkerHandler(CDeviceExecution& paDeviceExecution) :
+    CExternalEventHandler(paDeviceExecution), mQueueStart(0), mQueueSize(0), mWorkersStarted(false), mEnabled(true){
+  memset(&mStatistics, 0, sizeof(mStatistics));
+  for(unsigned int i = 0; i < scmNumberOfWorkers; ++i){
+    mWorkers[i] = new CWorker(*this);
+  }
+}
+
+CAsyncWorkerHandler::~CAsyncWorkerHandler(){
+  disableHandler();
+  for(unsigned int i = 0; i < scmNumberOfWorkers; ++i){
+    delete mWorkers[i];
+  }
+}
+
+void CAsyncWorkerHandler::enableHandler(void){
+  CCriticalRegion criticalRegion(mSync);
+  mEnabled = true;
+}
+
+void CAsyncWorkerHandler::disableHandler(void){
+  bool workersStarted;
+  {
+    CCriticalRegion criticalRegion(mSync);
+    mEnabled = false;
+    workersStarted = mWorkersStarted;
+    mWorkersStarted = false;
+    //dropped jobs are idle again so that their owners can be deleted
+    for(; 0 != mQueueSize; --mQueueSize){
+      mQueue[mQueueStart]->mState = CAsyncJob::eIdle;
+      mQueueStart = (mQueueStart + 1) % scmQueueSize;
+    }
+  }
+  if(workersStarted){
+    for(unsigned int i = 0; i < scmNumberOfWorkers; ++i){
+      mWorkers[i]->stop();
+    }
+    mJobSem.inc();
+    for(unsigned int i = 0; i < scmNumberOfWorkers; ++i){
+      mWorkers[i]->end();
+    }
+  }
+}
+
+bool CAsyncWorkerHandler::submit(CAsyncJob &paJob){
+  CCriticalRegion criticalRegion(mSync);
+  if(!mEnabled || CAsyncJob::eIdle != paJob.mState || scmQueueSize == mQueueSize){
+    ++mStatistics.mRejected;
+    return false;
+  }
+  if(!mWorkersStarted){
+    mWorkersStarted = true;
+    for(unsigned int i = 0; i < scmNumberOfWorkers; ++i){
+      mWorkers[i]->start();
+    }
+  }
+  paJob.mState = CAsyncJob::eQueued;
+  paJob.mNotify = true;
+  paJob.mSubmitTime = getNanoSecondsMonotonic();
+  mQueue[(mQueueStart + mQueueSize) % scmQueueSize] = &paJob;
+  ++mQueueSize;
+  ++mStatistics.mSubmitted;
+  mJobSem.inc();
+  return true;
+}
+
+bool CAsyncWorkerHandler::retract(CAsyncJob &paJob){
+  CCriticalRegion criticalRegion(mSync);
+  bool hasRun = false;
+  switch(paJob.mState){
+    case CAsyncJob::eQueued:
+      for(unsigned int i = 0; i < mQueueSize; ++i){
+        if(&paJob == mQueue[(mQueueStart + i) % scmQueueSize]){
+          //close the gap so that the queue keeps its order
+          for(unsigned int j = i + 1; j < mQueueSize; ++j){
+            mQueue[(mQueueStart + j - 1) % scmQueueSize] = mQueue[(mQueueStart + j) % scmQueueSize];
+          }
+          --mQueueSize;
+          break;
+        }
+      }
+      break;
+    case CAsyncJob::eRunning:
+      paJob.mNotify = false;
+      //jobs are retracted when FBs are stopped or deleted, so waiting for the worker is rare enough for polling
+      while(CAsyncJob::eRunning == paJob.mState){
+        mSync.unlock();
+        CThread::sleepThread(1);
+        mSync.lock();
+      }
+      hasRun = true;
+      break;
+    case CAsyncJob::eDone:
+      hasRun = true;
+      break;
+    default:
+      break;
+  }
+  paJob.mState = CAsyncJob::eIdle;
+  return hasRun;
+}
+
+void CAsyncWorkerHandler::getStatistics(SStatistics &paStatistics){
+  CCriticalRegion criticalRegion(mSync);
+  paStatistics = mStatistics;
+}
+
+CAsyncJob *CAsyncWorkerHandler::takeJob(){
+  CCriticalRegion criticalRegion(mSync);
+  CAsyncJob *job = 0;
+  if(0 != mQueueSize){
+    job = mQueue[mQueueStart];
+    mQueueStart = (mQueueStart + 1) % scmQueueSize;
+    --mQueueSize;
+    job->mState = CAsyncJob::eRunning;
+    job->mStartTime = getNanoSecondsMonotonic();
+    if(0 != mQueueSize){
+      mJobSem.inc();
+    }
+  }
+  return job;
+}
+
+void CAsyncWorkerHandler::runJob(CAsyncJob &paJob){
+  paJob.run();
+
+  CCriticalRegion criticalRegion(mSync);
+  paJob.mEndTime = getNanoSecondsMonotonic();
+  TForteUInt64 queueTime = paJob.getQueueTime();
+  TForteUInt64 runTime = paJob.getRunTime();
+  ++mStatistics.mCompleted;
+  mStatistics.mTotalQueueTime += queueTime;
+  mStatistics.mTotalRunTime += runTime;
+  if(queueTime > mStatistics.mMaxQueueTime){
+    mStatistics.mMaxQueueTime = queueTime;
+  }
+  if(runTime > mStatistics.mMaxRunTime){
+    mStatistics.mMaxRunTime = runTime;
+  }
+  if(paJob.mNotify){
+    paJob.mState = CAsyncJob::eDone;
+    //still in the critical region so that a retracting owner can not be deleted before its event chain is started
+    startNewEventChain(&paJob.mOwner);
+  }
+  else{
+    paJob.mState = CAsyncJob::eIdle;
+  }
+}
+
+void CAsyncWorkerHandler::CWorker::run(){
+  while(isAlive()){
+    mHandler.mJobSem.waitIndefinitely();
+    if(!isAlive()){
+      //wake up the next worker which has to end
+      mHandler.mJobSem.inc();
+      break;
+    }
+    CAsyncJob *job;
+    while(isAlive() && (0 != (job = mHandler.takeJob()))){
+      mHandler.runJob(*job);
+    }
+  }
+}
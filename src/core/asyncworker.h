@@ -0,0 +1,179 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *    agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#ifndef _ASYNCWORKER_H_
+#define _ASYNCWORKER_H_
+
+#include "extevhan.h"
+#include <forte_thread.h>
+#include <forte_sync.h>
+#include <forte_sem.h>
+#include <forte_architecture_time.h>
+
+#ifndef FORTE_ASYNC_WORKER_THREADS
+#define FORTE_ASYNC_WORKER_THREADS 2
+#endif
+
+#ifndef FORTE_ASYNC_WORKER_QUEUE_SIZE
+#define FORTE_ASYNC_WORKER_QUEUE_SIZE 32
+#endif
+
+class CEventSourceFB;
+
+/*!\brief Blocking work an FB hands over to the worker threads of the device
+ *
+ * The job is owned by the FB. After the job was run the FB gets an external event (cg_nExternalEventID) in the event
+ * chain executor it set as event source FB. There it takes the results from the job and releases the job. A job can
+ * only be submitted again after it was released.
+ *
+ * run() is executed in a worker thread, therefore it must not access the data or connections of the FB. Everything the
+ * job needs has to be copied into the job before it is submitted.
+ */
+class CAsyncJob{
+  public:
+    enum EState{
+      eIdle, //!< can be submitted
+      eQueued, //!< waits for a worker
+      eRunning, //!< is executed by a worker
+      eDone //!< finished, the owner got or will get the completion event
+    };
+
+    explicit CAsyncJob(CEventSourceFB &paOwner);
+
+    virtual ~CAsyncJob(){
+    }
+
+    EState getState() const {
+      return mState;
+    }
+
+    //! Makes a done job available for the next submission, to be called after the results were taken
+    void release(){
+      if(eDone == mState){
+        mState = eIdle;
+      }
+    }
+
+    //! Time in nanoseconds the last run of the job waited in the queue
+    TForteUInt64 getQueueTime() const {
+      return static_cast<TForteUInt64>(mStartTime - mSubmitTime);
+    }
+
+    //! Time in nanoseconds the last run of the job took in the worker
+    TForteUInt64 getRunTime() const {
+      return static_cast<TForteUInt64>(mEndTime - mStartTime);
+    }
+
+  private:
+    //! The blocking work, executed in a worker thread
+    virtual void run() = 0;
+
+    CEventSourceFB &mOwner;
+    volatile EState mState;
+    bool mNotify; //!< false if the owner retracted the job and does not want the completion event
+    uint_fast64_t mSubmitTime;
+    uint_fast64_t mStartTime;
+    uint_fast64_t mEndTime;
+
+    friend class CAsyncWorkerHandler;
+};
+
+/*!\brief Pool of worker threads running blocking jobs of FBs outside of the event chain execution
+ *
+ * The threads are started with the first submitted job. The number of jobs waiting for a worker is limited, jobs are
+ * rejected if the queue is full so that FBs can report the overload instead of blocking the event chain.
+ *
+ * The pool size and the queue size are set with FORTE_ASYNC_WORKER_THREADS and FORTE_ASYNC_WORKER_QUEUE_SIZE.
+ */
+class CAsyncWorkerHandler : public CExternalEventHandler{
+    DECLARE_HANDLER(CAsyncWorkerHandler)
+  public:
+    //! Counters over all jobs, times are in nanoseconds
+    struct SStatistics{
+        TForteUInt32 mSubmitted;
+        TForteUInt32 mRejected;
+        TForteUInt32 mCompleted;
+        TForteUInt64 mTotalQueueTime;
+        TForteUInt64 mMaxQueueTime;
+        TForteUInt64 mTotalRunTime;
+        TForteUInt64 mMaxRunTime;
+    };
+
+    static const unsigned int scmNumberOfWorkers = FORTE_ASYNC_WORKER_THREADS;
+    static const unsigned int scmQueueSize = FORTE_ASYNC_WORKER_QUEUE_SIZE;
+
+    void enableHandler(void);
+
+    //! Stops the workers, queued jobs are not run anymore
+    void disableHandler(void);
+
+    void setPriority(int){
+      //currently we are doing nothing here.
+    }
+
+    int getPriority(void) const{
+      return 0;
+    }
+
+    /*!\brief Queues the job for the next free worker
+     *
+     * @return false if the job is not idle, the queue is full or the handler is disabled
+     */
+    bool submit(CAsyncJob &paJob);
+
+    /*!\brief Takes the job back without a completion event
+     *
+     * A queued job is removed from the queue, for a running job the call blocks until the worker finished it. Afterwards
+     * the job is idle. To be used when the owner is stopped or deleted.
+     *
+     * @return true if the job has been run and its results have not been taken by the owner yet
+     */
+    bool retract(CAsyncJob &paJob);
+
+    void getStatistics(SStatistics &paStatistics);
+
+  private:
+    class CWorker : public CThread{
+      public:
+        explicit CWorker(CAsyncWorkerHandler &paHandler) :
+            mHandler(paHandler){
+        }
+
+        //! Lets the worker leave its loop, the worker has to be woken up afterwards
+        void stop(){
+          setAlive(false);
+        }
+
+      private:
+        virtual void run();
+
+        CAsyncWorkerHandler &mHandler;
+    };
+
+    //! Next queued job, 0 if there is none
+    CAsyncJob *takeJob();
+
+    void runJob(CAsyncJob &paJob);
+
+    CWorker *mWorkers[scmNumberOfWorkers];
+    CAsyncJob *mQueue[scmQueueSize];
+    unsigned int mQueueStart;
+    unsigned int mQueueSize;
+    bool mWorkersStarted;
+    bool mEnabled;
+    SStatistics mStatistics;
+    CSyncObject mSync;
+    //! signals queued jobs, it does not count so a worker taking a job wakes up the next one if there are more
+    forte::arch::CSemaphore mJobSem;
+};
+
+#endif /* _ASYNCWORKER_H_ */
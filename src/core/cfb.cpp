@@ -11,6 +11,7 @@
  *    Thomas Strasser, Alois Zoitl, Gunnar Grabmaier, Gerhard Ebenhofer,
  *    Martin Melik Merkumians, Ingo Hegny
  *      - initial implementation and rework communication infrastructure
+ *    agent - sealed interface event connections for the running phase
  *******************************************************************************/
 #include <string.h>
 #include "cfb.h"
@@ -123,6 +124,15 @@ EMGMResponse CCompositeFB::changeFBExecutionState(EMGMCommandType pa_unCommand){
   return nRetVal;
 }
 
+void CCompositeFB::sealConnections(){
+  CFunctionBlock::sealConnections();
+  if(0 != mInterface2InternalEventCons){
+    for(TPortId i = 0; i < m_pstInterfaceSpec->m_nNumEIs; i++){
+      mInterface2InternalEventCons[i]->seal();
+    }
+  }
+}
+
 #ifdef FORTE_SUPPORT_MONITORING
 
 CFunctionBlock *CCompositeFB::getFB(forte::core::TNameIdentifier::CIterator &paNameListIt){
@@ -11,6 +11,7 @@
  *    Thomas Strasser, Alois Zoitl, Gunnar Grabmaier, Gerhard Ebenhofer,
  *    Ingo Hegny
  *      - initial implementation and rework communication infrastructure
+ *    agent - sealed interface event connections for the running phase
  *******************************************************************************/
 #ifndef _CFB_H_
 #define _CFB_H_
@@ -123,6 +124,9 @@ class CCompositeFB: public CFunctionBlock {
     virtual CFunctionBlock *getFB(forte::core::TNameIdentifier::CIterator &paNameListIt);
 #endif
 
+  protected:
+    virtual void sealConnections();
+
   private:
     virtual void executeEvent(int pa_nEIID);
 
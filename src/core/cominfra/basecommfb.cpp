@@ -40,16 +40,6 @@ CBaseCommFB::CBaseCommFB(const CStringDictionary::TStringId pa_nInstanceNameId,
 
 CBaseCommFB::~CBaseCommFB() {
   closeConnection();
-
-  if(0 != m_pstInterfaceSpec) {
-    //Free the memory allocated for the interface, only do this if we dynamically created it (i.e., getManagesFBData is true)
-    delete[](m_pstInterfaceSpec->m_anEIWith);
-    delete[](m_pstInterfaceSpec->m_anEOWith);
-    delete[](m_pstInterfaceSpec->m_aunDINames);
-    delete[](m_pstInterfaceSpec->m_aunDIDataTypeNames);
-    delete[](m_pstInterfaceSpec->m_aunDONames);
-    delete[](m_pstInterfaceSpec->m_aunDODataTypeNames);
-  }
 }
 
 EMGMResponse CBaseCommFB::changeFBExecutionState(EMGMCommandType pa_unCommand) {
@@ -173,6 +173,15 @@ bool CCommFB::createInterfaceSpec(const char* paConfigString, SFBInterfaceSpec&
   return true;
 }
 
+void CCommFB::releaseInterfaceSpec(SFBInterfaceSpec &paInterfaceSpec) {
+  delete[](paInterfaceSpec.m_anEIWith);
+  delete[](paInterfaceSpec.m_anEOWith);
+  delete[](paInterfaceSpec.m_aunDINames);
+  delete[](paInterfaceSpec.m_aunDIDataTypeNames);
+  delete[](paInterfaceSpec.m_aunDONames);
+  delete[](paInterfaceSpec.m_aunDODataTypeNames);
+}
+
 void CCommFB::configureDIs(const char* paDIConfigString, SFBInterfaceSpec& paInterfaceSpec) const {
   CStringDictionary::TStringId* diDataTypeNames;
   CStringDictionary::TStringId* diNames;
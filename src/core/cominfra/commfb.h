@@ -62,6 +62,12 @@ namespace forte {
 
         virtual bool createInterfaceSpec(const char* paConfigString, SFBInterfaceSpec& paInterfaceSpec);
 
+        virtual CGenFBInterfaceSpecCache::TReleaseInterfaceSpecFunc getSharedInterfaceSpecReleaseFunc() const {
+          return releaseInterfaceSpec;
+        }
+
+        static void releaseInterfaceSpec(SFBInterfaceSpec &paInterfaceSpec);
+
         void configureDIs(const char* paDIConfigString, SFBInterfaceSpec& paInterfaceSpec) const;
         void configureDOs(const char* paDOConfigString, SFBInterfaceSpec& paInterfaceSpec) const;
     };
@@ -0,0 +1,223 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *    agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include "deltacomlayer.h"
+#include "fbdkasn1layer.h"
+#include "basecommfb.h"
+#include "../utils/string_utils.h"
+#include "../../arch/devlog.h"
+#include <string.h>
+
+using namespace forte::com_infra;
+
+CDeltaComLayer::CDeltaComLayer(CComLayer* paUpperLayer, CBaseCommFB* paComFB) :
+    CComLayer(paUpperLayer, paComFB),
+    mKeyFrameInterval(scmDefaultKeyFrameInterval),
+    mNrOfSDs(0),
+    mLastSentValid(false),
+    mSendSequence(0),
+    mFramesSinceKeyFrame(0),
+    mSendBuffer(0),
+    mSendBufferSize(0),
+    mExpectedSequence(0),
+    mSynchronized(false),
+    mLostMessages(0),
+    mDroppedMessages(0){
+  allocateEncodedDataPoints(mCurrent, 0);
+  allocateEncodedDataPoints(mLastSent, 0);
+}
+
+CDeltaComLayer::~CDeltaComLayer(){
+  freeEncodedDataPoints(mCurrent);
+  freeEncodedDataPoints(mLastSent);
+  delete[] mSendBuffer;
+}
+
+EComResponse CDeltaComLayer::openConnection(char *paLayerParameter){
+  mKeyFrameInterval = scmDefaultKeyFrameInterval;
+  if((0 != paLayerParameter) && ('\0' != *paLayerParameter)){
+    unsigned int interval = static_cast<unsigned int>(forte::core::util::strtoul(paLayerParameter, 0, 10));
+    if(0 == interval){
+      DEVLOG_ERROR("[DELTA] Invalid keyframe interval: %s\n", paLayerParameter);
+      return e_InitInvalidId;
+    }
+    mKeyFrameInterval = interval;
+  }
+  mLastSentValid = false;
+  mFramesSinceKeyFrame = 0;
+  mSynchronized = false;
+  return e_InitOk;
+}
+
+void CDeltaComLayer::closeConnection(){
+  //We don't need to do anything specific on closing
+}
+
+EComResponse CDeltaComLayer::sendData(void *paData, unsigned int paSize){
+  if(0 == m_poBottomLayer){
+    return e_ProcessDataNoSocket;
+  }
+  TConstIEC_ANYPtr apoSDs = static_cast<TConstIEC_ANYPtr>(paData);
+  if((0 == apoSDs) && (0 != paSize)){
+    return e_ProcessDataDataTypeError;
+  }
+
+  if(paSize != mNrOfSDs){
+    freeEncodedDataPoints(mCurrent);
+    freeEncodedDataPoints(mLastSent);
+    allocateEncodedDataPoints(mCurrent, paSize);
+    allocateEncodedDataPoints(mLastSent, paSize);
+    mNrOfSDs = paSize;
+    mLastSentValid = false;
+  }
+
+  if(!encodeDataPoints(mCurrent, apoSDs, paSize)){
+    DEVLOG_ERROR("[DELTA] Could not serialize the data to be sent\n");
+    return e_ProcessDataDataTypeError;
+  }
+
+  bool keyFrame = !mLastSentValid || ((mFramesSinceKeyFrame + 1) >= mKeyFrameInterval);
+  unsigned int encodedSize = (0 != paSize) ? (mCurrent.mOffsets[paSize - 1] + mCurrent.mSizes[paSize - 1]) : 0;
+  unsigned int requiredSize = scmHeaderSize + getBitmapSize(paSize) + encodedSize;
+  if(requiredSize > mSendBufferSize){
+    delete[] mSendBuffer;
+    mSendBuffer = new TForteByte[requiredSize];
+    mSendBufferSize = requiredSize;
+  }
+
+  mSendBuffer[0] = static_cast<TForteByte>(keyFrame ? e_KeyFrame : 0);
+  mSendBuffer[1] = static_cast<TForteByte>(mSendSequence >> 8);
+  mSendBuffer[2] = static_cast<TForteByte>(mSendSequence & 0xFF);
+  unsigned int pos = scmHeaderSize;
+  TForteByte *bitmap = 0;
+  if(!keyFrame){
+    bitmap = mSendBuffer + pos;
+    memset(bitmap, 0, getBitmapSize(paSize));
+    pos += getBitmapSize(paSize);
+  }
+  for(unsigned int i = 0; i < paSize; ++i){
+    if(keyFrame || hasChanged(i)){
+      if(!keyFrame){
+        bitmap[i / 8] = static_cast<TForteByte>(bitmap[i / 8] | (1 << (i % 8)));
+      }
+      memcpy(mSendBuffer + pos, mCurrent.mBuffer + mCurrent.mOffsets[i], mCurrent.mSizes[i]);
+      pos += mCurrent.mSizes[i];
+    }
+  }
+
+  // the last sent encodings are kept for the next comparison, a failed send shows up as gap at the receivers
+  SEncodedDataPoints lastSent = mLastSent;
+  mLastSent = mCurrent;
+  mCurrent = lastSent;
+  mLastSentValid = true;
+  mFramesSinceKeyFrame = keyFrame ? 0 : (mFramesSinceKeyFrame + 1);
+  ++mSendSequence;
+
+  return m_poBottomLayer->sendData(mSendBuffer, pos);
+}
+
+EComResponse CDeltaComLayer::recvData(const void *paData, unsigned int paSize){
+  const TForteByte *receivedData = static_cast<const TForteByte*>(paData);
+  if((0 == m_poFb) || (0 == receivedData) || (scmHeaderSize > paSize)){
+    return e_ProcessDataDataTypeError;
+  }
+
+  bool keyFrame = (0 != (receivedData[0] & e_KeyFrame));
+  TForteUInt16 sequence = static_cast<TForteUInt16>((receivedData[1] << 8) | receivedData[2]);
+  if(mSynchronized && (sequence != mExpectedSequence)){
+    mLostMessages += static_cast<TForteUInt16>(sequence - mExpectedSequence);
+    DEVLOG_WARNING("[DELTA] Lost %d messages, waiting for the next keyframe\n", static_cast<TForteUInt16>(sequence - mExpectedSequence));
+    mSynchronized = false;
+  }
+  mExpectedSequence = static_cast<TForteUInt16>(sequence + 1);
+
+  if(!keyFrame && !mSynchronized){
+    ++mDroppedMessages;
+    return e_Nothing;
+  }
+
+  EComResponse eRetVal = applyFrame(receivedData + scmHeaderSize, paSize - scmHeaderSize, keyFrame);
+  mSynchronized = (e_ProcessDataOk == eRetVal);
+  return eRetVal;
+}
+
+EComResponse CDeltaComLayer::applyFrame(const TForteByte *paData, unsigned int paSize, bool paKeyFrame){
+  unsigned int nrOfRDs = m_poFb->getNumRD();
+  CIEC_ANY *apoRDs = m_poFb->getRDs();
+  const TForteByte *bitmap = 0;
+  unsigned int pos = 0;
+  if(!paKeyFrame){
+    if(getBitmapSize(nrOfRDs) > paSize){
+      return e_ProcessDataDataTypeError;
+    }
+    bitmap = paData;
+    pos = getBitmapSize(nrOfRDs);
+  }
+
+  for(unsigned int i = 0; i < nrOfRDs; ++i){
+    if(paKeyFrame || (0 != (bitmap[i / 8] & (1 << (i % 8))))){
+      int usedBytes = CFBDKASN1ComLayer::deserializeDataPoint(paData + pos, static_cast<int>(paSize - pos), apoRDs[i]);
+      if(0 >= usedBytes){
+        DEVLOG_ERROR("[DELTA] Could not deserialize data point %d\n", i);
+        return e_ProcessDataDataTypeError;
+      }
+      pos += static_cast<unsigned int>(usedBytes);
+    }
+  }
+  return e_ProcessDataOk;
+}
+
+bool CDeltaComLayer::encodeDataPoints(SEncodedDataPoints &paTarget, TConstIEC_ANYPtr paData, unsigned int paNrOfDataPoints){
+  unsigned int requiredSize = 0;
+  for(unsigned int i = 0; i < paNrOfDataPoints; ++i){
+    requiredSize += CFBDKASN1ComLayer::getRequiredSerializationSize(paData[i]);
+  }
+  if(requiredSize > paTarget.mBufferSize){
+    delete[] paTarget.mBuffer;
+    paTarget.mBuffer = new TForteByte[requiredSize];
+    paTarget.mBufferSize = requiredSize;
+  }
+
+  unsigned int offset = 0;
+  for(unsigned int i = 0; i < paNrOfDataPoints; ++i){
+    int size = CFBDKASN1ComLayer::serializeDataPoint(paTarget.mBuffer + offset, static_cast<int>(requiredSize - offset), paData[i]);
+    if(0 > size){
+      return false;
+    }
+    paTarget.mOffsets[i] = offset;
+    paTarget.mSizes[i] = static_cast<unsigned int>(size);
+    offset += static_cast<unsigned int>(size);
+  }
+  return true;
+}
+
+bool CDeltaComLayer::hasChanged(unsigned int paIndex) const {
+  return (mCurrent.mSizes[paIndex] != mLastSent.mSizes[paIndex])
+    || (0 != memcmp(mCurrent.mBuffer + mCurrent.mOffsets[paIndex], mLastSent.mBuffer + mLastSent.mOffsets[paIndex], mCurrent.mSizes[paIndex]));
+}
+
+void CDeltaComLayer::allocateEncodedDataPoints(SEncodedDataPoints &paTarget, unsigned int paNrOfDataPoints){
+  paTarget.mBuffer = 0;
+  paTarget.mBufferSize = 0;
+  paTarget.mOffsets = (0 != paNrOfDataPoints) ? new unsigned int[paNrOfDataPoints] : 0;
+  paTarget.mSizes = (0 != paNrOfDataPoints) ? new unsigned int[paNrOfDataPoints] : 0;
+}
+
+void CDeltaComLayer::freeEncodedDataPoints(SEncodedDataPoints &paTarget){
+  delete[] paTarget.mBuffer;
+  delete[] paTarget.mOffsets;
+  delete[] paTarget.mSizes;
+  paTarget.mBuffer = 0;
+  paTarget.mOffsets = 0;
+  paTarget.mSizes = 0;
+  paTarget.mBufferSize = 0;
+}
@@ -0,0 +1,110 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *    agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#ifndef DELTACOMLAYER_H_
+#define DELTACOMLAYER_H_
+
+#include "comlayer.h"
+#include "../datatypes/forte_any.h"
+
+namespace forte {
+
+  namespace com_infra {
+
+    /*!\brief Serializing layer which only transmits the data points changed since the last message
+     *
+     * ID format: delta[keyframe interval].ip[address] (e.g., delta[20].ip[239.0.0.1:61000])
+     *
+     * The layer replaces the fbdk layer on top of the stack and uses its encoding for the single data points. Every
+     * message starts with a header consisting of a flags byte and a 16 bit sequence number. Key frames contain all
+     * data points, delta frames contain a bitmap of the changed data points followed by the changed values only. A
+     * data point counts as changed if its encoding differs from the one last sent. Every keyframe interval-th message
+     * is a key frame, the first message is always one.
+     *
+     * Receivers detect lost messages by gaps in the sequence number. As a publisher has no channel back from its
+     * subscribers, a receiver resynchronizes by dropping all delta frames until the next key frame arrived. Dropped
+     * frames do not trigger an indication of the FB.
+     */
+    class CDeltaComLayer : public CComLayer{
+      public:
+        CDeltaComLayer(CComLayer* paUpperLayer, CBaseCommFB* paComFB);
+        virtual ~CDeltaComLayer();
+
+        EComResponse sendData(void *paData, unsigned int paSize);
+        EComResponse recvData(const void *paData, unsigned int paSize);
+
+        //! Number of messages that never arrived, detected by gaps in the sequence numbers
+        unsigned int getNrOfLostMessages() const {
+          return mLostMessages;
+        }
+
+        //! Number of delta frames dropped while waiting for a key frame after a loss
+        unsigned int getNrOfDroppedMessages() const {
+          return mDroppedMessages;
+        }
+
+        enum EFrameFlags{
+          e_KeyFrame = 1
+        };
+
+        static const unsigned int scmHeaderSize = 3;
+        static const unsigned int scmDefaultKeyFrameInterval = 20;
+
+      private:
+        //! Encodings of the data points of one message stored one after the other
+        struct SEncodedDataPoints{
+            TForteByte *mBuffer;
+            unsigned int mBufferSize;
+            unsigned int *mOffsets;
+            unsigned int *mSizes;
+        };
+
+        EComResponse openConnection(char *paLayerParameter);
+        void closeConnection();
+
+        //! Encodes all data points into paTarget, returns false if a data point could not be encoded
+        static bool encodeDataPoints(SEncodedDataPoints &paTarget, TConstIEC_ANYPtr paData, unsigned int paNrOfDataPoints);
+        static void allocateEncodedDataPoints(SEncodedDataPoints &paTarget, unsigned int paNrOfDataPoints);
+        static void freeEncodedDataPoints(SEncodedDataPoints &paTarget);
+
+        bool hasChanged(unsigned int paIndex) const;
+
+        EComResponse applyFrame(const TForteByte *paData, unsigned int paSize, bool paKeyFrame);
+
+        static unsigned int getBitmapSize(unsigned int paNrOfDataPoints){
+          return (paNrOfDataPoints + 7) / 8;
+        }
+
+        unsigned int mKeyFrameInterval;
+
+        // sender side
+        unsigned int mNrOfSDs;
+        SEncodedDataPoints mCurrent;
+        SEncodedDataPoints mLastSent;
+        bool mLastSentValid;
+        TForteUInt16 mSendSequence;
+        unsigned int mFramesSinceKeyFrame;
+        TForteByte *mSendBuffer;
+        unsigned int mSendBufferSize;
+
+        // receiver side
+        TForteUInt16 mExpectedSequence;
+        bool mSynchronized;
+        unsigned int mLostMessages;
+        unsigned int mDroppedMessages;
+    };
+
+  }
+
+}
+
+#endif /* DELTACOMLAYER_H_ */
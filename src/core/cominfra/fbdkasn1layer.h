@@ -104,6 +104,13 @@ namespace forte {
          */
         static int deserializeValue(const TForteByte* pa_pcBytes, int pa_nStreamSize, CIEC_ANY &pa_roCIECData);
 
+        /*!\brief Number of bytes needed for serializing the given data point
+         *
+         * @param pa_roCIECData IEC data point
+         * @return number of bytes serializeDataPoint will write for the data point
+         */
+        static unsigned int getRequiredSerializationSize(const CIEC_ANY &pa_roCIECData);
+
         enum EDataTypeTags{
           e_ANY_TAG = 0, e_BOOL_TAG = 1, e_SINT_TAG = 2, e_INT_TAG = 3, e_DINT_TAG = 4, e_LINT_TAG = 5, e_USINT_TAG = 6, e_UINT_TAG = 7, e_UDINT_TAG = 8, e_ULINT_TAG = 9, e_REAL_TAG = 10, e_LREAL_TAG = 11, e_TIME_TAG = 12, e_DATE_TAG = 13, e_TIME_OF_DAY_TAG = 14, e_DATE_AND_TIME_TAG = 15, e_STRING_TAG = 16, e_BYTE_TAG = 17, e_WORD_TAG = 18, e_DWORD_TAG = 19, e_LWORD_TAG = 20, e_WSTRING_TAG = 21, e_DerivedData_TAG = 26, e_DirectlyDerivedData_TAG = 27, e_EnumeratedData_TAG = 28, e_SubrangeData_TAG = 29, e_ARRAY_TAG = 22, //according to the compliance profile
           e_STRUCT_TAG = 31
@@ -202,8 +209,6 @@ namespace forte {
         static int deserializeValueStruct(const TForteByte* pa_pcBytes, int pa_nStreamSize, CIEC_STRUCT &pa_roIECData);
         /**@}*/
 
-        static unsigned int getRequiredSerializationSize(const CIEC_ANY &pa_roCIECData);
-
         EComResponse openConnection(char *pa_acLayerParameter);
         void closeConnection();
         void resizeDeserBuffer(unsigned int pa_size);
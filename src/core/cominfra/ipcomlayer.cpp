@@ -13,14 +13,24 @@
  *    Martin Melik-Merkumians -  fix typo in forte::com_infra::EComConnectionState, serial communication support for WIN32
  *    Michael Hofmann - fix for fragmented packets
  *    Patrik Smejkal - rename interrupt in interruptCCommFB
+ *    agent - deliver batched UDP datagrams one per event
  *******************************************************************************/
 #include "ipcomlayer.h"
 #include "../../arch/devlog.h"
 #include "commfb.h"
 #include <forte_thread.h>
+#ifdef FORTE_COM_ETH_UDP_BATCHING
+#include <criticalregion.h>
+#include "../resource.h"
+#include "../device.h"
+#endif
 
 using namespace forte::com_infra;
 
+#ifdef FORTE_COM_ETH_UDP_BATCHING
+CUDPBatchSender CIPComLayer::smUDPBatchSender;
+#endif
+
 CIPComLayer::CIPComLayer(CComLayer* paUpperLayer, CBaseCommFB* paComFB) :
         CComLayer(paUpperLayer, paComFB),
         mSocketID(CIPComSocketHandler::scmInvalidSocketDescriptor),
@@ -29,9 +39,21 @@ CIPComLayer::CIPComLayer(CComLayer* paUpperLayer, CBaseCommFB* paComFB) :
         mBufFillSize(0){
   memset(mRecvBuffer, 0, sizeof(mRecvBuffer)); //TODO change this to  m_acRecvBuffer{0} in the extended list when fully switching to C++11
   memset(&mDestAddr, 0, sizeof(mDestAddr));
+#ifdef FORTE_COM_ETH_UDP_BATCHING
+  mRecvRing = 0;
+  mRingStart = 0;
+  mRingCount = 0;
+  mDroppedDatagrams = 0;
+  mDeliveryPending = false;
+  mRecvFailed = false;
+  mBatchedSend = false;
+#endif
 }
 
 CIPComLayer::~CIPComLayer(){
+#ifdef FORTE_COM_ETH_UDP_BATCHING
+  delete[] mRecvRing;
+#endif
 }
 
 EComResponse CIPComLayer::sendData(void *paData, unsigned int paSize){
@@ -54,6 +76,12 @@ EComResponse CIPComLayer::sendData(void *paData, unsigned int paSize){
         }
         break;
       case e_Publisher:
+#ifdef FORTE_COM_ETH_UDP_BATCHING
+        if(mBatchedSend && smUDPBatchSender.queue(mDestAddr, static_cast<char*>(paData), paSize)){
+          break;
+        }
+        //the batch is full, send the datagram directly
+#endif
         if(0
             >= CIPComSocketHandler::sendDataOnUDP(mSocketID, &mDestAddr, static_cast<char*>(paData), paSize)){
           eRetVal = e_InitTerminated;
@@ -68,6 +96,11 @@ EComResponse CIPComLayer::sendData(void *paData, unsigned int paSize){
 }
 
 EComResponse CIPComLayer::processInterrupt(){
+#ifdef FORTE_COM_ETH_UDP_BATCHING
+  if(0 != mRecvRing){
+    return processReceivedDatagrams();
+  }
+#endif
   if(e_ProcessDataOk == mInterruptResp){
     switch (m_eConnectionState){
       case e_Connected:
@@ -149,6 +182,14 @@ EComResponse CIPComLayer::openConnection(char *paLayerParameter){
     }
 
     if(CIPComSocketHandler::scmInvalidSocketDescriptor != nSockDes){
+#ifdef FORTE_COM_ETH_UDP_BATCHING
+      if(e_Publisher == m_poFb->getComServiceType()){
+        mBatchedSend = smUDPBatchSender.addPublisher();
+      }
+      else if(e_Subscriber == m_poFb->getComServiceType() && 0 == mRecvRing){
+        mRecvRing = new SRecvSlot[CUDPBatchSender::scmBatchSize];
+      }
+#endif
       if(e_Publisher != m_poFb->getComServiceType()){
         //Publishers should not be registered for receiving data
         getExtEvHandler<CIPComSocketHandler>().addComCallback(nSockDes, this);
@@ -167,6 +208,20 @@ void CIPComLayer::closeConnection(){
   closeSocket(&mSocketID);
   closeSocket(&mListeningID);
 
+#ifdef FORTE_COM_ETH_UDP_BATCHING
+  if(mBatchedSend){
+    smUDPBatchSender.removePublisher();
+    mBatchedSend = false;
+  }
+  {
+    CCriticalRegion criticalRegion(mRingSync);
+    mRingStart = 0;
+    mRingCount = 0;
+    mDeliveryPending = false;
+    mRecvFailed = false;
+  }
+#endif
+
   m_eConnectionState = e_Disconnected;
 }
 
@@ -179,6 +234,12 @@ void CIPComLayer::closeSocket(CIPComSocketHandler::TSocketDescriptor *paSocketID
 }
 
 void CIPComLayer::handledConnectedDataRecv(){
+#ifdef FORTE_COM_ETH_UDP_BATCHING
+  if(0 != mRecvRing){
+    receiveDatagrams();
+    return;
+  }
+#endif
   // in case of fragmented packets, it can occur that the buffer is full,
   // to avoid calling receiveDataFromTCP with a buffer size of 0 wait until buffer is larger 0
   while((cg_unIPLayerRecvBufferSize - mBufFillSize) <= 0){
@@ -234,3 +295,87 @@ void CIPComLayer::handleConnectionAttemptInConnected() const {
     CIPComSocketHandler::closeSocket(socketID);
   }
 }
+
+#ifdef FORTE_COM_ETH_UDP_BATCHING
+void CIPComLayer::receiveDatagrams(){
+  unsigned int unNumFree;
+  unsigned int unFirstFree;
+  {
+    CCriticalRegion criticalRegion(mRingSync);
+    unNumFree = CUDPBatchSender::scmBatchSize - mRingCount;
+    unFirstFree = (mRingStart + mRingCount) % CUDPBatchSender::scmBatchSize;
+  }
+
+  if(0 == unNumFree){
+    // the FB did not process the previous datagrams yet, drop the new one so that the socket does not stay readable
+    if(0 < CIPComSocketHandler::receiveDataFromUDP(mSocketID, mRecvBuffer, cg_unIPLayerRecvBufferSize)){
+      ++mDroppedDatagrams;
+      DEVLOG_WARNING("CIPComLayer: receive ring full, datagram dropped (%u in total)\n", mDroppedDatagrams);
+    }
+    mInterruptResp = e_Nothing;
+    return;
+  }
+
+  // only this thread fills the free slots, so they can be used without holding the lock
+  memset(mRecvMessages, 0, sizeof(mRecvMessages));
+  for(unsigned int i = 0; i < unNumFree; ++i){
+    mRecvIOVecs[i].iov_base = mRecvRing[(unFirstFree + i) % CUDPBatchSender::scmBatchSize].mData;
+    mRecvIOVecs[i].iov_len = cg_unIPLayerRecvBufferSize;
+    mRecvMessages[i].msg_hdr.msg_iov = &mRecvIOVecs[i];
+    mRecvMessages[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  int nRetVal = CIPComSocketHandler::receiveBatchFromUDP(mSocketID, mRecvMessages, unNumFree);
+  for(int i = 0; i < nRetVal; ++i){
+    mRecvRing[(unFirstFree + i) % CUDPBatchSender::scmBatchSize].mSize = mRecvMessages[i].msg_len;
+  }
+
+  CCriticalRegion criticalRegion(mRingSync);
+  if(0 < nRetVal){
+    mRingCount += static_cast<unsigned int>(nRetVal);
+  }
+  else{
+    mRecvFailed = true;
+  }
+  if(mDeliveryPending){
+    // the interrupt not processed yet also delivers the new datagrams, so no further event chain is needed
+    mInterruptResp = e_Nothing;
+  }
+  else{
+    mDeliveryPending = true;
+    mInterruptResp = e_ProcessDataOk;
+    m_poFb->interruptCommFB(this);
+  }
+}
+
+EComResponse CIPComLayer::processReceivedDatagrams(){
+  unsigned int nrOfDatagrams;
+  EComResponse eRetVal = e_Nothing;
+  {
+    CCriticalRegion criticalRegion(mRingSync);
+    // datagrams received from now on raise a new interrupt
+    mDeliveryPending = false;
+    nrOfDatagrams = mRingCount;
+    if(mRecvFailed){
+      eRetVal = e_ProcessDataRecvFaild;
+      mRecvFailed = false;
+    }
+  }
+
+  // only this thread empties the ring, the socket handler only appends behind the datagrams counted above
+  for(unsigned int i = 0; i < nrOfDatagrams; ++i){
+    const SRecvSlot &slot = mRecvRing[(mRingStart + i) % CUDPBatchSender::scmBatchSize];
+    if(0 != m_poTopLayer){
+      EComResponse eResp = m_poTopLayer->recvData(slot.mData, slot.mSize);
+      if(eResp > eRetVal){
+        eRetVal = eResp;
+      }
+    }
+  }
+
+  CCriticalRegion criticalRegion(mRingSync);
+  mRingStart = (mRingStart + nrOfDatagrams) % CUDPBatchSender::scmBatchSize;
+  mRingCount -= nrOfDatagrams;
+  return eRetVal;
+}
+#endif
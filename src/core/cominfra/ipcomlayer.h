@@ -17,6 +17,10 @@
 #include <sockhand.h>
 #include <forte_config.h>
 #include "comlayer.h"
+#ifdef FORTE_COM_ETH_UDP_BATCHING
+#include "udpbatchsender.h"
+#include <forte_sync.h>
+#endif
 
 
 namespace forte {
@@ -33,6 +37,13 @@ namespace forte {
 
         EComResponse processInterrupt();
 
+#ifdef FORTE_COM_ETH_UDP_BATCHING
+        //! Number of datagrams a subscriber dropped because its receive ring was full
+        unsigned int getNrOfDroppedDatagrams() const {
+          return mDroppedDatagrams;
+        }
+#endif
+
       protected:
         CIPComSocketHandler::TSocketDescriptor mSocketID;
         CIPComSocketHandler::TUDPDestAddr mDestAddr;
@@ -49,6 +60,40 @@ namespace forte {
         EComResponse mInterruptResp;
         char mRecvBuffer[cg_unIPLayerRecvBufferSize];
         unsigned int mBufFillSize;
+
+#ifdef FORTE_COM_ETH_UDP_BATCHING
+        struct SRecvSlot{
+            unsigned int mSize;
+            char mData[cg_unIPLayerRecvBufferSize];
+        };
+
+        //! Drains all datagrams waiting on the subscriber socket into the receive ring
+        void receiveDatagrams();
+        /*!\brief Hands all datagrams in the receive ring to the top layer in the order they were received
+         *
+         * The socket handler raises one interrupt per received batch, datagrams arriving before it is processed are
+         * delivered with it. So every datagram passes the layers above, e.g., a delta decoder, but the FB sends one IND
+         * per batch with the data of the last datagram.
+         */
+        EComResponse processReceivedDatagrams();
+
+        //! Ring of received datagrams of subscribers, filled by the socket handler and emptied in processInterrupt
+        SRecvSlot *mRecvRing;
+        unsigned int mRingStart;
+        unsigned int mRingCount;
+        unsigned int mDroppedDatagrams;
+        //! an interrupt for the datagrams in the ring is raised but not yet processed
+        bool mDeliveryPending;
+        //! a receive failed since the last interrupt was processed
+        bool mRecvFailed;
+        CSyncObject mRingSync;
+        //! true if this publisher is registered at the batch sender
+        bool mBatchedSend;
+        struct mmsghdr mRecvMessages[CUDPBatchSender::scmBatchSize];
+        struct iovec mRecvIOVecs[CUDPBatchSender::scmBatchSize];
+
+        static CUDPBatchSender smUDPBatchSender;
+#endif
     };
 
   }
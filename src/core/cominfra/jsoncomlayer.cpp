@@ -0,0 +1,169 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *    agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include "jsoncomlayer.h"
+#include "basecommfb.h"
+#include "../../arch/devlog.h"
+#include <string.h>
+
+using namespace forte::com_infra;
+
+CJSONComLayer::CJSONComLayer(CComLayer* paUpperLayer, CBaseCommFB* paComFB) :
+    CComLayer(paUpperLayer, paComFB), mKeyList(0), mKeys(0), mNrOfKeys(0), mRDCopies(0), mRDCopiesSize(0){
+}
+
+CJSONComLayer::~CJSONComLayer(){
+  clearKeys();
+  delete[] mRDCopies;
+}
+
+EComResponse CJSONComLayer::openConnection(char *paLayerParameter){
+  clearKeys();
+  if((0 == paLayerParameter) || ('\0' == *paLayerParameter)){
+    return e_InitOk;
+  }
+
+  size_t length = strlen(paLayerParameter);
+  mKeyList = new char[length + 1];
+  memcpy(mKeyList, paLayerParameter, length + 1);
+  mNrOfKeys = 1;
+  for(size_t i = 0; i < length; ++i){
+    if(',' == mKeyList[i]){
+      ++mNrOfKeys;
+    }
+  }
+  mKeys = new const char*[mNrOfKeys];
+  char *key = mKeyList;
+  for(unsigned int i = 0; i < mNrOfKeys; ++i){
+    char *separator = strchr(key, ',');
+    if(0 != separator){
+      *separator = '\0';
+    }
+    //allow blanks after the commas
+    while(' ' == *key){
+      ++key;
+    }
+    mKeys[i] = key;
+    if('\0' == *key){
+      DEVLOG_ERROR("[JSON] Empty key in key list: %s\n", paLayerParameter);
+      clearKeys();
+      return e_InitInvalidId;
+    }
+    key = (0 != separator) ? separator + 1 : key;
+  }
+  return e_InitOk;
+}
+
+void CJSONComLayer::closeConnection(){
+  //We don't need to do anything specific on closing
+}
+
+void CJSONComLayer::clearKeys(){
+  delete[] mKeys;
+  delete[] mKeyList;
+  mKeys = 0;
+  mKeyList = 0;
+  mNrOfKeys = 0;
+}
+
+EComResponse CJSONComLayer::sendData(void *paData, unsigned int paSize){
+  if(0 == m_poBottomLayer){
+    return e_ProcessDataNoSocket;
+  }
+  TConstIEC_ANYPtr apoSDs = static_cast<TConstIEC_ANYPtr>(paData);
+  if((0 == apoSDs) && (0 != paSize)){
+    return e_ProcessDataDataTypeError;
+  }
+  if((0 != mNrOfKeys) && (mNrOfKeys != paSize)){
+    DEVLOG_ERROR("[JSON] The key list has %u entries for %u SDs\n", mNrOfKeys, paSize);
+    return e_ProcessDataDataTypeError;
+  }
+
+  mEncoder.clear();
+  bool encoded = true;
+  if((1 == paSize) && (0 == mNrOfKeys)){
+    encoded = mEncoder.encode(apoSDs[0]);
+  } else if(0 != mNrOfKeys){
+    mEncoder.beginObject();
+    for(unsigned int i = 0; encoded && (i < paSize); ++i){
+      mEncoder.addKey(mKeys[i]);
+      encoded = mEncoder.encode(apoSDs[i]);
+    }
+    mEncoder.endObject();
+  } else {
+    mEncoder.beginArray();
+    for(unsigned int i = 0; encoded && (i < paSize); ++i){
+      encoded = mEncoder.encode(apoSDs[i]);
+    }
+    mEncoder.endArray();
+  }
+
+  if(!encoded){
+    DEVLOG_ERROR("[JSON] Could not encode the data to be sent\n");
+    return e_ProcessDataDataTypeError;
+  }
+  return m_poBottomLayer->sendData(const_cast<char*>(mEncoder.getData()), static_cast<unsigned int>(mEncoder.getLength()));
+}
+
+EComResponse CJSONComLayer::recvData(const void *paData, unsigned int paSize){
+  if((0 == m_poFb) || ((0 == paData) && (0 != paSize))){
+    return e_ProcessDataDataTypeError;
+  }
+  unsigned int nrOfRDs = m_poFb->getNumRD();
+  if(0 == nrOfRDs){
+    return e_ProcessDataOk;
+  }
+
+  const char *text = static_cast<const char*>(paData);
+  CIEC_ANY *rdCopies = copyRDs(nrOfRDs);
+  int usedSize;
+  if((1 == nrOfRDs) && (0 == mNrOfKeys)){
+    usedSize = mDecoder.decode(text, paSize, rdCopies[0]);
+  } else {
+    usedSize = mDecoder.decode(text, paSize, rdCopies, nrOfRDs, (nrOfRDs == mNrOfKeys) ? mKeys : 0);
+  }
+  bool valid = (static_cast<int>(paSize) == usedSize);
+  if(valid){
+    CIEC_ANY *rds = m_poFb->getRDs();
+    for(unsigned int i = 0; i < nrOfRDs; ++i){
+      rds[i].setValue(rdCopies[i]);
+    }
+  }
+  deleteRDCopies(nrOfRDs);
+  if(!valid){
+    DEVLOG_ERROR("[JSON] Received data is not valid JSON for the RDs\n");
+    return e_ProcessDataDataTypeError;
+  }
+  return e_ProcessDataOk;
+}
+
+CIEC_ANY *CJSONComLayer::copyRDs(unsigned int paNrOfRDs){
+  unsigned int size = paNrOfRDs * static_cast<unsigned int>(sizeof(CIEC_ANY));
+  if(mRDCopiesSize < size){
+    delete[] mRDCopies;
+    mRDCopies = new TForteByte[size];
+    mRDCopiesSize = size;
+  }
+  //members missing in the text keep the values the RDs have
+  CIEC_ANY *rds = m_poFb->getRDs();
+  for(unsigned int i = 0; i < paNrOfRDs; ++i){
+    rds[i].clone(mRDCopies + i * sizeof(CIEC_ANY));
+  }
+  return reinterpret_cast<CIEC_ANY*>(mRDCopies);
+}
+
+void CJSONComLayer::deleteRDCopies(unsigned int paNrOfRDs){
+  CIEC_ANY *rdCopies = reinterpret_cast<CIEC_ANY*>(mRDCopies);
+  for(unsigned int i = 0; i < paNrOfRDs; ++i){
+    rdCopies[i].~CIEC_ANY();
+  }
+}
@@ -0,0 +1,69 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *    agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#ifndef JSONCOMLAYER_H_
+#define JSONCOMLAYER_H_
+
+#include "comlayer.h"
+#include "../utils/jsoncodec.h"
+
+namespace forte {
+
+  namespace com_infra {
+
+    /*!\brief Serializing layer which transmits the data of the communication FB as JSON text
+     *
+     * ID format: json[key list].lower layers (e.g., json[].mqtt[tcp://localhost:1883, client, topic] or
+     * json[level,unit].http[127.0.0.1:80/data;POST;application/json])
+     *
+     * The layer is placed on top of a layer transporting bytes. A single SD is sent as its JSON value (structs
+     * become objects), several SDs as a JSON array. With a comma separated key list the SDs are sent as one object
+     * with the keys as member names instead. Received text is decoded the same way into the RDs, object members
+     * are assigned by the key list then. The text is decoded into copies of the RDs, which are only taken over if
+     * the whole text could be decoded, so invalid data leaves the RDs unchanged.
+     */
+    class CJSONComLayer : public CComLayer{
+      public:
+        CJSONComLayer(CComLayer* paUpperLayer, CBaseCommFB* paComFB);
+        virtual ~CJSONComLayer();
+
+        EComResponse sendData(void *paData, unsigned int paSize);
+        EComResponse recvData(const void *paData, unsigned int paSize);
+
+      private:
+        EComResponse openConnection(char *paLayerParameter);
+        void closeConnection();
+
+        void clearKeys();
+
+        //! Clones the RDs into mRDCopies, so that the decoder does not change them if the text is invalid
+        CIEC_ANY *copyRDs(unsigned int paNrOfRDs);
+        void deleteRDCopies(unsigned int paNrOfRDs);
+
+        //! copy of the key list with the separators replaced by \0
+        char *mKeyList;
+        const char **mKeys;
+        unsigned int mNrOfKeys;
+
+        //! memory for the copies of the RDs the received text is decoded into
+        TForteByte *mRDCopies;
+        unsigned int mRDCopiesSize;
+
+        forte::core::util::CJSONEncoder mEncoder;
+        forte::core::util::CJSONDecoder mDecoder;
+    };
+
+  }
+
+}
+
+#endif /* JSONCOMLAYER_H_ */
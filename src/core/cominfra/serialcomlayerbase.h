@@ -8,14 +8,25 @@
  *
  * Contributors:
  *  Jose Cabral - initial API and implementation and/or initial documentation
+ *  agent - frame the received bytes and deliver one frame per event
  *******************************************************************************/
 
 #ifndef SRC_CORE_COMINFRA_SERIALCOMLAYERBASE_H_
 #define SRC_CORE_COMINFRA_SERIALCOMLAYERBASE_H_
 
 #include "comlayer.h"
+#include "serialframer.h"
 #include "../datatypes/forte_string.h"
 
+/*!\brief Base for the serial line layers of the different architectures
+ *
+ * The architecture specific layers read the received bytes into a ring buffer. A framer configured with the optional
+ * last layer parameter (see forte::com_infra::CSerialFramer) takes the complete frames from the ring into a frame queue.
+ * Every frame is delivered to the top layer in its own event chain, so the FB gets exactly one complete frame per
+ * event. Several frames received at once are delivered directly one after the other.
+ *
+ * ID format: ser[interface, baud rate, byte size, stop bits, parity, termination symbol(, framing)]
+ */
 template <typename TSerialHandle, TSerialHandle nullHandle = static_cast<TSerialHandle>(0) >
 class CSerialComLayerBase : public forte::com_infra::CComLayer{
   public:
@@ -102,11 +113,38 @@ class CSerialComLayerBase : public forte::com_infra::CComLayer{
     char mTerminationSymbol[3]; //**< Space for CR, LF, or CR/LF + Terminating \0
     forte::com_infra::EComResponse openConnection(char *paLayerParameter);
     virtual forte::com_infra::EComResponse openSerialConnection(const SSerialParameters& paSerialParameters, TSerialHandle* paHandleResult) = 0;
-    static const unsigned int mMaxRecvBuffer = 1000;
+    static const unsigned int mMaxRecvBuffer = 1000; //!< maximum size of a frame
+    static const unsigned int scmFrameQueueSize = 8;
+
+    /*!\brief Space for reading received bytes
+     *
+     * If the receive ring is full the bytes read into the returned space are dropped, so that the line does not stay
+     * readable. mRecvLock has to be held.
+     */
+    char *getRecvSpace(unsigned int &paSize);
+
+    //! Adds the bytes read into the space returned by getRecvSpace, mRecvLock has to be held
+    void addReceivedBytes(unsigned int paSize);
+
+    /*!\brief Moves the frames completed by the received bytes into the frame queue
+     *
+     * mRecvLock has to be held.
+     * @return e_ProcessDataOk if the FB got triggered for delivering the frames, e_Nothing otherwise
+     */
+    forte::com_infra::EComResponse handleReceivedBytes();
+
+    /*!\brief Informs the framer that no byte was received for its idle timeout
+     *
+     * mRecvLock has to be held. The completed frames are delivered with the next call of handleReceivedBytes.
+     */
+    void handleIdleLine();
+
+    forte::com_infra::CSerialFramer *getFramer() const {
+      return mFramer;
+    }
 
     forte::com_infra::EComResponse mInterruptResp;
-    char mRecvBuffer[mMaxRecvBuffer];
-    unsigned int mBufFillSize;
+    forte::com_infra::CSerialRingBuffer mRecvRing;
     CSyncObject mRecvLock;
 
     TSerialHandle mSerialHandle;
@@ -116,6 +154,17 @@ class CSerialComLayerBase : public forte::com_infra::CComLayer{
 
   private:
 
+    struct SFrame{
+      unsigned int mSize;
+      char mData[mMaxRecvBuffer];
+    };
+
+    //! Takes frames from the receive ring as long as there is space in the frame queue
+    void extractFrames();
+
+    //! Triggers the FB if frames are waiting and it is not already triggered
+    forte::com_infra::EComResponse scheduleDelivery();
+
     enum EForteSerialCommunicationParameter{
       eInterface = 0,
       eBaudrate,
@@ -123,9 +172,18 @@ class CSerialComLayerBase : public forte::com_infra::CComLayer{
       eStopBits,
       eParity,
       eTerminationSymbol,
+      eFraming,
       eSerComParamterAmount
     };
 
+    forte::com_infra::CSerialFramer *mFramer;
+    SFrame mFrames[scmFrameQueueSize];
+    unsigned int mFirstFrame;
+    unsigned int mNrOfFrames;
+    bool mDeliveryPending; //!< the FB got triggered for the frames in the queue
+    unsigned int mDroppedBytes;
+    char mDropBuffer[64]; //!< read space while the receive ring is full
+
     static const unsigned int mNoOfParameters = eSerComParamterAmount;
 
 };
@@ -8,50 +8,133 @@
  *
  * Contributors:
  *  Jose Cabral - initial API and implementation and/or initial documentation
+ *  agent - frame the received bytes and deliver one frame per event
  *******************************************************************************/
 
 #include "serialcomlayerbase.h"
+#include "basecommfb.h"
 #include "../utils/parameterParser.h"
+#include "../resource.h"
+#include "../device.h"
 #include <criticalregion.h>
+#include <devlog.h>
 
 template <typename TThreadHandle, TThreadHandle nullHandle>
 CSerialComLayerBase<TThreadHandle, nullHandle>::CSerialComLayerBase(forte::com_infra::CComLayer* paUpperLayer,
     forte::com_infra::CBaseCommFB * paFB) :
-    forte::com_infra::CComLayer(paUpperLayer, paFB), mInterruptResp(forte::com_infra::e_Nothing), mBufFillSize(0), mSerialHandle(nullHandle) {
-  memset(mRecvBuffer, 0, sizeof(mRecvBuffer)); //TODO change this to  mRecvBuffer{0} in the extended list when fully switching to C++11
+    forte::com_infra::CComLayer(paUpperLayer, paFB), mInterruptResp(forte::com_infra::e_Nothing), mSerialHandle(nullHandle),
+    mFramer(0), mFirstFrame(0), mNrOfFrames(0), mDeliveryPending(false), mDroppedBytes(0) {
   memset(mTerminationSymbol, 0, sizeof(mTerminationSymbol)); //TODO change this to  mTerminationSymbol{0} in the extended list when fully switching to C++11
 }
 
 template <typename TThreadHandle, TThreadHandle nullHandle>
 CSerialComLayerBase<TThreadHandle, nullHandle>::~CSerialComLayerBase() {
+  delete mFramer;
 }
 
 template <typename TThreadHandle, TThreadHandle nullHandle>
 forte::com_infra::EComResponse CSerialComLayerBase<TThreadHandle, nullHandle>::processInterrupt(){
-  if(forte::com_infra::e_ProcessDataOk == mInterruptResp){
-    CCriticalRegion lock(mRecvLock);
-    switch (m_eConnectionState){
-      case forte::com_infra::e_Connected:
-        if(0 != m_poTopLayer){
-          mInterruptResp = m_poTopLayer->recvData(mRecvBuffer, mBufFillSize);
-          mBufFillSize = 0;
-        }
-        break;
-      case forte::com_infra::e_Disconnected:
-      case forte::com_infra::e_Listening:
-      case forte::com_infra::e_ConnectedAndListening:
-      default:
-        break;
+  CCriticalRegion lock(mRecvLock);
+  if((0 == mNrOfFrames) || (forte::com_infra::e_ProcessDataOk != mInterruptResp)){
+    //errors are reported before further frames are delivered, they wait for the next received bytes
+    mDeliveryPending = false;
+    return (forte::com_infra::e_ProcessDataOk != mInterruptResp) ? mInterruptResp : forte::com_infra::e_Nothing;
+  }
+
+  forte::com_infra::EComResponse eRetVal = forte::com_infra::e_Nothing;
+  if((forte::com_infra::e_Connected == m_eConnectionState) && (0 != m_poTopLayer)){
+    SFrame &frame = mFrames[mFirstFrame];
+    eRetVal = m_poTopLayer->recvData(frame.mData, frame.mSize);
+  }
+  mFirstFrame = (mFirstFrame + 1) % scmFrameQueueSize;
+  --mNrOfFrames;
+
+  extractFrames();
+  if(0 != mNrOfFrames){
+    //every frame gets its own event, the next one is delivered right after this event chain
+    m_poFb->interruptCommFB(this);
+    m_poFb->getResource().getDevice().getDeviceExecution().startNewEventChain(m_poFb);
+  }
+  else{
+    mDeliveryPending = false;
+  }
+  return eRetVal;
+}
+
+template <typename TThreadHandle, TThreadHandle nullHandle>
+char *CSerialComLayerBase<TThreadHandle, nullHandle>::getRecvSpace(unsigned int &paSize){
+  char *space = mRecvRing.getFreeSpace(paSize);
+  if(0 == paSize){
+    paSize = static_cast<unsigned int>(sizeof(mDropBuffer));
+    space = mDropBuffer;
+  }
+  return space;
+}
+
+template <typename TThreadHandle, TThreadHandle nullHandle>
+void CSerialComLayerBase<TThreadHandle, nullHandle>::addReceivedBytes(unsigned int paSize){
+  if(mRecvRing.isFull()){
+    mDroppedBytes += paSize;
+    DEVLOG_WARNING("CSerialComLayer: receive buffer full, %u bytes dropped (%u in total)\n", paSize, mDroppedBytes);
+  }
+  else{
+    mRecvRing.commit(paSize);
+  }
+}
+
+template <typename TThreadHandle, TThreadHandle nullHandle>
+forte::com_infra::EComResponse CSerialComLayerBase<TThreadHandle, nullHandle>::handleReceivedBytes(){
+  extractFrames();
+  if(mRecvRing.isFull() && (scmFrameQueueSize != mNrOfFrames)){
+    //the framer does not find a frame end in the whole buffer, e.g., an RTU line which is never idle
+    mDroppedBytes += mRecvRing.size();
+    DEVLOG_WARNING("CSerialComLayer: no frame found in the receive buffer, %u bytes dropped (%u in total)\n", mRecvRing.size(), mDroppedBytes);
+    mRecvRing.clear();
+    mFramer->reset();
+  }
+  mInterruptResp = forte::com_infra::e_ProcessDataOk;
+  return scheduleDelivery();
+}
+
+template <typename TThreadHandle, TThreadHandle nullHandle>
+void CSerialComLayerBase<TThreadHandle, nullHandle>::handleIdleLine(){
+  mFramer->lineIdle(mRecvRing);
+}
+
+template <typename TThreadHandle, TThreadHandle nullHandle>
+void CSerialComLayerBase<TThreadHandle, nullHandle>::extractFrames(){
+  while(scmFrameQueueSize != mNrOfFrames){
+    SFrame &frame = mFrames[(mFirstFrame + mNrOfFrames) % scmFrameQueueSize];
+    forte::com_infra::CSerialFramer::EResult result = mFramer->extractFrame(mRecvRing, frame.mData, mMaxRecvBuffer, frame.mSize);
+    if(forte::com_infra::CSerialFramer::eFrame == result){
+      ++mNrOfFrames;
+    }
+    else if(forte::com_infra::CSerialFramer::eDropped == result){
+      DEVLOG_WARNING("CSerialComLayer: invalid or too large frame dropped\n");
     }
+    else{
+      break;
+    }
+  }
+}
+
+template <typename TThreadHandle, TThreadHandle nullHandle>
+forte::com_infra::EComResponse CSerialComLayerBase<TThreadHandle, nullHandle>::scheduleDelivery(){
+  if(mDeliveryPending || (0 == mNrOfFrames)){
+    return forte::com_infra::e_Nothing;
   }
-  return mInterruptResp;
+  mDeliveryPending = true;
+  m_poFb->interruptCommFB(this);
+  return forte::com_infra::e_ProcessDataOk;
 }
 
 template <typename TThreadHandle, TThreadHandle nullHandle>
 forte::com_infra::EComResponse CSerialComLayerBase<TThreadHandle, nullHandle>::openConnection(char *paLayerParameter)  {
   //Create Serial Com Handle
   CParameterParser parser(paLayerParameter, ',', mNoOfParameters);
-  if(mNoOfParameters != parser.parseParameters()){
+  size_t nrOfParameters = parser.parseParameters();
+  //the framing is optional
+  if((mNoOfParameters != nrOfParameters) && (mNoOfParameters - 1 != nrOfParameters)){
     return forte::com_infra::e_InitInvalidId;
   }
 
@@ -140,6 +223,17 @@ forte::com_infra::EComResponse CSerialComLayerBase<TThreadHandle, nullHandle>::o
     return forte::com_infra::e_InitInvalidId;
   }
 
+  delete mFramer;
+  mFramer = forte::com_infra::CSerialFramer::createFramer((mNoOfParameters == nrOfParameters) ? parser[CSerialComLayerBase::eFraming] : 0,
+    mTerminationSymbol, static_cast<unsigned int>(parsedParameters.baudRate));
+  if(0 == mFramer){
+    return forte::com_infra::e_InitInvalidId;
+  }
+  mRecvRing.clear();
+  mFirstFrame = 0;
+  mNrOfFrames = 0;
+  mDeliveryPending = false;
+
   forte::com_infra::EComResponse resp = openSerialConnection(parsedParameters, &mSerialHandle);
   if(forte::com_infra::e_InitOk == resp){
     m_eConnectionState = forte::com_infra::e_Connected;
@@ -0,0 +1,269 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *    agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include "serialframer.h"
+#include <string.h>
+
+using namespace forte::com_infra;
+
+char *CSerialRingBuffer::getFreeSpace(unsigned int &paSize){
+  unsigned int end = (mStart + mSize) & (scmCapacity - 1);
+  if(isFull()){
+    paSize = 0;
+  }
+  else{
+    paSize = (end >= mStart) ? (scmCapacity - end) : (mStart - end);
+  }
+  return mData + end;
+}
+
+void CSerialRingBuffer::commit(unsigned int paSize){
+  mSize += paSize;
+}
+
+void CSerialRingBuffer::copyOut(char *paDestination, unsigned int paSize) const {
+  unsigned int firstPart = scmCapacity - mStart;
+  if(firstPart > paSize){
+    firstPart = paSize;
+  }
+  memcpy(paDestination, mData + mStart, firstPart);
+  memcpy(paDestination + firstPart, mData, paSize - firstPart);
+}
+
+void CSerialRingBuffer::consume(unsigned int paSize){
+  mSize -= paSize;
+  //an empty ring starts again at the beginning so that the next read gets the whole space at once
+  mStart = (0 == mSize) ? 0 : ((mStart + paSize) & (scmCapacity - 1));
+}
+
+CSerialFramer *CSerialFramer::createFramer(const char *paFraming, const char *paTerminationSymbol, unsigned int paBaudRate){
+  if((0 == paFraming) || ('\0' == *paFraming) || (0 == strcmp("RAW", paFraming))){
+    return new CRawFramer();
+  }
+  if(0 == strcmp("LINE", paFraming)){
+    return new CDelimitedFramer(paTerminationSymbol, static_cast<unsigned int>(strlen(paTerminationSymbol)));
+  }
+  if(0 == strcmp("LEN1", paFraming)){
+    return new CLengthPrefixFramer(1);
+  }
+  if(0 == strcmp("LEN2", paFraming)){
+    return new CLengthPrefixFramer(2);
+  }
+  if(0 == strcmp("RTU", paFraming)){
+    return new CIdleLineFramer(paBaudRate);
+  }
+  if(0 == strcmp("SLIP", paFraming)){
+    return new CSLIPFramer();
+  }
+  if(0 == strcmp("COBS", paFraming)){
+    return new CCOBSFramer();
+  }
+  return 0;
+}
+
+CDelimitedFramer::CDelimitedFramer(const char *paDelimiter, unsigned int paDelimiterSize) :
+    mDelimiterSize((paDelimiterSize < sizeof(mDelimiter)) ? paDelimiterSize : static_cast<unsigned int>(sizeof(mDelimiter))),
+    mScanned(0), mDiscarding(false){
+  memcpy(mDelimiter, paDelimiter, mDelimiterSize);
+}
+
+CSerialFramer::EResult CDelimitedFramer::extractFrame(CSerialRingBuffer &paBuffer, char *paFrame, unsigned int paFrameCapacity, unsigned int &paFrameSize){
+  for(;;){
+    unsigned int frameEnd = findDelimiter(paBuffer);
+    if(paBuffer.size() == frameEnd){
+      //keep the last bytes in the scan as they may be the beginning of a split delimiter
+      mScanned = (frameEnd >= mDelimiterSize - 1) ? (frameEnd - (mDelimiterSize - 1)) : 0;
+      if(mDiscarding){
+        paBuffer.consume(mScanned);
+        mScanned = 0;
+      }
+      else if(mScanned > getMaxEncodedSize(paFrameCapacity)){
+        paBuffer.consume(mScanned);
+        mScanned = 0;
+        mDiscarding = true;
+        return eDropped;
+      }
+      return eIncomplete;
+    }
+
+    mScanned = 0;
+    if(mDiscarding){
+      //end of the too large frame
+      mDiscarding = false;
+      paBuffer.consume(frameEnd + mDelimiterSize);
+    }
+    else if(0 == frameEnd){
+      paBuffer.consume(mDelimiterSize);
+    }
+    else{
+      bool valid = decode(paBuffer, frameEnd, paFrame, paFrameCapacity, paFrameSize);
+      paBuffer.consume(frameEnd + mDelimiterSize);
+      return (valid) ? eFrame : eDropped;
+    }
+  }
+}
+
+bool CDelimitedFramer::decode(const CSerialRingBuffer &paBuffer, unsigned int paSize, char *paFrame, unsigned int paFrameCapacity, unsigned int &paFrameSize){
+  if(paSize > paFrameCapacity){
+    return false;
+  }
+  paBuffer.copyOut(paFrame, paSize);
+  paFrameSize = paSize;
+  return true;
+}
+
+unsigned int CDelimitedFramer::findDelimiter(const CSerialRingBuffer &paBuffer) const {
+  const unsigned char first = static_cast<unsigned char>(mDelimiter[0]);
+  for(unsigned int i = mScanned; i + mDelimiterSize <= paBuffer.size(); ++i){
+    if((first == paBuffer[i]) && ((1 == mDelimiterSize) || (static_cast<unsigned char>(mDelimiter[1]) == paBuffer[i + 1]))){
+      return i;
+    }
+  }
+  return paBuffer.size();
+}
+
+namespace {
+  const char scmSLIPEnd = static_cast<char>(CSLIPFramer::scmEnd);
+  const char scmCOBSDelimiter = '\0';
+}
+
+CSLIPFramer::CSLIPFramer() :
+    CDelimitedFramer(&scmSLIPEnd, 1){
+}
+
+bool CSLIPFramer::decode(const CSerialRingBuffer &paBuffer, unsigned int paSize, char *paFrame, unsigned int paFrameCapacity, unsigned int &paFrameSize){
+  unsigned int frameSize = 0;
+  for(unsigned int i = 0; i < paSize; ++i){
+    unsigned char value = paBuffer[i];
+    if(scmEsc == value){
+      if(++i == paSize){
+        return false;
+      }
+      switch(paBuffer[i]){
+        case scmEscEnd:
+          value = scmEnd;
+          break;
+        case scmEscEsc:
+          value = scmEsc;
+          break;
+        default:
+          return false;
+      }
+    }
+    if(frameSize == paFrameCapacity){
+      return false;
+    }
+    paFrame[frameSize++] = static_cast<char>(value);
+  }
+  paFrameSize = frameSize;
+  return true;
+}
+
+CCOBSFramer::CCOBSFramer() :
+    CDelimitedFramer(&scmCOBSDelimiter, 1){
+}
+
+bool CCOBSFramer::decode(const CSerialRingBuffer &paBuffer, unsigned int paSize, char *paFrame, unsigned int paFrameCapacity, unsigned int &paFrameSize){
+  unsigned int frameSize = 0;
+  unsigned int i = 0;
+  while(i < paSize){
+    //the code byte is the distance to the next zero byte of the original data
+    unsigned int code = paBuffer[i++];
+    for(unsigned int j = 1; j < code; ++j){
+      if((i == paSize) || (frameSize == paFrameCapacity)){
+        return false;
+      }
+      paFrame[frameSize++] = static_cast<char>(paBuffer[i++]);
+    }
+    if((0xFF != code) && (i < paSize)){
+      if(frameSize == paFrameCapacity){
+        return false;
+      }
+      paFrame[frameSize++] = '\0';
+    }
+  }
+  paFrameSize = frameSize;
+  return true;
+}
+
+CLengthPrefixFramer::CLengthPrefixFramer(unsigned int paPrefixSize) :
+    mPrefixSize(paPrefixSize), mSkip(0){
+}
+
+CSerialFramer::EResult CLengthPrefixFramer::extractFrame(CSerialRingBuffer &paBuffer, char *paFrame, unsigned int paFrameCapacity, unsigned int &paFrameSize){
+  if(0 != mSkip){
+    unsigned int skipNow = (mSkip < paBuffer.size()) ? mSkip : paBuffer.size();
+    paBuffer.consume(skipNow);
+    mSkip -= skipNow;
+    if(0 != mSkip){
+      return eIncomplete;
+    }
+  }
+
+  if(paBuffer.size() < mPrefixSize){
+    return eIncomplete;
+  }
+  unsigned int frameSize = paBuffer[0];
+  if(2 == mPrefixSize){
+    frameSize = (frameSize << 8) | paBuffer[1];
+  }
+
+  if(frameSize > paFrameCapacity){
+    unsigned int available = paBuffer.size() - mPrefixSize;
+    unsigned int skipNow = (frameSize < available) ? frameSize : available;
+    paBuffer.consume(mPrefixSize + skipNow);
+    mSkip = frameSize - skipNow;
+    return eDropped;
+  }
+  if(paBuffer.size() < mPrefixSize + frameSize){
+    return eIncomplete;
+  }
+  paBuffer.consume(mPrefixSize);
+  paBuffer.copyOut(paFrame, frameSize);
+  paBuffer.consume(frameSize);
+  paFrameSize = frameSize;
+  return eFrame;
+}
+
+CIdleLineFramer::CIdleLineFramer(unsigned int paBaudRate) :
+    mIdleTimeout(1750), mFrameEnd(0){
+  if((0 != paBaudRate) && (19200 >= paBaudRate)){
+    //3.5 characters of 11 bits each
+    mIdleTimeout = (38500000 + paBaudRate - 1) / paBaudRate;
+  }
+}
+
+CSerialFramer::EResult CIdleLineFramer::extractFrame(CSerialRingBuffer &paBuffer, char *paFrame, unsigned int paFrameCapacity, unsigned int &paFrameSize){
+  if(0 == mFrameEnd){
+    return eIncomplete;
+  }
+  unsigned int frameSize = mFrameEnd;
+  mFrameEnd = 0;
+  if(frameSize > paFrameCapacity){
+    paBuffer.consume(frameSize);
+    return eDropped;
+  }
+  paBuffer.copyOut(paFrame, frameSize);
+  paBuffer.consume(frameSize);
+  paFrameSize = frameSize;
+  return eFrame;
+}
+
+CSerialFramer::EResult CRawFramer::extractFrame(CSerialRingBuffer &paBuffer, char *paFrame, unsigned int paFrameCapacity, unsigned int &paFrameSize){
+  if(0 == paBuffer.size()){
+    return eIncomplete;
+  }
+  paFrameSize = (paBuffer.size() < paFrameCapacity) ? paBuffer.size() : paFrameCapacity;
+  paBuffer.copyOut(paFrame, paFrameSize);
+  paBuffer.consume(paFrameSize);
+  return eFrame;
+}
@@ -0,0 +1,252 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *    agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#ifndef SERIALFRAMER_H_
+#define SERIALFRAMER_H_
+
+#include <forte_config.h>
+
+namespace forte {
+
+  namespace com_infra {
+
+    /*!\brief Byte ring for the data received on a serial line
+     *
+     * The receiving side reads directly into the free space of the ring, the framers take complete frames from its
+     * beginning. Incomplete frames stay in the ring until the rest of the frame arrived.
+     */
+    class CSerialRingBuffer{
+      public:
+        static const unsigned int scmCapacity = 4096; //!< has to be a power of two
+
+        CSerialRingBuffer() :
+            mStart(0), mSize(0){
+        }
+
+        unsigned int size() const {
+          return mSize;
+        }
+
+        bool isFull() const {
+          return scmCapacity == mSize;
+        }
+
+        //! Byte at the given position counted from the oldest byte in the ring
+        unsigned char operator[](unsigned int paIndex) const {
+          return static_cast<unsigned char>(mData[(mStart + paIndex) & (scmCapacity - 1)]);
+        }
+
+        /*!\brief Contiguous free space behind the newest byte
+         *
+         * @param paSize number of bytes which can be written to the returned space, 0 if the ring is full
+         */
+        char *getFreeSpace(unsigned int &paSize);
+
+        //! Adds paSize bytes written to the space returned by getFreeSpace
+        void commit(unsigned int paSize);
+
+        //! Copies the paSize oldest bytes to paDestination without removing them
+        void copyOut(char *paDestination, unsigned int paSize) const;
+
+        //! Removes the paSize oldest bytes
+        void consume(unsigned int paSize);
+
+        void clear(){
+          mStart = 0;
+          mSize = 0;
+        }
+
+      private:
+        char mData[scmCapacity];
+        unsigned int mStart;
+        unsigned int mSize;
+    };
+
+    /*!\brief Splits the bytes received on a serial line into frames
+     *
+     * A framer is configured with the last parameter of the serial layer:
+     *   - RAW (default): every chunk read from the line is a frame (no framing), as before framing was added
+     *   - LINE: frames end with the termination symbol of the layer
+     *   - LEN1, LEN2: frames start with their length as one or two byte (big endian) prefix
+     *   - RTU: frames end with an idle line of 3.5 character times (Modbus RTU)
+     *   - SLIP: frames are SLIP encoded (RFC 1055)
+     *   - COBS: frames are COBS encoded and end with a zero byte
+     */
+    class CSerialFramer{
+      public:
+        enum EResult{
+          eIncomplete, //!< more bytes are needed for the next frame
+          eFrame, //!< a frame was taken from the buffer
+          eDropped //!< bytes of an invalid or too large frame were removed from the buffer
+        };
+
+        virtual ~CSerialFramer(){
+        }
+
+        /*!\brief Takes the next frame from the beginning of the received bytes
+         *
+         * The bytes belonging to the frame are removed from paBuffer. Framers may keep how far they already scanned
+         * paBuffer, so only bytes may be added to or the frame be taken from it between two calls.
+         *
+         * @param paFrame space for the decoded frame
+         * @param paFrameCapacity size of paFrame, larger frames are dropped
+         * @param paFrameSize size of the decoded frame
+         */
+        virtual EResult extractFrame(CSerialRingBuffer &paBuffer, char *paFrame, unsigned int paFrameCapacity, unsigned int &paFrameSize) = 0;
+
+        //! Time in microseconds without new bytes after which lineIdle has to be called, 0 if the framer does not need it
+        virtual unsigned int getIdleTimeout() const {
+          return 0;
+        }
+
+        //! Informs the framer that no byte was received for the idle timeout
+        virtual void lineIdle(const CSerialRingBuffer &){
+        }
+
+        //! Forgets the scanned part of the buffer, needed after the buffer was cleared
+        virtual void reset(){
+        }
+
+        /*!\brief Creates the framer for the given framing parameter
+         *
+         * @param paFraming framing parameter, empty for the default RAW framing
+         * @param paTerminationSymbol termination symbol used for LINE framing
+         * @param paBaudRate baud rate of the line, needed for the RTU idle timeout
+         * @return the new framer, 0 if paFraming is not known
+         */
+        static CSerialFramer *createFramer(const char *paFraming, const char *paTerminationSymbol, unsigned int paBaudRate);
+    };
+
+    /*!\brief Frames whose end is marked with a delimiter
+     *
+     * Empty frames are skipped. Frames that do not fit into the frame space are dropped up to their delimiter.
+     */
+    class CDelimitedFramer : public CSerialFramer{
+      public:
+        CDelimitedFramer(const char *paDelimiter, unsigned int paDelimiterSize);
+
+        virtual EResult extractFrame(CSerialRingBuffer &paBuffer, char *paFrame, unsigned int paFrameCapacity, unsigned int &paFrameSize);
+
+        virtual void reset(){
+          mScanned = 0;
+          mDiscarding = false;
+        }
+
+      protected:
+        /*!\brief Decodes the paSize oldest bytes of paBuffer into paFrame
+         *
+         * The default copies the bytes.
+         * @return false if the bytes are not a valid frame or do not fit into paFrame
+         */
+        virtual bool decode(const CSerialRingBuffer &paBuffer, unsigned int paSize, char *paFrame, unsigned int paFrameCapacity, unsigned int &paFrameSize);
+
+        //! Maximum number of encoded bytes a frame of paFrameCapacity bytes can have
+        virtual unsigned int getMaxEncodedSize(unsigned int paFrameCapacity) const {
+          return paFrameCapacity;
+        }
+
+      private:
+        //! Position of the delimiter at or after mScanned, paBuffer.size() if there is none
+        unsigned int findDelimiter(const CSerialRingBuffer &paBuffer) const;
+
+        char mDelimiter[2];
+        unsigned int mDelimiterSize;
+        unsigned int mScanned; //!< bytes at the beginning of the buffer known not to contain a delimiter
+        bool mDiscarding; //!< the current frame is too large and is removed up to its delimiter
+    };
+
+    //! SLIP (RFC 1055) encoded frames
+    class CSLIPFramer : public CDelimitedFramer{
+      public:
+        CSLIPFramer();
+
+        static const unsigned char scmEnd = 0xC0;
+        static const unsigned char scmEsc = 0xDB;
+        static const unsigned char scmEscEnd = 0xDC;
+        static const unsigned char scmEscEsc = 0xDD;
+
+      protected:
+        virtual bool decode(const CSerialRingBuffer &paBuffer, unsigned int paSize, char *paFrame, unsigned int paFrameCapacity, unsigned int &paFrameSize);
+
+        virtual unsigned int getMaxEncodedSize(unsigned int paFrameCapacity) const {
+          return 2 * paFrameCapacity;
+        }
+    };
+
+    //! COBS (consistent overhead byte stuffing) encoded frames terminated by a zero byte
+    class CCOBSFramer : public CDelimitedFramer{
+      public:
+        CCOBSFramer();
+
+      protected:
+        virtual bool decode(const CSerialRingBuffer &paBuffer, unsigned int paSize, char *paFrame, unsigned int paFrameCapacity, unsigned int &paFrameSize);
+
+        virtual unsigned int getMaxEncodedSize(unsigned int paFrameCapacity) const {
+          return paFrameCapacity + paFrameCapacity / 254 + 1;
+        }
+    };
+
+    //! Frames prefixed with their length in big endian byte order
+    class CLengthPrefixFramer : public CSerialFramer{
+      public:
+        explicit CLengthPrefixFramer(unsigned int paPrefixSize);
+
+        virtual EResult extractFrame(CSerialRingBuffer &paBuffer, char *paFrame, unsigned int paFrameCapacity, unsigned int &paFrameSize);
+
+        virtual void reset(){
+          mSkip = 0;
+        }
+
+      private:
+        unsigned int mPrefixSize;
+        unsigned int mSkip; //!< bytes of a dropped frame which did not arrive yet
+    };
+
+    /*!\brief Frames separated by an idle line (Modbus RTU)
+     *
+     * A frame ends when no byte was received for 3.5 character times. Above 19200 baud the fixed time of 1750 us is used
+     * as defined by the Modbus over serial line specification.
+     */
+    class CIdleLineFramer : public CSerialFramer{
+      public:
+        explicit CIdleLineFramer(unsigned int paBaudRate);
+
+        virtual EResult extractFrame(CSerialRingBuffer &paBuffer, char *paFrame, unsigned int paFrameCapacity, unsigned int &paFrameSize);
+
+        virtual unsigned int getIdleTimeout() const {
+          return mIdleTimeout;
+        }
+
+        virtual void lineIdle(const CSerialRingBuffer &paBuffer){
+          mFrameEnd = paBuffer.size();
+        }
+
+        virtual void reset(){
+          mFrameEnd = 0;
+        }
+
+      private:
+        unsigned int mIdleTimeout;
+        unsigned int mFrameEnd; //!< size of the complete frame at the beginning of the buffer, 0 if none
+    };
+
+    //! Every chunk of bytes is a frame, the behavior of serial layers without framing
+    class CRawFramer : public CSerialFramer{
+      public:
+        virtual EResult extractFrame(CSerialRingBuffer &paBuffer, char *paFrame, unsigned int paFrameCapacity, unsigned int &paFrameSize);
+    };
+
+  }
+
+}
+
+#endif /* SERIALFRAMER_H_ */
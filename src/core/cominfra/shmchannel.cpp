@@ -0,0 +1,301 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *    agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include "shmchannel.h"
+#include "../../arch/devlog.h"
+#include <forte_thread.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+using namespace forte::com_infra;
+
+#ifndef FORTE_COM_SHM_MODE
+#define FORTE_COM_SHM_MODE 0600
+#endif
+
+namespace {
+  //! size of the header, chosen so that the write count and the slots do not share a cache line
+  const size_t scmHeaderSize = 64;
+  //! Number of 1ms retries while another process is still setting up a segment
+  const unsigned int scmSetupRetries = 100;
+  //! Number of failed attempts to take the write lock after which it is checked whether its owner is still alive
+  const unsigned int scmSpinsPerOwnerCheck = 64;
+
+  long futex(TForteUInt32 *paAddress, int paOperation, TForteUInt32 paValue, const struct timespec *paTimeout){
+    return syscall(SYS_futex, paAddress, paOperation, paValue, paTimeout, 0, 0);
+  }
+}
+
+CShmChannel::CShmChannel(unsigned int paNrOfSlots, unsigned int paSlotSize) :
+    mNrOfSlots(paNrOfSlots), mSlotSize(paSlotSize), mProcessId(0), mHeader(0), mSegmentInode(0){
+  mSegmentName[0] = '\0';
+}
+
+CShmChannel::~CShmChannel(){
+  close();
+}
+
+bool CShmChannel::buildSegmentName(const char *paName, char *paSegmentName){
+  if((0 == paName) || ('\0' == *paName) || (0 != strchr(paName, '/'))){
+    return false;
+  }
+  int nameLength = snprintf(paSegmentName, scmMaxNameLength, "/forte_shm_%s", paName);
+  return ((0 < nameLength) && (static_cast<unsigned int>(nameLength) < scmMaxNameLength));
+}
+
+size_t CShmChannel::getSegmentSize() const {
+  return scmHeaderSize + mNrOfSlots * ((sizeof(SSlotHeader) + mSlotSize + 7) & ~static_cast<size_t>(7));
+}
+
+CShmChannel::SSlotHeader *CShmChannel::getSlot(TForteUInt32 paMessageNr) const {
+  size_t slotStride = (sizeof(SSlotHeader) + mSlotSize + 7) & ~static_cast<size_t>(7);
+  return reinterpret_cast<SSlotHeader*>(reinterpret_cast<TForteByte*>(mHeader) + scmHeaderSize + (paMessageNr % mNrOfSlots) * slotStride);
+}
+
+bool CShmChannel::open(const char *paName){
+  if(isOpen() || (0 == mNrOfSlots) || !buildSegmentName(paName, mSegmentName)){
+    return false;
+  }
+  for(unsigned int i = 0; i < scmSetupRetries; ++i){
+    switch(mapSegment()){
+      case e_Mapped:
+        mProcessId = static_cast<TForteUInt32>(getpid());
+        return true;
+      case e_Failed:
+        return false;
+      default:
+        CThread::sleepThread(1);
+        break;
+    }
+  }
+  DEVLOG_ERROR("[SHM] Shared memory segment %s could not be set up\n", mSegmentName);
+  return false;
+}
+
+CShmChannel::EMapResult CShmChannel::mapSegment(){
+  size_t segmentSize = getSegmentSize();
+  bool created = true;
+  int fd = shm_open(mSegmentName, O_RDWR | O_CREAT | O_EXCL, FORTE_COM_SHM_MODE);
+  if((-1 == fd) && (EEXIST == errno)){
+    created = false;
+    fd = shm_open(mSegmentName, O_RDWR, 0);
+    if((-1 == fd) && (ENOENT == errno)){
+      // removed by its last user in the meantime
+      return e_Retry;
+    }
+  }
+  if(-1 == fd){
+    DEVLOG_ERROR("[SHM] Could not open shared memory segment %s: %s\n", mSegmentName, strerror(errno));
+    return e_Failed;
+  }
+
+  struct stat segmentStat;
+  segmentStat.st_size = 0;
+  if(created){
+    if((0 != ftruncate(fd, static_cast<off_t>(segmentSize))) || (0 != fstat(fd, &segmentStat))){
+      DEVLOG_ERROR("[SHM] Could not size shared memory segment %s: %s\n", mSegmentName, strerror(errno));
+      ::close(fd);
+      shm_unlink(mSegmentName);
+      return e_Failed;
+    }
+  }
+  else{
+    // the creating process may not have sized the segment yet
+    for(unsigned int i = 0; (i < scmSetupRetries) && (0 == fstat(fd, &segmentStat)) && (0 == segmentStat.st_size); ++i){
+      CThread::sleepThread(1);
+    }
+  }
+  mSegmentInode = static_cast<TForteUInt64>(segmentStat.st_ino);
+
+  void *segment = MAP_FAILED;
+  if(static_cast<off_t>(segmentSize) == segmentStat.st_size){
+    segment = mmap(0, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  ::close(fd);
+
+  if(MAP_FAILED == segment){
+    if(created){
+      DEVLOG_ERROR("[SHM] Shared memory segment %s could not be mapped: %s\n", mSegmentName, strerror(errno));
+      shm_unlink(mSegmentName);
+      return e_Failed;
+    }
+    DEVLOG_WARNING("[SHM] Replacing shared memory segment %s with a different size\n", mSegmentName);
+    unlinkSegment(mSegmentInode);
+    return e_Retry;
+  }
+
+  mHeader = static_cast<SHeader*>(segment);
+  if(created){
+    // the segment is zero filled by ftruncate, so only the layout has to be set before publishing it
+    mHeader->mNrOfSlots = mNrOfSlots;
+    mHeader->mSlotSize = mSlotSize;
+    mHeader->mUsers = 1;
+    __atomic_store_n(&mHeader->mMagic, scmMagic, __ATOMIC_RELEASE);
+    return e_Mapped;
+  }
+
+  for(unsigned int i = 0; (i < scmSetupRetries) && (scmMagic != __atomic_load_n(&mHeader->mMagic, __ATOMIC_ACQUIRE)); ++i){
+    CThread::sleepThread(1);
+  }
+  if((scmMagic != __atomic_load_n(&mHeader->mMagic, __ATOMIC_ACQUIRE)) || (mNrOfSlots != mHeader->mNrOfSlots) || (mSlotSize != mHeader->mSlotSize)){
+    DEVLOG_WARNING("[SHM] Replacing shared memory segment %s with an incompatible layout\n", mSegmentName);
+    munmap(mHeader, segmentSize);
+    mHeader = 0;
+    unlinkSegment(mSegmentInode);
+    return e_Retry;
+  }
+  if(0 == __atomic_fetch_add(&mHeader->mUsers, 1, __ATOMIC_ACQ_REL)){
+    // the last user is just removing the segment, or terminated while doing so
+    __atomic_sub_fetch(&mHeader->mUsers, 1, __ATOMIC_ACQ_REL);
+    munmap(mHeader, segmentSize);
+    mHeader = 0;
+    unlinkSegment(mSegmentInode);
+    return e_Retry;
+  }
+  return e_Mapped;
+}
+
+void CShmChannel::unlinkSegment(TForteUInt64 paInode) const {
+  int fd = shm_open(mSegmentName, O_RDONLY, 0);
+  if(-1 != fd){
+    struct stat segmentStat;
+    if((0 == fstat(fd, &segmentStat)) && (paInode == static_cast<TForteUInt64>(segmentStat.st_ino))){
+      shm_unlink(mSegmentName);
+    }
+    ::close(fd);
+  }
+}
+
+void CShmChannel::close(){
+  if(isOpen()){
+    bool lastUser = (0 == __atomic_sub_fetch(&mHeader->mUsers, 1, __ATOMIC_ACQ_REL));
+    munmap(mHeader, getSegmentSize());
+    mHeader = 0;
+    if(lastUser){
+      unlinkSegment(mSegmentInode);
+    }
+  }
+}
+
+void CShmChannel::remove(const char *paName){
+  char segmentName[scmMaxNameLength];
+  if(buildSegmentName(paName, segmentName)){
+    shm_unlink(segmentName);
+  }
+}
+
+TForteUInt32 CShmChannel::getWriteCount() const {
+  return __atomic_load_n(&mHeader->mWriteCount, __ATOMIC_ACQUIRE);
+}
+
+bool CShmChannel::write(const void *paData, unsigned int paSize){
+  if(paSize > mSlotSize){
+    return false;
+  }
+
+  lockWriters();
+
+  TForteUInt32 messageNr = __atomic_load_n(&mHeader->mWriteCount, __ATOMIC_RELAXED);
+  SSlotHeader *slot = getSlot(messageNr);
+  __atomic_store_n(&slot->mSequence, getSequence(messageNr) - 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  memcpy(slot + 1, paData, paSize);
+  __atomic_store_n(&slot->mSize, paSize, __ATOMIC_RELAXED);
+  __atomic_store_n(&slot->mSequence, getSequence(messageNr), __ATOMIC_RELEASE);
+  __atomic_store_n(&mHeader->mWriteCount, messageNr + 1, __ATOMIC_SEQ_CST);
+
+  __atomic_store_n(&mHeader->mWriteLock, 0, __ATOMIC_RELEASE);
+
+  // pairs with the increment of the waiting readers before they check the write count in waitForData
+  if(0 != __atomic_load_n(&mHeader->mWaitingReaders, __ATOMIC_SEQ_CST)){
+    wakeUpReaders();
+  }
+  return true;
+}
+
+void CShmChannel::lockWriters(){
+  unsigned int spins = 0;
+  TForteUInt32 owner = 0;
+  while(!__atomic_compare_exchange_n(&mHeader->mWriteLock, &owner, mProcessId, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)){
+    if((0 == (++spins % scmSpinsPerOwnerCheck)) && (mProcessId != owner) && (-1 == kill(static_cast<pid_t>(owner), 0)) && (ESRCH == errno)){
+      // the owner died while writing, its message is incomplete and gets overwritten as the write count was not advanced
+      if(__atomic_compare_exchange_n(&mHeader->mWriteLock, &owner, mProcessId, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)){
+        DEVLOG_WARNING("[SHM] Write lock of terminated process %u taken over\n", static_cast<unsigned int>(owner));
+        return;
+      }
+    }
+    else{
+      CThread::sleepThread(0);
+    }
+    owner = 0;
+  }
+}
+
+int CShmChannel::read(TForteUInt32 &paReadCount, void *paBuffer, unsigned int paBufferSize, unsigned int &paLost) const {
+  TForteUInt32 writeCount = getWriteCount();
+  while(paReadCount != writeCount){
+    if((writeCount - paReadCount) > mNrOfSlots){
+      paLost += writeCount - mNrOfSlots - paReadCount;
+      paReadCount = writeCount - mNrOfSlots;
+    }
+
+    const SSlotHeader *slot = getSlot(paReadCount);
+    TForteUInt32 sequence = getSequence(paReadCount);
+    if(sequence == __atomic_load_n(&slot->mSequence, __ATOMIC_ACQUIRE)){
+      unsigned int size = __atomic_load_n(&slot->mSize, __ATOMIC_RELAXED);
+      if(size > paBufferSize){
+        size = paBufferSize;
+      }
+      if(size > mSlotSize){
+        size = mSlotSize;
+      }
+      memcpy(paBuffer, slot + 1, size);
+      __atomic_thread_fence(__ATOMIC_ACQUIRE);
+      if(sequence == __atomic_load_n(&slot->mSequence, __ATOMIC_RELAXED)){
+        ++paReadCount;
+        return static_cast<int>(size);
+      }
+    }
+    // a writer has already reused the slot for a newer message
+    ++paLost;
+    ++paReadCount;
+    writeCount = getWriteCount();
+  }
+  return -1;
+}
+
+bool CShmChannel::waitForData(TForteUInt32 paReadCount, unsigned int paTimeoutMs) const {
+  __atomic_add_fetch(&mHeader->mWaitingReaders, 1, __ATOMIC_SEQ_CST);
+  if(paReadCount == __atomic_load_n(&mHeader->mWriteCount, __ATOMIC_SEQ_CST)){
+    struct timespec timeout;
+    timeout.tv_sec = paTimeoutMs / 1000;
+    timeout.tv_nsec = static_cast<long>(paTimeoutMs % 1000) * 1000000L;
+    // returns immediately if a writer changed the write count in the meantime
+    futex(&mHeader->mWriteCount, FUTEX_WAIT, paReadCount, &timeout);
+  }
+  __atomic_sub_fetch(&mHeader->mWaitingReaders, 1, __ATOMIC_SEQ_CST);
+  return (paReadCount != getWriteCount());
+}
+
+void CShmChannel::wakeUpReaders() const {
+  futex(&mHeader->mWriteCount, FUTEX_WAKE, INT_MAX, 0);
+}
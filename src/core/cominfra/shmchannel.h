@@ -0,0 +1,163 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *    agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#ifndef SHMCHANNEL_H_
+#define SHMCHANNEL_H_
+
+#include <forte_config.h>
+#include <datatype.h>
+
+namespace forte {
+
+  namespace com_infra {
+
+    /*!\brief Message channel between processes in a named POSIX shared memory segment
+     *
+     * The segment holds a ring of fixed size slots. Every slot is guarded by a sequence number (seqlock) which is
+     * derived from the number of the message it holds. Writers are serialized by a spin lock in the segment which holds
+     * the process id of its owner, so that the lock of a process terminated while writing is taken over. Readers
+     * never block the writers: each reader keeps its own read count and copies a message out of its slot. If a reader
+     * falls behind by more than the number of slots the overwritten messages are skipped and counted as lost.
+     *
+     * Readers wait for new messages with a futex on the write count, so a writer only issues a system call if a
+     * reader is actually waiting. The futex works across processes as it is placed in the shared segment.
+     */
+    class CShmChannel{
+      public:
+        CShmChannel(unsigned int paNrOfSlots, unsigned int paSlotSize);
+        ~CShmChannel();
+
+        /*!\brief Maps the segment of the channel, it is created if it does not exist yet
+         *
+         * A segment left behind with another layout, e.g., after FORTE_COM_SHM_NR_OF_SLOTS was changed, is replaced
+         * by a new one. New segments are created with the access mode FORTE_COM_SHM_MODE.
+         *
+         * @param paName name of the channel, must not contain a '/'
+         * @return true if the segment could be mapped
+         */
+        bool open(const char *paName);
+
+        //! Unmaps the segment, the last user of a segment removes it
+        void close();
+
+        bool isOpen() const {
+          return (0 != mHeader);
+        }
+
+        /*!\brief Number of messages written to the channel so far
+         *
+         * A reader starting with this count receives only messages written afterwards.
+         */
+        TForteUInt32 getWriteCount() const;
+
+        /*!\brief Appends a message to the channel and wakes up waiting readers
+         *
+         * @return false if the message does not fit into a slot
+         */
+        bool write(const void *paData, unsigned int paSize);
+
+        /*!\brief Copies the next message for a reader
+         *
+         * @param paReadCount number of messages already read by this reader, advanced by the read
+         * @param paBuffer destination of the message
+         * @param paBufferSize size of the destination, larger messages are truncated
+         * @param paLost incremented by the number of messages that were overwritten before they could be read
+         * @return size of the message, -1 if there is no new message
+         */
+        int read(TForteUInt32 &paReadCount, void *paBuffer, unsigned int paBufferSize, unsigned int &paLost) const;
+
+        /*!\brief Waits until messages newer than paReadCount are available
+         *
+         * @param paReadCount number of messages already read by the reader
+         * @param paTimeoutMs maximum time to wait in milliseconds
+         * @return true if there are new messages, false if the time elapsed or the reader was woken up without new
+         *         messages (e.g., by wakeUpReaders or by a wake-up meant for an earlier message)
+         */
+        bool waitForData(TForteUInt32 paReadCount, unsigned int paTimeoutMs) const;
+
+        //! Wakes up all readers waiting on this channel, e.g., to let a reader thread terminate
+        void wakeUpReaders() const;
+
+        //! Removes the segment of a channel, e.g., one left behind by terminated processes. Processes still having it mapped keep using it
+        static void remove(const char *paName);
+
+      private:
+        struct SHeader{
+            TForteUInt32 mMagic;
+            TForteUInt32 mNrOfSlots;
+            TForteUInt32 mSlotSize;
+            //! futex word readers are waiting on
+            TForteUInt32 mWriteCount;
+            TForteUInt32 mWaitingReaders;
+            //! process id of the writer holding the lock, 0 if it is free
+            TForteUInt32 mWriteLock;
+            //! number of channels having the segment open
+            TForteUInt32 mUsers;
+        };
+
+        enum EMapResult{
+          e_Mapped, e_Retry, e_Failed
+        };
+
+        struct SSlotHeader{
+            TForteUInt32 mSequence;
+            TForteUInt32 mSize;
+        };
+
+        static const TForteUInt32 scmMagic = 0x46534843; // "FSHC"
+        static const unsigned int scmMaxNameLength = 64;
+
+        static bool buildSegmentName(const char *paName, char *paSegmentName);
+
+        //! Opens or creates the segment, e_Retry if a stale segment was removed or another process is removing it
+        EMapResult mapSegment();
+
+        //! Removes the segment if its name still refers to the segment with the inode paInode
+        void unlinkSegment(TForteUInt64 paInode) const;
+
+        SSlotHeader *getSlot(TForteUInt32 paMessageNr) const;
+
+        size_t getSegmentSize() const;
+
+        /*!\brief Takes the write lock of the segment
+         *
+         * Spins until the lock is free. If its owner does not exist any more the lock is taken over. Threads of one
+         * process share the process id, so they only spin on each other.
+         */
+        void lockWriters();
+
+        //! Sequence number of a slot once message paMessageNr is completely written
+        static TForteUInt32 getSequence(TForteUInt32 paMessageNr){
+          return 2 * paMessageNr + 2;
+        }
+
+        const unsigned int mNrOfSlots;
+        const unsigned int mSlotSize;
+
+        //! id of the process which opened the channel, channels have to be opened again after a fork
+        TForteUInt32 mProcessId;
+
+        SHeader *mHeader;
+
+        char mSegmentName[scmMaxNameLength];
+        //! inode of the mapped segment, tells it apart from a segment created under the same name after it was removed
+        TForteUInt64 mSegmentInode;
+
+        CShmChannel(const CShmChannel&);
+        CShmChannel& operator=(const CShmChannel&);
+    };
+
+  }
+
+}
+
+#endif /* SHMCHANNEL_H_ */
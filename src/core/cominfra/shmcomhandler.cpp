@@ -0,0 +1,27 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *    agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include "shmcomhandler.h"
+#include "basecommfb.h"
+
+DEFINE_HANDLER(CShmComHandler);
+
+CShmComHandler::CShmComHandler(CDeviceExecution& paDeviceExecution) :
+    CExternalEventHandler(paDeviceExecution){
+}
+
+CShmComHandler::~CShmComHandler(){
+}
+
+void CShmComHandler::notifyReceived(forte::com_infra::CComLayer &paComLayer){
+  startNewEventChain(paComLayer.getCommFB());
+}
@@ -0,0 +1,44 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *    agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#ifndef SHMCOMHANDLER_H_
+#define SHMCOMHANDLER_H_
+
+#include "../extevhan.h"
+#include "comlayer.h"
+
+/*!\brief Starts the event chains of shared memory communication FBs
+ *
+ * The messages are received by the threads of the shared memory layers, this handler only triggers the FBs.
+ */
+class CShmComHandler : public CExternalEventHandler{
+    DECLARE_HANDLER(CShmComHandler)
+  public:
+    void enableHandler(void){
+    }
+
+    void disableHandler(void){
+    }
+
+    void setPriority(int){
+      //currently we are doing nothing here.
+    }
+
+    int getPriority(void) const{
+      return 0;
+    }
+
+    //! Starts the event chain of the FB of a layer which received a message
+    void notifyReceived(forte::com_infra::CComLayer &paComLayer);
+};
+
+#endif /* SHMCOMHANDLER_H_ */
@@ -0,0 +1,173 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *    agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include "shmcomlayer.h"
+#include "shmcomhandler.h"
+#include "fbdkasn1layer.h"
+#include "basecommfb.h"
+#include "../../arch/devlog.h"
+#include <string.h>
+#include <stdio.h>
+
+using namespace forte::com_infra;
+
+namespace {
+  //! Time in ms after which a waiting receive thread checks if it should terminate
+  const unsigned int scmReceiveWaitTime = 100;
+  const unsigned int scmMaxChannelNameLength = 64;
+}
+
+CShmComLayer::CShmComLayer(CComLayer* paUpperLayer, CBaseCommFB* paComFB) :
+    CComLayer(paUpperLayer, paComFB),
+    mSendChannel(FORTE_COM_SHM_NR_OF_SLOTS, cg_unIPLayerRecvBufferSize),
+    mRecvChannel(FORTE_COM_SHM_NR_OF_SLOTS, cg_unIPLayerRecvBufferSize),
+    mReceiveThread(*this),
+    mReadCount(0),
+    mLostMessages(0),
+    mRecvSize(0),
+    mSDs(0),
+    mRDs(0){
+}
+
+CShmComLayer::~CShmComLayer(){
+  closeConnection();
+}
+
+EComResponse CShmComLayer::sendData(void *paData, unsigned int paSize){
+  if(!mSendChannel.isOpen()){
+    return e_ProcessDataNoSocket;
+  }
+
+  if(0 == m_poTopLayer){
+    // we are the top of the stack: paData are the SDs of the FB
+    int serializedSize = CFBDKASN1ComLayer::serializeDataPointArray(mSendBuffer, sizeof(mSendBuffer), mSDs, m_poFb->getNumSD());
+    if(0 > serializedSize){
+      DEVLOG_ERROR("[SHM] Could not serialize the data to be sent\n");
+      return e_ProcessDataDataTypeError;
+    }
+    paData = mSendBuffer;
+    paSize = static_cast<unsigned int>(serializedSize);
+  }
+
+  return (mSendChannel.write(paData, paSize)) ? e_ProcessDataOk : e_ProcessDataSendFailed;
+}
+
+EComResponse CShmComLayer::recvData(const void *, unsigned int){
+  // this is the bottom layer, messages are received by the receive thread
+  return e_Nothing;
+}
+
+EComResponse CShmComLayer::processInterrupt(){
+  EComResponse eRetVal = (0 != m_poTopLayer) ? m_poTopLayer->recvData(mRecvBuffer, mRecvSize) : deserializeRDs();
+  mMessageProcessed.inc();
+  return eRetVal;
+}
+
+EComResponse CShmComLayer::deserializeRDs(){
+  return (CFBDKASN1ComLayer::deserializeDataPointArray(mRecvBuffer, mRecvSize, mRDs, m_poFb->getNumRD())) ? e_ProcessDataOk : e_ProcessDataDataTypeError;
+}
+
+EComResponse CShmComLayer::openConnection(char *paLayerParameter){
+  char sendName[scmMaxChannelNameLength];
+  char recvName[scmMaxChannelNameLength];
+  sendName[0] = '\0';
+  recvName[0] = '\0';
+
+  switch (m_poFb->getComServiceType()){
+    case e_Publisher:
+      snprintf(sendName, sizeof(sendName), "%s", paLayerParameter);
+      break;
+    case e_Subscriber:
+      snprintf(recvName, sizeof(recvName), "%s", paLayerParameter);
+      break;
+    case e_Client:
+      snprintf(sendName, sizeof(sendName), "%s.req", paLayerParameter);
+      snprintf(recvName, sizeof(recvName), "%s.rsp", paLayerParameter);
+      break;
+    case e_Server:
+      snprintf(sendName, sizeof(sendName), "%s.rsp", paLayerParameter);
+      snprintf(recvName, sizeof(recvName), "%s.req", paLayerParameter);
+      break;
+  }
+
+  if((('\0' != sendName[0]) && !mSendChannel.open(sendName)) || (('\0' != recvName[0]) && !mRecvChannel.open(recvName))){
+    closeConnection();
+    return e_InitInvalidId;
+  }
+
+  if(0 == m_poTopLayer){
+    unsigned int numSDs = m_poFb->getNumSD();
+    mSDs = new TConstIEC_ANYPtr[numSDs];
+    for(unsigned int i = 0; i < numSDs; ++i){
+      mSDs[i] = &m_poFb->getSDs()[i];
+    }
+    unsigned int numRDs = m_poFb->getNumRD();
+    mRDs = new TIEC_ANYPtr[numRDs];
+    for(unsigned int i = 0; i < numRDs; ++i){
+      mRDs[i] = &m_poFb->getRDs()[i];
+    }
+  }
+
+  if(mRecvChannel.isOpen()){
+    // only messages written after the FB got initialized are delivered
+    mReadCount = mRecvChannel.getWriteCount();
+    mLostMessages = 0;
+    mMessageProcessed.tryNoWait();
+    mReceiveThread.start();
+  }
+  m_eConnectionState = e_Connected;
+  return e_InitOk;
+}
+
+void CShmComLayer::closeConnection(){
+  if(mRecvChannel.isOpen()){
+    mReceiveThread.stop();
+    mRecvChannel.close();
+  }
+  mSendChannel.close();
+  delete[] mSDs;
+  mSDs = 0;
+  delete[] mRDs;
+  mRDs = 0;
+  m_eConnectionState = e_Disconnected;
+}
+
+bool CShmComLayer::receiveMessage(){
+  int size = mRecvChannel.read(mReadCount, mRecvBuffer, sizeof(mRecvBuffer), mLostMessages);
+  if(0 > size){
+    return false;
+  }
+  mRecvSize = static_cast<unsigned int>(size);
+  m_poFb->interruptCommFB(this);
+  getExtEvHandler<CShmComHandler>().notifyReceived(*this);
+  return true;
+}
+
+void CShmComLayer::CReceiveThread::run(){
+  while(isAlive()){
+    if(mLayer.receiveMessage()){
+      // the receive buffer is in use until the FB processed the message
+      while(isAlive() && !mLayer.mMessageProcessed.timedWait(static_cast<TForteUInt64>(scmReceiveWaitTime) * 1000000ULL)){
+      }
+    }
+    else{
+      mLayer.mRecvChannel.waitForData(mLayer.mReadCount, scmReceiveWaitTime);
+    }
+  }
+}
+
+void CShmComLayer::CReceiveThread::stop(){
+  setAlive(false);
+  mLayer.mRecvChannel.wakeUpReaders();
+  mLayer.mMessageProcessed.inc();
+  end();
+}
@@ -0,0 +1,101 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *    agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#ifndef SHMCOMLAYER_H_
+#define SHMCOMLAYER_H_
+
+#include <forte_config.h>
+#include <forte_thread.h>
+#include <forte_sem.h>
+#include "comlayer.h"
+#include "shmchannel.h"
+
+class CIEC_ANY;
+
+namespace forte {
+
+  namespace com_infra {
+
+    /*!\brief Communication between FORTE instances on the same host via shared memory
+     *
+     * ID format: shm[name]
+     *
+     * Publishers write to the channel name, subscribers read from it. Clients write their requests to the channel
+     * name.req and read the responses from name.rsp, servers the other way around.
+     *
+     * The layer can be used below a serializing layer (e.g., fbdk[].shm[name]) or as the only layer (shm[name]), then
+     * the data is encoded with the FBDK ASN.1 encoding. Each layer receiving data has a thread waiting on its channel.
+     * A message is handed to the FB only after the previous one was processed, messages written in the meantime are
+     * kept in the channel.
+     */
+    class CShmComLayer : public CComLayer{
+      public:
+        CShmComLayer(CComLayer* paUpperLayer, CBaseCommFB* paComFB);
+        virtual ~CShmComLayer();
+
+        EComResponse sendData(void *paData, unsigned int paSize);
+        EComResponse recvData(const void *paData, unsigned int paSize);
+
+        EComResponse processInterrupt();
+
+        //! Number of messages this layer could not read because they were overwritten by newer ones
+        unsigned int getNrOfLostMessages() const {
+          return mLostMessages;
+        }
+
+      private:
+        class CReceiveThread : public CThread{
+          public:
+            explicit CReceiveThread(CShmComLayer &paLayer) :
+                mLayer(paLayer){
+            }
+
+            void stop();
+
+          protected:
+            virtual void run();
+
+          private:
+            CShmComLayer &mLayer;
+        };
+
+        EComResponse openConnection(char *paLayerParameter);
+        void closeConnection();
+
+        //! Called by the receive thread, returns true if a message was handed to the FB
+        bool receiveMessage();
+
+        EComResponse deserializeRDs();
+
+        CShmChannel mSendChannel;
+        CShmChannel mRecvChannel;
+        CReceiveThread mReceiveThread;
+        //! signaled when the FB processed the last received message
+        forte::arch::CSemaphore mMessageProcessed;
+
+        TForteUInt32 mReadCount;
+        unsigned int mLostMessages;
+
+        TForteByte mSendBuffer[cg_unIPLayerRecvBufferSize];
+        TForteByte mRecvBuffer[cg_unIPLayerRecvBufferSize];
+        unsigned int mRecvSize;
+
+        //! Data point arrays used for the encoding if there is no layer above
+        const CIEC_ANY **mSDs;
+        CIEC_ANY **mRDs;
+    };
+
+  }
+
+}
+
+#endif /* SHMCOMLAYER_H_ */
@@ -0,0 +1,129 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *    agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include "udpbatchsender.h"
+#include "../../arch/devlog.h"
+#include <criticalregion.h>
+
+using namespace forte::com_infra;
+
+CUDPBatchSender::CUDPBatchSender() :
+    mFillingBatch(&mBatches[0]),
+    mSocket(CIPComSocketHandler::scmInvalidSocketDescriptor),
+    mNumPublishers(0),
+    mOverflows(0),
+    mSendErrors(0),
+    mNrOfBatches(0){
+  mBatches[0].mNumDatagrams = 0;
+  mBatches[1].mNumDatagrams = 0;
+  memset(mMessages, 0, sizeof(mMessages));
+  for(unsigned int i = 0; i < scmBatchSize; ++i){
+    mMessages[i].msg_hdr.msg_iov = &mIOVecs[i];
+    mMessages[i].msg_hdr.msg_iovlen = 1;
+    mMessages[i].msg_hdr.msg_namelen = sizeof(CIPComSocketHandler::TUDPDestAddr);
+  }
+}
+
+CUDPBatchSender::~CUDPBatchSender(){
+  if(0 != mNumPublishers){
+    mNumPublishers = 1;
+    removePublisher();
+  }
+}
+
+bool CUDPBatchSender::addPublisher(){
+  CCriticalRegion criticalRegion(mSync);
+  if(0 == mNumPublishers){
+    mSocket = socket(PF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if(CIPComSocketHandler::scmInvalidSocketDescriptor == mSocket){
+      DEVLOG_ERROR("CUDPBatchSender: Couldn't create socket: %s\n", strerror(errno));
+      return false;
+    }
+    start();
+  }
+  ++mNumPublishers;
+  return true;
+}
+
+void CUDPBatchSender::removePublisher(){
+  mSync.lock();
+  bool stopSender = (0 != mNumPublishers) && (0 == --mNumPublishers);
+  mSync.unlock();
+
+  if(stopSender){
+    setAlive(false);
+    mDataQueued.inc();
+    end();
+    // datagrams queued after the last send are still delivered
+    mSync.lock();
+    SBatch *lastBatch = mFillingBatch;
+    mSync.unlock();
+    sendBatch(*lastBatch);
+    CIPComSocketHandler::closeSocket(mSocket);
+    mSocket = CIPComSocketHandler::scmInvalidSocketDescriptor;
+  }
+}
+
+bool CUDPBatchSender::queue(const CIPComSocketHandler::TUDPDestAddr &paDestAddr, const char *paData, unsigned int paSize){
+  if(paSize > cg_unIPLayerRecvBufferSize){
+    return false;
+  }
+  bool firstOfBatch;
+  {
+    CCriticalRegion criticalRegion(mSync);
+    if((0 == mNumPublishers) || (scmBatchSize == mFillingBatch->mNumDatagrams)){
+      ++mOverflows;
+      return false;
+    }
+    SDatagram &datagram = mFillingBatch->mDatagrams[mFillingBatch->mNumDatagrams];
+    datagram.mDestAddr = paDestAddr;
+    datagram.mSize = paSize;
+    memcpy(datagram.mData, paData, paSize);
+    firstOfBatch = (0 == mFillingBatch->mNumDatagrams++);
+  }
+  if(firstOfBatch){
+    // the sender is woken up once per batch, datagrams queued until it takes the batch are sent with it
+    mDataQueued.inc();
+  }
+  return true;
+}
+
+void CUDPBatchSender::run(){
+  while(isAlive()){
+    mDataQueued.waitIndefinitely();
+
+    mSync.lock();
+    SBatch *batchToSend = mFillingBatch;
+    mFillingBatch = (batchToSend == &mBatches[0]) ? &mBatches[1] : &mBatches[0];
+    mSync.unlock();
+
+    sendBatch(*batchToSend);
+  }
+}
+
+void CUDPBatchSender::sendBatch(SBatch &paBatch){
+  if(0 == paBatch.mNumDatagrams){
+    return;
+  }
+  for(unsigned int i = 0; i < paBatch.mNumDatagrams; ++i){
+    SDatagram &datagram = paBatch.mDatagrams[i];
+    mMessages[i].msg_hdr.msg_name = &datagram.mDestAddr;
+    mIOVecs[i].iov_base = datagram.mData;
+    mIOVecs[i].iov_len = datagram.mSize;
+  }
+  int nSent = CIPComSocketHandler::sendBatchOnUDP(mSocket, mMessages, paBatch.mNumDatagrams);
+  ++mNrOfBatches;
+  if(nSent < static_cast<int>(paBatch.mNumDatagrams)){
+    mSendErrors += paBatch.mNumDatagrams - ((0 < nSent) ? static_cast<unsigned int>(nSent) : 0);
+  }
+  paBatch.mNumDatagrams = 0;
+}
@@ -0,0 +1,107 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *    agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#ifndef UDPBATCHSENDER_H_
+#define UDPBATCHSENDER_H_
+
+#include <sockhand.h>
+#include <forte_config.h>
+#include <forte_sync.h>
+#include <forte_sem.h>
+#include <forte_thread.h>
+
+namespace forte {
+
+  namespace com_infra {
+
+    /*!\brief Sends the datagrams of all UDP publishers of the process in batches
+     *
+     * Publishers only copy their datagram into the batch currently filled, so the event chain never waits for the
+     * network. The sender thread takes the whole batch and sends it with one system call over its own socket, while the
+     * publishers already fill the other batch. The sender thread is only woken up by the first datagram of a batch.
+     * While it sends one batch all datagrams published in the meantime are collected in the other one and leave with
+     * the next sendmmsg.
+     */
+    class CUDPBatchSender : private CThread{
+      public:
+        static const unsigned int scmBatchSize = FORTE_COM_ETH_UDP_BATCH_SIZE;
+
+        CUDPBatchSender();
+        ~CUDPBatchSender();
+
+        //! Registers a publisher, the sender is running as long as publishers are registered
+        bool addPublisher();
+        void removePublisher();
+
+        /*!\brief Adds a datagram to the current batch
+         *
+         * @return false if the batch is full or the sender is not running, then the caller has to send the datagram itself
+         */
+        bool queue(const CIPComSocketHandler::TUDPDestAddr &paDestAddr, const char *paData, unsigned int paSize);
+
+        //! Number of datagrams which did not fit into a batch
+        unsigned int getNrOfOverflows() const {
+          return mOverflows;
+        }
+
+        //! Number of datagrams the sender could not send
+        unsigned int getNrOfSendErrors() const {
+          return mSendErrors;
+        }
+
+        //! Number of batches sent, i.e., of sendmmsg calls
+        unsigned int getNrOfBatches() const {
+          return mNrOfBatches;
+        }
+
+      protected:
+        virtual void run();
+
+      private:
+        struct SDatagram{
+            CIPComSocketHandler::TUDPDestAddr mDestAddr;
+            unsigned int mSize;
+            char mData[cg_unIPLayerRecvBufferSize];
+        };
+
+        struct SBatch{
+            unsigned int mNumDatagrams;
+            SDatagram mDatagrams[scmBatchSize];
+        };
+
+        void sendBatch(SBatch &paBatch);
+
+        SBatch mBatches[2];
+        //! batch publishers are currently adding to, guarded by mSync
+        SBatch *mFillingBatch;
+
+        struct mmsghdr mMessages[scmBatchSize];
+        struct iovec mIOVecs[scmBatchSize];
+
+        CIPComSocketHandler::TSocketDescriptor mSocket;
+        unsigned int mNumPublishers;
+        unsigned int mOverflows;
+        unsigned int mSendErrors;
+        unsigned int mNrOfBatches;
+
+        CSyncObject mSync;
+        forte::arch::CSemaphore mDataQueued;
+
+        CUDPBatchSender(const CUDPBatchSender&);
+        CUDPBatchSender& operator=(const CUDPBatchSender&);
+    };
+
+  }
+
+}
+
+#endif /* UDPBATCHSENDER_H_ */
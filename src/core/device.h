@@ -9,12 +9,14 @@
  * Contributors:
  *    Alois Zoitl, Gerhard Ebenhofer, Thomas Strasser, Martin Melik Merkumians
  *      - initial implementation and rework communication infrastructure
+ *    agent - history store of the device, delete the FBs before it
  *******************************************************************************/
 #ifndef _DEVICE_H
 #define _DEVICE_H
 
 #include "resource.h"
 #include "devexec.h"
+#include "historystore.h"
 
 /*!\ingroup CORE CDevice represents a device according to IEC 61499. CDevice contains
  - one or more IEC 61499 compliant resources (CResource),
@@ -36,6 +38,8 @@ class CDevice : public CResource {
      */
     CDeviceExecution mDeviceExecution;
 
+    forte::core::CHistoryStore mHistoryStore;
+
   protected:
     virtual void executeEvent(int) {
     }
@@ -50,6 +54,8 @@ class CDevice : public CResource {
     }
 
     virtual ~CDevice() {
+      //the FBs may use the history store until they are deleted, but the base class destructor runs after it is gone
+      deleteContainedFBs();
     }
 
 
@@ -89,6 +95,11 @@ class CDevice : public CResource {
     CTimerHandler& getTimer() const {
       return mDeviceExecution.getTimer();
     }
+
+    //! Retrieve the store keeping the history buffers of the signals of this device
+    forte::core::CHistoryStore &getHistoryStore(void) {
+      return mHistoryStore;
+    }
 };
 
 #endif
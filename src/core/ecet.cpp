@@ -13,6 +13,7 @@
   *      - initial implementation and rework communication infrastructure
   *    zhaoxin
   *      -  fix that external event queue becomes event locker after it is full
+  *    agent - sample the streamed monitoring subscriptions
   *******************************************************************************/
 #include <forte_config.h>
 #include <fortenew.h>
@@ -20,9 +21,16 @@
 #include "esfb.h"
 #include "utils/criticalregion.h"
 #include "../arch/devlog.h"
+#ifdef FORTE_SUPPORT_MONITORING_STREAM
+#include "monitoringstream.h"
+#endif
 
 CEventChainExecutionThread::CEventChainExecutionThread() :
-    CThread(), mSuspendSemaphore(0), mProcessingEvents(false){
+    CThread(), mSuspendSemaphore(0), mProcessingEvents(false)
+#ifdef FORTE_SUPPORT_MONITORING_STREAM
+    , mMonitoringStream(0)
+#endif
+{
   clear();
 }
 
@@ -58,6 +66,12 @@ void CEventChainExecutionThread::mainRun(){
       mEventListStart--;
     }
   }
+#ifdef FORTE_SUPPORT_MONITORING_STREAM
+  forte::core::CMonitoringStream *monitoringStream = mMonitoringStream.load();
+  if(0 != monitoringStream){
+    monitoringStream->capture();
+  }
+#endif
 }
 
 void CEventChainExecutionThread::clear(void){
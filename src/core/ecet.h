@@ -10,16 +10,28 @@
  * Contributors:
  *    Alois Zoitl, Gunnar Grabmaier, Thomas Strasser, Rene Smodic, Ingo Hegny
  *      - initial implementation and rework communication infrastructure
+ *    agent - sample the streamed monitoring subscriptions
  *******************************************************************************/
 #ifndef _ECET_H_
 #define _ECET_H_
 
+#include <forte_config.h>
 #include "event.h"
 #include "datatypes/forte_time.h"
 #include <forte_thread.h>
 #include <forte_sync.h>
 #include <forte_sem.h>
 
+#ifdef FORTE_SUPPORT_MONITORING_STREAM
+#include <forte_atomic.h>
+
+namespace forte {
+  namespace core {
+    class CMonitoringStream;
+  }
+}
+#endif
+
 /*! \ingroup CORE\brief Class for executing one event chain.
  *
  */
@@ -65,6 +77,16 @@ class CEventChainExecutionThread : public CThread{
 
     static CEventChainExecutionThread* createEcet();
 
+#ifdef FORTE_SUPPORT_MONITORING_STREAM
+    /*! Set the monitoring stream whose due subscriptions are sampled after every processed event
+     *
+     * May be called while the thread runs, the stream has to be completely constructed.
+     */
+    void setMonitoringStream(forte::core::CMonitoringStream *paMonitoringStream){
+      mMonitoringStream.store(paMonitoringStream);
+    }
+#endif
+
   protected:
     //@{
     /*! \brief List of input events to deliver.
@@ -136,6 +158,10 @@ class CEventChainExecutionThread : public CThread{
      * TODO consider surrounding the usage points of this flag with #defines such that it is only used for testing.
      */
     bool mProcessingEvents;
+
+#ifdef FORTE_SUPPORT_MONITORING_STREAM
+    forte::arch::CAtomicPointer<forte::core::CMonitoringStream> mMonitoringStream;
+#endif
 };
 
 #endif /*ECET_H_*/
@@ -10,16 +10,21 @@
  * Contributors:
  *    Thomas Strasser, Alois Zoitl,
  *      - initial implementation and rework communication infrastructure
+ *    agent - sealed destination array for the running phase
  *******************************************************************************/
 #include "eventconn.h"
 #include "ecet.h"
 #include "funcbloc.h"
 
 CEventConnection::CEventConnection(CFunctionBlock *paSrcFB, TPortId paSrcPortId) :
-    CConnection(paSrcFB, paSrcPortId){
+    CConnection(paSrcFB, paSrcPortId), mSealedDestinations(0), mNumSealedDestinations(0), mSealed(0){
 }
 
 CEventConnection::~CEventConnection(){
+  delete[] mSealedDestinations;
+  for(CSinglyLinkedList<SEventEntry*>::Iterator it = mRetiredDestinations.begin(); it != mRetiredDestinations.end(); ++it){
+    delete[] *it;
+  }
 }
 
 EMGMResponse CEventConnection::connect(CFunctionBlock *paDstFB, CStringDictionary::TStringId paDstPortNameId){
@@ -27,6 +32,7 @@ EMGMResponse CEventConnection::connect(CFunctionBlock *paDstFB, CStringDictionar
   TPortId nEIID = paDstFB->getEIID(paDstPortNameId);
 
   if(cg_nInvalidEventID != nEIID){
+    unseal();
     retval = CConnection::addDestination(CConnectionPoint(paDstFB, nEIID));
   }
   return retval;
@@ -38,6 +44,7 @@ EMGMResponse CEventConnection::connectToCFBInterface(CFunctionBlock *paDstFB, CS
 
   if(cg_nInvalidEventID != nEOID){
     nEOID |= cgInternal2InterfaceMarker;
+    unseal();
     retval = CConnection::addDestination(CConnectionPoint(paDstFB, nEOID));
   }
   return retval;
@@ -48,6 +55,7 @@ EMGMResponse CEventConnection::disconnect(CFunctionBlock *paDstFB, CStringDictio
   TEventID nEIID = paDstFB->getEIID(paDstPortNameId);
 
   if(cg_nInvalidEventID != nEIID){
+    unseal();
     retval = CConnection::removeDestination(CConnectionPoint(paDstFB, nEIID));
   }
   return retval;
@@ -55,11 +63,50 @@ EMGMResponse CEventConnection::disconnect(CFunctionBlock *paDstFB, CStringDictio
 
 void CEventConnection::triggerEvent(CEventChainExecutionThread *pa_poExecEnv) const {
   if(nullptr != pa_poExecEnv) {
-    for(TDestinationIdList::Iterator it = mDestinationIds.begin();
-        0 != it.getPosition(); ++it){
-      pa_poExecEnv->addEventEntry(&(*it));
+    if(0 != mSealed.load()){
+      for(size_t i = 0; i < mNumSealedDestinations; ++i){
+        pa_poExecEnv->addEventEntry(&mSealedDestinations[i]);
+      }
+    }
+    else{
+      for(TDestinationIdList::Iterator it = mDestinationIds.begin();
+          0 != it.getPosition(); ++it){
+        pa_poExecEnv->addEventEntry(&(*it));
+      }
     }
   }
 }
 
+void CEventConnection::seal(){
+  size_t numDestinations = 0;
+  for(TDestinationIdList::Iterator it = mDestinationIds.begin(); it != mDestinationIds.end(); ++it){
+    ++numDestinations;
+  }
+  bool unchanged = (numDestinations == mNumSealedDestinations);
+  size_t i = 0;
+  for(TDestinationIdList::Iterator it = mDestinationIds.begin(); unchanged && (it != mDestinationIds.end()); ++it){
+    unchanged = (mSealedDestinations[i++] == *it);
+  }
+
+  if(!unchanged){
+    mSealed.store(0);
+    retireSealedDestinations();
+    if(0 != numDestinations){
+      mSealedDestinations = new SEventEntry[numDestinations];
+      i = 0;
+      for(TDestinationIdList::Iterator it = mDestinationIds.begin(); it != mDestinationIds.end(); ++it){
+        mSealedDestinations[i++] = *it;
+      }
+    }
+    mNumSealedDestinations = numDestinations;
+  }
+  mSealed.store(1);
+}
 
+void CEventConnection::retireSealedDestinations(){
+  if(0 != mSealedDestinations){
+    mRetiredDestinations.pushBack(mSealedDestinations);
+    mSealedDestinations = 0;
+  }
+  mNumSealedDestinations = 0;
+}
@@ -10,11 +10,14 @@
  * Contributors:
  *    Thomas Strasser, Alois Zoitl,
  *      - initial implementation and rework communication infrastructure
+ *    agent - sealed destination array for the running phase
  *******************************************************************************/
 #ifndef _EVENCONN_H_
 #define _EVENCONN_H_
 
 #include "conn.h"
+#include "event.h"
+#include <forte_atomic.h>
 
 class CEventChainExecutionThread;
 
@@ -40,6 +43,32 @@ class CEventConnection : public CConnection{
      */
     void triggerEvent(CEventChainExecutionThread *pa_poExecEnv) const;
 
+    /*! \brief Copies the destinations into a contiguous array used by triggerEvent
+     *
+     * Called by the management when the source FB is started. Any change of the destinations unseals the connection
+     * again and triggerEvent falls back to the destination list until the connection is sealed the next time.
+     */
+    void seal();
+
+    bool isSealed() const {
+      return 0 != mSealed.load();
+    }
+
+  private:
+    void unseal(){
+      mSealed.store(0);
+    }
+
+    //! Keeps the current sealed array until the connection is deleted, the execution threads may still have events queued pointing into it
+    void retireSealedDestinations();
+
+    //! copies of the entries of the destination list, the queued events point to these copies
+    SEventEntry *mSealedDestinations;
+    size_t mNumSealedDestinations;
+    //! set after the sealed array has been filled, read by the execution threads
+    forte::arch::CAtomicUInt32 mSealed;
+    //! sealed arrays replaced by a later seal
+    CSinglyLinkedList<SEventEntry*> mRetiredDestinations;
 };
 
 typedef CEventConnection *TEventConnectionPtr;
@@ -12,9 +12,11 @@
  *    Martin Jobst - adapt for LUA integration
  *    Martin Melik Merkumians
  *      - implementation for checkForActionEquivalentState
+ *    agent - delete contained FBs before the owner's members
  *******************************************************************************/
 #include "fbcontainer.h"
 #include "funcbloc.h"
+#include "resource.h"
 
 using namespace forte::core;
 
@@ -38,6 +40,10 @@ CFBContainer::CFBContainer(CStringDictionary::TStringId paContainerName, CFBCont
 }
 
 CFBContainer::~CFBContainer() {
+  deleteContainedFBs();
+}
+
+void CFBContainer::deleteContainedFBs() {
   for (TFunctionBlockList::Iterator itRunner(mFunctionBlocks.begin()); itRunner != mFunctionBlocks.end(); ++itRunner) {
     CTypeLib::deleteFB(*itRunner);
   }
@@ -111,6 +117,10 @@ EMGMResponse CFBContainer::deleteFB(forte::core::TNameIdentifier::CIterator &paN
       while(itRunner != mFunctionBlocks.end()){
         if(fBNameId == (*itRunner)->getInstanceNameId()){
           if((*itRunner)->isCurrentlyDeleteable()){
+#ifdef FORTE_SUPPORT_MONITORING_STREAM
+            //the monitoring stream must not sample the data points of the deleted function block anymore
+            (*itRunner)->getResource().getMonitoringHandler().unsubscribe(**itRunner);
+#endif
             CTypeLib::deleteFB(*itRunner);
             if(itRefNode == mFunctionBlocks.end()){
               //we have the first entry in the list
@@ -10,6 +10,7 @@
  * Contributors:
  *    Alois Zoitl
  *      - initial implementation and rework communication infrastructure
+ *    agent - delete contained FBs before the owner's members
  *******************************************************************************/
 #ifndef _FBCONTAINER_H_
 #define _FBCONTAINER_H_
@@ -80,6 +81,13 @@ namespace forte {
         //! Change the execution state of all contained FBs and also recursively in all contained containers
         EMGMResponse changeContainedFBsExecutionState(EMGMCommandType paCommand);
 
+        /*!\brief Delete all contained FBs and subcontainers
+         *
+         * Called by derived classes whose members are used by the contained FBs until they are deleted, as the
+         * destructor of this class runs after these members are already destroyed.
+         */
+        void deleteContainedFBs();
+
 
         typedef CSinglyLinkedList<CFBContainer *> TFBContainerList;
 
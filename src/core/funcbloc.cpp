@@ -14,6 +14,9 @@
  *    Matthias Plasch
  *      - initial implementation and rework communication infrastructure
  *    Alois Zoitl - introduced new CGenFB class for better handling generic FBs
+ *    agent - sealed WITH lists and event fan-out for the running phase
+ *    agent - hot/cold ordered and cache line aligned FB data
+ *    agent - forced port bitmap for monitoring
  *******************************************************************************/
 #include "funcbloc.h"
 #ifdef FORTE_ENABLE_GENERATED_SOURCE_CPP
@@ -23,19 +26,23 @@
 #include "device.h"
 #include "utils/criticalregion.h"
 #include "../arch/timerha.h"
+#include <fortealloc.h>
 #include <string.h>
 #include <stdlib.h>
 
 CFunctionBlock::CFunctionBlock(CResource *pa_poSrcRes, const SFBInterfaceSpec *pa_pstInterfaceSpec, const CStringDictionary::TStringId pa_nInstanceNameId, TForteByte *pa_acFBConnData, TForteByte *pa_acFBVarsData) :
-   mEOConns(0), m_apoDIConns(0), mDOConns(0),
-   m_poInvokingExecEnv(0), m_apoAdapters(0), m_poResource(pa_poSrcRes), m_aoDIs(0), m_aoDOs(0), m_nFBInstanceName(pa_nInstanceNameId),
+    m_poInvokingExecEnv(0),
     m_enFBState(e_KILLED),   //put the FB in the killed state so that reseting it after creation will correctly initialize it
-    m_bDeletable(true){
-
+    mUseSealedWiths(0), mSealedWiths(0), mSealedWithIndexes(0), mEOConns(0), m_poResource(pa_poSrcRes), m_aoDIs(0), m_aoDOs(0),
+    m_apoDIConns(0), mDOConns(0), m_apoAdapters(0), mWithsSealed(0),
 #ifdef FORTE_SUPPORT_MONITORING
-  mEIMonitorCount = 0;
-  mEOMonitorCount = 0;
+    mEIMonitorCount(0), mEOMonitorCount(0), mForcedPorts(0), mNumForcedPorts(0),
 #endif
+    m_nFBInstanceName(pa_nInstanceNameId), m_bDeletable(true)
+#ifdef FORTE_SUPPORT_MONITORING
+    , mMonitorCountInBlock(false)
+#endif
+    {
 
   setupFBInterface(pa_pstInterfaceSpec, pa_acFBConnData, pa_acFBVarsData);
 }
@@ -44,7 +51,88 @@ CFunctionBlock::~CFunctionBlock(){
   freeAllData();
 }
 
+#if FORTE_FB_ALIGNMENT > 1
+namespace {
+  //! Stored in front of every FB allocated by the new operators of CFunctionBlock
+  struct SFBBlockHeader{
+      TForteUInt32 *mMonitorCount; //!< event monitoring counters behind the FB, 0 if there are none
+      size_t mNrOfMonitorCounts;
+      void *mMemory; //!< start of the allocated memory
+  };
+
+  SFBBlockHeader *getBlockHeader(void *paFB){
+    return static_cast<SFBBlockHeader *>(paFB) - 1;
+  }
+
+  //! Allocates an aligned FB of paSize bytes with paNrOfCounts monitoring counters behind it, 0 if out of memory
+  void *allocateFBBlock(size_t paSize, size_t paNrOfCounts){
+    const size_t countsOffset = (paSize + sizeof(TForteUInt32) - 1) / sizeof(TForteUInt32) * sizeof(TForteUInt32);
+    const size_t overhead = sizeof(SFBBlockHeader) + FORTE_FB_ALIGNMENT - 1;
+    if((paSize > static_cast<size_t>(-1) - overhead) || (paNrOfCounts > (static_cast<size_t>(-1) - overhead - countsOffset) / sizeof(TForteUInt32))){
+      return 0;
+    }
+    TForteByte *memory = static_cast<TForteByte *>(forte_malloc(overhead + countsOffset + paNrOfCounts * sizeof(TForteUInt32)));
+    if(0 == memory){
+      return 0;
+    }
+    TForteByte *fb = memory + sizeof(SFBBlockHeader);
+    fb += (FORTE_FB_ALIGNMENT - reinterpret_cast<size_t>(fb) % FORTE_FB_ALIGNMENT) % FORTE_FB_ALIGNMENT;
+    SFBBlockHeader *header = getBlockHeader(fb);
+    header->mMonitorCount = (0 != paNrOfCounts) ? reinterpret_cast<TForteUInt32 *>(fb + countsOffset) : 0;
+    header->mNrOfMonitorCounts = paNrOfCounts;
+    header->mMemory = memory;
+    return fb;
+  }
+
+#ifdef FORTE_SUPPORT_MONITORING
+  /*! The FB allocated with its monitoring counters whose constructor has not taken them yet. An FB created at the
+   * same time in another thread may replace it, its constructor then allocates the counters on its own.
+   */
+  forte::arch::CAtomicPointer<void> sFBWithMonitorCount;
+#endif
+}
+
+#if __cplusplus >= 201103L
+void *CFunctionBlock::operator new(size_t paSize) noexcept {
+#else
+void *CFunctionBlock::operator new(size_t paSize) throw() {
+#endif
+  return allocateFBBlock(paSize, 0);
+}
+
+void CFunctionBlock::operator delete(void *paFB){
+  if(0 != paFB){
+#ifdef FORTE_SUPPORT_MONITORING
+    //an FB whose constructor did not run must not hand its counters to a later FB at the same address
+    void *expected = paFB;
+    sFBWithMonitorCount.compareExchange(expected, 0);
+#endif
+    forte_free(getBlockHeader(paFB)->mMemory);
+  }
+}
+
+#ifdef FORTE_SUPPORT_MONITORING
+#if __cplusplus >= 201103L
+void *CFunctionBlock::operator new(size_t paSize, const SFBInterfaceSpec &paInterfaceSpec) noexcept {
+#else
+void *CFunctionBlock::operator new(size_t paSize, const SFBInterfaceSpec &paInterfaceSpec) throw() {
+#endif
+  const size_t nrOfCounts = static_cast<size_t>(paInterfaceSpec.m_nNumEIs) + paInterfaceSpec.m_nNumEOs;
+  void *fb = allocateFBBlock(paSize, nrOfCounts);
+  if((0 != fb) && (0 != nrOfCounts)){
+    sFBWithMonitorCount.store(fb);
+  }
+  return fb;
+}
+
+void CFunctionBlock::operator delete(void *paFB, const SFBInterfaceSpec &){
+  CFunctionBlock::operator delete(paFB);
+}
+#endif //FORTE_SUPPORT_MONITORING
+#endif
+
 void CFunctionBlock::freeAllData(){
+  freeSealedWiths();
   if(0 != m_pstInterfaceSpec){
     for(int i = 0; i < m_pstInterfaceSpec->m_nNumEOs; ++i){
       (mEOConns + i)->~CEventConnection();
@@ -65,10 +153,15 @@ void CFunctionBlock::freeAllData(){
   }
 
 #ifdef  FORTE_SUPPORT_MONITORING
-  delete[] mEOMonitorCount;
-  mEOMonitorCount = 0;
-  delete[] mEIMonitorCount;
+  if(!mMonitorCountInBlock){
+    delete[] mEIMonitorCount;
+  }
+  mMonitorCountInBlock = false;
   mEIMonitorCount = 0;
+  mEOMonitorCount = 0;
+  delete[] mForcedPorts;
+  mForcedPorts = 0;
+  mNumForcedPorts = 0;
 #endif //FORTE_SUPPORT_MONITORING
 }
 
@@ -106,6 +199,7 @@ bool CFunctionBlock::connectDI(TPortId paDIPortId, CDataConnection *pa_poDataCon
   if(m_pstInterfaceSpec->m_nNumDIs > paDIPortId){ //catch invalid ID
     if(0 == pa_poDataCon){
       m_apoDIConns[paDIPortId] = 0;
+      setWithsSealed(false);
       bRetVal = true;
     }
     else{
@@ -120,6 +214,7 @@ bool CFunctionBlock::connectDI(TPortId paDIPortId, CDataConnection *pa_poDataCon
         }
       }else{
         m_apoDIConns[paDIPortId] = pa_poDataCon;
+        setWithsSealed(false);
         configureGenericDI(paDIPortId, pa_poDataCon->getValue());
         bRetVal = true;
       }
@@ -241,24 +336,27 @@ TPortId CFunctionBlock::getAdapterPortId(CStringDictionary::TStringId paAdapterN
 void CFunctionBlock::sendOutputEvent(size_t paEO){
   FORTE_TRACE("OutputEvent: Function Block sending event: %d (maxid: %d)\n", paEO, m_pstInterfaceSpec->m_nNumEOs - 1);
   if(paEO < m_pstInterfaceSpec->m_nNumEOs) {
-    if(0 != m_pstInterfaceSpec->m_anEOWithIndexes && -1 != m_pstInterfaceSpec->m_anEOWithIndexes[paEO]) {
+    if(0 != mUseSealedWiths.load()) {
+      const SSealedWith *with = mSealedWiths + mSealedWithIndexes[m_pstInterfaceSpec->m_nNumEIs + paEO];
+      const SSealedWith *const withEnd = mSealedWiths + mSealedWithIndexes[m_pstInterfaceSpec->m_nNumEIs + paEO + 1];
+      if(with != withEnd) {
+        //TODO think on this lock
+        CCriticalRegion criticalRegion(m_poResource->m_oResDataConSync);
+        for(; with != withEnd; ++with) {
+          if(with->mConnection->isConnected()) {
+            with->mConnection->writeData(with->mData);
+          }
+        }
+      }
+    }
+    else if(0 != m_pstInterfaceSpec->m_anEOWithIndexes && -1 != m_pstInterfaceSpec->m_anEOWithIndexes[paEO]) {
       const TDataIOID *eiWithStart = &(m_pstInterfaceSpec->m_anEOWith[m_pstInterfaceSpec->m_anEOWithIndexes[paEO]]);
       //TODO think on this lock
       CCriticalRegion criticalRegion(m_poResource->m_oResDataConSync);
       for(size_t i = 0; eiWithStart[i] != scmWithListDelimiter; ++i) {
         CDataConnection *con = getDOConUnchecked(eiWithStart[i]);
         if(con->isConnected()) {
-          CIEC_ANY *dataOutput = getDO(eiWithStart[i]);
-#ifdef FORTE_SUPPORT_MONITORING
-          if(dataOutput->isForced() != true) {
-#endif //FORTE_SUPPORT_MONITORING
-            con->writeData(dataOutput);
-#ifdef FORTE_SUPPORT_MONITORING
-          } else {
-            //when forcing we write back the value from the connection to keep the forced value on the output
-            con->readData(dataOutput);
-          }
-#endif //FORTE_SUPPORT_MONITORING
+          writeOutputData(m_pstInterfaceSpec->m_nNumDIs + eiWithStart[i], con, getDO(eiWithStart[i]));
         }
       }
     }
@@ -287,21 +385,25 @@ void CFunctionBlock::receiveInputEvent(size_t paEIID, CEventChainExecutionThread
 
   if(e_RUNNING == getState()){
     if(paEIID < m_pstInterfaceSpec->m_nNumEIs) {
-      if(0 != m_pstInterfaceSpec->m_anEIWithIndexes && -1 != m_pstInterfaceSpec->m_anEIWithIndexes[paEIID]) {
+      if(0 != mUseSealedWiths.load()) {
+        const SSealedWith *with = mSealedWiths + mSealedWithIndexes[paEIID];
+        const SSealedWith *const withEnd = mSealedWiths + mSealedWithIndexes[paEIID + 1];
+        if(with != withEnd) {
+          // TODO think on this lock
+          CCriticalRegion criticalRegion(m_poResource->m_oResDataConSync);
+          for(; with != withEnd; ++with) {
+            with->mConnection->readData(with->mData);
+          }
+        }
+      }
+      else if(0 != m_pstInterfaceSpec->m_anEIWithIndexes && -1 != m_pstInterfaceSpec->m_anEIWithIndexes[paEIID]) {
         const TDataIOID *eiWithStart = &(m_pstInterfaceSpec->m_anEIWith[m_pstInterfaceSpec->m_anEIWithIndexes[paEIID]]);
 
         // TODO think on this lock
         CCriticalRegion criticalRegion(m_poResource->m_oResDataConSync);
         for(size_t i = 0; eiWithStart[i] != scmWithListDelimiter; ++i) {
           if(0 != m_apoDIConns[eiWithStart[i]]) {
-            CIEC_ANY *di = getDI(eiWithStart[i]);
-#ifdef FORTE_SUPPORT_MONITORING
-            if(true != di->isForced()) {
-#endif //FORTE_SUPPORT_MONITORING
-              m_apoDIConns[eiWithStart[i]]->readData(di);
-#ifdef FORTE_SUPPORT_MONITORING
-            }
-#endif //FORTE_SUPPORT_MONITORING
+            readInputData(eiWithStart[i], m_apoDIConns[eiWithStart[i]], getDI(eiWithStart[i]));
           }
         }
       }
@@ -320,6 +422,7 @@ EMGMResponse CFunctionBlock::changeFBExecutionState(EMGMCommandType pa_unCommand
   switch (pa_unCommand){
     case cg_nMGM_CMD_Start:
       if((e_IDLE == m_enFBState) || (e_STOPPED == m_enFBState)){
+        sealConnections();
         m_enFBState = e_RUNNING;
         nRetVal = e_RDY;
       }
@@ -358,6 +461,73 @@ EMGMResponse CFunctionBlock::changeFBExecutionState(EMGMCommandType pa_unCommand
   return nRetVal;
 }
 
+void CFunctionBlock::sealConnections(){
+  if(0 != m_pstInterfaceSpec){
+    sealWiths();
+    for(TPortId i = 0; i < m_pstInterfaceSpec->m_nNumEOs; ++i){
+      getEOConUnchecked(i)->seal();
+    }
+  }
+}
+
+void CFunctionBlock::sealWiths(){
+  //the previous arrays are only freed here as an event may still be processed with them after a connection change
+  freeSealedWiths();
+  const unsigned int numEIs = m_pstInterfaceSpec->m_nNumEIs;
+  const unsigned int numEvents = numEIs + m_pstInterfaceSpec->m_nNumEOs;
+  mSealedWithIndexes = new size_t[numEvents + 1];
+  mSealedWiths = new SSealedWith[getNumberOfWiths(m_pstInterfaceSpec->m_anEIWith, m_pstInterfaceSpec->m_anEIWithIndexes, m_pstInterfaceSpec->m_nNumEIs)
+      + getNumberOfWiths(m_pstInterfaceSpec->m_anEOWith, m_pstInterfaceSpec->m_anEOWithIndexes, m_pstInterfaceSpec->m_nNumEOs)];
+
+  size_t pos = 0;
+  for(unsigned int event = 0; event < numEvents; ++event){
+    const bool isEI = (event < numEIs);
+    const TPortId eventId = static_cast<TPortId>(isEI ? event : event - numEIs);
+    const TForteInt16 *withIndexes = (isEI) ? m_pstInterfaceSpec->m_anEIWithIndexes : m_pstInterfaceSpec->m_anEOWithIndexes;
+    mSealedWithIndexes[event] = pos;
+    if(0 != withIndexes && -1 != withIndexes[eventId]){
+      const TDataIOID *with = (isEI) ? &(m_pstInterfaceSpec->m_anEIWith[withIndexes[eventId]]) : &(m_pstInterfaceSpec->m_anEOWith[withIndexes[eventId]]);
+      for(; *with != scmWithListDelimiter; ++with){
+        if(isEI){
+          //unconnected data inputs keep their value, so they don't need an entry
+          if(0 != m_apoDIConns[*with]){
+            mSealedWiths[pos].mData = getDI(*with);
+            mSealedWiths[pos++].mConnection = m_apoDIConns[*with];
+          }
+        }
+        else{
+          mSealedWiths[pos].mData = getDO(*with);
+          mSealedWiths[pos++].mConnection = getDOConUnchecked(*with);
+        }
+      }
+    }
+  }
+  mSealedWithIndexes[numEvents] = pos;
+  setWithsSealed(true);
+}
+
+size_t CFunctionBlock::getNumberOfWiths(const TDataIOID *paWiths, const TForteInt16 *paWithIndexes, unsigned int paNumEvents){
+  size_t retVal = 0;
+  if(0 != paWithIndexes){
+    for(unsigned int i = 0; i < paNumEvents; ++i){
+      if(-1 != paWithIndexes[i]){
+        for(const TDataIOID *with = paWiths + paWithIndexes[i]; *with != scmWithListDelimiter; ++with){
+          ++retVal;
+        }
+      }
+    }
+  }
+  return retVal;
+}
+
+void CFunctionBlock::freeSealedWiths(){
+  setWithsSealed(false);
+  delete[] mSealedWiths;
+  mSealedWiths = 0;
+  delete[] mSealedWithIndexes;
+  mSealedWithIndexes = 0;
+}
+
 CIEC_ANY *CFunctionBlock::createDataPoint(const CStringDictionary::TStringId **pa_panDataTypeIds, TForteByte *pa_acDataBuf){
   CIEC_ANY *poRetVal = CTypeLib::createDataTypeInstance(**pa_panDataTypeIds, pa_acDataBuf);
   ++(*pa_panDataTypeIds);
@@ -452,17 +622,65 @@ TPortId CFunctionBlock::getPortId(CStringDictionary::TStringId pa_unPortNameId,
   return cg_unInvalidPortId;
 }
 
-//********************************** below here are monitoring specific functions **********************************************************
+void CFunctionBlock::setForced(CIEC_ANY *paVar, bool paForced){
+  paVar->setForced(paForced);
+
 #ifdef FORTE_SUPPORT_MONITORING
-void CFunctionBlock::setupEventMonitoringData(){
-  if(0 != m_pstInterfaceSpec->m_nNumEIs){
-    mEIMonitorCount = new TForteUInt32[m_pstInterfaceSpec->m_nNumEIs];
-    memset(mEIMonitorCount, 0, sizeof(TForteUInt32) * m_pstInterfaceSpec->m_nNumEIs);
+  size_t port;
+  if((getDI(0) <= paVar) && (paVar < getDI(m_pstInterfaceSpec->m_nNumDIs))){
+    port = static_cast<size_t>(paVar - getDI(0));
+  }
+  else if((getDO(0) <= paVar) && (paVar < getDO(m_pstInterfaceSpec->m_nNumDOs))){
+    port = m_pstInterfaceSpec->m_nNumDIs + static_cast<size_t>(paVar - getDO(0));
+  }
+  else{
+    //internal variables are not part of any WITH list
+    return;
+  }
+
+  if(0 == mForcedPorts){
+    if(!paForced){
+      return;
+    }
+    const size_t numWords = (m_pstInterfaceSpec->m_nNumDIs + m_pstInterfaceSpec->m_nNumDOs + 31) / 32;
+    mForcedPorts = new TForteUInt32[numWords];
+    memset(mForcedPorts, 0, sizeof(TForteUInt32) * numWords);
   }
 
-  if(0 != m_pstInterfaceSpec->m_nNumEOs){
-    mEOMonitorCount = new TForteUInt32[m_pstInterfaceSpec->m_nNumEOs];
-    memset(mEOMonitorCount, 0, sizeof(TForteUInt32) * m_pstInterfaceSpec->m_nNumEOs);
+  const TForteUInt32 mask = 1U << (port % 32);
+  if(paForced != (0 != (mForcedPorts[port / 32] & mask))){
+    if(paForced){
+      mForcedPorts[port / 32] |= mask;
+      ++mNumForcedPorts;
+    }
+    else{
+      mForcedPorts[port / 32] &= ~mask;
+      --mNumForcedPorts;
+    }
+    setWithsSealed(0 != mWithsSealed.load());
+  }
+#endif //FORTE_SUPPORT_MONITORING
+}
+
+//********************************** below here are monitoring specific functions **********************************************************
+#ifdef FORTE_SUPPORT_MONITORING
+void CFunctionBlock::setupEventMonitoringData(){
+  const unsigned int numEvents = m_pstInterfaceSpec->m_nNumEIs + m_pstInterfaceSpec->m_nNumEOs;
+  if(0 != numEvents){
+#if FORTE_FB_ALIGNMENT > 1
+    //take the counters allocated behind the FB by the type entry, see operator new(size_t, const SFBInterfaceSpec&)
+    void *self = this;
+    if(sFBWithMonitorCount.compareExchange(self, 0) && (getBlockHeader(this)->mNrOfMonitorCounts >= numEvents)){
+      mEIMonitorCount = getBlockHeader(this)->mMonitorCount;
+      mMonitorCountInBlock = true;
+    }
+    else
+#endif
+    {
+      mEIMonitorCount = new TForteUInt32[numEvents];
+    }
+    memset(mEIMonitorCount, 0, sizeof(TForteUInt32) * numEvents);
+    mEOMonitorCount = mEIMonitorCount + m_pstInterfaceSpec->m_nNumEIs;
   }
 }
 
@@ -13,6 +13,8 @@
  *    Stanislav Meduna, Patrick Smejkal,
  *      - initial implementation and rework communication infrastructure
  *    Alois Zoitl - introduced new CGenFB class for better handling generic FBs
+ *    agent - sealed WITH lists and event fan-out for the running phase
+ *    agent - forced port bitmap for monitoring
  *******************************************************************************/
 #ifndef _FUNCBLOC_H_
 #define _FUNCBLOC_H_
@@ -26,6 +28,7 @@
 #include "../arch/devlog.h"
 #include "iec61131_functions.h"
 #include <stringlist.h>
+#include <forte_atomic.h>
 
 class CEventChainExecutionThread;
 class CAdapter;
@@ -57,6 +60,23 @@ namespace forte {
   };
 #endif
 
+#ifndef FORTE_FB_ALIGNMENT  //with this check we can overwrite this define in a platform specific file (e.g., config.h)
+/*! Alignment of dynamically created FBs, by default the size of a cache line.
+ * The FB's data needed for every event and its connection and variable data (see FORTE_FB_DATA_ARRAY) are one block
+ * starting at this alignment. Values below 2 keep the alignment of the normal new operator.
+ */
+#define FORTE_FB_ALIGNMENT 64
+#endif
+
+#if (FORTE_FB_ALIGNMENT > 1) && defined(FORTE_SUPPORT_MONITORING)
+/*! The type entries of FBs with a fixed interface allocate the event monitoring counters in the FB's block, right
+ * behind the FB (see CFunctionBlock::operator new(size_t, const SFBInterfaceSpec&)).
+ */
+#define FORTE_NEW_FIRMWARE_FB(fbclass) new(fbclass::scm_stFBInterfaceSpec) fbclass
+#else
+#define FORTE_NEW_FIRMWARE_FB(fbclass) new fbclass
+#endif
+
 typedef CAdapter *TAdapterPtr;
 
 typedef TForteUInt8 TDataIOID; //!< \ingroup CORE Type for holding an data In- or output ID (max value 254)
@@ -104,6 +124,34 @@ class CFunctionBlock {
   public:
     const static TDataIOID scmWithListDelimiter = cg_unInvalidPortId; //!< value identifying the end of a with list
 
+#if FORTE_FB_ALIGNMENT > 1
+    /*!\brief Allocates the FB aligned to FORTE_FB_ALIGNMENT
+     *
+     * Like the global new of FORTE it returns 0 if there is not enough memory. It is declared not to throw, so that the
+     * FB is only constructed if the allocation succeeded.
+     */
+#if __cplusplus >= 201103L
+    static void *operator new(size_t paSize) noexcept;
+#else
+    static void *operator new(size_t paSize) throw();
+#endif
+    static void operator delete(void *paFB);
+
+#ifdef FORTE_SUPPORT_MONITORING
+    /*!\brief Allocates the FB aligned to FORTE_FB_ALIGNMENT with the event monitoring counters of the interface behind it
+     *
+     * Used by the type entries through FORTE_NEW_FIRMWARE_FB. The constructor of the FB takes the counters from the
+     * block instead of allocating them, if the FB's interface has not more events than paInterfaceSpec.
+     */
+#if __cplusplus >= 201103L
+    static void *operator new(size_t paSize, const SFBInterfaceSpec &paInterfaceSpec) noexcept;
+#else
+    static void *operator new(size_t paSize, const SFBInterfaceSpec &paInterfaceSpec) throw();
+#endif
+    static void operator delete(void *paFB, const SFBInterfaceSpec &paInterfaceSpec);
+#endif //FORTE_SUPPORT_MONITORING
+#endif
+
     /*!\brief Possible states of a runable object.
      *
      */
@@ -231,6 +279,15 @@ class CFunctionBlock {
      */
     virtual CIEC_ANY* getVar(CStringDictionary::TStringId *paNameList, unsigned int paNameListSize);
 
+    /*!\brief Sets or clears the forced flag of a variable of this FB
+     *
+     * Forcing only has an effect with FORTE_SUPPORT_MONITORING. Forced data inputs and outputs are additionally recorded
+     * in a bitmap of the FB. The data copies of the WITH lists only check for forced values while at least one port of
+     * the FB is forced.
+     * @param paVar variable of this FB as returned by getVar
+     */
+    void setForced(CIEC_ANY *paVar, bool paForced);
+
     /*!\brief Get the pointer to the adapter instance of the FB.
      *
      * \param pa_uAdapterNameId  StringId of the adapter name.
@@ -401,6 +458,14 @@ class CFunctionBlock {
 
     void setupAdapters(const SFBInterfaceSpec *pa_pstInterfaceSpec, TForteByte *pa_acFBData);
 
+    /*!\brief Compacts the connections used while the FB is running into contiguous arrays
+     *
+     * Invoked when the FB is started. The WITH lists are resolved into arrays of data point and connection pairs and the
+     * event output connections copy their destinations into an array. Connection changes fall back to the unsealed
+     * lists until the FB is started the next time. FBs with further connections (e.g., CFBs) have to seal them as well.
+     */
+    virtual void sealConnections();
+
     CEventConnection* getEOConUnchecked(TPortId paEONum) const {
       return (mEOConns + paEONum);
     }
@@ -429,15 +494,68 @@ class CFunctionBlock {
 
     void freeAllData();
 
+    /* The data members are ordered by their use: the ones needed for every event come first so that they share the
+     * first cache lines of the FB (see FORTE_FB_ALIGNMENT), the management data follows at the end.
+     */
     const SFBInterfaceSpec *m_pstInterfaceSpec; //!< Pointer to the interface specification
+    CEventChainExecutionThread *m_poInvokingExecEnv; //!< A pointer to the execution thread that invoked the FB. This value is stored here to reduce function parameters and reduce therefore stack usage.
+
+  private:
+    //! One data copy of a sealed WITH list
+    struct SSealedWith;
+
+    /*!\brief Current state of the runnable object.
+     *
+     */
+    E_FBStates m_enFBState;
+    forte::arch::CAtomicUInt32 mUseSealedWiths; //!< the WITH lists are sealed and no data port is forced, the plain data copies can be used, set by the management and read by the execution thread
+    /*! The WITH lists of all event inputs followed by those of all event outputs. For event inputs only the connected
+     * data inputs are contained, data outputs are checked for being connected when the event is sent.
+     */
+    SSealedWith *mSealedWiths;
+    size_t *mSealedWithIndexes; //!< start of each event's WITH list in mSealedWiths, one more entry for the end of the last
+
+  protected:
     CEventConnection *mEOConns; //!< A list of event connections pointers storing for each event output the event connection. If the output event is not connected the pointer is 0.
+
+  private:
+    CResource *m_poResource; //!< A pointer to the resource containing the function block.
+    CIEC_ANY *m_aoDIs; //!< A list of pointers to the data inputs. This allows to implement a general getDataInput()
+    CIEC_ANY *m_aoDOs; //!< A list of pointers to the data outputs. This allows to implement a general getDataOutput()
+
+  protected:
     TDataConnectionPtr *m_apoDIConns; //!< A list of data connections pointers storing for each data input the data connection. If the data input is not connected the pointer is 0.
     CDataConnection *mDOConns; //!< A list of data connections pointers storing for each data output the data connection. If the data output is not connected the pointer is 0.
-    CEventChainExecutionThread *m_poInvokingExecEnv; //!< A pointer to the execution thread that invoked the FB. This value is stored here to reduce function parameters and reduce therefore stack usage.
+
     CAdapter **m_apoAdapters; //!< A list of pointers to the adapters. This allows to implement a general getAdapter().
     TFunctionBlockPtr *mInternalFBs;
 
   private:
+    forte::arch::CAtomicUInt32 mWithsSealed; //!< mSealedWiths reflects the current data input connections
+
+#ifdef FORTE_SUPPORT_MONITORING
+    // monitoring stuff, the event input counters followed by the event output counters, in the FB's block or one allocation
+    TForteUInt32 *mEIMonitorCount;
+    TForteUInt32 *mEOMonitorCount;
+    //! bit for each data input followed by a bit for each data output telling if the port is forced, allocated on first force
+    TForteUInt32 *mForcedPorts;
+    unsigned int mNumForcedPorts;
+#endif
+
+    //! the instance name of the object
+    CStringDictionary::TStringId m_nFBInstanceName;
+
+    /*!\brief Attribute defines if runnable object can be deleted by a management command.
+     *
+     * Default value is set to true.
+     * If the runnable object is declared in a device or resource specification it must be set to false.
+     */
+    bool m_bDeletable;
+
+#ifdef FORTE_SUPPORT_MONITORING
+    bool mMonitorCountInBlock; //!< mEIMonitorCount lies in the FB's block and is freed with it
+#endif
+
     /*!\brief Function providing the functionality of the FB (e.g. execute ECC for basic FBs).
      *
      * \param pa_nEIID Event input ID where event occurred.
@@ -459,32 +577,60 @@ class CFunctionBlock {
 
     void configureGenericDI(TPortId paDIPortId, const CIEC_ANY *paRefValue);
 
-    CResource *m_poResource; //!< A pointer to the resource containing the function block.
-    CIEC_ANY *m_aoDIs; //!< A list of pointers to the data inputs. This allows to implement a general getDataInput()
-    CIEC_ANY *m_aoDOs; //!< A list of pointers to the data outputs. This allows to implement a general getDataOutput()
+    struct SSealedWith{
+      CIEC_ANY *mData;
+      CDataConnection *mConnection;
+    };
 
-#ifdef FORTE_SUPPORT_MONITORING
-    void setupEventMonitoringData();
+    void sealWiths();
+    void freeSealedWiths();
+    //! Number of entries of all WITH lists of the given events
+    static size_t getNumberOfWiths(const TDataIOID *paWiths, const TForteInt16 *paWithIndexes, unsigned int paNumEvents);
 
-    // monitoring stuff
-    TForteUInt32 *mEOMonitorCount;
-    TForteUInt32 *mEIMonitorCount;
+    void setWithsSealed(bool paSealed){
+      mWithsSealed.store(paSealed ? 1 : 0);
+#ifdef FORTE_SUPPORT_MONITORING
+      mUseSealedWiths.store((paSealed && (0 == mNumForcedPorts)) ? 1 : 0);
+#else
+      mUseSealedWiths.store(paSealed ? 1 : 0);
 #endif
+    }
 
-    //! the instance name of the object
-    CStringDictionary::TStringId m_nFBInstanceName;
+    //! Data copy for a WITH list entry while ports may be forced, paPort is the DI number or the DO number after all DIs
+    void readInputData(size_t paPort, const CDataConnection *paConnection, CIEC_ANY *paDI) const {
+#ifdef FORTE_SUPPORT_MONITORING
+      if(!isPortForced(paPort)) {
+#endif //FORTE_SUPPORT_MONITORING
+        paConnection->readData(paDI);
+#ifdef FORTE_SUPPORT_MONITORING
+      }
+#else
+      (void) paPort;
+#endif //FORTE_SUPPORT_MONITORING
+    }
 
-    /*!\brief Current state of the runnable object.
-     *
-     */
-    E_FBStates m_enFBState;
+    void writeOutputData(size_t paPort, CDataConnection *paConnection, CIEC_ANY *paDO) const {
+#ifdef FORTE_SUPPORT_MONITORING
+      if(!isPortForced(paPort)) {
+#endif //FORTE_SUPPORT_MONITORING
+        paConnection->writeData(paDO);
+#ifdef FORTE_SUPPORT_MONITORING
+      } else {
+        //when forcing we write back the value from the connection to keep the forced value on the output
+        paConnection->readData(paDO);
+      }
+#else
+      (void) paPort;
+#endif //FORTE_SUPPORT_MONITORING
+    }
 
-    /*!\brief Attribute defines if runnable object can be deleted by a management command.
-     *
-     * Default value is set to true.
-     * If the runnable object is declared in a device or resource specification it must be set to false.
-     */
-    bool m_bDeletable;
+#ifdef FORTE_SUPPORT_MONITORING
+    void setupEventMonitoringData();
+
+    bool isPortForced(size_t paPort) const {
+      return (0 != mNumForcedPorts) && (0 != (mForcedPorts[paPort / 32] & (1U << (paPort % 32))));
+    }
+#endif
 
     //FIXME remove these friends
     friend class CAdapter;
@@ -14,6 +14,7 @@
 #define _GENFB_H_
 
 #include "funcbloc.h"
+#include "genfbspeccache.h"
 
 template <class T>
 class CGenFunctionBlock : public T {
@@ -40,6 +41,19 @@ class CGenFunctionBlock : public T {
         CStringDictionary::TStringId* paDataTypeNamesArrayStart,
         CStringDictionary::TStringId* paNamesArrayStart, size_t paNumGenericDataPoints);
 
+    /*! \brief Get the function for freeing an interface specification which is shared between instances
+     *
+     * Generic FBs whose interface specification only depends on the configuration string can return here the function
+     * freeing the arrays allocated in createInterfaceSpec. The interface specification is then only created for the first
+     * instance of a configured type name and shared with all further instances via the CGenFBInterfaceSpecCache.
+     * Such FBs must not free the interface arrays themselves and must not store any instance state in createInterfaceSpec.
+     *
+     * @retval 0 if each instance needs its own interface specification (default)
+     */
+    virtual CGenFBInterfaceSpecCache::TReleaseInterfaceSpecFunc getSharedInterfaceSpecReleaseFunc() const {
+      return 0;
+    }
+
   private:
     /*! \brief parse the config string and generate the according interface specification
      *
@@ -59,6 +73,7 @@ class CGenFunctionBlock : public T {
 
     CStringDictionary::TStringId mConfiguredFBTypeNameId;
     SFBInterfaceSpec mGenInterfaceSpec;  //!< the interface spec for this specific instance of generic FB
+    bool mSharedInterfaceSpec; //!< true if the interface spec is owned by the CGenFBInterfaceSpecCache
     TForteByte *mFBConnData;
     TForteByte *mFBVarsData;
 };
@@ -17,7 +17,7 @@
 template<class T>
 CGenFunctionBlock<T>::CGenFunctionBlock(CResource *paSrcRes, const CStringDictionary::TStringId paInstanceNameId) :
     T(paSrcRes, 0, paInstanceNameId, 0, 0),
-    mConfiguredFBTypeNameId(CStringDictionary::scm_nInvalidStringId), mGenInterfaceSpec(), mFBConnData(0), mFBVarsData(0) {
+    mConfiguredFBTypeNameId(CStringDictionary::scm_nInvalidStringId), mGenInterfaceSpec(), mSharedInterfaceSpec(false), mFBConnData(0), mFBVarsData(0) {
 
     FORTE_STATIC_ASSERT((forte::core::mpl::is_base_of<CFunctionBlock, T>::value), TFunctionBlock);
 }
@@ -28,6 +28,9 @@ CGenFunctionBlock<T>::~CGenFunctionBlock(){
     T::freeAllData();  //clean the interface and connections first.
     delete[] mFBConnData;
     delete[] mFBVarsData;
+    if(mSharedInterfaceSpec){
+      CGenFBInterfaceSpecCache::getInstance().release(mConfiguredFBTypeNameId);
+    }
     T::m_pstInterfaceSpec = 0; //this stops the base classes from any wrong clean-up
   }
 }
@@ -35,13 +38,26 @@ CGenFunctionBlock<T>::~CGenFunctionBlock(){
 template<class T>
 bool CGenFunctionBlock<T>::configureFB(const char *paConfigString){
   setConfiguredTypeNameId(CStringDictionary::getInstance().insert(paConfigString));
-  if(createInterfaceSpec(paConfigString, mGenInterfaceSpec)){
-    mFBConnData = new TForteByte[T::genFBConnDataSize(mGenInterfaceSpec.m_nNumEOs, mGenInterfaceSpec.m_nNumDIs, mGenInterfaceSpec.m_nNumDOs)];
-    mFBVarsData = new TForteByte[T::genFBVarsDataSize(mGenInterfaceSpec.m_nNumDIs, mGenInterfaceSpec.m_nNumDOs)];
-    T::setupFBInterface(&mGenInterfaceSpec, mFBConnData, mFBVarsData);
-    return true;
+  CGenFBInterfaceSpecCache::TReleaseInterfaceSpecFunc releaseFunc = getSharedInterfaceSpecReleaseFunc();
+  const SFBInterfaceSpec *interfaceSpec = 0;
+
+  if(0 != releaseFunc){
+    interfaceSpec = CGenFBInterfaceSpecCache::getInstance().acquire(mConfiguredFBTypeNameId);
+  }
+
+  if(0 == interfaceSpec){
+    if(!createInterfaceSpec(paConfigString, mGenInterfaceSpec)){
+      return false;
+    }
+    interfaceSpec = (0 != releaseFunc) ?
+        CGenFBInterfaceSpecCache::getInstance().add(mConfiguredFBTypeNameId, mGenInterfaceSpec, releaseFunc) : &mGenInterfaceSpec;
   }
-  return false;
+  mSharedInterfaceSpec = (0 != releaseFunc);
+
+  mFBConnData = new TForteByte[T::genFBConnDataSize(interfaceSpec->m_nNumEOs, interfaceSpec->m_nNumDIs, interfaceSpec->m_nNumDOs)];
+  mFBVarsData = new TForteByte[T::genFBVarsDataSize(interfaceSpec->m_nNumDIs, interfaceSpec->m_nNumDOs)];
+  T::setupFBInterface(interfaceSpec, mFBConnData, mFBVarsData);
+  return true;
 }
 
 template<class T>
@@ -0,0 +1,138 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *    agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include "genfbspeccache.h"
+#include "utils/criticalregion.h"
+#include <fortenew.h>
+#include <devlog.h>
+
+DEFINE_SINGLETON(CGenFBInterfaceSpecCache)
+
+CGenFBInterfaceSpecCache::CGenFBInterfaceSpecCache(){
+}
+
+CGenFBInterfaceSpecCache::~CGenFBInterfaceSpecCache(){
+  for(TCacheEntryList::Iterator it = mEntries.begin(); it != mEntries.end(); ++it){
+    (*it)->mReleaseFunc((*it)->mInterfaceSpec);
+    delete *it;
+  }
+  mEntries.clearAll();
+}
+
+const SFBInterfaceSpec *CGenFBInterfaceSpecCache::acquire(CStringDictionary::TStringId paTypeNameId){
+  CCriticalRegion criticalRegion(mSync);
+  SCacheEntry *entry = findEntry(paTypeNameId);
+  if(0 != entry){
+    entry->mRefCount++;
+    return &entry->mInterfaceSpec;
+  }
+  return 0;
+}
+
+const SFBInterfaceSpec *CGenFBInterfaceSpecCache::add(CStringDictionary::TStringId paTypeNameId, const SFBInterfaceSpec &paInterfaceSpec,
+    TReleaseInterfaceSpecFunc paReleaseFunc){
+  CCriticalRegion criticalRegion(mSync);
+  SCacheEntry *entry = findEntry(paTypeNameId);
+  if(0 == entry){
+    entry = new SCacheEntry;
+    entry->mTypeNameId = paTypeNameId;
+    entry->mInterfaceSpec = paInterfaceSpec;
+    entry->mReleaseFunc = paReleaseFunc;
+    entry->mRefCount = 0;
+    mEntries.pushBack(entry);
+  }
+  else{
+    //an other instance of the same type was faster, drop our copy and use the existing one
+    SFBInterfaceSpec duplicate = paInterfaceSpec;
+    paReleaseFunc(duplicate);
+  }
+  entry->mRefCount++;
+  return &entry->mInterfaceSpec;
+}
+
+void CGenFBInterfaceSpecCache::release(CStringDictionary::TStringId paTypeNameId){
+  CCriticalRegion criticalRegion(mSync);
+  SCacheEntry *entry = findEntry(paTypeNameId);
+  if(0 != entry){
+    entry->mRefCount--;
+    if(0 == entry->mRefCount){
+      mEntries.erase(entry);
+      entry->mReleaseFunc(entry->mInterfaceSpec);
+      delete entry;
+    }
+  }
+  else{
+    DEVLOG_ERROR("[CGenFBInterfaceSpecCache]: Releasing interface spec of type %s which is not in the cache\n",
+      CStringDictionary::getInstance().get(paTypeNameId));
+  }
+}
+
+size_t CGenFBInterfaceSpecCache::getNumberOfEntries(){
+  CCriticalRegion criticalRegion(mSync);
+  size_t retVal = 0;
+  for(TCacheEntryList::Iterator it = mEntries.begin(); it != mEntries.end(); ++it){
+    retVal++;
+  }
+  return retVal;
+}
+
+size_t CGenFBInterfaceSpecCache::getNumberOfUsers(){
+  CCriticalRegion criticalRegion(mSync);
+  size_t retVal = 0;
+  for(TCacheEntryList::Iterator it = mEntries.begin(); it != mEntries.end(); ++it){
+    retVal += (*it)->mRefCount;
+  }
+  return retVal;
+}
+
+size_t CGenFBInterfaceSpecCache::getSavedMemory(){
+  CCriticalRegion criticalRegion(mSync);
+  size_t retVal = 0;
+  for(TCacheEntryList::Iterator it = mEntries.begin(); it != mEntries.end(); ++it){
+    retVal += ((*it)->mRefCount - 1) * getInterfaceArraysSize((*it)->mInterfaceSpec);
+  }
+  return retVal;
+}
+
+size_t CGenFBInterfaceSpecCache::getInterfaceArraysSize(const SFBInterfaceSpec &paInterfaceSpec){
+  size_t retVal = (paInterfaceSpec.m_nNumEIs + paInterfaceSpec.m_nNumEOs) * sizeof(CStringDictionary::TStringId);
+  retVal += 2 * (paInterfaceSpec.m_nNumDIs + paInterfaceSpec.m_nNumDOs) * sizeof(CStringDictionary::TStringId);
+  retVal += getWithListSize(paInterfaceSpec.m_anEIWith, paInterfaceSpec.m_anEIWithIndexes, paInterfaceSpec.m_nNumEIs);
+  retVal += getWithListSize(paInterfaceSpec.m_anEOWith, paInterfaceSpec.m_anEOWithIndexes, paInterfaceSpec.m_nNumEOs);
+  return retVal;
+}
+
+CGenFBInterfaceSpecCache::SCacheEntry *CGenFBInterfaceSpecCache::findEntry(CStringDictionary::TStringId paTypeNameId){
+  for(TCacheEntryList::Iterator it = mEntries.begin(); it != mEntries.end(); ++it){
+    if((*it)->mTypeNameId == paTypeNameId){
+      return *it;
+    }
+  }
+  return 0;
+}
+
+size_t CGenFBInterfaceSpecCache::getWithListSize(const TDataIOID *paWith, const TForteInt16 *paWithIndexes, size_t paNumEvents){
+  size_t retVal = 0;
+  if(0 != paWith && 0 != paWithIndexes){
+    for(size_t i = 0; i < paNumEvents; ++i){
+      if(-1 != paWithIndexes[i]){
+        const TDataIOID *runner = &paWith[paWithIndexes[i]];
+        while(CFunctionBlock::scmWithListDelimiter != *runner){
+          ++runner;
+          retVal++;
+        }
+        retVal++; //the delimiter
+      }
+    }
+  }
+  return retVal * sizeof(TDataIOID);
+}
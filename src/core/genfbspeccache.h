@@ -0,0 +1,93 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *    agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#ifndef _GENFBSPECCACHE_H_
+#define _GENFBSPECCACHE_H_
+
+#include "funcbloc.h"
+#include "fortelist.h"
+#include "utils/singlet.h"
+#include <forte_sync.h>
+
+/*!\ingroup CORE\brief Type level cache for the interface specifications of generic function blocks
+ *
+ * Generic FBs (e.g., PUBLISH_3, E_MUX_4) create their interface specification from the configuration
+ * string. As long as the interface specification only depends on the configuration string it can be
+ * created once and shared between all instances configured with the same type name. The cache keeps
+ * one reference counted entry per configured type name and frees the interface arrays with the
+ * release function provided by the generic FB when the last instance is deleted.
+ */
+class CGenFBInterfaceSpecCache {
+  DECLARE_SINGLETON(CGenFBInterfaceSpecCache)
+
+  public:
+    //! Function freeing all dynamically allocated arrays of an interface specification
+    typedef void (*TReleaseInterfaceSpecFunc)(SFBInterfaceSpec &paInterfaceSpec);
+
+    /*!\brief Get the shared interface specification of the given generic type and increase its reference count
+     *
+     * @param paTypeNameId configured type name of the generic FB (e.g., PUBLISH_3)
+     * @return the shared interface specification or 0 if no instance of this type exists
+     */
+    const SFBInterfaceSpec *acquire(CStringDictionary::TStringId paTypeNameId);
+
+    /*!\brief Hand a newly created interface specification over to the cache
+     *
+     * The cache takes the ownership of the arrays referenced in the interface specification. If in the meantime an
+     * other instance has added a specification for the same type name the given one is released and the already
+     * stored one is used.
+     *
+     * @param paTypeNameId configured type name of the generic FB
+     * @param paInterfaceSpec the interface specification created by the generic FB
+     * @param paReleaseFunc function to be used for freeing the arrays of the interface specification
+     * @return the shared interface specification with its reference count increased
+     */
+    const SFBInterfaceSpec *add(CStringDictionary::TStringId paTypeNameId, const SFBInterfaceSpec &paInterfaceSpec,
+        TReleaseInterfaceSpecFunc paReleaseFunc);
+
+    /*!\brief Decrease the reference count of the given type and free the interface specification if it is not used anymore
+     */
+    void release(CStringDictionary::TStringId paTypeNameId);
+
+    //! Number of different generic types currently held in the cache
+    size_t getNumberOfEntries();
+
+    //! Number of FB instances currently using a shared interface specification
+    size_t getNumberOfUsers();
+
+    /*!\brief Memory in bytes which would be additionally needed if every instance would have its own interface arrays
+     */
+    size_t getSavedMemory();
+
+    /*!\brief Size in bytes of the name, type, and with arrays of an interface specification
+     */
+    static size_t getInterfaceArraysSize(const SFBInterfaceSpec &paInterfaceSpec);
+
+  private:
+    struct SCacheEntry {
+        CStringDictionary::TStringId mTypeNameId;
+        SFBInterfaceSpec mInterfaceSpec;
+        TReleaseInterfaceSpecFunc mReleaseFunc;
+        size_t mRefCount;
+    };
+
+    typedef CSinglyLinkedList<SCacheEntry *> TCacheEntryList;
+
+    SCacheEntry *findEntry(CStringDictionary::TStringId paTypeNameId);
+
+    static size_t getWithListSize(const TDataIOID *paWith, const TForteInt16 *paWithIndexes, size_t paNumEvents);
+
+    TCacheEntryList mEntries;
+    CSyncObject mSync;
+};
+
+#endif /* _GENFBSPECCACHE_H_ */
@@ -0,0 +1,362 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include "historystore.h"
+#include "utils/criticalregion.h"
+#include "utils/string_utils.h"
+#include <forte_architecture_time.h>
+#include <forte_printer.h>
+#include <float.h>
+#include <string.h>
+
+using namespace forte::core;
+
+namespace {
+  const TForteUInt64 scmMaxTime = ~static_cast<TForteUInt64>(0);
+
+  void appendUInt(CMGMResponseBuffer &paResponse, TForteUInt64 paValue){
+    char text[20];
+    char *pos = text + sizeof(text);
+    do{
+      *--pos = static_cast<char>('0' + paValue % 10);
+      paValue /= 10;
+    } while(0 != paValue);
+    paResponse.append(pos, static_cast<size_t>(text + sizeof(text) - pos));
+  }
+
+  void appendNumber(CMGMResponseBuffer &paResponse, double paValue){
+    if((paValue != paValue) || (paValue > DBL_MAX) || (paValue < -DBL_MAX)){
+      //NaN and infinity have no JSON representation
+      paResponse.append("null", 4);
+      return;
+    }
+    const size_t size = 32;
+    int length = forte_snprintf(paResponse.reserve(size), size, "%.15g", paValue);
+    paResponse.commit(((0 < length) && (static_cast<size_t>(length) < size)) ? static_cast<size_t>(length) : 0);
+  }
+
+  void appendJSONString(CMGMResponseBuffer &paResponse, const char *paText){
+    paResponse.append("\"", 1);
+    for(; '\0' != *paText; ++paText){
+      switch(*paText){
+        case '"':
+          paResponse.append("\\\"", 2);
+          break;
+        case '\\':
+          paResponse.append("\\\\", 2);
+          break;
+        case '<': //the JSON text is the content of an XML element
+          paResponse.append("\\u003c", 6);
+          break;
+        case '&':
+          paResponse.append("\\u0026", 6);
+          break;
+        default:
+          paResponse.append(paText, 1);
+          break;
+      }
+    }
+    paResponse.append("\"", 1);
+  }
+
+  void appendPoint(CMGMResponseBuffer &paResponse, unsigned int paTier, const CHistoryBuffer::SPoint &paPoint){
+    paResponse.append("[", 1);
+    appendUInt(paResponse, paPoint.mTime);
+    paResponse.append(",", 1);
+    if(0 == paTier){
+      appendNumber(paResponse, paPoint.mAvg);
+    } else {
+      appendNumber(paResponse, paPoint.mMin);
+      paResponse.append(",", 1);
+      appendNumber(paResponse, paPoint.mMax);
+      paResponse.append(",", 1);
+      appendNumber(paResponse, paPoint.mAvg);
+    }
+    paResponse.append("]", 1);
+  }
+
+  //! Reads the next ';' separated parameter, an empty one keeps the default value
+  void parseParam(const char *&paPos, TForteUInt64 &paValue){
+    if(('\0' != *paPos) && (';' != *paPos)){
+      paValue = static_cast<TForteUInt64>(forte::core::util::strtoull(paPos, 0, 10));
+    }
+    const char *next = strchr(paPos, ';');
+    paPos = (0 != next) ? next + 1 : paPos + strlen(paPos);
+  }
+}
+
+CHistoryBuffer::CHistoryBuffer(CStringDictionary::TStringId paName, size_t paCapacity, unsigned int paFactor, unsigned int paNumTiers) :
+    mName(paName), mCapacity(paCapacity), mFactor(paFactor), mNumTiers(paNumTiers), mSamples(new SSample[paCapacity]),
+    mSamplesStart(0), mSamplesCount(0), mSamplesStored(0){
+  memset(mTiers, 0, sizeof(mTiers));
+  for(unsigned int i = 1; i < mNumTiers; ++i){
+    mTiers[i - 1].mPoints = new SPoint[mCapacity];
+  }
+}
+
+CHistoryBuffer::~CHistoryBuffer(){
+  for(unsigned int i = 1; i < mNumTiers; ++i){
+    delete[] mTiers[i - 1].mPoints;
+  }
+  delete[] mSamples;
+}
+
+size_t CHistoryBuffer::getMemorySize(size_t paCapacity, unsigned int paNumTiers){
+  return paCapacity * (sizeof(SSample) + (paNumTiers - 1) * sizeof(SPoint));
+}
+
+void CHistoryBuffer::add(TForteUInt64 paTime, double paValue){
+  CCriticalRegion criticalRegion(mSync);
+  size_t pos = (mSamplesStart + mSamplesCount) % mCapacity;
+  if(mSamplesCount == mCapacity){
+    mSamplesStart = (mSamplesStart + 1) % mCapacity;
+  } else {
+    ++mSamplesCount;
+  }
+  mSamples[pos].mTime = paTime;
+  mSamples[pos].mValue = paValue;
+  ++mSamplesStored;
+
+  if(1 < mNumTiers){
+    SPoint point = { paTime, paValue, paValue, paValue };
+    aggregate(1, point);
+  }
+}
+
+void CHistoryBuffer::aggregate(unsigned int paTier, const SPoint &paPoint){
+  STier &tier = mTiers[paTier - 1];
+  if(0 == tier.mPendingCount){
+    tier.mPending = paPoint;
+    tier.mPendingSum = paPoint.mAvg;
+  } else {
+    if(paPoint.mMin < tier.mPending.mMin){
+      tier.mPending.mMin = paPoint.mMin;
+    }
+    if(paPoint.mMax > tier.mPending.mMax){
+      tier.mPending.mMax = paPoint.mMax;
+    }
+    //all entries of a tier summarize the same number of samples, so the average of the averages is exact
+    tier.mPendingSum += paPoint.mAvg;
+  }
+  if(++tier.mPendingCount < mFactor){
+    return;
+  }
+  tier.mPending.mAvg = tier.mPendingSum / mFactor;
+  tier.mPendingCount = 0;
+  size_t pos = (tier.mStart + tier.mCount) % mCapacity;
+  if(tier.mCount == mCapacity){
+    tier.mStart = (tier.mStart + 1) % mCapacity;
+  } else {
+    ++tier.mCount;
+  }
+  tier.mPoints[pos] = tier.mPending;
+  ++tier.mStored;
+  if(paTier + 1 < mNumTiers){
+    aggregate(paTier + 1, tier.mPending);
+  }
+}
+
+size_t CHistoryBuffer::getCount(unsigned int paTier) const {
+  return (0 == paTier) ? mSamplesCount : mTiers[paTier - 1].mCount;
+}
+
+TForteUInt64 CHistoryBuffer::getFirstIndex(unsigned int paTier) const {
+  return ((0 == paTier) ? mSamplesStored : mTiers[paTier - 1].mStored) - getCount(paTier);
+}
+
+void CHistoryBuffer::getPoint(unsigned int paTier, size_t paIndex, SPoint &paPoint) const {
+  if(0 == paTier){
+    const SSample &sample = mSamples[(mSamplesStart + paIndex) % mCapacity];
+    paPoint.mTime = sample.mTime;
+    paPoint.mMin = paPoint.mMax = paPoint.mAvg = sample.mValue;
+  } else {
+    const STier &tier = mTiers[paTier - 1];
+    paPoint = tier.mPoints[(tier.mStart + paIndex) % mCapacity];
+  }
+}
+
+void CHistoryBuffer::findRange(unsigned int paTier, TForteUInt64 paStart, TForteUInt64 paEnd, size_t &paFirst, size_t &paLast) const {
+  //the entries are ordered by time, so both ends are found with a binary search
+  SPoint point;
+  size_t low = 0;
+  size_t high = getCount(paTier);
+  while(low < high){
+    size_t mid = low + (high - low) / 2;
+    getPoint(paTier, mid, point);
+    if(point.mTime < paStart){
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  paFirst = low;
+  high = getCount(paTier);
+  while(low < high){
+    size_t mid = low + (high - low) / 2;
+    getPoint(paTier, mid, point);
+    if(point.mTime <= paEnd){
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  paLast = low;
+}
+
+size_t CHistoryBuffer::read(unsigned int paTier, TForteUInt64 paStart, TForteUInt64 paIndex, TForteUInt64 paEnd, SPoint *paPoints,
+    size_t paMaxPoints, TForteUInt64 &paFirstIndex){
+  if(paTier >= mNumTiers){
+    return 0;
+  }
+  CCriticalRegion criticalRegion(mSync);
+  size_t first;
+  size_t end;
+  findRange(paTier, paStart, paEnd, first, end);
+  //the entries are also ordered by index, so the entries before paIndex are at the start of the range
+  TForteUInt64 firstIndex = getFirstIndex(paTier);
+  if(paIndex > firstIndex + first){
+    first = (paIndex - firstIndex < end) ? static_cast<size_t>(paIndex - firstIndex) : end;
+  }
+  paFirstIndex = firstIndex + first;
+  if(end - first > paMaxPoints){
+    end = first + paMaxPoints;
+  }
+  for(size_t i = first; i < end; ++i){
+    getPoint(paTier, i, paPoints[i - first]);
+  }
+  return end - first;
+}
+
+CHistoryStore::CHistoryStore(size_t paMemoryLimit) :
+    mMemoryLimit(paMemoryLimit), mMemoryUsed(0){
+}
+
+CHistoryStore::~CHistoryStore(){
+  for(TBufferList::Iterator itRunner = mBuffers.begin(); itRunner != mBuffers.end(); ++itRunner){
+    delete *itRunner;
+  }
+}
+
+CHistoryBuffer *CHistoryStore::createBuffer(CStringDictionary::TStringId paName, size_t paCapacity, unsigned int paFactor,
+    unsigned int paNumTiers, EError &paError){
+  if((0 == paCapacity) || (0 == paNumTiers) || (paNumTiers > CHistoryBuffer::scmMaxTiers) || ((1 < paNumTiers) && (2 > paFactor))){
+    paError = eInvalidConfiguration;
+    return 0;
+  }
+  CCriticalRegion criticalRegion(mSync);
+  if(0 != findBuffer(paName)){
+    paError = eNameInUse;
+    return 0;
+  }
+  size_t size = CHistoryBuffer::getMemorySize(paCapacity, paNumTiers);
+  //the division catches capacities for which the size overflows
+  if((size > mMemoryLimit - mMemoryUsed) || (size / paCapacity < CHistoryBuffer::getMemorySize(1, paNumTiers))){
+    paError = eMemoryLimit;
+    return 0;
+  }
+  CHistoryBuffer *buffer = new CHistoryBuffer(paName, paCapacity, paFactor, paNumTiers);
+  mBuffers.pushBack(buffer);
+  mMemoryUsed += size;
+  paError = eOk;
+  return buffer;
+}
+
+void CHistoryStore::deleteBuffer(CHistoryBuffer *paBuffer){
+  if(0 == paBuffer){
+    return;
+  }
+  {
+    //a running query holds the lock, so the buffer is not deleted while it is read
+    CCriticalRegion criticalRegion(mSync);
+    mBuffers.erase(paBuffer);
+    mMemoryUsed -= paBuffer->getMemorySize();
+  }
+  delete paBuffer;
+}
+
+EMGMResponse CHistoryStore::query(CStringDictionary::TStringId paName, const char *paParams, CMGMResponseBuffer &paResponse){
+  TForteUInt64 tier = 0;
+  TForteUInt64 start = 0;
+  TForteUInt64 end = scmMaxTime;
+  TForteUInt64 index = 0;
+  parseParam(paParams, tier);
+  parseParam(paParams, start);
+  parseParam(paParams, end);
+  parseParam(paParams, index);
+
+  if(CStringDictionary::scm_nInvalidStringId == paName){
+    return e_NO_SUCH_OBJECT;
+  }
+  CCriticalRegion criticalRegion(mSync);
+  CHistoryBuffer *buffer = findBuffer(paName);
+  if(0 == buffer){
+    return e_NO_SUCH_OBJECT;
+  }
+  if(tier >= buffer->getNumTiers()){
+    return e_INVALID_OBJECT;
+  }
+
+  paResponse.append("{\"name\":");
+  appendJSONString(paResponse, CStringDictionary::getInstance().get(paName));
+  paResponse.append(",\"tier\":");
+  appendUInt(paResponse, tier);
+  //number of raw samples an entry of the tier summarizes
+  TForteUInt64 samples = 1;
+  for(TForteUInt64 i = 0; i < tier; ++i){
+    samples *= buffer->getFactor();
+  }
+  paResponse.append(",\"samples\":");
+  appendUInt(paResponse, samples);
+  paResponse.append(",\"now\":");
+  appendUInt(paResponse, getNanoSecondsMonotonic());
+  paResponse.append(",\"points\":[");
+
+  CHistoryBuffer::SPoint points[scmReadChunkSize];
+  bool firstPoint = true;
+  for(;;){
+    TForteUInt64 firstIndex;
+    size_t count = buffer->read(static_cast<unsigned int>(tier), start, index, end, points, scmReadChunkSize, firstIndex);
+    for(size_t i = 0; i < count; ++i){
+      //the first entry is always taken, so that every page makes progress
+      if(!firstPoint && (0 != paResponse.getLimit()) && (paResponse.length() + scmMaxEntryLength > paResponse.getLimit())){
+        //the page is full, the client continues with the first entry left out
+        paResponse.append("],\"next\":{\"start\":");
+        appendUInt(paResponse, points[i].mTime);
+        paResponse.append(",\"index\":");
+        appendUInt(paResponse, firstIndex + i);
+        paResponse.append("}}");
+        return e_RDY;
+      }
+      if(!firstPoint){
+        paResponse.append(",", 1);
+      }
+      firstPoint = false;
+      appendPoint(paResponse, static_cast<unsigned int>(tier), points[i]);
+    }
+    if(count < scmReadChunkSize){
+      break;
+    }
+    //the buffer may have moved on while the chunk was formatted, so the next chunk is looked up by time and index
+    start = points[count - 1].mTime;
+    index = firstIndex + count;
+  }
+  paResponse.append("]}");
+  return e_RDY;
+}
+
+CHistoryBuffer *CHistoryStore::findBuffer(CStringDictionary::TStringId paName){
+  for(TBufferList::Iterator itRunner = mBuffers.begin(); itRunner != mBuffers.end(); ++itRunner){
+    if(paName == (*itRunner)->getName()){
+      return *itRunner;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,204 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#ifndef _HISTORYSTORE_H_
+#define _HISTORYSTORE_H_
+
+#include <forte_config.h>
+#include "stringdict.h"
+#include "mgmcmd.h"
+#include "mgmresponse.h"
+#include "fortelist.h"
+#include <forte_sync.h>
+#include <stddef.h>
+
+#ifndef FORTE_HISTORY_MEMORY_LIMIT
+#define FORTE_HISTORY_MEMORY_LIMIT 1048576
+#endif
+
+namespace forte {
+  namespace core {
+
+    /*!\brief Recent values of one signal in preallocated ring buffers
+     *
+     * Tier 0 holds the raw samples. Every further tier holds buckets summarizing paFactor entries of the tier below
+     * with their minimum, maximum and average, so with the same number of entries each tier covers a paFactor times
+     * longer period. A bucket is stored when it is complete. All memory is allocated when the buffer is created.
+     *
+     * Samples are added from the event chain of the owning FB while queries come from the management of the device,
+     * therefore each buffer has its own lock.
+     */
+    class CHistoryBuffer{
+      public:
+        static const unsigned int scmMaxTiers = 4;
+
+        //! Entry of a tier, for raw samples minimum, maximum and average are the sample value
+        struct SPoint{
+            TForteUInt64 mTime; //!< nanoseconds of the monotonic clock of the device, for buckets their first sample
+            double mMin;
+            double mMax;
+            double mAvg;
+        };
+
+        CHistoryBuffer(CStringDictionary::TStringId paName, size_t paCapacity, unsigned int paFactor, unsigned int paNumTiers);
+        ~CHistoryBuffer();
+
+        //! Bytes a buffer with the given configuration allocates
+        static size_t getMemorySize(size_t paCapacity, unsigned int paNumTiers);
+
+        CStringDictionary::TStringId getName() const {
+          return mName;
+        }
+
+        size_t getMemorySize() const {
+          return getMemorySize(mCapacity, mNumTiers);
+        }
+
+        unsigned int getNumTiers() const {
+          return mNumTiers;
+        }
+
+        unsigned int getFactor() const {
+          return mFactor;
+        }
+
+        void add(TForteUInt64 paTime, double paValue);
+
+        /*!\brief Copies the entries of a tier with a time in [paStart, paEnd] and an index of at least paIndex to paPoints
+         *
+         * The index of an entry counts all entries ever stored in its tier, so unlike its position it does not change
+         * when older entries are pushed out. It tells apart entries with the same time.
+         *
+         * @param paFirstIndex index of the first copied entry
+         * @return number of copied entries, oldest first
+         */
+        size_t read(unsigned int paTier, TForteUInt64 paStart, TForteUInt64 paIndex, TForteUInt64 paEnd, SPoint *paPoints,
+            size_t paMaxPoints, TForteUInt64 &paFirstIndex);
+
+      private:
+        //! Raw sample, kept smaller than SPoint as tier 0 is the largest one
+        struct SSample{
+            TForteUInt64 mTime;
+            double mValue;
+        };
+
+        //! Downsampled tier with the bucket currently being filled
+        struct STier{
+            SPoint *mPoints;
+            size_t mStart;
+            size_t mCount;
+            TForteUInt64 mStored; //!< entries stored so far, the index of the next entry
+            SPoint mPending;
+            double mPendingSum;
+            unsigned int mPendingCount;
+        };
+
+        //! Adds an entry of the tier below paTier to the pending bucket of paTier
+        void aggregate(unsigned int paTier, const SPoint &paPoint);
+        //! Index range [paFirst, paLast) of the entries of a tier within [paStart, paEnd], relative to the oldest entry
+        void findRange(unsigned int paTier, TForteUInt64 paStart, TForteUInt64 paEnd, size_t &paFirst, size_t &paLast) const;
+        void getPoint(unsigned int paTier, size_t paIndex, SPoint &paPoint) const;
+        size_t getCount(unsigned int paTier) const;
+        //! Index of the oldest entry of a tier still in the buffer
+        TForteUInt64 getFirstIndex(unsigned int paTier) const;
+
+        CStringDictionary::TStringId mName;
+        size_t mCapacity;
+        unsigned int mFactor;
+        unsigned int mNumTiers;
+
+        SSample *mSamples;
+        size_t mSamplesStart;
+        size_t mSamplesCount;
+        TForteUInt64 mSamplesStored;
+        STier mTiers[scmMaxTiers - 1];
+
+        CSyncObject mSync;
+
+        CHistoryBuffer(const CHistoryBuffer&);
+        CHistoryBuffer& operator =(const CHistoryBuffer &);
+    };
+
+    /*!\brief History buffers of all signals of a device
+     *
+     * The buffers together may not use more memory than given at construction (FORTE_HISTORY_MEMORY_LIMIT for the
+     * store of a device). The history of a signal is read with the management command
+     *   <Request ID="1" Action="QUERY"><History Name="signal" Tier="1" Start="..." End="..." Index="..."/></Request>
+     * where Tier, Start, End and Index are optional. The result is a JSON object with the name, tier, the number of raw
+     * samples per entry, the current time of the device and the entries, [time,value] for raw samples and
+     * [time,min,max,avg] for buckets. A result exceeding the page size of the response ends with
+     * "next":{"start":...,"index":...}, to be given as Start and Index of the following request. Paging by time and
+     * index keeps the pages consistent while new samples push old ones out of the buffer, also for samples with the
+     * same time.
+     *
+     * The history is only served through the management connection. The HTTP com layer hands requests to the RDs of a
+     * server FB and answers with its SDs, so it can not reach the store of the device without an application. As the
+     * management response is XML, the result is JSON text rather than binary data.
+     */
+    class CHistoryStore{
+      public:
+        enum EError{
+          eOk, eNameInUse, eMemoryLimit, eInvalidConfiguration
+        };
+
+        explicit CHistoryStore(size_t paMemoryLimit = FORTE_HISTORY_MEMORY_LIMIT);
+        ~CHistoryStore();
+
+        /*!\brief Allocates the buffer for a signal
+         *
+         * @return the buffer, 0 if the name is already used, the memory limit would be exceeded or the configuration
+         *         is invalid, the reason is given in paError
+         */
+        CHistoryBuffer *createBuffer(CStringDictionary::TStringId paName, size_t paCapacity, unsigned int paFactor,
+            unsigned int paNumTiers, EError &paError);
+
+        void deleteBuffer(CHistoryBuffer *paBuffer);
+
+        size_t getMemoryUsed() const {
+          return mMemoryUsed;
+        }
+
+        size_t getMemoryLimit() const {
+          return mMemoryLimit;
+        }
+
+        /*!\brief Writes the history of a signal into the response
+         *
+         * The entries are copied out of the buffer in chunks and formatted without holding the lock of the buffer, so
+         * adding samples is not blocked by the formatting.
+         *
+         * @param paParams tier, start, end and index separated by ';', each of them may be empty
+         */
+        EMGMResponse query(CStringDictionary::TStringId paName, const char *paParams, CMGMResponseBuffer &paResponse);
+
+      private:
+        typedef CSinglyLinkedList<CHistoryBuffer*> TBufferList;
+
+        //! Number of entries copied out of a buffer at once
+        static const size_t scmReadChunkSize = 32;
+        //! Upper bound of the length of one formatted entry including its separator
+        static const size_t scmMaxEntryLength = 128;
+
+        CHistoryBuffer *findBuffer(CStringDictionary::TStringId paName);
+
+        TBufferList mBuffers;
+        size_t mMemoryLimit;
+        size_t mMemoryUsed;
+        CSyncObject mSync;
+
+        CHistoryStore(const CHistoryStore&);
+        CHistoryStore& operator =(const CHistoryStore &);
+    };
+
+  }
+}
+
+#endif /* _HISTORYSTORE_H_ */
@@ -9,11 +9,18 @@
  * Contributors:
  *   Johannes Messmer - initial API and implementation and/or initial documentation
  *   Jose Cabral - Cleaning of namespaces
+ *   agent - bus statistics outputs
  *******************************************************************************/
 
 #include "../../resource.h"
 #include "../../device.h"
 #include "io_configFB_controller.h"
+#ifdef FORTE_ENABLE_GENERATED_SOURCE_CPP
+#include "io_configFB_controller_gen.cpp"
+#endif
+#include <forte_udint.h>
+#include <forte_time.h>
+#include <string.h>
 
 using namespace forte::core::io;
 
@@ -27,7 +34,11 @@ const char * const IOConfigFBController::scmStopped = "Stopped";
 IOConfigFBController::IOConfigFBController(CResource *paSrcRes, const SFBInterfaceSpec *paInterfaceSpec, const CStringDictionary::TStringId paInstanceNameId,
     TForteByte *paFBConnData, TForteByte *paFBVarsData) :
     IOConfigFBBase(paSrcRes, paInterfaceSpec, paInstanceNameId, paFBConnData, paFBVarsData), mStarting(false), mErrorCounter(0), mController(0),
-        mPerformRestart(false) {
+        mPerformRestart(false), mStatisticsDO(getDOID(g_nStringIdCYCLES)), mStatisticsEI(cg_nInvalidEventID), mStatisticsEO(cg_nInvalidEventID) {
+  if(cg_unInvalidPortId != mStatisticsDO) {
+    mStatisticsEI = getEIID(g_nStringIdREQ);
+    mStatisticsEO = getEOID(g_nStringIdCNF);
+  }
 }
 
 IOConfigFBController::~IOConfigFBController() {
@@ -47,9 +58,31 @@ void IOConfigFBController::executeEvent(int paEIID) {
       }
     } else {
       QO() = deInit();
+      updateStatisticsOutputs();
       sendOutputEvent(scmEventINITOID);
     }
+  } else if(cg_nInvalidEventID != mStatisticsEI && mStatisticsEI == paEIID) {
+    updateStatisticsOutputs();
+    if(cg_nInvalidEventID != mStatisticsEO) {
+      sendOutputEvent(mStatisticsEO);
+    }
+  }
+}
+
+void IOConfigFBController::updateStatisticsOutputs() {
+  if(cg_unInvalidPortId == mStatisticsDO) {
+    return;
+  }
+
+  IODeviceController::Statistics statistics;
+  if(!getStatistics(statistics)) {
+    memset(&statistics, 0, sizeof(statistics));
   }
+  *static_cast<CIEC_UDINT*>(getDO(mStatisticsDO)) = statistics.mCycles;
+  static_cast<CIEC_TIME*>(getDO(mStatisticsDO + 1))->setFromNanoSeconds(statistics.mLastBusTime);
+  static_cast<CIEC_TIME*>(getDO(mStatisticsDO + 2))->setFromNanoSeconds(statistics.mMaxBusTime);
+  static_cast<CIEC_TIME*>(getDO(mStatisticsDO + 3))->setFromNanoSeconds(statistics.mAverageBusTime);
+  static_cast<CIEC_TIME*>(getDO(mStatisticsDO + 4))->setFromNanoSeconds(statistics.mCyclePeriod);
 }
 
 bool IOConfigFBController::handleNotification(IODeviceController::NotificationType paType, const void* paAttachment) {
@@ -152,6 +185,7 @@ void IOConfigFBController::started(const char* paError) {
 
   QO() = true;
   STATUS() = scmOK;
+  updateStatisticsOutputs();
   sendOutputEvent(scmEventINITOID);
 }
 
@@ -9,6 +9,7 @@
  * Contributors:
  *   Johannes Messmer - initial API and implementation and/or initial documentation
  *   Jose Cabral - Cleaning of namespaces
+ *   agent - bus statistics outputs
  *******************************************************************************/
 
 #ifndef SRC_CORE_IO_CONFIGFB_CONTROLLER_H_
@@ -30,6 +31,7 @@ namespace forte {
        * - handles the basic events of a controller configuration fb (INIT, INITO with the corresponding data outputs QI, QO, and STATUS)
        * - thread safe communication with corresponding device controller (see #handleNotification)
        * - automatic error handling and restart of the Device Controller (see #IODeviceController)
+       * - optional bus statistics outputs CYCLES, BUSTIME, MAXBUSTIME, AVGBUSTIME, and PERIOD (see #updateStatisticsOutputs)
        */
       class IOConfigFBController : public IOConfigFBBase {
         public:
@@ -41,6 +43,16 @@ namespace forte {
             return mController;
           }
 
+          /*! @brief Retrieves the bus statistics of the Device Controller, e.g., the bus time per poll cycle
+           *
+           * Should be called from the execution context of the fb, as the controller is replaced there after errors.
+           *
+           * @return False if the controller is not running or does not provide statistics
+           */
+          bool getStatistics(IODeviceController::Statistics &paStatistics) const {
+            return (0 != mController) && mController->getStatistics(paStatistics);
+          }
+
         protected:
 
           static const TEventID scmEventINITID = 0;
@@ -62,6 +74,14 @@ namespace forte {
 
           virtual void executeEvent(int paEIID);
 
+          /*! @brief Writes the bus statistics of the Device Controller to the statistics outputs
+           *
+           * A configuration fb offers the statistics by declaring the data outputs CYCLES (UDINT), BUSTIME, MAXBUSTIME,
+           * AVGBUSTIME, and PERIOD (TIME) in this order. They are written with INITO and with CNF, which confirms a REQ
+           * event input of the fb. The outputs are zero while the controller is not running or provides no statistics.
+           */
+          void updateStatisticsOutputs();
+
           /*! @brief Creates an instance of the corresponding Device Controller
            *
            * The method should create an instance of the hardware specific Device Controller.
@@ -164,6 +184,12 @@ namespace forte {
 
           bool mPerformRestart;
 
+          //! Data output CYCLES, followed by the other statistics outputs. Invalid if the fb has no statistics outputs.
+          TPortId mStatisticsDO;
+          //! REQ and CNF events requesting the statistics outputs, invalid if the fb has none
+          TEventID mStatisticsEI;
+          TEventID mStatisticsEO;
+
           static const char * const scmOK;
           static const char * const scmInitializing;
           static const char * const scmFailedToInit;
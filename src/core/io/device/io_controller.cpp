@@ -14,6 +14,7 @@
 #include "io_controller.h"
 
 #include "../processinterface.h"
+#include "../mapper/io_handle_image.h"
 #include "../configFB/io_configFB_controller.h"
 #include "criticalregion.h"
 
@@ -21,7 +22,7 @@ using namespace forte::core::io;
 
 IODeviceController::IODeviceController(CDeviceExecution& paDeviceExecution) :
     CExternalEventHandler(paDeviceExecution), mNotificationType(UnknownNotificationType), mNotificationAttachment(0), mNotificationHandled(true), mError(0),
-        mDelegate(0), mInitDelay(0) {
+        mDelegate(0), mProcessImage(0), mInputChanges(0), mInitDelay(0) {
 }
 
 void IODeviceController::run() {
@@ -33,10 +34,17 @@ void IODeviceController::run() {
   mError = init();
 
   if(!hasError()) {
+    bool imageRegistered = (0 != mProcessImage) && (0 != mDelegate)
+      && IOMapper::getInstance().registerProcessImage(mDelegate->getInstanceName(), mProcessImage);
+
     notifyConfigFB(Success);
 
     runLoop();
 
+    if(imageRegistered) {
+      IOMapper::getInstance().deregisterProcessImage(mProcessImage);
+    }
+
     if(hasError()) {
       notifyConfigFB(Error, mError);
     }
@@ -75,6 +83,10 @@ void IODeviceController::handleChangeEvent(IOHandle*) {
   // EMPTY - Override
 }
 
+bool IODeviceController::getStatistics(Statistics&) const {
+  return false;
+}
+
 bool IODeviceController::hasError() const {
   return mError != 0;
 }
@@ -105,6 +117,36 @@ void IODeviceController::checkForInputChanges() {
   for(THandleList::Iterator it = mInputHandles.begin(); it != itEnd; ++it) {
     if((*it)->hasObserver() && !isHandleValueEqual(*it)) {
       // Inform Process Interface about change
+      ++mInputChanges;
+      (*it)->onChange();
+    }
+  }
+}
+
+void IODeviceController::setProcessImage(IOProcessImage *paImage) {
+  mProcessImage = paImage;
+}
+
+IOHandle* IODeviceController::createImageHandle(IOMapper::Direction paDirection, CIEC_ANY::EDataTypeID paType, unsigned int paOffset,
+    unsigned int paPosition) {
+  IOProcessImage::Location location;
+  if(0 == mProcessImage || !IOProcessImage::getLocation(paType, paOffset, paPosition, location)
+    || !(paDirection == IOMapper::In ? mProcessImage->isInInputImage(location) : mProcessImage->isInOutputImage(location))) {
+    DEVLOG_WARNING("[IODeviceController] Invalid process image location %u.%u\n", paOffset, paPosition);
+    return 0;
+  }
+  return new IOHandleImage(this, paDirection, paType, *mProcessImage, location);
+}
+
+void IODeviceController::commitInputImage() {
+  mProcessImage->commitInputs();
+
+  CCriticalRegion criticalRegion(mHandleMutex);
+  THandleList::Iterator itEnd = mInputHandles.end();
+  for(THandleList::Iterator it = mInputHandles.begin(); it != itEnd; ++it) {
+    IOProcessImage::Location location;
+    if((*it)->hasObserver() && mProcessImage == (*it)->getProcessImage(location) && mProcessImage->hasInputChanged(location)) {
+      ++mInputChanges;
       (*it)->onChange();
     }
   }
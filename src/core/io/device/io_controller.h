@@ -21,6 +21,7 @@
 #include <fortelist.h>
 
 #include <io/mapper/io_handle.h>
+#include <io/mapper/io_process_image.h>
 
 namespace forte {
   namespace core {
@@ -82,6 +83,26 @@ namespace forte {
           const void* mNotificationAttachment;
           bool mNotificationHandled;
 
+          //! Bus statistics of controllers accessing their device in cycles, all times are in ns
+          struct Statistics {
+              //! number of cycles since the start of the controller
+              TForteUInt32 mCycles;
+              //! time spent for the transfers of the last cycle
+              TForteUInt64 mLastBusTime;
+              TForteUInt64 mMaxBusTime;
+              TForteUInt64 mAverageBusTime;
+              //! current time between two cycles
+              TForteUInt64 mCyclePeriod;
+          };
+
+          /*! @brief Retrieves the bus statistics of the controller
+           *
+           * May be called from any thread while the controller runs.
+           *
+           * @return False if the controller does not provide statistics
+           */
+          virtual bool getStatistics(Statistics &paStatistics) const;
+
           /*! @brief Sets the configuration of the controller
            *
            * @param paConfig Pointer to the configuration struct provided by the corresponding controller configuration fb. Use *static_cast<CustomConfig*>(config) to retrieve the struct instance.
@@ -92,6 +113,11 @@ namespace forte {
 
           virtual void handleChangeEvent(IOHandle *paHandle);
 
+          //! Process image of the controller, 0 if its handles access the device on their own
+          IOProcessImage* getProcessImage() const {
+            return mProcessImage;
+          }
+
           //TODO: adapt this properly to the new handler model. This mockup is just to avoid the classes below to be abstract
           virtual size_t getIdentifier() const {
             return 0;
@@ -179,6 +205,39 @@ namespace forte {
            */
           virtual bool isHandleValueEqual(IOHandle* paHandle);
 
+          //! Number of observed input changes reported by #checkForInputChanges and #commitInputImage so far
+          TForteUInt32 getNrOfInputChanges() const {
+            return mInputChanges;
+          }
+
+          /*! @brief Switches the controller to the process image mode
+           *
+           * Should be called in the constructor or the #init method before any handle is created.
+           * The process image is registered at the #IOMapper under the name of the configuration fb while the controller runs.
+           *
+           * A poll routine using the image reads all inputs into the buffer returned by IOProcessImage::beginInputScan
+           * and calls #commitInputImage afterwards. Staged outputs are fetched with IOProcessImage::flushOutputs.
+           *
+           * @param paImage Process image, the controller keeps the ownership
+           */
+          void setProcessImage(IOProcessImage *paImage);
+
+          /*! @brief Creates a handle located in the process image
+           *
+           * @param paDirection Direction of the handle, selects the input or output image
+           * @param paType Data type of the handle (BOOL, BYTE, WORD, DWORD, LWORD)
+           * @param paOffset Byte offset of the value within the image
+           * @param paPosition Bit position of a BOOL value
+           * @return The handle or 0 if there is no process image or the location is invalid
+           */
+          IOHandle* createImageHandle(IOMapper::Direction paDirection, CIEC_ANY::EDataTypeID paType, unsigned int paOffset, unsigned int paPosition = 0);
+
+          /*! @brief Publishes the scanned inputs and notifies the observers of all changed input handles
+           *
+           * Replaces #checkForInputChanges for controllers in the process image mode.
+           */
+          void commitInputImage();
+
           /*! @brief Synchronizes the access to the #inputHandles and #outputHandles. Use it for iterations over the lists. */
           CSyncObject mHandleMutex;
 
@@ -200,6 +259,10 @@ namespace forte {
 
           IOConfigFBController *mDelegate;
 
+          IOProcessImage *mProcessImage;
+
+          TForteUInt32 mInputChanges;
+
           /*! @brief Drops all handle instances which were previously added by the #addHandle method
            *
            * The method is automatically called during the deinitialization of the corresponding configuration function block.
@@ -9,14 +9,26 @@
  * Contributors:
  *   Johannes Messmer - initial API and implementation and/or initial documentation
  *   Jose Cabral - Cleaning of namespaces
+ *   agent - adaptive poll interval, register blocks, and bus statistics
  *******************************************************************************/
 
 #include "io_controller_poll.h"
+#include "criticalregion.h"
+#include <forte_architecture_time.h>
+#include <string.h>
 
 using namespace forte::core::io;
 
+const char * const IODevicePollController::scmFailedToTransferBlock = "Failed to transfer register block";
+
 IODevicePollController::IODevicePollController(CDeviceExecution& paDeviceExecution, float paPollInterval) :
-    IODeviceController(paDeviceExecution), mPollInterval(paPollInterval) {
+    IODeviceController(paDeviceExecution), mPollPeriod(0), mMinPollPeriod(0), mOutputTransfer(0), mTotalBusTime(0) {
+  memset(&mStatistics, 0, sizeof(mStatistics));
+  setPollInterval(paPollInterval);
+}
+
+IODevicePollController::~IODevicePollController() {
+  delete[] mOutputTransfer;
 }
 
 void IODevicePollController::handleChangeEvent(IOHandle*) {
@@ -25,10 +37,15 @@ void IODevicePollController::handleChangeEvent(IOHandle*) {
 
 void IODevicePollController::runLoop() {
   while(isAlive()) {
-    mForceLoop.timedWait(static_cast<const TForteUInt64>(mPollInterval * 1E6)); //If timeout occurred is a normal waiting, otherwise is a forced loop. Don't care about the return value
+    TForteUInt64 period;
+    {
+      CCriticalRegion criticalRegion(mStatisticsMutex);
+      period = mStatistics.mCyclePeriod;
+    }
+    mForceLoop.timedWait(period); //If timeout occurred is a normal waiting, otherwise is a forced loop. Don't care about the return value
 
     // Perform poll operation
-    poll();
+    pollCycle();
 
     if(hasError()) {
       break;
@@ -37,16 +54,129 @@ void IODevicePollController::runLoop() {
   }
 }
 
+void IODevicePollController::pollCycle() {
+  TForteUInt32 inputChanges = getNrOfInputChanges();
+  TForteUInt64 start = getNanoSecondsMonotonic();
+
+  poll();
+
+  TForteUInt64 busTime = getNanoSecondsMonotonic() - start;
+
+  CCriticalRegion criticalRegion(mStatisticsMutex);
+  ++mStatistics.mCycles;
+  mStatistics.mLastBusTime = busTime;
+  if(busTime > mStatistics.mMaxBusTime) {
+    mStatistics.mMaxBusTime = busTime;
+  }
+  mTotalBusTime += busTime;
+  mStatistics.mAverageBusTime = mTotalBusTime / mStatistics.mCycles;
+
+  if(0 != mMinPollPeriod) {
+    if(inputChanges != getNrOfInputChanges()) {
+      mStatistics.mCyclePeriod = mMinPollPeriod;
+    } else if(mStatistics.mCyclePeriod < mPollPeriod) {
+      mStatistics.mCyclePeriod = (mStatistics.mCyclePeriod * 2 < mPollPeriod) ? mStatistics.mCyclePeriod * 2 : mPollPeriod;
+    }
+  }
+}
+
+void IODevicePollController::poll() {
+  transferBlocks();
+}
+
 void IODevicePollController::setPollInterval(float paPollInterval) {
   if(paPollInterval <= 0) {
-    DEVLOG_WARNING("[IODevicePollController] Configured PollInterval is set to an invalid value '%d'. Set to 25.\n", paPollInterval);
+    DEVLOG_WARNING("[IODevicePollController] Configured PollInterval is set to an invalid value '%f'. Set to 25.\n", paPollInterval);
     paPollInterval = 25;
   }
 
-  this->mPollInterval = paPollInterval;
+  CCriticalRegion criticalRegion(mStatisticsMutex);
+  mPollPeriod = static_cast<TForteUInt64>(paPollInterval * 1E6);
+  mStatistics.mCyclePeriod = mPollPeriod;
+}
+
+void IODevicePollController::setAdaptivePollInterval(float paMinPollInterval) {
+  CCriticalRegion criticalRegion(mStatisticsMutex);
+  mMinPollPeriod = (paMinPollInterval > 0) ? static_cast<TForteUInt64>(paMinPollInterval * 1E6) : 0;
+  if(mMinPollPeriod > mPollPeriod) {
+    DEVLOG_WARNING("[IODevicePollController] Adaptive PollInterval is longer than the configured PollInterval. It is disabled.\n");
+    mMinPollPeriod = 0;
+  }
+  mStatistics.mCyclePeriod = mPollPeriod;
 }
 
 void IODevicePollController::forcePoll() {
   mForceLoop.inc();
 }
 
+bool IODevicePollController::getStatistics(Statistics &paStatistics) const {
+  CCriticalRegion criticalRegion(mStatisticsMutex);
+  paStatistics = mStatistics;
+  return true;
+}
+
+void IODevicePollController::addInputBlock(unsigned int paAddress, unsigned int paImageOffset, unsigned int paSize) {
+  if(0 == getProcessImage() || !addBlock(mInputBlocks, getProcessImage()->getInputSize(), paAddress, paImageOffset, paSize)) {
+    DEVLOG_WARNING("[IODevicePollController] Input block 0x%x does not fit into the process image. It is ignored.\n", paAddress);
+  }
+}
+
+void IODevicePollController::addOutputBlock(unsigned int paAddress, unsigned int paImageOffset, unsigned int paSize) {
+  if(0 == getProcessImage() || !addBlock(mOutputBlocks, getProcessImage()->getOutputSize(), paAddress, paImageOffset, paSize)) {
+    DEVLOG_WARNING("[IODevicePollController] Output block 0x%x does not fit into the process image. It is ignored.\n", paAddress);
+    return;
+  }
+  if(0 == mOutputTransfer) {
+    mOutputTransfer = new TForteByte[getProcessImage()->getOutputSize()];
+  }
+}
+
+bool IODevicePollController::addBlock(TRegisterBlockList &paBlocks, unsigned int paImageSize, unsigned int paAddress, unsigned int paImageOffset,
+    unsigned int paSize) {
+  if(0 == paSize || paImageOffset + paSize > paImageSize) {
+    return false;
+  }
+  RegisterBlock block;
+  block.mAddress = paAddress;
+  block.mImageOffset = paImageOffset;
+  block.mSize = paSize;
+  paBlocks.pushBack(block);
+  return true;
+}
+
+bool IODevicePollController::readBlock(unsigned int, TForteByte*, unsigned int) {
+  return false;
+}
+
+bool IODevicePollController::writeBlock(unsigned int, const TForteByte*, unsigned int) {
+  return false;
+}
+
+void IODevicePollController::transferBlocks() {
+  IOProcessImage *image = getProcessImage();
+  if(0 == image) {
+    return;
+  }
+
+  if(!mInputBlocks.isEmpty()) {
+    TForteByte *scan = image->beginInputScan();
+    TRegisterBlockList::Iterator itEnd = mInputBlocks.end();
+    for(TRegisterBlockList::Iterator it = mInputBlocks.begin(); it != itEnd; ++it) {
+      if(!readBlock((*it).mAddress, scan + (*it).mImageOffset, (*it).mSize)) {
+        mError = scmFailedToTransferBlock;
+        return;
+      }
+    }
+    commitInputImage();
+  }
+
+  if(0 != mOutputTransfer && image->flushOutputs(mOutputTransfer)) {
+    TRegisterBlockList::Iterator itEnd = mOutputBlocks.end();
+    for(TRegisterBlockList::Iterator it = mOutputBlocks.begin(); it != itEnd; ++it) {
+      if(!writeBlock((*it).mAddress, mOutputTransfer + (*it).mImageOffset, (*it).mSize)) {
+        mError = scmFailedToTransferBlock;
+        return;
+      }
+    }
+  }
+}
@@ -16,6 +16,8 @@
 
 #include "io_controller.h"
 #include <forte_sem.h>
+#include <forte_sync.h>
+#include <fortelist.h>
 
 namespace forte {
   namespace core {
@@ -26,17 +28,25 @@ namespace forte {
        * IO device controller for devices which require an implementation of IOs using poll operations.
        * Offers a #poll method which performs an IO update in a configured #PollInterval.
        * Allows to force a polling routine with the #forcePoll method (e.g. can be used to set an output immediately).
+       *
+       * With #setAdaptivePollInterval the controller polls faster while inputs are changing and backs off to the
+       * configured poll interval while they are stable.
+       * Controllers in the process image mode may declare the contiguous register blocks of their device (see #addInputBlock).
+       * The default #poll routine then transfers each block in one piece per cycle.
        */
       class IODevicePollController : public IODeviceController {
         public:
+          virtual ~IODevicePollController();
 
           virtual void handleChangeEvent(IOHandle *paHandle);
 
+          virtual bool getStatistics(Statistics &paStatistics) const;
+
         protected:
           /*! @brief Constructor
            *
            * @param paDeviceExecution Device execution where the controller runs
-           * @param paPollInterval Default poll routines per seconds (Hz). Must be greater than 0. Call #setPollInterval in the #setConfig method.
+           * @param paPollInterval Default time between two poll routines in ms. Must be greater than 0. Call #setPollInterval in the #setConfig method.
            */
           IODevicePollController(CDeviceExecution& paDeviceExecution, float paPollInterval);
 
@@ -44,10 +54,11 @@ namespace forte {
            *
            * The IO states of all handles should be written/read in this method.
            * The method should call the #checkForInputChanges method after receiving new input states.
+           * The default implementation calls #transferBlocks.
            *
            * @attention The method should perform a single update routine and not a blocking loop.
            */
-          virtual void poll() = 0;
+          virtual void poll();
 
           /*! @brief Forces an execution of the #poll routine
            *
@@ -55,20 +66,89 @@ namespace forte {
            */
           void forcePoll();
 
-          /*! @brief Sets the polling interval in Hz (poll routines per second)
+          /*! @brief Sets the polling interval, the time between two poll routines
            *
-           * The poll interval should not be set to high as the poll operations may consume too much processing power and consequently block other control operations.
+           * The poll interval should not be set to low as the poll operations may consume too much processing power and consequently block other control operations.
            *
-           * @param paPollInterval Poll routines per seconds (Hz). Must be greater than 0.
+           * @param paPollInterval Time between two poll routines in ms. Must be greater than 0.
            */
           void setPollInterval(float paPollInterval);
 
+          /*! @brief Enables the adaptive poll interval
+           *
+           * After a cycle with input changes the controller polls with the given minimum interval.
+           * Each cycle without changes doubles the interval until the interval configured with #setPollInterval is reached again.
+           *
+           * @param paMinPollInterval Time between two poll routines in ms while inputs are changing. 0 disables the adaptive interval.
+           */
+          void setAdaptivePollInterval(float paMinPollInterval);
+
+          /*! @brief Declares a contiguous block of input registers
+           *
+           * The block is read with a single #readBlock call per cycle and stored in the input image.
+           * Requires the process image mode (see #setProcessImage).
+           *
+           * @param paAddress Device address of the first register
+           * @param paImageOffset Byte offset of the block in the input image
+           * @param paSize Size of the block in bytes
+           */
+          void addInputBlock(unsigned int paAddress, unsigned int paImageOffset, unsigned int paSize);
+
+          //! Declares a contiguous block of output registers, see #addInputBlock
+          void addOutputBlock(unsigned int paAddress, unsigned int paImageOffset, unsigned int paSize);
+
+          /*! @brief Reads a declared register block from the device
+           *
+           * @return False if the transfer failed. The controller stops with an error then.
+           */
+          virtual bool readBlock(unsigned int paAddress, TForteByte *paData, unsigned int paSize);
+
+          //! Writes a declared register block to the device, see #readBlock
+          virtual bool writeBlock(unsigned int paAddress, const TForteByte *paData, unsigned int paSize);
+
+          /*! @brief Transfers all declared register blocks
+           *
+           * The input blocks are read into the input image, which is committed afterwards.
+           * The output blocks are only written if outputs have been staged since the last cycle.
+           */
+          void transferBlocks();
+
+          /*! @brief Performs one cycle: polls the device, records the bus time, and adapts the poll interval
+           *
+           * Called by the run loop after each interval or forced poll.
+           */
+          void pollCycle();
+
         private:
+          struct RegisterBlock {
+              unsigned int mAddress;
+              unsigned int mImageOffset;
+              unsigned int mSize;
+          };
+
+          typedef CSinglyLinkedList<RegisterBlock> TRegisterBlockList;
+
           virtual void runLoop();
 
-          float mPollInterval;
+          static bool addBlock(TRegisterBlockList &paBlocks, unsigned int paImageSize, unsigned int paAddress, unsigned int paImageOffset, unsigned int paSize);
+
+          //! configured time between two polls in ns
+          TForteUInt64 mPollPeriod;
+          //! time between two polls while inputs are changing in ns, 0 if the interval is not adaptive
+          TForteUInt64 mMinPollPeriod;
 
           CSemaphore mForceLoop;
+
+          TRegisterBlockList mInputBlocks;
+          TRegisterBlockList mOutputBlocks;
+          //! output image fetched from the process image for writing the output blocks
+          TForteByte *mOutputTransfer;
+
+          Statistics mStatistics;
+          TForteUInt64 mTotalBusTime;
+          mutable CSyncObject mStatisticsMutex;
+
+          static const char * const scmFailedToTransferBlock;
       };
 
     } //namespace IO
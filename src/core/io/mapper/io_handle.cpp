@@ -34,6 +34,10 @@ void IOHandle::dropObserver() {
   this->mObserver = 0;
 }
 
+IOProcessImage* IOHandle::getProcessImage(IOProcessImage::Location&) {
+  return 0;
+}
+
 void IOHandle::onChange() {
   if(mObserver != 0 && mObserver->onChange()) {
     mController->fireIndicationEvent(mObserver);
@@ -18,6 +18,7 @@
 #include <forte_bool.h>
 
 #include "io_mapper.h"
+#include "io_process_image.h"
 
 namespace forte {
   namespace core {
@@ -51,6 +52,15 @@ namespace forte {
           virtual void set(const CIEC_ANY &) = 0;
           virtual void get(CIEC_ANY &) = 0;
 
+          /*! @brief Returns the process image holding the value of the handle
+           *
+           * Allows observers to resolve the location once and to read from the image directly.
+           *
+           * @param paLocation Receives the location of the value within the image
+           * @return The process image or 0 if the handle accesses the device on its own
+           */
+          virtual IOProcessImage* getProcessImage(IOProcessImage::Location &paLocation);
+
           void onChange();
 
         protected:
@@ -0,0 +1,59 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+
+#include "io_handle_image.h"
+
+using namespace forte::core::io;
+
+IOHandleImage::IOHandleImage(IODeviceController *paController, IOMapper::Direction paDirection, CIEC_ANY::EDataTypeID paType, IOProcessImage &paImage,
+    const IOProcessImage::Location &paLocation) :
+    IOHandle(paController, paDirection, paType), mImage(paImage), mLocation(paLocation) {
+}
+
+void IOHandleImage::set(const CIEC_ANY &paValue) {
+  if(mImage.stageOutput(mLocation, paValue)) {
+    mController->handleChangeEvent(this);
+  }
+}
+
+void IOHandleImage::get(CIEC_ANY &paValue) {
+  if(mDirection == IOMapper::In) {
+    mImage.readInput(mLocation, paValue);
+  } else {
+    mImage.readOutput(mLocation, paValue);
+  }
+}
+
+IOProcessImage* IOHandleImage::getProcessImage(IOProcessImage::Location &paLocation) {
+  paLocation = mLocation;
+  return &mImage;
+}
+
+void IOHandleImage::onObserver(IOObserver *paObserver) {
+  IOHandle::onObserver(paObserver);
+
+  if(mDirection == IOMapper::In && is(CIEC_ANY::e_BOOL)) {
+    CIEC_BOOL state;
+    get(state);
+    if(state) {
+      mController->fireIndicationEvent(paObserver);
+    }
+  }
+}
+
+void IOHandleImage::dropObserver() {
+  IOHandle::dropObserver();
+
+  if(mDirection == IOMapper::Out && mImage.resetOutput(mLocation)) {
+    mController->handleChangeEvent(this);
+  }
+}
@@ -0,0 +1,57 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+
+#ifndef SRC_CORE_IO_MAPPER_IO_HANDLE_IMAGE_H_
+#define SRC_CORE_IO_MAPPER_IO_HANDLE_IMAGE_H_
+
+#include <io/mapper/io_handle.h>
+#include <io/mapper/io_process_image.h>
+#include <io/device/io_controller.h>
+
+namespace forte {
+  namespace core {
+    namespace io {
+
+      /*! @brief Handle of a value located in the process image of its controller
+       *
+       * Inputs are read from the last committed snapshot of the image, outputs are staged in the image.
+       * The controller is triggered with #IODeviceController::handleChangeEvent only for the first output staged in a cycle.
+       */
+      class IOHandleImage : public IOHandle {
+        public:
+          IOHandleImage(IODeviceController *paController, IOMapper::Direction paDirection, CIEC_ANY::EDataTypeID paType, IOProcessImage &paImage,
+              const IOProcessImage::Location &paLocation);
+
+          virtual void set(const CIEC_ANY &);
+          virtual void get(CIEC_ANY &);
+
+          virtual IOProcessImage* getProcessImage(IOProcessImage::Location &paLocation);
+
+          //! Checks if the input changed with the last commit of the image
+          bool hasChanged() const {
+            return mImage.hasInputChanged(mLocation);
+          }
+
+        protected:
+          virtual void onObserver(IOObserver *paObserver);
+          virtual void dropObserver();
+
+        private:
+          IOProcessImage &mImage;
+          const IOProcessImage::Location mLocation;
+      };
+
+    } //namespace IO
+  } //namepsace core
+} //namespace forte
+
+#endif /* SRC_CORE_IO_MAPPER_IO_HANDLE_IMAGE_H_ */
@@ -118,3 +118,35 @@ void IOMapper::deregisterObserver(IOObserver* paObserver) {
     }
   }
 }
+
+bool IOMapper::registerProcessImage(CIEC_WSTRING const &paId, IOProcessImage* paImage) {
+  CCriticalRegion criticalRegion(mSyncMutex);
+  std::string idStr(paId.getValue());
+
+  if(mProcessImages.find(idStr) != mProcessImages.end()) {
+    DEVLOG_WARNING("[IOMapper] Duplicated process image entry '%s'\n", paId.getValue());
+    return false;
+  }
+
+  mProcessImages.insert(std::make_pair(idStr, paImage));
+  DEVLOG_DEBUG("[IOMapper] Register process image %s\n", paId.getValue());
+  return true;
+}
+
+void IOMapper::deregisterProcessImage(IOProcessImage* paImage) {
+  CCriticalRegion criticalRegion(mSyncMutex);
+
+  for(TProcessImageMap::iterator it = mProcessImages.begin(); it != mProcessImages.end(); ++it) {
+    if(it->second == paImage) {
+      DEVLOG_DEBUG("[IOMapper] Deregister process image %s\n", it->first.data());
+      mProcessImages.erase(it);
+      break;
+    }
+  }
+}
+
+IOProcessImage* IOMapper::getProcessImage(CIEC_WSTRING const &paId) {
+  CCriticalRegion criticalRegion(mSyncMutex);
+  TProcessImageMap::iterator it = mProcessImages.find(std::string(paId.getValue()));
+  return (it != mProcessImages.end()) ? it->second : 0;
+}
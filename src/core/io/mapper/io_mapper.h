@@ -26,6 +26,7 @@ namespace forte {
 
       class IOHandle;
       class IOObserver;
+      class IOProcessImage;
 
       class IOMapper {
         DECLARE_SINGLETON (IOMapper)
@@ -44,6 +45,17 @@ namespace forte {
           bool registerObserver(CIEC_WSTRING const &paId, IOObserver* paObserver);
           void deregisterObserver(IOObserver* paObserver);
 
+          /*! @brief Makes the process image of a controller available, e.g., for monitoring
+           *
+           * @param paId Id of the image, the instance name of the controller's configuration fb
+           * @param paImage Process image, owned by the controller
+           */
+          bool registerProcessImage(CIEC_WSTRING const &paId, IOProcessImage* paImage);
+          void deregisterProcessImage(IOProcessImage* paImage);
+
+          //! Returns the process image registered under the id or 0
+          IOProcessImage* getProcessImage(CIEC_WSTRING const &paId);
+
         private:
           typedef std::map<std::string, IOHandle*> THandleMap;
           THandleMap mHandles;
@@ -51,6 +63,9 @@ namespace forte {
           typedef std::map<std::string, IOObserver*> TObserverMap;
           TObserverMap mObservers;
 
+          typedef std::map<std::string, IOProcessImage*> TProcessImageMap;
+          TProcessImageMap mProcessImages;
+
           CSyncObject mSyncMutex;
       };
 
@@ -0,0 +1,214 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+
+#include "io_process_image.h"
+#include <forte_bool.h>
+#include <forte_byte.h>
+#include <forte_word.h>
+#include <forte_dword.h>
+#ifdef FORTE_USE_64BIT_DATATYPES
+#include <forte_lword.h>
+#endif
+#include "criticalregion.h"
+#include <string.h>
+
+using namespace forte::core::io;
+
+IOProcessImage::IOProcessImage(unsigned int paInputSize, unsigned int paOutputSize) :
+    mInputSize(paInputSize), mOutputSize(paOutputSize), mCommitted(0), mOutputsChanged(false), mInputCommits(0), mOutputFlushes(0) {
+  for(unsigned int i = 0; i < 2; ++i) {
+    mInputs[i] = new TForteByte[mInputSize + 1];
+    memset(mInputs[i], 0, mInputSize + 1);
+  }
+  mOutputs = new TForteByte[mOutputSize + 1];
+  memset(mOutputs, 0, mOutputSize + 1);
+}
+
+IOProcessImage::~IOProcessImage() {
+  delete[] mInputs[0];
+  delete[] mInputs[1];
+  delete[] mOutputs;
+}
+
+bool IOProcessImage::getLocation(CIEC_ANY::EDataTypeID paType, unsigned int paOffset, unsigned int paPosition, Location &paLocation) {
+  paLocation.mOffset = paOffset;
+  paLocation.mMask = 0;
+  switch(paType){
+    case CIEC_ANY::e_BOOL:
+      if(8 <= paPosition) {
+        return false;
+      }
+      paLocation.mMask = static_cast<TForteByte>(1 << paPosition);
+      paLocation.mSize = 1;
+      break;
+    case CIEC_ANY::e_BYTE:
+      paLocation.mSize = sizeof(TForteByte);
+      break;
+    case CIEC_ANY::e_WORD:
+      paLocation.mSize = sizeof(TForteWord);
+      break;
+    case CIEC_ANY::e_DWORD:
+      paLocation.mSize = sizeof(TForteDWord);
+      break;
+#ifdef FORTE_USE_64BIT_DATATYPES
+    case CIEC_ANY::e_LWORD:
+      paLocation.mSize = sizeof(TForteLWord);
+      break;
+#endif
+    default:
+      return false;
+  }
+  return true;
+}
+
+TForteByte* IOProcessImage::beginInputScan() {
+  TForteByte *scanBuffer = mInputs[mCommitted ^ 1];
+  // only the controller thread changes the committed snapshot, reading it without lock is fine
+  memcpy(scanBuffer, mInputs[mCommitted], mInputSize);
+  return scanBuffer;
+}
+
+void IOProcessImage::commitInputs() {
+  CCriticalRegion criticalRegion(mSyncMutex);
+  mCommitted ^= 1;
+  ++mInputCommits;
+}
+
+bool IOProcessImage::hasInputChanged(const Location &paLocation) const {
+  const TForteByte *current = mInputs[mCommitted] + paLocation.mOffset;
+  const TForteByte *previous = mInputs[mCommitted ^ 1] + paLocation.mOffset;
+  if(0 != paLocation.mMask) {
+    return ((*current ^ *previous) & paLocation.mMask) != 0;
+  }
+  return 0 != memcmp(current, previous, paLocation.mSize);
+}
+
+void IOProcessImage::readInput(const Location &paLocation, CIEC_ANY &paValue) const {
+  CCriticalRegion criticalRegion(mSyncMutex);
+  getValue(mInputs[mCommitted], paLocation, paValue);
+}
+
+bool IOProcessImage::stageOutput(const Location &paLocation, const CIEC_ANY &paValue) {
+  CCriticalRegion criticalRegion(mSyncMutex);
+  setValue(mOutputs, paLocation, paValue);
+  bool firstChange = !mOutputsChanged;
+  mOutputsChanged = true;
+  return firstChange;
+}
+
+bool IOProcessImage::resetOutput(const Location &paLocation) {
+  CCriticalRegion criticalRegion(mSyncMutex);
+  TForteByte *target = mOutputs + paLocation.mOffset;
+  if(0 != paLocation.mMask) {
+    *target = static_cast<TForteByte>(*target & ~paLocation.mMask);
+  } else {
+    memset(target, 0, paLocation.mSize);
+  }
+  bool firstChange = !mOutputsChanged;
+  mOutputsChanged = true;
+  return firstChange;
+}
+
+void IOProcessImage::readOutput(const Location &paLocation, CIEC_ANY &paValue) const {
+  CCriticalRegion criticalRegion(mSyncMutex);
+  getValue(mOutputs, paLocation, paValue);
+}
+
+bool IOProcessImage::flushOutputs(TForteByte *paTarget) {
+  CCriticalRegion criticalRegion(mSyncMutex);
+  if(!mOutputsChanged) {
+    return false;
+  }
+  memcpy(paTarget, mOutputs, mOutputSize);
+  mOutputsChanged = false;
+  ++mOutputFlushes;
+  return true;
+}
+
+void IOProcessImage::copyInputImage(TForteByte *paTarget) const {
+  CCriticalRegion criticalRegion(mSyncMutex);
+  memcpy(paTarget, mInputs[mCommitted], mInputSize);
+}
+
+void IOProcessImage::copyOutputImage(TForteByte *paTarget) const {
+  CCriticalRegion criticalRegion(mSyncMutex);
+  memcpy(paTarget, mOutputs, mOutputSize);
+}
+
+void IOProcessImage::getValue(const TForteByte *paImage, const Location &paLocation, CIEC_ANY &paValue) {
+  const TForteByte *source = paImage + paLocation.mOffset;
+  switch(paValue.getDataTypeID()){
+    case CIEC_ANY::e_BOOL:
+      static_cast<CIEC_BOOL&>(paValue) = (*source & paLocation.mMask) != 0;
+      break;
+    case CIEC_ANY::e_BYTE:
+      static_cast<CIEC_BYTE&>(paValue) = *source;
+      break;
+    case CIEC_ANY::e_WORD: {
+      TForteWord value;
+      memcpy(&value, source, sizeof(value));
+      static_cast<CIEC_WORD&>(paValue) = value;
+      break;
+    }
+    case CIEC_ANY::e_DWORD: {
+      TForteDWord value;
+      memcpy(&value, source, sizeof(value));
+      static_cast<CIEC_DWORD&>(paValue) = value;
+      break;
+    }
+#ifdef FORTE_USE_64BIT_DATATYPES
+    case CIEC_ANY::e_LWORD: {
+      TForteLWord value;
+      memcpy(&value, source, sizeof(value));
+      static_cast<CIEC_LWORD&>(paValue) = value;
+      break;
+    }
+#endif
+    default:
+      break;
+  }
+}
+
+void IOProcessImage::setValue(TForteByte *paImage, const Location &paLocation, const CIEC_ANY &paValue) {
+  TForteByte *target = paImage + paLocation.mOffset;
+  switch(paValue.getDataTypeID()){
+    case CIEC_ANY::e_BOOL:
+      if(static_cast<const CIEC_BOOL&>(paValue)) {
+        *target = static_cast<TForteByte>(*target | paLocation.mMask);
+      } else {
+        *target = static_cast<TForteByte>(*target & ~paLocation.mMask);
+      }
+      break;
+    case CIEC_ANY::e_BYTE:
+      *target = static_cast<const CIEC_BYTE&>(paValue);
+      break;
+    case CIEC_ANY::e_WORD: {
+      TForteWord value = static_cast<const CIEC_WORD&>(paValue);
+      memcpy(target, &value, sizeof(value));
+      break;
+    }
+    case CIEC_ANY::e_DWORD: {
+      TForteDWord value = static_cast<const CIEC_DWORD&>(paValue);
+      memcpy(target, &value, sizeof(value));
+      break;
+    }
+#ifdef FORTE_USE_64BIT_DATATYPES
+    case CIEC_ANY::e_LWORD: {
+      TForteLWord value = static_cast<const CIEC_LWORD&>(paValue);
+      memcpy(target, &value, sizeof(value));
+      break;
+    }
+#endif
+    default:
+      break;
+  }
+}
@@ -0,0 +1,155 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+
+#ifndef SRC_CORE_IO_MAPPER_IO_PROCESS_IMAGE_H_
+#define SRC_CORE_IO_MAPPER_IO_PROCESS_IMAGE_H_
+
+#include <forte_any.h>
+#include <forte_sync.h>
+
+namespace forte {
+  namespace core {
+    namespace io {
+
+      /*! @brief Cycle consistent process image of an IO device controller
+       *
+       * The input image is double buffered. The controller writes a complete bus scan into the scan buffer
+       * (see #beginInputScan) and publishes it with #commitInputs. Process interfaces always read from the last
+       * committed snapshot, so all inputs read in between two commits stem from the same bus scan.
+       *
+       * Outputs written by the process interfaces are staged and handed over to the controller in one transaction
+       * per cycle with #flushOutputs.
+       *
+       * The values are addressed by a pre-resolved #Location, which the handles of the controller compute once
+       * when they are created. Booleans are single bits, all other types are stored byte aligned in host byte order.
+       */
+      class IOProcessImage {
+        public:
+          //! Position of a value within the process image
+          struct Location {
+              unsigned int mOffset;
+              //! bit mask of a BOOL value, 0 for values spanning whole bytes
+              TForteByte mMask;
+              //! number of bytes of a value spanning whole bytes
+              unsigned int mSize;
+          };
+
+          IOProcessImage(unsigned int paInputSize, unsigned int paOutputSize);
+          ~IOProcessImage();
+
+          /*! @brief Computes the location of a value of the given type
+           *
+           * @param paType Data type of the value. Supported are BOOL, BYTE, WORD, DWORD and LWORD.
+           * @param paOffset Byte offset within the input or output image
+           * @param paPosition Bit position of a BOOL value within its byte
+           * @param paLocation Receives the location
+           * @return False if the type is not supported
+           */
+          static bool getLocation(CIEC_ANY::EDataTypeID paType, unsigned int paOffset, unsigned int paPosition, Location &paLocation);
+
+          unsigned int getInputSize() const {
+            return mInputSize;
+          }
+
+          unsigned int getOutputSize() const {
+            return mOutputSize;
+          }
+
+          bool isInInputImage(const Location &paLocation) const {
+            return paLocation.mOffset + getSize(paLocation) <= mInputSize;
+          }
+
+          bool isInOutputImage(const Location &paLocation) const {
+            return paLocation.mOffset + getSize(paLocation) <= mOutputSize;
+          }
+
+          /*! @brief Returns the buffer the controller writes the next bus scan to
+           *
+           * The buffer is initialized with the last committed snapshot, so inputs not updated by the scan keep their value.
+           * Only the controller thread may access the buffer until it calls #commitInputs.
+           */
+          TForteByte* beginInputScan();
+
+          //! Publishes the scan buffer as new snapshot, the previous snapshot is kept for #hasInputChanged
+          void commitInputs();
+
+          //! Checks if the value at the location differs between the last two committed snapshots
+          bool hasInputChanged(const Location &paLocation) const;
+
+          //! Reads a value from the last committed input snapshot
+          void readInput(const Location &paLocation, CIEC_ANY &paValue) const;
+
+          /*! @brief Stages an output value for the next #flushOutputs
+           *
+           * @return True if this is the first change staged since the last flush. The controller should be triggered then.
+           */
+          bool stageOutput(const Location &paLocation, const CIEC_ANY &paValue);
+
+          //! Stages zero for the output value, e.g., when its process interface is gone. Returns the same as #stageOutput.
+          bool resetOutput(const Location &paLocation);
+
+          //! Reads a staged output value
+          void readOutput(const Location &paLocation, CIEC_ANY &paValue) const;
+
+          /*! @brief Copies the staged outputs to the controller's transfer buffer
+           *
+           * @param paTarget Buffer of at least #getOutputSize bytes
+           * @return True if outputs changed since the last flush and have been copied
+           */
+          bool flushOutputs(TForteByte *paTarget);
+
+          //! Copies the last committed input snapshot, e.g., for monitoring. paTarget needs #getInputSize bytes.
+          void copyInputImage(TForteByte *paTarget) const;
+
+          //! Copies the staged outputs, e.g., for monitoring. paTarget needs #getOutputSize bytes.
+          void copyOutputImage(TForteByte *paTarget) const;
+
+          TForteUInt32 getNrOfInputCommits() const {
+            return mInputCommits;
+          }
+
+          TForteUInt32 getNrOfOutputFlushes() const {
+            return mOutputFlushes;
+          }
+
+        private:
+          static unsigned int getSize(const Location &paLocation) {
+            return (0 != paLocation.mMask) ? 1 : paLocation.mSize;
+          }
+
+          static void getValue(const TForteByte *paImage, const Location &paLocation, CIEC_ANY &paValue);
+          static void setValue(TForteByte *paImage, const Location &paLocation, const CIEC_ANY &paValue);
+
+          const unsigned int mInputSize;
+          const unsigned int mOutputSize;
+
+          //! the committed snapshot and the scan buffer, which holds the previous snapshot right after a commit
+          TForteByte *mInputs[2];
+          unsigned int mCommitted;
+
+          TForteByte *mOutputs;
+          bool mOutputsChanged;
+
+          TForteUInt32 mInputCommits;
+          TForteUInt32 mOutputFlushes;
+
+          mutable CSyncObject mSyncMutex;
+
+          IOProcessImage(const IOProcessImage&);
+          IOProcessImage& operator=(const IOProcessImage&);
+      };
+
+    } //namespace IO
+  } //namepsace core
+} //namespace forte
+
+#endif /* SRC_CORE_IO_MAPPER_IO_PROCESS_IMAGE_H_ */
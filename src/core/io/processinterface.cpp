@@ -28,6 +28,7 @@ ProcessInterface::ProcessInterface(CResource *paSrcRes, const SFBInterfaceSpec *
     CProcessInterfaceBase(paSrcRes, paInterfaceSpec, paInstanceNameId, paFBConnData, paFBVarsData), IOObserver() {
   mIsListening = false;
   mIsReady = false;
+  mImage = 0;
 }
 
 ProcessInterface::~ProcessInterface() {
@@ -68,7 +69,11 @@ bool ProcessInterface::read(CIEC_ANY &paData) {
     return false;
   }
 
-  mHandle->get(paData);
+  if(0 != mImage) {
+    mImage->readInput(mImageLocation, paData);
+  } else {
+    mHandle->get(paData);
+  }
 
   return true;
 }
@@ -90,6 +95,12 @@ bool ProcessInterface::read() {
     return false;
   }
 
+  if(0 != mImage) {
+    // the type of the handle has been checked when it was connected
+    mImage->readInput(mImageLocation, *getDO(2));
+    return true;
+  }
+
   if(mHandle->is(CIEC_ANY::e_BOOL)) {
     mHandle->get(IN_X());
   } else if(mHandle->is(CIEC_ANY::e_WORD)) {
@@ -144,6 +155,7 @@ void ProcessInterface::onHandle(IOHandle* paHandle) {
 
     if(mDirection == IOMapper::In) {
       setEventChainExecutor(m_poInvokingExecEnv);
+      mImage = paHandle->getProcessImage(mImageLocation);
     }
 
     STATUS() = scmOK;
@@ -163,6 +175,7 @@ void ProcessInterface::dropHandle() {
 
   IOObserver::dropHandle();
 
+  mImage = 0;
   QO() = false;
   STATUS() = scmWaitingForHandle;
   mIsReady = false;
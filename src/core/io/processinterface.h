@@ -67,6 +67,10 @@ namespace forte {
         private:
           bool mIsListening;
           bool mIsReady;
+
+          //! process image of the handle and the pre-resolved location of the value, 0 if the handle has none
+          IOProcessImage *mImage;
+          IOProcessImage::Location mImageLocation;
           CSyncObject mSyncMutex;
 
           static const char * const scmOK;
@@ -10,6 +10,8 @@
  *    Alois Zoitl, Gunnar Grabmaier, Thomas Strasser, Gerhard Ebenhofer,
  *    Martin Melik Merkumians, Ingo Hegny,
  *      - initial implementation and rework communication infrastructure
+ *    agent - added monitoring subscriptions
+ *    agent - added history query
  *******************************************************************************/
 #ifndef _MGMCMD_H_
 #define _MGMCMD_H_
@@ -212,6 +214,16 @@ enum EMGMCommandType{
    *    - m_sAdditionalParams the read value is stored here
    */
   cg_nMGM_CMD_QUERY_AdapterType = 0x87,
+
+  /*! \brief Read the history of a signal from the history store of the device.
+   *
+   * The parameters of the SManagementCMD are defined as:
+   *    - m_sFirstParam = name of the signal
+   *    - m_sSecondParam = not used
+   *    - m_sAdditionalParams = tier, start and end time separated by ';', each of them may be empty
+   *    - mResponse the history as JSON
+   */
+  cg_nMGM_CMD_QUERY_History = 0x97,
 #endif
 
   /*! \brief reset a FB, resource or the device.
@@ -235,6 +247,11 @@ enum EMGMCommandType{
   cg_nMGM_CMD_Monitoring_ClearForce = 0x6A,
   cg_nMGM_CMD_Monitoring_Trigger_Event = 0x7A,
   cg_nMGM_CMD_Monitoring_Reset_Event_Count = 0x8A,
+  /*! \brief Subscribe a data point for the monitoring stream
+   *    - mFirstParam = name of the data point
+   *    - mAdditionalParams = sampling period in ms, optionally followed by ';' and the deadband
+   */
+  cg_nMGM_CMD_Monitoring_Subscribe = 0x9A,
 #endif // FORTE_SUPPORT_MONITORING
 
 
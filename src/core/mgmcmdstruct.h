@@ -9,6 +9,7 @@
  * Contributors:
  *    Ingo Hegny, Alois Zoitl
  *      - initial implementation and rework communication infrastructure
+ *    agent - segmented and paged responses of list queries
  *******************************************************************************/
 #ifndef MGMCMDSTRUCT_H_
 #define MGMCMDSTRUCT_H_
@@ -16,6 +17,7 @@
 #include <mgmcmd.h>
 #include <forte_string.h>
 #include <fixedcapvector.h>
+#include "mgmresponse.h"
 
 namespace forte {
   namespace core {
@@ -75,10 +77,11 @@ namespace forte {
         /*\brief pointer to the ID to generate the correct response */
         char *mID;
 
-#ifdef FORTE_SUPPORT_MONITORING
-        /*\brief pointer to the response to generate the correct response */
-        CIEC_STRING mMonitorResponse;
-#endif
+        /*\brief Result of commands returning lists (e.g., query FBs, query connections, read watches)
+         *
+         * The issuer of the command resets the buffer with the requested cursor and the maximum page size.
+         */
+        CMGMResponseBuffer mResponse;
 
     };
 
@@ -0,0 +1,153 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include "mgmresponse.h"
+#include <string.h>
+
+using namespace forte::core;
+
+namespace {
+  //! the length of a CIEC_STRING is stored in 16 bit and one byte is needed for the terminating \0
+  const size_t scmMaxStringLength = 65534;
+}
+
+CMGMResponseBuffer::CMGMResponseBuffer() :
+    mFirst(0), mCurrent(0), mLength(0), mLimit(0), mCursor(0), mEntryIndex(0), mEntriesTaken(0), mNextCursor(0),
+    mEntrySegment(0), mEntrySegmentUsed(0), mEntryLength(0){
+}
+
+CMGMResponseBuffer::~CMGMResponseBuffer(){
+  while(0 != mFirst){
+    SSegment *segment = mFirst;
+    mFirst = segment->mNext;
+    delete[] segment->mData;
+    delete segment;
+  }
+}
+
+void CMGMResponseBuffer::reset(TForteUInt32 paCursor, size_t paLimit){
+  for(SSegment *segment = mFirst; 0 != segment; segment = segment->mNext){
+    segment->mUsed = 0;
+  }
+  mCurrent = mFirst;
+  mLength = 0;
+  mLimit = paLimit;
+  mCursor = paCursor;
+  mEntryIndex = 0;
+  mEntriesTaken = 0;
+  mNextCursor = 0;
+}
+
+void CMGMResponseBuffer::append(const char *paText){
+  if(0 != paText){
+    append(paText, strlen(paText));
+  }
+}
+
+void CMGMResponseBuffer::append(const char *paText, size_t paLength){
+  while(0 != paLength){
+    provideSpace(1);
+    size_t chunk = mCurrent->mCapacity - mCurrent->mUsed;
+    if(chunk > paLength){
+      chunk = paLength;
+    }
+    memcpy(mCurrent->mData + mCurrent->mUsed, paText, chunk);
+    mCurrent->mUsed += chunk;
+    mLength += chunk;
+    paText += chunk;
+    paLength -= chunk;
+  }
+}
+
+char *CMGMResponseBuffer::reserve(size_t paSize){
+  provideSpace(paSize);
+  return mCurrent->mData + mCurrent->mUsed;
+}
+
+void CMGMResponseBuffer::commit(size_t paSize){
+  mCurrent->mUsed += paSize;
+  mLength += paSize;
+}
+
+bool CMGMResponseBuffer::beginEntry(const char *paSeparator){
+  TForteUInt32 index = mEntryIndex++;
+  if((0 != mNextCursor) || (index < mCursor)){
+    return false;
+  }
+  provideSpace(1);
+  mEntrySegment = mCurrent;
+  mEntrySegmentUsed = mCurrent->mUsed;
+  mEntryLength = mLength;
+  if(0 != mEntriesTaken){
+    append(paSeparator);
+  }
+  return true;
+}
+
+void CMGMResponseBuffer::endEntry(){
+  //the first entry is always taken, otherwise a too large entry would block all further pages
+  if((0 != mLimit) && (mLength > mLimit) && (0 != mEntriesTaken)){
+    for(SSegment *segment = mEntrySegment->mNext; 0 != segment; segment = segment->mNext){
+      segment->mUsed = 0;
+    }
+    mEntrySegment->mUsed = mEntrySegmentUsed;
+    mCurrent = mEntrySegment;
+    mLength = mEntryLength;
+    mNextCursor = mEntryIndex - 1;
+  } else {
+    ++mEntriesTaken;
+  }
+}
+
+void CMGMResponseBuffer::copyTo(char *paDestination) const {
+  for(SSegment *segment = mFirst; 0 != segment; segment = segment->mNext){
+    memcpy(paDestination, segment->mData, segment->mUsed);
+    paDestination += segment->mUsed;
+  }
+}
+
+void CMGMResponseBuffer::appendTo(CIEC_STRING &paString) const {
+  size_t available = scmMaxStringLength - paString.length();
+  size_t toCopy = (mLength < available) ? mLength : available;
+  paString.reserve(static_cast<TForteUInt16>(paString.length() + toCopy));
+  for(SSegment *segment = mFirst; (0 != segment) && (0 != toCopy); segment = segment->mNext){
+    size_t chunk = (segment->mUsed < toCopy) ? segment->mUsed : toCopy;
+    paString.append(segment->mData, static_cast<TForteUInt16>(chunk));
+    toCopy -= chunk;
+  }
+}
+
+CMGMResponseBuffer::SSegment *CMGMResponseBuffer::createSegment(size_t paCapacity){
+  SSegment *segment = new SSegment;
+  segment->mNext = 0;
+  segment->mData = new char[paCapacity];
+  segment->mCapacity = paCapacity;
+  segment->mUsed = 0;
+  return segment;
+}
+
+void CMGMResponseBuffer::provideSpace(size_t paSize){
+  if((0 != mCurrent) && (mCurrent->mCapacity - mCurrent->mUsed >= paSize)){
+    return;
+  }
+  if(0 == mCurrent){
+    //first use of the buffer
+    mFirst = mCurrent = createSegment((paSize > scmSegmentSize) ? paSize : scmSegmentSize);
+  } else if((0 != mCurrent->mNext) && (mCurrent->mNext->mCapacity >= paSize)){
+    //reuse the segments kept from former responses
+    mCurrent = mCurrent->mNext;
+  } else {
+    SSegment *segment = createSegment((paSize > scmSegmentSize) ? paSize : scmSegmentSize);
+    segment->mNext = mCurrent->mNext;
+    mCurrent->mNext = segment;
+    mCurrent = segment;
+  }
+}
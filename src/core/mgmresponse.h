@@ -0,0 +1,131 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#ifndef _MGMRESPONSE_H_
+#define _MGMRESPONSE_H_
+
+#include <forte_string.h>
+#include <stddef.h>
+
+namespace forte {
+  namespace core {
+
+    /*!\brief Buffer for the potentially large results of management commands (e.g., query or read watches)
+     *
+     * The text is stored in a chain of fixed size segments. Appending never moves already written text, so
+     * creating a response is linear in its size and the size is not limited by the 16 bit length of CIEC_STRING.
+     * The segments are kept when the buffer is reset so that following commands do not need to allocate again.
+     *
+     * Results of list queries are written as entries (e.g., one FB or one connection). With a cursor the first
+     * entries are skipped and with a limit the buffer stops taking entries when the next one would exceed it.
+     * The index of the first entry left out is the cursor for requesting the next page.
+     */
+    class CMGMResponseBuffer{
+      public:
+        static const size_t scmSegmentSize = 4096;
+
+        CMGMResponseBuffer();
+        ~CMGMResponseBuffer();
+
+        /*!\brief Removes the content and starts a new page
+         *
+         * @param paCursor index of the first entry to be taken into the buffer
+         * @param paLimit maximum length of the content taken entries must not exceed, 0 for no limit
+         */
+        void reset(TForteUInt32 paCursor = 0, size_t paLimit = 0);
+
+        size_t length() const {
+          return mLength;
+        }
+
+        //! Maximum length of the content given to reset(), 0 for no limit
+        size_t getLimit() const {
+          return mLimit;
+        }
+
+        bool isEmpty() const {
+          return (0 == mLength);
+        }
+
+        void append(const char *paText);
+        void append(const char *paText, size_t paLength);
+
+        /*!\brief Provides paSize bytes of contiguous space at the end of the content, e.g., for a toString call
+         *
+         * The bytes become part of the content with commit().
+         */
+        char *reserve(size_t paSize);
+
+        //! Adds paSize bytes of the space provided by the last reserve() call to the content
+        void commit(size_t paSize);
+
+        /*!\brief Starts the next entry of a list
+         *
+         * @param paSeparator text put in front of the entry if it is not the first one in the buffer
+         * @return false if the entry is not part of this page, nothing may be written for it then
+         */
+        bool beginEntry(const char *paSeparator);
+
+        //! Completes the entry started with beginEntry(), removes it again if it exceeds the limit
+        void endEntry();
+
+        /*!\brief Index of the first entry which was left out because of the limit
+         *
+         * @return the cursor for the next page, 0 if the buffer holds all remaining entries
+         */
+        TForteUInt32 getNextCursor() const {
+          return mNextCursor;
+        }
+
+        //! Copies the content to paDestination, which needs space for length() bytes
+        void copyTo(char *paDestination) const;
+
+        /*!\brief Appends the content to the string
+         *
+         * The string is enlarged only once. Content beyond the maximum string length is cut off.
+         */
+        void appendTo(CIEC_STRING &paString) const;
+
+      private:
+        struct SSegment{
+            SSegment *mNext;
+            char *mData;
+            size_t mCapacity;
+            size_t mUsed;
+        };
+
+        SSegment *createSegment(size_t paCapacity);
+        //! Makes the current segment one with at least paSize free bytes
+        void provideSpace(size_t paSize);
+
+        SSegment *mFirst;
+        SSegment *mCurrent;
+        size_t mLength;
+        size_t mLimit;
+
+        TForteUInt32 mCursor;
+        TForteUInt32 mEntryIndex;
+        TForteUInt32 mEntriesTaken;
+        TForteUInt32 mNextCursor;
+
+        //! state of the buffer when the open entry started, for removing it again
+        SSegment *mEntrySegment;
+        size_t mEntrySegmentUsed;
+        size_t mEntryLength;
+
+        CMGMResponseBuffer(const CMGMResponseBuffer&);
+        CMGMResponseBuffer& operator =(const CMGMResponseBuffer &);
+    };
+
+  }
+}
+
+#endif /* _MGMRESPONSE_H_ */
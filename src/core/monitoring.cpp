@@ -9,6 +9,8 @@
  * Contributors:
  *    Alois Zoitl
  *      - initial implementation and rework communication infrastructure
+ *    agent - added subscriptions streamed over a dedicated connection
+ *    agent - write watches into the segmented response buffer
  *******************************************************************************/
 #include "monitoring.h"
 #include "resource.h"
@@ -16,15 +18,30 @@
 #include "ecet.h"
 #include "utils/criticalregion.h"
 #include "utils/string_utils.h"
+#ifdef FORTE_SUPPORT_MONITORING_STREAM
+#include "monitoringstreamserver.h"
+#include <stdlib.h>
+#endif
 
 
 using namespace forte::core;
 
 CMonitoringHandler::CMonitoringHandler(CResource &paResource) :
+#ifdef FORTE_SUPPORT_MONITORING_STREAM
+    mStream(0), mStreamServer(0), mLastSubscriptionId(0),
+#endif
     mTriggerEvent(0, 0),
         mResource(paResource){
 }
 
+CMonitoringHandler::~CMonitoringHandler(){
+#ifdef FORTE_SUPPORT_MONITORING_STREAM
+  //the resource's execution thread is already gone, so the stream can be deleted without detaching it
+  delete mStream;
+  delete mStreamServer;
+#endif
+}
+
 EMGMResponse CMonitoringHandler::executeMonitoringCommand(SManagementCMD &paCommand){
   EMGMResponse retVal = e_UNSUPPORTED_CMD;
 
@@ -36,7 +53,7 @@ EMGMResponse CMonitoringHandler::executeMonitoringCommand(SManagementCMD &paComm
       retVal = removeWatch(paCommand.mFirstParam);
       break;
     case cg_nMGM_CMD_Monitoring_Read_Watches:
-      retVal = readWatches(paCommand.mMonitorResponse);
+      retVal = readWatches(paCommand.mResponse);
       break;
     case cg_nMGM_CMD_Monitoring_Force:
       retVal = mResource.writeValue(paCommand.mFirstParam, paCommand.mAdditionalParams, true);
@@ -50,16 +67,24 @@ EMGMResponse CMonitoringHandler::executeMonitoringCommand(SManagementCMD &paComm
     case cg_nMGM_CMD_Monitoring_Reset_Event_Count:
       retVal = resetEventCount(paCommand.mFirstParam);
       break;
+#ifdef FORTE_SUPPORT_MONITORING_STREAM
+    case cg_nMGM_CMD_Monitoring_Subscribe:
+      retVal = subscribe(paCommand.mFirstParam, paCommand.mAdditionalParams);
+      break;
+#endif
     default:
       break;
   }
   return retVal;
 }
 
-CFunctionBlock* CMonitoringHandler::getFB(forte::core::TNameIdentifier &paNameList){
+CFunctionBlock* CMonitoringHandler::getFB(forte::core::TNameIdentifier &paNameList, CFunctionBlock **paContainedFB){
   forte::core::TNameIdentifier::CIterator runner(paNameList.begin());
 
   CFunctionBlock *fb = mResource.getContainedFB(runner);
+  if(0 != paContainedFB){
+    *paContainedFB = fb;
+  }
   if((0 != fb) && (!runner.isLastEntry())){
     ++runner;
     fb = fb->getFB(runner);
@@ -134,12 +159,17 @@ EMGMResponse CMonitoringHandler::removeWatch(forte::core::TNameIdentifier &paNam
       itRefNode = itRunner;
       ++itRunner;
     }
+#ifdef FORTE_SUPPORT_MONITORING_STREAM
+    if(unsubscribe(*fB, portName)){
+      eRetVal = e_RDY;
+    }
+#endif
   }
   return eRetVal;
 }
 
-EMGMResponse CMonitoringHandler::readWatches(CIEC_STRING &paResponse){
-  paResponse.clear();
+EMGMResponse CMonitoringHandler::readWatches(forte::core::CMGMResponseBuffer &paResponse){
+  paResponse.reset();
   if(0 == mResource.getResourcePtr()){
     //we are in the device
     for(CFBContainer::TFunctionBlockList::Iterator itRunner = mResource.getFBList().begin();
@@ -165,7 +195,7 @@ EMGMResponse CMonitoringHandler::clearForce(forte::core::TNameIdentifier &paName
   if(0 != fB){
     CIEC_ANY *poDataVal = fB->getVar(&portName, 1);
     if(0 != poDataVal){
-      poDataVal->setForced(false);
+      fB->setForced(poDataVal, false);
       eRetVal = e_RDY;
     }
   }
@@ -320,7 +350,7 @@ bool CMonitoringHandler::removeEventWatch(SFBMonitoringEntry &paFBMonitoringEntr
   return bRetVal;
 }
 
-void CMonitoringHandler::readResourceWatches(CIEC_STRING &paResponse){
+void CMonitoringHandler::readResourceWatches(forte::core::CMGMResponseBuffer &paResponse){
   if(!mFBMonitoringList.isEmpty()){
     paResponse.append("<Resource name=\"");
     paResponse.append(mResource.getInstanceName());
@@ -367,12 +397,12 @@ void CMonitoringHandler::updateMonitringData(){
 }
 
 
-void CMonitoringHandler::appendDataWatch(CIEC_STRING &paResponse,
+void CMonitoringHandler::appendDataWatch(forte::core::CMGMResponseBuffer &paResponse,
     SDataWatchEntry &paDataWatchEntry){
   size_t bufferSize = paDataWatchEntry.mDataBuffer->getToStringBufferSize() + getExtraSizeForEscapedChars(*paDataWatchEntry.mDataBuffer);
   appendPortTag(paResponse, paDataWatchEntry.mPortId);
   paResponse.append("<Data value=\"");
-  char* acDataValue = new char [bufferSize]; //TODO try to directly use the response string instead
+  char* acDataValue = paResponse.reserve(bufferSize);
   int consumedBytes = -1;
   switch (paDataWatchEntry.mDataBuffer->getDataTypeID()){
     case CIEC_ANY::e_WSTRING:
@@ -393,14 +423,12 @@ void CMonitoringHandler::appendDataWatch(CIEC_STRING &paResponse,
       consumedBytes = paDataWatchEntry.mDataBuffer->toString(acDataValue, bufferSize);
       break;
   }
-  if(-1 != consumedBytes){
-    acDataValue[consumedBytes] = '\0';
+  if(0 < consumedBytes){
+    paResponse.commit(static_cast<size_t>(consumedBytes));
   }
-  paResponse.append(acDataValue);
   paResponse.append("\" forced=\"");
   paResponse.append((paDataWatchEntry.mDataBuffer->isForced()) ? "true" : "false");
   paResponse.append("\"/></Port>");
-  delete [] acDataValue;
 }
 
 size_t CMonitoringHandler::getExtraSizeForEscapedChars(const CIEC_ANY& paDataValue){
@@ -470,26 +498,30 @@ size_t CMonitoringHandler::getExtraSizeForEscapedCharsStruct(const CIEC_STRUCT&
   return retVal;
 }
 
-void CMonitoringHandler::appendPortTag(CIEC_STRING &paResponse,
+void CMonitoringHandler::appendPortTag(forte::core::CMGMResponseBuffer &paResponse,
     CStringDictionary::TStringId paPortId){
   paResponse.append("<Port name=\"");
   paResponse.append(CStringDictionary::getInstance().get(paPortId));
   paResponse.append("\">");
 }
 
-void CMonitoringHandler::appendEventWatch(CIEC_STRING &paResponse, SEventWatchEntry &paEventWatchEntry){
+void CMonitoringHandler::appendEventWatch(forte::core::CMGMResponseBuffer &paResponse, SEventWatchEntry &paEventWatchEntry){
   appendPortTag(paResponse, paEventWatchEntry.mPortId);
 
   CIEC_UDINT udint(paEventWatchEntry.mEventDataBuf);
   CIEC_ULINT ulint(mResource.getDevice().getTimer().getForteTime());
 
   paResponse.append("<Data value=\"");
-  char buf[21]; // the bigest number in an ulint is 18446744073709551616, TODO directly use pa_roResponse
-  udint.toString(buf, sizeof(buf));
-  paResponse.append(buf);
+  const size_t bufferSize = 21; // the bigest number in an ulint is 18446744073709551616
+  int consumedBytes = udint.toString(paResponse.reserve(bufferSize), bufferSize);
+  if(0 < consumedBytes){
+    paResponse.commit(static_cast<size_t>(consumedBytes));
+  }
   paResponse.append("\" time=\"");
-  ulint.toString(buf, sizeof(buf));
-  paResponse.append(buf);
+  consumedBytes = ulint.toString(paResponse.reserve(bufferSize), bufferSize);
+  if(0 < consumedBytes){
+    paResponse.commit(static_cast<size_t>(consumedBytes));
+  }
   paResponse.append("\"/>\n</Port>");
 }
 
@@ -502,3 +534,90 @@ void CMonitoringHandler::createFullFBName(CIEC_STRING &paFullName, forte::core::
   }
 }
 
+#ifdef FORTE_SUPPORT_MONITORING_STREAM
+
+EMGMResponse CMonitoringHandler::subscribe(forte::core::TNameIdentifier &paNameList, const CIEC_STRING &paParameters){
+  const char *parameters = paParameters.getValue();
+  char *parseEnd;
+  unsigned long period = strtoul(parameters, &parseEnd, 10);
+  if(parseEnd == parameters){
+    return e_BAD_PARAMS;
+  }
+  double deadband = 0.0;
+  if(';' == *parseEnd){
+    const char *deadbandStart = parseEnd + 1;
+    deadband = strtod(deadbandStart, &parseEnd);
+    if((parseEnd == deadbandStart) || (0.0 > deadband)){
+      return e_BAD_PARAMS;
+    }
+  }
+
+  CIEC_STRING fullName;
+  if(0 != mResource.getResourcePtr()){
+    //within a resource the name list does not contain the resource
+    fullName = mResource.getInstanceName();
+    fullName.append(".");
+  }
+  createFullFBName(fullName, paNameList);
+
+  CStringDictionary::TStringId portName = paNameList.back();
+  paNameList.popBack();
+  CFunctionBlock *containedFB = 0;
+  CFunctionBlock *fB = getFB(paNameList, &containedFB);
+  CIEC_ANY *dataVal = (0 != fB) ? fB->getVar(&portName, 1) : 0;
+  if(0 == dataVal){
+    return e_NO_SUCH_OBJECT;
+  }
+
+  CMonitoringHandler &deviceHandler(getDeviceMonitoringHandler());
+  CMonitoringStreamServer *server = deviceHandler.getStreamServer();
+  if(0 == server){
+    return e_INVALID_STATE;
+  }
+  CMonitoringStream &stream(fB->getResource().getMonitoringHandler().getStream());
+  server->registerStream(stream);
+  stream.subscribe(++deviceHandler.mLastSubscriptionId, fullName.getValue(), *dataVal, static_cast<TForteUInt32>(period), deadband, containedFB);
+  return e_RDY;
+}
+
+bool CMonitoringHandler::unsubscribe(CFunctionBlock &paFB, CStringDictionary::TStringId paPortId){
+  CIEC_ANY *dataVal = paFB.getVar(&paPortId, 1);
+  CMonitoringHandler &resourceHandler(paFB.getResource().getMonitoringHandler());
+  return (0 != dataVal) && (0 != resourceHandler.mStream) && resourceHandler.mStream->unsubscribe(*dataVal);
+}
+
+void CMonitoringHandler::unsubscribe(const CFunctionBlock &paFB){
+  if(0 != mStream){
+    mStream->unsubscribe(paFB);
+  }
+}
+
+CMonitoringHandler &CMonitoringHandler::getDeviceMonitoringHandler(){
+  return (0 == mResource.getResourcePtr()) ? *this : mResource.getDevice().getMonitoringHandler();
+}
+
+CMonitoringStream &CMonitoringHandler::getStream(){
+  if(0 == mStream){
+    mStream = new CMonitoringStream(FORTE_MONITORING_STREAM_RING_SIZE, mResource.m_oResDataConSync);
+    CEventChainExecutionThread *execution = mResource.getResourceEventExecution();
+    if(0 != execution){
+      mStream->setExecutionThread(execution);
+      //publishes the completely set up stream to the already running execution thread
+      execution->setMonitoringStream(mStream);
+    }
+  }
+  return *mStream;
+}
+
+CMonitoringStreamServer *CMonitoringHandler::getStreamServer(){
+  if(0 == mStreamServer){
+    mStreamServer = new CMonitoringStreamServer(static_cast<CDevice&>(mResource).getDeviceExecution());
+    if(!mStreamServer->open(FORTE_MONITORING_STREAM_PORT)){
+      delete mStreamServer;
+      mStreamServer = 0;
+    }
+  }
+  return mStreamServer;
+}
+
+#endif //FORTE_SUPPORT_MONITORING_STREAM
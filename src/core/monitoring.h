@@ -10,10 +10,13 @@
  * Contributors:
  *    Alois Zoitl
  *      - initial implementation and rework communication infrastructure
+ *    agent - added subscriptions streamed over a dedicated connection
+ *    agent - write watches into the segmented response buffer
  *******************************************************************************/
 #ifndef MONITORING_H_
 #define MONITORING_H_
 
+#include <forte_config.h>
 #include "mgmcmdstruct.h"
 #include "fortelist.h"
 #include "event.h"
@@ -22,6 +25,9 @@
 #include "../arch/timerha.h"
 #include "datatypes/forte_array.h"
 #include "datatypes/forte_struct.h"
+#ifdef FORTE_SUPPORT_MONITORING_STREAM
+#include "monitoringstream.h"
+#endif
 
 class CFunctionBlock;
 class CResource;
@@ -29,15 +35,26 @@ class CResource;
 namespace forte {
   namespace core {
 
+    class CMonitoringStreamServer;
+
     /*!\brief class that handles all monitoring tasks
      *
+     * Besides the watches read with polling requests data points can be subscribed with a sampling period and a
+     * deadband. Their changes are captured by the resource's execution thread and pushed to the client connected to
+     * the device's monitoring stream server (see CMonitoringStream).
      */
     class CMonitoringHandler{
       public:
         explicit CMonitoringHandler(CResource &paResource);
+        ~CMonitoringHandler();
 
         EMGMResponse executeMonitoringCommand(SManagementCMD &paCommand);
 
+#ifdef FORTE_SUPPORT_MONITORING_STREAM
+        //! Removes the subscriptions of the function block's data points, has to be called before it is deleted
+        void unsubscribe(const CFunctionBlock &paFB);
+#endif
+
       private:
         class  SDataWatchEntry{
           public:
@@ -84,11 +101,15 @@ namespace forte {
 
         typedef CSinglyLinkedList<SFBMonitoringEntry> TFBMonitoringList;
 
-        CFunctionBlock* getFB(forte::core::TNameIdentifier &paNameList);
+        /*!\brief Looks up the function block, which may also be contained in a composite or be an adapter
+         *
+         * @param paContainedFB if given it is set to the function block in the resource's network containing the found one
+         */
+        CFunctionBlock* getFB(forte::core::TNameIdentifier &paNameList, CFunctionBlock **paContainedFB = 0);
 
         EMGMResponse addWatch(forte::core::TNameIdentifier &paNameList);
         EMGMResponse removeWatch(forte::core::TNameIdentifier &paNameList);
-        EMGMResponse readWatches(CIEC_STRING &pa_roResponse);
+        EMGMResponse readWatches(forte::core::CMGMResponseBuffer &paResponse);
         EMGMResponse clearForce(forte::core::TNameIdentifier &paNameList);
         EMGMResponse triggerEvent(forte::core::TNameIdentifier &paNameList);
         EMGMResponse resetEventCount(forte::core::TNameIdentifier &paNameList);
@@ -98,15 +119,15 @@ namespace forte {
         static bool removeDataWatch(SFBMonitoringEntry& pa_roFBMonitoringEntry, CStringDictionary::TStringId pa_unPortId);
         static void addEventWatch(SFBMonitoringEntry& paFBMonitoringEntry, CStringDictionary::TStringId paPortId, TForteUInt32& paEventData);
         static bool removeEventWatch(SFBMonitoringEntry& pa_roFBMonitoringEntry, CStringDictionary::TStringId pa_unPortId);
-        void readResourceWatches(CIEC_STRING &pa_roResponse);
+        void readResourceWatches(forte::core::CMGMResponseBuffer &paResponse);
 
         void updateMonitringData();
 
-        static void appendDataWatch(CIEC_STRING &pa_roResponse,
+        static void appendDataWatch(forte::core::CMGMResponseBuffer &paResponse,
             SDataWatchEntry &pa_roDataWatchEntry);
-        static void appendPortTag(CIEC_STRING &pa_roResponse,
+        static void appendPortTag(forte::core::CMGMResponseBuffer &paResponse,
             CStringDictionary::TStringId pa_unPortId);
-        void appendEventWatch(CIEC_STRING &pa_roResponse, SEventWatchEntry &pa_roEventWatchEntry);
+        void appendEventWatch(forte::core::CMGMResponseBuffer &paResponse, SEventWatchEntry &pa_roEventWatchEntry);
 
         static void createFullFBName(CIEC_STRING &paFullName, forte::core::TNameIdentifier &paNameList);
 
@@ -116,6 +137,22 @@ namespace forte {
 
         static size_t getExtraSizeForEscapedCharsStruct(const CIEC_STRUCT& paDataValue);
 
+#ifdef FORTE_SUPPORT_MONITORING_STREAM
+        EMGMResponse subscribe(forte::core::TNameIdentifier &paNameList, const CIEC_STRING &paParameters);
+        bool unsubscribe(CFunctionBlock &paFB, CStringDictionary::TStringId paPortId);
+
+        CMonitoringHandler &getDeviceMonitoringHandler();
+        //! the stream of this resource, created with the first subscription
+        CMonitoringStream &getStream();
+        //! the stream server of the device, opened with the first subscription
+        CMonitoringStreamServer *getStreamServer();
+
+        CMonitoringStream *mStream;
+        CMonitoringStreamServer *mStreamServer;
+        //! last id given to a subscription, only used in the device's handler
+        TForteUInt32 mLastSubscriptionId;
+#endif
+
         //!List storing all FBs which are currently monitored
         TFBMonitoringList mFBMonitoringList;
 
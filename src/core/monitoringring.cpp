@@ -0,0 +1,79 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include "monitoringring.h"
+#include <string.h>
+
+using namespace forte::core;
+
+CMonitoringRing::CMonitoringRing(unsigned int paSize) :
+    mBuffer(0), mCapacity(scmSizeFieldSize * 2), mWritten(0), mRead(0), mDropped(0){
+  while(mCapacity < paSize){
+    mCapacity <<= 1;
+  }
+  mBuffer = new TForteByte[mCapacity];
+}
+
+CMonitoringRing::~CMonitoringRing(){
+  delete[] mBuffer;
+}
+
+bool CMonitoringRing::write(const TForteByte *paData, unsigned int paSize){
+  TForteUInt32 written = mWritten.load();
+  TForteUInt32 used = written - mRead.load();
+  if((0 == paSize) || (paSize + scmSizeFieldSize > mCapacity - used)){
+    mDropped.fetchAdd(1);
+    return false;
+  }
+  TForteUInt32 size = paSize;
+  copyIn(written, reinterpret_cast<const TForteByte*>(&size), scmSizeFieldSize);
+  copyIn(written + scmSizeFieldSize, paData, paSize);
+  mWritten.store(written + scmSizeFieldSize + paSize);
+  return true;
+}
+
+unsigned int CMonitoringRing::getNextSize() const {
+  TForteUInt32 read = mRead.load();
+  if(read == mWritten.load()){
+    return 0;
+  }
+  TForteUInt32 size;
+  copyOut(read, reinterpret_cast<TForteByte*>(&size), scmSizeFieldSize);
+  return size;
+}
+
+unsigned int CMonitoringRing::read(TForteByte *paBuffer){
+  unsigned int size = getNextSize();
+  if(0 != size){
+    TForteUInt32 read = mRead.load();
+    copyOut(read + scmSizeFieldSize, paBuffer, size);
+    mRead.store(read + scmSizeFieldSize + size);
+  }
+  return size;
+}
+
+TForteUInt32 CMonitoringRing::getNrOfDroppedRecords() const {
+  return mDropped.load();
+}
+
+void CMonitoringRing::copyIn(TForteUInt32 paPosition, const TForteByte *paData, unsigned int paSize){
+  unsigned int offset = paPosition & (mCapacity - 1);
+  unsigned int firstPart = (paSize < mCapacity - offset) ? paSize : (mCapacity - offset);
+  memcpy(mBuffer + offset, paData, firstPart);
+  memcpy(mBuffer, paData + firstPart, paSize - firstPart);
+}
+
+void CMonitoringRing::copyOut(TForteUInt32 paPosition, TForteByte *paData, unsigned int paSize) const {
+  unsigned int offset = paPosition & (mCapacity - 1);
+  unsigned int firstPart = (paSize < mCapacity - offset) ? paSize : (mCapacity - offset);
+  memcpy(paData, mBuffer + offset, firstPart);
+  memcpy(paData + firstPart, mBuffer, paSize - firstPart);
+}
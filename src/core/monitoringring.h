@@ -0,0 +1,78 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#ifndef _MONITORINGRING_H_
+#define _MONITORINGRING_H_
+
+#include <datatype.h>
+#include <forte_atomic.h>
+
+namespace forte {
+  namespace core {
+
+    /*!\brief Lock-free ring of variable sized records with a single producer and a single consumer
+     *
+     * The producer is the event chain execution thread capturing monitoring samples, the consumer is the thread
+     * streaming them to the monitoring client. Both sides only advance their own free-running byte counter, so none
+     * of them ever waits for the other. If a record does not fit into the free space it is dropped and counted.
+     */
+    class CMonitoringRing{
+      public:
+        //! @param paSize capacity in bytes, rounded up to the next power of two
+        explicit CMonitoringRing(unsigned int paSize);
+        ~CMonitoringRing();
+
+        unsigned int getCapacity() const {
+          return mCapacity;
+        }
+
+        /*!\brief Appends a record (producer side)
+         *
+         * @return false if the record is empty or there is not enough free space, the record is dropped then
+         */
+        bool write(const TForteByte *paData, unsigned int paSize);
+
+        //! Size of the oldest record in the ring, 0 if the ring is empty (consumer side)
+        unsigned int getNextSize() const;
+
+        /*!\brief Removes the oldest record from the ring (consumer side)
+         *
+         * @param paBuffer destination of at least getNextSize() bytes
+         * @return size of the record, 0 if the ring is empty
+         */
+        unsigned int read(TForteByte *paBuffer);
+
+        //! Number of records dropped because the ring was full
+        TForteUInt32 getNrOfDroppedRecords() const;
+
+      private:
+        static const unsigned int scmSizeFieldSize = sizeof(TForteUInt32);
+
+        void copyIn(TForteUInt32 paPosition, const TForteByte *paData, unsigned int paSize);
+        void copyOut(TForteUInt32 paPosition, TForteByte *paData, unsigned int paSize) const;
+
+        TForteByte *mBuffer;
+        unsigned int mCapacity;
+
+        //! bytes written so far, only advanced by the producer
+        forte::arch::CAtomicUInt32 mWritten;
+        //! bytes read so far, only advanced by the consumer
+        forte::arch::CAtomicUInt32 mRead;
+        forte::arch::CAtomicUInt32 mDropped;
+
+        CMonitoringRing(const CMonitoringRing&);
+        CMonitoringRing& operator =(const CMonitoringRing &);
+    };
+
+  }
+}
+
+#endif /* _MONITORINGRING_H_ */
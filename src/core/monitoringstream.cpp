@@ -0,0 +1,492 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include "monitoringstream.h"
+#include "monitoringstreamserver.h"
+#include "ecet.h"
+#include "cominfra/fbdkasn1layer.h"
+#include "utils/criticalregion.h"
+#include <forte_any_int.h>
+#include <forte_real.h>
+#include <forte_lreal.h>
+#include <forte_architecture_time.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+using namespace forte::core;
+using forte::com_infra::CFBDKASN1ComLayer;
+
+namespace {
+  const TForteUInt64 scmNanoSecondsPerMilliSecond = 1000000ULL;
+  const unsigned int scmMinimumBufferCapacity = 64;
+
+  void putUInt32(TForteByte *paDest, TForteUInt32 paValue){
+    for(int i = 3; i >= 0; --i){
+      paDest[i] = static_cast<TForteByte>(paValue & 0xFF);
+      paValue >>= 8;
+    }
+  }
+
+  void putUInt64(TForteByte *paDest, TForteUInt64 paValue){
+    for(int i = 7; i >= 0; --i){
+      paDest[i] = static_cast<TForteByte>(paValue & 0xFF);
+      paValue >>= 8;
+    }
+  }
+
+  TForteUInt32 getUInt32(const TForteByte *paSrc){
+    TForteUInt32 value = 0;
+    for(unsigned int i = 0; i < 4; ++i){
+      value = (value << 8) | paSrc[i];
+    }
+    return value;
+  }
+
+  TForteUInt64 getUInt64(const TForteByte *paSrc){
+    TForteUInt64 value = 0;
+    for(unsigned int i = 0; i < 8; ++i){
+      value = (value << 8) | paSrc[i];
+    }
+    return value;
+  }
+
+  TForteByte *appendFrameHeader(CMonitoringStreamBuffer &paBuffer, CMonitoringStream::EFrameType paType, unsigned int paPayloadSize){
+    TForteByte *frame = paBuffer.grow(CMonitoringStream::scmFrameHeaderSize + paPayloadSize);
+    frame[0] = static_cast<TForteByte>(paType);
+    putUInt32(frame + 1, paPayloadSize);
+    return frame + CMonitoringStream::scmFrameHeaderSize;
+  }
+}
+
+CMonitoringStreamBuffer::CMonitoringStreamBuffer() :
+    mData(0), mSize(0), mCapacity(0){
+}
+
+CMonitoringStreamBuffer::~CMonitoringStreamBuffer(){
+  delete[] mData;
+}
+
+TForteByte *CMonitoringStreamBuffer::grow(unsigned int paSize){
+  if(mSize + paSize > mCapacity){
+    unsigned int newCapacity = (0 != mCapacity) ? mCapacity : scmMinimumBufferCapacity;
+    while(newCapacity < mSize + paSize){
+      newCapacity *= 2;
+    }
+    TForteByte *newData = new TForteByte[newCapacity];
+    if(0 != mSize){
+      memcpy(newData, mData, mSize);
+    }
+    delete[] mData;
+    mData = newData;
+    mCapacity = newCapacity;
+  }
+  TForteByte *retVal = mData + mSize;
+  mSize += paSize;
+  return retVal;
+}
+
+void CMonitoringStreamBuffer::append(const TForteByte *paData, unsigned int paSize){
+  if(0 != paSize){
+    memcpy(grow(paSize), paData, paSize);
+  }
+}
+
+void CMonitoringStreamBuffer::append(const char *paString){
+  append(reinterpret_cast<const TForteByte*>(paString), static_cast<unsigned int>(strlen(paString)));
+}
+
+void CMonitoringStreamBuffer::appendUInt(TForteUInt64 paValue){
+  char digits[21];
+  unsigned int pos = sizeof(digits);
+  do{
+    digits[--pos] = static_cast<char>('0' + (paValue % 10));
+    paValue /= 10;
+  } while(0 != paValue);
+  append(reinterpret_cast<const TForteByte*>(&digits[pos]), static_cast<unsigned int>(sizeof(digits) - pos));
+}
+
+void CMonitoringStreamBuffer::appendJSONString(const char *paString){
+  append("\"");
+  for(; '\0' != *paString; ++paString){
+    unsigned char character = static_cast<unsigned char>(*paString);
+    if(('"' == character) || ('\\' == character)){
+      TForteByte *escaped = grow(2);
+      escaped[0] = '\\';
+      escaped[1] = character;
+    } else if(character < 0x20){
+      char escaped[7];
+      snprintf(escaped, sizeof(escaped), "\\u%04x", character);
+      append(escaped);
+    } else{
+      *grow(1) = character;
+    }
+  }
+  append("\"");
+}
+
+CMonitoringStream::SSubscription::SSubscription() :
+    mId(0), mValue(0), mFB(0), mPeriod(0), mPeriodMs(0), mDeadband(0.0), mDecodeBuffer(0), mAnnouncement(0), mRemoved(0), mNextHandover(0),
+    mNextCapture(0), mCapturedAnnouncement(0), mNextSample(0), mCaptured(false), mForced(false), mLastNumeric(0.0){
+}
+
+CMonitoringStream::CMonitoringStream(unsigned int paRingSize, CSyncObject &paDataSync) :
+    mDataSync(paDataSync), mRing(paRingSize), mSubscriptionsChanged(0), mCaptureList(0), mNextSample(0), mExecutionThread(0), mServer(0){
+}
+
+CMonitoringStream::~CMonitoringStream(){
+  if(0 != mServer){
+    mServer->deregisterStream(*this);
+  }
+  //the execution thread is gone, every subscription is either in its capture list or in one of the hand over stacks
+  for(SSubscription *subscription = mCaptureList; 0 != subscription;){
+    SSubscription *next = subscription->mNextCapture;
+    deleteSubscription(subscription);
+    subscription = next;
+  }
+  for(SSubscription *subscription = mNewSubscriptions.exchange(0); 0 != subscription;){
+    SSubscription *next = subscription->mNextHandover;
+    deleteSubscription(subscription);
+    subscription = next;
+  }
+  deleteRetiredSubscriptions();
+}
+
+void CMonitoringStream::subscribe(TForteUInt32 paId, const char *paName, CIEC_ANY &paValue, TForteUInt32 paPeriod, double paDeadband,
+    const CFunctionBlock *paFB){
+  unsubscribe(paValue);
+
+  SSubscription *subscription = new SSubscription();
+  subscription->mId = paId;
+  subscription->mName = paName;
+  subscription->mValue = &paValue;
+  subscription->mFB = paFB;
+  subscription->mPeriodMs = paPeriod;
+  subscription->mPeriod = paPeriod * scmNanoSecondsPerMilliSecond;
+  subscription->mDeadband = paDeadband;
+  subscription->mDecodeBuffer = paValue.clone(0);
+
+  CCriticalRegion criticalRegion(mSync);
+  mSubscriptions.pushBack(subscription);
+  //only this thread pushes while holding mSync, the execution thread only takes the whole stack
+  SSubscription *head = mNewSubscriptions.load();
+  do{
+    subscription->mNextHandover = head;
+  } while(!mNewSubscriptions.compareExchange(head, subscription));
+  mSubscriptionsChanged.store(1);
+}
+
+bool CMonitoringStream::unsubscribe(const CIEC_ANY &paValue){
+  CCriticalRegion criticalRegion(mSync);
+  deleteRetiredSubscriptions();
+  TSubscriptionList::Iterator itRefNode = mSubscriptions.end();
+  for(TSubscriptionList::Iterator itRunner = mSubscriptions.begin(); itRunner != mSubscriptions.end(); ++itRunner){
+    if((*itRunner)->mValue == &paValue){
+      removeSubscription(itRefNode, itRunner);
+      return true;
+    }
+    itRefNode = itRunner;
+  }
+  return false;
+}
+
+unsigned int CMonitoringStream::unsubscribe(const CFunctionBlock &paFB){
+  unsigned int nrOfRemoved = 0;
+  //the execution thread checks the removal flag while holding the data lock before it reads the value
+  CCriticalRegion dataRegion(mDataSync);
+  CCriticalRegion criticalRegion(mSync);
+  deleteRetiredSubscriptions();
+  TSubscriptionList::Iterator itRefNode = mSubscriptions.end();
+  TSubscriptionList::Iterator itRunner = mSubscriptions.begin();
+  while(itRunner != mSubscriptions.end()){
+    if((*itRunner)->mFB == &paFB){
+      removeSubscription(itRefNode, itRunner);
+      ++nrOfRemoved;
+    } else{
+      itRefNode = itRunner;
+      ++itRunner;
+    }
+  }
+  return nrOfRemoved;
+}
+
+void CMonitoringStream::removeSubscription(TSubscriptionList::Iterator &paRefNode, TSubscriptionList::Iterator &paRunner){
+  //the execution thread may still capture it, it hands it back for deletion with its next capture
+  (*paRunner)->mRemoved.store(1);
+  if(paRefNode == mSubscriptions.end()){
+    mSubscriptions.popFront();
+    paRunner = mSubscriptions.begin();
+  } else{
+    paRunner = mSubscriptions.eraseAfter(paRefNode);
+  }
+  mSubscriptionsChanged.store(1);
+}
+
+bool CMonitoringStream::hasSubscriptions() const {
+  CCriticalRegion criticalRegion(mSync);
+  return !mSubscriptions.isEmpty();
+}
+
+void CMonitoringStream::capture(){
+  capture(getNanoSecondsMonotonic());
+}
+
+void CMonitoringStream::capture(TForteUInt64 paNow){
+  bool subscriptionsChanged = (0 != mSubscriptionsChanged.load());
+  if((paNow < mNextSample) && !subscriptionsChanged){
+    return;
+  }
+  if(subscriptionsChanged){
+    mSubscriptionsChanged.store(0);
+    updateCaptureList();
+  }
+
+  TForteUInt64 nextSample = static_cast<TForteUInt64>(-1);
+  for(SSubscription *subscription = mCaptureList; 0 != subscription; subscription = subscription->mNextCapture){
+    TForteUInt32 announcement = subscription->mAnnouncement.load();
+    if(announcement != subscription->mCapturedAnnouncement){
+      //announced anew, the client needs the current value
+      subscription->mCapturedAnnouncement = announcement;
+      subscription->mCaptured = false;
+      subscription->mNextSample = 0;
+    }
+    if(0 == (announcement & 1)){
+      continue;
+    }
+    if(subscription->mNextSample <= paNow){
+      sample(*subscription, paNow);
+      subscription->mNextSample = paNow + subscription->mPeriod;
+    }
+    if(subscription->mNextSample < nextSample){
+      nextSample = subscription->mNextSample;
+    }
+  }
+  mNextSample = nextSample;
+}
+
+void CMonitoringStream::updateCaptureList(){
+  for(SSubscription *subscription = mNewSubscriptions.exchange(0); 0 != subscription;){
+    SSubscription *next = subscription->mNextHandover;
+    subscription->mNextCapture = mCaptureList;
+    mCaptureList = subscription;
+    subscription = next;
+  }
+
+  SSubscription **link = &mCaptureList;
+  while(0 != *link){
+    SSubscription *subscription = *link;
+    if(0 != subscription->mRemoved.load()){
+      *link = subscription->mNextCapture;
+      SSubscription *head = mRetiredSubscriptions.load();
+      do{
+        subscription->mNextHandover = head;
+      } while(!mRetiredSubscriptions.compareExchange(head, subscription));
+    } else{
+      link = &subscription->mNextCapture;
+    }
+  }
+}
+
+void CMonitoringStream::deleteRetiredSubscriptions(){
+  for(SSubscription *subscription = mRetiredSubscriptions.exchange(0); 0 != subscription;){
+    SSubscription *next = subscription->mNextHandover;
+    deleteSubscription(subscription);
+    subscription = next;
+  }
+}
+
+void CMonitoringStream::deleteSubscription(SSubscription *paSubscription){
+  delete paSubscription->mDecodeBuffer;
+  delete paSubscription;
+}
+
+void CMonitoringStream::withdrawAnnouncement(SSubscription &paSubscription){
+  if(paSubscription.isAnnounced()){
+    paSubscription.mAnnouncement.fetchAdd(1);
+  }
+}
+
+void CMonitoringStream::sample(SSubscription &paSubscription, TForteUInt64 paNow){
+  TForteByte *record;
+  int encodedSize;
+  bool forced;
+  double numeric = 0.0;
+  bool isNumeric;
+  {
+    //other resources and the management write the data points while holding the data lock
+    CCriticalRegion dataRegion(mDataSync);
+    if(0 != paSubscription.mRemoved.load()){
+      //the function block of the data point may be deleted already
+      return;
+    }
+    const CIEC_ANY &value(*paSubscription.mValue);
+    unsigned int valueSize = CFBDKASN1ComLayer::getRequiredSerializationSize(value);
+
+    mCaptureBuffer.clear();
+    record = mCaptureBuffer.grow(scmSampleHeaderSize + valueSize);
+    encodedSize = CFBDKASN1ComLayer::serializeDataPoint(record + scmSampleHeaderSize, static_cast<int>(valueSize), value);
+    forced = value.isForced();
+    isNumeric = getNumericValue(value, numeric);
+  }
+  if(encodedSize <= 0){
+    return;
+  }
+
+  if(paSubscription.mCaptured && (forced == paSubscription.mForced)
+      && !hasChanged(paSubscription, record + scmSampleHeaderSize, static_cast<unsigned int>(encodedSize), numeric, isNumeric)){
+    return;
+  }
+
+  putUInt32(record, paSubscription.mId);
+  putUInt64(record + 4, paNow);
+  record[12] = forced ? 1 : 0;
+  //if the ring is full the value stays uncaptured and is tried again with the next sample
+  if(mRing.write(record, scmSampleHeaderSize + static_cast<unsigned int>(encodedSize))){
+    paSubscription.mCaptured = true;
+    paSubscription.mForced = forced;
+    paSubscription.mLastNumeric = numeric;
+    paSubscription.mLastValue.clear();
+    paSubscription.mLastValue.append(record + scmSampleHeaderSize, static_cast<unsigned int>(encodedSize));
+  }
+}
+
+bool CMonitoringStream::hasChanged(const SSubscription &paSubscription, const TForteByte *paValue, unsigned int paSize, double paNumeric,
+    bool paIsNumeric) const {
+  if((0.0 < paSubscription.mDeadband) && paIsNumeric){
+    return fabs(paNumeric - paSubscription.mLastNumeric) >= paSubscription.mDeadband;
+  }
+  return (paSize != paSubscription.mLastValue.getSize()) || (0 != memcmp(paValue, paSubscription.mLastValue.getData(), paSize));
+}
+
+unsigned int CMonitoringStream::appendFrames(CMonitoringStreamBuffer &paBuffer, EFormat paFormat){
+  CCriticalRegion criticalRegion(mSync);
+  bool announced = false;
+  for(TSubscriptionList::Iterator itRunner = mSubscriptions.begin(); itRunner != mSubscriptions.end(); ++itRunner){
+    if(!(*itRunner)->isAnnounced()){
+      appendDefinition(paBuffer, paFormat, **itRunner);
+      (*itRunner)->mAnnouncement.fetchAdd(1);
+      announced = true;
+    }
+  }
+  if(announced){
+    mSubscriptionsChanged.store(1);
+    if(0 != mExecutionThread){
+      //let the execution thread capture the initial values even if it is idle
+      mExecutionThread->resumeSelfSuspend();
+    }
+  }
+
+  unsigned int samples = 0;
+  for(unsigned int size = mRing.getNextSize(); 0 != size; size = mRing.getNextSize()){
+    mReadBuffer.clear();
+    mRing.read(mReadBuffer.grow(size));
+    //samples of removed subscriptions or captured before the client reconnected are not streamed
+    SSubscription *subscription = (scmSampleHeaderSize <= size) ? findSubscription(getUInt32(mReadBuffer.getData())) : 0;
+    if((0 == subscription) || !subscription->isAnnounced()){
+      continue;
+    }
+    if(e_Binary == paFormat){
+      memcpy(appendFrameHeader(paBuffer, e_Sample, size), mReadBuffer.getData(), size);
+    } else{
+      appendJSONSample(paBuffer, *subscription, mReadBuffer.getData(), size);
+    }
+    ++samples;
+  }
+  return samples;
+}
+
+void CMonitoringStream::resetAnnouncements(){
+  CCriticalRegion criticalRegion(mSync);
+  for(TSubscriptionList::Iterator itRunner = mSubscriptions.begin(); itRunner != mSubscriptions.end(); ++itRunner){
+    withdrawAnnouncement(**itRunner);
+  }
+  for(unsigned int size = mRing.getNextSize(); 0 != size; size = mRing.getNextSize()){
+    mReadBuffer.clear();
+    mRing.read(mReadBuffer.grow(size));
+  }
+}
+
+CMonitoringStream::SSubscription *CMonitoringStream::findSubscription(TForteUInt32 paId) const {
+  for(TSubscriptionList::Iterator itRunner = mSubscriptions.begin(); itRunner != mSubscriptions.end(); ++itRunner){
+    if((*itRunner)->mId == paId){
+      return *itRunner;
+    }
+  }
+  return 0;
+}
+
+void CMonitoringStream::appendDefinition(CMonitoringStreamBuffer &paBuffer, EFormat paFormat, const SSubscription &paSubscription){
+  if(e_Binary == paFormat){
+    unsigned int nameLength = paSubscription.mName.length();
+    TForteByte *payload = appendFrameHeader(paBuffer, e_Definition, 8 + nameLength);
+    putUInt32(payload, paSubscription.mId);
+    putUInt32(payload + 4, paSubscription.mPeriodMs);
+    memcpy(payload + 8, paSubscription.mName.getValue(), nameLength);
+  } else{
+    paBuffer.append("{\"id\":");
+    paBuffer.appendUInt(paSubscription.mId);
+    paBuffer.append(",\"name\":");
+    paBuffer.appendJSONString(paSubscription.mName.getValue());
+    paBuffer.append(",\"period\":");
+    paBuffer.appendUInt(paSubscription.mPeriodMs);
+    paBuffer.append("}\n");
+  }
+}
+
+void CMonitoringStream::appendJSONSample(CMonitoringStreamBuffer &paBuffer, SSubscription &paSubscription, const TForteByte *paRecord,
+    unsigned int paSize){
+  CIEC_ANY &value(*paSubscription.mDecodeBuffer);
+  if(0 > CFBDKASN1ComLayer::deserializeDataPoint(paRecord + scmSampleHeaderSize, static_cast<int>(paSize - scmSampleHeaderSize), value)){
+    return;
+  }
+  unsigned int textSize = static_cast<unsigned int>(value.getToStringBufferSize());
+  mTextBuffer.clear();
+  char *text = reinterpret_cast<char*>(mTextBuffer.grow(textSize + 1));
+  int textLength = value.toString(text, textSize);
+  text[(0 < textLength) ? textLength : 0] = '\0';
+
+  paBuffer.append("{\"id\":");
+  paBuffer.appendUInt(paSubscription.mId);
+  paBuffer.append(",\"t\":");
+  paBuffer.appendUInt(getUInt64(paRecord + 4));
+  paBuffer.append(",\"v\":");
+  paBuffer.appendJSONString(text);
+  paBuffer.append((0 != (paRecord[12] & 1)) ? ",\"forced\":true}\n" : ",\"forced\":false}\n");
+}
+
+bool CMonitoringStream::getNumericValue(const CIEC_ANY &paValue, double &paNumeric){
+  switch(paValue.getDataTypeID()){
+    case CIEC_ANY::e_SINT:
+    case CIEC_ANY::e_INT:
+    case CIEC_ANY::e_DINT:
+    case CIEC_ANY::e_LINT:
+      paNumeric = static_cast<double>(static_cast<const CIEC_ANY_INT&>(paValue).getSignedValue());
+      return true;
+    case CIEC_ANY::e_USINT:
+    case CIEC_ANY::e_UINT:
+    case CIEC_ANY::e_UDINT:
+    case CIEC_ANY::e_ULINT:
+      paNumeric = static_cast<double>(static_cast<const CIEC_ANY_INT&>(paValue).getUnsignedValue());
+      return true;
+#ifdef FORTE_USE_REAL_DATATYPE
+    case CIEC_ANY::e_REAL:
+      paNumeric = static_cast<TForteFloat>(static_cast<const CIEC_REAL&>(paValue));
+      return true;
+#endif
+#ifdef FORTE_USE_LREAL_DATATYPE
+    case CIEC_ANY::e_LREAL:
+      paNumeric = static_cast<TForteDFloat>(static_cast<const CIEC_LREAL&>(paValue));
+      return true;
+#endif
+    default:
+      return false;
+  }
+}
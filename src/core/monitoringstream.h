@@ -0,0 +1,268 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#ifndef _MONITORINGSTREAM_H_
+#define _MONITORINGSTREAM_H_
+
+#include "monitoringring.h"
+#include "fortelist.h"
+#include <forte_any.h>
+#include <forte_string.h>
+#include <forte_sync.h>
+#include <forte_atomic.h>
+
+class CEventChainExecutionThread;
+class CFunctionBlock;
+
+namespace forte {
+  namespace core {
+
+    class CMonitoringStreamServer;
+
+    //! Growing byte buffer the monitoring frames are assembled in
+    class CMonitoringStreamBuffer{
+      public:
+        CMonitoringStreamBuffer();
+        ~CMonitoringStreamBuffer();
+
+        void clear(){
+          mSize = 0;
+        }
+
+        const TForteByte *getData() const {
+          return mData;
+        }
+
+        unsigned int getSize() const {
+          return mSize;
+        }
+
+        //! Appends paSize uninitialized bytes and returns a pointer to them
+        TForteByte *grow(unsigned int paSize);
+
+        //! Removes the last paSize bytes, e.g., when a grown record could not be filled
+        void shrink(unsigned int paSize){
+          mSize -= (paSize < mSize) ? paSize : mSize;
+        }
+
+        void append(const TForteByte *paData, unsigned int paSize);
+        void append(const char *paString);
+        void appendUInt(TForteUInt64 paValue);
+        //! Appends the string as JSON string literal including the quotes
+        void appendJSONString(const char *paString);
+
+      private:
+        TForteByte *mData;
+        unsigned int mSize;
+        unsigned int mCapacity;
+
+        CMonitoringStreamBuffer(const CMonitoringStreamBuffer&);
+        CMonitoringStreamBuffer& operator =(const CMonitoringStreamBuffer &);
+    };
+
+    /*!\brief Push based monitoring of the data points of one resource
+     *
+     * Every subscription has a sampling period and an optional deadband. The resource's event chain execution thread
+     * samples the due subscriptions after it processed an event (see capture()). The data points are also written by
+     * other threads, e.g., local communication from other resources or WRITE and FORCE commands, so they are only read
+     * while holding the resource's data lock. Changed values are serialized in the FBDK ASN.1 encoding into a lock-free
+     * ring, from where the stream server takes them and sends them as frames to the monitoring client (see
+     * appendFrames()).
+     *
+     * The execution thread never takes a lock of the stream. It keeps its own list of the subscriptions to capture.
+     * New subscriptions are handed over through a lock-free stack, removed ones are flagged and handed back through
+     * a second stack for deletion. The management and the stream server thread synchronize with each other on mSync.
+     *
+     * Samples are only captured for subscriptions which have been announced to a connected client, so nothing is
+     * recorded while no client is listening.
+     *
+     * Binary frames start with the frame type and the payload size as 32 bit big endian number:
+     *   - Definition ('D'): subscription id (32 bit), sampling period in ms (32 bit), name of the data point
+     *   - Sample ('S'): subscription id (32 bit), capture time in ns (64 bit), flags (8 bit, bit 0 forced), ASN.1 value
+     *
+     * JSON frames are one object per line: {"id":1,"name":"RES.FB.OUT","period":100} and {"id":1,"t":42,"v":"5","forced":false}
+     */
+    class CMonitoringStream{
+      public:
+        enum EFormat{
+          e_Binary, e_JSON
+        };
+
+        enum EFrameType{
+          e_Definition = 'D',
+          e_Sample = 'S'
+        };
+
+        static const unsigned int scmFrameHeaderSize = 5;
+        static const unsigned int scmSampleHeaderSize = 13;
+
+        /*!\brief Creates the stream for the data points of one resource
+         *
+         * @param paRingSize size of the ring buffering the captured samples
+         * @param paDataSync lock the writers of the data points hold, e.g., the resource's m_oResDataConSync
+         */
+        CMonitoringStream(unsigned int paRingSize, CSyncObject &paDataSync);
+        ~CMonitoringStream();
+
+        /*!\brief Adds a subscription for a data point, an existing subscription of the data point is replaced
+         *
+         * @param paId device wide unique id of the subscription used in the frames
+         * @param paName full name of the data point including the resource
+         * @param paValue the data point
+         * @param paPeriod sampling period in ms, 0 samples the value after every event
+         * @param paDeadband minimum change of numeric values to be reported, 0 reports every change
+         * @param paFB function block in the resource's network the data point belongs to, deleting it removes the subscription
+         */
+        void subscribe(TForteUInt32 paId, const char *paName, CIEC_ANY &paValue, TForteUInt32 paPeriod, double paDeadband,
+            const CFunctionBlock *paFB = 0);
+
+        //! @return false if the data point has not been subscribed
+        bool unsubscribe(const CIEC_ANY &paValue);
+
+        /*!\brief Removes all subscriptions of data points belonging to the function block, called before it is deleted
+         *
+         * When it returns the execution thread does not access the data points anymore.
+         * @return number of removed subscriptions
+         */
+        unsigned int unsubscribe(const CFunctionBlock &paFB);
+
+        bool hasSubscriptions() const;
+
+        //! Set the thread capturing the samples, it is woken up when new subscriptions need their initial value
+        void setExecutionThread(CEventChainExecutionThread *paExecutionThread){
+          mExecutionThread = paExecutionThread;
+        }
+
+        //! Samples all due subscriptions, called by the execution thread
+        void capture();
+
+        void capture(TForteUInt64 paNow);
+
+        /*!\brief Appends the definitions of new subscriptions and all captured samples to the buffer
+         *
+         * @return number of samples appended
+         */
+        unsigned int appendFrames(CMonitoringStreamBuffer &paBuffer, EFormat paFormat);
+
+        //! Stops capturing until the subscriptions are announced again, e.g., after the client disconnected
+        void resetAnnouncements();
+
+        TForteUInt32 getNrOfDroppedSamples() const {
+          return mRing.getNrOfDroppedRecords();
+        }
+
+      private:
+        struct SSubscription{
+            SSubscription();
+
+            //! true while the subscription is announced to the client, only changed by the consumer
+            bool isAnnounced() const {
+              return 0 != (mAnnouncement.load() & 1);
+            }
+
+            //! @name parameters, not changed after the subscription has been handed over to the execution thread
+            //!@{
+            TForteUInt32 mId;
+            CIEC_STRING mName;
+            CIEC_ANY *mValue;
+            const CFunctionBlock *mFB;
+            TForteUInt64 mPeriod;
+            TForteUInt32 mPeriodMs;
+            double mDeadband;
+            //!@}
+
+            //! buffer for decoding the samples when streaming JSON, only used by the consumer
+            CIEC_ANY *mDecodeBuffer;
+
+            //! incremented by the consumer when it announces the subscription and when it stops streaming it
+            forte::arch::CAtomicUInt32 mAnnouncement;
+            //! set when the subscription has been removed, the execution thread hands it back for deletion then. Set
+            //! while holding the data lock if the data point is about to be deleted, the execution thread checks it then.
+            forte::arch::CAtomicUInt32 mRemoved;
+            //! link in the stack of new or of retired subscriptions
+            SSubscription *mNextHandover;
+
+            //! @name state of the execution thread
+            //!@{
+            SSubscription *mNextCapture;
+            TForteUInt32 mCapturedAnnouncement;
+            TForteUInt64 mNextSample;
+            bool mCaptured;
+            bool mForced;
+            double mLastNumeric;
+            //! encoding of the last captured value
+            CMonitoringStreamBuffer mLastValue;
+            //!@}
+        };
+
+        typedef CSinglyLinkedList<SSubscription*> TSubscriptionList;
+
+        //! Moves the new subscriptions to the capture list and hands the removed ones back, called by the execution thread
+        void updateCaptureList();
+        //! Deletes the subscriptions handed back by the execution thread, requires mSync
+        void deleteRetiredSubscriptions();
+        //! Marks the subscription as removed and takes it out of mSubscriptions, requires mSync
+        void removeSubscription(TSubscriptionList::Iterator &paRefNode, TSubscriptionList::Iterator &paRunner);
+        static void deleteSubscription(SSubscription *paSubscription);
+        //! Stops capturing the subscription, requires mSync
+        static void withdrawAnnouncement(SSubscription &paSubscription);
+
+        void sample(SSubscription &paSubscription, TForteUInt64 paNow);
+        bool hasChanged(const SSubscription &paSubscription, const TForteByte *paValue, unsigned int paSize, double paNumeric, bool paIsNumeric) const;
+        //! Looks the id up in the not removed subscriptions, requires mSync
+        SSubscription *findSubscription(TForteUInt32 paId) const;
+
+        static void appendDefinition(CMonitoringStreamBuffer &paBuffer, EFormat paFormat, const SSubscription &paSubscription);
+        //! Decodes the sample into the subscription's buffer and appends it as JSON object, requires mSync
+        void appendJSONSample(CMonitoringStreamBuffer &paBuffer, SSubscription &paSubscription, const TForteByte *paRecord, unsigned int paSize);
+
+        static bool getNumericValue(const CIEC_ANY &paValue, double &paNumeric);
+
+        //! subscriptions which have not been removed, used by the management and the consumer thread
+        TSubscriptionList mSubscriptions;
+        //! protects mSubscriptions and the consumer state, never taken by the execution thread
+        mutable CSyncObject mSync;
+
+        //! held by all writers of the data points, the execution thread holds it while reading a value
+        CSyncObject &mDataSync;
+
+        CMonitoringRing mRing;
+
+        //! subscriptions not yet taken over by the execution thread, pushed with mSync held
+        forte::arch::CAtomicPointer<SSubscription> mNewSubscriptions;
+        //! removed subscriptions the execution thread does not capture anymore
+        forte::arch::CAtomicPointer<SSubscription> mRetiredSubscriptions;
+        //! set when subscriptions have been added, announced, or removed, so that the next capture checks all subscriptions
+        forte::arch::CAtomicUInt32 mSubscriptionsChanged;
+
+        //! subscriptions captured by the execution thread, only used by it
+        SSubscription *mCaptureList;
+        //! earliest time a subscription is due, only used by the capturing thread
+        TForteUInt64 mNextSample;
+        //! record assembled by the capturing thread
+        CMonitoringStreamBuffer mCaptureBuffer;
+        //! record read by the consumer for the JSON conversion
+        CMonitoringStreamBuffer mReadBuffer;
+        CMonitoringStreamBuffer mTextBuffer;
+
+        CEventChainExecutionThread *mExecutionThread;
+        CMonitoringStreamServer *mServer;
+
+        friend class CMonitoringStreamServer;
+
+        CMonitoringStream(const CMonitoringStream&);
+        CMonitoringStream& operator =(const CMonitoringStream &);
+    };
+
+  }
+}
+
+#endif /* _MONITORINGSTREAM_H_ */
@@ -0,0 +1,179 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include "monitoringstreamserver.h"
+#include "devexec.h"
+#include "utils/criticalregion.h"
+#include "../arch/devlog.h"
+
+using namespace forte::core;
+using forte::com_infra::EComResponse;
+
+namespace {
+  //! time between two transmissions of the captured samples in ns
+  const TForteUInt64 scmFlushInterval = 10000000ULL;
+}
+
+CMonitoringStreamServer::CMonitoringStreamServer(CDeviceExecution &paDeviceExecution) :
+    mDeviceExecution(paDeviceExecution), mListeningSocket(CIPComSocketHandler::scmInvalidSocketDescriptor),
+    mClientSocket(CIPComSocketHandler::scmInvalidSocketDescriptor), mFormat(CMonitoringStream::e_Binary){
+}
+
+CMonitoringStreamServer::~CMonitoringStreamServer(){
+  setAlive(false);
+  mFlushSemaphore.inc();
+  end();
+
+  {
+    CCriticalRegion criticalRegion(mClientSync);
+    closeClient();
+  }
+  if(CIPComSocketHandler::scmInvalidSocketDescriptor != mListeningSocket){
+    mDeviceExecution.getExtEvHandler<CIPComSocketHandler>().removeComCallback(mListeningSocket);
+    CIPComSocketHandler::closeSocket(mListeningSocket);
+  }
+
+  CCriticalRegion criticalRegion(mStreamsSync);
+  for(TStreamList::Iterator itRunner = mStreams.begin(); itRunner != mStreams.end(); ++itRunner){
+    (*itRunner)->mServer = 0;
+  }
+}
+
+bool CMonitoringStreamServer::open(unsigned short paPort){
+  char address[] = "0.0.0.0";
+  mListeningSocket = CIPComSocketHandler::openTCPServerConnection(address, paPort);
+  if(CIPComSocketHandler::scmInvalidSocketDescriptor == mListeningSocket){
+    DEVLOG_ERROR("Could not open the monitoring stream port %d\n", paPort);
+    return false;
+  }
+  mDeviceExecution.getExtEvHandler<CIPComSocketHandler>().addComCallback(mListeningSocket, this);
+  start();
+  return true;
+}
+
+void CMonitoringStreamServer::registerStream(CMonitoringStream &paStream){
+  CCriticalRegion criticalRegion(mStreamsSync);
+  for(TStreamList::Iterator itRunner = mStreams.begin(); itRunner != mStreams.end(); ++itRunner){
+    if(*itRunner == &paStream){
+      return;
+    }
+  }
+  mStreams.pushBack(&paStream);
+  paStream.mServer = this;
+}
+
+void CMonitoringStreamServer::deregisterStream(CMonitoringStream &paStream){
+  CCriticalRegion criticalRegion(mStreamsSync);
+  TStreamList::Iterator itRefNode = mStreams.end();
+  for(TStreamList::Iterator itRunner = mStreams.begin(); itRunner != mStreams.end(); ++itRunner){
+    if(*itRunner == &paStream){
+      if(itRefNode == mStreams.end()){
+        mStreams.popFront();
+      } else{
+        mStreams.eraseAfter(itRefNode);
+      }
+      break;
+    }
+    itRefNode = itRunner;
+  }
+  paStream.mServer = 0;
+}
+
+void CMonitoringStreamServer::flush(){
+  CCriticalRegion clientRegion(mClientSync);
+  if(CIPComSocketHandler::scmInvalidSocketDescriptor == mClientSocket){
+    return;
+  }
+
+  mSendBuffer.clear();
+  {
+    CCriticalRegion streamsRegion(mStreamsSync);
+    for(TStreamList::Iterator itRunner = mStreams.begin(); itRunner != mStreams.end(); ++itRunner){
+      (*itRunner)->appendFrames(mSendBuffer, mFormat);
+    }
+  }
+
+  if(0 != mSendBuffer.getSize()){
+    if(0 >= CIPComSocketHandler::sendDataOnTCP(mClientSocket, reinterpret_cast<char*>(const_cast<TForteByte*>(mSendBuffer.getData())), mSendBuffer.getSize())){
+      DEVLOG_INFO("Monitoring stream client disconnected\n");
+      closeClient();
+    }
+  }
+}
+
+bool CMonitoringStreamServer::isClientConnected() const {
+  CCriticalRegion criticalRegion(mClientSync);
+  return (CIPComSocketHandler::scmInvalidSocketDescriptor != mClientSocket);
+}
+
+EComResponse CMonitoringStreamServer::recvData(const void *paData, unsigned int){
+  CIPComSocketHandler::TSocketDescriptor socket = *static_cast<const CIPComSocketHandler::TSocketDescriptor*>(paData);
+  CCriticalRegion criticalRegion(mClientSync);
+  if(socket == mListeningSocket){
+    acceptClient();
+  } else if(socket == mClientSocket){
+    handleClientData();
+  }
+  return forte::com_infra::e_Nothing;
+}
+
+void CMonitoringStreamServer::run(){
+  while(isAlive()){
+    mFlushSemaphore.timedWait(scmFlushInterval);
+    if(isAlive()){
+      flush();
+    }
+  }
+}
+
+void CMonitoringStreamServer::acceptClient(){
+  CIPComSocketHandler::TSocketDescriptor socket = CIPComSocketHandler::acceptTCPConnection(mListeningSocket);
+  if(CIPComSocketHandler::scmInvalidSocketDescriptor != socket){
+    //a new client replaces the current one, e.g., an IDE reconnecting after it lost the connection
+    closeClient();
+    mClientSocket = socket;
+    mFormat = CMonitoringStream::e_Binary;
+    mDeviceExecution.getExtEvHandler<CIPComSocketHandler>().addComCallback(mClientSocket, this);
+    DEVLOG_INFO("Monitoring stream client connected\n");
+  }
+}
+
+void CMonitoringStreamServer::handleClientData(){
+  char buffer[64];
+  int received = CIPComSocketHandler::receiveDataFromTCP(mClientSocket, buffer, sizeof(buffer));
+  if(0 >= received){
+    DEVLOG_INFO("Monitoring stream client disconnected\n");
+    closeClient();
+    return;
+  }
+  for(int i = 0; i < received; ++i){
+    if(('J' == buffer[i]) || ('B' == buffer[i])){
+      mFormat = ('J' == buffer[i]) ? CMonitoringStream::e_JSON : CMonitoringStream::e_Binary;
+      restartStreams();
+    }
+  }
+}
+
+void CMonitoringStreamServer::closeClient(){
+  if(CIPComSocketHandler::scmInvalidSocketDescriptor != mClientSocket){
+    mDeviceExecution.getExtEvHandler<CIPComSocketHandler>().removeComCallback(mClientSocket);
+    CIPComSocketHandler::closeSocket(mClientSocket);
+    mClientSocket = CIPComSocketHandler::scmInvalidSocketDescriptor;
+    restartStreams();
+  }
+}
+
+void CMonitoringStreamServer::restartStreams(){
+  CCriticalRegion criticalRegion(mStreamsSync);
+  for(TStreamList::Iterator itRunner = mStreams.begin(); itRunner != mStreams.end(); ++itRunner){
+    (*itRunner)->resetAnnouncements();
+  }
+}
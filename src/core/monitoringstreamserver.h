@@ -0,0 +1,89 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#ifndef _MONITORINGSTREAMSERVER_H_
+#define _MONITORINGSTREAMSERVER_H_
+
+#include "monitoringstream.h"
+#include "cominfra/comCallback.h"
+#include <sockhand.h>
+#include <forte_thread.h>
+#include <forte_sem.h>
+
+class CDeviceExecution;
+
+namespace forte {
+  namespace core {
+
+    /*!\brief Dedicated TCP connection streaming the monitoring samples of all resources of a device
+     *
+     * The server accepts one client at a time, a new connection replaces the previous one. Right after connecting the
+     * client gets the definitions of all subscriptions and their current values in the binary format. Sending a line
+     * starting with 'J' switches the connection to JSON frames, a line starting with 'B' back to binary frames. Both
+     * restart the stream with the definitions.
+     *
+     * The server thread collects the samples of all registered streams every few milliseconds and sends them with
+     * one send call. There is no limit on the amount of data sent at once.
+     */
+    class CMonitoringStreamServer : public CThread, public forte::com_infra::CComCallback{
+      public:
+        explicit CMonitoringStreamServer(CDeviceExecution &paDeviceExecution);
+        virtual ~CMonitoringStreamServer();
+
+        /*!\brief Opens the listening socket and starts the server thread
+         *
+         * @param paPort TCP port the server listens on at all interfaces
+         * @return false if the socket could not be opened
+         */
+        bool open(unsigned short paPort);
+
+        void registerStream(CMonitoringStream &paStream);
+        void deregisterStream(CMonitoringStream &paStream);
+
+        //! Sends the pending frames of all streams to the client
+        void flush();
+
+        bool isClientConnected() const;
+
+        virtual forte::com_infra::EComResponse recvData(const void *paData, unsigned int paSize);
+
+      private:
+        typedef CSinglyLinkedList<CMonitoringStream*> TStreamList;
+
+        virtual void run();
+
+        void acceptClient();
+        void handleClientData();
+        void closeClient();
+        void restartStreams();
+
+        CDeviceExecution &mDeviceExecution;
+
+        TStreamList mStreams;
+        CSyncObject mStreamsSync;
+
+        CIPComSocketHandler::TSocketDescriptor mListeningSocket;
+        CIPComSocketHandler::TSocketDescriptor mClientSocket;
+        CMonitoringStream::EFormat mFormat;
+        //! protects the client connection, taken before mStreamsSync
+        mutable CSyncObject mClientSync;
+
+        CMonitoringStreamBuffer mSendBuffer;
+        forte::arch::CSemaphore mFlushSemaphore;
+
+        CMonitoringStreamServer(const CMonitoringStreamServer&);
+        CMonitoringStreamServer& operator =(const CMonitoringStreamServer &);
+    };
+
+  }
+}
+
+#endif /* _MONITORINGSTREAMSERVER_H_ */
@@ -11,6 +11,8 @@
  *    Alois Zoitl, Rene Smodic, Gerhard Ebenhofer, Thomas Strasser,
  *    Martin Melik Merkumians,
  *      - initial implementation and rework communication infrastructure
+ *    agent - write list queries as pageable entries
+ *    agent - added history query
  *******************************************************************************/
 #include <fortenew.h>
 #include "resource.h"
@@ -112,13 +114,13 @@ EMGMResponse CResource::executeMGMCommand(forte::core::SManagementCMD &paCommand
         break;
 #ifdef FORTE_SUPPORT_QUERY_CMD
         case cg_nMGM_CMD_QUERY_FBTypes:
-        retVal = queryAllFBTypes(paCommand.mAdditionalParams);
+        retVal = queryAllFBTypes(paCommand.mResponse);
         break;
         case cg_nMGM_CMD_QUERY_AdapterTypes:
-        retVal = queryAllAdapterTypes(paCommand.mAdditionalParams);
+        retVal = queryAllAdapterTypes(paCommand.mResponse);
         break;
         case cg_nMGM_CMD_QUERY_FB:
-        retVal = queryFBs(paCommand.mAdditionalParams);
+        retVal = queryFBs(paCommand.mResponse);
         break;
         case cg_nMGM_CMD_QUERY_FBType:
         retVal = createFBTypeResponseMessage(paCommand.mFirstParam.front(), paCommand.mAdditionalParams);
@@ -127,7 +129,14 @@ EMGMResponse CResource::executeMGMCommand(forte::core::SManagementCMD &paCommand
         retVal = createAdapterTypeResponseMessage(paCommand.mFirstParam.front(), paCommand.mAdditionalParams);
         break;
         case cg_nMGM_CMD_QUERY_Connection:
-        retVal = queryConnections(paCommand.mAdditionalParams);
+        retVal = queryConnections(paCommand.mResponse);
+        break;
+        case cg_nMGM_CMD_QUERY_History: {
+          //the device is the only resource without a resource
+          CDevice &device = (0 == getResourcePtr()) ? static_cast<CDevice &>(*this) : getDevice();
+          retVal = device.getHistoryStore().query(paCommand.mFirstParam.front(), paCommand.mAdditionalParams.getValue(),
+              paCommand.mResponse);
+        }
         break;
 #endif //FORTE_SUPPORT_QUERY_CMD
       default:
@@ -236,7 +245,7 @@ EMGMResponse CResource::writeValue(forte::core::TNameIdentifier &paNameList, con
       if((paValue.length() > 0) && (paValue.length() == var->fromString(paValue.getValue()))){
         //if we cannot parse the full value the value is not valid
         if(paForce){
-          var->setForced(true);
+          fb->setForced(var, true);
           CDataConnection *con = fb->getDOConnection(portName);
           if(0 != con){
             //if we have got a connection it was a DO mirror the forced value there
@@ -287,53 +296,53 @@ EMGMResponse CResource::readValue(forte::core::TNameIdentifier &paNameList, CIEC
 
 #ifdef FORTE_SUPPORT_QUERY_CMD
 
-EMGMResponse CResource::queryAllFBTypes(CIEC_STRING & paValue){
+EMGMResponse CResource::queryAllFBTypes(forte::core::CMGMResponseBuffer &paValue){
   EMGMResponse retVal = e_UNSUPPORTED_TYPE;
 
   CTypeLib::CTypeEntry *fbTypeRunner = CTypeLib::getFBLibStart();
   if(fbTypeRunner != 0){
     retVal = e_RDY;
     for(; fbTypeRunner != 0; fbTypeRunner = fbTypeRunner->m_poNext){
-      paValue.append(CStringDictionary::getInstance().get(fbTypeRunner->getTypeNameId()));
-      if(fbTypeRunner->m_poNext != 0){
-        paValue.append(", ");
+      if(paValue.beginEntry(", ")){
+        paValue.append(CStringDictionary::getInstance().get(fbTypeRunner->getTypeNameId()));
+        paValue.endEntry();
       }
     }
   }
   return retVal;
 }
 
-EMGMResponse CResource::queryAllAdapterTypes(CIEC_STRING & paValue){
+EMGMResponse CResource::queryAllAdapterTypes(forte::core::CMGMResponseBuffer &paValue){
   EMGMResponse retVal = e_UNSUPPORTED_TYPE;
 
   CTypeLib::CTypeEntry *adapterTypeRunner = CTypeLib::getAdapterLibStart();
   if(adapterTypeRunner != 0){
     retVal = e_RDY;
     for(; adapterTypeRunner != 0; adapterTypeRunner = adapterTypeRunner->m_poNext){
-      paValue.append(CStringDictionary::getInstance().get(adapterTypeRunner->getTypeNameId()));
-      if(adapterTypeRunner->m_poNext != 0){
-        paValue.append(", ");
+      if(paValue.beginEntry(", ")){
+        paValue.append(CStringDictionary::getInstance().get(adapterTypeRunner->getTypeNameId()));
+        paValue.endEntry();
       }
     }
   }
   return retVal;
 }
 
-EMGMResponse CResource::queryFBs(CIEC_STRING & paValue){
+EMGMResponse CResource::queryFBs(forte::core::CMGMResponseBuffer &paValue){
   for(TFunctionBlockList::Iterator itRunner(getFBList().begin()); itRunner != getFBList().end(); ++itRunner){
-    if(itRunner != getFBList().begin()){
-      paValue.append("\n");
+    if(paValue.beginEntry("\n")){
+      paValue.append("<FB name=\"");
+      paValue.append((static_cast<CFunctionBlock *>(*itRunner))->getInstanceName());
+      paValue.append("\" type=\"");
+      paValue.append(CStringDictionary::getInstance().get((static_cast<CFunctionBlock *>(*itRunner))->getFBTypeId()));
+      paValue.append("\"/>");
+      paValue.endEntry();
     }
-    paValue.append("<FB name=\"");
-    paValue.append((static_cast<CFunctionBlock *>(*itRunner))->getInstanceName());
-    paValue.append("\" type=\"");
-    paValue.append(CStringDictionary::getInstance().get((static_cast<CFunctionBlock *>(*itRunner))->getFBTypeId()));
-    paValue.append("\"/>");
   }
   return e_RDY;
 }
 
-EMGMResponse CResource::queryConnections(CIEC_STRING & paReqResult){
+EMGMResponse CResource::queryConnections(forte::core::CMGMResponseBuffer &paReqResult){
   EMGMResponse retVal = e_UNSUPPORTED_TYPE;
   //TODO check container list to support subapps issue[538333]
   for(TFunctionBlockList::Iterator itRunner(getFBList().begin()); itRunner != getFBList().end(); ++itRunner){
@@ -345,16 +354,13 @@ EMGMResponse CResource::queryConnections(CIEC_STRING & paReqResult){
   return retVal;
 }
 
-void CResource::createEOConnectionResponse(const CFunctionBlock& paFb, CIEC_STRING& paReqResult){
+void CResource::createEOConnectionResponse(const CFunctionBlock& paFb, forte::core::CMGMResponseBuffer& paReqResult){
   const SFBInterfaceSpec * const spec = paFb.getFBInterfaceSpec();
   if(spec->m_nNumEOs > 0){
     for(size_t i = 0; spec->m_aunEONames[i] != spec->m_aunEONames[spec->m_nNumEOs]; i++){
       const CEventConnection* eConn = paFb.getEOConnection(spec->m_aunEONames[i]);
       for(CSinglyLinkedList<CConnectionPoint>::Iterator itRunnerDst(eConn->getDestinationList().begin()); itRunnerDst != eConn->getDestinationList().end();
           ++itRunnerDst){
-        if(itRunnerDst != eConn->getDestinationList().begin()){
-          paReqResult.append("\n");
-        }
         createConnectionResponseMessage(spec->m_aunEONames[i], itRunnerDst->mFB->getFBInterfaceSpec()->m_aunEINames[itRunnerDst->mPortId], *itRunnerDst->mFB,
             paFb, paReqResult);
       }
@@ -362,16 +368,13 @@ void CResource::createEOConnectionResponse(const CFunctionBlock& paFb, CIEC_STRI
   }
 }
 
-void CResource::createDOConnectionResponse(const CFunctionBlock& paFb, CIEC_STRING& paReqResult){
+void CResource::createDOConnectionResponse(const CFunctionBlock& paFb, forte::core::CMGMResponseBuffer& paReqResult){
   const SFBInterfaceSpec * const spec = paFb.getFBInterfaceSpec();
   if(spec->m_nNumDOs > 0){
     for(size_t i = 0; spec->m_aunDONames[i] != spec->m_aunDONames[spec->m_nNumDOs]; i++){
       const CDataConnection * const dConn = paFb.getDOConnection(spec->m_aunDONames[i]);
       for(CSinglyLinkedList<CConnectionPoint>::Iterator itRunnerDst(dConn->getDestinationList().begin()); itRunnerDst != dConn->getDestinationList().end();
           ++itRunnerDst){
-        if(itRunnerDst != dConn->getDestinationList().begin()){
-          paReqResult.append("\n");
-        }
         createConnectionResponseMessage(spec->m_aunDONames[i], itRunnerDst->mFB->getFBInterfaceSpec()->m_aunDINames[itRunnerDst->mPortId], *itRunnerDst->mFB,
             paFb, paReqResult);
       }
@@ -379,16 +382,13 @@ void CResource::createDOConnectionResponse(const CFunctionBlock& paFb, CIEC_STRI
   }
 }
 
-void CResource::createAOConnectionResponse(const CFunctionBlock& paFb, CIEC_STRING& paReqResult){
+void CResource::createAOConnectionResponse(const CFunctionBlock& paFb, forte::core::CMGMResponseBuffer& paReqResult){
   const SFBInterfaceSpec * const spec = paFb.getFBInterfaceSpec();
   if(spec->m_nNumAdapters > 0){
     for(size_t i = 0; i < spec->m_nNumAdapters; i++){
       const CAdapter * const adapter = paFb.getAdapter(spec->m_pstAdapterInstanceDefinition[i].m_nAdapterNameID);
       const CAdapterConnection* aConn = adapter->getAdapterConnection();
       if(spec->m_pstAdapterInstanceDefinition[i].m_bIsPlug && 0 != aConn){
-        if(i != 0){
-          paReqResult.append("\n");
-        }
         if(!aConn->getDestinationList().isEmpty()){
           CSinglyLinkedList<CConnectionPoint>::Iterator itRunnerDst(aConn->getDestinationList().begin());
           createConnectionResponseMessage(spec->m_pstAdapterInstanceDefinition[i].m_nAdapterNameID,
@@ -401,16 +401,19 @@ void CResource::createAOConnectionResponse(const CFunctionBlock& paFb, CIEC_STRI
 }
 
 void CResource::createConnectionResponseMessage(const CStringDictionary::TStringId srcId, const CStringDictionary::TStringId dstId,
-    const CFunctionBlock& paDstFb, const CFunctionBlock& paSrcFb, CIEC_STRING& paReqResult) const {
-  paReqResult.append("<Connection Source=\"");
-  paReqResult.append(paSrcFb.getInstanceName());
-  paReqResult.append(".");
-  paReqResult.append(CStringDictionary::getInstance().get(srcId));
-  paReqResult.append("\" Destination=\"");
-  paReqResult.append(paDstFb.getInstanceName());
-  paReqResult.append(".");
-  paReqResult.append(CStringDictionary::getInstance().get(dstId));
-  paReqResult.append("\"/>");
+    const CFunctionBlock& paDstFb, const CFunctionBlock& paSrcFb, forte::core::CMGMResponseBuffer& paReqResult) const {
+  if(paReqResult.beginEntry("\n")){
+    paReqResult.append("<Connection Source=\"");
+    paReqResult.append(paSrcFb.getInstanceName());
+    paReqResult.append(".");
+    paReqResult.append(CStringDictionary::getInstance().get(srcId));
+    paReqResult.append("\" Destination=\"");
+    paReqResult.append(paDstFb.getInstanceName());
+    paReqResult.append(".");
+    paReqResult.append(CStringDictionary::getInstance().get(dstId));
+    paReqResult.append("\"/>");
+    paReqResult.endEntry();
+  }
 }
 
 EMGMResponse CResource::createFBTypeResponseMessage(const CStringDictionary::TStringId paValue, CIEC_STRING & paReqResult){
@@ -9,6 +9,7 @@
  * Contributors:
  *    Alois Zoitl, Rene Smodic, Thomas Strasser, Gerhard Ebenhofer, Ingo Hegny,
  *      - initial implementation and rework communication infrastructure
+ *    agent - write list queries as pageable entries
  *******************************************************************************/
 #ifndef _RESOURCE_H_
 #define _RESOURCE_H_
@@ -157,27 +158,30 @@ class CResource : public CFunctionBlock, public forte::core::CFBContainer{
      *
      * @return response of the command execution as defined in IEC 61499
      */
-    static EMGMResponse queryAllFBTypes(CIEC_STRING& paValue);
+    static EMGMResponse queryAllFBTypes(forte::core::CMGMResponseBuffer &paValue);
 
     /*!\brief Read the existing adapter types.
      *
      * @return response of the command execution as defined in IEC 61499
      */
-    static EMGMResponse queryAllAdapterTypes(CIEC_STRING& paValue);
+    static EMGMResponse queryAllAdapterTypes(forte::core::CMGMResponseBuffer &paValue);
 
     /*!\brief Retrieve the list of FB instances
+     *
+     * Every FB is one entry of the result, so that large lists can be retrieved in pages.
      *
      * @param paValue the result of the query
      * @return response of the command execution as defined in IEC 61499
      */
-    EMGMResponse queryFBs(CIEC_STRING& paValue);
+    EMGMResponse queryFBs(forte::core::CMGMResponseBuffer &paValue);
 
-    EMGMResponse queryConnections(CIEC_STRING &paValue);
-    void createEOConnectionResponse(const CFunctionBlock& paFb, CIEC_STRING& paReqResult);
-    void createDOConnectionResponse(const CFunctionBlock& paFb, CIEC_STRING& paReqResult);
-    void createAOConnectionResponse(const CFunctionBlock& paFb, CIEC_STRING& paReqResult);
+    //! Retrieve the list of connections, every connection is one entry of the result
+    EMGMResponse queryConnections(forte::core::CMGMResponseBuffer &paValue);
+    void createEOConnectionResponse(const CFunctionBlock& paFb, forte::core::CMGMResponseBuffer& paReqResult);
+    void createDOConnectionResponse(const CFunctionBlock& paFb, forte::core::CMGMResponseBuffer& paReqResult);
+    void createAOConnectionResponse(const CFunctionBlock& paFb, forte::core::CMGMResponseBuffer& paReqResult);
     void createConnectionResponseMessage(const CStringDictionary::TStringId srcId, const CStringDictionary::TStringId dstId, const CFunctionBlock& paDstFb,
-        const CFunctionBlock& paFb, CIEC_STRING& paValue) const;
+        const CFunctionBlock& paFb, forte::core::CMGMResponseBuffer& paValue) const;
 
     EMGMResponse createFBTypeResponseMessage(const CStringDictionary::TStringId paValue, CIEC_STRING & paReqResult);
     EMGMResponse createAdapterTypeResponseMessage(const CStringDictionary::TStringId paValue, CIEC_STRING & paReqResult);
@@ -39,21 +39,25 @@ class CAdapter;
 #define FORTE_DUMMY_INIT_DEC  static int dummyInit();
 
 
-//!\ingroup CORE This define is used to create the definition necessary for generic FirmwareFunction blocks in order to get them automatically added to the FirmwareType list.
-#define DECLARE_GENERIC_FIRMWARE_FB(fbclass) \
+//!\ingroup CORE Type entry and creation function of a FirmwareFunction block, newFB is the new expression creating the FB
+#define FORTE_FIRMWARE_FB_ENTRY(fbclass, newFB) \
   private: \
     const static CTypeLib::CFBTypeEntry csm_oFirmwareFBEntry_##fbclass; \
   public:  \
     static CFunctionBlock *createFB(CStringDictionary::TStringId pa_nInstanceNameId, CResource *pa_poSrcRes){ \
-      return new fbclass( pa_nInstanceNameId, pa_poSrcRes);\
+      return newFB( pa_nInstanceNameId, pa_poSrcRes);\
     }; \
     FORTE_DUMMY_INIT_DEC \
   private:
 
+//!\ingroup CORE This define is used to create the definition necessary for generic FirmwareFunction blocks in order to get them automatically added to the FirmwareType list.
+#define DECLARE_GENERIC_FIRMWARE_FB(fbclass) \
+    FORTE_FIRMWARE_FB_ENTRY(fbclass, new fbclass)
+
 
 //!\ingroup CORE This define is used to create the definition necessary for FirmwareFunction blocks in order to get them automatically added to the FirmwareType list.
 #define DECLARE_FIRMWARE_FB(fbclass) \
-    DECLARE_GENERIC_FIRMWARE_FB(fbclass) \
+    FORTE_FIRMWARE_FB_ENTRY(fbclass, FORTE_NEW_FIRMWARE_FB(fbclass)) \
   public: \
     virtual CStringDictionary::TStringId getFBTypeId(void) const;\
   private:
@@ -0,0 +1,752 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include "jsoncodec.h"
+#include "string_utils.h"
+#include <forte_struct.h>
+#include <forte_array.h>
+#include <forte_bool.h>
+#include <forte_any_string.h>
+#include <string.h>
+
+using namespace forte::core::util;
+
+namespace {
+  const size_t scmInitialBufferSize = 256;
+
+  const char scmHexDigits[] = "0123456789abcdef";
+
+  bool isStringType(CIEC_ANY::EDataTypeID paTypeId){
+    return (CIEC_ANY::e_STRING == paTypeId) || (CIEC_ANY::e_WSTRING == paTypeId);
+  }
+
+  bool isLiteralChar(char paValue){
+    return isDigit(paValue) || ((paValue >= 'a') && (paValue <= 'z')) || ((paValue >= 'A') && (paValue <= 'Z')) || ('-' == paValue)
+      || ('+' == paValue) || ('.' == paValue);
+  }
+
+  //! writes the code point UTF-8 encoded, returns the number of bytes used
+  size_t encodeUTF8(TForteUInt32 paCodePoint, char *paDestination){
+    if(paCodePoint < 0x80){
+      paDestination[0] = static_cast<char>(paCodePoint);
+      return 1;
+    }
+    if(paCodePoint < 0x800){
+      paDestination[0] = static_cast<char>(0xC0 | (paCodePoint >> 6));
+      paDestination[1] = static_cast<char>(0x80 | (paCodePoint & 0x3F));
+      return 2;
+    }
+    if(paCodePoint < 0x10000){
+      paDestination[0] = static_cast<char>(0xE0 | (paCodePoint >> 12));
+      paDestination[1] = static_cast<char>(0x80 | ((paCodePoint >> 6) & 0x3F));
+      paDestination[2] = static_cast<char>(0x80 | (paCodePoint & 0x3F));
+      return 3;
+    }
+    paDestination[0] = static_cast<char>(0xF0 | (paCodePoint >> 18));
+    paDestination[1] = static_cast<char>(0x80 | ((paCodePoint >> 12) & 0x3F));
+    paDestination[2] = static_cast<char>(0x80 | ((paCodePoint >> 6) & 0x3F));
+    paDestination[3] = static_cast<char>(0x80 | (paCodePoint & 0x3F));
+    return 4;
+  }
+
+  bool parseHex4(const char *paText, TForteUInt32 &paValue){
+    paValue = 0;
+    for(unsigned int i = 0; i < 4; ++i){
+      if(!isHexDigit(paText[i])){
+        return false;
+      }
+      paValue = (paValue << 4) | static_cast<TForteUInt32>(charHexDigitToInt(paText[i]));
+    }
+    return true;
+  }
+}
+
+CJSONEncoder::CJSONEncoder() :
+    mBuffer(new char[scmInitialBufferSize]), mCapacity(scmInitialBufferSize), mLength(0){
+}
+
+CJSONEncoder::~CJSONEncoder(){
+  delete[] mBuffer;
+}
+
+bool CJSONEncoder::encode(const CIEC_ANY &paValue){
+  switch(paValue.getDataTypeID()){
+    case CIEC_ANY::e_BOOL:
+      appendLiteral(static_cast<bool>(static_cast<const CIEC_BOOL&>(paValue)) ? "true" : "false");
+      return true;
+    case CIEC_ANY::e_SINT:
+    case CIEC_ANY::e_INT:
+    case CIEC_ANY::e_DINT:
+    case CIEC_ANY::e_LINT:
+    case CIEC_ANY::e_USINT:
+    case CIEC_ANY::e_UINT:
+    case CIEC_ANY::e_UDINT:
+    case CIEC_ANY::e_ULINT:
+    case CIEC_ANY::e_BYTE:
+    case CIEC_ANY::e_WORD:
+    case CIEC_ANY::e_DWORD:
+    case CIEC_ANY::e_LWORD:
+    case CIEC_ANY::e_REAL:
+    case CIEC_ANY::e_LREAL:
+      return encodeNumber(paValue);
+    case CIEC_ANY::e_STRING:
+      separate();
+      append('"');
+#ifdef FORTE_UNICODE_SUPPORT
+      appendEscaped(static_cast<const CIEC_ANY_STRING&>(paValue).getValue(), static_cast<const CIEC_ANY_STRING&>(paValue).length(), true);
+#else
+      appendEscaped(static_cast<const CIEC_ANY_STRING&>(paValue).getValue(), static_cast<const CIEC_ANY_STRING&>(paValue).length(), false);
+#endif
+      append('"');
+      return true;
+    case CIEC_ANY::e_WSTRING:
+      //WSTRINGs are stored UTF-8 encoded
+      appendString(static_cast<const CIEC_ANY_STRING&>(paValue).getValue(), static_cast<const CIEC_ANY_STRING&>(paValue).length());
+      return true;
+    case CIEC_ANY::e_DATE_AND_TIME:
+      return encodeDateAndTime(paValue);
+    case CIEC_ANY::e_STRUCT:
+      return encodeStruct(static_cast<const CIEC_STRUCT&>(paValue));
+    case CIEC_ANY::e_ARRAY:
+      return encodeArray(static_cast<const CIEC_ARRAY&>(paValue));
+    case CIEC_ANY::e_ANY:
+      return false;
+    default:
+      return encodeLiteralAsString(paValue);
+  }
+}
+
+void CJSONEncoder::beginObject(){
+  separate();
+  append('{');
+}
+
+void CJSONEncoder::endObject(){
+  append('}');
+}
+
+void CJSONEncoder::addKey(const char *paKey){
+  addKey(paKey, strlen(paKey));
+}
+
+void CJSONEncoder::addKey(const char *paKey, size_t paLength){
+  appendString(paKey, paLength);
+  append(':');
+}
+
+void CJSONEncoder::beginArray(){
+  separate();
+  append('[');
+}
+
+void CJSONEncoder::endArray(){
+  append(']');
+}
+
+void CJSONEncoder::appendString(const char *paText, size_t paLength){
+  separate();
+  append('"');
+  appendEscaped(paText, paLength, false);
+  append('"');
+}
+
+void CJSONEncoder::appendLiteral(const char *paLiteral){
+  separate();
+  append(paLiteral, strlen(paLiteral));
+}
+
+void CJSONEncoder::separate(){
+  if(0 != mLength){
+    char last = mBuffer[mLength - 1];
+    if(('{' != last) && ('[' != last) && (':' != last)){
+      append(',');
+    }
+  }
+}
+
+void CJSONEncoder::append(const char *paText, size_t paLength){
+  memcpy(reserve(paLength), paText, paLength);
+  mLength += paLength;
+}
+
+char *CJSONEncoder::reserve(size_t paSize){
+  if(mCapacity - mLength < paSize){
+    size_t newCapacity = 2 * mCapacity;
+    if(newCapacity - mLength < paSize){
+      newCapacity = mLength + paSize;
+    }
+    char *newBuffer = new char[newCapacity];
+    memcpy(newBuffer, mBuffer, mLength);
+    delete[] mBuffer;
+    mBuffer = newBuffer;
+    mCapacity = newCapacity;
+  }
+  return mBuffer + mLength;
+}
+
+void CJSONEncoder::appendEscaped(const char *paText, size_t paLength, bool paLatin1){
+  //worst case is a control character which needs the six bytes of a \u00XX escape
+  char *runner = reserve(6 * paLength);
+  char *start = runner;
+  for(size_t i = 0; i < paLength; ++i){
+    unsigned char value = static_cast<unsigned char>(paText[i]);
+    switch(value){
+      case '"':
+      case '\\':
+        *runner++ = '\\';
+        *runner++ = static_cast<char>(value);
+        break;
+      case '\n':
+        *runner++ = '\\';
+        *runner++ = 'n';
+        break;
+      case '\r':
+        *runner++ = '\\';
+        *runner++ = 'r';
+        break;
+      case '\t':
+        *runner++ = '\\';
+        *runner++ = 't';
+        break;
+      default:
+        if(value < 0x20){
+          memcpy(runner, "\\u00", 4);
+          runner[4] = scmHexDigits[value >> 4];
+          runner[5] = scmHexDigits[value & 0xF];
+          runner += 6;
+        } else if(paLatin1 && (value >= 0x80)){
+          runner += encodeUTF8(value, runner);
+        } else {
+          *runner++ = static_cast<char>(value);
+        }
+        break;
+    }
+  }
+  mLength += static_cast<size_t>(runner - start);
+}
+
+bool CJSONEncoder::encodeStruct(const CIEC_STRUCT &paValue){
+  const CStringDictionary::TStringId *memberNames = paValue.elementNames();
+  const CIEC_ANY *members = paValue.getMembers();
+  beginObject();
+  for(TForteUInt16 i = 0; i < paValue.getStructSize(); ++i){
+    addKey(CStringDictionary::getInstance().get(memberNames[i]));
+    if(!encode(members[i])){
+      return false;
+    }
+  }
+  endObject();
+  return true;
+}
+
+bool CJSONEncoder::encodeArray(const CIEC_ARRAY &paValue){
+  beginArray();
+  for(TForteUInt16 i = 0; i < paValue.size(); ++i){
+    if(!encode(*paValue[i])){
+      return false;
+    }
+  }
+  endArray();
+  return true;
+}
+
+bool CJSONEncoder::encodeNumber(const CIEC_ANY &paValue){
+  separate();
+  size_t size = paValue.getToStringBufferSize();
+  char *text = reserve(size);
+  int length = paValue.toString(text, size);
+  if(0 >= length){
+    return false;
+  }
+  if((CIEC_ANY::e_REAL == paValue.getDataTypeID()) || (CIEC_ANY::e_LREAL == paValue.getDataTypeID())){
+    //NaN and infinity have no JSON representation
+    for(int i = 0; i < length; ++i){
+      if(('e' != text[i]) && ('E' != text[i]) && !isDigit(text[i]) && ('-' != text[i]) && ('+' != text[i]) && ('.' != text[i])){
+        append("null", 4);
+        return true;
+      }
+    }
+  }
+  mLength += static_cast<size_t>(length);
+  return true;
+}
+
+bool CJSONEncoder::encodeLiteralAsString(const CIEC_ANY &paValue){
+  separate();
+  size_t size = paValue.getToStringBufferSize();
+  bool retVal = false;
+  if(paValue.getDataTypeID() <= CIEC_ANY::e_TIME){
+    //the literals of the elementary types do not contain characters to be escaped
+    char *text = reserve(size + 2);
+    int length = paValue.toString(text + 1, size);
+    if(0 <= length){
+      text[0] = '"';
+      text[length + 1] = '"';
+      mLength += static_cast<size_t>(length) + 2;
+      retVal = true;
+    }
+  } else {
+    char *text = new char[size];
+    int length = paValue.toString(text, size);
+    if(0 <= length){
+      append('"');
+      appendEscaped(text, static_cast<size_t>(length), false);
+      append('"');
+      retVal = true;
+    }
+    delete[] text;
+  }
+  return retVal;
+}
+
+bool CJSONEncoder::encodeDateAndTime(const CIEC_ANY &paValue){
+  separate();
+  size_t size = paValue.getToStringBufferSize();
+  char *text = reserve(size + 3);
+  int length = paValue.toString(text + 1, size);
+  if(0 >= length){
+    return false;
+  }
+  //the literal 2007-12-21-15:00:00.000 becomes 2007-12-21T15:00:00.000Z
+  char *separator = text + 1;
+  for(unsigned int i = 0; (0 != separator) && (i < 3); ++i){
+    separator = strchr(separator + 1, '-');
+  }
+  if(0 == separator){
+    return false;
+  }
+  *separator = 'T';
+  text[0] = '"';
+  text[length + 1] = 'Z';
+  text[length + 2] = '"';
+  mLength += static_cast<size_t>(length) + 3;
+  return true;
+}
+
+CJSONDecoder::CJSONDecoder() :
+    mPos(0), mEnd(0), mScratch(new char[scmInitialBufferSize]), mScratchCapacity(scmInitialBufferSize), mScratchLength(0){
+}
+
+CJSONDecoder::~CJSONDecoder(){
+  delete[] mScratch;
+}
+
+int CJSONDecoder::decode(const char *paText, size_t paLength, CIEC_ANY &paTarget){
+  mPos = paText;
+  mEnd = paText + paLength;
+  if(!parseValue(&paTarget, 0)){
+    return -1;
+  }
+  skipWhiteSpace();
+  return static_cast<int>(mPos - paText);
+}
+
+int CJSONDecoder::decode(const char *paText, size_t paLength, CIEC_ANY *paTargets, size_t paNrOfTargets, const char * const *paNames){
+  mPos = paText;
+  mEnd = paText + paLength;
+  skipWhiteSpace();
+  if(mPos >= mEnd){
+    return -1;
+  }
+  char closing;
+  if('[' == *mPos){
+    closing = ']';
+  } else if(('{' == *mPos) && (0 != paNames)){
+    closing = '}';
+  } else {
+    return -1;
+  }
+  ++mPos;
+  skipWhiteSpace();
+  if((mPos < mEnd) && (closing == *mPos)){
+    ++mPos;
+  } else {
+    for(size_t index = 0;; ++index){
+      CIEC_ANY *target = 0;
+      if(']' == closing){
+        target = (index < paNrOfTargets) ? &paTargets[index] : 0;
+      } else {
+        skipWhiteSpace();
+        if((mPos >= mEnd) || ('"' != *mPos) || !parseString(0)){
+          return -1;
+        }
+        for(size_t i = 0; (0 == target) && (i < paNrOfTargets); ++i){
+          if(0 == strcmp(mScratch, paNames[i])){
+            target = &paTargets[i];
+          }
+        }
+        if(!expect(':')){
+          return -1;
+        }
+      }
+      if(!parseValue(target, 1)){
+        return -1;
+      }
+      skipWhiteSpace();
+      if((mPos < mEnd) && (',' == *mPos)){
+        ++mPos;
+      } else if((mPos < mEnd) && (closing == *mPos)){
+        ++mPos;
+        break;
+      } else {
+        return -1;
+      }
+    }
+  }
+  skipWhiteSpace();
+  return static_cast<int>(mPos - paText);
+}
+
+bool CJSONDecoder::parseValue(CIEC_ANY *paTarget, unsigned int paDepth){
+  skipWhiteSpace();
+  if(mPos >= mEnd){
+    return false;
+  }
+  switch(*mPos){
+    case '{':
+      return parseObject(paTarget, paDepth + 1);
+    case '[':
+      return parseArray(paTarget, paDepth + 1);
+    case '"':
+      return parseString(0) && ((0 == paTarget) || storeText(*paTarget, true));
+    default:
+      return parseLiteral(paTarget);
+  }
+}
+
+bool CJSONDecoder::parseObject(CIEC_ANY *paTarget, unsigned int paDepth){
+  if(paDepth > scmMaxDepth){
+    return false;
+  }
+  ++mPos;
+  CIEC_STRUCT *structTarget = 0;
+  if(0 != paTarget){
+    if(CIEC_ANY::e_STRUCT == paTarget->getDataTypeID()){
+      structTarget = static_cast<CIEC_STRUCT*>(paTarget);
+    } else if((CIEC_ANY::e_ARRAY == paTarget->getDataTypeID()) && isStringType(static_cast<CIEC_ARRAY*>(paTarget)->getElementDataTypeID())){
+      return parseObjectIntoStringArray(*static_cast<CIEC_ARRAY*>(paTarget), paDepth);
+    } else {
+      return false;
+    }
+  }
+
+  skipWhiteSpace();
+  if((mPos < mEnd) && ('}' == *mPos)){
+    ++mPos;
+    return true;
+  }
+  for(;;){
+    skipWhiteSpace();
+    if((mPos >= mEnd) || ('"' != *mPos) || !parseString(0)){
+      return false;
+    }
+    CIEC_ANY *member = 0;
+    if(0 != structTarget){
+      CStringDictionary::TStringId memberNameId = CStringDictionary::getInstance().getId(mScratch);
+      if(CStringDictionary::scm_nInvalidStringId != memberNameId){
+        member = structTarget->getMemberNamed(memberNameId);
+      }
+    }
+    if(!expect(':') || !parseValue(member, paDepth)){
+      return false;
+    }
+    skipWhiteSpace();
+    if(mPos >= mEnd){
+      return false;
+    }
+    if('}' == *mPos){
+      ++mPos;
+      return true;
+    }
+    if(',' != *mPos){
+      return false;
+    }
+    ++mPos;
+  }
+}
+
+bool CJSONDecoder::parseArray(CIEC_ANY *paTarget, unsigned int paDepth){
+  if(paDepth > scmMaxDepth){
+    return false;
+  }
+  ++mPos;
+  CIEC_ARRAY *arrayTarget = 0;
+  if(0 != paTarget){
+    if(CIEC_ANY::e_ARRAY != paTarget->getDataTypeID()){
+      return false;
+    }
+    arrayTarget = static_cast<CIEC_ARRAY*>(paTarget);
+  }
+
+  skipWhiteSpace();
+  if((mPos < mEnd) && (']' == *mPos)){
+    ++mPos;
+    return true;
+  }
+  for(size_t index = 0;; ++index){
+    CIEC_ANY *element = ((0 != arrayTarget) && (index < arrayTarget->size())) ? (*arrayTarget)[static_cast<TForteUInt16>(index)] : 0;
+    if(!parseValue(element, paDepth)){
+      return false;
+    }
+    skipWhiteSpace();
+    if(mPos >= mEnd){
+      return false;
+    }
+    if(']' == *mPos){
+      ++mPos;
+      return true;
+    }
+    if(',' != *mPos){
+      return false;
+    }
+    ++mPos;
+  }
+}
+
+bool CJSONDecoder::parseObjectIntoStringArray(CIEC_ARRAY &paTarget, unsigned int paDepth){
+  skipWhiteSpace();
+  if((mPos < mEnd) && ('}' == *mPos)){
+    ++mPos;
+    return true;
+  }
+  for(size_t index = 0;; ++index){
+    skipWhiteSpace();
+    if((mPos >= mEnd) || ('"' != *mPos) || !parseString(0)){
+      return false;
+    }
+    size_t keyLength = mScratchLength;
+    if(!expect(':')){
+      return false;
+    }
+    skipWhiteSpace();
+    if(mPos >= mEnd){
+      return false;
+    }
+    CIEC_ANY *entry = (index < paTarget.size()) ? paTarget[static_cast<TForteUInt16>(index)] : 0;
+    //the scratch buffer holds the \0 terminated key, so there is space for the =
+    mScratch[keyLength] = '=';
+    if('"' == *mPos){
+      if(!parseString(keyLength + 1)){
+        return false;
+      }
+    } else if(('{' == *mPos) || ('[' == *mPos)){
+      //nested values cannot be represented in a key=value entry
+      if(!parseValue(0, paDepth)){
+        return false;
+      }
+      entry = 0;
+    } else {
+      const char *token;
+      size_t tokenLength;
+      if(!scanToken(token, tokenLength)){
+        return false;
+      }
+      char *value = reserveScratch(keyLength + tokenLength + 2) + keyLength + 1;
+      memcpy(value, token, tokenLength);
+      value[tokenLength] = '\0';
+      mScratchLength = keyLength + 1 + tokenLength;
+    }
+    if((0 != entry) && !storeText(*entry, true)){
+      return false;
+    }
+
+    skipWhiteSpace();
+    if(mPos >= mEnd){
+      return false;
+    }
+    if('}' == *mPos){
+      ++mPos;
+      return true;
+    }
+    if(',' != *mPos){
+      return false;
+    }
+    ++mPos;
+  }
+}
+
+bool CJSONDecoder::parseLiteral(CIEC_ANY *paTarget){
+  const char *token;
+  size_t tokenLength;
+  if(!scanToken(token, tokenLength)){
+    return false;
+  }
+  if((4 == tokenLength) && (0 == strncmp(token, "null", 4))){
+    return true;
+  }
+  if(0 == paTarget){
+    return true;
+  }
+  char *text = reserveScratch(tokenLength + 1);
+  memcpy(text, token, tokenLength);
+  text[tokenLength] = '\0';
+  mScratchLength = tokenLength;
+  return storeText(*paTarget, false);
+}
+
+bool CJSONDecoder::parseString(size_t paOffset){
+  ++mPos;
+  //find the end first, the unescaped content is never longer than the escaped one
+  const char *end = mPos;
+  while((end < mEnd) && ('"' != *end)){
+    if('\\' == *end){
+      ++end;
+    }
+    ++end;
+  }
+  if(end >= mEnd){
+    return false;
+  }
+
+  char *runner = reserveScratch(paOffset + static_cast<size_t>(end - mPos) + 1) + paOffset;
+  char *start = mScratch;
+  while(mPos < end){
+    char value = *mPos++;
+    if('\\' != value){
+      if(static_cast<unsigned char>(value) < 0x20){
+        return false;
+      }
+      *runner++ = value;
+      continue;
+    }
+    value = *mPos++;
+    switch(value){
+      case '"':
+      case '\\':
+      case '/':
+        *runner++ = value;
+        break;
+      case 'b':
+        *runner++ = '\b';
+        break;
+      case 'f':
+        *runner++ = '\f';
+        break;
+      case 'n':
+        *runner++ = '\n';
+        break;
+      case 'r':
+        *runner++ = '\r';
+        break;
+      case 't':
+        *runner++ = '\t';
+        break;
+      case 'u': {
+        TForteUInt32 codePoint;
+        if((end - mPos < 4) || !parseHex4(mPos, codePoint)){
+          return false;
+        }
+        mPos += 4;
+        if((0 == codePoint) || ((codePoint >= 0xDC00) && (codePoint <= 0xDFFF))){
+          //the strings are terminated by \0, and a low surrogate needs a high one before it
+          return false;
+        }
+        if((codePoint >= 0xD800) && (codePoint < 0xDC00)){
+          //high surrogate, the low one has to follow
+          TForteUInt32 lowSurrogate;
+          if((end - mPos < 6) || ('\\' != mPos[0]) || ('u' != mPos[1]) || !parseHex4(mPos + 2, lowSurrogate)
+            || (lowSurrogate < 0xDC00) || (lowSurrogate > 0xDFFF)){
+            return false;
+          }
+          mPos += 6;
+          codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+        }
+        runner += encodeUTF8(codePoint, runner);
+        break;
+      }
+      default:
+        return false;
+    }
+  }
+  ++mPos; //closing quote
+  *runner = '\0';
+  mScratchLength = static_cast<size_t>(runner - start);
+  return true;
+}
+
+bool CJSONDecoder::scanToken(const char *&paStart, size_t &paLength){
+  paStart = mPos;
+  while((mPos < mEnd) && isLiteralChar(*mPos)){
+    ++mPos;
+  }
+  paLength = static_cast<size_t>(mPos - paStart);
+  if(0 == paLength){
+    return false;
+  }
+  if(isDigit(*paStart) || ('-' == *paStart)){
+    return true;
+  }
+  return ((4 == paLength) && ((0 == strncmp(paStart, "true", 4)) || (0 == strncmp(paStart, "null", 4))))
+    || ((5 == paLength) && (0 == strncmp(paStart, "false", 5)));
+}
+
+bool CJSONDecoder::storeText(CIEC_ANY &paTarget, bool paWasString){
+  switch(paTarget.getDataTypeID()){
+    case CIEC_ANY::e_STRING:
+    case CIEC_ANY::e_WSTRING:
+#ifdef FORTE_UNICODE_SUPPORT
+      return 0 <= static_cast<CIEC_ANY_STRING&>(paTarget).fromUTF8(mScratch, static_cast<int>(mScratchLength), false);
+#else
+      static_cast<CIEC_ANY_STRING&>(paTarget).assign(mScratch, static_cast<TForteUInt16>(
+          (mScratchLength < CIEC_ANY_STRING::scm_unMaxStringLen) ? mScratchLength : CIEC_ANY_STRING::scm_unMaxStringLen));
+      return true;
+#endif
+    case CIEC_ANY::e_STRUCT:
+    case CIEC_ANY::e_ARRAY:
+      return false;
+    case CIEC_ANY::e_DATE_AND_TIME:
+      //ISO 8601 (2007-12-21T15:00:00.000Z) to the IEC literal (2007-12-21-15:00:00.000)
+      if(paWasString && (mScratchLength > 10) && ('T' == mScratch[10])){
+        mScratch[10] = '-';
+        if('Z' == mScratch[mScratchLength - 1]){
+          mScratch[--mScratchLength] = '\0';
+        }
+      }
+      break;
+    default:
+      break;
+  }
+  if(0 == mScratchLength){
+    //e.g., an empty timestamp
+    return paWasString;
+  }
+  return static_cast<int>(mScratchLength) == paTarget.fromString(mScratch);
+}
+
+bool CJSONDecoder::expect(char paCharacter){
+  skipWhiteSpace();
+  if((mPos < mEnd) && (paCharacter == *mPos)){
+    ++mPos;
+    return true;
+  }
+  return false;
+}
+
+void CJSONDecoder::skipWhiteSpace(){
+  while((mPos < mEnd) && ((' ' == *mPos) || ('\n' == *mPos) || ('\r' == *mPos) || ('\t' == *mPos))){
+    ++mPos;
+  }
+}
+
+char *CJSONDecoder::reserveScratch(size_t paSize){
+  if(paSize > mScratchCapacity){
+    size_t newCapacity = 2 * mScratchCapacity;
+    if(newCapacity < paSize){
+      newCapacity = paSize;
+    }
+    char *newScratch = new char[newCapacity];
+    memcpy(newScratch, mScratch, mScratchCapacity);
+    delete[] mScratch;
+    mScratch = newScratch;
+    mScratchCapacity = newCapacity;
+  }
+  return mScratch;
+}
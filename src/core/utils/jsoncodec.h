@@ -0,0 +1,186 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#ifndef _JSONCODEC_H_
+#define _JSONCODEC_H_
+
+#include <forte_any.h>
+#include <stddef.h>
+
+class CIEC_STRUCT;
+class CIEC_ARRAY;
+
+namespace forte {
+  namespace core {
+    namespace util {
+
+      /*!\brief Encodes IEC 61131 values as JSON text
+       *
+       * The values are written directly into the encoder's buffer, walking structs and arrays along their type
+       * information. The buffer is kept between messages so that encoding does not allocate in the steady state.
+       *
+       * Mapping: BOOL to true/false, numbers (integers, bit strings, REAL, LREAL) to JSON numbers (NaN and
+       * infinity to null), STRING and WSTRING to JSON strings, DATE_AND_TIME to an ISO 8601 string
+       * (e.g., "2007-12-21T15:00:00.000Z"), all other elementary types to a string of their IEC literal
+       * (e.g., "T#5ms"), structs to objects with the member names as keys and arrays to JSON arrays.
+       *
+       * Besides whole values, objects and arrays can be composed with the building block functions. Commas between
+       * values and members are inserted automatically.
+       */
+      class CJSONEncoder{
+        public:
+          CJSONEncoder();
+          ~CJSONEncoder();
+
+          //! Removes the encoded text, the buffer is kept
+          void clear(){
+            mLength = 0;
+          }
+
+          //! Encoded text, not \0 terminated
+          const char *getData() const {
+            return mBuffer;
+          }
+
+          size_t getLength() const {
+            return mLength;
+          }
+
+          /*!\brief Appends the JSON representation of the value
+           *
+           * @return false if the value or one of its elements has a type that cannot be encoded
+           */
+          bool encode(const CIEC_ANY &paValue);
+
+          void beginObject();
+          void endObject();
+
+          //! Appends the key of the next object member
+          void addKey(const char *paKey);
+          void addKey(const char *paKey, size_t paLength);
+
+          void beginArray();
+          void endArray();
+
+          //! Appends a JSON string with the given UTF-8 encoded content
+          void appendString(const char *paText, size_t paLength);
+
+          //! Appends a value which is already valid JSON, e.g., true or null
+          void appendLiteral(const char *paLiteral);
+
+        private:
+          //! Inserts the comma needed in front of the next value or key
+          void separate();
+
+          void append(char paCharacter){
+            reserve(1)[0] = paCharacter;
+            ++mLength;
+          }
+
+          void append(const char *paText, size_t paLength);
+
+          //! Provides paSize bytes of free space at the end of the buffer
+          char *reserve(size_t paSize);
+
+          /*!\brief Appends the text escaped for a JSON string without the quotes
+           *
+           * @param paLatin1 the text is ISO 8859-1 encoded and has to be converted to UTF-8
+           */
+          void appendEscaped(const char *paText, size_t paLength, bool paLatin1);
+
+          bool encodeStruct(const CIEC_STRUCT &paValue);
+          bool encodeArray(const CIEC_ARRAY &paValue);
+          bool encodeNumber(const CIEC_ANY &paValue);
+          bool encodeLiteralAsString(const CIEC_ANY &paValue);
+          bool encodeDateAndTime(const CIEC_ANY &paValue);
+
+          char *mBuffer;
+          size_t mCapacity;
+          size_t mLength;
+
+          CJSONEncoder(const CJSONEncoder&);
+          CJSONEncoder& operator =(const CJSONEncoder &);
+      };
+
+      /*!\brief Decodes JSON text into IEC 61131 values
+       *
+       * The text is parsed in a single pass and every JSON value is directly stored into the element of the target
+       * it belongs to. The target's type information guides the decoding, the mapping is the reverse of the one of
+       * CJSONEncoder. In addition:
+       *   - object members without a struct member of the same name are skipped
+       *   - array entries beyond the size of the target array are skipped
+       *   - an object decoded into an array of STRING or WSTRING results in "key=value" entries (e.g., metadata)
+       *   - null and empty strings for non string types leave the target unchanged
+       *
+       * Nesting is limited to scmMaxDepth levels so that malicious input cannot exhaust the stack.
+       */
+      class CJSONDecoder{
+        public:
+          static const unsigned int scmMaxDepth = 64;
+
+          CJSONDecoder();
+          ~CJSONDecoder();
+
+          /*!\brief Decodes the JSON value at the beginning of the text into paTarget
+           *
+           * @return number of bytes used from the text including trailing white space, -1 on error
+           */
+          int decode(const char *paText, size_t paLength, CIEC_ANY &paTarget);
+
+          /*!\brief Decodes a JSON array or object into several values (e.g., the RDs of a communication FB)
+           *
+           * The entries of an array are stored one after the other. Members of an object are stored into the value
+           * with the same name in paNames, with 0 for paNames only arrays are accepted.
+           *
+           * @return number of bytes used from the text including trailing white space, -1 on error
+           */
+          int decode(const char *paText, size_t paLength, CIEC_ANY *paTargets, size_t paNrOfTargets, const char * const *paNames);
+
+        private:
+          //! Parses the next value and stores it into paTarget, with 0 for paTarget the value is skipped
+          bool parseValue(CIEC_ANY *paTarget, unsigned int paDepth);
+          bool parseObject(CIEC_ANY *paTarget, unsigned int paDepth);
+          bool parseArray(CIEC_ANY *paTarget, unsigned int paDepth);
+          bool parseObjectIntoStringArray(CIEC_ARRAY &paTarget, unsigned int paDepth);
+          bool parseLiteral(CIEC_ANY *paTarget);
+
+          /*!\brief Unescapes the string at the current position into the scratch buffer starting at paOffset
+           *
+           * The result is \0 terminated, mScratchLength is the length of the content without the terminator.
+           */
+          bool parseString(size_t paOffset);
+
+          //! Scans the number or literal token (true, false, null) at the current position
+          bool scanToken(const char *&paStart, size_t &paLength);
+
+          //! Stores the content of the scratch buffer into the elementary value paTarget
+          bool storeText(CIEC_ANY &paTarget, bool paWasString);
+
+          bool expect(char paCharacter);
+          void skipWhiteSpace();
+          char *reserveScratch(size_t paSize);
+
+          const char *mPos;
+          const char *mEnd;
+
+          char *mScratch;
+          size_t mScratchCapacity;
+          size_t mScratchLength;
+
+          CJSONDecoder(const CJSONDecoder&);
+          CJSONDecoder& operator =(const CJSONDecoder &);
+      };
+
+    }
+  }
+}
+
+#endif /* _JSONCODEC_H_ */
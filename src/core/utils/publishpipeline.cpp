@@ -0,0 +1,110 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include "publishpipeline.h"
+#include <string.h>
+
+using namespace forte::core::util;
+
+CPublishPipeline::CPublishPipeline() :
+    mWindowSize(0), mQueueSize(0), mQueue(0), mQueueHead(0), mSendTimes(0), mInFlightHead(0){
+  memset(&mStatistics, 0, sizeof(mStatistics));
+}
+
+CPublishPipeline::~CPublishPipeline(){
+  freeBuffers();
+}
+
+bool CPublishPipeline::init(unsigned int paWindowSize, unsigned int paQueueSize){
+  if((0 == paWindowSize) || (0 == paQueueSize)){
+    return false;
+  }
+  freeBuffers();
+  memset(&mStatistics, 0, sizeof(mStatistics));
+  mWindowSize = paWindowSize;
+  mQueueSize = paQueueSize;
+  mQueue = new SMessage[mQueueSize];
+  memset(mQueue, 0, sizeof(SMessage) * mQueueSize);
+  mQueueHead = 0;
+  mSendTimes = new uint_fast64_t[mWindowSize];
+  mInFlightHead = 0;
+  return true;
+}
+
+void CPublishPipeline::sent(uint_fast64_t paNow){
+  mSendTimes[(mInFlightHead + mStatistics.mInFlight) % mWindowSize] = paNow;
+  mStatistics.mInFlight++;
+  mStatistics.mSent++;
+}
+
+void CPublishPipeline::enqueue(const void *paData, unsigned int paSize){
+  if(mStatistics.mQueueDepth == mQueueSize){
+    //coalesce: the oldest queued message is replaced by the newest one
+    mQueueHead = (mQueueHead + 1) % mQueueSize;
+    mStatistics.mQueueDepth--;
+    mStatistics.mDropped++;
+  }
+  SMessage &message(mQueue[(mQueueHead + mStatistics.mQueueDepth) % mQueueSize]);
+  if(message.mCapacity < paSize){
+    delete[] message.mData;
+    message.mData = new char[paSize];
+    message.mCapacity = paSize;
+  }
+  memcpy(message.mData, paData, paSize);
+  message.mSize = paSize;
+  mStatistics.mQueueDepth++;
+  if(mStatistics.mQueueDepth > mStatistics.mMaxQueueDepth){
+    mStatistics.mMaxQueueDepth = mStatistics.mQueueDepth;
+  }
+}
+
+bool CPublishPipeline::acknowledged(bool paSuccess, uint_fast64_t paNow){
+  if(0 == mStatistics.mInFlight){
+    return false;
+  }
+  uint_fast64_t latency = paNow - mSendTimes[mInFlightHead];
+  mInFlightHead = (mInFlightHead + 1) % mWindowSize;
+  mStatistics.mInFlight--;
+  if(paSuccess){
+    mStatistics.mAcknowledged++;
+    mStatistics.mLastAckLatency = latency;
+    mStatistics.mSumAckLatency += latency;
+    if(latency > mStatistics.mMaxAckLatency){
+      mStatistics.mMaxAckLatency = latency;
+    }
+  }
+  else{
+    mStatistics.mFailed++;
+  }
+  return true;
+}
+
+const CPublishPipeline::SMessage *CPublishPipeline::takeNext(){
+  if((0 == mStatistics.mQueueDepth) || isWindowFull()){
+    return 0;
+  }
+  const SMessage *message = &mQueue[mQueueHead];
+  mQueueHead = (mQueueHead + 1) % mQueueSize;
+  mStatistics.mQueueDepth--;
+  return message;
+}
+
+void CPublishPipeline::freeBuffers(){
+  if(0 != mQueue){
+    for(unsigned int i = 0; i < mQueueSize; i++){
+      delete[] mQueue[i].mData;
+    }
+    delete[] mQueue;
+    mQueue = 0;
+  }
+  delete[] mSendTimes;
+  mSendTimes = 0;
+}
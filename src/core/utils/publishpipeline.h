@@ -0,0 +1,121 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#ifndef PUBLISHPIPELINE_H_
+#define PUBLISHPIPELINE_H_
+
+#include <forte_architecture_time.h>
+
+namespace forte {
+  namespace core {
+    namespace util {
+
+      /*!\brief Bookkeeping of messages sent to a broker which acknowledges them asynchronously
+       *
+       * At most getWindowSize() messages may wait for their acknowledgment. Further messages wait in a queue until an
+       * acknowledgment frees a slot of the window. If the queue is full the oldest queued message is replaced by the
+       * newest one, so a slow broker gets the latest values instead of a growing backlog. Acknowledgments are expected
+       * in send order, which gives the latency of every message.
+       *
+       * The pipeline has no lock of its own, the user has to serialize all calls.
+       */
+      class CPublishPipeline{
+        public:
+          //! Metrics of the pipeline, latencies are in nanoseconds
+          struct SStatistics{
+              unsigned int mQueueDepth; //!< number of messages currently waiting for a free slot in the window
+              unsigned int mMaxQueueDepth;
+              unsigned int mInFlight; //!< number of messages sent and not yet acknowledged
+              TForteUInt32 mSent;
+              TForteUInt32 mAcknowledged;
+              TForteUInt32 mDropped; //!< queued messages replaced by newer ones because the queue was full
+              TForteUInt32 mFailed;
+              uint_fast64_t mLastAckLatency;
+              uint_fast64_t mMaxAckLatency;
+              uint_fast64_t mSumAckLatency;
+          };
+
+          //! A queued message, the data stays valid until the next call of enqueue
+          struct SMessage{
+              char *mData;
+              unsigned int mSize;
+              unsigned int mCapacity;
+          };
+
+          CPublishPipeline();
+          ~CPublishPipeline();
+
+          //! Allocates the window and the queue, both sizes have to be at least one
+          bool init(unsigned int paWindowSize, unsigned int paQueueSize);
+
+          unsigned int getWindowSize() const {
+            return mWindowSize;
+          }
+
+          unsigned int getQueueSize() const {
+            return mQueueSize;
+          }
+
+          bool isWindowFull() const {
+            return (mStatistics.mInFlight >= mWindowSize);
+          }
+
+          //! Records a message handed to the broker at paNow, the window must not be full
+          void sent(uint_fast64_t paNow);
+
+          //! Records a message which could not be handed to the broker
+          void sendFailed(){
+            mStatistics.mFailed++;
+          }
+
+          //! Copies the message into the queue, replacing the oldest queued message if the queue is full
+          void enqueue(const void *paData, unsigned int paSize);
+
+          /*!\brief Records the acknowledgment of the oldest message in flight
+           *
+           * @param paSuccess false if the broker reported a failure for the message
+           * @param paNow time the acknowledgment arrived
+           * @return false if no message is in flight
+           */
+          bool acknowledged(bool paSuccess, uint_fast64_t paNow);
+
+          //! Takes the oldest queued message if the window has a free slot, otherwise returns 0
+          const SMessage *takeNext();
+
+          //! Drops all queued messages
+          void clearQueue(){
+            mStatistics.mQueueDepth = 0;
+          }
+
+          const SStatistics &getStatistics() const {
+            return mStatistics;
+          }
+
+        private:
+          void freeBuffers();
+
+          unsigned int mWindowSize;
+          unsigned int mQueueSize;
+          SMessage *mQueue;
+          unsigned int mQueueHead;
+          uint_fast64_t *mSendTimes; //!< send time of each message in flight
+          unsigned int mInFlightHead;
+          SStatistics mStatistics;
+
+          CPublishPipeline(const CPublishPipeline&);
+          CPublishPipeline& operator=(const CPublishPipeline&);
+      };
+
+    }
+  }
+}
+
+#endif /* PUBLISHPIPELINE_H_ */
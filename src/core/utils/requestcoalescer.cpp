@@ -0,0 +1,84 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include "requestcoalescer.h"
+
+using namespace forte::core::util;
+
+CRequestCoalescer::~CRequestCoalescer(){
+  clearRequests();
+}
+
+bool CRequestCoalescer::queue(SCoalescedAction &paAction, uint_fast64_t paNow){
+  if(paAction.mQueued){
+    return false;
+  }
+  if(isEmpty()){
+    mFirstQueuedTime = paNow;
+  }
+  paAction.mQueued = true;
+  mQueue.pushBack(&paAction);
+  mNoOfQueued++;
+  return true;
+}
+
+uint_fast64_t CRequestCoalescer::getTimeToSend(uint_fast64_t paNow) const {
+  uint_fast64_t retVal = 0;
+  if(!isEmpty()){
+    uint_fast64_t elapsed = paNow - mFirstQueuedTime;
+    if(elapsed < mWindow){
+      retVal = mWindow - elapsed;
+    }
+  }
+  return retVal;
+}
+
+CCoalescedRequest *CRequestCoalescer::take(){
+  if(isEmpty()){
+    return 0;
+  }
+  CCoalescedRequest *request = new CCoalescedRequest(mNoOfQueued);
+  for(CSinglyLinkedList<SCoalescedAction*>::Iterator it = mQueue.begin(); it != mQueue.end(); ++it){
+    request->addPart(**it);
+    (*it)->mQueued = false;
+  }
+  mQueue.clearAll();
+  mNoOfQueued = 0;
+  mRequests.pushBack(request);
+  return request;
+}
+
+void CRequestCoalescer::finished(CCoalescedRequest *paRequest){
+  mRequests.erase(paRequest);
+  delete paRequest;
+}
+
+void CRequestCoalescer::remove(SCoalescedAction &paAction){
+  if(paAction.mQueued){
+    mQueue.erase(&paAction);
+    mNoOfQueued--;
+    paAction.mQueued = false;
+  }
+  for(CSinglyLinkedList<CCoalescedRequest*>::Iterator it = mRequests.begin(); it != mRequests.end(); ++it){
+    for(size_t i = 0; i < (*it)->mNoOfParts; i++){
+      if(&paAction == (*it)->mParts[i].mAction){
+        (*it)->mParts[i].mAction = 0;
+      }
+    }
+  }
+}
+
+void CRequestCoalescer::clearRequests(){
+  for(CSinglyLinkedList<CCoalescedRequest*>::Iterator it = mRequests.begin(); it != mRequests.end(); ++it){
+    delete *it;
+  }
+  mRequests.clearAll();
+}
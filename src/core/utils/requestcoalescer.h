@@ -0,0 +1,144 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#ifndef REQUESTCOALESCER_H_
+#define REQUESTCOALESCER_H_
+
+#include <fortelist.h>
+#include <forte_architecture_time.h>
+#include <stddef.h>
+
+namespace forte {
+  namespace core {
+    namespace util {
+
+      /*!\brief Action of a CRequestCoalescer, to be used as base of the structure holding the action's request elements
+       *
+       * An element is one item of the request sent to the remote, e.g., one node of an OPC UA read request.
+       */
+      struct SCoalescedAction{
+          explicit SCoalescedAction(size_t paNoOfElements) :
+              mNoOfElements(paNoOfElements), mQueued(false){
+          }
+
+          size_t mNoOfElements;
+          //! the action waits in the queue, queueing it again does not add it a second time
+          bool mQueued;
+      };
+
+      //! One request sent for all actions queued within a coalescing window
+      class CCoalescedRequest{
+        public:
+          //! The elements mOffset to mOffset + mSize - 1 of the request and of its response belong to mAction
+          struct SPart{
+              //! 0 if the action was removed while the request was in flight
+              SCoalescedAction *mAction;
+              size_t mOffset;
+              size_t mSize;
+          };
+
+          explicit CCoalescedRequest(size_t paNoOfParts) :
+              mParts(new SPart[paNoOfParts]), mNoOfParts(0), mNoOfElements(0){
+          }
+
+          ~CCoalescedRequest(){
+            delete[] mParts;
+          }
+
+          size_t getNoOfParts() const {
+            return mNoOfParts;
+          }
+
+          const SPart &getPart(size_t paIndex) const {
+            return mParts[paIndex];
+          }
+
+          //! Total number of elements of all actions in the request
+          size_t getNoOfElements() const {
+            return mNoOfElements;
+          }
+
+        private:
+          friend class CRequestCoalescer;
+
+          void addPart(SCoalescedAction &paAction){
+            SPart &part(mParts[mNoOfParts++]);
+            part.mAction = &paAction;
+            part.mOffset = mNoOfElements;
+            part.mSize = paAction.mNoOfElements;
+            mNoOfElements += part.mSize;
+          }
+
+          SPart *mParts;
+          size_t mNoOfParts;
+          size_t mNoOfElements;
+
+          CCoalescedRequest(const CCoalescedRequest&);
+          CCoalescedRequest& operator=(const CCoalescedRequest&);
+      };
+
+      /*!\brief Collects the actions for one remote which are executed within a time window, so that they are sent in one request
+       *
+       * The window starts with the oldest queued action. The requests taken from the coalescer stay in flight until they
+       * are finished, so that removing an action detaches it from the requests waiting for their response.
+       *
+       * The coalescer has no lock of its own, the user has to serialize all calls.
+       */
+      class CRequestCoalescer{
+        public:
+          //! @param paWindow time in nanoseconds the actions are collected
+          explicit CRequestCoalescer(uint_fast64_t paWindow) :
+              mWindow(paWindow), mNoOfQueued(0), mFirstQueuedTime(0){
+          }
+
+          ~CRequestCoalescer();
+
+          bool isEmpty() const {
+            return (0 == mNoOfQueued);
+          }
+
+          //! @return false if the action was queued already
+          bool queue(SCoalescedAction &paAction, uint_fast64_t paNow);
+
+          //! @return time in nanoseconds until the window of the queued actions ends, 0 if they are due or nothing is queued
+          uint_fast64_t getTimeToSend(uint_fast64_t paNow) const;
+
+          /*!\brief Takes all queued actions as one request in queueing order
+           *
+           * @return the request, which is in flight until finished is called for it, or 0 if nothing is queued
+           */
+          CCoalescedRequest *take();
+
+          //! Deletes a request returned by take after its response was handled or it could not be sent
+          void finished(CCoalescedRequest *paRequest);
+
+          //! Removes the action from the queue and from all requests in flight, e.g., before it is deleted
+          void remove(SCoalescedAction &paAction);
+
+          //! Deletes all requests in flight, e.g., when the connection to the remote is closed
+          void clearRequests();
+
+        private:
+          const uint_fast64_t mWindow;
+          CSinglyLinkedList<SCoalescedAction*> mQueue;
+          size_t mNoOfQueued;
+          uint_fast64_t mFirstQueuedTime;
+          CSinglyLinkedList<CCoalescedRequest*> mRequests;
+
+          CRequestCoalescer(const CRequestCoalescer&);
+          CRequestCoalescer& operator=(const CRequestCoalescer&);
+      };
+
+    }
+  }
+}
+
+#endif /* REQUESTCOALESCER_H_ */
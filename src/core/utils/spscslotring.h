@@ -0,0 +1,88 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#ifndef SPSCSLOTRING_H_
+#define SPSCSLOTRING_H_
+
+#include <datatype.h>
+#include <forte_atomic.h>
+
+namespace forte {
+  namespace core {
+    namespace util {
+
+      /*!\brief Lock-free bookkeeping of a ring of preallocated slots with a single producer and a single consumer
+       *
+       * The ring only hands out slot indices, the slots themselves belong to the user, e.g., one preallocated value per
+       * slot. The producer fills getWriteSlot() and publishes it with commitWrite(), the consumer reads getReadSlot()
+       * and hands it back with commitRead(). Both sides only advance their own free-running counter, so none of them
+       * ever waits for the other.
+       */
+      class CSPSCSlotRing{
+        public:
+          //! @param paNrOfSlots number of slots, rounded up to the next power of two
+          explicit CSPSCSlotRing(unsigned int paNrOfSlots) :
+              mNrOfSlots(1), mWritten(0), mRead(0){
+            while(mNrOfSlots < paNrOfSlots){
+              mNrOfSlots <<= 1;
+            }
+          }
+
+          unsigned int getNrOfSlots() const {
+            return mNrOfSlots;
+          }
+
+          //! All slots are filled and not yet read, the producer must not write (producer side)
+          bool isFull() const {
+            return (mWritten.load() - mRead.load()) >= mNrOfSlots;
+          }
+
+          //! Slot to be filled next, only valid if the ring is not full (producer side)
+          unsigned int getWriteSlot() const {
+            return mWritten.load() & (mNrOfSlots - 1);
+          }
+
+          //! Hands the filled slot to the consumer (producer side)
+          void commitWrite(){
+            mWritten.store(mWritten.load() + 1);
+          }
+
+          //! No filled slot is waiting to be read (consumer side)
+          bool isEmpty() const {
+            return mRead.load() == mWritten.load();
+          }
+
+          //! Oldest filled slot, only valid if the ring is not empty (consumer side)
+          unsigned int getReadSlot() const {
+            return mRead.load() & (mNrOfSlots - 1);
+          }
+
+          //! Hands the read slot back to the producer (consumer side)
+          void commitRead(){
+            mRead.store(mRead.load() + 1);
+          }
+
+        private:
+          unsigned int mNrOfSlots;
+          //! slots filled so far, only advanced by the producer
+          forte::arch::CAtomicUInt32 mWritten;
+          //! slots read so far, only advanced by the consumer
+          forte::arch::CAtomicUInt32 mRead;
+
+          CSPSCSlotRing(const CSPSCSlotRing&);
+          CSPSCSlotRing& operator =(const CSPSCSlotRing &);
+      };
+
+    }
+  }
+}
+
+#endif /* SPSCSLOTRING_H_ */
@@ -0,0 +1,111 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ * agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+
+#ifndef TOPICTRIE_H_
+#define TOPICTRIE_H_
+
+#include <fortelist.h>
+#include <map>
+#include <string>
+
+namespace forte {
+  namespace core {
+    namespace util {
+
+      /*!\brief Topic index for dispatching the messages of publish/subscribe protocols, e.g., MQTT
+       *
+       * The trie stores for each topic filter the registered entries. Every topic level is a node in the trie so
+       * that finding the entries for a received topic only depends on the number of levels of the topic and not on
+       * the number of subscriptions. The MQTT wildcards '+' (single level) and '#' (multi level) are supported in
+       * the stored topic filters.
+       */
+      template<typename T>
+      class CTopicTrie {
+        public:
+          CTopicTrie();
+          ~CTopicTrie();
+
+          /*!\brief Add an entry for the given topic filter
+           *
+           * @param paTopicFilter topic filter as used for the subscription, may contain the wildcards '+' and '#'
+           * @param paEntry the entry to be returned for topics matching the filter
+           */
+          void insert(const char *paTopicFilter, T *paEntry);
+
+          /*!\brief Remove an entry from the given topic filter
+           *
+           * @return true if the entry was registered for the topic filter
+           */
+          bool remove(const char *paTopicFilter, T *paEntry);
+
+          /*!\brief Call the visitor for all entries whose topic filter matches the given topic
+           *
+           * @param paTopic a topic name as received from the broker (i.e., without wildcards)
+           * @param paVisitor functor with an operator()(T*) which is called for every matching entry
+           * @return number of matching entries
+           */
+          template<typename TVisitor>
+          size_t match(const char *paTopic, TVisitor &paVisitor) const;
+
+          bool isEmpty() const {
+            return mRoot.isEmpty();
+          }
+
+          static const char scmLevelSeparator = '/';
+          static const char scmSingleLevelWildcard = '+';
+          static const char scmMultiLevelWildcard = '#';
+
+        private:
+          class CNode {
+            public:
+              CNode(){
+              }
+
+              ~CNode();
+
+              bool isEmpty() const {
+                return mEntries.isEmpty() && mChildren.empty();
+              }
+
+              typedef std::map<std::string, CNode *> TChildMap;
+
+              TChildMap mChildren;
+              CSinglyLinkedList<T *> mEntries;
+
+            private:
+              CNode(const CNode&);
+              CNode& operator=(const CNode&);
+          };
+
+          template<typename TVisitor>
+          static size_t matchLevel(const CNode &paNode, const char *paLevelStart, bool paFirstLevel, TVisitor &paVisitor);
+
+          template<typename TVisitor>
+          static size_t visitEntries(const CNode &paNode, TVisitor &paVisitor);
+
+          static bool removeFromNode(CNode &paNode, const char *paLevelStart, T *paEntry);
+
+          static const char *getLevelEnd(const char *paLevelStart);
+
+          CNode mRoot;
+
+          CTopicTrie(const CTopicTrie&);
+          CTopicTrie& operator=(const CTopicTrie&);
+      };
+
+    }
+  }
+}
+
+#include "topictrie.tpp"
+
+#endif /* TOPICTRIE_H_ */
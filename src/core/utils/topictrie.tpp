@@ -0,0 +1,144 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ * agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+
+#include <string.h>
+
+namespace forte {
+  namespace core {
+    namespace util {
+
+      template<typename T>
+      CTopicTrie<T>::CTopicTrie(){
+      }
+
+      template<typename T>
+      CTopicTrie<T>::~CTopicTrie(){
+      }
+
+      template<typename T>
+      CTopicTrie<T>::CNode::~CNode(){
+        for(typename TChildMap::iterator it = mChildren.begin(); it != mChildren.end(); ++it){
+          delete it->second;
+        }
+      }
+
+      template<typename T>
+      void CTopicTrie<T>::insert(const char *paTopicFilter, T *paEntry){
+        CNode *node = &mRoot;
+        const char *levelStart = paTopicFilter;
+        while(0 != levelStart){
+          const char *levelEnd = getLevelEnd(levelStart);
+          std::string level(levelStart, levelEnd);
+          typename CNode::TChildMap::iterator it = node->mChildren.find(level);
+          if(node->mChildren.end() == it){
+            it = node->mChildren.insert(std::make_pair(level, new CNode())).first;
+          }
+          node = it->second;
+          levelStart = ('\0' == *levelEnd) ? 0 : levelEnd + 1;
+        }
+        node->mEntries.pushBack(paEntry);
+      }
+
+      template<typename T>
+      bool CTopicTrie<T>::remove(const char *paTopicFilter, T *paEntry){
+        return removeFromNode(mRoot, paTopicFilter, paEntry);
+      }
+
+      template<typename T>
+      bool CTopicTrie<T>::removeFromNode(CNode &paNode, const char *paLevelStart, T *paEntry){
+        if(0 == paLevelStart){
+          for(typename CSinglyLinkedList<T *>::Iterator it = paNode.mEntries.begin(); it != paNode.mEntries.end(); ++it){
+            if(*it == paEntry){
+              paNode.mEntries.erase(paEntry);
+              return true;
+            }
+          }
+          return false;
+        }
+
+        const char *levelEnd = getLevelEnd(paLevelStart);
+        typename CNode::TChildMap::iterator it = paNode.mChildren.find(std::string(paLevelStart, levelEnd));
+        if(paNode.mChildren.end() != it && removeFromNode(*it->second, ('\0' == *levelEnd) ? 0 : levelEnd + 1, paEntry)){
+          if(it->second->isEmpty()){
+            delete it->second;
+            paNode.mChildren.erase(it);
+          }
+          return true;
+        }
+        return false;
+      }
+
+      template<typename T>
+      template<typename TVisitor>
+      size_t CTopicTrie<T>::match(const char *paTopic, TVisitor &paVisitor) const{
+        return matchLevel(mRoot, paTopic, true, paVisitor);
+      }
+
+      template<typename T>
+      template<typename TVisitor>
+      size_t CTopicTrie<T>::matchLevel(const CNode &paNode, const char *paLevelStart, bool paFirstLevel, TVisitor &paVisitor){
+        static const std::string scmMultiLevelKey(1, scmMultiLevelWildcard);
+        static const std::string scmSingleLevelKey(1, scmSingleLevelWildcard);
+
+        size_t retVal = 0;
+        typename CNode::TChildMap::const_iterator multiLevel = paNode.mChildren.find(scmMultiLevelKey);
+
+        if(0 == paLevelStart){
+          retVal += visitEntries(paNode, paVisitor);
+          if(paNode.mChildren.end() != multiLevel){
+            //"a/#" also matches the parent level "a"
+            retVal += visitEntries(*multiLevel->second, paVisitor);
+          }
+          return retVal;
+        }
+
+        const char *levelEnd = getLevelEnd(paLevelStart);
+        const char *nextLevel = ('\0' == *levelEnd) ? 0 : levelEnd + 1;
+
+        //topics starting with $ (e.g., $SYS) are not matched by wildcards on the first level
+        if(!paFirstLevel || '$' != *paLevelStart){
+          if(paNode.mChildren.end() != multiLevel){
+            retVal += visitEntries(*multiLevel->second, paVisitor);
+          }
+          typename CNode::TChildMap::const_iterator singleLevel = paNode.mChildren.find(scmSingleLevelKey);
+          if(paNode.mChildren.end() != singleLevel){
+            retVal += matchLevel(*singleLevel->second, nextLevel, false, paVisitor);
+          }
+        }
+
+        typename CNode::TChildMap::const_iterator exact = paNode.mChildren.find(std::string(paLevelStart, levelEnd));
+        if(paNode.mChildren.end() != exact){
+          retVal += matchLevel(*exact->second, nextLevel, false, paVisitor);
+        }
+        return retVal;
+      }
+
+      template<typename T>
+      template<typename TVisitor>
+      size_t CTopicTrie<T>::visitEntries(const CNode &paNode, TVisitor &paVisitor){
+        size_t retVal = 0;
+        for(typename CSinglyLinkedList<T *>::Iterator it = paNode.mEntries.begin(); it != paNode.mEntries.end(); ++it){
+          paVisitor(*it);
+          retVal++;
+        }
+        return retVal;
+      }
+
+      template<typename T>
+      const char *CTopicTrie<T>::getLevelEnd(const char *paLevelStart){
+        const char *levelEnd = strchr(paLevelStart, scmLevelSeparator);
+        return (0 != levelEnd) ? levelEnd : paLevelStart + strlen(paLevelStart);
+      }
+
+    }
+  }
+}
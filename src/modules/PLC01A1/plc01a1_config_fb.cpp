@@ -8,6 +8,7 @@
  *
  * Contributors:
  *   Jose Cabral - initial API and implementation and/or initial documentation
+ *   agent - bus statistics outputs
  *******************************************************************************/
 
 #include "plc01a1_config_fb.h"
@@ -29,20 +30,22 @@ const CStringDictionary::TStringId PLC01A1ConfigFB::scm_anDataInputTypeIds[] = {
   g_nStringIdWSTRING, g_nStringIdWSTRING, g_nStringIdWSTRING, g_nStringIdWSTRING, g_nStringIdWSTRING, g_nStringIdWSTRING, g_nStringIdWSTRING,
   g_nStringIdWSTRING, g_nStringIdWSTRING, g_nStringIdWSTRING, g_nStringIdWSTRING, g_nStringIdWSTRING, g_nStringIdWSTRING, g_nStringIdUINT };
 
-const CStringDictionary::TStringId PLC01A1ConfigFB::scm_anDataOutputNames[] = { g_nStringIdQO, g_nStringIdSTATUS };
+const CStringDictionary::TStringId PLC01A1ConfigFB::scm_anDataOutputNames[] = { g_nStringIdQO, g_nStringIdSTATUS, g_nStringIdCYCLES, g_nStringIdBUSTIME,
+  g_nStringIdMAXBUSTIME, g_nStringIdAVGBUSTIME, g_nStringIdPERIOD };
 
-const CStringDictionary::TStringId PLC01A1ConfigFB::scm_anDataOutputTypeIds[] = { g_nStringIdBOOL, g_nStringIdWSTRING };
+const CStringDictionary::TStringId PLC01A1ConfigFB::scm_anDataOutputTypeIds[] = { g_nStringIdBOOL, g_nStringIdWSTRING, g_nStringIdUDINT, g_nStringIdTIME,
+  g_nStringIdTIME, g_nStringIdTIME, g_nStringIdTIME };
 
-const TForteInt16 PLC01A1ConfigFB::scm_anEIWithIndexes[] = { 0 };
+const TForteInt16 PLC01A1ConfigFB::scm_anEIWithIndexes[] = { 0, -1 };
 const TDataIOID PLC01A1ConfigFB::scm_anEIWith[] = { 0, 17, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 255 };
-const CStringDictionary::TStringId PLC01A1ConfigFB::scm_anEventInputNames[] = { g_nStringIdINIT };
-const TDataIOID PLC01A1ConfigFB::scm_anEOWith[] = { 0, 1, 255, 0, 1, 255 };
-const TForteInt16 PLC01A1ConfigFB::scm_anEOWithIndexes[] = { 0, 3, -1 };
-const CStringDictionary::TStringId PLC01A1ConfigFB::scm_anEventOutputNames[] = { g_nStringIdINITO, g_nStringIdIND };
+const CStringDictionary::TStringId PLC01A1ConfigFB::scm_anEventInputNames[] = { g_nStringIdINIT, g_nStringIdREQ };
+const TDataIOID PLC01A1ConfigFB::scm_anEOWith[] = { 0, 1, 2, 3, 4, 5, 6, 255, 0, 1, 255, 2, 3, 4, 5, 6, 255 };
+const TForteInt16 PLC01A1ConfigFB::scm_anEOWithIndexes[] = { 0, 8, 11, -1 };
+const CStringDictionary::TStringId PLC01A1ConfigFB::scm_anEventOutputNames[] = { g_nStringIdINITO, g_nStringIdIND, g_nStringIdCNF };
 const SFBInterfaceSpec PLC01A1ConfigFB::scm_stFBInterfaceSpec = {
-  1,  scm_anEventInputNames,  scm_anEIWith,  scm_anEIWithIndexes,
-  2,  scm_anEventOutputNames,  scm_anEOWith, scm_anEOWithIndexes,  18,  scm_anDataInputNames, scm_anDataInputTypeIds,
-  2,  scm_anDataOutputNames, scm_anDataOutputTypeIds,
+  2,  scm_anEventInputNames,  scm_anEIWith,  scm_anEIWithIndexes,
+  3,  scm_anEventOutputNames,  scm_anEOWith, scm_anEOWithIndexes,  18,  scm_anDataInputNames, scm_anDataInputTypeIds,
+  7,  scm_anDataOutputNames, scm_anDataOutputTypeIds,
   0, 0
 };
 
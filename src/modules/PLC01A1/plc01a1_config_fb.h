@@ -8,6 +8,7 @@
  *
  * Contributors:
  *   Jose Cabral - initial API and implementation and/or initial documentation
+ *   agent - bus statistics outputs
  *******************************************************************************/
 
 #ifndef _PLC01A1_H_
@@ -17,6 +18,8 @@
 #include <forte_bool.h>
 #include <forte_uint.h>
 #include <forte_wstring.h>
+#include <forte_udint.h>
+#include <forte_time.h>
 #include <io/configFB/io_configFB_controller.h>
 
 class PLC01A1ConfigFB : public forte::core::io::IOConfigFBController {
@@ -107,20 +110,42 @@ private:
     return *static_cast<CIEC_WSTRING*>(getDO(1));
   };
 
+  CIEC_UDINT &CYCLES() {
+    return *static_cast<CIEC_UDINT*>(getDO(2));
+  };
+
+  CIEC_TIME &BUSTIME() {
+    return *static_cast<CIEC_TIME*>(getDO(3));
+  };
+
+  CIEC_TIME &MAXBUSTIME() {
+    return *static_cast<CIEC_TIME*>(getDO(4));
+  };
+
+  CIEC_TIME &AVGBUSTIME() {
+    return *static_cast<CIEC_TIME*>(getDO(5));
+  };
+
+  CIEC_TIME &PERIOD() {
+    return *static_cast<CIEC_TIME*>(getDO(6));
+  };
+
   static const TEventID scm_nEventINITID = 0;
+  static const TEventID scm_nEventREQID = 1;
   static const TForteInt16 scm_anEIWithIndexes[];
   static const TDataIOID scm_anEIWith[];
   static const CStringDictionary::TStringId scm_anEventInputNames[];
 
   static const TEventID scm_nEventINITOID = 0;
   static const TEventID scm_nEventINDID = 1;
+  static const TEventID scm_nEventCNFID = 2;
   static const TForteInt16 scm_anEOWithIndexes[];
   static const TDataIOID scm_anEOWith[];
   static const CStringDictionary::TStringId scm_anEventOutputNames[];
 
   static const SFBInterfaceSpec scm_stFBInterfaceSpec;
 
-   FORTE_FB_DATA_ARRAY(2, 18, 2, 0);
+   FORTE_FB_DATA_ARRAY(3, 18, 7, 0);
 
 virtual void setInitialValues();
 
@@ -8,9 +8,9 @@
  *
  * Contributors:
  *   Jose Cabral - initial API and implementation and/or initial documentation
+ *   agent - transfer the process image as register blocks
  *******************************************************************************/
 
-#include <io/mapper/io_handle_bit.h>
 #include "plc01a1_controller.h"
 #include <devlog.h>
 #include <sys/ioctl.h>
@@ -33,6 +33,8 @@ const char *const PLC01A1Controller::scmFailedToSetOutputBits = "Failed to set o
 const char *const PLC01A1Controller::scmFailedToSetInputSpeed = "Failed to set input speed";
 const char *const PLC01A1Controller::scmFailedToSetOutputSpeed = "Failed to set output speed";
 
+const char *const PLC01A1Controller::scmFailedToWriteOutputs = "Failed to write outputs";
+
 const uint32_t PLC01A1Controller::scmSPIMode = 0;
 
 const uint8_t PLC01A1Controller::scmSPIBits = 8;
@@ -42,9 +44,8 @@ const uint32_t PLC01A1Controller::scmSPIOutputMaxSpeed = 5000000; //5 MHz
 
 
 PLC01A1Controller::PLC01A1Controller(CDeviceExecution &paDeviceExecution) :
-    forte::core::io::IODevicePollController(paDeviceExecution, 25), mSPIInputFd(0), mSPIOutputFd(0) {
-  memset(mInputArrayOld, 0, scmInputArrayLenght);
-  memset(mInputArray, 0, scmInputArrayLenght);
+    forte::core::io::IODevicePollController(paDeviceExecution, 25), mSPIInputFd(0), mSPIOutputFd(0),
+    mImage(scmInputArrayLenght, scmOutputImageLength) {
   memset(mOutputArray, 0, scmOutputArrayLenght);
   memset(mInputTX, 0, scmOutputArrayLenght);
   memset(mOutputRX, 0, scmOutputArrayLenght);
@@ -53,19 +54,22 @@ PLC01A1Controller::PLC01A1Controller(CDeviceExecution &paDeviceExecution) :
   memset(&mOutputTR, 0, sizeof(struct spi_ioc_transfer));
 
   mInputTR.tx_buf = (unsigned long) mInputTX;
-  mInputTR.rx_buf = (unsigned long) mInputArray;
-  mInputTR.len = 2;
+  mInputTR.len = scmInputArrayLenght;
   mInputTR.speed_hz = scmSPIInputMaxSpeed;
   mInputTR.delay_usecs = 0;
   mInputTR.bits_per_word = scmSPIBits;
 
   mOutputTR.tx_buf = (unsigned long) mOutputArray;
   mOutputTR.rx_buf = (unsigned long) mOutputRX;
-  mOutputTR.len = 2;
+  mOutputTR.len = scmOutputArrayLenght;
   mOutputTR.speed_hz = scmSPIOutputMaxSpeed;
   mOutputTR.delay_usecs = 0;
   mOutputTR.bits_per_word = scmSPIBits;
 
+  // the board has one input and one output controller, the block addresses are not used
+  setProcessImage(&mImage);
+  addInputBlock(0, 0, scmInputArrayLenght);
+  addOutputBlock(0, 0, scmOutputImageLength);
 }
 
 void PLC01A1Controller::setConfig(struct forte::core::io::IODeviceController::Config *paConfig) {
@@ -118,6 +122,13 @@ const char* PLC01A1Controller::init() {
     return scmFailedToSetOutputSpeed;
   }
 
+  // outputs are only written after changes, so bring the board to the staged outputs, e.g., after a restart
+  TForteByte outputs[scmOutputImageLength];
+  mImage.copyOutputImage(outputs);
+  if(!writeBlock(0, outputs, scmOutputImageLength)) {
+    return scmFailedToWriteOutputs;
+  }
+
   DEVLOG_INFO("[PLC01A1Controller]: Initialization Correct!\n");
 
   return 0;
@@ -134,37 +145,33 @@ void PLC01A1Controller::deInit() {
   }
 }
 
-void PLC01A1Controller::poll() {
-
+bool PLC01A1Controller::readBlock(unsigned int, TForteByte *paData, unsigned int paSize) {
+  mInputTR.rx_buf = (unsigned long) paData;
+  mInputTR.len = paSize;
   int ret = ioctl(mSPIInputFd, SPI_IOC_MESSAGE(1), &mInputTR);
   if(ret < 1) {
-    DEVLOG_ERROR("[PLC01A1Controller]: Failed sending SPI message to input controller");
+    DEVLOG_ERROR("[PLC01A1Controller]: Failed sending SPI message to input controller\n");
+    return false;
   }
+  return true;
+}
 
-  // Check for updates and fire events
-  checkForInputChanges();
-
-  // Copy image to old image
-  memcpy(mInputArrayOld, mInputArray, scmInputArrayLenght);
-
+bool PLC01A1Controller::writeBlock(unsigned int, const TForteByte *paData, unsigned int) {
+  mOutputArray[0] = paData[0];
   output_parity_bits();
 
-  ret = ioctl(mSPIOutputFd, SPI_IOC_MESSAGE(1), &mOutputTR);
+  int ret = ioctl(mSPIOutputFd, SPI_IOC_MESSAGE(1), &mOutputTR);
   if(ret < 1) {
-    DEVLOG_ERROR("[PLC01A1Controller]: Failed sending SPI message to output controller");
+    DEVLOG_ERROR("[PLC01A1Controller]: Failed sending SPI message to output controller\n");
+    return false;
   }
-
-}
-
-bool PLC01A1Controller::isHandleValueEqual(forte::core::io::IOHandle *paHandle) {
-  return ((forte::core::io::IOHandleBit*) paHandle)->equal(mInputArrayOld);
+  return true;
 }
 
 forte::core::io::IOHandle* PLC01A1Controller::initHandle(forte::core::io::IODeviceController::HandleDescriptor *paHandleDescriptor) {
   HandleDescriptor desc = *static_cast<HandleDescriptor*>(paHandleDescriptor);
 
-  return new forte::core::io::IOHandleBit(this, desc.mDirection, desc.mOffset, desc.mPosition,
-    desc.mDirection == forte::core::io::IOMapper::In ? mInputArray : mOutputArray);
+  return createImageHandle(desc.mDirection, CIEC_ANY::e_BOOL, desc.mOffset, desc.mPosition);
 }
 
 void PLC01A1Controller::output_parity_bits() {
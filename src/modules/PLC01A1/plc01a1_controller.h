@@ -8,20 +8,27 @@
  *
  * Contributors:
  *   Jose Cabral - initial API and implementation and/or initial documentation
+ *   agent - transfer the process image as register blocks
  *******************************************************************************/
 
 #ifndef SRC_MODULES_FESTO_CECC_FESTO_CONTROLLER_H_
 #define SRC_MODULES_FESTO_CECC_FESTO_CONTROLLER_H_
 
 #include <io/device/io_controller_poll.h>
+#include <io/mapper/io_process_image.h>
 #include <linux/spi/spidev.h>
 
+/*! @brief Controller of the X-NUCLEO-PLC01A1 board
+ *
+ * The inputs and outputs are kept in a process image. Each poll cycle reads the input register block with one SPI
+ * message. The output register block is only written in cycles after outputs changed.
+ */
 class PLC01A1Controller : public forte::core::io::IODevicePollController {
   public:
     explicit PLC01A1Controller(CDeviceExecution &paDeviceExecution);
 
     struct Config : forte::core::io::IODeviceController::Config {
-        unsigned int mUpdateInterval; //!< Sets the frequency for the data update cycle. The default value is 25 Hz.
+        unsigned int mUpdateInterval; //!< Sets the time between two data update cycles in ms. The default value is 25 ms.
     };
 
     class HandleDescriptor : public forte::core::io::IODeviceController::HandleDescriptor {
@@ -37,15 +44,17 @@ class PLC01A1Controller : public forte::core::io::IODevicePollController {
 
     void setConfig(struct forte::core::io::IODeviceController::Config* paConfig);
 
-    virtual bool isHandleValueEqual(forte::core::io::IOHandle* paHandle);
-
     forte::core::io::IOHandle* initHandle(forte::core::io::IODeviceController::HandleDescriptor *paHandleDescriptor);
 
   protected:
     const char* init();
     void deInit();
 
-    void poll();
+    //! Reads the input block with one SPI message to the input controller
+    bool readBlock(unsigned int paAddress, TForteByte *paData, unsigned int paSize);
+
+    //! Writes the output block together with its parity bits with one SPI message to the output controller
+    bool writeBlock(unsigned int paAddress, const TForteByte *paData, unsigned int paSize);
 
   private:
 
@@ -74,11 +83,15 @@ class PLC01A1Controller : public forte::core::io::IODevicePollController {
     static const char *const scmFailedToSetInputSpeed;
     static const char *const scmFailedToSetOutputSpeed;
 
+    static const char *const scmFailedToWriteOutputs;
+
     static const size_t scmInputArrayLenght = 2;
     static const size_t scmOutputArrayLenght = 2;
+    //! only the first byte of the output message holds outputs, the second one their parity bits
+    static const size_t scmOutputImageLength = 1;
+
+    forte::core::io::IOProcessImage mImage;
 
-    uint8_t mInputArrayOld[scmInputArrayLenght];
-    uint8_t mInputArray[scmInputArrayLenght];
     uint8_t mOutputArray[scmOutputArrayLenght];
 
     uint8_t mInputTX[scmInputArrayLenght];
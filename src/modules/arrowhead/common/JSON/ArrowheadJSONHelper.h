@@ -8,6 +8,7 @@
  *
  * Contributors:
  *   Jose Cabral - initial implementation
+ *   agent - encode directly with the generic JSON encoder
  *******************************************************************************/
 
 #ifndef FORDIAC_RTE_MODULES_ARROWHEAD_COMMON_HTTP_ARROWHEADJSONHELPER_H_
@@ -16,6 +17,9 @@
 #include <forte_struct.h>
 #include <forte_string.h>
 #include <forte_array.h>
+#include <forte_wstring.h>
+#include <forte_date_and_time.h>
+#include <jsoncodec.h>
 #include "../forte_arrowheadservice.h"
 #include "../../orchestrator/forte_servicerequestform.h"
 #include <forte_arrowheadevent.h>
@@ -25,9 +29,13 @@
 
 class ArrowheadJSONHelper {
   public:
-    static void transformANYToJSON(const CIEC_ANY &paSource, CIEC_STRING &paResult);
-
-    static void transformJSONToStruct(char* paToChange);
+    /*! \brief Encodes the value as JSON in the form expected by the Arrowhead core systems
+     *
+     * The Arrowhead structs get their protocol specific layout (e.g., metadata key=value entries become objects and
+     * unused entries are left out), all other values are encoded with the generic JSON encoder.
+     * @return false if the value could not be encoded
+     */
+    static bool transformANYToJSON(const CIEC_ANY &paSource, CIEC_STRING &paResult);
 
   private:
     ArrowheadJSONHelper() {
@@ -35,35 +43,32 @@ class ArrowheadJSONHelper {
     virtual ~ArrowheadJSONHelper() {
     }
 
-    static void transformStructToJSON(const CIEC_STRUCT &paSource, CIEC_STRING &paResult);
-
-    static void transformArrayToJSON(const CIEC_ARRAY &paSource, CIEC_STRING &paResult);
-
-    static void transformSystemToJSON(CIEC_ArrowheadSystem& paSource, CIEC_STRING& paResult);
+    //! Size of the fixed arrays in the Arrowhead structs
+    static const size_t scmMaxNrOfEntries = 10;
 
-    static void transformServiceToJSON(CIEC_ArrowheadService &paSource, CIEC_STRING &paResult);
+    static bool encodeANY(const CIEC_ANY &paSource, forte::core::util::CJSONEncoder &paEncoder);
 
-    static void transformOrchServciceRequestFormToJSON(CIEC_ServiceRequestForm& paSource, CIEC_STRING& paResult);
+    static bool encodeMember(const char *paKey, const CIEC_ANY &paMember, forte::core::util::CJSONEncoder &paEncoder);
 
-    static void transformArrowheadEventToJSON(CIEC_ArrowheadEvent& paSource, CIEC_STRING& paResult);
+    static bool encodeStruct(const CIEC_STRUCT &paSource, forte::core::util::CJSONEncoder &paEncoder);
 
-    static void transformEventFilterToJSON(CIEC_EventFilter& paSource, CIEC_STRING& paResult);
+    static bool encodeArray(const CIEC_ARRAY &paSource, forte::core::util::CJSONEncoder &paEncoder);
 
-    static void transformPublishEventToJSON(CIEC_PublishEvent& paSource, CIEC_STRING& paResult);
+    static void encodeMetadata(const char *paKey, const CIEC_WSTRING *paMetadata, forte::core::util::CJSONEncoder &paEncoder);
 
-    static void transformServiceMetadata(char* paText);
+    static void encodeTimestamp(const char *paKey, const CIEC_DATE_AND_TIME &paTimestamp, forte::core::util::CJSONEncoder &paEncoder);
 
-    static void removeIds(char* paText);
+    static bool encodeSystem(const CIEC_ArrowheadSystem &paSource, forte::core::util::CJSONEncoder &paEncoder);
 
-    static void removeEndOfValidity(char *paText);
+    static bool encodeService(const CIEC_ArrowheadService &paSource, forte::core::util::CJSONEncoder &paEncoder);
 
-    static void changeKeys(char** paText);
+    static bool encodeServiceRequestForm(const CIEC_ServiceRequestForm &paSource, forte::core::util::CJSONEncoder &paEncoder);
 
-    static void changeKeysArray(char** paText);
+    static bool encodeArrowheadEvent(const CIEC_ArrowheadEvent &paSource, forte::core::util::CJSONEncoder &paEncoder);
 
-    static void transformNull(char *paText);
+    static bool encodeEventFilter(const CIEC_EventFilter &paSource, forte::core::util::CJSONEncoder &paEncoder);
 
-    static void changeToStruct(char* paText);
+    static bool encodePublishEvent(const CIEC_PublishEvent &paSource, forte::core::util::CJSONEncoder &paEncoder);
 };
 
 #endif /* FORDIAC_RTE_MODULES_ARROWHEAD_COMMON_HTTP_ARROWHEADJSONHELPER_H_ */
@@ -8,6 +8,7 @@
  *
  * Contributors:
  *   Jose Cabral - initial implementation
+ *   agent - decode directly with the generic JSON decoder
  *******************************************************************************/
 
 #include "GetArrayResponseFromJSON.h"
@@ -15,7 +16,8 @@
 #include "GetArrayResponseFromJSON_gen.cpp"
 #endif
 
-#include "ArrowheadJSONHelper.h"
+#include <jsoncodec.h>
+#include <string.h>
 
 DEFINE_FIRMWARE_FB(FORTE_GetArrayResponseFromJSON, g_nStringIdGetArrayResponseFromJSON)
 
@@ -43,38 +45,23 @@ const SFBInterfaceSpec FORTE_GetArrayResponseFromJSON::scm_stFBInterfaceSpec = {
 };
 
 
-bool FORTE_GetArrayResponseFromJSON::isResponseEmpty(char* paText) {
-  while(']' != *paText) {
-    if(' ' != *paText) {
-      return false;
-    }
-    paText++;
-  }
-  return true;
-}
-
 void FORTE_GetArrayResponseFromJSON::executeEvent(int paEIID) {
   if(scm_nEventREQID == paEIID && CIEC_ANY::e_ARRAY == output().getDataTypeID() && CIEC_ANY::e_STRUCT == output_Array()[0]->getDataTypeID()) {
     //clean the output first
     output_Array().setup(output_Array().size(), static_cast<CIEC_STRUCT*>(output_Array()[0])->getStructTypeNameID());
 
     DEVLOG_DEBUG("[Arrowhead GetArrayResponseFromJSON]: Response received: %s\n", response().getValue());
-    char* helper = strrchr(response().getValue(), ']');
-    if(0 != helper) {
-
-      *(helper + 1) = '\0';
-
-      helper = strchr(response().getValue(), '[');
-      if(0 != helper) {
-        if(!isResponseEmpty(helper + 1)) {
-          ArrowheadJSONHelper::transformJSONToStruct(helper);
-          output().fromString(helper);
-        } //if response is empty, don't do anything.
-      } else {
-        DEVLOG_ERROR("[Arrowhead GetArrayResponseFromJSON]: Invalid response, ] was found but not [: \n", response().getValue());
+    const char* startOfArray = strchr(response().getValue(), '[');
+    const char* endOfArray = strrchr(response().getValue(), ']');
+    if(0 != startOfArray && 0 != endOfArray && startOfArray < endOfArray) {
+      //members of the response not part of the struct (e.g., id) are skipped and metadata objects become key=value entries
+      forte::core::util::CJSONDecoder decoder;
+      int length = static_cast<int>(endOfArray - startOfArray) + 1;
+      if(length != decoder.decode(startOfArray, static_cast<size_t>(length), output())) {
+        DEVLOG_ERROR("[Arrowhead GetArrayResponseFromJSON]: Invalid response, the array couldn't be decoded: %s\n", response().getValue());
       }
     } else {
-      DEVLOG_ERROR("[Arrowhead GetArrayResponseFromJSON]: Invalid response, no ] was found: %s\n", response().getValue());
+      DEVLOG_ERROR("[Arrowhead GetArrayResponseFromJSON]: Invalid response, no array was found: %s\n", response().getValue());
     }
     sendOutputEvent(scm_nEventCNFID);
   }
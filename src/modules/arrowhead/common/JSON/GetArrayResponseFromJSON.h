@@ -53,8 +53,6 @@ private:
 
   void executeEvent(int pa_nEIID);
 
-  bool isResponseEmpty(char* paText);
-
 
 public:
   FUNCTION_BLOCK_CTOR(FORTE_GetArrayResponseFromJSON){
@@ -15,6 +15,14 @@
 #include <extevhandlerhelper.h>
 #include <criticalregion.h>
 #include <string>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+
+std::string CSysFsProcessInterface::smGPIOPath("/sys/class/gpio/");
+
 const char * const CSysFsProcessInterface::scmOK = "OK";
 const char * const CSysFsProcessInterface::scmPinInUse = "Pin already in use by other FB";
 const char * const CSysFsProcessInterface::scmNotInitialised = "FB not initialized";
@@ -24,7 +32,7 @@ const char * const CSysFsProcessInterface::scmCouldNotWrite = "Could not write";
 
 CSysFsProcessInterface::CSysFsProcessInterface(CResource *paSrcRes, const SFBInterfaceSpec *paInterfaceSpec,
     const CStringDictionary::TStringId paInstanceNameId, TForteByte *paFBConnData, TForteByte *paFBVarsData) :
-    CProcessInterfaceBase(paSrcRes, paInterfaceSpec, paInstanceNameId, paFBConnData, paFBVarsData) {
+    CProcessInterfaceBase(paSrcRes, paInterfaceSpec, paInstanceNameId, paFBConnData, paFBVarsData), mValueFD(-1), mEdgeTriggered(false) {
   mFile.rdbuf()->pubsetbuf(0, 0); //disable buffer to avoid latency
   STATUS() = scmNotInitialised;
 }
@@ -33,32 +41,48 @@ CSysFsProcessInterface::~CSysFsProcessInterface() {
   unexportIO(); //Will unexport everything, so next time FORTE starts it won't fail to initialize.
 }
 
+void CSysFsProcessInterface::setGPIOPath(const char *paPath) {
+  smGPIOPath = paPath;
+}
+
+std::string CSysFsProcessInterface::getGPIOFileName(const char *paFile) {
+  return smGPIOPath + "gpio" + std::string(PARAMS().getValue()) + "/" + paFile;
+}
+
 bool CSysFsProcessInterface::setDirection(bool paIsInput) {
-  bool retVal = false;
-  std::string fileName = "/sys/class/gpio/gpio" + std::string(PARAMS().getValue()) + "/direction";
+  //errors are reported by initialise as the file may not be accessible yet
   std::ofstream mDirectionFile;
-  mDirectionFile.open(fileName.c_str());
+  mDirectionFile.open(getGPIOFileName("direction").c_str());
   if(mDirectionFile.is_open()) {
     if(paIsInput) {
       mDirectionFile << "in";
     } else {
       mDirectionFile << "out";
     }
-    if(!mDirectionFile.fail()){
-      retVal = true;
-    } else{
-      DEVLOG_ERROR("[CSysFsProcessInterface::setDirection] Error writing to file %s.\n", fileName.c_str());
-    }
-  } else {
-    DEVLOG_ERROR("[CSysFsProcessInterface::setDirection] Opening file %s failed.\n", fileName.c_str());
+    mDirectionFile.flush();
+    return !mDirectionFile.fail();
   }
+  return false;
+}
 
-  return retVal;
+bool CSysFsProcessInterface::setEdge() {
+  std::string fileName = getGPIOFileName("edge");
+  std::ofstream edgeFile;
+  edgeFile.open(fileName.c_str());
+  if(edgeFile.is_open()) {
+    edgeFile << "both";
+    edgeFile.flush();
+    if(!edgeFile.fail()) {
+      return true;
+    }
+  }
+  DEVLOG_WARNING("[CSysFsProcessInterface::setEdge] Pin %s does not support interrupts, it will be polled.\n", PARAMS().getValue());
+  return false;
 }
 
 bool CSysFsProcessInterface::exportGPIO() {
   bool retVal = false;
-  std::string fileName = "/sys/class/gpio/export";
+  std::string fileName = smGPIOPath + "export";
   std::ofstream mExportFile;
   mExportFile.open(fileName.c_str());
   if(mExportFile.is_open()) {
@@ -78,51 +102,64 @@ bool CSysFsProcessInterface::exportGPIO() {
 }
 
 bool CSysFsProcessInterface::valueGPIO(bool paIsInput) {
-  bool retVal = false;
-  std::string fileName = "/sys/class/gpio/gpio" + std::string(PARAMS().getValue()) + "/value";
+  std::string fileName = getGPIOFileName("value");
   if(paIsInput) {
-    mFile.open(fileName.c_str(), std::fstream::in);
-  } else {
-    mFile.open(fileName.c_str(), std::fstream::out);
-  }
-
-  if(mFile.is_open()){
-    retVal = true;
-  }else{
-    DEVLOG_ERROR("[CSysFsProcessInterface::valueGPIO] Opening file %s failed.\n", fileName.c_str());
+    mValueFD = open(fileName.c_str(), O_RDONLY);
+    return (-1 != mValueFD);
   }
-  return retVal;
+  mFile.open(fileName.c_str(), std::fstream::out);
+  return mFile.is_open();
 }
 
 bool CSysFsProcessInterface::initialise(bool paIsInput) {
-  bool retVal = false;
-  if(CSysFsProcessInterface::exportGPIO()) {
-    CThread::sleepThread(250);
-    if(CSysFsProcessInterface::setDirection(paIsInput)) {
-      CThread::sleepThread(250);
-      if(CSysFsProcessInterface::valueGPIO(paIsInput)) {
-        if(paIsInput) {
-          getExtEvHandler<CSysFsProcessInterface::CIOHandler>(*this).registerIXFB(this);
-          if(!getExtEvHandler<CSysFsProcessInterface::CIOHandler>(*this).isAlive()) {
-            getExtEvHandler<CSysFsProcessInterface::CIOHandler>(*this).start();
-          }
-        }
-        DEVLOG_DEBUG("[CSysFsProcessInterface::initialise] Pin with PARAM() %s was properly initialized.\n", PARAMS().getValue());
-        STATUS() = scmOK;
-        retVal = true;
-      }
+  if(!CSysFsProcessInterface::exportGPIO()) {
+    return false;
+  }
+
+  // instead of waiting a fixed time for udev to set up the pin we retry until the files are accessible
+  unsigned int waited = 0;
+  while(!CSysFsProcessInterface::setDirection(paIsInput)) {
+    if(waited >= scmMaxSetupTime) {
+      DEVLOG_ERROR("[CSysFsProcessInterface::initialise] Setting the direction of pin %s failed.\n", PARAMS().getValue());
+      return false;
     }
+    CThread::sleepThread(scmSetupRetryInterval);
+    waited += scmSetupRetryInterval;
   }
 
-  return retVal;
+  mEdgeTriggered = paIsInput && setEdge();
+
+  while(!CSysFsProcessInterface::valueGPIO(paIsInput)) {
+    if(waited >= scmMaxSetupTime) {
+      DEVLOG_ERROR("[CSysFsProcessInterface::initialise] Opening the value file of pin %s failed.\n", PARAMS().getValue());
+      return false;
+    }
+    CThread::sleepThread(scmSetupRetryInterval);
+    waited += scmSetupRetryInterval;
+  }
+
+  if(paIsInput) {
+    checkInputData(); //the initial value, also acknowledges a pending edge
+    getExtEvHandler<CSysFsProcessInterface::CIOHandler>(*this).registerIXFB(this);
+    if(!getExtEvHandler<CSysFsProcessInterface::CIOHandler>(*this).isAlive()) {
+      getExtEvHandler<CSysFsProcessInterface::CIOHandler>(*this).start();
+    }
+  }
+  DEVLOG_DEBUG("[CSysFsProcessInterface::initialise] Pin with PARAM() %s was properly initialized.\n", PARAMS().getValue());
+  STATUS() = scmOK;
+  return true;
 }
 
 bool CSysFsProcessInterface::unexportIO() {
   bool retVal = false;
-  std::string fileName = "/sys/class/gpio/unexport";
+  std::string fileName = smGPIOPath + "unexport";
   std::ofstream mUnExport;
 
   mFile.close();
+  if(-1 != mValueFD) {
+    close(mValueFD);
+    mValueFD = -1;
+  }
   mUnExport.open(fileName.c_str(), std::fstream::out);
   if(mUnExport.is_open()) {
     mUnExport << PARAMS().getValue();
@@ -151,12 +188,10 @@ bool CSysFsProcessInterface::readPin() {
 
 bool CSysFsProcessInterface::checkInputData() {
   bool retVal = false;
-  if(mFile.is_open()) {
+  if(-1 != mValueFD) {
     char binData = 0;
-    mFile.clear();
-    mFile.seekg(0, std::ios::beg);
-    mFile.read(&binData, 1);
-    if(mFile.fail()) {
+    //reading the value file from its start acknowledges the edge reported by poll
+    if((-1 == lseek(mValueFD, 0, SEEK_SET)) || (1 != read(mValueFD, &binData, 1))) {
       STATUS() = scmCouldNotRead;
     } else {
       bool newData = ('0' != binData) ? true : false;
@@ -197,61 +232,143 @@ bool CSysFsProcessInterface::writePin() {
 DEFINE_HANDLER(CSysFsProcessInterface::CIOHandler);
 
 CSysFsProcessInterface::CIOHandler::CIOHandler(CDeviceExecution& pa_poDeviceExecution) :
-    CExternalEventHandler(pa_poDeviceExecution) {
+    CExternalEventHandler(pa_poDeviceExecution), mPollFDs(0), mPollFDsSize(0), mListChanged(true), mHasPolledPins(false) {
+  if(0 == pipe(mWakeUpPipe)) {
+    fcntl(mWakeUpPipe[0], F_SETFL, O_NONBLOCK);
+    fcntl(mWakeUpPipe[1], F_SETFL, O_NONBLOCK);
+  } else {
+    DEVLOG_ERROR("[CSysFsProcessInterface::CIOHandler] Could not create the wake up pipe: %s\n", strerror(errno));
+    mWakeUpPipe[0] = mWakeUpPipe[1] = -1;
+  }
 }
 
 CSysFsProcessInterface::CIOHandler::~CIOHandler() {
-  CCriticalRegion readList(mReadFBListSync);
-  mReadFBList.clearAll();
-  end();
+  disableHandler();
+  {
+    CCriticalRegion readList(mReadFBListSync);
+    mReadFBList.clearAll();
+  }
+  delete[] mPollFDs;
+  if(-1 != mWakeUpPipe[0]) {
+    close(mWakeUpPipe[0]);
+    close(mWakeUpPipe[1]);
+  }
 }
 
 void CSysFsProcessInterface::CIOHandler::registerIXFB(CSysFsProcessInterface *pa_poFB) {
-  CCriticalRegion readList(mReadFBListSync);
-  mReadFBList.pushBack(pa_poFB);
+  {
+    CCriticalRegion readList(mReadFBListSync);
+    mReadFBList.pushBack(pa_poFB);
+    mListChanged = true;
+  }
+  wakeUp();
 }
 
 void CSysFsProcessInterface::CIOHandler::unregisterIXFB(CSysFsProcessInterface *pa_poFB) {
-  CCriticalRegion readList(mReadFBListSync);
-  TReadFBContainer::Iterator itRunner(mReadFBList.begin());
-  TReadFBContainer::Iterator itRefNode(mReadFBList.end());
-  TReadFBContainer::Iterator itEnd(mReadFBList.end());
-  while(itRunner != itEnd) {
-    if(*itRunner == pa_poFB) {
-      if(itRefNode == itEnd) {
-        mReadFBList.popFront();
-      } else {
-        mReadFBList.eraseAfter(itRefNode);
+  {
+    CCriticalRegion readList(mReadFBListSync);
+    TReadFBContainer::Iterator itRunner(mReadFBList.begin());
+    TReadFBContainer::Iterator itRefNode(mReadFBList.end());
+    TReadFBContainer::Iterator itEnd(mReadFBList.end());
+    while(itRunner != itEnd) {
+      if(*itRunner == pa_poFB) {
+        if(itRefNode == itEnd) {
+          mReadFBList.popFront();
+        } else {
+          mReadFBList.eraseAfter(itRefNode);
+        }
+        break;
       }
-      break;
+      itRefNode = itRunner;
+      ++itRunner;
     }
-    itRefNode = itRunner;
-    ++itRunner;
+    mListChanged = true;
   }
+  wakeUp();
 }
 
 void CSysFsProcessInterface::CIOHandler::run() {
   while(isAlive()) {
-    CThread::sleepThread(10);
+    unsigned int nrOfFDs = preparePollFDs();
+    int result = poll(mPollFDs, nrOfFDs, mHasPolledPins ? scmPollInterval : -1);
+    if(!isAlive()) {
+      break;
+    }
+    if(0 > result) {
+      if(EINTR != errno) {
+        DEVLOG_ERROR("[CSysFsProcessInterface::CIOHandler] Waiting for input changes failed: %s\n", strerror(errno));
+        CThread::sleepThread(scmPollInterval);
+      }
+      continue;
+    }
+    if(0 != (mPollFDs[0].revents & POLLIN)) {
+      char buffer[16];
+      while(0 < read(mWakeUpPipe[0], buffer, sizeof(buffer))) {
+        //drain the wake up requests
+      }
+    }
     updateReadData();
   }
 }
 
+unsigned int CSysFsProcessInterface::CIOHandler::preparePollFDs() {
+  CCriticalRegion readList(mReadFBListSync);
+  if(mListChanged) {
+    unsigned int nrOfFDs = 1;
+    TReadFBContainer::Iterator itEnd(mReadFBList.end());
+    for(TReadFBContainer::Iterator itRunner = mReadFBList.begin(); itRunner != itEnd; ++itRunner) {
+      ++nrOfFDs;
+    }
+    if(nrOfFDs != mPollFDsSize) {
+      delete[] mPollFDs;
+      mPollFDs = new struct pollfd[nrOfFDs];
+      mPollFDsSize = nrOfFDs;
+    }
+
+    mPollFDs[0].fd = mWakeUpPipe[0];
+    mPollFDs[0].events = POLLIN;
+    mHasPolledPins = false;
+    unsigned int i = 1;
+    for(TReadFBContainer::Iterator itRunner = mReadFBList.begin(); itRunner != itEnd; ++itRunner, ++i) {
+      //negative descriptors are ignored by poll, these pins are checked on each timeout
+      mPollFDs[i].fd = (*itRunner)->mEdgeTriggered ? (*itRunner)->mValueFD : -1;
+      mPollFDs[i].events = POLLPRI | POLLERR;
+      mHasPolledPins = mHasPolledPins || !(*itRunner)->mEdgeTriggered;
+    }
+    mListChanged = false;
+  }
+  return mPollFDsSize;
+}
+
 void CSysFsProcessInterface::CIOHandler::updateReadData() {
   CCriticalRegion readList(mReadFBListSync);
+  //if pins have been added or removed in the meantime the descriptors do not match anymore, all pins are checked then
+  bool checkAll = mListChanged;
+  unsigned int i = 1;
   TReadFBContainer::Iterator itEnd(mReadFBList.end());
-  for(TReadFBContainer::Iterator itRunner = mReadFBList.begin(); itRunner != itEnd; ++itRunner) {
-    if((*itRunner)->checkInputData()) {
+  for(TReadFBContainer::Iterator itRunner = mReadFBList.begin(); itRunner != itEnd; ++itRunner, ++i) {
+    if((checkAll || !(*itRunner)->mEdgeTriggered || 0 != mPollFDs[i].revents) && (*itRunner)->checkInputData()) {
       startNewEventChain(*itRunner);
     }
   }
 }
 
+void CSysFsProcessInterface::CIOHandler::wakeUp() {
+  if(-1 != mWakeUpPipe[1]) {
+    char wakeUp = 0;
+    if(1 != write(mWakeUpPipe[1], &wakeUp, 1) && EAGAIN != errno) {
+      DEVLOG_ERROR("[CSysFsProcessInterface::CIOHandler] Could not wake up the handler: %s\n", strerror(errno));
+    }
+  }
+}
+
 void CSysFsProcessInterface::CIOHandler::enableHandler(void) {
   //do nothing
 }
 
 void CSysFsProcessInterface::CIOHandler::disableHandler(void) {
+  setAlive(false);
+  wakeUp();
   end();
 }
 
@@ -17,6 +17,9 @@
 #include <forte_thread.h>
 #include <extevhan.h>
 #include <fstream>
+#include <string>
+
+struct pollfd;
 
 class CSysFsProcessInterface : public CProcessInterfaceBase {
 
@@ -25,6 +28,18 @@ class CSysFsProcessInterface : public CProcessInterfaceBase {
         TForteByte *paFBConnData, TForteByte *paFBVarsData);
     virtual ~CSysFsProcessInterface();
 
+    /*! \brief Sets the directory of the sysfs gpio interface, default is /sys/class/gpio/
+     *
+     * Allows to use a different mount point or a fake sysfs tree for testing.
+     */
+    static void setGPIOPath(const char *paPath);
+
+    /*! \brief Handler reporting the changes of all input pins
+     *
+     * Pins supporting interrupts get their edge attribute set to both. The handler waits for their edges with
+     * poll(POLLPRI) on the value files, so it does not use any processing time while the inputs are stable. Pins
+     * without an edge attribute are polled every scmPollInterval ms.
+     */
     class CIOHandler : public CExternalEventHandler, public CThread {
       DECLARE_HANDLER(CIOHandler)
         ;
@@ -39,10 +54,24 @@ class CSysFsProcessInterface : public CProcessInterfaceBase {
         void setPriority(int paPriority);
         int getPriority(void) const;
 
+        //! Interval in ms for polling the pins without interrupt support
+        static const int scmPollInterval = 10;
+
       private:
+        //! Updates the poll descriptors if pins have been added or removed, returns their number
+        unsigned int preparePollFDs();
+        void wakeUp();
+
         typedef CSinglyLinkedList<CSysFsProcessInterface *> TReadFBContainer;
         TReadFBContainer mReadFBList;
         CSyncObject mReadFBListSync;
+
+        //! the first entry is the read end of the wake up pipe, the others are the value files in the order of mReadFBList
+        struct pollfd *mPollFDs;
+        unsigned int mPollFDsSize;
+        bool mListChanged;
+        bool mHasPolledPins;
+        int mWakeUpPipe[2];
     };
 
   protected:
@@ -53,14 +82,27 @@ class CSysFsProcessInterface : public CProcessInterfaceBase {
     bool checkInputData();
 
   private:
+    //! value file of an output
     std::fstream mFile;
+    //! value file of an input, read directly as the handler waits for its edges
+    int mValueFD;
+    bool mEdgeTriggered;
 
     bool exportGPIO();
     bool setDirection(bool paIsInput);
+    bool setEdge();
     bool valueGPIO(bool paIsInput);
 
     bool unexportIO();
 
+    std::string getGPIOFileName(const char *paFile);
+
+    static std::string smGPIOPath;
+
+    //! the gpio files are accessible as soon as udev applied the permissions, it is retried in these steps (ms)
+    static const unsigned int scmSetupRetryInterval = 10;
+    static const unsigned int scmMaxSetupTime = 1000;
+
     static const char * const scmOK;
     static const char * const scmPinInUse;
     static const char * const scmNotInitialised;
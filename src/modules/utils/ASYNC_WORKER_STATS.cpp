@@ -0,0 +1,56 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include "ASYNC_WORKER_STATS.h"
+#ifdef FORTE_ENABLE_GENERATED_SOURCE_CPP
+#include "ASYNC_WORKER_STATS_gen.cpp"
+#endif
+#include <asyncworker.h>
+#include <extevhandlerhelper.h>
+
+DEFINE_FIRMWARE_FB(FORTE_ASYNC_WORKER_STATS, g_nStringIdASYNC_WORKER_STATS)
+
+const CStringDictionary::TStringId FORTE_ASYNC_WORKER_STATS::scm_anDataOutputNames[] = {g_nStringIdSUBMITTED, g_nStringIdREJECTED,
+  g_nStringIdCOMPLETED, g_nStringIdAVG_QUEUE_TIME, g_nStringIdMAX_QUEUE_TIME, g_nStringIdAVG_RUN_TIME, g_nStringIdMAX_RUN_TIME};
+
+const CStringDictionary::TStringId FORTE_ASYNC_WORKER_STATS::scm_anDataOutputTypeIds[] = {g_nStringIdUDINT, g_nStringIdUDINT,
+  g_nStringIdUDINT, g_nStringIdTIME, g_nStringIdTIME, g_nStringIdTIME, g_nStringIdTIME};
+
+const TForteInt16 FORTE_ASYNC_WORKER_STATS::scm_anEIWithIndexes[] = {-1};
+const CStringDictionary::TStringId FORTE_ASYNC_WORKER_STATS::scm_anEventInputNames[] = {g_nStringIdREQ};
+
+const TDataIOID FORTE_ASYNC_WORKER_STATS::scm_anEOWith[] = {0, 1, 2, 3, 4, 5, 6, 255};
+const TForteInt16 FORTE_ASYNC_WORKER_STATS::scm_anEOWithIndexes[] = {0, -1};
+const CStringDictionary::TStringId FORTE_ASYNC_WORKER_STATS::scm_anEventOutputNames[] = {g_nStringIdCNF};
+
+const SFBInterfaceSpec FORTE_ASYNC_WORKER_STATS::scm_stFBInterfaceSpec = {
+  1,  scm_anEventInputNames,  0,  scm_anEIWithIndexes,
+  1,  scm_anEventOutputNames,  scm_anEOWith, scm_anEOWithIndexes,  0,  0, 0,
+  7,  scm_anDataOutputNames, scm_anDataOutputTypeIds,
+  0, 0
+};
+
+void FORTE_ASYNC_WORKER_STATS::executeEvent(int pa_nEIID){
+  if(scm_nEventREQID == pa_nEIID){
+    CAsyncWorkerHandler::SStatistics statistics;
+    getExtEvHandler<CAsyncWorkerHandler>(*this).getStatistics(statistics);
+    SUBMITTED() = statistics.mSubmitted;
+    REJECTED() = statistics.mRejected;
+    COMPLETED() = statistics.mCompleted;
+    //the times are summed up when a job completes
+    const TForteUInt32 completed = (0 != statistics.mCompleted) ? statistics.mCompleted : 1;
+    AVG_QUEUE_TIME().setFromNanoSeconds(static_cast<CIEC_TIME::TValueType>(statistics.mTotalQueueTime / completed));
+    MAX_QUEUE_TIME().setFromNanoSeconds(static_cast<CIEC_TIME::TValueType>(statistics.mMaxQueueTime));
+    AVG_RUN_TIME().setFromNanoSeconds(static_cast<CIEC_TIME::TValueType>(statistics.mTotalRunTime / completed));
+    MAX_RUN_TIME().setFromNanoSeconds(static_cast<CIEC_TIME::TValueType>(statistics.mMaxRunTime));
+    sendOutputEvent(scm_nEventCNFID);
+  }
+}
@@ -0,0 +1,81 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#ifndef _ASYNC_WORKER_STATS_H_
+#define _ASYNC_WORKER_STATS_H_
+
+#include <funcbloc.h>
+#include <forte_udint.h>
+#include <forte_time.h>
+
+/*!\brief Provides the statistics of the asynchronous workers of the device
+ *
+ * On REQ the counters of all jobs submitted so far and the average and maximum times the jobs waited in the queue and
+ * ran in a worker are read from the CAsyncWorkerHandler and sent with CNF.
+ */
+class FORTE_ASYNC_WORKER_STATS: public CFunctionBlock{
+  DECLARE_FIRMWARE_FB(FORTE_ASYNC_WORKER_STATS)
+
+private:
+  static const CStringDictionary::TStringId scm_anDataOutputNames[];
+  static const CStringDictionary::TStringId scm_anDataOutputTypeIds[];
+  CIEC_UDINT &SUBMITTED() {
+    return *static_cast<CIEC_UDINT*>(getDO(0));
+  };
+
+  CIEC_UDINT &REJECTED() {
+    return *static_cast<CIEC_UDINT*>(getDO(1));
+  };
+
+  CIEC_UDINT &COMPLETED() {
+    return *static_cast<CIEC_UDINT*>(getDO(2));
+  };
+
+  CIEC_TIME &AVG_QUEUE_TIME() {
+    return *static_cast<CIEC_TIME*>(getDO(3));
+  };
+
+  CIEC_TIME &MAX_QUEUE_TIME() {
+    return *static_cast<CIEC_TIME*>(getDO(4));
+  };
+
+  CIEC_TIME &AVG_RUN_TIME() {
+    return *static_cast<CIEC_TIME*>(getDO(5));
+  };
+
+  CIEC_TIME &MAX_RUN_TIME() {
+    return *static_cast<CIEC_TIME*>(getDO(6));
+  };
+
+  static const TEventID scm_nEventREQID = 0;
+  static const TForteInt16 scm_anEIWithIndexes[];
+  static const CStringDictionary::TStringId scm_anEventInputNames[];
+
+  static const TEventID scm_nEventCNFID = 0;
+  static const TForteInt16 scm_anEOWithIndexes[];
+  static const TDataIOID scm_anEOWith[];
+  static const CStringDictionary::TStringId scm_anEventOutputNames[];
+
+  static const SFBInterfaceSpec scm_stFBInterfaceSpec;
+
+  FORTE_FB_DATA_ARRAY(1, 0, 7, 0);
+
+  void executeEvent(int pa_nEIID);
+
+public:
+  FUNCTION_BLOCK_CTOR(FORTE_ASYNC_WORKER_STATS){
+  };
+
+  virtual ~FORTE_ASYNC_WORKER_STATS(){};
+
+};
+
+#endif //_ASYNC_WORKER_STATS_H_
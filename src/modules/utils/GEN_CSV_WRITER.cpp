@@ -11,6 +11,8 @@
  *   Alois Zoitl
  *   - initial API and implementation and/or initial documentation
  *    Alois Zoitl - introduced new CGenFB class for better handling generic FBs
+ *    agent - moved the file operations to the asynchronous workers
+ *    agent - pending lines for requests received while a file operation runs
  *******************************************************************************/
 #include "GEN_CSV_WRITER.h"
 #ifdef FORTE_ENABLE_GENERATED_SOURCE_CPP
@@ -19,6 +21,7 @@
 #include <string.h>
 #include <errno.h>
 #include <devlog.h>
+#include <extevhandlerhelper.h>
 
 DEFINE_GENERIC_FIRMWARE_FB(GEN_CSV_WRITER, g_nStringIdGEN_CSV_WRITER);
 
@@ -37,33 +40,69 @@ const CStringDictionary::TStringId GEN_CSV_WRITER::scm_anEventOutputNames[] = {
 const char * const GEN_CSV_WRITER::scmOK = "OK";
 const char * const GEN_CSV_WRITER::scmFileAlreadyOpened = "File already opened";
 const char * const GEN_CSV_WRITER::scmFileNotOpened = "File not opened";
+const char * const GEN_CSV_WRITER::scmBusy = "Previous file operation still running";
+const char * const GEN_CSV_WRITER::scmQueueFull = "Too many pending file operations";
+const char * const GEN_CSV_WRITER::scmPendingLinesFull = "Too many pending lines";
 
 void GEN_CSV_WRITER::executeEvent(int paEIID) {
-  if(scm_nEventINITID == paEIID) {
+  if(cg_nExternalEventID == paEIID) {
+    if(CAsyncJob::eDone == mFileJob.getState()) {
+      finishFileJob();
+    }
+  } else if(scm_nEventINITID == paEIID) {
     if(QI()) {
       openCSVFile();
     } else {
       closeCSVFile();
     }
-    sendOutputEvent(scm_nEventINITOID);
   } else if(scm_nEventREQID == paEIID) {
     QO() = QI();
     if(QI()) {
       writeCSVFileLine();
+    } else {
+      sendOutputEvent(scm_nEventCNFID);
     }
-    sendOutputEvent(scm_nEventCNFID);
   }
 }
 
+EMGMResponse GEN_CSV_WRITER::changeFBExecutionState(EMGMCommandType paCommand){
+  EMGMResponse retVal = CGenFunctionBlock<CEventSourceFB>::changeFBExecutionState(paCommand);
+  if((e_RDY == retVal) && ((cg_nMGM_CMD_Stop == paCommand) || (cg_nMGM_CMD_Kill == paCommand))) {
+    //a stopped FB does not get the completion event anymore
+    retractFileJob();
+  }
+  return retVal;
+}
+
 GEN_CSV_WRITER::GEN_CSV_WRITER(const CStringDictionary::TStringId paInstanceNameId, CResource *paSrcRes) :
-    CGenFunctionBlock<CFunctionBlock>(paSrcRes, paInstanceNameId), mCSVFile(0), m_anDataInputNames(0), m_anDataInputTypeIds(0), m_anEIWith(0){
+    CGenFunctionBlock<CEventSourceFB>(paSrcRes, paInstanceNameId), mFileJob(*this), mPendingLines(0), mPendingSize(0), mPendingError(0){
 }
 
 GEN_CSV_WRITER::~GEN_CSV_WRITER(){
-  delete[] m_anDataInputNames;
-  delete[] m_anDataInputTypeIds;
-  delete[] m_anEIWith;
-  closeCSVFile();
+  retractFileJob();
+  if(0 != mFileJob.mFile) {
+    if(0 != mPendingSize) {
+      fwrite(mPendingLines, 1, mPendingSize, mFileJob.mFile);
+    }
+    fclose(mFileJob.mFile);
+  }
+  delete[] mPendingLines;
+}
+
+void GEN_CSV_WRITER::retractFileJob(){
+  //FBs are stopped and deleted by the management, so the lines of a job which did not run can be written here
+  if(!getExtEvHandler<CAsyncWorkerHandler>(*this).retract(mFileJob) && (0 != mFileJob.mFile) && (0 != mFileJob.mLineSize)) {
+    if(mFileJob.mLineSize != fwrite(mFileJob.mLine, 1, mFileJob.mLineSize, mFileJob.mFile)) {
+      DEVLOG_ERROR("[GEN_CSV_WRITER]: Couldn't write to file %s. Error: %s\n", FILE_NAME().getValue(), strerror(errno));
+    }
+  }
+  mFileJob.mLineSize = 0;
+}
+
+void GEN_CSV_WRITER::releaseInterfaceSpec(SFBInterfaceSpec &paInterfaceSpec){
+  delete[] paInterfaceSpec.m_aunDINames;
+  delete[] paInterfaceSpec.m_aunDIDataTypeNames;
+  delete[] paInterfaceSpec.m_anEIWith;
 }
 
 bool GEN_CSV_WRITER::createInterfaceSpec(const char *paConfigString, SFBInterfaceSpec &paInterfaceSpec) {
@@ -72,40 +111,40 @@ bool GEN_CSV_WRITER::createInterfaceSpec(const char *paConfigString, SFBInterfac
     acPos++;
     paInterfaceSpec.m_nNumDIs = static_cast<TForteUInt8>(forte::core::util::strtoul(acPos, 0, 10) + 2); // we have in addition to the SDs a QI and FILE_NAME data inputs
 
-    m_anDataInputNames = new CStringDictionary::TStringId[paInterfaceSpec.m_nNumDIs];
-    m_anDataInputTypeIds = new CStringDictionary::TStringId[paInterfaceSpec.m_nNumDIs];
+    CStringDictionary::TStringId *dataInputNames = new CStringDictionary::TStringId[paInterfaceSpec.m_nNumDIs];
+    CStringDictionary::TStringId *dataInputTypeIds = new CStringDictionary::TStringId[paInterfaceSpec.m_nNumDIs];
 
-    m_anDataInputNames[0] = g_nStringIdQI;
-    m_anDataInputTypeIds[0] = g_nStringIdBOOL;
-    m_anDataInputNames[1] = g_nStringIdFILE_NAME;
-    m_anDataInputTypeIds[1] = g_nStringIdSTRING;
+    dataInputNames[0] = g_nStringIdQI;
+    dataInputTypeIds[0] = g_nStringIdBOOL;
+    dataInputNames[1] = g_nStringIdFILE_NAME;
+    dataInputTypeIds[1] = g_nStringIdSTRING;
 
-    generateGenericDataPointArrays("SD_", &(m_anDataInputTypeIds[2]), &(m_anDataInputNames[2]), paInterfaceSpec.m_nNumDIs - 2);
+    generateGenericDataPointArrays("SD_", &(dataInputTypeIds[2]), &(dataInputNames[2]), paInterfaceSpec.m_nNumDIs - 2);
 
-    m_anEIWith = new TDataIOID[3 + paInterfaceSpec.m_nNumDIs];
+    TDataIOID *eiWith = new TDataIOID[3 + paInterfaceSpec.m_nNumDIs];
 
-    m_anEIWith[0] = 0;
-    m_anEIWith[1] = 1;
-    m_anEIWith[2] = scmWithListDelimiter;
-    m_anEIWith[3] = 0;
+    eiWith[0] = 0;
+    eiWith[1] = 1;
+    eiWith[2] = scmWithListDelimiter;
+    eiWith[3] = 0;
 
     for(TDataIOID i = 2; i < paInterfaceSpec.m_nNumDIs; i++){
-      m_anEIWith[i + 2] = i;
+      eiWith[i + 2] = i;
     }
 
-    m_anEIWith[2 + paInterfaceSpec.m_nNumDIs] = scmWithListDelimiter;
+    eiWith[2 + paInterfaceSpec.m_nNumDIs] = scmWithListDelimiter;
 
     //create the interface Specification
     paInterfaceSpec.m_nNumEIs = 2;
     paInterfaceSpec.m_aunEINames = scm_anEventInputNames;
-    paInterfaceSpec.m_anEIWith = m_anEIWith;
+    paInterfaceSpec.m_anEIWith = eiWith;
     paInterfaceSpec.m_anEIWithIndexes = scm_anEIWithIndexes;
     paInterfaceSpec.m_nNumEOs = 2;
     paInterfaceSpec.m_aunEONames = scm_anEventOutputNames;
     paInterfaceSpec.m_anEOWith = scm_anEOWith;
     paInterfaceSpec.m_anEOWithIndexes = scm_anEOWithIndexes;
-    paInterfaceSpec.m_aunDINames = m_anDataInputNames;
-    paInterfaceSpec.m_aunDIDataTypeNames = m_anDataInputTypeIds;
+    paInterfaceSpec.m_aunDINames = dataInputNames;
+    paInterfaceSpec.m_aunDIDataTypeNames = dataInputTypeIds;
     paInterfaceSpec.m_nNumDOs = 2;
     paInterfaceSpec.m_aunDONames = scm_anDataOutputNames;
     paInterfaceSpec.m_aunDODataTypeNames = scm_anDataOutputTypeIds;
@@ -116,48 +155,230 @@ bool GEN_CSV_WRITER::createInterfaceSpec(const char *paConfigString, SFBInterfac
 
 void GEN_CSV_WRITER::openCSVFile() {
   QO() = false;
-  if(0 == mCSVFile) {
-    mCSVFile = fopen(FILE_NAME().getValue(), "w+");
-    if(0 != mCSVFile) {
-      QO() = true;
-      STATUS() = scmOK;
-      DEVLOG_INFO("[GEN_CSV_WRITER]: File %s successfully opened\n", FILE_NAME().getValue());
-    } else {
-      STATUS() = strerror(errno);
-      DEVLOG_ERROR("[GEN_CSV_WRITER]: Couldn't open file %s. Error: %s\n", FILE_NAME().getValue(), STATUS().getValue());
+  if(CAsyncJob::eIdle != mFileJob.getState() || 0 == mFileJob.mFile) {
+    mFileJob.mFileName = FILE_NAME();
+    if(startFileJob(CFileJob::eOpen)) {
+      return;
     }
   } else {
     STATUS() = scmFileAlreadyOpened;
     DEVLOG_ERROR("[GEN_CSV_WRITER]: Can't open file %s since it is already opened\n", FILE_NAME().getValue());
   }
+  sendOutputEvent(scm_nEventINITOID);
 }
 
 void GEN_CSV_WRITER::closeCSVFile() {
   QO() = false;
-  if(0 != mCSVFile) {
-    if(0 == fclose(mCSVFile)) {
-      STATUS() = scmOK;
-      DEVLOG_INFO("[GEN_CSV_WRITER]: File %s successfully closed\n", FILE_NAME().getValue());
-    } else {
-      STATUS() = strerror(errno);
-      DEVLOG_ERROR("[GEN_CSV_WRITER]: Couldn't close file %s. Error: %s\n", FILE_NAME().getValue(), STATUS().getValue());
+  if(CAsyncJob::eIdle != mFileJob.getState() || 0 != mFileJob.mFile) {
+    //the pending lines are written before the file is closed
+    if(startWriteJob(CFileJob::eClose, false)) {
+      return;
     }
-    mCSVFile = 0;
   }
+  sendOutputEvent(scm_nEventINITOID);
 }
 
 void GEN_CSV_WRITER::writeCSVFileLine() {
-  if(0 != mCSVFile) {
-    char acBuffer[scmWriteBufferSize];
-    for(int i = 2; i < m_pstInterfaceSpec->m_nNumDIs; i++) {
-      int nLen = getDI(i)->toString(acBuffer, scmWriteBufferSize);
-      fwrite(acBuffer, 1, nLen, mCSVFile);
-      fwrite("; ", 1, 2, mCSVFile);
+  bool idle = (CAsyncJob::eIdle == mFileJob.getState());
+  if((idle && 0 != mFileJob.mFile) || (!idle && CFileJob::eClose != mFileJob.mCommand)) {
+    size_t previousSize = mPendingSize;
+    if(appendPendingLine()) {
+      if(idle) {
+        if(startWriteJob(CFileJob::eWriteLine, true)) {
+          return;
+        }
+        //only the rejected line is dropped, older pending lines are written with the next job
+        mPendingSize = previousSize;
+      } else if(0 != mPendingError) {
+        QO() = false;
+        STATUS() = strerror(mPendingError);
+        mPendingError = 0;
+      }
     }
-    fwrite("\n", 1, 1, mCSVFile);
   } else {
     QO() = false;
     STATUS() = scmFileNotOpened;
     DEVLOG_ERROR("[GEN_CSV_WRITER]: Can't write to file %s since it is not opened\n", FILE_NAME().getValue());
   }
+  sendOutputEvent(scm_nEventCNFID);
+}
+
+bool GEN_CSV_WRITER::appendPendingLine() {
+  //reserves the conversion buffer for each SD, the separators, and the new line
+  const size_t maxLineSize = (m_pstInterfaceSpec->m_nNumDIs - 2) * (scmWriteBufferSize + 2) + 2;
+  if(0 == mPendingLines) {
+    //both buffers have the same size so that they can be exchanged
+    mFileJob.mLineCapacity = scmMaxPendingLines * maxLineSize;
+    mPendingLines = new char[mFileJob.mLineCapacity];
+    mFileJob.mLine = new char[mFileJob.mLineCapacity];
+  }
+  if(mFileJob.mLineCapacity - mPendingSize < maxLineSize) {
+    QO() = false;
+    STATUS() = scmPendingLinesFull;
+    DEVLOG_ERROR("[GEN_CSV_WRITER]: Line for file %s rejected, too many lines are waiting to be written\n", FILE_NAME().getValue());
+    return false;
+  }
+  //the values are converted here as the worker must not access the inputs
+  char *linePos = mPendingLines + mPendingSize;
+  for(int i = 2; i < m_pstInterfaceSpec->m_nNumDIs; i++) {
+    int nLen = getDI(i)->toString(linePos, scmWriteBufferSize);
+    if(0 < nLen) {
+      linePos += nLen;
+    }
+    *linePos++ = ';';
+    *linePos++ = ' ';
+  }
+  *linePos++ = '\n';
+  mPendingSize = static_cast<size_t>(linePos - mPendingLines);
+  return true;
+}
+
+bool GEN_CSV_WRITER::startWriteJob(CFileJob::ECommand paCommand, bool paConfirm) {
+  bool idle = (CAsyncJob::eIdle == mFileJob.getState());
+  if(idle) {
+    swapLines();
+    mFileJob.mConfirm = paConfirm;
+  }
+  if(startFileJob(paCommand)) {
+    return true;
+  }
+  if(idle) {
+    swapLines();
+  }
+  return false;
+}
+
+void GEN_CSV_WRITER::flushPendingLines() {
+  swapLines();
+  mFileJob.mConfirm = false;
+  if(!submitFileJob(CFileJob::eWriteLine)) {
+    swapLines();
+    DEVLOG_WARNING("[GEN_CSV_WRITER]: Pending lines for file %s are written with the next request, too many pending file operations\n", FILE_NAME().getValue());
+  }
+}
+
+void GEN_CSV_WRITER::swapLines() {
+  char *lines = mFileJob.mLine;
+  mFileJob.mLine = mPendingLines;
+  mPendingLines = lines;
+  size_t size = mFileJob.mLineSize;
+  mFileJob.mLineSize = mPendingSize;
+  mPendingSize = size;
+}
+
+bool GEN_CSV_WRITER::startFileJob(CFileJob::ECommand paCommand) {
+  if(CAsyncJob::eIdle != mFileJob.getState()) {
+    QO() = false;
+    STATUS() = scmBusy;
+    DEVLOG_ERROR("[GEN_CSV_WRITER]: Operation on file %s rejected, the previous one is still running\n", FILE_NAME().getValue());
+    return false;
+  }
+  if(!submitFileJob(paCommand)) {
+    QO() = false;
+    STATUS() = scmQueueFull;
+    DEVLOG_ERROR("[GEN_CSV_WRITER]: Operation on file %s rejected, too many pending file operations\n", FILE_NAME().getValue());
+    return false;
+  }
+  return true;
+}
+
+bool GEN_CSV_WRITER::submitFileJob(CFileJob::ECommand paCommand) {
+  mFileJob.mCommand = paCommand;
+  //the completion is handled in the event chain the request came from
+  setEventChainExecutor(m_poInvokingExecEnv);
+  return getExtEvHandler<CAsyncWorkerHandler>(*this).submit(mFileJob);
+}
+
+void GEN_CSV_WRITER::finishFileJob() {
+  CFileJob::ECommand command = mFileJob.mCommand;
+  int error = mFileJob.mError;
+  bool confirm = mFileJob.mConfirm;
+  mFileJob.mLineSize = 0;
+  mFileJob.release();
+
+  if(CFileJob::eWriteLine == command) {
+    if(!confirm) {
+      //no REQ waits for the pending lines, a failure is reported with the next CNF
+      if(0 != error) {
+        mPendingError = error;
+        DEVLOG_ERROR("[GEN_CSV_WRITER]: Couldn't write to file %s. Error: %s\n", FILE_NAME().getValue(), strerror(error));
+      }
+      error = 0;
+    } else {
+      if(0 == error) {
+        error = mPendingError;
+      }
+      mPendingError = 0;
+    }
+  } else if(CFileJob::eClose == command) {
+    mPendingError = 0;
+  }
+  if(0 != error) {
+    QO() = false;
+    STATUS() = strerror(error);
+  }
+  switch(command){
+    case CFileJob::eOpen:
+      if(0 == error) {
+        QO() = true;
+        STATUS() = scmOK;
+        DEVLOG_INFO("[GEN_CSV_WRITER]: File %s successfully opened\n", FILE_NAME().getValue());
+      } else {
+        DEVLOG_ERROR("[GEN_CSV_WRITER]: Couldn't open file %s. Error: %s\n", FILE_NAME().getValue(), STATUS().getValue());
+      }
+      sendOutputEvent(scm_nEventINITOID);
+      break;
+    case CFileJob::eClose:
+      if(0 == error) {
+        STATUS() = scmOK;
+        DEVLOG_INFO("[GEN_CSV_WRITER]: File %s successfully closed\n", FILE_NAME().getValue());
+      } else {
+        DEVLOG_ERROR("[GEN_CSV_WRITER]: Couldn't close file %s. Error: %s\n", FILE_NAME().getValue(), STATUS().getValue());
+      }
+      sendOutputEvent(scm_nEventINITOID);
+      break;
+    case CFileJob::eWriteLine:
+      if(confirm) {
+        if(0 != error) {
+          DEVLOG_ERROR("[GEN_CSV_WRITER]: Couldn't write to file %s. Error: %s\n", FILE_NAME().getValue(), STATUS().getValue());
+        }
+        sendOutputEvent(scm_nEventCNFID);
+      }
+      break;
+  }
+
+  //lines of requests received while the job was running
+  if(0 == mFileJob.mFile) {
+    mPendingSize = 0;
+  } else if(0 != mPendingSize) {
+    flushPendingLines();
+  }
+}
+
+void GEN_CSV_WRITER::CFileJob::run() {
+  mError = 0;
+  switch(mCommand){
+    case eOpen:
+      mFile = fopen(mFileName.getValue(), "w+");
+      if(0 == mFile) {
+        mError = errno;
+      }
+      break;
+    case eClose:
+      errno = 0;
+      if((0 != mLineSize) && (mLineSize != fwrite(mLine, 1, mLineSize, mFile))) {
+        mError = (0 != errno) ? errno : EIO;
+      }
+      if((0 != fclose(mFile)) && (0 == mError)) {
+        mError = errno;
+      }
+      mFile = 0;
+      break;
+    case eWriteLine:
+      errno = 0;
+      if(mLineSize != fwrite(mLine, 1, mLineSize, mFile)) {
+        mError = (0 != errno) ? errno : EIO;
+      }
+      break;
+  }
 }
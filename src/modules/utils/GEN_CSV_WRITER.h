@@ -11,14 +11,26 @@
  *   Alois Zoitl, Monika Wenger
  *   - initial API and implementation and/or initial documentation
  *    Alois Zoitl - introduced new CGenFB class for better handling generic FBs
+ *    agent - moved the file operations to the asynchronous workers
  *******************************************************************************/
 #ifndef _GEN_CSV_WRITER_H_
 #define _GEN_CSV_WRITER_H_
 
 #include <genfb.h>
+#include <esfb.h>
+#include <asyncworker.h>
+#include <forte_string.h>
 #include <stdio.h>
 
-class GEN_CSV_WRITER : public CGenFunctionBlock<CFunctionBlock> {
+/*!\brief Writes the values of its SD inputs as lines of a CSV file
+ *
+ * Opening, writing and closing the file is done by the asynchronous workers of the device so that a slow file system
+ * does not block the event chain. INITO and CNF are sent when the file operation finished. Lines requested while an
+ * operation is running are collected in a pending buffer and written by the next file job, their CNF is sent right away.
+ * REQ is only answered with QO = FALSE if the pending buffer is full. A failed write of pending lines is reported with
+ * the next CNF. INIT is rejected with QO = FALSE while an operation is running.
+ */
+class GEN_CSV_WRITER : public CGenFunctionBlock<CEventSourceFB> {
     DECLARE_GENERIC_FIRMWARE_FB(GEN_CSV_WRITER)
 
   private:
@@ -54,30 +66,86 @@ class GEN_CSV_WRITER : public CGenFunctionBlock<CFunctionBlock> {
     static const CStringDictionary::TStringId scm_anEventOutputNames[];
 
     void executeEvent(int paEIID);
+    virtual EMGMResponse changeFBExecutionState(EMGMCommandType paCommand);
     virtual bool createInterfaceSpec(const char *paConfigString, SFBInterfaceSpec &paInterfaceSpec);
 
+    virtual CGenFBInterfaceSpecCache::TReleaseInterfaceSpecFunc getSharedInterfaceSpecReleaseFunc() const {
+      return releaseInterfaceSpec;
+    }
+
+    static void releaseInterfaceSpec(SFBInterfaceSpec &paInterfaceSpec);
+
   public:
     GEN_CSV_WRITER(const CStringDictionary::TStringId paInstanceNameId, CResource *paSrcRes);
     virtual ~GEN_CSV_WRITER();
 
   private:
+    //! File operation run by the asynchronous workers
+    class CFileJob : public CAsyncJob{
+      public:
+        enum ECommand{
+          eOpen, eClose, eWriteLine
+        };
+
+        explicit CFileJob(CEventSourceFB &paOwner) :
+            CAsyncJob(paOwner), mCommand(eOpen), mFile(0), mLine(0), mLineSize(0), mLineCapacity(0), mConfirm(false), mError(0){
+        }
+
+        virtual ~CFileJob(){
+          delete[] mLine;
+        }
+
+        ECommand mCommand;
+        FILE *mFile;
+        CIEC_STRING mFileName;
+        char *mLine; //!< lines to be written, prepared in the event chain, eClose writes them before closing
+        size_t mLineSize;
+        size_t mLineCapacity;
+        bool mConfirm; //!< a REQ waits for the completion of the job
+        int mError; //!< errno of the failed operation, 0 if it succeeded
+
+      private:
+        virtual void run();
+    };
 
     void openCSVFile();
     void closeCSVFile();
     void writeCSVFileLine();
 
-    FILE *mCSVFile;
-
-    CStringDictionary::TStringId *m_anDataInputNames;
-    CStringDictionary::TStringId *m_anDataInputTypeIds;
-
-    TDataIOID *m_anEIWith;
+    //! Formats the SDs as line at the end of the pending lines, on failure QO and STATUS are set
+    bool appendPendingLine();
+    //! Hands the pending lines over to the file job and submits it, on failure QO and STATUS are set
+    bool startWriteJob(CFileJob::ECommand paCommand, bool paConfirm);
+    //! Writes the pending lines without a REQ waiting for them, if the job is rejected they stay pending
+    void flushPendingLines();
+    //! Exchanges the pending lines with the lines of the file job
+    void swapLines();
+    //! Takes the file job back, lines it did not write yet are written here
+    void retractFileJob();
+
+    //! Submits the file job with the given command, on failure QO and STATUS are set
+    bool startFileJob(CFileJob::ECommand paCommand);
+    //! Submits the file job with the given command to the workers
+    bool submitFileJob(CFileJob::ECommand paCommand);
+    //! Takes the results of the finished file job and sends the according output event
+    void finishFileJob();
+
+    CFileJob mFileJob;
+
+    char *mPendingLines; //!< lines of requests received while a file job was running
+    size_t mPendingSize;
+    int mPendingError; //!< errno of a failed write of pending lines, reported with the next CNF
 
     static const char * const scmOK;
     static const char * const scmFileAlreadyOpened;
     static const char * const scmFileNotOpened;
+    static const char * const scmBusy;
+    static const char * const scmQueueFull;
+    static const char * const scmPendingLinesFull;
 
     static const size_t scmWriteBufferSize = 100;
+    //! Number of lines the pending buffer can hold
+    static const size_t scmMaxPendingLines = 32;
 
 };
 
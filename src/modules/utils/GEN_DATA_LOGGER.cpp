@@ -0,0 +1,670 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include "GEN_DATA_LOGGER.h"
+#ifdef FORTE_ENABLE_GENERATED_SOURCE_CPP
+#include "GEN_DATA_LOGGER_gen.cpp"
+#endif
+#include <string.h>
+#include <errno.h>
+#include <devlog.h>
+#include <extevhandlerhelper.h>
+#include <forte_architecture_time.h>
+#ifdef WIN32
+#include <io.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+DEFINE_GENERIC_FIRMWARE_FB(GEN_DATA_LOGGER, g_nStringIdGEN_DATA_LOGGER);
+
+const CStringDictionary::TStringId GEN_DATA_LOGGER::scm_anDataOutputNames[] = { g_nStringIdQO, g_nStringIdSTATUS, g_nStringIdDROPPED };
+
+const CStringDictionary::TStringId GEN_DATA_LOGGER::scm_anDataOutputTypeIds[] = { g_nStringIdBOOL, g_nStringIdSTRING, g_nStringIdUDINT };
+
+const CStringDictionary::TStringId GEN_DATA_LOGGER::scm_anEventInputNames[] = { g_nStringIdINIT, g_nStringIdREQ };
+
+const TForteInt16 GEN_DATA_LOGGER::scm_anEIWithIndexes[] = { 0, scmNumFixedDIs + 1 };
+const TDataIOID GEN_DATA_LOGGER::scm_anEOWith[] = { 0, 1, 2, 255, 0, 1, 2, 255 };
+const TForteInt16 GEN_DATA_LOGGER::scm_anEOWithIndexes[] = { 0, 4, -1 };
+const CStringDictionary::TStringId GEN_DATA_LOGGER::scm_anEventOutputNames[] = { g_nStringIdINITO, g_nStringIdCNF };
+
+const char * const GEN_DATA_LOGGER::scmOK = "OK";
+const char * const GEN_DATA_LOGGER::scmAlreadyOpened = "Logger already opened";
+const char * const GEN_DATA_LOGGER::scmNotOpened = "Logger not opened";
+const char * const GEN_DATA_LOGGER::scmBusy = "Previous file operation still running";
+const char * const GEN_DATA_LOGGER::scmQueueFull = "Too many pending file operations";
+const char * const GEN_DATA_LOGGER::scmUnsupportedType = "SD of a type which can not be logged";
+const char * const GEN_DATA_LOGGER::scmUnknownFormat = "Unknown format";
+
+namespace {
+  const char scmBinaryMagic[8] = { 'F', 'O', 'R', 'T', 'E', 'L', 'O', 'G' };
+  const TForteUInt16 scmBinaryByteOrderMark = 0x0102;
+  const TForteUInt16 scmBinaryVersion = 1;
+  const size_t scmTimeStampSize = sizeof(TForteUInt64);
+  const size_t scmValueTextSize = 64;
+}
+
+void GEN_DATA_LOGGER::executeEvent(int paEIID) {
+  if(cg_nExternalEventID == paEIID) {
+    if(CAsyncJob::eDone == mLogJob.getState()) {
+      finishJob();
+    } else {
+      //tick of the flush timer
+      flushIfNeeded();
+    }
+  } else if(scm_nEventINITID == paEIID) {
+    if(QI()) {
+      openLogger();
+    } else {
+      closeLogger();
+    }
+  } else if(scm_nEventREQID == paEIID) {
+    QO() = QI() && mOpened;
+    if(QI()) {
+      logSample();
+    }
+    sendOutputEvent(scm_nEventCNFID);
+  }
+}
+
+EMGMResponse GEN_DATA_LOGGER::changeFBExecutionState(EMGMCommandType paCommand){
+  EMGMResponse retVal = CGenFunctionBlock<CEventSourceFB>::changeFBExecutionState(paCommand);
+  if((e_RDY == retVal) && (cg_nMGM_CMD_Start == paCommand) && mOpened) {
+    startFlushTimer();
+  }
+  if((e_RDY == retVal) && ((cg_nMGM_CMD_Stop == paCommand) || (cg_nMGM_CMD_Kill == paCommand))) {
+    stopFlushTimer();
+    //a stopped FB does not get the completion event anymore, therefore the results are taken here
+    if(getExtEvHandler<CAsyncWorkerHandler>(*this).retract(mLogJob)) {
+      takeJobResults();
+    }
+    if(!mOpened) {
+      //a retracted open leaves the buffers behind
+      freeBuffers();
+    }
+    mClosePending = false;
+  }
+  return retVal;
+}
+
+GEN_DATA_LOGGER::GEN_DATA_LOGGER(const CStringDictionary::TStringId paInstanceNameId, CResource *paSrcRes) :
+    CGenFunctionBlock<CEventSourceFB>(paSrcRes, paInstanceNameId), mLogJob(*this), mColumns(0), mRing(0), mRingStart(0),
+    mRingCount(0), mOpened(false), mClosePending(false), mFlushTimerActive(false){
+  mFlushTimer.mTimeOut = 0;
+  mFlushTimer.mInterval = 0;
+  mFlushTimer.mNext = 0;
+  mFlushTimer.mType = e_Periodic;
+  mFlushTimer.mTimedFB = this;
+}
+
+GEN_DATA_LOGGER::~GEN_DATA_LOGGER(){
+  stopFlushTimer();
+  if(getExtEvHandler<CAsyncWorkerHandler>(*this).retract(mLogJob)) {
+    takeJobResults();
+  }
+  if(0 != mLogJob.mFile) {
+    //the remaining samples are written here as the workers can not report back to a deleted FB
+    mLogJob.mCommand = CLogJob::eClose;
+    mLogJob.mFirstSample = mRingStart;
+    mLogJob.mNumSamples = mRingCount;
+    mLogJob.execute();
+  }
+  freeBuffers();
+}
+
+size_t GEN_DATA_LOGGER::getValueSize(CIEC_ANY::EDataTypeID paTypeId){
+  switch(paTypeId){
+    case CIEC_ANY::e_BOOL:
+      return sizeof(bool);
+    case CIEC_ANY::e_SINT:
+    case CIEC_ANY::e_USINT:
+    case CIEC_ANY::e_BYTE:
+      return sizeof(TForteUInt8);
+    case CIEC_ANY::e_INT:
+    case CIEC_ANY::e_UINT:
+    case CIEC_ANY::e_WORD:
+      return sizeof(TForteUInt16);
+    case CIEC_ANY::e_DINT:
+    case CIEC_ANY::e_UDINT:
+    case CIEC_ANY::e_DWORD:
+      return sizeof(TForteUInt32);
+#ifdef FORTE_USE_REAL_DATATYPE
+    case CIEC_ANY::e_REAL:
+      return sizeof(TForteFloat);
+#endif //FORTE_USE_REAL_DATATYPE
+#ifdef FORTE_USE_LREAL_DATATYPE
+    case CIEC_ANY::e_LREAL:
+      return sizeof(TForteDFloat);
+#endif //FORTE_USE_LREAL_DATATYPE
+    case CIEC_ANY::e_LINT:
+    case CIEC_ANY::e_ULINT:
+    case CIEC_ANY::e_LWORD:
+    case CIEC_ANY::e_DATE:
+    case CIEC_ANY::e_TIME_OF_DAY:
+    case CIEC_ANY::e_DATE_AND_TIME:
+    case CIEC_ANY::e_TIME:
+      return sizeof(CIEC_ANY::TLargestUIntValueType);
+    default:
+      //strings and constructed types do not keep their value in the data union
+      return 0;
+  }
+}
+
+void GEN_DATA_LOGGER::releaseInterfaceSpec(SFBInterfaceSpec &paInterfaceSpec){
+  delete[] paInterfaceSpec.m_aunDINames;
+  delete[] paInterfaceSpec.m_aunDIDataTypeNames;
+  delete[] paInterfaceSpec.m_anEIWith;
+}
+
+bool GEN_DATA_LOGGER::createInterfaceSpec(const char *paConfigString, SFBInterfaceSpec &paInterfaceSpec) {
+  const char *acPos = strrchr(paConfigString, '_');
+  if(0 != acPos){
+    acPos++;
+    paInterfaceSpec.m_nNumDIs = static_cast<TForteUInt8>(forte::core::util::strtoul(acPos, 0, 10) + scmNumFixedDIs);
+
+    CStringDictionary::TStringId *dataInputNames = new CStringDictionary::TStringId[paInterfaceSpec.m_nNumDIs];
+    CStringDictionary::TStringId *dataInputTypeIds = new CStringDictionary::TStringId[paInterfaceSpec.m_nNumDIs];
+
+    const CStringDictionary::TStringId fixedNames[scmNumFixedDIs] = { g_nStringIdQI, g_nStringIdFILE_NAME, g_nStringIdFORMAT,
+      g_nStringIdSAMPLES, g_nStringIdROTATE_SIZE, g_nStringIdROTATE_TIME, g_nStringIdSYNC };
+    const CStringDictionary::TStringId fixedTypeIds[scmNumFixedDIs] = { g_nStringIdBOOL, g_nStringIdSTRING, g_nStringIdSTRING,
+      g_nStringIdUDINT, g_nStringIdUDINT, g_nStringIdTIME, g_nStringIdUSINT };
+    memcpy(dataInputNames, fixedNames, sizeof(fixedNames));
+    memcpy(dataInputTypeIds, fixedTypeIds, sizeof(fixedTypeIds));
+
+    generateGenericDataPointArrays("SD_", &(dataInputTypeIds[scmNumFixedDIs]), &(dataInputNames[scmNumFixedDIs]),
+        paInterfaceSpec.m_nNumDIs - scmNumFixedDIs);
+
+    //INIT with all fixed inputs, REQ with QI and the SDs
+    TDataIOID *eiWith = new TDataIOID[paInterfaceSpec.m_nNumDIs + 3];
+    for(TDataIOID i = 0; i < scmNumFixedDIs; i++){
+      eiWith[i] = i;
+    }
+    eiWith[scmNumFixedDIs] = scmWithListDelimiter;
+    eiWith[scmNumFixedDIs + 1] = 0;
+    for(TDataIOID i = scmNumFixedDIs; i < paInterfaceSpec.m_nNumDIs; i++){
+      eiWith[i + 2] = i;
+    }
+    eiWith[paInterfaceSpec.m_nNumDIs + 2] = scmWithListDelimiter;
+
+    //create the interface Specification
+    paInterfaceSpec.m_nNumEIs = 2;
+    paInterfaceSpec.m_aunEINames = scm_anEventInputNames;
+    paInterfaceSpec.m_anEIWith = eiWith;
+    paInterfaceSpec.m_anEIWithIndexes = scm_anEIWithIndexes;
+    paInterfaceSpec.m_nNumEOs = 2;
+    paInterfaceSpec.m_aunEONames = scm_anEventOutputNames;
+    paInterfaceSpec.m_anEOWith = scm_anEOWith;
+    paInterfaceSpec.m_anEOWithIndexes = scm_anEOWithIndexes;
+    paInterfaceSpec.m_aunDINames = dataInputNames;
+    paInterfaceSpec.m_aunDIDataTypeNames = dataInputTypeIds;
+    paInterfaceSpec.m_nNumDOs = 3;
+    paInterfaceSpec.m_aunDONames = scm_anDataOutputNames;
+    paInterfaceSpec.m_aunDODataTypeNames = scm_anDataOutputTypeIds;
+    return true;
+  }
+  return false;
+}
+
+void GEN_DATA_LOGGER::openLogger() {
+  QO() = false;
+  if(0 != mRing) {
+    //the ring exists from the start of the opening until the logger is closed
+    setError(mOpened ? scmAlreadyOpened : scmBusy);
+    sendOutputEvent(scm_nEventINITOID);
+    return;
+  }
+
+  if(('\0' == FORMAT().getValue()[0]) || (0 == strcmp("CSV", FORMAT().getValue()))) {
+    mLogJob.mFormat = CLogJob::eCSV;
+  } else if(0 == strcmp("BIN", FORMAT().getValue())) {
+    mLogJob.mFormat = CLogJob::eBinary;
+  } else {
+    setError(scmUnknownFormat);
+    sendOutputEvent(scm_nEventINITOID);
+    return;
+  }
+
+  size_t numColumns = static_cast<size_t>(m_pstInterfaceSpec->m_nNumDIs - scmNumFixedDIs);
+  mColumns = new SColumn[numColumns];
+  size_t sampleSize = scmTimeStampSize;
+  for(size_t i = 0; i < numColumns; ++i) {
+    CIEC_ANY *sd = getDI(static_cast<unsigned int>(scmNumFixedDIs + i));
+    mColumns[i].mName = m_pstInterfaceSpec->m_aunDINames[scmNumFixedDIs + i];
+    mColumns[i].mSize = getValueSize(sd->getDataTypeID());
+    mColumns[i].mValue = (0 != mColumns[i].mSize) ? sd->clone(0) : 0;
+    sampleSize += mColumns[i].mSize;
+  }
+  for(size_t i = 0; i < numColumns; ++i) {
+    if(0 == mColumns[i].mSize) {
+      mLogJob.mNumColumns = numColumns;
+      freeBuffers();
+      setError(scmUnsupportedType);
+      sendOutputEvent(scm_nEventINITOID);
+      return;
+    }
+  }
+
+  size_t capacity = (0 != SAMPLES()) ? static_cast<size_t>(static_cast<TForteUInt32>(SAMPLES())) : scmDefaultSamples;
+  mRing = new TForteByte[capacity * sampleSize];
+  mRingStart = 0;
+  mRingCount = 0;
+  DROPPED() = CIEC_UDINT(0);
+
+  mLogJob.mFileName = FILE_NAME();
+  mLogJob.mSyncPolicy = (SYNC() > CLogJob::eSyncAlways) ? CLogJob::eSyncAlways : static_cast<CLogJob::ESyncPolicy>(static_cast<TForteUInt8>(SYNC()));
+  mLogJob.mRotateSize = static_cast<TForteUInt32>(ROTATE_SIZE());
+  mLogJob.mRotateTime = (0 < ROTATE_TIME()) ? static_cast<TForteUInt64>(ROTATE_TIME().getInNanoSeconds()) : 0;
+  mLogJob.mStartTime = getNanoSecondsMonotonic();
+  mLogJob.mColumns = mColumns;
+  mLogJob.mNumColumns = numColumns;
+  mLogJob.mRing = mRing;
+  mLogJob.mScratch = (CLogJob::eBinary == mLogJob.mFormat) ? new TForteByte[capacity * sizeof(CIEC_ANY::TLargestUIntValueType)] : 0;
+  mLogJob.mSampleSize = sampleSize;
+  mLogJob.mCapacity = capacity;
+  mLogJob.mNumSamples = 0;
+
+  if(!startJob(CLogJob::eOpen)) {
+    freeBuffers();
+    sendOutputEvent(scm_nEventINITOID);
+  }
+}
+
+void GEN_DATA_LOGGER::closeLogger() {
+  QO() = false;
+  if(!mOpened) {
+    if(0 != mRing) {
+      setError(scmBusy);
+    }
+    sendOutputEvent(scm_nEventINITOID);
+    return;
+  }
+  if(CAsyncJob::eIdle != mLogJob.getState()) {
+    //INITO is sent when the file was closed after the running write
+    mClosePending = true;
+    return;
+  }
+  mLogJob.mFirstSample = mRingStart;
+  mLogJob.mNumSamples = mRingCount;
+  if(!startJob(CLogJob::eClose)) {
+    sendOutputEvent(scm_nEventINITOID);
+  }
+}
+
+void GEN_DATA_LOGGER::logSample() {
+  if(!mOpened || mClosePending) {
+    setError(scmNotOpened);
+    return;
+  }
+  if(mRingCount == mLogJob.mCapacity) {
+    DROPPED() = CIEC_UDINT(static_cast<TForteUInt32>(DROPPED() + 1));
+  } else {
+    TForteByte *pos = mRing + ((mRingStart + mRingCount) % mLogJob.mCapacity) * mLogJob.mSampleSize;
+    TForteUInt64 timeStamp = static_cast<TForteUInt64>(getNanoSecondsMonotonic() - mLogJob.mStartTime);
+    memcpy(pos, &timeStamp, scmTimeStampSize);
+    pos += scmTimeStampSize;
+    for(size_t i = 0; i < mLogJob.mNumColumns; ++i) {
+      //the values of the logged types are at the beginning of the data union
+      memcpy(pos, getDI(static_cast<unsigned int>(scmNumFixedDIs + i))->getConstDataPtr(), mColumns[i].mSize);
+      pos += mColumns[i].mSize;
+    }
+    ++mRingCount;
+  }
+  flushIfNeeded();
+}
+
+void GEN_DATA_LOGGER::flushIfNeeded() {
+  if((0 == mRingCount) || (CAsyncJob::eIdle != mLogJob.getState())) {
+    return;
+  }
+  TForteUInt64 oldest;
+  memcpy(&oldest, mRing + mRingStart * mLogJob.mSampleSize, scmTimeStampSize);
+  TForteUInt64 now = static_cast<TForteUInt64>(getNanoSecondsMonotonic() - mLogJob.mStartTime);
+  //the age is checked only every scmFlushCheckInterval, so the write starts that much earlier
+  if((mRingCount >= (mLogJob.mCapacity + 1) / 2) || (now - oldest >= scmMaxSampleAge - scmFlushCheckInterval)) {
+    mLogJob.mFirstSample = mRingStart;
+    mLogJob.mNumSamples = mRingCount;
+    startJob(CLogJob::eFlush);
+  }
+}
+
+void GEN_DATA_LOGGER::startFlushTimer() {
+  if(!mFlushTimerActive) {
+    CIEC_TIME interval;
+    interval.setFromNanoSeconds(static_cast<CIEC_TIME::TValueType>(scmFlushCheckInterval));
+    getTimer().registerTimedFB(&mFlushTimer, interval);
+    mFlushTimerActive = true;
+  }
+}
+
+void GEN_DATA_LOGGER::stopFlushTimer() {
+  if(mFlushTimerActive) {
+    getTimer().unregisterTimedFB(this);
+    mFlushTimerActive = false;
+  }
+}
+
+bool GEN_DATA_LOGGER::startJob(CLogJob::ECommand paCommand) {
+  if(CAsyncJob::eIdle != mLogJob.getState()) {
+    setError(scmBusy);
+    return false;
+  }
+  mLogJob.mCommand = paCommand;
+  //the completion is handled in the event chain the request came from
+  setEventChainExecutor(m_poInvokingExecEnv);
+  if(!getExtEvHandler<CAsyncWorkerHandler>(*this).submit(mLogJob)) {
+    setError(scmQueueFull);
+    return false;
+  }
+  return true;
+}
+
+void GEN_DATA_LOGGER::finishJob() {
+  CLogJob::ECommand command = mLogJob.mCommand;
+  mLogJob.release();
+  takeJobResults();
+  switch(command){
+    case CLogJob::eOpen:
+      if(mOpened) {
+        startFlushTimer();
+      }
+      sendOutputEvent(scm_nEventINITOID);
+      break;
+    case CLogJob::eClose:
+      sendOutputEvent(scm_nEventINITOID);
+      break;
+    case CLogJob::eFlush:
+      if(mClosePending) {
+        mClosePending = false;
+        closeLogger();
+      } else {
+        flushIfNeeded();
+      }
+      break;
+  }
+}
+
+void GEN_DATA_LOGGER::takeJobResults() {
+  int error = mLogJob.mError;
+  switch(mLogJob.mCommand){
+    case CLogJob::eOpen:
+      if(0 == error) {
+        mOpened = true;
+        QO() = true;
+        STATUS() = scmOK;
+        DEVLOG_INFO("[GEN_DATA_LOGGER]: File %s successfully opened\n", mLogJob.mFileName.getValue());
+      } else {
+        freeBuffers();
+      }
+      break;
+    case CLogJob::eFlush:
+      mRingStart = (mRingStart + mLogJob.mNumSamples) % mLogJob.mCapacity;
+      mRingCount -= mLogJob.mNumSamples;
+      break;
+    case CLogJob::eClose:
+      mOpened = false;
+      stopFlushTimer();
+      freeBuffers();
+      QO() = false;
+      if(0 == error) {
+        STATUS() = scmOK;
+        DEVLOG_INFO("[GEN_DATA_LOGGER]: File %s successfully closed\n", mLogJob.mFileName.getValue());
+      }
+      break;
+  }
+  if(0 != error) {
+    if(CLogJob::eOpen != mLogJob.mCommand) {
+      //the samples of a failed write are lost
+      DROPPED() = CIEC_UDINT(static_cast<TForteUInt32>(DROPPED() + mLogJob.mNumSamples));
+    }
+    QO() = false;
+    STATUS() = strerror(error);
+    DEVLOG_ERROR("[GEN_DATA_LOGGER]: File operation on %s failed. Error: %s\n", mLogJob.mFileName.getValue(), STATUS().getValue());
+  }
+}
+
+void GEN_DATA_LOGGER::freeBuffers() {
+  if(0 != mColumns) {
+    for(size_t i = 0; i < mLogJob.mNumColumns; ++i) {
+      delete mColumns[i].mValue;
+    }
+    delete[] mColumns;
+    mColumns = 0;
+  }
+  delete[] mRing;
+  mRing = 0;
+  delete[] mLogJob.mScratch;
+  mLogJob.mScratch = 0;
+  mLogJob.mColumns = 0;
+  mLogJob.mRing = 0;
+  mLogJob.mNumColumns = 0;
+  mRingCount = 0;
+}
+
+void GEN_DATA_LOGGER::setError(const char *paStatus) {
+  QO() = false;
+  STATUS() = paStatus;
+  DEVLOG_ERROR("[GEN_DATA_LOGGER]: %s: %s\n", FILE_NAME().getValue(), paStatus);
+}
+
+GEN_DATA_LOGGER::CLogJob::CLogJob(CEventSourceFB &paOwner) :
+    CAsyncJob(paOwner), mCommand(eOpen), mFormat(eCSV), mSyncPolicy(eSyncNever), mFile(0), mFileIndex(0), mFileSize(0),
+    mFileStartTime(0), mRotateSize(0), mRotateTime(0), mStartTime(0), mColumns(0), mNumColumns(0), mRing(0), mScratch(0),
+    mSampleSize(0), mCapacity(0), mFirstSample(0), mNumSamples(0), mError(0){
+}
+
+void GEN_DATA_LOGGER::CLogJob::run() {
+  execute();
+}
+
+void GEN_DATA_LOGGER::CLogJob::execute() {
+  mError = 0;
+  switch(mCommand){
+    case eOpen:
+      mFileIndex = 0;
+      if(!openFile()) {
+        closeFile();
+      }
+      break;
+    case eFlush:
+      //a file which could not be opened at a rotation is tried again
+      if(((0 != mFile) || openFile()) && rotateIfNeeded() && writeSamples() && (eSyncAlways == mSyncPolicy)) {
+        sync();
+      }
+      break;
+    case eClose:
+      if(((0 != mFile) || openFile()) && rotateIfNeeded()) {
+        writeSamples();
+      }
+      closeFile();
+      break;
+  }
+}
+
+bool GEN_DATA_LOGGER::CLogJob::openFile() {
+  const char *fileName = mFileName.getValue();
+  char *indexedName = 0;
+  if(0 != mFileIndex) {
+    size_t nameLength = strlen(fileName);
+    indexedName = new char[nameLength + 12];
+    memcpy(indexedName, fileName, nameLength);
+    char *pos = indexedName + nameLength;
+    *pos++ = '.';
+    char digits[10];
+    size_t numDigits = 0;
+    for(unsigned int index = mFileIndex; 0 != index; index /= 10) {
+      digits[numDigits++] = static_cast<char>('0' + index % 10);
+    }
+    while(0 != numDigits) {
+      *pos++ = digits[--numDigits];
+    }
+    *pos = '\0';
+    fileName = indexedName;
+  }
+
+  mFile = fopen(fileName, (eBinary == mFormat) ? "wb" : "w");
+  delete[] indexedName;
+  if(0 == mFile) {
+    mError = errno;
+    return false;
+  }
+  mFileSize = 0;
+  mFileStartTime = getNanoSecondsMonotonic();
+  return (eBinary == mFormat) ? writeBinaryHeader() : writeCSVHeader();
+}
+
+bool GEN_DATA_LOGGER::CLogJob::closeFile() {
+  if(0 == mFile) {
+    return true;
+  }
+  if(eSyncNever != mSyncPolicy) {
+    sync();
+  }
+  bool closed = (0 == fclose(mFile));
+  mFile = 0;
+  if(!closed && (0 == mError)) {
+    mError = errno;
+  }
+  return closed;
+}
+
+bool GEN_DATA_LOGGER::CLogJob::rotateIfNeeded() {
+  //a new file is only started when there are samples for it
+  if((0 != mNumSamples) && (((0 != mRotateSize) && (mFileSize >= mRotateSize)) ||
+      ((0 != mRotateTime) && (getNanoSecondsMonotonic() - mFileStartTime >= mRotateTime)))) {
+    bool closed = closeFile();
+    ++mFileIndex;
+    return closed && openFile();
+  }
+  return true;
+}
+
+bool GEN_DATA_LOGGER::CLogJob::writeSamples() {
+  if(0 == mNumSamples) {
+    return true;
+  }
+  return (eBinary == mFormat) ? writeBinaryBlock() : writeCSVLines();
+}
+
+bool GEN_DATA_LOGGER::CLogJob::writeCSVHeader() {
+  if(!write("TIME", 4)) {
+    return false;
+  }
+  for(size_t i = 0; i < mNumColumns; ++i) {
+    const char *name = CStringDictionary::getInstance().get(mColumns[i].mName);
+    if(!write("; ", 2) || !write(name, strlen(name))) {
+      return false;
+    }
+  }
+  return write("\n", 1);
+}
+
+bool GEN_DATA_LOGGER::CLogJob::writeCSVLines() {
+  char text[scmValueTextSize];
+  for(size_t i = 0; i < mNumSamples; ++i) {
+    const TForteByte *sample = getSample(i);
+    TForteUInt64 timeStamp;
+    memcpy(&timeStamp, sample, scmTimeStampSize);
+    char *pos = text + sizeof(text);
+    do {
+      *--pos = static_cast<char>('0' + timeStamp % 10);
+      timeStamp /= 10;
+    } while(0 != timeStamp);
+    if(!write(pos, static_cast<size_t>(text + sizeof(text) - pos))) {
+      return false;
+    }
+
+    sample += scmTimeStampSize;
+    for(size_t j = 0; j < mNumColumns; ++j) {
+      CIEC_ANY &value = *mColumns[j].mValue;
+      memcpy(value.getDataPtr(), sample, mColumns[j].mSize);
+      sample += mColumns[j].mSize;
+      int length = value.toString(text, sizeof(text));
+      if(!write("; ", 2) || ((0 < length) && !write(text, static_cast<size_t>(length)))) {
+        return false;
+      }
+    }
+    if(!write("\n", 1)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* The binary file starts with the schema header, all numbers are in the byte order of the device:
+ *   8 byte magic "FORTELOG", UINT16 byte order mark 0x0102, UINT16 version, UINT16 number of columns,
+ *   UINT16 reserved, UINT64 time the logger was opened in nanoseconds of the device's monotonic clock
+ *   per column: UINT16 data type id (CIEC_ANY::EDataTypeID), UINT8 value size, UINT8 name length, name
+ */
+bool GEN_DATA_LOGGER::CLogJob::writeBinaryHeader() {
+  TForteUInt16 header[4] = { scmBinaryByteOrderMark, scmBinaryVersion, static_cast<TForteUInt16>(mNumColumns), 0 };
+  TForteUInt64 startTime = static_cast<TForteUInt64>(mStartTime);
+  if(!write(scmBinaryMagic, sizeof(scmBinaryMagic)) || !write(header, sizeof(header)) || !write(&startTime, sizeof(startTime))) {
+    return false;
+  }
+  for(size_t i = 0; i < mNumColumns; ++i) {
+    const char *name = CStringDictionary::getInstance().get(mColumns[i].mName);
+    TForteUInt16 typeId = static_cast<TForteUInt16>(mColumns[i].mValue->getDataTypeID());
+    TForteUInt8 sizes[2] = { static_cast<TForteUInt8>(mColumns[i].mSize), static_cast<TForteUInt8>(strlen(name)) };
+    if(!write(&typeId, sizeof(typeId)) || !write(sizes, sizeof(sizes)) || !write(name, sizes[1])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* A block of samples: UINT32 number of samples, the UINT64 time stamps in nanoseconds since the logger was opened and
+ * then the values of every column one after the other
+ */
+bool GEN_DATA_LOGGER::CLogJob::writeBinaryBlock() {
+  TForteUInt32 numSamples = static_cast<TForteUInt32>(mNumSamples);
+  if(!write(&numSamples, sizeof(numSamples))) {
+    return false;
+  }
+  size_t offset = 0;
+  for(size_t column = 0; column <= mNumColumns; ++column) {
+    size_t size = (0 == column) ? scmTimeStampSize : mColumns[column - 1].mSize;
+    TForteByte *pos = mScratch;
+    for(size_t i = 0; i < mNumSamples; ++i) {
+      memcpy(pos, getSample(i) + offset, size);
+      pos += size;
+    }
+    if(!write(mScratch, size * mNumSamples)) {
+      return false;
+    }
+    offset += size;
+  }
+  return true;
+}
+
+bool GEN_DATA_LOGGER::CLogJob::write(const void *paData, size_t paSize) {
+  errno = 0;
+  if(paSize != fwrite(paData, 1, paSize, mFile)) {
+    mError = (0 != errno) ? errno : EIO;
+    return false;
+  }
+  mFileSize += paSize;
+  return true;
+}
+
+void GEN_DATA_LOGGER::CLogJob::sync() {
+  fflush(mFile);
+#ifdef WIN32
+  _commit(_fileno(mFile));
+#elif defined(__unix__) || defined(__APPLE__)
+  fsync(fileno(mFile));
+#endif
+}
+
+const TForteByte *GEN_DATA_LOGGER::CLogJob::getSample(size_t paIndex) const {
+  return mRing + ((mFirstSample + paIndex) % mCapacity) * mSampleSize;
+}
@@ -0,0 +1,235 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#ifndef _GEN_DATA_LOGGER_H_
+#define _GEN_DATA_LOGGER_H_
+
+#include <genfb.h>
+#include <esfb.h>
+#include <asyncworker.h>
+#include <timerha.h>
+#include <forte_bool.h>
+#include <forte_string.h>
+#include <forte_udint.h>
+#include <forte_usint.h>
+#include <forte_time.h>
+#include <stdio.h>
+
+/*!\brief Logs the values of its SD inputs with a high rate
+ *
+ * REQ only copies the raw values of the SDs together with a time stamp into a ring buffer allocated at INIT. The
+ * samples are written to the file by the asynchronous workers of the device when the ring is half full, one second
+ * after the oldest unwritten sample or when the logger is closed. While the logger is open the timer handler of the
+ * device checks the age of the samples periodically, so also the last samples of a burst are written in time. If the
+ * ring is full samples are dropped and counted in DROPPED.
+ *
+ * Only SDs of elementary types with a fixed size can be logged. The file is written in one of the formats:
+ *   - CSV: a header line with the input names followed by one line per sample, the first column is the time in
+ *     nanoseconds since the logger was opened
+ *   - BIN: a schema header followed by blocks of samples stored column by column, see writeBinaryHeader and
+ *     writeBinaryBlock for the layout
+ *
+ * Further parameters given with INIT:
+ *   - SAMPLES: number of samples the ring buffer can hold, 0 for the default of 1024
+ *   - ROTATE_SIZE: size in bytes after which a new file is started, 0 disables the rotation by size
+ *   - ROTATE_TIME: time after which a new file is started, 0 disables the rotation by time
+ *   - SYNC: 0 never syncs the file to the disk, 1 syncs when a file is closed, 2 syncs after every write
+ *
+ * The rotated files get FILE_NAME with the number of the file appended (e.g., log.csv.1, log.csv.2).
+ */
+class GEN_DATA_LOGGER : public CGenFunctionBlock<CEventSourceFB> {
+    DECLARE_GENERIC_FIRMWARE_FB(GEN_DATA_LOGGER)
+
+  private:
+    CIEC_BOOL &QI(){
+      return *static_cast<CIEC_BOOL*>(getDI(0));
+    }
+
+    CIEC_STRING &FILE_NAME(){
+      return *static_cast<CIEC_STRING*>(getDI(1));
+    }
+
+    CIEC_STRING &FORMAT(){
+      return *static_cast<CIEC_STRING*>(getDI(2));
+    }
+
+    CIEC_UDINT &SAMPLES(){
+      return *static_cast<CIEC_UDINT*>(getDI(3));
+    }
+
+    CIEC_UDINT &ROTATE_SIZE(){
+      return *static_cast<CIEC_UDINT*>(getDI(4));
+    }
+
+    CIEC_TIME &ROTATE_TIME(){
+      return *static_cast<CIEC_TIME*>(getDI(5));
+    }
+
+    CIEC_USINT &SYNC(){
+      return *static_cast<CIEC_USINT*>(getDI(6));
+    }
+
+    static const CStringDictionary::TStringId scm_anDataOutputNames[];
+    static const CStringDictionary::TStringId scm_anDataOutputTypeIds[];
+    CIEC_BOOL &QO(){
+      return *static_cast<CIEC_BOOL*>(getDO(0));
+    }
+
+    CIEC_STRING &STATUS(){
+      return *static_cast<CIEC_STRING*>(getDO(1));
+    }
+
+    CIEC_UDINT &DROPPED(){
+      return *static_cast<CIEC_UDINT*>(getDO(2));
+    }
+
+    static const TEventID scm_nEventINITID = 0;
+    static const TEventID scm_nEventREQID = 1;
+    static const TForteInt16 scm_anEIWithIndexes[];
+    static const CStringDictionary::TStringId scm_anEventInputNames[];
+
+    static const TEventID scm_nEventINITOID = 0;
+    static const TEventID scm_nEventCNFID = 1;
+    static const TForteInt16 scm_anEOWithIndexes[];
+    static const TDataIOID scm_anEOWith[];
+    static const CStringDictionary::TStringId scm_anEventOutputNames[];
+
+    //! QI, FILE_NAME, FORMAT, SAMPLES, ROTATE_SIZE, ROTATE_TIME, SYNC
+    static const TPortId scmNumFixedDIs = 7;
+
+    void executeEvent(int paEIID);
+    virtual EMGMResponse changeFBExecutionState(EMGMCommandType paCommand);
+    virtual bool createInterfaceSpec(const char *paConfigString, SFBInterfaceSpec &paInterfaceSpec);
+
+    virtual CGenFBInterfaceSpecCache::TReleaseInterfaceSpecFunc getSharedInterfaceSpecReleaseFunc() const {
+      return releaseInterfaceSpec;
+    }
+
+    static void releaseInterfaceSpec(SFBInterfaceSpec &paInterfaceSpec);
+
+  public:
+    GEN_DATA_LOGGER(const CStringDictionary::TStringId paInstanceNameId, CResource *paSrcRes);
+    virtual ~GEN_DATA_LOGGER();
+
+    //! Size of the raw value of the given type in the ring buffer, 0 if values of the type can not be logged
+    static size_t getValueSize(CIEC_ANY::EDataTypeID paTypeId);
+
+  private:
+    //! Column of the log, one per SD
+    struct SColumn{
+        CStringDictionary::TStringId mName;
+        size_t mSize;
+        CIEC_ANY *mValue; //!< value the worker uses for converting the raw data to text
+    };
+
+    //! File operations and the writing of the samples, run by the asynchronous workers
+    class CLogJob : public CAsyncJob{
+      public:
+        enum ECommand{
+          eOpen, eFlush, eClose
+        };
+
+        enum EFormat{
+          eCSV, eBinary
+        };
+
+        enum ESyncPolicy{
+          eSyncNever, eSyncOnClose, eSyncAlways
+        };
+
+        explicit CLogJob(CEventSourceFB &paOwner);
+
+        //! Does the work of the current command, used directly when the logger is deleted
+        void execute();
+
+        ECommand mCommand;
+        EFormat mFormat;
+        ESyncPolicy mSyncPolicy;
+        FILE *mFile;
+        CIEC_STRING mFileName;
+        unsigned int mFileIndex;
+        TForteUInt64 mFileSize;
+        uint_fast64_t mFileStartTime;
+        TForteUInt64 mRotateSize;
+        TForteUInt64 mRotateTime;
+        uint_fast64_t mStartTime; //!< time stamps are relative to the time the logger was opened
+
+        const SColumn *mColumns;
+        size_t mNumColumns;
+        const TForteByte *mRing;
+        TForteByte *mScratch; //!< space for one column of all ring samples, used for the columnar binary format
+        size_t mSampleSize;
+        size_t mCapacity;
+        size_t mFirstSample; //!< first sample to be written
+        size_t mNumSamples; //!< number of samples to be written
+
+        int mError; //!< errno of the failed operation, 0 if it succeeded
+
+      private:
+        virtual void run();
+
+        bool openFile();
+        bool closeFile();
+        bool rotateIfNeeded();
+        bool writeSamples();
+        bool writeCSVHeader();
+        bool writeCSVLines();
+        bool writeBinaryHeader();
+        bool writeBinaryBlock();
+        bool write(const void *paData, size_t paSize);
+        void sync();
+        const TForteByte *getSample(size_t paIndex) const;
+    };
+
+    void openLogger();
+    void closeLogger();
+    void logSample();
+
+    //! Submits the job with the given command, on failure QO and STATUS are set
+    bool startJob(CLogJob::ECommand paCommand);
+    //! Takes the results of the finished job and continues with pending work
+    void finishJob();
+    //! Applies the results of the last job to the outputs and the ring buffer
+    void takeJobResults();
+    //! Writes the unwritten samples if the ring is half full or the oldest sample waits for too long
+    void flushIfNeeded();
+
+    //! Registers the periodic check of the sample age at the timer handler
+    void startFlushTimer();
+    void stopFlushTimer();
+
+    void freeBuffers();
+    void setError(const char *paStatus);
+
+    CLogJob mLogJob;
+    SColumn *mColumns;
+    TForteByte *mRing;
+    size_t mRingStart; //!< oldest unwritten sample
+    size_t mRingCount;
+    bool mOpened;
+    bool mClosePending; //!< INIT- arrived while the samples were written
+    STimedFBListEntry mFlushTimer;
+    bool mFlushTimerActive;
+
+    static const char * const scmOK;
+    static const char * const scmAlreadyOpened;
+    static const char * const scmNotOpened;
+    static const char * const scmBusy;
+    static const char * const scmQueueFull;
+    static const char * const scmUnsupportedType;
+    static const char * const scmUnknownFormat;
+
+    static const TForteUInt32 scmDefaultSamples = 1024;
+    static const TForteUInt64 scmMaxSampleAge = 1000000000ULL; //!< nanoseconds a sample may wait for being written
+    static const TForteUInt64 scmFlushCheckInterval = 100000000ULL; //!< nanoseconds between two checks of the sample age
+};
+
+#endif //_GEN_DATA_LOGGER_H_
@@ -0,0 +1,169 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include "HISTORY.h"
+
+#ifdef FORTE_ENABLE_GENERATED_SOURCE_CPP
+#include "HISTORY_gen.cpp"
+#endif
+
+#include <device.h>
+#include <forte_any_int.h>
+#ifdef FORTE_USE_REAL_DATATYPE
+#include <forte_real.h>
+#endif
+#ifdef FORTE_USE_LREAL_DATATYPE
+#include <forte_lreal.h>
+#endif
+#include <forte_architecture_time.h>
+#include <devlog.h>
+
+DEFINE_FIRMWARE_FB(FORTE_HISTORY, g_nStringIdHISTORY)
+
+const CStringDictionary::TStringId FORTE_HISTORY::scm_anDataInputNames[] = { g_nStringIdQI, g_nStringIdNAME, g_nStringIdSAMPLES,
+  g_nStringIdFACTOR, g_nStringIdTIERS, g_nStringIdIN };
+const CStringDictionary::TStringId FORTE_HISTORY::scm_anDataInputTypeIds[] = { g_nStringIdBOOL, g_nStringIdSTRING, g_nStringIdUDINT,
+  g_nStringIdUINT, g_nStringIdUSINT, g_nStringIdANY };
+const CStringDictionary::TStringId FORTE_HISTORY::scm_anDataOutputNames[] = { g_nStringIdQO, g_nStringIdSTATUS };
+const CStringDictionary::TStringId FORTE_HISTORY::scm_anDataOutputTypeIds[] = { g_nStringIdBOOL, g_nStringIdSTRING };
+const TForteInt16 FORTE_HISTORY::scm_anEIWithIndexes[] = { 0, 6 };
+const TDataIOID FORTE_HISTORY::scm_anEIWith[] = { 0, 1, 2, 3, 4, 255, 0, 5, 255 };
+const CStringDictionary::TStringId FORTE_HISTORY::scm_anEventInputNames[] = { g_nStringIdINIT, g_nStringIdREQ };
+const TDataIOID FORTE_HISTORY::scm_anEOWith[] = { 0, 1, 255, 0, 1, 255 };
+const TForteInt16 FORTE_HISTORY::scm_anEOWithIndexes[] = { 0, 3, -1 };
+const CStringDictionary::TStringId FORTE_HISTORY::scm_anEventOutputNames[] = { g_nStringIdINITO, g_nStringIdCNF };
+const SFBInterfaceSpec FORTE_HISTORY::scm_stFBInterfaceSpec = { 2, scm_anEventInputNames, scm_anEIWith, scm_anEIWithIndexes, 2, scm_anEventOutputNames,
+  scm_anEOWith, scm_anEOWithIndexes, 6, scm_anDataInputNames, scm_anDataInputTypeIds, 2, scm_anDataOutputNames, scm_anDataOutputTypeIds, 0, 0 };
+
+const char * const FORTE_HISTORY::scmOK = "OK";
+const char * const FORTE_HISTORY::scmAlreadyInitialized = "History already initialized";
+const char * const FORTE_HISTORY::scmNotInitialized = "History not initialized";
+const char * const FORTE_HISTORY::scmNameInUse = "Signal name already in use";
+const char * const FORTE_HISTORY::scmMemoryLimit = "History memory limit of the device exceeded";
+const char * const FORTE_HISTORY::scmInvalidConfiguration = "Invalid history configuration";
+const char * const FORTE_HISTORY::scmNotNumeric = "IN is not numeric";
+
+FORTE_HISTORY::~FORTE_HISTORY(){
+  releaseBuffer();
+}
+
+void FORTE_HISTORY::executeEvent(int pa_nEIID){
+  switch(pa_nEIID){
+    case scm_nEventINITID:
+      if(QI()){
+        createBuffer();
+      } else {
+        releaseBuffer();
+        QO() = false;
+        STATUS() = scmOK;
+      }
+      sendOutputEvent(scm_nEventINITOID);
+      break;
+    case scm_nEventREQID:
+      if(QI()){
+        addValue();
+      } else {
+        QO() = false;
+      }
+      sendOutputEvent(scm_nEventCNFID);
+      break;
+    default:
+      break;
+  }
+}
+
+void FORTE_HISTORY::createBuffer(){
+  QO() = false;
+  if(0 != mBuffer){
+    STATUS() = scmAlreadyInitialized;
+    return;
+  }
+  CStringDictionary::TStringId name = ('\0' == NAME().getValue()[0]) ? getInstanceNameId() :
+      CStringDictionary::getInstance().insert(NAME().getValue());
+  size_t capacity = (0 != SAMPLES()) ? static_cast<size_t>(static_cast<TForteUInt32>(SAMPLES())) : scmDefaultSamples;
+  unsigned int factor = (0 != FACTOR()) ? static_cast<unsigned int>(static_cast<TForteUInt16>(FACTOR())) : scmDefaultFactor;
+  forte::core::CHistoryStore::EError error;
+  mBuffer = getHistoryStore().createBuffer(name, capacity, factor, static_cast<unsigned int>(static_cast<TForteUInt8>(TIERS())) + 1, error);
+  switch(error){
+    case forte::core::CHistoryStore::eOk:
+      QO() = true;
+      STATUS() = scmOK;
+      return;
+    case forte::core::CHistoryStore::eNameInUse:
+      STATUS() = scmNameInUse;
+      break;
+    case forte::core::CHistoryStore::eMemoryLimit:
+      STATUS() = scmMemoryLimit;
+      break;
+    default:
+      STATUS() = scmInvalidConfiguration;
+      break;
+  }
+  DEVLOG_ERROR("[HISTORY]: %s: %s\n", getInstanceName(), STATUS().getValue());
+}
+
+void FORTE_HISTORY::releaseBuffer(){
+  if(0 != mBuffer){
+    getHistoryStore().deleteBuffer(mBuffer);
+    mBuffer = 0;
+  }
+}
+
+void FORTE_HISTORY::addValue(){
+  QO() = false;
+  if(0 == mBuffer){
+    STATUS() = scmNotInitialized;
+    return;
+  }
+  double value;
+  if(!getNumericValue(IN(), value)){
+    STATUS() = scmNotNumeric;
+    return;
+  }
+  mBuffer->add(static_cast<TForteUInt64>(getNanoSecondsMonotonic()), value);
+  QO() = true;
+}
+
+forte::core::CHistoryStore &FORTE_HISTORY::getHistoryStore(){
+  return getResource().getDevice().getHistoryStore();
+}
+
+bool FORTE_HISTORY::getNumericValue(const CIEC_ANY &paValue, double &paNumeric){
+  switch(paValue.getDataTypeID()){
+    case CIEC_ANY::e_BOOL:
+      paNumeric = static_cast<const CIEC_BOOL&>(paValue) ? 1.0 : 0.0;
+      return true;
+    case CIEC_ANY::e_SINT:
+    case CIEC_ANY::e_INT:
+    case CIEC_ANY::e_DINT:
+    case CIEC_ANY::e_LINT:
+      paNumeric = static_cast<double>(static_cast<const CIEC_ANY_INT&>(paValue).getSignedValue());
+      return true;
+    case CIEC_ANY::e_USINT:
+    case CIEC_ANY::e_UINT:
+    case CIEC_ANY::e_UDINT:
+    case CIEC_ANY::e_ULINT:
+      paNumeric = static_cast<double>(static_cast<const CIEC_ANY_INT&>(paValue).getUnsignedValue());
+      return true;
+#ifdef FORTE_USE_REAL_DATATYPE
+    case CIEC_ANY::e_REAL:
+      paNumeric = static_cast<TForteFloat>(static_cast<const CIEC_REAL&>(paValue));
+      return true;
+#endif
+#ifdef FORTE_USE_LREAL_DATATYPE
+    case CIEC_ANY::e_LREAL:
+      paNumeric = static_cast<TForteDFloat>(static_cast<const CIEC_LREAL&>(paValue));
+      return true;
+#endif
+    default:
+      return false;
+  }
+}
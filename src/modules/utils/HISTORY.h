@@ -0,0 +1,118 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#ifndef _HISTORY_H_
+#define _HISTORY_H_
+
+#include <funcbloc.h>
+#include <forte_bool.h>
+#include <forte_string.h>
+#include <forte_udint.h>
+#include <forte_uint.h>
+#include <forte_usint.h>
+#include <forte_any.h>
+#include <historystore.h>
+
+/*!\brief Keeps the recent values of IN in the history store of the device
+ *
+ * INIT+ allocates the history buffer of the signal NAME, the instance name if NAME is empty. SAMPLES is the number of
+ * entries of each tier, FACTOR the number of entries of a tier summarized in one entry of the next tier and TIERS the
+ * number of downsampled tiers kept in addition to the raw samples. INIT- frees the buffer again.
+ *
+ * Every REQ adds the value of IN with the current time. IN may be of any elementary numeric type or BOOL. The history
+ * is read with the QUERY management command, see forte::core::CHistoryStore.
+ */
+class FORTE_HISTORY : public CFunctionBlock {
+  DECLARE_FIRMWARE_FB(FORTE_HISTORY)
+
+  public:
+    FUNCTION_BLOCK_CTOR(FORTE_HISTORY), mBuffer(0){
+    }
+
+    virtual ~FORTE_HISTORY();
+
+    //! Converts the value to a double, false if it is not of an elementary numeric type or BOOL
+    static bool getNumericValue(const CIEC_ANY &paValue, double &paNumeric);
+
+  private:
+    CIEC_BOOL &QI() {
+      return *static_cast<CIEC_BOOL*>(getDI(0));
+    }
+
+    CIEC_STRING &NAME() {
+      return *static_cast<CIEC_STRING*>(getDI(1));
+    }
+
+    CIEC_UDINT &SAMPLES() {
+      return *static_cast<CIEC_UDINT*>(getDI(2));
+    }
+
+    CIEC_UINT &FACTOR() {
+      return *static_cast<CIEC_UINT*>(getDI(3));
+    }
+
+    CIEC_USINT &TIERS() {
+      return *static_cast<CIEC_USINT*>(getDI(4));
+    }
+
+    CIEC_ANY &IN() {
+      return *static_cast<CIEC_ANY*>(getDI(5));
+    }
+
+    CIEC_BOOL &QO() {
+      return *static_cast<CIEC_BOOL*>(getDO(0));
+    }
+
+    CIEC_STRING &STATUS() {
+      return *static_cast<CIEC_STRING*>(getDO(1));
+    }
+
+    void executeEvent(int pa_nEIID);
+
+    void createBuffer();
+    void releaseBuffer();
+    void addValue();
+    forte::core::CHistoryStore &getHistoryStore();
+
+    forte::core::CHistoryBuffer *mBuffer;
+
+    static const CStringDictionary::TStringId scm_anDataInputNames[];
+    static const CStringDictionary::TStringId scm_anDataInputTypeIds[];
+    static const CStringDictionary::TStringId scm_anDataOutputNames[];
+    static const CStringDictionary::TStringId scm_anDataOutputTypeIds[];
+    static const TEventID scm_nEventINITID = 0;
+    static const TEventID scm_nEventREQID = 1;
+    static const TForteInt16 scm_anEIWithIndexes[];
+    static const TDataIOID scm_anEIWith[];
+    static const CStringDictionary::TStringId scm_anEventInputNames[];
+    static const TEventID scm_nEventINITOID = 0;
+    static const TEventID scm_nEventCNFID = 1;
+    static const TForteInt16 scm_anEOWithIndexes[];
+    static const TDataIOID scm_anEOWith[];
+    static const CStringDictionary::TStringId scm_anEventOutputNames[];
+
+    static const SFBInterfaceSpec scm_stFBInterfaceSpec;
+
+    static const char * const scmOK;
+    static const char * const scmAlreadyInitialized;
+    static const char * const scmNotInitialized;
+    static const char * const scmNameInUse;
+    static const char * const scmMemoryLimit;
+    static const char * const scmInvalidConfiguration;
+    static const char * const scmNotNumeric;
+
+    static const TForteUInt32 scmDefaultSamples = 1000;
+    static const TForteUInt16 scmDefaultFactor = 10;
+
+    FORTE_FB_DATA_ARRAY(2, 6, 2, 0);
+};
+
+#endif //_HISTORY_H_
@@ -28,11 +28,14 @@ const TDataIOID GEN_E_DEMUX::scm_anEIWith[] = { 0, 255 };
 const CStringDictionary::TStringId GEN_E_DEMUX::scm_anEventInputNames[] = { g_nStringIdEI };
 
 GEN_E_DEMUX::GEN_E_DEMUX(const CStringDictionary::TStringId paInstanceNameId, CResource *paSrcRes) :
-    CGenFunctionBlock<CFunctionBlock>(paSrcRes, paInstanceNameId), m_anEventOutputNames(0){
+    CGenFunctionBlock<CFunctionBlock>(paSrcRes, paInstanceNameId){
 }
 
 GEN_E_DEMUX::~GEN_E_DEMUX(){
-  delete[] m_anEventOutputNames;
+}
+
+void GEN_E_DEMUX::releaseInterfaceSpec(SFBInterfaceSpec &paInterfaceSpec){
+  delete[] paInterfaceSpec.m_aunEONames;
 }
 
 void GEN_E_DEMUX::executeEvent(int paEIID){
@@ -51,15 +54,15 @@ bool GEN_E_DEMUX::createInterfaceSpec(const char *paConfigString, SFBInterfaceSp
       paInterfaceSpec.m_nNumEOs = static_cast<TForteUInt8>(forte::core::util::strtoul(acPos, 0, 10));
 
       if(paInterfaceSpec.m_nNumEOs < CFunctionBlock::scm_nMaxInterfaceEvents){
-        m_anEventOutputNames = new CStringDictionary::TStringId[paInterfaceSpec.m_nNumEOs];
+        CStringDictionary::TStringId *eventOutputNames = new CStringDictionary::TStringId[paInterfaceSpec.m_nNumEOs];
 
-        generateGenericInterfacePointNameArray("EO", m_anEventOutputNames, paInterfaceSpec.m_nNumEOs);
+        generateGenericInterfacePointNameArray("EO", eventOutputNames, paInterfaceSpec.m_nNumEOs);
 
         paInterfaceSpec.m_nNumEIs = 1;
         paInterfaceSpec.m_aunEINames = scm_anEventInputNames;
         paInterfaceSpec.m_anEIWith = scm_anEIWith;
         paInterfaceSpec.m_anEIWithIndexes = scm_anEIWithIndexes;
-        paInterfaceSpec.m_aunEONames = m_anEventOutputNames;
+        paInterfaceSpec.m_aunEONames = eventOutputNames;
         paInterfaceSpec.m_anEOWith = 0;
         paInterfaceSpec.m_anEOWithIndexes = 0;
         paInterfaceSpec.m_nNumDIs = 1;
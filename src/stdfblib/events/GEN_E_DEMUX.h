@@ -28,11 +28,15 @@ class GEN_E_DEMUX : public CGenFunctionBlock<CFunctionBlock>{
     static const TDataIOID scm_anEIWith[];
     static const CStringDictionary::TStringId scm_anEventInputNames[];
 
-    CStringDictionary::TStringId *m_anEventOutputNames;
-
     virtual void executeEvent(int paEIID);
     virtual bool createInterfaceSpec(const char *paConfigString, SFBInterfaceSpec &paInterfaceSpec);
 
+    virtual CGenFBInterfaceSpecCache::TReleaseInterfaceSpecFunc getSharedInterfaceSpecReleaseFunc() const {
+      return releaseInterfaceSpec;
+    }
+
+    static void releaseInterfaceSpec(SFBInterfaceSpec &paInterfaceSpec);
+
     CIEC_UINT& K(){
       return *static_cast<CIEC_UINT*>(getDI(0));
     }
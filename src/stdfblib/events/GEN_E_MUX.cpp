@@ -28,11 +28,14 @@ const TDataIOID GEN_E_MUX::scm_anEOWith[] = { 0, 255 };
 const CStringDictionary::TStringId GEN_E_MUX::scm_anEventOutputNames[] = { g_nStringIdEO };
 
 GEN_E_MUX::GEN_E_MUX(const CStringDictionary::TStringId paInstanceNameId, CResource *paSrcRes) :
-    CGenFunctionBlock<CFunctionBlock>(paSrcRes, paInstanceNameId), m_anEventInputNames(0){
+    CGenFunctionBlock<CFunctionBlock>(paSrcRes, paInstanceNameId){
 }
 
 GEN_E_MUX::~GEN_E_MUX(){
-  delete[] m_anEventInputNames;
+}
+
+void GEN_E_MUX::releaseInterfaceSpec(SFBInterfaceSpec &paInterfaceSpec){
+  delete[] paInterfaceSpec.m_aunEINames;
 }
 
 void GEN_E_MUX::executeEvent(int paEIID){
@@ -52,11 +55,11 @@ bool GEN_E_MUX::createInterfaceSpec(const char *paConfigString, SFBInterfaceSpec
       paInterfaceSpec.m_nNumEIs = static_cast<TForteUInt8>(forte::core::util::strtoul(acPos, 0, 10));
 
       if(paInterfaceSpec.m_nNumEIs < CFunctionBlock::scm_nMaxInterfaceEvents && paInterfaceSpec.m_nNumEIs >= 2){
-        m_anEventInputNames = new CStringDictionary::TStringId[paInterfaceSpec.m_nNumEIs];
+        CStringDictionary::TStringId *eventInputNames = new CStringDictionary::TStringId[paInterfaceSpec.m_nNumEIs];
 
-        generateGenericInterfacePointNameArray("EI", m_anEventInputNames, paInterfaceSpec.m_nNumEIs);
+        generateGenericInterfacePointNameArray("EI", eventInputNames, paInterfaceSpec.m_nNumEIs);
 
-        paInterfaceSpec.m_aunEINames = m_anEventInputNames;
+        paInterfaceSpec.m_aunEINames = eventInputNames;
         paInterfaceSpec.m_anEIWith = 0;
         paInterfaceSpec.m_anEIWithIndexes = 0;
         paInterfaceSpec.m_nNumEOs = 1;
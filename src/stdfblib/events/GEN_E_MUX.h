@@ -28,11 +28,15 @@ class GEN_E_MUX : public CGenFunctionBlock<CFunctionBlock>{
     static const TDataIOID scm_anEOWith[];
     static const CStringDictionary::TStringId scm_anEventOutputNames[];
 
-    CStringDictionary::TStringId *m_anEventInputNames;
-
     virtual void executeEvent(int paEIID);
     virtual bool createInterfaceSpec(const char *paConfigString, SFBInterfaceSpec &paInterfaceSpec);
 
+    virtual CGenFBInterfaceSpecCache::TReleaseInterfaceSpecFunc getSharedInterfaceSpecReleaseFunc() const {
+      return releaseInterfaceSpec;
+    }
+
+    static void releaseInterfaceSpec(SFBInterfaceSpec &paInterfaceSpec);
+
     CIEC_UINT& K(){
       return *static_cast<CIEC_UINT*>(getDO(0));
     }
@@ -16,6 +16,9 @@
  *   Jens Reimann
  *    - Enhance bootfile loading behavior
  *    Alois Zoitl - introduced new CGenFB class for better handling generic FBs
+ *    agent - parse subscriptions for the monitoring stream
+ *    agent - paged responses of list queries
+ *    agent - query the history of signals
  *******************************************************************************/
 #include <string.h>
 #include "DEV_MGR.h"
@@ -27,6 +30,7 @@
 #include <stdlib.h>
 #include "ForteBootFileLoader.h"
 #include "../../core/utils/string_utils.h"
+#include <forte_udint.h>
 
 DEFINE_FIRMWARE_FB(DEV_MGR, g_nStringIdDEV_MGR)
 
@@ -86,11 +90,11 @@ void DEV_MGR::executeRQST(void){
   EMGMResponse resp = parseAndExecuteMGMCommand(DST().getValue(), RQST().getValue());
 
 #ifdef FORTE_SUPPORT_MONITORING
-  if (0 != mCommand.mMonitorResponse.length()) {
+  if ((cg_nMGM_CMD_Monitoring_Read_Watches == mCommand.mCMD) && !mCommand.mResponse.isEmpty()) {
     generateMonitorResponse(resp, mCommand);
   } else
 #endif //FORTE_SUPPORT_MONITORING
-  if(0 < mCommand.mAdditionalParams.length()){
+  if((0 < mCommand.mAdditionalParams.length()) || !mCommand.mResponse.isEmpty()){
     generateLongResponse(resp, mCommand);
   }
   else{
@@ -301,7 +305,7 @@ void DEV_MGR::parseCreateData(char *paRequestPartLeft, forte::core::SManagementC
 #ifdef FORTE_SUPPORT_MONITORING
         case 'W': // we have an Watch to Add
           if(parseMonitoringData(paRequestPartLeft, paCommand)){
-            paCommand.mCMD = cg_nMGM_CMD_Monitoring_Add_Watch;
+            paCommand.mCMD = parseSubscriptionData(paRequestPartLeft, paCommand) ? cg_nMGM_CMD_Monitoring_Subscribe : cg_nMGM_CMD_Monitoring_Add_Watch;
           }
           break;
 #endif //FORTE_SUPPORT_MONITORING
@@ -390,6 +394,7 @@ void DEV_MGR::parseWriteData(char *paRequestPartLeft, forte::core::SManagementCM
 void DEV_MGR::parseQueryData(char *paRequestPartLeft, forte::core::SManagementCMD &paCommand){
   paCommand.mCMD = cg_nMGM_CMD_INVALID;
   if(0 != paRequestPartLeft){
+    paCommand.mResponse.reset(parseCursor(paRequestPartLeft), scmMaxResponsePageSize);
     switch (paRequestPartLeft[0]){
       case 'F': // query fb or fb type list
         if(!strncmp(paRequestPartLeft, "FBT", sizeof("FBT") - 1)){
@@ -422,6 +427,11 @@ void DEV_MGR::parseQueryData(char *paRequestPartLeft, forte::core::SManagementCM
           }
         }
         break;
+      case 'H': // query the history of a signal
+        if(parseHistoryData(paRequestPartLeft, paCommand)){
+          paCommand.mCMD = cg_nMGM_CMD_QUERY_History;
+        }
+        break;
       case 'A': // query adaptertype list
         if(!strncmp(paRequestPartLeft, "AdapterT", sizeof("AdapterT") - 1)){
           if(parseTypeListData(paRequestPartLeft, paCommand)){
@@ -464,6 +474,49 @@ bool DEV_MGR::parseTypeListData(char *paRequestPartLeft, forte::core::SManagemen
   }
   return retVal;
 }
+
+bool DEV_MGR::parseHistoryData(char *paRequestPartLeft, forte::core::SManagementCMD &paCommand){
+  if(strncmp("History Name=\"", paRequestPartLeft, sizeof("History Name=\"") - 1)){
+    return false;
+  }
+  char *name = paRequestPartLeft + sizeof("History Name=\"") - 1;
+  char *nameEnd = strchr(name, '"');
+  if((0 == nameEnd) || (name == nameEnd)){
+    return false;
+  }
+  //signal names may contain dots, so the name is one identifier. An unknown name is not inserted into the dictionary,
+  //its invalid id is answered with NO_SUCH_OBJECT
+  *nameEnd = '\0';
+  bool retVal = paCommand.mFirstParam.pushBack(CStringDictionary::getInstance().getId(name));
+  *nameEnd = '"';
+
+  static const char * const scmAttributes[] = { " Tier=\"", " Start=\"", " End=\"", " Index=\"" };
+  const char *elementEnd = strchr(nameEnd, '>');
+  paCommand.mAdditionalParams.clear();
+  for(size_t i = 0; i < sizeof(scmAttributes) / sizeof(scmAttributes[0]); ++i){
+    if(0 != i){
+      paCommand.mAdditionalParams.append(";");
+    }
+    const char *value = strstr(nameEnd, scmAttributes[i]);
+    if((0 != value) && ((0 == elementEnd) || (value < elementEnd))){
+      value += strlen(scmAttributes[i]);
+      const char *valueEnd = strchr(value, '"');
+      if(0 != valueEnd){
+        paCommand.mAdditionalParams.append(value, static_cast<TForteUInt16>(valueEnd - value));
+      }
+    }
+  }
+  return retVal;
+}
+
+TForteUInt32 DEV_MGR::parseCursor(const char *paRequestPartLeft){
+  const char *elementEnd = strchr(paRequestPartLeft, '>');
+  const char *cursor = strstr(paRequestPartLeft, " Cursor=\"");
+  if((0 == cursor) || ((0 != elementEnd) && (cursor > elementEnd))){
+    return 0;
+  }
+  return static_cast<TForteUInt32>(strtoul(cursor + sizeof(" Cursor=\"") - 1, 0, 10));
+}
 #endif
 
 void DEV_MGR::generateResponse(const char *paID, EMGMResponse paResp){
@@ -483,12 +536,21 @@ void DEV_MGR::generateResponse(const char *paID, EMGMResponse paResp){
 
 void DEV_MGR::generateLongResponse(EMGMResponse paResp, forte::core::SManagementCMD &paCMD){
   RESP().clear();
-  RESP().reserve(static_cast<TForteUInt16>(255 + (paCMD.mAdditionalParams.length())));
+  size_t size = 255 + paCMD.mAdditionalParams.length() + paCMD.mResponse.length();
+  RESP().reserve(static_cast<TForteUInt16>((size < 65534) ? size : 65534));
   RESP().append("<Response ID=\"");
   if (0 != paCMD.mID) {
     RESP().append(paCMD.mID);
   }
   RESP().append("\"");
+  if(0 != paCMD.mResponse.getNextCursor()){
+    //the result did not fit into one response, the client requests the rest with this cursor
+    char cursor[11];
+    CIEC_UDINT(paCMD.mResponse.getNextCursor()).toString(cursor, sizeof(cursor));
+    RESP().append(" Cursor=\"");
+    RESP().append(cursor);
+    RESP().append("\"");
+  }
   if(e_RDY != paResp){
     RESP().append(" Reason=\"");
     RESP().append(scm_sMGMResponseTexts[paResp]);
@@ -507,11 +569,11 @@ void DEV_MGR::generateLongResponse(EMGMResponse paResp, forte::core::SManagement
     else if(paCMD.mCMD == cg_nMGM_CMD_QUERY_Connection){
       if ((paCMD.mFirstParam.isEmpty()) &&
           (paCMD.mSecondParam.isEmpty())) { //src & dst = *
-          RESP().append(paCMD.mAdditionalParams.getValue());
+          paCMD.mResponse.appendTo(RESP());
       }
       else { //either src or dst = * (both != * should be treated by generateResponse
         RESP().append("<EndpointList>\n    ");
-        RESP().append(paCMD.mAdditionalParams.getValue());
+        paCMD.mResponse.appendTo(RESP());
         RESP().append("\n  </EndpointList>");
       }
     }
@@ -519,25 +581,25 @@ void DEV_MGR::generateLongResponse(EMGMResponse paResp, forte::core::SManagement
       if(!paCMD.mFirstParam.isEmpty()) {  //Name != "*"
         if(!paCMD.mSecondParam.isEmpty()){ //Type != "*"
           RESP().append("<FBStatus Status=\"");
-          RESP().append(paCMD.mAdditionalParams.getValue());
+          paCMD.mResponse.appendTo(RESP());
           RESP().append("\" />");
         } else { //Type == "*"
           RESP().append("<FB Name=\"");
           appendIdentifierName(RESP(), paCMD.mFirstParam);
           RESP().append("\" Type=\"");
-          RESP().append(paCMD.mAdditionalParams.getValue());
+          paCMD.mResponse.appendTo(RESP());
           RESP().append("\" />");
         }
       }
       else{
         RESP().append("<FBList>\n    ");
-        RESP().append(paCMD.mAdditionalParams.getValue());
+        paCMD.mResponse.appendTo(RESP());
         RESP().append("\n  </FBList>");
       }
     }
     else if(paCMD.mCMD == cg_nMGM_CMD_QUERY_FBTypes || paCMD.mCMD == cg_nMGM_CMD_QUERY_AdapterTypes){
       RESP().append("<NameList>\n    ");
-      RESP().append(paCMD.mAdditionalParams.getValue());
+      paCMD.mResponse.appendTo(RESP());
       RESP().append("\n  </NameList>");
     }
     else if(paCMD.mCMD == cg_nMGM_CMD_QUERY_DTTypes){
@@ -550,6 +612,11 @@ void DEV_MGR::generateLongResponse(EMGMResponse paResp, forte::core::SManagement
       RESP().append(paCMD.mAdditionalParams.getValue());
       RESP().append("  </FBType>");
     }
+    else if(paCMD.mCMD == cg_nMGM_CMD_QUERY_History){
+      RESP().append("<History>");
+      paCMD.mResponse.appendTo(RESP());
+      RESP().append("</History>");
+    }
     else if(paCMD.mCMD == cg_nMGM_CMD_QUERY_AdapterType){
       RESP().append("<AdapterType Comment=\"generated\" ");
       RESP().append(paCMD.mAdditionalParams.getValue());
@@ -594,9 +661,7 @@ EMGMResponse DEV_MGR::parseAndExecuteMGMCommand(char *paDest, char *paCommand){
       mCommand.mAdditionalParams.reserve(255);
     }
     mCommand.mID=0;
-#ifdef FORTE_SUPPORT_MONITORING
-  mCommand.mMonitorResponse.clear();
-#endif // FORTE_SUPPORT_MONITORING
+    mCommand.mResponse.reset();
     char *acRequestPartLeft = parseRequest(paCommand, mCommand);
     if(0 != acRequestPartLeft){
       acRequestPartLeft = strchr(acRequestPartLeft, '<');
@@ -661,6 +726,31 @@ bool DEV_MGR::parseMonitoringData(char *paRequestPartLeft, forte::core::SManagem
   return bRetVal;
 }
 
+bool DEV_MGR::parseSubscriptionData(char *paRequestPartLeft, forte::core::SManagementCMD &paCommand){
+  const char *elementEnd = strchr(paRequestPartLeft, '>');
+  const char *period = strstr(paRequestPartLeft, " Period=\"");
+  if((0 == period) || ((0 != elementEnd) && (period > elementEnd))){
+    return false;
+  }
+  period += sizeof(" Period=\"") - 1;
+  const char *periodEnd = strchr(period, '"');
+  if(0 == periodEnd){
+    return false;
+  }
+  paCommand.mAdditionalParams.assign(period, static_cast<TForteUInt16>(periodEnd - period));
+
+  const char *deadband = strstr(periodEnd, " Deadband=\"");
+  if((0 != deadband) && ((0 == elementEnd) || (deadband < elementEnd))){
+    deadband += sizeof(" Deadband=\"") - 1;
+    const char *deadbandEnd = strchr(deadband, '"');
+    if(0 != deadbandEnd){
+      paCommand.mAdditionalParams.append(";");
+      paCommand.mAdditionalParams.append(deadband, static_cast<TForteUInt16>(deadbandEnd - deadband));
+    }
+  }
+  return true;
+}
+
 void DEV_MGR::generateMonitorResponse(EMGMResponse paResp, forte::core::SManagementCMD &paCMD){
   RESP().clear();
   if(e_RDY != paResp){
@@ -672,8 +762,8 @@ void DEV_MGR::generateMonitorResponse(EMGMResponse paResp, forte::core::SManagem
     RESP().append("\">\n  ");
     RESP().append("\n</Response>");
   }else{
-    TForteUInt16 size = static_cast<TForteUInt16>(paCMD.mMonitorResponse.length() + strlen(paCMD.mID) + 74);
-    RESP().reserve(size);
+    size_t size = paCMD.mResponse.length() + strlen(paCMD.mID) + 74;
+    RESP().reserve(static_cast<TForteUInt16>((size < 65534) ? size : 65534));
 
     RESP().clear();
     RESP().append("<Response ID=\"");
@@ -682,12 +772,11 @@ void DEV_MGR::generateMonitorResponse(EMGMResponse paResp, forte::core::SManagem
     RESP().append(">\n  ");
     if(paCMD.mCMD == cg_nMGM_CMD_Monitoring_Read_Watches) {
       RESP().append("<Watches>\n    ");
-      RESP().append(paCMD.mMonitorResponse.getValue());
+      paCMD.mResponse.appendTo(RESP());
       RESP().append("\n  </Watches>");
     }
     RESP().append("\n</Response>");
   }
-  paCMD.mMonitorResponse.clear();
 }
 
 #endif // FORTE_SUPPORT_MONITORING
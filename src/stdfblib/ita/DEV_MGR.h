@@ -10,6 +10,8 @@
  *   Alois Zoitl, Rene Smodic, Thomas Strasser, Gerhard Ebenhofer,
  *   Ingo Hegny
  *    - initial API and implementation and/or initial documentation
+ *   agent - paged responses of list queries
+ *   agent - query the history of signals
  *******************************************************************************/
 #ifndef _DEV_MGR_H_
 #define _DEV_MGR_H_
@@ -107,8 +109,25 @@ class DEV_MGR: public forte::com_infra::CCommFB, public IBootFileCallback {
     static void parseWriteData(char *paRequestPartLeft, forte::core::SManagementCMD &paCommand);
 
 #ifdef FORTE_SUPPORT_QUERY_CMD
+    /*!\brief Maximum length of the result of a list query sent in one response
+     *
+     * The response is sent as one STRING with a 16 bit length. The rest of the response element needs to fit too.
+     */
+    static const size_t scmMaxResponsePageSize = 60000;
+
     static void parseQueryData(char *paRequestPartLeft, forte::core::SManagementCMD &paCommand);
     static bool parseTypeListData(char *paRequestPartLeft, forte::core::SManagementCMD &paCommand);
+    /*!\brief Parse the optional Cursor attribute of a query, i.e., the index of the first entry to return
+     *
+     * \return the cursor or 0 if the query has none
+     */
+    static TForteUInt32 parseCursor(const char *paRequestPartLeft);
+    /*!\brief Parse a history query, i.e., <History Name="signal" Tier="1" Start="..." End="..." Index="..."/>
+     *
+     * The name is stored as one identifier in mFirstParam, tier, start, end and index separated by ';' in
+     * mAdditionalParams.
+     */
+    static bool parseHistoryData(char *paRequestPartLeft, forte::core::SManagementCMD &paCommand);
 #endif
 
 
@@ -126,6 +145,11 @@ class DEV_MGR: public forte::com_infra::CCommFB, public IBootFileCallback {
 
 #ifdef FORTE_SUPPORT_MONITORING
     static bool parseMonitoringData(char *paRequestPartLeft, forte::core::SManagementCMD &paCommand);
+    /*!\brief Parse the optional sampling period and deadband of a watch into the additional params
+     *
+     * \return true if the watch has a Period attribute and should be subscribed for the monitoring stream
+     */
+    static bool parseSubscriptionData(char *paRequestPartLeft, forte::core::SManagementCMD &paCommand);
     void generateMonitorResponse(EMGMResponse paResp, forte::core::SManagementCMD &paCMD);
 #endif //FORTE_SUPPORT_MONITORING
 
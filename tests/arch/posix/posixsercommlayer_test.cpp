@@ -0,0 +1,261 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include <boost/test/unit_test.hpp>
+
+#include "../../../src/arch/posix/posixsercommlayer.h"
+#include "../../../src/core/cominfra/commfb.h"
+#include "../../core/fbtests/fbtesterglobalfixture.h"
+#include <criticalregion.h>
+#include <forte_sem.h>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef FORTE_ENABLE_GENERATED_SOURCE_CPP
+#include "posixsercommlayer_test_gen.cpp"
+#endif
+
+using namespace forte::com_infra;
+
+namespace {
+  const TForteUInt64 scmWaitTime = 2000000000ULL;
+
+  const CStringDictionary::TStringId scmDataTypes[] = { g_nStringIdBOOL,
+#ifdef FORTE_USE_WSTRING_DATATYPE
+    g_nStringIdWSTRING
+#else
+    g_nStringIdSTRING
+#endif
+  };
+
+  /** Comm FB with only QI/ID and QO/STATUS, counts the external events it gets */
+  class CSerialTestCommFB : public CCommFB{
+    public:
+      CSerialTestCommFB() :
+          CCommFB(CStringDictionary::scm_nInvalidStringId, CFBTestDataGlobalFixture::getResource(), e_Subscriber),
+          mMockFBInterface(), mNrOfExternalEvents(0){
+        memset(&mMockFBInterface, 0, sizeof(mMockFBInterface));
+        mMockFBInterface.m_nNumDIs = 2;
+        mMockFBInterface.m_aunDIDataTypeNames = scmDataTypes;
+        mMockFBInterface.m_nNumDOs = 2;
+        mMockFBInterface.m_aunDODataTypeNames = scmDataTypes;
+
+        mFBConnData = new TForteByte[genFBConnDataSize(0, 2, 2)];
+        mFBVarsData = new TForteByte[genFBVarsDataSize(2, 2)];
+        setupFBInterface(&mMockFBInterface, mFBConnData, mFBVarsData);
+        //new FBs are killed, only running FBs get external events
+        changeFBExecutionState(cg_nMGM_CMD_Reset);
+        changeFBExecutionState(cg_nMGM_CMD_Start);
+      }
+
+      virtual ~CSerialTestCommFB(){
+        changeFBExecutionState(cg_nMGM_CMD_Stop);
+        freeAllData();
+        delete[] mFBConnData;
+        delete[] mFBVarsData;
+        m_pstInterfaceSpec = 0;
+      }
+
+      unsigned int getNrOfExternalEvents() const {
+        return mNrOfExternalEvents;
+      }
+
+    protected:
+      virtual void executeEvent(int paEIID){
+        CCommFB::executeEvent(paEIID);
+        //count after the event was processed so that waiting for the count ensures the layer is not used anymore
+        if(cg_nExternalEventID == paEIID){
+          ++mNrOfExternalEvents;
+        }
+      }
+
+    private:
+      SFBInterfaceSpec mMockFBInterface;
+      TForteByte *mFBConnData;
+      TForteByte *mFBVarsData;
+      unsigned int mNrOfExternalEvents;
+  };
+
+  /** Top layer keeping the received frames */
+  class CFrameRecorder : public CComLayer{
+    public:
+      explicit CFrameRecorder(CBaseCommFB *paFB) :
+          CComLayer(0, paFB), mExpectedFrames(0){
+      }
+
+      EComResponse sendData(void *paData, unsigned int paSize){
+        return m_poBottomLayer->sendData(paData, paSize);
+      }
+
+      EComResponse recvData(const void *paData, unsigned int paSize){
+        {
+          CCriticalRegion lock(mSync);
+          mFrames.push_back(std::string(static_cast<const char*>(paData), paSize));
+        }
+        mFrameSem.inc();
+        return e_ProcessDataOk;
+      }
+
+      //! Waits for the given number of further frames
+      bool waitForFrames(unsigned int paNrOfFrames){
+        mExpectedFrames += paNrOfFrames;
+        //the semaphore does not count, it only signals that there are new frames
+        while(getFrames().size() < mExpectedFrames){
+          if(!mFrameSem.timedWait(scmWaitTime)){
+            return false;
+          }
+        }
+        return true;
+      }
+
+      std::vector<std::string> getFrames(){
+        CCriticalRegion lock(mSync);
+        return mFrames;
+      }
+
+    private:
+      EComResponse openConnection(char *){
+        return e_InitOk;
+      }
+
+      void closeConnection(){
+      }
+
+      CSyncObject mSync;
+      forte::arch::CSemaphore mFrameSem;
+      std::vector<std::string> mFrames;
+      size_t mExpectedFrames;
+  };
+
+  /** Pseudo terminal pair, the layer uses the slave side as its serial line */
+  class CPseudoTerminal{
+    public:
+      CPseudoTerminal() :
+          mMaster(posix_openpt(O_RDWR | O_NOCTTY)){
+        if((0 <= mMaster) && (0 == grantpt(mMaster)) && (0 == unlockpt(mMaster))){
+          mSlaveName = ptsname(mMaster);
+        }
+      }
+
+      ~CPseudoTerminal(){
+        if(0 <= mMaster){
+          close(mMaster);
+        }
+      }
+
+      bool isValid() const {
+        return !mSlaveName.empty();
+      }
+
+      void write(const std::string &paBytes) const {
+        BOOST_REQUIRE_EQUAL(static_cast<ssize_t>(paBytes.size()), ::write(mMaster, paBytes.data(), paBytes.size()));
+      }
+
+      std::string read() const {
+        char buffer[64];
+        ssize_t size = ::read(mMaster, buffer, sizeof(buffer));
+        return std::string(buffer, (0 < size) ? static_cast<size_t>(size) : 0);
+      }
+
+      //! Layer parameters for the slave side
+      std::string getLayerParameters(const char *paFraming) const {
+        return mSlaveName + ",9600,8,1,NONE,$n" + paFraming;
+      }
+
+    private:
+      int mMaster;
+      std::string mSlaveName;
+  };
+
+  EComResponse openLayer(CComLayer &paLayer, const std::string &paParameters){
+    std::vector<char> parameters(paParameters.begin(), paParameters.end());
+    parameters.push_back('\0');
+    return paLayer.openConnection(&parameters[0]);
+  }
+
+  void waitForEvents(const CSerialTestCommFB &paFB, unsigned int paNrOfEvents){
+    for(unsigned int i = 0; (i < 200) && (paFB.getNrOfExternalEvents() < paNrOfEvents); ++i){
+      usleep(10000);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(PosixSerialComLayer)
+
+  BOOST_AUTO_TEST_CASE(oneFramePerEvent){
+    CPseudoTerminal terminal;
+    BOOST_REQUIRE(terminal.isValid());
+    CSerialTestCommFB commFB;
+    CFrameRecorder recorder(&commFB);
+    CComLayer &serialLayer = *new CPosixSerCommLayer(&recorder, &commFB); // deleted by the recorder
+    BOOST_REQUIRE_EQUAL(e_InitOk, openLayer(serialLayer, terminal.getLayerParameters(",LINE")));
+
+    //split across reads
+    terminal.write("fir");
+    usleep(50000);
+    terminal.write("st\nsec");
+    usleep(50000);
+    terminal.write("ond\n");
+    BOOST_REQUIRE(recorder.waitForFrames(2));
+
+    //several frames with one read
+    terminal.write("a\nb\nc\nd\nincomplete");
+    BOOST_REQUIRE(recorder.waitForFrames(4));
+    waitForEvents(commFB, 6);
+
+    std::vector<std::string> frames = recorder.getFrames();
+    BOOST_REQUIRE_EQUAL(6U, frames.size());
+    BOOST_CHECK_EQUAL("first", frames[0]);
+    BOOST_CHECK_EQUAL("second", frames[1]);
+    BOOST_CHECK_EQUAL("a", frames[2]);
+    BOOST_CHECK_EQUAL("d", frames[5]);
+    BOOST_CHECK_EQUAL(6U, commFB.getNrOfExternalEvents());
+
+    //sending is not affected by the framing
+    BOOST_CHECK_EQUAL(e_ProcessDataOk, recorder.sendData(const_cast<char*>("out"), 3));
+    BOOST_CHECK_EQUAL("out", terminal.read());
+  }
+
+  BOOST_AUTO_TEST_CASE(idleLineFraming){
+    CPseudoTerminal terminal;
+    BOOST_REQUIRE(terminal.isValid());
+    CSerialTestCommFB commFB;
+    CFrameRecorder recorder(&commFB);
+    CComLayer &serialLayer = *new CPosixSerCommLayer(&recorder, &commFB); // deleted by the recorder
+    BOOST_REQUIRE_EQUAL(e_InitOk, openLayer(serialLayer, terminal.getLayerParameters(",RTU")));
+
+    terminal.write(std::string("\x01\x03\x00\x10", 4));
+    BOOST_REQUIRE(recorder.waitForFrames(1));
+    terminal.write(std::string("\x01\x06", 2));
+    BOOST_REQUIRE(recorder.waitForFrames(1));
+    waitForEvents(commFB, 2);
+
+    std::vector<std::string> frames = recorder.getFrames();
+    BOOST_REQUIRE_EQUAL(2U, frames.size());
+    BOOST_CHECK_EQUAL(std::string("\x01\x03\x00\x10", 4), frames[0]);
+    BOOST_CHECK_EQUAL(std::string("\x01\x06", 2), frames[1]);
+    BOOST_CHECK_EQUAL(2U, commFB.getNrOfExternalEvents());
+  }
+
+  BOOST_AUTO_TEST_CASE(invalidFraming){
+    CPseudoTerminal terminal;
+    BOOST_REQUIRE(terminal.isValid());
+    CSerialTestCommFB commFB;
+    CFrameRecorder recorder(&commFB);
+    CComLayer &serialLayer = *new CPosixSerCommLayer(&recorder, &commFB); // deleted by the recorder
+    BOOST_CHECK_EQUAL(e_InitInvalidId, openLayer(serialLayer, terminal.getLayerParameters(",HDLC")));
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,213 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include <boost/test/unit_test.hpp>
+
+#include "fbtests/fbtesterglobalfixture.h"
+#include <asyncworker.h>
+#include <esfb.h>
+#include <resource.h>
+#include <extevhandlerhelper.h>
+#include <vector>
+
+#ifdef FORTE_ENABLE_GENERATED_SOURCE_CPP
+#include "asyncworkertest_gen.cpp"
+#endif
+
+namespace {
+  const SFBInterfaceSpec scmEmptyInterface = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+  //! Job sleeping for the given time, all jobs wait while they are blocked
+  class CTestJob : public CAsyncJob{
+    public:
+      CTestJob(CEventSourceFB &paOwner, unsigned int paDuration) :
+          CAsyncJob(paOwner), mDuration(paDuration), mRuns(0){
+      }
+
+      unsigned int getRuns() const {
+        return mRuns;
+      }
+
+      static volatile bool smBlocked;
+
+    private:
+      virtual void run(){
+        while(smBlocked){
+          CThread::sleepThread(1);
+        }
+        CThread::sleepThread(mDuration);
+        ++mRuns;
+      }
+
+      unsigned int mDuration;
+      volatile unsigned int mRuns;
+  };
+
+  volatile bool CTestJob::smBlocked = false;
+
+  //! Unblocks the jobs also when a test fails, so that the owner can retract its jobs
+  struct SBlockJobs{
+      SBlockJobs(){
+        CTestJob::smBlocked = true;
+      }
+
+      ~SBlockJobs(){
+        CTestJob::smBlocked = false;
+      }
+  };
+
+  /** Event source FB counting the completion events and releasing the done jobs */
+  class CJobOwnerFB : public CEventSourceFB{
+    public:
+      CJobOwnerFB() :
+          CEventSourceFB(CFBTestDataGlobalFixture::getResource(), &scmEmptyInterface, CStringDictionary::scm_nInvalidStringId,
+              m_anFBConnData, m_anFBVarsData), mNrOfEvents(0){
+        setEventChainExecutor(CFBTestDataGlobalFixture::getResource()->getResourceEventExecution());
+        changeFBExecutionState(cg_nMGM_CMD_Reset);
+        changeFBExecutionState(cg_nMGM_CMD_Start);
+      }
+
+      virtual ~CJobOwnerFB(){
+        for(size_t i = 0; i < mJobs.size(); ++i){
+          getHandler().retract(*mJobs[i]);
+          delete mJobs[i];
+        }
+        changeFBExecutionState(cg_nMGM_CMD_Stop);
+      }
+
+      CStringDictionary::TStringId getFBTypeId(void) const {
+        return CStringDictionary::scm_nInvalidStringId;
+      }
+
+      CTestJob &addJob(unsigned int paDuration){
+        mJobs.push_back(new CTestJob(*this, paDuration));
+        return *mJobs.back();
+      }
+
+      CAsyncWorkerHandler &getHandler(){
+        return getExtEvHandler<CAsyncWorkerHandler>(*this);
+      }
+
+      unsigned int getNrOfEvents() const {
+        return mNrOfEvents;
+      }
+
+      void waitForEvents(unsigned int paNrOfEvents) const {
+        for(unsigned int i = 0; (i < 2000) && (mNrOfEvents < paNrOfEvents); ++i){
+          CThread::sleepThread(1);
+        }
+      }
+
+    private:
+      virtual void executeEvent(int paEIID){
+        if(cg_nExternalEventID == paEIID){
+          for(size_t i = 0; i < mJobs.size(); ++i){
+            mJobs[i]->release();
+          }
+          ++mNrOfEvents;
+        }
+      }
+
+      std::vector<CTestJob *> mJobs;
+      volatile unsigned int mNrOfEvents;
+
+      FORTE_FB_DATA_ARRAY(0, 0, 0, 0)
+  };
+
+  void waitForState(const CAsyncJob &paJob, CAsyncJob::EState paState){
+    for(unsigned int i = 0; (i < 2000) && (paState != paJob.getState()); ++i){
+      CThread::sleepThread(1);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(AsyncWorker)
+
+  BOOST_AUTO_TEST_CASE(completionIsSignaledAsExternalEvent){
+    CJobOwnerFB owner;
+    CTestJob &job = owner.addJob(20);
+    CAsyncWorkerHandler::SStatistics before;
+    owner.getHandler().getStatistics(before);
+
+    BOOST_REQUIRE(owner.getHandler().submit(job));
+    //a job can only be submitted once at a time
+    BOOST_CHECK(!owner.getHandler().submit(job));
+    owner.waitForEvents(1);
+    BOOST_CHECK_EQUAL(1U, owner.getNrOfEvents());
+    BOOST_CHECK_EQUAL(1U, job.getRuns());
+    BOOST_CHECK_EQUAL(CAsyncJob::eIdle, job.getState());
+    BOOST_CHECK(job.getRunTime() >= 15000000ULL);
+
+    CAsyncWorkerHandler::SStatistics after;
+    owner.getHandler().getStatistics(after);
+    BOOST_CHECK_EQUAL(before.mSubmitted + 1, after.mSubmitted);
+    BOOST_CHECK_EQUAL(before.mRejected + 1, after.mRejected);
+    BOOST_CHECK_EQUAL(before.mCompleted + 1, after.mCompleted);
+    BOOST_CHECK(after.mMaxRunTime >= job.getRunTime());
+    BOOST_CHECK(after.mTotalRunTime - before.mTotalRunTime >= job.getRunTime());
+
+    //released jobs can be submitted again
+    BOOST_REQUIRE(owner.getHandler().submit(job));
+    owner.waitForEvents(2);
+    BOOST_CHECK_EQUAL(2U, job.getRuns());
+  }
+
+  BOOST_AUTO_TEST_CASE(fullQueueRejectsJobs){
+    CJobOwnerFB owner;
+    CAsyncWorkerHandler &handler = owner.getHandler();
+    SBlockJobs blockJobs;
+
+    std::vector<CTestJob *> jobs;
+    for(unsigned int i = 0; i < CAsyncWorkerHandler::scmNumberOfWorkers; ++i){
+      jobs.push_back(&owner.addJob(0));
+      BOOST_REQUIRE(handler.submit(*jobs.back()));
+      waitForState(*jobs.back(), CAsyncJob::eRunning);
+    }
+    for(unsigned int i = 0; i < CAsyncWorkerHandler::scmQueueSize; ++i){
+      jobs.push_back(&owner.addJob(0));
+      BOOST_REQUIRE(handler.submit(*jobs.back()));
+    }
+    CTestJob &rejected = owner.addJob(0);
+    BOOST_CHECK(!handler.submit(rejected));
+
+    //a retracted job frees its place in the queue
+    CTestJob &retracted = *jobs.back();
+    BOOST_CHECK_EQUAL(CAsyncJob::eQueued, retracted.getState());
+    handler.retract(retracted);
+    BOOST_CHECK_EQUAL(CAsyncJob::eIdle, retracted.getState());
+    BOOST_CHECK(handler.submit(rejected));
+
+    CTestJob::smBlocked = false;
+    //the burst of completion events may exceed the external event queue of the resource, so wait for the jobs
+    waitForState(rejected, CAsyncJob::eIdle);
+    for(size_t i = 0; i < jobs.size(); ++i){
+      waitForState(*jobs[i], CAsyncJob::eIdle);
+      BOOST_CHECK_EQUAL((&retracted == jobs[i]) ? 0U : 1U, jobs[i]->getRuns());
+    }
+    BOOST_CHECK_EQUAL(1U, rejected.getRuns());
+    BOOST_CHECK(0 != owner.getNrOfEvents());
+  }
+
+  BOOST_AUTO_TEST_CASE(retractWaitsForRunningJob){
+    CJobOwnerFB owner;
+    CTestJob &job = owner.addJob(50);
+    BOOST_REQUIRE(owner.getHandler().submit(job));
+    waitForState(job, CAsyncJob::eRunning);
+
+    owner.getHandler().retract(job);
+    BOOST_CHECK_EQUAL(1U, job.getRuns());
+    BOOST_CHECK_EQUAL(CAsyncJob::eIdle, job.getState());
+    //the owner does not get the completion event of a retracted job
+    CThread::sleepThread(20);
+    BOOST_CHECK_EQUAL(0U, owner.getNrOfEvents());
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
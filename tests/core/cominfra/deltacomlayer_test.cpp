@@ -0,0 +1,270 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include <boost/test/unit_test.hpp>
+
+#include "../../../src/core/cominfra/deltacomlayer.h"
+#include "../../../src/core/cominfra/fbdkasn1layer.h"
+#include "../../../src/core/cominfra/commfb.h"
+#include "../../../src/stdfblib/ita/EMB_RES.h"
+#include "../../../src/core/datatypes/forte_bool.h"
+#include "../../../src/core/datatypes/forte_dint.h"
+#include "../../../src/core/datatypes/forte_uint.h"
+#include "../../../src/core/datatypes/forte_word.h"
+#include "../../../src/core/datatypes/forte_string.h"
+#include <string.h>
+#include <time.h>
+#include <vector>
+
+#ifdef FORTE_ENABLE_GENERATED_SOURCE_CPP
+#include "deltacomlayer_test_gen.cpp"
+#endif
+
+using namespace forte::com_infra;
+
+namespace {
+  const unsigned int scmNrOfDataPoints = 20;
+  const unsigned int scmNrOfCycles = 1000;
+
+  const CStringDictionary::TStringId scmDataTypes[] = { g_nStringIdBOOL, g_nStringIdBOOL, //QO, STATUS
+    g_nStringIdDINT, g_nStringIdDINT, g_nStringIdDINT, g_nStringIdDINT, g_nStringIdDINT, g_nStringIdUINT, g_nStringIdUINT,
+    g_nStringIdUINT, g_nStringIdUINT, g_nStringIdUINT, g_nStringIdWORD, g_nStringIdWORD, g_nStringIdWORD, g_nStringIdWORD,
+    g_nStringIdBOOL, g_nStringIdBOOL, g_nStringIdBOOL, g_nStringIdBOOL, g_nStringIdSTRING, g_nStringIdSTRING };
+
+  /** Comm FB providing data points of the types above, its RDs are used as send data as well */
+  class CDeltaTestMockCommFB : public CCommFB{
+    public:
+      CDeltaTestMockCommFB() :
+          CCommFB(CStringDictionary::scm_nInvalidStringId, &smResource, e_Subscriber), mMockFBInterface(){
+        memset(&mMockFBInterface, 0, sizeof(mMockFBInterface));
+        mMockFBInterface.m_nNumDIs = 2;
+        mMockFBInterface.m_aunDIDataTypeNames = scmDataTypes;
+        mMockFBInterface.m_nNumDOs = static_cast<TForteUInt8>(scmNrOfDataPoints + 2U);
+        mMockFBInterface.m_aunDODataTypeNames = scmDataTypes;
+
+        mFBConnData = new TForteByte[genFBConnDataSize(0, 2, scmNrOfDataPoints + 2)];
+        mFBVarsData = new TForteByte[genFBVarsDataSize(2, scmNrOfDataPoints + 2)];
+        setupFBInterface(&mMockFBInterface, mFBConnData, mFBVarsData);
+      }
+
+      virtual ~CDeltaTestMockCommFB(){
+        freeAllData();
+        delete[] mFBConnData;
+        delete[] mFBVarsData;
+        m_pstInterfaceSpec = 0;
+      }
+
+    private:
+      static EMB_RES smResource;
+
+      SFBInterfaceSpec mMockFBInterface;
+      TForteByte *mFBConnData;
+      TForteByte *mFBVarsData;
+  };
+
+  EMB_RES CDeltaTestMockCommFB::smResource(CStringDictionary::scm_nInvalidStringId, 0);
+
+  /** Keeps every message sent through it */
+  class CRecordingLayer : public CComLayer{
+    public:
+      CRecordingLayer() :
+          CComLayer(0, 0), mSentBytes(0){
+      }
+
+      EComResponse sendData(void *paData, unsigned int paSize){
+        const TForteByte *data = static_cast<const TForteByte*>(paData);
+        mMessages.push_back(std::vector<TForteByte>(data, data + paSize));
+        mSentBytes += paSize;
+        return e_ProcessDataOk;
+      }
+
+      EComResponse recvData(const void *, unsigned int){
+        return e_ProcessDataOk;
+      }
+
+      EComResponse openConnection(char *){
+        return e_InitOk;
+      }
+
+      void closeConnection(){
+      }
+
+      std::vector<std::vector<TForteByte> > mMessages;
+      unsigned long mSentBytes;
+  };
+
+  /** Changes one or two values each cycle, like a typical process image published periodically */
+  void changeValues(CIEC_ANY *paData, unsigned int paCycle){
+    static_cast<CIEC_DINT&>(paData[paCycle % 5]) = static_cast<TForteInt32>(paCycle);
+    if(0 == (paCycle % 3)){
+      static_cast<CIEC_BOOL&>(paData[14 + (paCycle % 4)]) = !static_cast<CIEC_BOOL&>(paData[14 + (paCycle % 4)]);
+    }
+  }
+
+  void initValues(CIEC_ANY *paData){
+    for(unsigned int i = 0; i < 5; ++i){
+      static_cast<CIEC_DINT&>(paData[i]) = static_cast<TForteInt32>(1000 * i);
+    }
+    for(unsigned int i = 5; i < 10; ++i){
+      static_cast<CIEC_UINT&>(paData[i]) = static_cast<TForteUInt16>(i);
+    }
+    for(unsigned int i = 10; i < 14; ++i){
+      static_cast<CIEC_WORD&>(paData[i]) = static_cast<TForteWord>(0x100 * i);
+    }
+    static_cast<CIEC_STRING&>(paData[18]) = "temperature sensor";
+    static_cast<CIEC_STRING&>(paData[19]) = "line 4";
+  }
+
+  bool haveSameValues(const CIEC_ANY *paFirst, const CIEC_ANY *paSecond){
+    TForteByte first[64];
+    TForteByte second[64];
+    for(unsigned int i = 0; i < scmNrOfDataPoints; ++i){
+      int firstSize = CFBDKASN1ComLayer::serializeDataPoint(first, sizeof(first), paFirst[i]);
+      int secondSize = CFBDKASN1ComLayer::serializeDataPoint(second, sizeof(second), paSecond[i]);
+      if((firstSize != secondSize) || (0 != memcmp(first, second, static_cast<size_t>(firstSize)))){
+        return false;
+      }
+    }
+    return true;
+  }
+
+  TForteUInt64 getNanoSeconds(){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<TForteUInt64>(now.tv_sec) * 1000000000ULL + static_cast<TForteUInt64>(now.tv_nsec);
+  }
+
+  EComResponse openLayer(CComLayer &paLayer, const char *paParameter){
+    char parameter[16];
+    strcpy(parameter, paParameter);
+    return paLayer.openConnection(parameter);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(DeltaComLayer)
+
+  BOOST_AUTO_TEST_CASE(receiverReconstructsAllRDs){
+    CDeltaTestMockCommFB sender;
+    CDeltaTestMockCommFB receiver;
+    CRecordingLayer &bottom = *new CRecordingLayer(); // deleted by the layer above it
+    CDeltaComLayer sendLayer(0, 0);
+    CDeltaComLayer recvLayer(0, &receiver);
+    sendLayer.setBottomLayer(&bottom);
+    BOOST_REQUIRE_EQUAL(e_InitOk, openLayer(sendLayer, "5"));
+    BOOST_REQUIRE_EQUAL(e_InitOk, openLayer(recvLayer, "5"));
+
+    initValues(sender.getRDs());
+    bool allEqual = true;
+    for(unsigned int cycle = 0; cycle < 50; ++cycle){
+      changeValues(sender.getRDs(), cycle);
+      BOOST_CHECK_EQUAL(e_ProcessDataOk, sendLayer.sendData(sender.getRDs(), scmNrOfDataPoints));
+      const std::vector<TForteByte> &message = bottom.mMessages.back();
+      BOOST_CHECK_EQUAL((0 == (cycle % 5)) ? CDeltaComLayer::e_KeyFrame : 0, message[0] & CDeltaComLayer::e_KeyFrame);
+      BOOST_CHECK_EQUAL(e_ProcessDataOk, recvLayer.recvData(&message[0], static_cast<unsigned int>(message.size())));
+      allEqual = allEqual && haveSameValues(sender.getRDs(), receiver.getRDs());
+    }
+    BOOST_CHECK(allEqual);
+    BOOST_CHECK_EQUAL(0U, recvLayer.getNrOfLostMessages());
+  }
+
+  BOOST_AUTO_TEST_CASE(unchangedDataSendsEmptyBitmap){
+    CDeltaTestMockCommFB sender;
+    CRecordingLayer &bottom = *new CRecordingLayer(); // deleted by the layer above it
+    CDeltaComLayer sendLayer(0, 0);
+    sendLayer.setBottomLayer(&bottom);
+    BOOST_REQUIRE_EQUAL(e_InitOk, openLayer(sendLayer, ""));
+
+    initValues(sender.getRDs());
+    sendLayer.sendData(sender.getRDs(), scmNrOfDataPoints);
+    sendLayer.sendData(sender.getRDs(), scmNrOfDataPoints);
+    const std::vector<TForteByte> &message = bottom.mMessages.back();
+    BOOST_CHECK_EQUAL(CDeltaComLayer::scmHeaderSize + (scmNrOfDataPoints + 7) / 8, message.size());
+    BOOST_CHECK_EQUAL(0, message[0]);
+    BOOST_CHECK_EQUAL(1, message[2]);
+  }
+
+  BOOST_AUTO_TEST_CASE(lostMessageResynchronizesOnKeyFrame){
+    CDeltaTestMockCommFB sender;
+    CDeltaTestMockCommFB receiver;
+    CRecordingLayer &bottom = *new CRecordingLayer(); // deleted by the layer above it
+    CDeltaComLayer sendLayer(0, 0);
+    CDeltaComLayer recvLayer(0, &receiver);
+    sendLayer.setBottomLayer(&bottom);
+    BOOST_REQUIRE_EQUAL(e_InitOk, openLayer(sendLayer, "4"));
+    BOOST_REQUIRE_EQUAL(e_InitOk, openLayer(recvLayer, ""));
+
+    initValues(sender.getRDs());
+    std::vector<EComResponse> responses;
+    for(unsigned int cycle = 0; cycle < 9; ++cycle){
+      changeValues(sender.getRDs(), cycle);
+      sendLayer.sendData(sender.getRDs(), scmNrOfDataPoints);
+      if(1 != cycle){
+        const std::vector<TForteByte> &message = bottom.mMessages.back();
+        responses.push_back(recvLayer.recvData(&message[0], static_cast<unsigned int>(message.size())));
+      }
+    }
+
+    // cycle 1 got lost, the deltas 2 and 3 are dropped, 4 is a key frame
+    BOOST_CHECK_EQUAL(e_ProcessDataOk, responses[0]);
+    BOOST_CHECK_EQUAL(e_Nothing, responses[1]);
+    BOOST_CHECK_EQUAL(e_Nothing, responses[2]);
+    for(size_t i = 3; i < responses.size(); ++i){
+      BOOST_CHECK_EQUAL(e_ProcessDataOk, responses[i]);
+    }
+    BOOST_CHECK_EQUAL(1U, recvLayer.getNrOfLostMessages());
+    BOOST_CHECK_EQUAL(2U, recvLayer.getNrOfDroppedMessages());
+    BOOST_CHECK(haveSameValues(sender.getRDs(), receiver.getRDs()));
+  }
+
+  BOOST_AUTO_TEST_CASE(invalidUse){
+    CDeltaTestMockCommFB receiver;
+    CDeltaComLayer recvLayer(0, &receiver);
+    BOOST_CHECK_EQUAL(e_InitInvalidId, openLayer(recvLayer, "0"));
+    BOOST_REQUIRE_EQUAL(e_InitOk, openLayer(recvLayer, ""));
+
+    const TForteByte tooShort[] = { CDeltaComLayer::e_KeyFrame, 0 };
+    BOOST_CHECK_EQUAL(e_ProcessDataDataTypeError, recvLayer.recvData(tooShort, sizeof(tooShort)));
+    const TForteByte truncatedKeyFrame[] = { CDeltaComLayer::e_KeyFrame, 0, 0, 0x44, 0 };
+    BOOST_CHECK_EQUAL(e_ProcessDataDataTypeError, recvLayer.recvData(truncatedKeyFrame, sizeof(truncatedKeyFrame)));
+    CDeltaComLayer sendLayer(0, 0);
+    BOOST_CHECK_EQUAL(e_ProcessDataNoSocket, sendLayer.sendData(receiver.getRDs(), scmNrOfDataPoints));
+  }
+
+  BOOST_AUTO_TEST_CASE(compareToFullEncoding){
+    CDeltaTestMockCommFB sender;
+    CRecordingLayer &deltaBottom = *new CRecordingLayer(); // deleted by the layers above them
+    CRecordingLayer &fullBottom = *new CRecordingLayer();
+    CDeltaComLayer deltaLayer(0, 0);
+    CFBDKASN1ComLayer fullLayer(0, 0);
+    deltaLayer.setBottomLayer(&deltaBottom);
+    fullLayer.setBottomLayer(&fullBottom);
+    BOOST_REQUIRE_EQUAL(e_InitOk, openLayer(deltaLayer, ""));
+
+    initValues(sender.getRDs());
+    TForteUInt64 deltaTime = 0;
+    TForteUInt64 fullTime = 0;
+    for(unsigned int cycle = 0; cycle < scmNrOfCycles; ++cycle){
+      changeValues(sender.getRDs(), cycle);
+      TForteUInt64 start = getNanoSeconds();
+      deltaLayer.sendData(sender.getRDs(), scmNrOfDataPoints);
+      TForteUInt64 middle = getNanoSeconds();
+      fullLayer.sendData(sender.getRDs(), scmNrOfDataPoints);
+      fullTime += getNanoSeconds() - middle;
+      deltaTime += middle - start;
+    }
+
+    BOOST_CHECK(deltaBottom.mSentBytes < fullBottom.mSentBytes / 3);
+    BOOST_TEST_MESSAGE("20 data points, 1-2 changed per message: delta " << deltaBottom.mSentBytes / scmNrOfCycles
+      << " bytes/message, " << deltaTime / scmNrOfCycles << " ns encoding; fbdk " << fullBottom.mSentBytes / scmNrOfCycles
+      << " bytes/message, " << fullTime / scmNrOfCycles << " ns encoding");
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
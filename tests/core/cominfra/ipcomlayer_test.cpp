@@ -0,0 +1,200 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include <boost/test/unit_test.hpp>
+
+#include "../../../src/core/cominfra/ipcomlayer.h"
+#include "../../../src/core/cominfra/commfb.h"
+#include "../fbtests/fbtesterglobalfixture.h"
+#include <criticalregion.h>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+
+#ifdef FORTE_ENABLE_GENERATED_SOURCE_CPP
+#include "ipcomlayer_test_gen.cpp"
+#endif
+
+using namespace forte::com_infra;
+
+namespace {
+  const unsigned short scmSubscriberPort = 15612;
+
+  const CStringDictionary::TStringId scmDataTypes[] = { g_nStringIdBOOL,
+#ifdef FORTE_USE_WSTRING_DATATYPE
+    g_nStringIdWSTRING
+#else
+    g_nStringIdSTRING
+#endif
+  };
+
+  /** Subscriber with only QI/ID and QO/STATUS, counts its external events and the indications it sends */
+  class CUDPTestCommFB : public CCommFB{
+    public:
+      CUDPTestCommFB() :
+          CCommFB(CStringDictionary::scm_nInvalidStringId, CFBTestDataGlobalFixture::getResource(), e_Subscriber),
+          mMockFBInterface(), mNrOfExternalEvents(0), mNrOfIndications(0){
+        memset(&mMockFBInterface, 0, sizeof(mMockFBInterface));
+        mMockFBInterface.m_nNumDIs = 2;
+        mMockFBInterface.m_aunDIDataTypeNames = scmDataTypes;
+        mMockFBInterface.m_nNumDOs = 2;
+        mMockFBInterface.m_aunDODataTypeNames = scmDataTypes;
+
+        mFBConnData = new TForteByte[genFBConnDataSize(0, 2, 2)];
+        mFBVarsData = new TForteByte[genFBVarsDataSize(2, 2)];
+        setupFBInterface(&mMockFBInterface, mFBConnData, mFBVarsData);
+        //new FBs are killed, only running FBs get external events
+        changeFBExecutionState(cg_nMGM_CMD_Reset);
+        changeFBExecutionState(cg_nMGM_CMD_Start);
+      }
+
+      virtual ~CUDPTestCommFB(){
+        changeFBExecutionState(cg_nMGM_CMD_Stop);
+        freeAllData();
+        delete[] mFBConnData;
+        delete[] mFBVarsData;
+        m_pstInterfaceSpec = 0;
+      }
+
+      unsigned int getNrOfExternalEvents() const {
+        return mNrOfExternalEvents;
+      }
+
+      unsigned int getNrOfIndications() const {
+        return mNrOfIndications;
+      }
+
+    protected:
+      virtual void executeEvent(int paEIID){
+        if(cg_nExternalEventID == paEIID){
+          ++mNrOfExternalEvents;
+          //the status is only written if the event results in an indication
+          STATUS() = "";
+          CCommFB::executeEvent(paEIID);
+          if(!STATUS().empty()){
+            ++mNrOfIndications;
+          }
+        }
+        else{
+          CCommFB::executeEvent(paEIID);
+        }
+      }
+
+    private:
+      SFBInterfaceSpec mMockFBInterface;
+      TForteByte *mFBConnData;
+      TForteByte *mFBVarsData;
+      unsigned int mNrOfExternalEvents;
+      unsigned int mNrOfIndications;
+  };
+
+  /** Top layer keeping the received datagrams together with the external event they were delivered in */
+  class CDatagramRecorder : public CComLayer{
+    public:
+      explicit CDatagramRecorder(CUDPTestCommFB *paFB) :
+          CComLayer(0, paFB), mFB(paFB){
+      }
+
+      EComResponse sendData(void *, unsigned int){
+        return e_ProcessDataSendFailed;
+      }
+
+      EComResponse recvData(const void *paData, unsigned int paSize){
+        CCriticalRegion lock(mSync);
+        TForteUInt32 value = 0;
+        if(sizeof(value) == paSize){
+          memcpy(&value, paData, sizeof(value));
+        }
+        mValues.push_back(value);
+        mEvents.push_back(mFB->getNrOfExternalEvents());
+        return e_ProcessDataOk;
+      }
+
+      size_t getNrOfDatagrams(){
+        CCriticalRegion lock(mSync);
+        return mValues.size();
+      }
+
+      std::vector<TForteUInt32> getValues(){
+        CCriticalRegion lock(mSync);
+        return mValues;
+      }
+
+      std::vector<unsigned int> getEvents(){
+        CCriticalRegion lock(mSync);
+        return mEvents;
+      }
+
+    private:
+      EComResponse openConnection(char *){
+        return e_InitOk;
+      }
+
+      void closeConnection(){
+      }
+
+      CUDPTestCommFB *mFB;
+      CSyncObject mSync;
+      std::vector<TForteUInt32> mValues;
+      std::vector<unsigned int> mEvents;
+  };
+}
+
+BOOST_AUTO_TEST_SUITE(IPComLayer)
+
+  BOOST_AUTO_TEST_CASE(batchedDatagramsAreDeliveredInOrder){
+    CUDPTestCommFB commFB;
+    CDatagramRecorder recorder(&commFB);
+    CIPComLayer *ipLayer = new CIPComLayer(&recorder, &commFB); // closed and deleted by the recorder
+    char parameters[] = "127.0.0.1:15612";
+    BOOST_REQUIRE_EQUAL(e_InitOk, static_cast<CComLayer*>(ipLayer)->openConnection(parameters));
+
+    //the batch sender hands all datagrams to the kernel with one system call, so the subscriber receives them at once
+    CIPComSocketHandler::TUDPDestAddr address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(scmSubscriberPort);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    const TForteUInt32 nrOfDatagrams = (CUDPBatchSender::scmBatchSize < 8) ? CUDPBatchSender::scmBatchSize : 8;
+    CUDPBatchSender sender;
+    BOOST_REQUIRE(sender.addPublisher());
+    for(TForteUInt32 i = 0; i < nrOfDatagrams; ++i){
+      BOOST_REQUIRE(sender.queue(address, reinterpret_cast<char*>(&i), sizeof(i)));
+    }
+    sender.removePublisher();
+    //the sender is only woken up by the first datagram of a batch, so the datagrams do not leave one by one
+    BOOST_CHECK(0 < sender.getNrOfBatches());
+    BOOST_CHECK(nrOfDatagrams > sender.getNrOfBatches());
+    BOOST_TEST_MESSAGE(nrOfDatagrams << " datagrams sent with " << sender.getNrOfBatches() << " sendmmsg calls");
+
+    for(unsigned int i = 0; (i < 200) && (recorder.getNrOfDatagrams() < nrOfDatagrams); ++i){
+      usleep(10000);
+    }
+    //further event chains of the socket handler must not be started
+    usleep(50000);
+
+    std::vector<TForteUInt32> values = recorder.getValues();
+    std::vector<unsigned int> events = recorder.getEvents();
+    BOOST_REQUIRE_EQUAL(nrOfDatagrams, values.size());
+    for(TForteUInt32 i = 0; i < nrOfDatagrams; ++i){
+      BOOST_CHECK_EQUAL(i, values[i]);
+      if(0 != i){
+        BOOST_CHECK(events[i - 1] <= events[i]);
+      }
+    }
+    //one interrupt per received batch, every event chain delivers datagrams
+    BOOST_CHECK(0 < commFB.getNrOfIndications());
+    BOOST_CHECK(nrOfDatagrams >= commFB.getNrOfIndications());
+    BOOST_CHECK_EQUAL(commFB.getNrOfExternalEvents(), commFB.getNrOfIndications());
+    BOOST_CHECK_EQUAL(0U, ipLayer->getNrOfDroppedDatagrams());
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,180 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include <boost/test/unit_test.hpp>
+
+#include "../../../src/core/cominfra/jsoncomlayer.h"
+#include "../../../src/core/cominfra/commfb.h"
+#include "../../../src/stdfblib/ita/EMB_RES.h"
+#include "../../../src/core/datatypes/forte_bool.h"
+#include "../../../src/core/datatypes/forte_int.h"
+#include "../../../src/core/datatypes/forte_string.h"
+#include <string>
+#include <string.h>
+
+#ifdef FORTE_ENABLE_GENERATED_SOURCE_CPP
+#include "jsoncomlayer_test_gen.cpp"
+#endif
+
+using namespace forte::com_infra;
+
+namespace {
+  const CStringDictionary::TStringId scmDataTypes[] = { g_nStringIdBOOL, g_nStringIdBOOL, //QO, STATUS
+    g_nStringIdINT, g_nStringIdSTRING, g_nStringIdBOOL };
+
+  /** Comm FB with up to three data points (INT, STRING, BOOL), its RDs are used as send data as well */
+  class CJSONTestMockCommFB : public CCommFB{
+    public:
+      explicit CJSONTestMockCommFB(unsigned int paNrOfDataPoints) :
+          CCommFB(CStringDictionary::scm_nInvalidStringId, &smResource, e_Subscriber), mMockFBInterface(){
+        memset(&mMockFBInterface, 0, sizeof(mMockFBInterface));
+        mMockFBInterface.m_nNumDIs = 2;
+        mMockFBInterface.m_aunDIDataTypeNames = scmDataTypes;
+        mMockFBInterface.m_nNumDOs = static_cast<TForteUInt8>(paNrOfDataPoints + 2U);
+        mMockFBInterface.m_aunDODataTypeNames = scmDataTypes;
+
+        mFBConnData = new TForteByte[genFBConnDataSize(0, 2, paNrOfDataPoints + 2)];
+        mFBVarsData = new TForteByte[genFBVarsDataSize(2, paNrOfDataPoints + 2)];
+        setupFBInterface(&mMockFBInterface, mFBConnData, mFBVarsData);
+      }
+
+      virtual ~CJSONTestMockCommFB(){
+        freeAllData();
+        delete[] mFBConnData;
+        delete[] mFBVarsData;
+        m_pstInterfaceSpec = 0;
+      }
+
+    private:
+      static EMB_RES smResource;
+
+      SFBInterfaceSpec mMockFBInterface;
+      TForteByte *mFBConnData;
+      TForteByte *mFBVarsData;
+  };
+
+  EMB_RES CJSONTestMockCommFB::smResource(CStringDictionary::scm_nInvalidStringId, 0);
+
+  /** Keeps the last message sent through it */
+  class CRecordingLayer : public CComLayer{
+    public:
+      CRecordingLayer() :
+          CComLayer(0, 0){
+      }
+
+      EComResponse sendData(void *paData, unsigned int paSize){
+        mLastMessage.assign(static_cast<const char*>(paData), paSize);
+        return e_ProcessDataOk;
+      }
+
+      EComResponse recvData(const void *, unsigned int){
+        return e_ProcessDataOk;
+      }
+
+      EComResponse openConnection(char *){
+        return e_InitOk;
+      }
+
+      void closeConnection(){
+      }
+
+      std::string mLastMessage;
+  };
+
+  EComResponse openLayer(CComLayer &paLayer, const char *paParameter){
+    char parameter[32];
+    strcpy(parameter, paParameter);
+    return paLayer.openConnection(parameter);
+  }
+
+  EComResponse receive(CComLayer &paLayer, const char *paText){
+    return paLayer.recvData(paText, static_cast<unsigned int>(strlen(paText)));
+  }
+
+  void setValues(CIEC_ANY *paData, TForteInt16 paLevel, const char *paUnit, bool paOn){
+    static_cast<CIEC_INT&>(paData[0]) = paLevel;
+    static_cast<CIEC_STRING&>(paData[1]) = paUnit;
+    static_cast<CIEC_BOOL&>(paData[2]) = paOn;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(JSONComLayer)
+
+  BOOST_AUTO_TEST_CASE(dataPointsAsArray){
+    CJSONTestMockCommFB sender(3);
+    CJSONTestMockCommFB receiver(3);
+    CRecordingLayer &bottom = *new CRecordingLayer(); // deleted by the layer above it
+    CJSONComLayer sendLayer(0, 0);
+    CJSONComLayer recvLayer(0, &receiver);
+    sendLayer.setBottomLayer(&bottom);
+    BOOST_REQUIRE_EQUAL(e_InitOk, openLayer(sendLayer, ""));
+    BOOST_REQUIRE_EQUAL(e_InitOk, openLayer(recvLayer, ""));
+
+    setValues(sender.getRDs(), 42, "m\"m", true);
+    BOOST_CHECK_EQUAL(e_ProcessDataOk, sendLayer.sendData(sender.getRDs(), 3));
+    BOOST_CHECK_EQUAL("[42,\"m\\\"m\",true]", bottom.mLastMessage);
+
+    BOOST_CHECK_EQUAL(e_ProcessDataOk, receive(recvLayer, bottom.mLastMessage.c_str()));
+    BOOST_CHECK_EQUAL(42, static_cast<TForteInt16>(static_cast<CIEC_INT&>(receiver.getRDs()[0])));
+    BOOST_CHECK_EQUAL(std::string("m\"m"), static_cast<CIEC_STRING&>(receiver.getRDs()[1]).getValue());
+    BOOST_CHECK(static_cast<CIEC_BOOL&>(receiver.getRDs()[2]));
+  }
+
+  BOOST_AUTO_TEST_CASE(dataPointsAsObject){
+    CJSONTestMockCommFB sender(3);
+    CJSONTestMockCommFB receiver(3);
+    CRecordingLayer &bottom = *new CRecordingLayer(); // deleted by the layer above it
+    CJSONComLayer sendLayer(0, 0);
+    CJSONComLayer recvLayer(0, &receiver);
+    sendLayer.setBottomLayer(&bottom);
+    BOOST_REQUIRE_EQUAL(e_InitOk, openLayer(sendLayer, "level, unit, on"));
+    BOOST_REQUIRE_EQUAL(e_InitOk, openLayer(recvLayer, "level,unit,on"));
+    CJSONComLayer invalidLayer(0, 0);
+    BOOST_CHECK_EQUAL(e_InitInvalidId, openLayer(invalidLayer, "level,,on"));
+
+    setValues(sender.getRDs(), -3, "cm", false);
+    BOOST_CHECK_EQUAL(e_ProcessDataOk, sendLayer.sendData(sender.getRDs(), 3));
+    BOOST_CHECK_EQUAL("{\"level\":-3,\"unit\":\"cm\",\"on\":false}", bottom.mLastMessage);
+    BOOST_CHECK_EQUAL(e_ProcessDataDataTypeError, sendLayer.sendData(sender.getRDs(), 2));
+
+    //members can come in any order, unknown ones are ignored
+    setValues(receiver.getRDs(), 0, "", true);
+    BOOST_CHECK_EQUAL(e_ProcessDataOk, receive(recvLayer, "{\"on\": false, \"source\": \"plc\", \"level\": 17}"));
+    BOOST_CHECK_EQUAL(17, static_cast<TForteInt16>(static_cast<CIEC_INT&>(receiver.getRDs()[0])));
+    BOOST_CHECK(!static_cast<CIEC_BOOL&>(receiver.getRDs()[2]));
+
+    BOOST_CHECK_EQUAL(e_ProcessDataDataTypeError, receive(recvLayer, "{\"level\": \"high\"}"));
+    BOOST_CHECK_EQUAL(e_ProcessDataDataTypeError, receive(recvLayer, "{\"level\": 1} trailing"));
+    //invalid text does not change any RD
+    BOOST_CHECK_EQUAL(e_ProcessDataDataTypeError, receive(recvLayer, "{\"level\": 2, \"unit\": \"mm\", \"on\": maybe}"));
+    BOOST_CHECK_EQUAL(17, static_cast<TForteInt16>(static_cast<CIEC_INT&>(receiver.getRDs()[0])));
+    BOOST_CHECK_EQUAL(std::string(""), static_cast<CIEC_STRING&>(receiver.getRDs()[1]).getValue());
+    BOOST_CHECK(!static_cast<CIEC_BOOL&>(receiver.getRDs()[2]));
+  }
+
+  BOOST_AUTO_TEST_CASE(singleDataPointIsSentAsValue){
+    CJSONTestMockCommFB sender(1);
+    CJSONTestMockCommFB receiver(1);
+    CRecordingLayer &bottom = *new CRecordingLayer(); // deleted by the layer above it
+    CJSONComLayer sendLayer(0, 0);
+    CJSONComLayer recvLayer(0, &receiver);
+    sendLayer.setBottomLayer(&bottom);
+    BOOST_REQUIRE_EQUAL(e_InitOk, openLayer(sendLayer, ""));
+    BOOST_REQUIRE_EQUAL(e_InitOk, openLayer(recvLayer, ""));
+
+    static_cast<CIEC_INT&>(sender.getRDs()[0]) = 1234;
+    BOOST_CHECK_EQUAL(e_ProcessDataOk, sendLayer.sendData(sender.getRDs(), 1));
+    BOOST_CHECK_EQUAL("1234", bottom.mLastMessage);
+    BOOST_CHECK_EQUAL(e_ProcessDataOk, receive(recvLayer, " 1234\n"));
+    BOOST_CHECK_EQUAL(1234, static_cast<TForteInt16>(static_cast<CIEC_INT&>(receiver.getRDs()[0])));
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,209 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include <boost/test/unit_test.hpp>
+
+#include "../../../src/core/cominfra/serialframer.h"
+#include <string>
+#include <vector>
+#include <string.h>
+
+using namespace forte::com_infra;
+
+namespace {
+  const unsigned int scmFrameCapacity = 16;
+
+  void addBytes(CSerialRingBuffer &paBuffer, const std::string &paBytes){
+    size_t added = 0;
+    while(added < paBytes.size()){
+      unsigned int spaceSize;
+      char *space = paBuffer.getFreeSpace(spaceSize);
+      BOOST_REQUIRE(0 != spaceSize);
+      unsigned int chunk = static_cast<unsigned int>(paBytes.size() - added);
+      if(chunk > spaceSize){
+        chunk = spaceSize;
+      }
+      memcpy(space, paBytes.data() + added, chunk);
+      paBuffer.commit(chunk);
+      added += chunk;
+    }
+  }
+
+  //! Takes all complete frames, dropped frames are recorded as "<dropped>"
+  std::vector<std::string> extractFrames(CSerialFramer &paFramer, CSerialRingBuffer &paBuffer){
+    std::vector<std::string> frames;
+    char frame[scmFrameCapacity];
+    unsigned int frameSize;
+    CSerialFramer::EResult result;
+    while(CSerialFramer::eIncomplete != (result = paFramer.extractFrame(paBuffer, frame, scmFrameCapacity, frameSize))){
+      frames.push_back((CSerialFramer::eFrame == result) ? std::string(frame, frameSize) : std::string("<dropped>"));
+    }
+    return frames;
+  }
+
+  //! Feeds the bytes one by one and returns all frames found on the way
+  std::vector<std::string> feedBytewise(CSerialFramer &paFramer, const std::string &paBytes){
+    CSerialRingBuffer buffer;
+    std::vector<std::string> frames;
+    for(size_t i = 0; i < paBytes.size(); ++i){
+      addBytes(buffer, paBytes.substr(i, 1));
+      std::vector<std::string> newFrames = extractFrames(paFramer, buffer);
+      frames.insert(frames.end(), newFrames.begin(), newFrames.end());
+    }
+    return frames;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(SerialFramer)
+
+  BOOST_AUTO_TEST_CASE(ringBufferWrapsAround){
+    CSerialRingBuffer buffer;
+    std::string filler(CSerialRingBuffer::scmCapacity - 5, 'a');
+    addBytes(buffer, filler);
+    buffer.consume(static_cast<unsigned int>(filler.size()) - 5);
+    addBytes(buffer, "0123456789");
+    BOOST_CHECK_EQUAL(15U, buffer.size());
+
+    char content[15];
+    buffer.copyOut(content, 15);
+    BOOST_CHECK_EQUAL(std::string("aaaaa0123456789"), std::string(content, 15));
+    BOOST_CHECK_EQUAL('9', buffer[14]);
+
+    addBytes(buffer, std::string(CSerialRingBuffer::scmCapacity - 15, 'b'));
+    BOOST_CHECK(buffer.isFull());
+    unsigned int spaceSize;
+    buffer.getFreeSpace(spaceSize);
+    BOOST_CHECK_EQUAL(0U, spaceSize);
+  }
+
+  BOOST_AUTO_TEST_CASE(delimiterFramesSplitAndBatched){
+    CSerialRingBuffer buffer;
+    CDelimitedFramer framer("\r\n", 2);
+
+    addBytes(buffer, "fir");
+    BOOST_CHECK(extractFrames(framer, buffer).empty());
+    addBytes(buffer, "st\r");
+    BOOST_CHECK(extractFrames(framer, buffer).empty());
+    addBytes(buffer, "\nsecond\r\n\r\nthird\r\nfou");
+    std::vector<std::string> frames = extractFrames(framer, buffer);
+    BOOST_REQUIRE_EQUAL(3U, frames.size());
+    BOOST_CHECK_EQUAL("first", frames[0]);
+    BOOST_CHECK_EQUAL("second", frames[1]);
+    BOOST_CHECK_EQUAL("third", frames[2]);
+    BOOST_CHECK_EQUAL(3U, buffer.size());
+
+    BOOST_CHECK_EQUAL(2U, feedBytewise(framer, "a\rb\r\nc\r\n").size());
+  }
+
+  BOOST_AUTO_TEST_CASE(tooLargeFrameIsDroppedUpToItsDelimiter){
+    CSerialRingBuffer buffer;
+    CDelimitedFramer framer("\n", 1);
+
+    addBytes(buffer, std::string(scmFrameCapacity + 5, 'x'));
+    std::vector<std::string> frames = extractFrames(framer, buffer);
+    BOOST_REQUIRE_EQUAL(1U, frames.size());
+    BOOST_CHECK_EQUAL("<dropped>", frames[0]);
+    addBytes(buffer, std::string(3 * scmFrameCapacity, 'x'));
+    BOOST_CHECK(extractFrames(framer, buffer).empty());
+    addBytes(buffer, "xx\nok\n");
+    frames = extractFrames(framer, buffer);
+    BOOST_REQUIRE_EQUAL(1U, frames.size());
+    BOOST_CHECK_EQUAL("ok", frames[0]);
+    BOOST_CHECK_EQUAL(0U, buffer.size());
+  }
+
+  BOOST_AUTO_TEST_CASE(lengthPrefixFrames){
+    CLengthPrefixFramer framer(2);
+    std::string stream("\x00\x03" "abc" "\x00\x00" "\x00\x01" "d", 10);
+    std::vector<std::string> frames = feedBytewise(framer, stream);
+    BOOST_REQUIRE_EQUAL(3U, frames.size());
+    BOOST_CHECK_EQUAL("abc", frames[0]);
+    BOOST_CHECK_EQUAL("", frames[1]);
+    BOOST_CHECK_EQUAL("d", frames[2]);
+
+    CLengthPrefixFramer shortFramer(1);
+    std::string tooLarge(1, static_cast<char>(scmFrameCapacity + 1));
+    tooLarge += std::string(scmFrameCapacity + 1, 'x') + "\x02" "ok";
+    frames = feedBytewise(shortFramer, tooLarge);
+    BOOST_REQUIRE_EQUAL(2U, frames.size());
+    BOOST_CHECK_EQUAL("<dropped>", frames[0]);
+    BOOST_CHECK_EQUAL("ok", frames[1]);
+  }
+
+  BOOST_AUTO_TEST_CASE(slipFrames){
+    CSLIPFramer framer;
+    //leading END, escaped END and ESC, invalid escape
+    std::string stream("\xC0" "a\xDB\xDC" "b\xDB\xDD" "\xC0" "c\xC0" "\xDB" "x\xC0", 13);
+    std::vector<std::string> frames = feedBytewise(framer, stream);
+    BOOST_REQUIRE_EQUAL(3U, frames.size());
+    BOOST_CHECK_EQUAL(std::string("a\xC0" "b\xDB"), frames[0]);
+    BOOST_CHECK_EQUAL("c", frames[1]);
+    BOOST_CHECK_EQUAL("<dropped>", frames[2]);
+  }
+
+  BOOST_AUTO_TEST_CASE(cobsFrames){
+    CCOBSFramer framer;
+    //"\x11\x00\x22" and "\x33" and an empty frame
+    std::string stream("\x02\x11\x02\x22\x00" "\x02\x33\x00" "\x01\x00", 10);
+    std::vector<std::string> frames = feedBytewise(framer, stream);
+    BOOST_REQUIRE_EQUAL(3U, frames.size());
+    BOOST_CHECK_EQUAL(std::string("\x11\x00\x22", 3), frames[0]);
+    BOOST_CHECK_EQUAL("\x33", frames[1]);
+    BOOST_CHECK_EQUAL("", frames[2]);
+
+    //code pointing behind the frame end
+    CSerialRingBuffer buffer;
+    addBytes(buffer, std::string("\x05\x11\x00", 3));
+    frames = extractFrames(framer, buffer);
+    BOOST_REQUIRE_EQUAL(1U, frames.size());
+    BOOST_CHECK_EQUAL("<dropped>", frames[0]);
+  }
+
+  BOOST_AUTO_TEST_CASE(idleLineFrames){
+    CIdleLineFramer framer(9600);
+    BOOST_CHECK_EQUAL(4011U, framer.getIdleTimeout());
+    BOOST_CHECK_EQUAL(1750U, CIdleLineFramer(115200).getIdleTimeout());
+
+    CSerialRingBuffer buffer;
+    addBytes(buffer, std::string("\x01\x03\x00", 3));
+    BOOST_CHECK(extractFrames(framer, buffer).empty());
+    addBytes(buffer, "\x10");
+    framer.lineIdle(buffer);
+    addBytes(buffer, "\x02");
+    std::vector<std::string> frames = extractFrames(framer, buffer);
+    BOOST_REQUIRE_EQUAL(1U, frames.size());
+    BOOST_CHECK_EQUAL(std::string("\x01\x03\x00\x10", 4), frames[0]);
+    BOOST_CHECK_EQUAL(1U, buffer.size());
+  }
+
+  BOOST_AUTO_TEST_CASE(createFramers){
+    const char *const framings[] = { "", "LINE", "RAW", "LEN1", "LEN2", "RTU", "SLIP", "COBS" };
+    for(size_t i = 0; i < sizeof(framings) / sizeof(framings[0]); ++i){
+      CSerialFramer *framer = CSerialFramer::createFramer(framings[i], "\n", 9600);
+      BOOST_CHECK(0 != framer);
+      delete framer;
+    }
+    BOOST_CHECK(0 == CSerialFramer::createFramer("HDLC", "\n", 9600));
+
+    //without a framing parameter the received bytes are not split
+    const char *const rawFramings[] = { 0, "", "RAW" };
+    for(size_t i = 0; i < sizeof(rawFramings) / sizeof(rawFramings[0]); ++i){
+      CSerialFramer *raw = CSerialFramer::createFramer(rawFramings[i], "\n", 9600);
+      CSerialRingBuffer buffer;
+      addBytes(buffer, "no\nframing");
+      std::vector<std::string> frames = extractFrames(*raw, buffer);
+      BOOST_REQUIRE_EQUAL(1U, frames.size());
+      BOOST_CHECK_EQUAL("no\nframing", frames[0]);
+      delete raw;
+    }
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
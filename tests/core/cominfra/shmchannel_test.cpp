@@ -0,0 +1,400 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include <boost/test/unit_test.hpp>
+
+#include "../../../src/core/cominfra/shmchannel.h"
+#include <forte_thread.h>
+#include <stdio.h>
+#include <string>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+using namespace forte::com_infra;
+
+namespace {
+  const unsigned int scmNrOfSlots = 8;
+  const unsigned int scmSlotSize = 256;
+  const unsigned int scmNrOfRoundTrips = 2000;
+  const unsigned int scmUdpPort = 15601;
+
+  /** Name of a channel unique for this test process */
+  const char *getChannelName(const char *paSuffix) {
+    static char name[64];
+    snprintf(name, sizeof(name), "test_%d_%s", static_cast<int>(getpid()), paSuffix);
+    return name;
+  }
+
+  /** Opens the segment of a channel without a CShmChannel, -1 if it does not exist */
+  int openSegment(const char *paName) {
+    return shm_open((std::string("/forte_shm_") + paName).c_str(), O_RDONLY, 0);
+  }
+
+  bool segmentExists(const char *paName) {
+    int fd = openSegment(paName);
+    if(-1 == fd) {
+      return false;
+    }
+    close(fd);
+    return true;
+  }
+
+  TForteUInt64 getNanoSeconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<TForteUInt64>(now.tv_sec) * 1000000000ULL + static_cast<TForteUInt64>(now.tv_nsec);
+  }
+
+  /** Returns every message received on one channel on another one */
+  class CShmEcho : public CThread {
+    public:
+      CShmEcho(CShmChannel &paRequests, CShmChannel &paResponses) :
+          mRequests(paRequests), mResponses(paResponses) {
+      }
+
+      void stop() {
+        setAlive(false);
+        mRequests.wakeUpReaders();
+        end();
+      }
+
+    protected:
+      void run() {
+        TForteUInt32 readCount = 0;
+        unsigned int lost = 0;
+        char buffer[scmSlotSize];
+        while(isAlive()) {
+          int size = mRequests.read(readCount, buffer, sizeof(buffer), lost);
+          if(0 <= size) {
+            mResponses.write(buffer, static_cast<unsigned int>(size));
+          } else {
+            mRequests.waitForData(readCount, 100);
+          }
+        }
+      }
+
+    private:
+      CShmChannel &mRequests;
+      CShmChannel &mResponses;
+  };
+
+  /** Returns every datagram received to its sender */
+  class CUdpEcho : public CThread {
+    public:
+      explicit CUdpEcho(int paSocket) :
+          mSocket(paSocket) {
+      }
+
+    protected:
+      void run() {
+        char buffer[scmSlotSize];
+        struct sockaddr_in sender;
+        while(isAlive()) {
+          socklen_t senderSize = sizeof(sender);
+          ssize_t size = recvfrom(mSocket, buffer, sizeof(buffer), 0, reinterpret_cast<struct sockaddr*>(&sender), &senderSize);
+          if(0 < size) {
+            sendto(mSocket, buffer, static_cast<size_t>(size), 0, reinterpret_cast<struct sockaddr*>(&sender), senderSize);
+          }
+        }
+      }
+
+    private:
+      int mSocket;
+  };
+
+  int openUdpSocket(unsigned int paPort) {
+    int udpSocket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(paPort));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    struct timeval timeout = { 0, 100000 };
+    setsockopt(udpSocket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    if(0 != bind(udpSocket, reinterpret_cast<struct sockaddr*>(&address), sizeof(address))) {
+      close(udpSocket);
+      return -1;
+    }
+    return udpSocket;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(ShmChannel)
+
+  BOOST_AUTO_TEST_CASE(writeAndRead) {
+    CShmChannel writer(scmNrOfSlots, scmSlotSize);
+    CShmChannel reader(scmNrOfSlots, scmSlotSize);
+    BOOST_REQUIRE(writer.open(getChannelName("rw")));
+    BOOST_REQUIRE(reader.open(getChannelName("rw")));
+
+    TForteUInt32 readCount = reader.getWriteCount();
+    unsigned int lost = 0;
+    char buffer[scmSlotSize];
+    BOOST_CHECK_EQUAL(-1, reader.read(readCount, buffer, sizeof(buffer), lost));
+
+    BOOST_CHECK(writer.write("first", 6));
+    BOOST_CHECK(writer.write("second", 7));
+    BOOST_CHECK(reader.waitForData(readCount, 0));
+
+    BOOST_CHECK_EQUAL(6, reader.read(readCount, buffer, sizeof(buffer), lost));
+    BOOST_CHECK_EQUAL(std::string("first"), std::string(buffer));
+    BOOST_CHECK_EQUAL(7, reader.read(readCount, buffer, sizeof(buffer), lost));
+    BOOST_CHECK_EQUAL(std::string("second"), std::string(buffer));
+    BOOST_CHECK_EQUAL(-1, reader.read(readCount, buffer, sizeof(buffer), lost));
+    BOOST_CHECK_EQUAL(0U, lost);
+    BOOST_CHECK(!reader.waitForData(readCount, 1));
+
+    CShmChannel::remove(getChannelName("rw"));
+  }
+
+  BOOST_AUTO_TEST_CASE(slowReaderLosesOldestMessages) {
+    CShmChannel channel(scmNrOfSlots, scmSlotSize);
+    BOOST_REQUIRE(channel.open(getChannelName("lost")));
+
+    TForteUInt32 readCount = channel.getWriteCount();
+    for(TForteUInt32 i = 0; i < scmNrOfSlots + 3; ++i) {
+      BOOST_CHECK(channel.write(&i, sizeof(i)));
+    }
+
+    unsigned int lost = 0;
+    TForteUInt32 value;
+    for(TForteUInt32 i = 3; i < scmNrOfSlots + 3; ++i) {
+      BOOST_CHECK_EQUAL(static_cast<int>(sizeof(value)), channel.read(readCount, &value, sizeof(value), lost));
+      BOOST_CHECK_EQUAL(i, value);
+    }
+    BOOST_CHECK_EQUAL(3U, lost);
+    BOOST_CHECK_EQUAL(-1, channel.read(readCount, &value, sizeof(value), lost));
+
+    CShmChannel::remove(getChannelName("lost"));
+  }
+
+  BOOST_AUTO_TEST_CASE(invalidUse) {
+    CShmChannel channel(scmNrOfSlots, scmSlotSize);
+    BOOST_CHECK(!channel.open("invalid/name"));
+    BOOST_CHECK(!channel.open(""));
+    BOOST_REQUIRE(channel.open(getChannelName("invalid")));
+
+    char tooLarge[scmSlotSize + 1];
+    memset(tooLarge, 0, sizeof(tooLarge));
+    BOOST_CHECK(!channel.write(tooLarge, sizeof(tooLarge)));
+
+    CShmChannel::remove(getChannelName("invalid"));
+  }
+
+  BOOST_AUTO_TEST_CASE(lastUserRemovesSegment) {
+    std::string channelName(getChannelName("users"));
+    CShmChannel first(scmNrOfSlots, scmSlotSize);
+    CShmChannel second(scmNrOfSlots, scmSlotSize);
+    BOOST_REQUIRE(first.open(channelName.c_str()));
+    BOOST_REQUIRE(second.open(channelName.c_str()));
+
+    // only the owner has access to the segment
+    int fd = openSegment(channelName.c_str());
+    BOOST_REQUIRE(-1 != fd);
+    struct stat segmentStat;
+    BOOST_REQUIRE_EQUAL(0, fstat(fd, &segmentStat));
+    BOOST_CHECK_EQUAL(0, segmentStat.st_mode & 077);
+    close(fd);
+
+    first.close();
+    BOOST_CHECK(segmentExists(channelName.c_str()));
+    second.close();
+    BOOST_CHECK(!segmentExists(channelName.c_str()));
+
+    // a channel opened again gets a new segment
+    BOOST_REQUIRE(first.open(channelName.c_str()));
+    BOOST_CHECK(first.write("again", 6));
+    first.close();
+    BOOST_CHECK(!segmentExists(channelName.c_str()));
+  }
+
+  BOOST_AUTO_TEST_CASE(staleSegmentWithOtherLayoutIsReplaced) {
+    std::string channelName(getChannelName("stale"));
+    // left behind by a process configured with another number of slots which terminated without closing it
+    CShmChannel otherLayout(scmNrOfSlots * 2, scmSlotSize);
+    BOOST_REQUIRE(otherLayout.open(channelName.c_str()));
+    pid_t pid = fork();
+    BOOST_REQUIRE(-1 != pid);
+    if(0 == pid) {
+      CShmChannel *leftBehind = new CShmChannel(scmNrOfSlots * 2, scmSlotSize);
+      leftBehind->open(channelName.c_str());
+      _exit(0);
+    }
+    int status;
+    waitpid(pid, &status, 0);
+    otherLayout.close();
+    BOOST_REQUIRE(segmentExists(channelName.c_str()));
+
+    CShmChannel writer(scmNrOfSlots, scmSlotSize);
+    CShmChannel reader(scmNrOfSlots, scmSlotSize);
+    BOOST_REQUIRE(writer.open(channelName.c_str()));
+    BOOST_REQUIRE(reader.open(channelName.c_str()));
+    TForteUInt32 readCount = reader.getWriteCount();
+    BOOST_CHECK(writer.write("new", 4));
+    unsigned int lost = 0;
+    char buffer[scmSlotSize];
+    BOOST_CHECK_EQUAL(4, reader.read(readCount, buffer, sizeof(buffer), lost));
+
+    writer.close();
+    reader.close();
+    BOOST_CHECK(!segmentExists(channelName.c_str()));
+  }
+
+  BOOST_AUTO_TEST_CASE(lockOfTerminatedWriterIsTakenOver) {
+    std::string channelName(getChannelName("deadwriter"));
+    CShmChannel channel(scmNrOfSlots, scmSlotSize);
+    BOOST_REQUIRE(channel.open(channelName.c_str()));
+    TForteUInt32 readCount = channel.getWriteCount();
+
+    // a writer process terminating while it holds the write lock, the lock is the sixth word of the segment header
+    pid_t writerPid = fork();
+    BOOST_REQUIRE(-1 != writerPid);
+    if(0 == writerPid) {
+      int fd = shm_open(("/forte_shm_" + channelName).c_str(), O_RDWR, 0);
+      void *segment = (-1 != fd) ? mmap(0, 64, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+      if(MAP_FAILED != segment) {
+        static_cast<TForteUInt32*>(segment)[5] = static_cast<TForteUInt32>(getpid());
+      }
+      _exit(0);
+    }
+    int status;
+    waitpid(writerPid, &status, 0);
+
+    BOOST_CHECK(channel.write("after", 6));
+    unsigned int lost = 0;
+    char buffer[scmSlotSize];
+    BOOST_CHECK_EQUAL(6, channel.read(readCount, buffer, sizeof(buffer), lost));
+    BOOST_CHECK_EQUAL(std::string("after"), std::string(buffer));
+
+    CShmChannel::remove(channelName.c_str());
+  }
+
+  BOOST_AUTO_TEST_CASE(betweenProcesses) {
+    const TForteUInt32 nrOfMessages = 10000;
+    // the name contains the pid, so it has to be determined before forking
+    std::string channelName(getChannelName("proc"));
+    CShmChannel channel(scmNrOfSlots, scmSlotSize);
+    BOOST_REQUIRE(channel.open(channelName.c_str()));
+    TForteUInt32 readCount = channel.getWriteCount();
+
+    pid_t writerPid = fork();
+    BOOST_REQUIRE(-1 != writerPid);
+    if(0 == writerPid) {
+      CShmChannel writer(scmNrOfSlots, scmSlotSize);
+      if(writer.open(channelName.c_str())) {
+        for(TForteUInt32 i = 0; i < nrOfMessages; ++i) {
+          writer.write(&i, sizeof(i));
+        }
+      }
+      _exit(0);
+    }
+
+    unsigned int lost = 0;
+    unsigned int received = 0;
+    bool inOrder = true;
+    TForteUInt32 value;
+    TForteUInt32 lastValue = 0;
+    TForteUInt64 timeout = getNanoSeconds() + 10000000000ULL;
+    while((received + lost) < nrOfMessages && getNanoSeconds() < timeout) {
+      channel.waitForData(readCount, 100);
+      while(0 <= channel.read(readCount, &value, sizeof(value), lost)) {
+        inOrder = inOrder && ((0 == received) || (value > lastValue));
+        lastValue = value;
+        ++received;
+      }
+    }
+    int status;
+    waitpid(writerPid, &status, 0);
+
+    BOOST_CHECK_EQUAL(nrOfMessages, received + lost);
+    BOOST_CHECK(inOrder);
+    BOOST_CHECK_EQUAL(nrOfMessages - 1, lastValue);
+    BOOST_TEST_MESSAGE("shm between processes: " << received << " messages received, " << lost << " overwritten");
+
+    CShmChannel::remove(channelName.c_str());
+  }
+
+  BOOST_AUTO_TEST_CASE(roundTripCompareToUdp) {
+    CShmChannel requests(scmNrOfSlots, scmSlotSize);
+    CShmChannel responses(scmNrOfSlots, scmSlotSize);
+    BOOST_REQUIRE(requests.open(getChannelName("req")));
+    BOOST_REQUIRE(responses.open(getChannelName("rsp")));
+
+    CShmEcho shmEcho(requests, responses);
+    shmEcho.start();
+
+    char message[64];
+    memset(message, 0x5A, sizeof(message));
+    char buffer[scmSlotSize];
+    unsigned int lost = 0;
+    TForteUInt32 readCount = responses.getWriteCount();
+    unsigned int shmRoundTrips = 0;
+    TForteUInt64 start = getNanoSeconds();
+    for(unsigned int i = 0; i < scmNrOfRoundTrips; ++i) {
+      requests.write(message, sizeof(message));
+      int size;
+      TForteUInt64 timeout = getNanoSeconds() + 1000000000ULL;
+      while(0 > (size = responses.read(readCount, buffer, sizeof(buffer), lost)) && getNanoSeconds() < timeout) {
+        responses.waitForData(readCount, 100);
+      }
+      if(0 <= size) {
+        ++shmRoundTrips;
+      }
+    }
+    TForteUInt64 shmTime = getNanoSeconds() - start;
+    shmEcho.stop();
+
+    BOOST_CHECK_EQUAL(scmNrOfRoundTrips, shmRoundTrips);
+    BOOST_CHECK_EQUAL(0U, lost);
+
+    int echoSocket = openUdpSocket(scmUdpPort);
+    int clientSocket = openUdpSocket(scmUdpPort + 1);
+    BOOST_REQUIRE(-1 != echoSocket);
+    BOOST_REQUIRE(-1 != clientSocket);
+    CUdpEcho udpEcho(echoSocket);
+    udpEcho.start();
+
+    struct sockaddr_in echoAddress;
+    memset(&echoAddress, 0, sizeof(echoAddress));
+    echoAddress.sin_family = AF_INET;
+    echoAddress.sin_port = htons(static_cast<uint16_t>(scmUdpPort));
+    echoAddress.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    unsigned int udpRoundTrips = 0;
+    start = getNanoSeconds();
+    for(unsigned int i = 0; i < scmNrOfRoundTrips; ++i) {
+      sendto(clientSocket, message, sizeof(message), 0, reinterpret_cast<struct sockaddr*>(&echoAddress), sizeof(echoAddress));
+      if(0 < recv(clientSocket, buffer, sizeof(buffer), 0)) {
+        ++udpRoundTrips;
+      }
+    }
+    TForteUInt64 udpTime = getNanoSeconds() - start;
+    udpEcho.end();
+    close(clientSocket);
+    close(echoSocket);
+
+    BOOST_CHECK_EQUAL(scmNrOfRoundTrips, udpRoundTrips);
+    BOOST_TEST_MESSAGE("average round trip of a 64 byte message: shm " << shmTime / scmNrOfRoundTrips << " ns, UDP loopback "
+      << udpTime / scmNrOfRoundTrips << " ns");
+
+    CShmChannel::remove(getChannelName("req"));
+    CShmChannel::remove(getChannelName("rsp"));
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
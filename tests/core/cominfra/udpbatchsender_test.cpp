@@ -0,0 +1,123 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include <boost/test/unit_test.hpp>
+
+#include "../../../src/core/cominfra/udpbatchsender.h"
+#include <forte_thread.h>
+#include <string.h>
+
+using namespace forte::com_infra;
+
+namespace {
+  const unsigned short scmReceivePort = 15611;
+
+  CIPComSocketHandler::TSocketDescriptor openReceiveSocket(CIPComSocketHandler::TUDPDestAddr &paAddress) {
+    CIPComSocketHandler::TSocketDescriptor receiveSocket = socket(PF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    memset(&paAddress, 0, sizeof(paAddress));
+    paAddress.sin_family = AF_INET;
+    paAddress.sin_port = htons(scmReceivePort);
+    paAddress.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int bufferSize = 1024 * 1024;
+    setsockopt(receiveSocket, SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize));
+    if(0 != bind(receiveSocket, reinterpret_cast<struct sockaddr*>(&paAddress), sizeof(paAddress))) {
+      close(receiveSocket);
+      return CIPComSocketHandler::scmInvalidSocketDescriptor;
+    }
+    return receiveSocket;
+  }
+
+  /** Receives the datagrams waiting on the socket in batches, each datagram has to contain its index */
+  unsigned int receiveAll(CIPComSocketHandler::TSocketDescriptor paSocket, unsigned int paExpected, bool &paInOrder) {
+    TForteUInt32 values[CUDPBatchSender::scmBatchSize];
+    struct iovec ioVecs[CUDPBatchSender::scmBatchSize];
+    struct mmsghdr messages[CUDPBatchSender::scmBatchSize];
+    unsigned int received = 0;
+    paInOrder = true;
+    for(unsigned int retries = 0; received < paExpected && retries < 100; ++retries) {
+      memset(messages, 0, sizeof(messages));
+      for(unsigned int i = 0; i < CUDPBatchSender::scmBatchSize; ++i) {
+        ioVecs[i].iov_base = &values[i];
+        ioVecs[i].iov_len = sizeof(values[i]);
+        messages[i].msg_hdr.msg_iov = &ioVecs[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+      }
+      int nrReceived = CIPComSocketHandler::receiveBatchFromUDP(paSocket, messages, CUDPBatchSender::scmBatchSize);
+      if(0 < nrReceived) {
+        for(int i = 0; i < nrReceived; ++i) {
+          paInOrder = paInOrder && (sizeof(TForteUInt32) == messages[i].msg_len) && (received == values[i]);
+          ++received;
+        }
+      } else {
+        CThread::sleepThread(10);
+      }
+    }
+    return received;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(UDPBatchSender)
+
+  BOOST_AUTO_TEST_CASE(queueWithoutPublisher) {
+    CUDPBatchSender sender;
+    CIPComSocketHandler::TUDPDestAddr address;
+    memset(&address, 0, sizeof(address));
+    TForteUInt32 value = 0;
+    BOOST_CHECK(!sender.queue(address, reinterpret_cast<char*>(&value), sizeof(value)));
+  }
+
+  BOOST_AUTO_TEST_CASE(batchesArriveInOrder) {
+    CIPComSocketHandler::TUDPDestAddr address;
+    CIPComSocketHandler::TSocketDescriptor receiveSocket = openReceiveSocket(address);
+    BOOST_REQUIRE(CIPComSocketHandler::scmInvalidSocketDescriptor != receiveSocket);
+
+    CUDPBatchSender sender;
+    BOOST_REQUIRE(sender.addPublisher());
+    const TForteUInt32 nrOfDatagrams = 20 * CUDPBatchSender::scmBatchSize;
+    TForteUInt32 queued = 0;
+    for(TForteUInt32 i = 0; i < nrOfDatagrams; ++i) {
+      if(sender.queue(address, reinterpret_cast<char*>(&queued), sizeof(queued))) {
+        ++queued;
+      } else {
+        // a publisher would send the datagram itself, here we give the sender time to catch up
+        CThread::sleepThread(1);
+      }
+    }
+    sender.removePublisher();
+
+    bool inOrder;
+    BOOST_CHECK_EQUAL(queued, receiveAll(receiveSocket, queued, inOrder));
+    BOOST_CHECK(inOrder);
+    BOOST_CHECK_EQUAL(0U, sender.getNrOfSendErrors());
+    BOOST_CHECK_EQUAL(nrOfDatagrams - queued, sender.getNrOfOverflows());
+    CIPComSocketHandler::closeSocket(receiveSocket);
+  }
+
+  BOOST_AUTO_TEST_CASE(receiveBatchDrainsBurst) {
+    CIPComSocketHandler::TUDPDestAddr address;
+    CIPComSocketHandler::TSocketDescriptor receiveSocket = openReceiveSocket(address);
+    BOOST_REQUIRE(CIPComSocketHandler::scmInvalidSocketDescriptor != receiveSocket);
+    CIPComSocketHandler::TSocketDescriptor sendSocket = socket(PF_INET, SOCK_DGRAM, IPPROTO_UDP);
+
+    const TForteUInt32 nrOfDatagrams = CUDPBatchSender::scmBatchSize / 2;
+    for(TForteUInt32 i = 0; i < nrOfDatagrams; ++i) {
+      CIPComSocketHandler::sendDataOnUDP(sendSocket, &address, reinterpret_cast<char*>(&i), sizeof(i));
+    }
+
+    bool inOrder;
+    BOOST_CHECK_EQUAL(nrOfDatagrams, receiveAll(receiveSocket, nrOfDatagrams, inOrder));
+    BOOST_CHECK(inOrder);
+
+    CIPComSocketHandler::closeSocket(sendSocket);
+    CIPComSocketHandler::closeSocket(receiveSocket);
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,381 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include <boost/test/unit_test.hpp>
+
+#include "fbtests/fbtesterglobalfixture.h"
+#include <funcbloc.h>
+#include <resource.h>
+#include <forte_dint.h>
+#include <ecet.h>
+
+#ifdef FORTE_ENABLE_GENERATED_SOURCE_CPP
+#include "eventfanouttest_gen.cpp"
+#endif
+
+#ifdef WIN32
+#include <windows.h>
+# define usleep(x) Sleep((x)/1000)
+#else
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <string.h>
+#include <time.h>
+#include <vector>
+#endif
+
+namespace {
+  const CStringDictionary::TStringId scmEINames[] = { g_nStringIdREQ };
+  const TDataIOID scmEIWith[] = { 0, CFunctionBlock::scmWithListDelimiter };
+  const TForteInt16 scmEIWithIndexes[] = { 0 };
+  const CStringDictionary::TStringId scmEONames[] = { g_nStringIdCNF };
+  const TDataIOID scmEOWith[] = { 0, CFunctionBlock::scmWithListDelimiter };
+  const TForteInt16 scmEOWithIndexes[] = { 0, -1 };
+  const CStringDictionary::TStringId scmDINames[] = { g_nStringIdIN };
+  const CStringDictionary::TStringId scmDONames[] = { g_nStringIdOUT };
+  const CStringDictionary::TStringId scmDataTypes[] = { g_nStringIdDINT };
+
+  const SFBInterfaceSpec scmFanOutTestInterface = { 1, scmEINames, scmEIWith, scmEIWithIndexes, 1, scmEONames, scmEOWith,
+    scmEOWithIndexes, 1, scmDINames, scmDataTypes, 1, scmDONames, scmDataTypes, 0, 0 };
+
+  /** FB with REQ WITH IN and CNF WITH OUT, records the received events and the input value and answers REQ with CNF */
+  class CFanOutTestFB : public CFunctionBlock{
+    public:
+      CFanOutTestFB() :
+          CFunctionBlock(CFBTestDataGlobalFixture::getResource(), &scmFanOutTestInterface, CStringDictionary::scm_nInvalidStringId,
+              m_anFBConnData, m_anFBVarsData), mNrOfEvents(0), mLastInput(0){
+        changeFBExecutionState(cg_nMGM_CMD_Reset);
+      }
+
+      virtual ~CFanOutTestFB(){
+        changeFBExecutionState(cg_nMGM_CMD_Stop);
+      }
+
+      CStringDictionary::TStringId getFBTypeId(void) const {
+        return CStringDictionary::scm_nInvalidStringId;
+      }
+
+      void setOutput(TForteInt32 paValue){
+        getDO(0)->setValue(CIEC_DINT(paValue));
+      }
+
+      unsigned int getNrOfEvents() const {
+        return mNrOfEvents;
+      }
+
+      TForteInt32 getLastInput() const {
+        return mLastInput;
+      }
+
+      //! Restarts the FB so that its connections are sealed again
+      void restart(){
+        changeFBExecutionState(cg_nMGM_CMD_Stop);
+        changeFBExecutionState(cg_nMGM_CMD_Start);
+      }
+
+    private:
+      virtual void executeEvent(int){
+        mLastInput = *static_cast<CIEC_DINT *>(getDI(0));
+        ++mNrOfEvents;
+        sendOutputEvent(0);
+      }
+
+      volatile unsigned int mNrOfEvents;
+      volatile TForteInt32 mLastInput;
+
+      FORTE_FB_DATA_ARRAY(1, 1, 1, 0)
+  };
+
+#ifdef __linux__
+  /** Counts the cache misses of the calling thread in user space with perf_event_open */
+  class CCacheMissCounter{
+    public:
+      CCacheMissCounter(){
+        struct perf_event_attr attributes;
+        memset(&attributes, 0, sizeof(attributes));
+        attributes.type = PERF_TYPE_HARDWARE;
+        attributes.size = sizeof(attributes);
+        attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+        attributes.disabled = 1;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+        mFd = static_cast<int>(syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0));
+      }
+
+      ~CCacheMissCounter(){
+        if(-1 != mFd){
+          close(mFd);
+        }
+      }
+
+      //! false if the kernel or the virtual machine does not provide the counter
+      bool isAvailable() const {
+        return -1 != mFd;
+      }
+
+      void start(){
+        ioctl(mFd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(mFd, PERF_EVENT_IOC_ENABLE, 0);
+      }
+
+      TForteUInt64 stop(){
+        ioctl(mFd, PERF_EVENT_IOC_DISABLE, 0);
+        TForteUInt64 value = 0;
+        if(static_cast<ssize_t>(sizeof(value)) != read(mFd, &value, sizeof(value))){
+          value = 0;
+        }
+        return value;
+      }
+
+    private:
+      int mFd;
+  };
+
+  /** Execution thread which is not started, the test takes the queued events out itself */
+  class CQueueingExecutionThread : public CEventChainExecutionThread{
+    public:
+      //! Reads the queued entries as the execution thread does, empties the list, and returns a checksum of them
+      TForteUInt32 drain(){
+        TForteUInt32 checksum = 0;
+        for(TEventEntryPtr *entry = &mEventList[cg_nEventChainEventListSize - 1]; entry != mEventListEnd; --entry){
+          checksum += static_cast<TForteUInt32>((*entry)->mPortId + reinterpret_cast<size_t>((*entry)->mFB));
+          *entry = 0;
+        }
+        mEventListStart = mEventListEnd = &mEventList[cg_nEventChainEventListSize - 1];
+        return checksum;
+      }
+  };
+#endif
+
+  const unsigned int scmNrOfDestinations = 3;
+
+  struct SFanOutFixture{
+      SFanOutFixture() :
+          mSourceEntry(&mSource, 0){
+        for(unsigned int i = 0; i < scmNrOfDestinations; ++i){
+          BOOST_REQUIRE_EQUAL(e_RDY, mSource.getEOConnection(g_nStringIdCNF)->connect(&mDestinations[i], g_nStringIdREQ));
+          BOOST_REQUIRE_EQUAL(e_RDY, mSource.getDOConnection(g_nStringIdOUT)->connect(&mDestinations[i], g_nStringIdIN));
+          mDestinations[i].changeFBExecutionState(cg_nMGM_CMD_Start);
+        }
+        mSource.changeFBExecutionState(cg_nMGM_CMD_Start);
+      }
+
+      ~SFanOutFixture(){
+        for(unsigned int i = 0; i < scmNrOfDestinations; ++i){
+          mSource.getEOConnection(g_nStringIdCNF)->disconnect(&mDestinations[i], g_nStringIdREQ);
+          mSource.getDOConnection(g_nStringIdOUT)->disconnect(&mDestinations[i], g_nStringIdIN);
+        }
+      }
+
+      //! Sends CNF with the given value from the source in the resource's event chain
+      void fire(TForteInt32 paValue){
+        mSource.setOutput(paValue);
+        CFBTestDataGlobalFixture::getResource()->getResourceEventExecution()->startEventChain(&mSourceEntry);
+      }
+
+      //! Waits for the given number of events at paFB, all destinations triggered before it are done then as well
+      static void waitForEvents(const CFanOutTestFB &paFB, unsigned int paNrOfEvents){
+        for(unsigned int i = 0; (i < 2000) && (paFB.getNrOfEvents() < paNrOfEvents); ++i){
+          usleep(1000);
+        }
+      }
+
+      CFanOutTestFB mSource;
+      CFanOutTestFB mDestinations[scmNrOfDestinations];
+      SEventEntry mSourceEntry;
+  };
+}
+
+BOOST_FIXTURE_TEST_SUITE(EventFanOut, SFanOutFixture)
+
+  BOOST_AUTO_TEST_CASE(sealedFanOutReachesAllDestinations){
+    BOOST_CHECK(mSource.getEOConnection(g_nStringIdCNF)->isSealed());
+
+    fire(42);
+    waitForEvents(mDestinations[2], 1);
+    for(unsigned int i = 0; i < scmNrOfDestinations; ++i){
+      BOOST_CHECK_EQUAL(1U, mDestinations[i].getNrOfEvents());
+      BOOST_CHECK_EQUAL(42, mDestinations[i].getLastInput());
+    }
+
+    fire(43);
+    waitForEvents(mDestinations[2], 2);
+    for(unsigned int i = 0; i < scmNrOfDestinations; ++i){
+      BOOST_CHECK_EQUAL(2U, mDestinations[i].getNrOfEvents());
+      BOOST_CHECK_EQUAL(43, mDestinations[i].getLastInput());
+    }
+  }
+
+  BOOST_AUTO_TEST_CASE(reconfigurationUnsealsUntilNextStart){
+    BOOST_REQUIRE_EQUAL(e_RDY, mSource.getEOConnection(g_nStringIdCNF)->disconnect(&mDestinations[1], g_nStringIdREQ));
+    BOOST_CHECK(!mSource.getEOConnection(g_nStringIdCNF)->isSealed());
+    //the last destination's input keeps its value after its connection is removed
+    BOOST_REQUIRE_EQUAL(e_RDY, mSource.getDOConnection(g_nStringIdOUT)->disconnect(&mDestinations[2], g_nStringIdIN));
+
+    fire(7);
+    waitForEvents(mDestinations[2], 1);
+    BOOST_CHECK_EQUAL(1U, mDestinations[0].getNrOfEvents());
+    BOOST_CHECK_EQUAL(7, mDestinations[0].getLastInput());
+    BOOST_CHECK_EQUAL(0U, mDestinations[1].getNrOfEvents());
+    BOOST_CHECK_EQUAL(1U, mDestinations[2].getNrOfEvents());
+    BOOST_CHECK_EQUAL(0, mDestinations[2].getLastInput());
+
+    BOOST_REQUIRE_EQUAL(e_RDY, mSource.getEOConnection(g_nStringIdCNF)->connect(&mDestinations[1], g_nStringIdREQ));
+    mSource.restart();
+    BOOST_CHECK(mSource.getEOConnection(g_nStringIdCNF)->isSealed());
+
+    //the reconnected destination is the last one now
+    fire(8);
+    waitForEvents(mDestinations[1], 1);
+    for(unsigned int i = 0; i < scmNrOfDestinations; ++i){
+      BOOST_CHECK_EQUAL((1 == i) ? 1U : 2U, mDestinations[i].getNrOfEvents());
+    }
+    BOOST_CHECK_EQUAL(8, mDestinations[1].getLastInput());
+    BOOST_CHECK_EQUAL(0, mDestinations[2].getLastInput());
+  }
+
+#ifdef __linux__
+  BOOST_AUTO_TEST_CASE(cacheMissesPerEvent){
+    const unsigned int nrOfDestinations = 64;
+    const unsigned int nrOfRounds = 200;
+    CFanOutTestFB *destinations = new CFanOutTestFB[nrOfDestinations];
+    CEventConnection connection(&mSource, 0);
+    //spread the nodes of the destination list over the heap like a connection built up during a deployment
+    std::vector<char*> spacers;
+    for(unsigned int i = 0; i < nrOfDestinations; ++i){
+      BOOST_REQUIRE_EQUAL(e_RDY, connection.connect(&destinations[i], g_nStringIdREQ));
+      spacers.push_back(new char[512]);
+    }
+
+    CQueueingExecutionThread execution;
+    std::vector<char> evictionBuffer(8 * 1024 * 1024);
+    CCacheMissCounter counter;
+    TForteUInt64 misses[2] = { 0, 0 };
+    TForteUInt32 checksums[2] = { 0, 0 };
+    for(unsigned int sealed = 0; sealed < 2; ++sealed){
+      if(0 != sealed){
+        connection.seal();
+      }
+      for(unsigned int round = 0; round < nrOfRounds; ++round){
+        //evict the connection so that every round measures a dispatch with cold caches
+        for(size_t pos = 0; pos < evictionBuffer.size(); pos += 64){
+          ++evictionBuffer[pos];
+        }
+        if(counter.isAvailable()){
+          counter.start();
+        }
+        connection.triggerEvent(&execution);
+        checksums[sealed] += execution.drain();
+        if(counter.isAvailable()){
+          misses[sealed] += counter.stop();
+        }
+      }
+    }
+    BOOST_CHECK_EQUAL(checksums[0], checksums[1]);
+    if(counter.isAvailable()){
+      const double nrOfEvents = static_cast<double>(nrOfRounds * nrOfDestinations);
+      BOOST_TEST_MESSAGE("cache misses per event: destination list " << static_cast<double>(misses[0]) / nrOfEvents
+          << ", sealed array " << static_cast<double>(misses[1]) / nrOfEvents);
+    } else{
+      BOOST_TEST_MESSAGE("perf_event_open provides no cache miss counter, only the dispatch is checked");
+    }
+
+    for(unsigned int i = 0; i < nrOfDestinations; ++i){
+      delete[] spacers[i];
+    }
+    delete[] destinations;
+  }
+#endif
+
+#if defined(__linux__) && defined(FORTE_SUPPORT_MONITORING) && (FORTE_FB_ALIGNMENT > 1)
+  BOOST_AUTO_TEST_CASE(chainThroughputWithMonitoringCountersInTheFBBlock){
+    const unsigned int nrOfFBs = 512;
+    const unsigned int nrOfRounds = 200;
+    double nanoSecondsPerEvent[2] = { 0, 0 };
+    for(unsigned int inBlock = 0; inBlock < 2; ++inBlock){
+      //the counters of FBs created with new are allocated between the other allocations of a deployment
+      std::vector<CFanOutTestFB*> chain;
+      std::vector<char*> spacers;
+      for(unsigned int i = 0; i < nrOfFBs; ++i){
+        chain.push_back((0 != inBlock) ? new(scmFanOutTestInterface) CFanOutTestFB() : new CFanOutTestFB());
+        spacers.push_back(new char[256]);
+      }
+      for(unsigned int i = 0; i + 1 < nrOfFBs; ++i){
+        BOOST_REQUIRE_EQUAL(e_RDY, chain[i]->getEOConnection(g_nStringIdCNF)->connect(chain[i + 1], g_nStringIdREQ));
+      }
+      for(unsigned int i = 0; i < nrOfFBs; ++i){
+        chain[i]->changeFBExecutionState(cg_nMGM_CMD_Start);
+      }
+
+      SEventEntry start(chain[0], 0);
+      struct timespec begin;
+      struct timespec end;
+      clock_gettime(CLOCK_MONOTONIC, &begin);
+      for(unsigned int round = 1; round <= nrOfRounds; ++round){
+        CFBTestDataGlobalFixture::getResource()->getResourceEventExecution()->startEventChain(&start);
+        for(unsigned int i = 0; (i < 5000000) && (chain[nrOfFBs - 1]->getNrOfEvents() < round); ++i){
+        }
+      }
+      clock_gettime(CLOCK_MONOTONIC, &end);
+      waitForEvents(*chain[nrOfFBs - 1], nrOfRounds);
+      BOOST_CHECK_EQUAL(nrOfRounds, chain[nrOfFBs - 1]->getNrOfEvents());
+      BOOST_CHECK_EQUAL(nrOfRounds, chain[nrOfFBs - 1]->getEIMonitorData(0));
+      nanoSecondsPerEvent[inBlock] = (static_cast<double>(end.tv_sec - begin.tv_sec) * 1e9 + static_cast<double>(end.tv_nsec - begin.tv_nsec))
+          / (static_cast<double>(nrOfRounds) * nrOfFBs);
+
+      for(unsigned int i = 0; i + 1 < nrOfFBs; ++i){
+        chain[i]->getEOConnection(g_nStringIdCNF)->disconnect(chain[i + 1], g_nStringIdREQ);
+      }
+      for(unsigned int i = 0; i < nrOfFBs; ++i){
+        delete chain[i];
+        delete[] spacers[i];
+      }
+    }
+    BOOST_TEST_MESSAGE("ns per event in a chain of " << nrOfFBs << " FBs: counters allocated separately " << nanoSecondsPerEvent[0]
+        << ", counters in the FB block " << nanoSecondsPerEvent[1]);
+  }
+#endif
+
+#ifdef FORTE_SUPPORT_MONITORING
+  BOOST_AUTO_TEST_CASE(forcedPortsKeepTheirValue){
+    CFanOutTestFB &forcedDestination = mDestinations[0];
+    forcedDestination.getDI(0)->setValue(CIEC_DINT(5));
+    forcedDestination.setForced(forcedDestination.getDI(0), true);
+
+    fire(9);
+    waitForEvents(mDestinations[2], 1);
+    BOOST_CHECK_EQUAL(5, forcedDestination.getLastInput());
+    BOOST_CHECK_EQUAL(9, mDestinations[1].getLastInput());
+
+    //a forced output keeps the value it had in the connection
+    mSource.setForced(mSource.getDO(0), true);
+    fire(10);
+    waitForEvents(mDestinations[2], 2);
+    BOOST_CHECK_EQUAL(5, forcedDestination.getLastInput());
+    BOOST_CHECK_EQUAL(9, mDestinations[1].getLastInput());
+
+    mSource.setForced(mSource.getDO(0), false);
+    forcedDestination.setForced(forcedDestination.getDI(0), false);
+    BOOST_CHECK(!forcedDestination.getDI(0)->isForced());
+    fire(11);
+    waitForEvents(mDestinations[2], 3);
+    for(unsigned int i = 0; i < scmNrOfDestinations; ++i){
+      BOOST_CHECK_EQUAL(11, mDestinations[i].getLastInput());
+    }
+  }
+#endif //FORTE_SUPPORT_MONITORING
+
+BOOST_AUTO_TEST_SUITE_END()
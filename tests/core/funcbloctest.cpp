@@ -0,0 +1,111 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include <boost/test/unit_test.hpp>
+
+#include "fbtests/fbtesterglobalfixture.h"
+#include <funcbloc.h>
+
+#ifdef FORTE_ENABLE_GENERATED_SOURCE_CPP
+#include "funcbloctest_gen.cpp"
+#endif
+
+namespace {
+  const CStringDictionary::TStringId scmEINames[] = { g_nStringIdINIT, g_nStringIdREQ };
+  const CStringDictionary::TStringId scmEONames[] = { g_nStringIdCNF };
+
+  const SFBInterfaceSpec scmLayoutTestInterface = { 2, scmEINames, 0, 0, 1, scmEONames, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+  class CLayoutTestFB : public CFunctionBlock{
+    public:
+      CLayoutTestFB() :
+          CFunctionBlock(CFBTestDataGlobalFixture::getResource(), &scmLayoutTestInterface, CStringDictionary::scm_nInvalidStringId,
+              m_anFBConnData, m_anFBVarsData){
+      }
+
+      CStringDictionary::TStringId getFBTypeId(void) const {
+        return CStringDictionary::scm_nInvalidStringId;
+      }
+
+    private:
+      virtual void executeEvent(int){
+      }
+
+      FORTE_FB_DATA_ARRAY(1, 0, 0, 0)
+  };
+}
+
+BOOST_AUTO_TEST_SUITE(FunctionBlock)
+
+  BOOST_AUTO_TEST_CASE(dynamicFBsAreAligned){
+#if FORTE_FB_ALIGNMENT > 1
+    CLayoutTestFB *fbs[5];
+    for(size_t i = 0; i < sizeof(fbs) / sizeof(fbs[0]); ++i){
+      fbs[i] = new CLayoutTestFB();
+      BOOST_CHECK_EQUAL(0U, reinterpret_cast<size_t>(fbs[i]) % FORTE_FB_ALIGNMENT);
+    }
+    for(size_t i = 0; i < sizeof(fbs) / sizeof(fbs[0]); ++i){
+      delete fbs[i];
+    }
+#endif
+  }
+
+  BOOST_AUTO_TEST_CASE(failedAllocationReturnsNull){
+#if FORTE_FB_ALIGNMENT > 1
+    //a size for which the alignment overhead overflows can never be allocated
+    BOOST_CHECK(0 == CFunctionBlock::operator new(static_cast<size_t>(-1)));
+    BOOST_CHECK(0 == CFunctionBlock::operator new(static_cast<size_t>(-1) - FORTE_FB_ALIGNMENT));
+#endif
+  }
+
+#ifdef FORTE_SUPPORT_MONITORING
+  BOOST_AUTO_TEST_CASE(monitoringCountersAreSeparate){
+    CLayoutTestFB fb;
+    fb.getEIMonitorData(0) = 1;
+    fb.getEIMonitorData(1) = 2;
+    fb.getEOMonitorData(0) = 3;
+    BOOST_CHECK_EQUAL(1U, fb.getEIMonitorData(0));
+    BOOST_CHECK_EQUAL(2U, fb.getEIMonitorData(1));
+    BOOST_CHECK_EQUAL(3U, fb.getEOMonitorData(0));
+  }
+
+#if FORTE_FB_ALIGNMENT > 1
+  BOOST_AUTO_TEST_CASE(typeEntryAllocatesMonitoringCountersBehindTheFB){
+    CLayoutTestFB *fb = new(scmLayoutTestInterface) CLayoutTestFB();
+    BOOST_REQUIRE(0 != fb);
+    BOOST_CHECK_EQUAL(0U, reinterpret_cast<size_t>(fb) % FORTE_FB_ALIGNMENT);
+    const TForteByte *fbEnd = reinterpret_cast<TForteByte *>(fb) + sizeof(CLayoutTestFB);
+    const TForteByte *counters = reinterpret_cast<TForteByte *>(&fb->getEIMonitorData(0));
+    BOOST_CHECK(counters >= fbEnd);
+    BOOST_CHECK(counters < fbEnd + sizeof(TForteUInt32));
+    BOOST_CHECK(reinterpret_cast<TForteByte *>(&fb->getEOMonitorData(0)) == counters + 2 * sizeof(TForteUInt32));
+    BOOST_CHECK_EQUAL(0U, fb->getEIMonitorData(1));
+    fb->getEOMonitorData(0) = 3;
+    BOOST_CHECK_EQUAL(3U, fb->getEOMonitorData(0));
+    delete fb;
+  }
+
+  BOOST_AUTO_TEST_CASE(tooFewCountersInTheBlockAreNotUsed){
+    //an interface with less events than the one of the FB
+    const SFBInterfaceSpec smallerInterface = { 1, scmEINames, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+    CLayoutTestFB *fb = new(smallerInterface) CLayoutTestFB();
+    BOOST_REQUIRE(0 != fb);
+    const TForteByte *fbEnd = reinterpret_cast<TForteByte *>(fb) + sizeof(CLayoutTestFB);
+    const TForteByte *counters = reinterpret_cast<TForteByte *>(&fb->getEIMonitorData(0));
+    BOOST_CHECK((counters < reinterpret_cast<TForteByte *>(fb)) || (counters >= fbEnd + sizeof(TForteUInt32)));
+    fb->getEOMonitorData(0) = 3;
+    BOOST_CHECK_EQUAL(0U, fb->getEIMonitorData(1));
+    delete fb;
+  }
+#endif
+#endif //FORTE_SUPPORT_MONITORING
+
+BOOST_AUTO_TEST_SUITE_END()
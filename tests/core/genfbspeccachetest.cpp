@@ -0,0 +1,104 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include <boost/test/unit_test.hpp>
+#include "../../src/core/genfbspeccache.h"
+#include "../../src/core/typelib.h"
+#include "fbtests/fbtesterglobalfixture.h"
+
+#ifdef FORTE_ENABLE_GENERATED_SOURCE_CPP
+#include "genfbspeccachetest_gen.cpp"
+#else
+#include "stringlist.h"
+#endif
+
+namespace {
+  unsigned int gReleaseCount = 0;
+
+  void releaseTestInterfaceSpec(SFBInterfaceSpec &paInterfaceSpec){
+    delete[] paInterfaceSpec.m_aunDINames;
+    gReleaseCount++;
+  }
+
+  SFBInterfaceSpec createTestInterfaceSpec(){
+    SFBInterfaceSpec interfaceSpec = SFBInterfaceSpec();
+    interfaceSpec.m_nNumDIs = 2;
+    interfaceSpec.m_aunDINames = new CStringDictionary::TStringId[2];
+    return interfaceSpec;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(GenFBInterfaceSpecCacheTests)
+
+  BOOST_AUTO_TEST_CASE(sharedSpecIsReferenceCounted){
+    CGenFBInterfaceSpecCache &cache(CGenFBInterfaceSpecCache::getInstance());
+    const CStringDictionary::TStringId typeNameId = CStringDictionary::getInstance().insert("CACHE_TEST_2");
+    gReleaseCount = 0;
+
+    BOOST_CHECK(0 == cache.acquire(typeNameId));
+
+    const SFBInterfaceSpec *first = cache.add(typeNameId, createTestInterfaceSpec(), releaseTestInterfaceSpec);
+    BOOST_REQUIRE(0 != first);
+    const SFBInterfaceSpec *second = cache.acquire(typeNameId);
+    BOOST_CHECK_EQUAL(first, second);
+    BOOST_CHECK_EQUAL(CGenFBInterfaceSpecCache::getInterfaceArraysSize(*first), cache.getSavedMemory());
+
+    //adding a duplicate releases the new spec and returns the cached one
+    const SFBInterfaceSpec *third = cache.add(typeNameId, createTestInterfaceSpec(), releaseTestInterfaceSpec);
+    BOOST_CHECK_EQUAL(first, third);
+    BOOST_CHECK_EQUAL(1U, gReleaseCount);
+
+    cache.release(typeNameId);
+    cache.release(typeNameId);
+    BOOST_CHECK_EQUAL(1U, gReleaseCount);
+    cache.release(typeNameId);
+    BOOST_CHECK_EQUAL(2U, gReleaseCount);
+    BOOST_CHECK(0 == cache.acquire(typeNameId));
+  }
+
+  BOOST_AUTO_TEST_CASE(interfaceArraysSize){
+    const CStringDictionary::TStringId names[] = { g_nStringIdQI, g_nStringIdID };
+    const TDataIOID eiWith[] = { 0, 1, 255, 0, 255 };
+    const TForteInt16 eiWithIndexes[] = { 0, 3, -1 };
+    SFBInterfaceSpec interfaceSpec = SFBInterfaceSpec();
+    interfaceSpec.m_nNumEIs = 3;
+    interfaceSpec.m_aunEINames = names;
+    interfaceSpec.m_anEIWith = eiWith;
+    interfaceSpec.m_anEIWithIndexes = eiWithIndexes;
+    interfaceSpec.m_nNumDIs = 2;
+    interfaceSpec.m_aunDINames = names;
+    interfaceSpec.m_aunDIDataTypeNames = names;
+
+    BOOST_CHECK_EQUAL(7 * sizeof(CStringDictionary::TStringId) + 5 * sizeof(TDataIOID),
+      CGenFBInterfaceSpecCache::getInterfaceArraysSize(interfaceSpec));
+  }
+
+  BOOST_AUTO_TEST_CASE(genericInstancesShareInterfaceSpec){
+    CGenFBInterfaceSpecCache &cache(CGenFBInterfaceSpecCache::getInstance());
+    const size_t usersBefore = cache.getNumberOfUsers();
+
+    CFunctionBlock *fb1 = CTypeLib::createFB(g_nStringIdInstanceName, g_nStringIdE_MUX_3, CFBTestDataGlobalFixture::getResource());
+    CFunctionBlock *fb2 = CTypeLib::createFB(g_nStringIdInstanceName, g_nStringIdE_MUX_3, CFBTestDataGlobalFixture::getResource());
+    BOOST_REQUIRE(0 != fb1);
+    BOOST_REQUIRE(0 != fb2);
+
+    BOOST_CHECK_EQUAL(fb1->getFBInterfaceSpec(), fb2->getFBInterfaceSpec());
+    BOOST_CHECK_EQUAL(3, fb1->getFBInterfaceSpec()->m_nNumEIs);
+    BOOST_CHECK_EQUAL(g_nStringIdEI3, fb2->getFBInterfaceSpec()->m_aunEINames[2]);
+    BOOST_CHECK_EQUAL(usersBefore + 2, cache.getNumberOfUsers());
+
+    BOOST_CHECK(CTypeLib::deleteFB(fb1));
+    BOOST_CHECK_EQUAL(g_nStringIdEI3, fb2->getFBInterfaceSpec()->m_aunEINames[2]);
+    BOOST_CHECK(CTypeLib::deleteFB(fb2));
+    BOOST_CHECK_EQUAL(usersBefore, cache.getNumberOfUsers());
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
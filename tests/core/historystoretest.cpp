@@ -0,0 +1,255 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include <boost/test/unit_test.hpp>
+
+#include <historystore.h>
+#include <utils/string_utils.h>
+#include <string>
+#include <vector>
+
+#ifdef FORTE_ENABLE_GENERATED_SOURCE_CPP
+#include "historystoretest_gen.cpp"
+#endif
+
+using namespace forte::core;
+
+namespace {
+  std::string getContent(const CMGMResponseBuffer &paResponse){
+    std::vector<char> text(paResponse.length() + 1);
+    paResponse.copyTo(&text[0]);
+    return std::string(&text[0], paResponse.length());
+  }
+
+  //! Removes the current time of the device, which differs in every response
+  std::string stripNow(const std::string &paJSON){
+    size_t now = paJSON.find(",\"now\":");
+    size_t points = paJSON.find(",\"points\":");
+    return (std::string::npos == now) ? paJSON : paJSON.substr(0, now) + paJSON.substr(points);
+  }
+
+  //! Values of the raw samples of a query result
+  std::vector<TForteUInt64> getValues(const std::string &paJSON){
+    std::vector<TForteUInt64> values;
+    size_t pos = paJSON.find("\"points\":[") + sizeof("\"points\":[") - 1;
+    while('[' == paJSON[pos]){
+      pos = paJSON.find(',', pos) + 1;
+      values.push_back(forte::core::util::strtoull(paJSON.c_str() + pos, 0, 10));
+      pos = paJSON.find(']', pos) + 1;
+      if(',' == paJSON[pos]){
+        ++pos;
+      }
+    }
+    return values;
+  }
+
+  //! Parameters continuing a query with the "next" of its result, empty if the result is complete
+  std::string getNextParams(const std::string &paJSON){
+    size_t start = paJSON.find(",\"next\":{\"start\":");
+    if(std::string::npos == start){
+      return std::string();
+    }
+    start += sizeof(",\"next\":{\"start\":") - 1;
+    size_t index = paJSON.find(",\"index\":", start);
+    size_t end = paJSON.find('}', index);
+    index += sizeof(",\"index\":") - 1;
+    return "0;" + paJSON.substr(start, paJSON.find(',', start) - start) + ";;" + paJSON.substr(index, end - index);
+  }
+
+  CStringDictionary::TStringId getName(const char *paName){
+    return CStringDictionary::getInstance().insert(paName);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(HistoryStore)
+
+  BOOST_AUTO_TEST_CASE(tiersSummarizeTheTierBelow){
+    CHistoryBuffer buffer(getName("tiersSummarize"), 4, 2, 3);
+    for(unsigned int i = 1; i <= 8; ++i){
+      buffer.add(i * 10, i);
+    }
+
+    CHistoryBuffer::SPoint points[8];
+    TForteUInt64 firstIndex = 0;
+    //the raw tier keeps the last samples
+    BOOST_REQUIRE_EQUAL(4U, buffer.read(0, 0, 0, 100, points, 8, firstIndex));
+    BOOST_CHECK_EQUAL(4U, firstIndex);
+    BOOST_CHECK_EQUAL(50U, points[0].mTime);
+    BOOST_CHECK_EQUAL(5.0, points[0].mAvg);
+    BOOST_CHECK_EQUAL(8.0, points[3].mMax);
+
+    BOOST_REQUIRE_EQUAL(4U, buffer.read(1, 0, 0, 100, points, 8, firstIndex));
+    for(unsigned int i = 0; i < 4; ++i){
+      BOOST_CHECK_EQUAL(10U + i * 20U, points[i].mTime);
+      BOOST_CHECK_EQUAL(1.0 + i * 2, points[i].mMin);
+      BOOST_CHECK_EQUAL(2.0 + i * 2, points[i].mMax);
+      BOOST_CHECK_EQUAL(1.5 + i * 2, points[i].mAvg);
+    }
+
+    BOOST_REQUIRE_EQUAL(2U, buffer.read(2, 0, 0, 100, points, 8, firstIndex));
+    BOOST_CHECK_EQUAL(10U, points[0].mTime);
+    BOOST_CHECK_EQUAL(1.0, points[0].mMin);
+    BOOST_CHECK_EQUAL(4.0, points[0].mMax);
+    BOOST_CHECK_EQUAL(2.5, points[0].mAvg);
+    BOOST_CHECK_EQUAL(50U, points[1].mTime);
+    BOOST_CHECK_EQUAL(6.5, points[1].mAvg);
+
+    BOOST_CHECK_EQUAL(0U, buffer.read(3, 0, 0, 100, points, 8, firstIndex));
+  }
+
+  BOOST_AUTO_TEST_CASE(readTimeRange){
+    CHistoryBuffer buffer(getName("readTimeRange"), 5, 2, 1);
+    for(unsigned int i = 1; i <= 12; ++i){
+      buffer.add(i * 10, i);
+    }
+    CHistoryBuffer::SPoint points[5];
+    TForteUInt64 firstIndex = 0;
+    BOOST_REQUIRE_EQUAL(2U, buffer.read(0, 95, 0, 110, points, 5, firstIndex));
+    BOOST_CHECK_EQUAL(9U, firstIndex);
+    BOOST_CHECK_EQUAL(100U, points[0].mTime);
+    BOOST_CHECK_EQUAL(110U, points[1].mTime);
+    BOOST_CHECK_EQUAL(0U, buffer.read(0, 0, 0, 79, points, 5, firstIndex));
+    BOOST_CHECK_EQUAL(0U, buffer.read(0, 121, 0, 200, points, 5, firstIndex));
+    //the result is limited to the given space
+    BOOST_REQUIRE_EQUAL(3U, buffer.read(0, 0, 0, 200, points, 3, firstIndex));
+    BOOST_CHECK_EQUAL(80U, points[0].mTime);
+  }
+
+  BOOST_AUTO_TEST_CASE(storeLimitsTheMemory){
+    CHistoryStore store(2 * CHistoryBuffer::getMemorySize(10, 2));
+    CHistoryStore::EError error;
+    CHistoryBuffer *first = store.createBuffer(getName("storeLimitsFirst"), 10, 4, 2, error);
+    BOOST_REQUIRE(0 != first);
+    BOOST_CHECK_EQUAL(CHistoryStore::eOk, error);
+
+    BOOST_CHECK(0 == store.createBuffer(getName("storeLimitsFirst"), 10, 4, 2, error));
+    BOOST_CHECK_EQUAL(CHistoryStore::eNameInUse, error);
+    BOOST_CHECK(0 == store.createBuffer(getName("storeLimitsSecond"), 11, 4, 2, error));
+    BOOST_CHECK_EQUAL(CHistoryStore::eMemoryLimit, error);
+    BOOST_CHECK(0 == store.createBuffer(getName("storeLimitsSecond"), 10, 1, 2, error));
+    BOOST_CHECK_EQUAL(CHistoryStore::eInvalidConfiguration, error);
+    BOOST_CHECK(0 == store.createBuffer(getName("storeLimitsSecond"), 10, 4, CHistoryBuffer::scmMaxTiers + 1, error));
+    BOOST_CHECK_EQUAL(CHistoryStore::eInvalidConfiguration, error);
+
+    CHistoryBuffer *second = store.createBuffer(getName("storeLimitsSecond"), 10, 4, 2, error);
+    BOOST_CHECK(0 != second);
+    BOOST_CHECK_EQUAL(store.getMemoryLimit(), store.getMemoryUsed());
+
+    store.deleteBuffer(first);
+    BOOST_CHECK_EQUAL(CHistoryBuffer::getMemorySize(10, 2), store.getMemoryUsed());
+    BOOST_CHECK(0 != store.createBuffer(getName("storeLimitsFirst"), 20, 4, 1, error));
+  }
+
+  BOOST_AUTO_TEST_CASE(queryWritesJSON){
+    CHistoryStore store;
+    CHistoryStore::EError error;
+    CStringDictionary::TStringId name = getName("querySignal");
+    CHistoryBuffer *buffer = store.createBuffer(name, 10, 2, 2, error);
+    BOOST_REQUIRE(0 != buffer);
+    buffer->add(1, 1.5);
+    buffer->add(2, -2);
+    buffer->add(3, 3);
+
+    CMGMResponseBuffer response;
+    BOOST_CHECK_EQUAL(e_RDY, store.query(name, "", response));
+    std::string json(getContent(response));
+    BOOST_CHECK_EQUAL(0U, json.find("{\"name\":\"querySignal\",\"tier\":0,\"samples\":1,\"now\":"));
+    BOOST_CHECK_EQUAL(std::string("{\"name\":\"querySignal\",\"tier\":0,\"samples\":1,\"points\":[[1,1.5],[2,-2],[3,3]]}"),
+        stripNow(json));
+
+    response.reset();
+    BOOST_CHECK_EQUAL(e_RDY, store.query(name, "1;;", response));
+    BOOST_CHECK_EQUAL(std::string("{\"name\":\"querySignal\",\"tier\":1,\"samples\":2,\"points\":[[1,-2,1.5,-0.25]]}"),
+        stripNow(getContent(response)));
+
+    response.reset();
+    BOOST_CHECK_EQUAL(e_RDY, store.query(name, "0;2;2", response));
+    BOOST_CHECK_EQUAL(std::string("{\"name\":\"querySignal\",\"tier\":0,\"samples\":1,\"points\":[[2,-2]]}"),
+        stripNow(getContent(response)));
+
+    response.reset();
+    BOOST_CHECK_EQUAL(e_INVALID_OBJECT, store.query(name, "2", response));
+    BOOST_CHECK_EQUAL(e_NO_SUCH_OBJECT, store.query(getName("queryUnknownSignal"), "", response));
+    BOOST_CHECK_EQUAL(e_NO_SUCH_OBJECT, store.query(CStringDictionary::scm_nInvalidStringId, "", response));
+  }
+
+  BOOST_AUTO_TEST_CASE(queryPagesByTimeAndIndex){
+    CHistoryStore store;
+    CHistoryStore::EError error;
+    CStringDictionary::TStringId name = getName("pagedSignal");
+    CHistoryBuffer *buffer = store.createBuffer(name, 100, 2, 1, error);
+    BOOST_REQUIRE(0 != buffer);
+    //several samples share a time, more than a chunk read at once and more than fit on a page
+    const TForteUInt64 samplesPerTime = 37;
+    TForteUInt64 value = 1;
+    for(; value <= 100; ++value){
+      buffer->add(value / samplesPerTime, static_cast<double>(value));
+    }
+
+    std::vector<TForteUInt64> values;
+    CMGMResponseBuffer response;
+    std::string params("0;0");
+    unsigned int pages = 0;
+    TForteUInt64 newest;
+    for(;;){
+      newest = value - 1;
+      response.reset(0, 400);
+      BOOST_REQUIRE_EQUAL(e_RDY, store.query(name, params.c_str(), response));
+      std::string json(getContent(response));
+      std::vector<TForteUInt64> page(getValues(json));
+      BOOST_REQUIRE(!page.empty());
+      values.insert(values.end(), page.begin(), page.end());
+      ++pages;
+      BOOST_REQUIRE(pages < 100);
+
+      //new samples push the oldest ones out of the buffer between the pages
+      for(unsigned int i = 0; i < 5; ++i, ++value){
+        buffer->add(value / samplesPerTime, static_cast<double>(value));
+      }
+
+      params = getNextParams(json);
+      if(params.empty()){
+        break;
+      }
+    }
+
+    BOOST_CHECK(pages > 1);
+    BOOST_CHECK_EQUAL(1U, values.front());
+    BOOST_CHECK_EQUAL(newest, values.back());
+    //no point is skipped or repeated
+    for(size_t i = 1; i < values.size(); ++i){
+      BOOST_CHECK_EQUAL(values[i - 1] + 1, values[i]);
+    }
+  }
+
+  BOOST_AUTO_TEST_CASE(readSkipsEntriesBeforeIndex){
+    CHistoryStore store;
+    CHistoryStore::EError error;
+    CHistoryBuffer *buffer = store.createBuffer(getName("indexedSignal"), 4, 2, 1, error);
+    BOOST_REQUIRE(0 != buffer);
+    for(unsigned int i = 0; i < 6; ++i){
+      buffer->add(7, static_cast<double>(i));
+    }
+
+    //indices 0 and 1 were pushed out, the buffer holds 2 to 5
+    CHistoryBuffer::SPoint points[4];
+    TForteUInt64 firstIndex = 0;
+    BOOST_CHECK_EQUAL(4U, buffer->read(0, 7, 0, 7, points, 4, firstIndex));
+    BOOST_CHECK_EQUAL(2U, firstIndex);
+    BOOST_CHECK_EQUAL(2, points[0].mAvg);
+    BOOST_CHECK_EQUAL(2U, buffer->read(0, 7, 4, 7, points, 4, firstIndex));
+    BOOST_CHECK_EQUAL(4U, firstIndex);
+    BOOST_CHECK_EQUAL(4, points[0].mAvg);
+    BOOST_CHECK_EQUAL(0U, buffer->read(0, 7, 6, 7, points, 4, firstIndex));
+    BOOST_CHECK_EQUAL(0U, buffer->read(0, 8, 4, 8, points, 4, firstIndex));
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,374 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include <boost/test/unit_test.hpp>
+
+#include "../../../src/core/io/device/io_controller_poll.h"
+#include "../../../src/core/io/configFB/io_configFB_controller.h"
+#include "../../../src/core/io/mapper/io_observer.h"
+#include "../../../src/core/devexec.h"
+#include "../../../src/core/resource.h"
+#include "../../../src/core/ecet.h"
+#include "../../../src/core/datatypes/forte_word.h"
+#include "../../../src/core/datatypes/forte_udint.h"
+#include "../../../src/core/datatypes/forte_time.h"
+#include "../fbtests/fbtesterglobalfixture.h"
+#include <string.h>
+
+#ifdef FORTE_ENABLE_GENERATED_SOURCE_CPP
+#include "io_controller_poll_test_gen.cpp"
+#endif
+
+using namespace forte::core::io;
+
+namespace {
+  /** Poll controller of a fake device with an input and an output register block */
+  class CPollTestController : public IODevicePollController {
+    public:
+      class TestHandleDescriptor : public HandleDescriptor {
+        public:
+          TestHandleDescriptor(CIEC_WSTRING const &paId, IOMapper::Direction paDirection, CIEC_ANY::EDataTypeID paType, unsigned int paOffset) :
+              HandleDescriptor(paId, paDirection), mType(paType), mOffset(paOffset) {
+          }
+
+          CIEC_ANY::EDataTypeID mType;
+          unsigned int mOffset;
+      };
+
+      static const unsigned int scmInputAddress = 0x100;
+      static const unsigned int scmOutputAddress = 0x200;
+
+      explicit CPollTestController(CDeviceExecution &paDeviceExecution) :
+          IODevicePollController(paDeviceExecution, 10), mImage(4, 2), mReads(0), mWrites(0), mFailReads(false) {
+        memset(mDeviceInputs, 0, sizeof(mDeviceInputs));
+        memset(mDeviceOutputs, 0, sizeof(mDeviceOutputs));
+        setProcessImage(&mImage);
+        addInputBlock(scmInputAddress, 0, 4);
+        addOutputBlock(scmOutputAddress, 0, 2);
+        addInputBlock(scmInputAddress, 2, 4); //does not fit into the image
+      }
+
+      virtual ~CPollTestController() {
+        deleteHandles(mInputHandles);
+        deleteHandles(mOutputHandles);
+      }
+
+      void setConfig(Config*) {
+      }
+
+      void addImageHandle(CIEC_WSTRING const &paId, IOMapper::Direction paDirection, CIEC_ANY::EDataTypeID paType, unsigned int paOffset) {
+        TestHandleDescriptor descriptor(paId, paDirection, paType, paOffset);
+        IODeviceController::addHandle(&descriptor);
+      }
+
+      using IODevicePollController::pollCycle;
+      using IODevicePollController::setPollInterval;
+      using IODevicePollController::setAdaptivePollInterval;
+
+      bool failed() const {
+        return hasError();
+      }
+
+      TForteUInt64 getCyclePeriod() const {
+        Statistics statistics;
+        getStatistics(statistics);
+        return statistics.mCyclePeriod;
+      }
+
+      void startPolling() {
+        start();
+      }
+
+      void stopPolling() {
+        setAlive(false);
+        forcePoll();
+        end();
+      }
+
+      IOProcessImage mImage;
+      TForteByte mDeviceInputs[4];
+      TForteByte mDeviceOutputs[2];
+      unsigned int mReads;
+      unsigned int mWrites;
+      bool mFailReads;
+
+    protected:
+      const char* init() {
+        return 0;
+      }
+
+      void deInit() {
+      }
+
+      IOHandle* initHandle(HandleDescriptor *paHandleDescriptor) {
+        TestHandleDescriptor *descriptor = static_cast<TestHandleDescriptor*>(paHandleDescriptor);
+        return createImageHandle(descriptor->mDirection, descriptor->mType, descriptor->mOffset);
+      }
+
+      bool readBlock(unsigned int paAddress, TForteByte *paData, unsigned int paSize) {
+        BOOST_CHECK_EQUAL(scmInputAddress, paAddress);
+        BOOST_CHECK_EQUAL(sizeof(mDeviceInputs), paSize);
+        ++mReads;
+        memcpy(paData, mDeviceInputs, paSize);
+        return !mFailReads;
+      }
+
+      bool writeBlock(unsigned int paAddress, const TForteByte *paData, unsigned int paSize) {
+        BOOST_CHECK_EQUAL(scmOutputAddress, paAddress);
+        BOOST_CHECK_EQUAL(sizeof(mDeviceOutputs), paSize);
+        ++mWrites;
+        memcpy(mDeviceOutputs, paData, paSize);
+        return true;
+      }
+
+    private:
+      static void deleteHandles(THandleList &paHandles) {
+        for(THandleList::Iterator it = paHandles.begin(); it != paHandles.end(); ++it) {
+          IOMapper::getInstance().deregisterHandle(*it);
+          delete *it;
+        }
+        paHandles.clearAll();
+      }
+  };
+
+  const unsigned int CPollTestController::scmInputAddress;
+  const unsigned int CPollTestController::scmOutputAddress;
+
+  /** Counts the changes it is notified about, never triggers an indication event */
+  class CCountingObserver : public IOObserver {
+    public:
+      CCountingObserver() :
+          mChanges(0) {
+      }
+
+      bool onChange() {
+        ++mChanges;
+        return false;
+      }
+
+      IOHandle* getHandle() {
+        return mHandle;
+      }
+
+      unsigned int mChanges;
+  };
+
+  /** Configuration fb of the fake device offering the statistics outputs */
+  class CPollTestConfigFB : public IOConfigFBController {
+    public:
+      explicit CPollTestConfigFB(CResource *paSrcRes) :
+          IOConfigFBController(paSrcRes, &scm_stFBInterfaceSpec, CStringDictionary::scm_nInvalidStringId, m_anFBConnData, m_anFBVarsData) {
+        //new FBs are killed, only running FBs process events
+        changeFBExecutionState(cg_nMGM_CMD_Reset);
+        changeFBExecutionState(cg_nMGM_CMD_Start);
+      }
+
+      virtual ~CPollTestConfigFB() {
+        changeFBExecutionState(cg_nMGM_CMD_Stop);
+      }
+
+      CStringDictionary::TStringId getFBTypeId() const {
+        return CStringDictionary::scm_nInvalidStringId;
+      }
+
+      static const TEventID scmEventREQID = 1;
+
+      using IOConfigFBController::scmEventINITID;
+      using IOConfigFBController::QI;
+      using IOConfigFBController::QO;
+
+      CIEC_UDINT &CYCLES() {
+        return *static_cast<CIEC_UDINT*>(getDO(2));
+      }
+
+      CIEC_TIME &PERIOD() {
+        return *static_cast<CIEC_TIME*>(getDO(6));
+      }
+
+      //! Triggers the event in the resource and waits until it is processed
+      void trigger(TEventID paEIID) {
+        SEventEntry entry(this, paEIID);
+        CEventChainExecutionThread *execution = getResource().getResourceEventExecution();
+        execution->startEventChain(&entry);
+        do {
+          CThread::sleepThread(1);
+        } while(execution->isProcessingEvents());
+      }
+
+    protected:
+      IODeviceController* createDeviceController(CDeviceExecution &paDeviceExecution) {
+        return new CPollTestController(paDeviceExecution);
+      }
+
+      void setConfig() {
+      }
+
+    private:
+      static const CStringDictionary::TStringId scm_anDataOutputNames[];
+      static const CStringDictionary::TStringId scm_anDataOutputTypeIds[];
+      static const CStringDictionary::TStringId scm_anEventInputNames[];
+      static const CStringDictionary::TStringId scm_anEventOutputNames[];
+      static const CStringDictionary::TStringId scm_anDataInputNames[];
+      static const CStringDictionary::TStringId scm_anDataInputTypeIds[];
+      static const SFBInterfaceSpec scm_stFBInterfaceSpec;
+
+      FORTE_FB_DATA_ARRAY(3, 1, 7, 0);
+  };
+
+  const CStringDictionary::TStringId CPollTestConfigFB::scm_anDataInputNames[] = { g_nStringIdQI };
+  const CStringDictionary::TStringId CPollTestConfigFB::scm_anDataInputTypeIds[] = { g_nStringIdBOOL };
+  const CStringDictionary::TStringId CPollTestConfigFB::scm_anDataOutputNames[] = { g_nStringIdQO, g_nStringIdSTATUS, g_nStringIdCYCLES,
+    g_nStringIdBUSTIME, g_nStringIdMAXBUSTIME, g_nStringIdAVGBUSTIME, g_nStringIdPERIOD };
+  const CStringDictionary::TStringId CPollTestConfigFB::scm_anDataOutputTypeIds[] = { g_nStringIdBOOL, g_nStringIdWSTRING, g_nStringIdUDINT,
+    g_nStringIdTIME, g_nStringIdTIME, g_nStringIdTIME, g_nStringIdTIME };
+  const CStringDictionary::TStringId CPollTestConfigFB::scm_anEventInputNames[] = { g_nStringIdINIT, g_nStringIdREQ };
+  const CStringDictionary::TStringId CPollTestConfigFB::scm_anEventOutputNames[] = { g_nStringIdINITO, g_nStringIdIND, g_nStringIdCNF };
+  const SFBInterfaceSpec CPollTestConfigFB::scm_stFBInterfaceSpec = {
+    2, scm_anEventInputNames, 0, 0,
+    3, scm_anEventOutputNames, 0, 0,
+    1, scm_anDataInputNames, scm_anDataInputTypeIds,
+    7, scm_anDataOutputNames, scm_anDataOutputTypeIds,
+    0, 0
+  };
+}
+
+BOOST_AUTO_TEST_SUITE(IODevicePollController_Test)
+
+  BOOST_AUTO_TEST_CASE(blocksAreTransferredInOnePiece) {
+    CDeviceExecution deviceExecution;
+    CPollTestController controller(deviceExecution);
+    controller.addImageHandle("PollTest.IW0", IOMapper::In, CIEC_ANY::e_WORD, 0);
+    controller.addImageHandle("PollTest.IW1", IOMapper::In, CIEC_ANY::e_WORD, 2);
+    controller.addImageHandle("PollTest.QB0", IOMapper::Out, CIEC_ANY::e_BYTE, 0);
+    controller.addImageHandle("PollTest.QB1", IOMapper::Out, CIEC_ANY::e_BYTE, 1);
+
+    CCountingObserver word0;
+    CCountingObserver word1;
+    CCountingObserver byte0;
+    CCountingObserver byte1;
+    IOMapper &mapper = IOMapper::getInstance();
+    BOOST_REQUIRE(mapper.registerObserver("PollTest.IW0", &word0));
+    BOOST_REQUIRE(mapper.registerObserver("PollTest.IW1", &word1));
+    BOOST_REQUIRE(mapper.registerObserver("PollTest.QB0", &byte0));
+    BOOST_REQUIRE(mapper.registerObserver("PollTest.QB1", &byte1));
+
+    TForteWord raw = 0x4321;
+    memcpy(controller.mDeviceInputs + 2, &raw, sizeof(raw));
+    controller.pollCycle();
+    BOOST_CHECK_EQUAL(1U, controller.mReads);
+    BOOST_CHECK_EQUAL(0U, word0.mChanges);
+    BOOST_CHECK_EQUAL(1U, word1.mChanges);
+    CIEC_WORD value;
+    word1.getHandle()->get(value);
+    BOOST_CHECK_EQUAL(0x4321, static_cast<TForteWord>(value));
+
+    // outputs are only written in cycles after they changed, both bytes with one transfer
+    BOOST_CHECK_EQUAL(0U, controller.mWrites);
+    byte0.getHandle()->set(CIEC_BYTE(0x12));
+    byte1.getHandle()->set(CIEC_BYTE(0x34));
+    controller.pollCycle();
+    BOOST_CHECK_EQUAL(1U, controller.mWrites);
+    BOOST_CHECK_EQUAL(0x12, controller.mDeviceOutputs[0]);
+    BOOST_CHECK_EQUAL(0x34, controller.mDeviceOutputs[1]);
+    controller.pollCycle();
+    BOOST_CHECK_EQUAL(1U, controller.mWrites);
+    BOOST_CHECK_EQUAL(3U, controller.mReads);
+
+    controller.mFailReads = true;
+    controller.pollCycle();
+    BOOST_CHECK(controller.failed());
+
+  }
+
+  BOOST_AUTO_TEST_CASE(intervalAdaptsToInputChanges) {
+    CDeviceExecution deviceExecution;
+    CPollTestController controller(deviceExecution);
+    controller.addImageHandle("PollTest.IB0", IOMapper::In, CIEC_ANY::e_BYTE, 0);
+    CCountingObserver input;
+    BOOST_REQUIRE(IOMapper::getInstance().registerObserver("PollTest.IB0", &input));
+
+    const TForteUInt64 idlePeriod = 10000000; // 10 ms
+    const TForteUInt64 busyPeriod = 1000000; // 1 ms
+    BOOST_CHECK_EQUAL(idlePeriod, controller.getCyclePeriod());
+
+    // without an adaptive interval the period does not change
+    controller.mDeviceInputs[0] = 1;
+    controller.pollCycle();
+    BOOST_CHECK_EQUAL(idlePeriod, controller.getCyclePeriod());
+
+    controller.setAdaptivePollInterval(1);
+    controller.mDeviceInputs[0] = 2;
+    controller.pollCycle();
+    BOOST_CHECK_EQUAL(busyPeriod, controller.getCyclePeriod());
+    controller.mDeviceInputs[0] = 3;
+    controller.pollCycle();
+    BOOST_CHECK_EQUAL(busyPeriod, controller.getCyclePeriod());
+
+    // stable inputs double the interval until the configured interval is reached
+    TForteUInt64 expected = busyPeriod;
+    for(unsigned int i = 0; i < 3; ++i) {
+      controller.pollCycle();
+      expected *= 2;
+      BOOST_CHECK_EQUAL(expected, controller.getCyclePeriod());
+    }
+    controller.pollCycle();
+    BOOST_CHECK_EQUAL(idlePeriod, controller.getCyclePeriod());
+    controller.pollCycle();
+    BOOST_CHECK_EQUAL(idlePeriod, controller.getCyclePeriod());
+
+    controller.mDeviceInputs[0] = 4;
+    controller.pollCycle();
+    BOOST_CHECK_EQUAL(busyPeriod, controller.getCyclePeriod());
+    BOOST_CHECK_EQUAL(4U, input.mChanges);
+  }
+
+  BOOST_AUTO_TEST_CASE(busTimeStatistics) {
+    CDeviceExecution deviceExecution;
+    CPollTestController controller(deviceExecution);
+    controller.setPollInterval(1);
+    controller.startPolling();
+    CThread::sleepThread(100);
+    controller.stopPolling();
+
+    IODeviceController::Statistics statistics;
+    BOOST_REQUIRE(controller.getStatistics(statistics));
+    BOOST_CHECK_GT(statistics.mCycles, 10U);
+    BOOST_CHECK_EQUAL(controller.mReads, statistics.mCycles);
+    BOOST_CHECK_GT(statistics.mMaxBusTime, 0U);
+    BOOST_CHECK_LE(statistics.mLastBusTime, statistics.mMaxBusTime);
+    BOOST_CHECK_LE(statistics.mAverageBusTime, statistics.mMaxBusTime);
+    BOOST_CHECK_EQUAL(1000000U, statistics.mCyclePeriod);
+  }
+
+  BOOST_AUTO_TEST_CASE(configFBOutputsStatistics) {
+    CPollTestConfigFB configFB(CFBTestDataGlobalFixture::getResource());
+    configFB.QI() = true;
+    configFB.trigger(CPollTestConfigFB::scmEventINITID);
+    // the controller confirms its start with an external event
+    for(unsigned int i = 0; i < 200 && !configFB.QO(); ++i) {
+      CThread::sleepThread(10);
+    }
+    BOOST_REQUIRE(configFB.QO());
+    BOOST_CHECK_EQUAL(10, configFB.PERIOD().getInMilliSeconds());
+
+    CThread::sleepThread(50);
+    configFB.trigger(CPollTestConfigFB::scmEventREQID);
+    TForteUInt32 cycles = configFB.CYCLES();
+    BOOST_CHECK_GT(cycles, 0U);
+    BOOST_CHECK_EQUAL(10, configFB.PERIOD().getInMilliSeconds());
+
+    configFB.QI() = false;
+    configFB.trigger(CPollTestConfigFB::scmEventINITID);
+    BOOST_CHECK_EQUAL(0U, static_cast<TForteUInt32>(configFB.CYCLES()));
+    BOOST_CHECK_EQUAL(0, configFB.PERIOD().getInMilliSeconds());
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
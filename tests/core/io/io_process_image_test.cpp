@@ -0,0 +1,270 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include <boost/test/unit_test.hpp>
+
+#include "../../../src/core/io/mapper/io_process_image.h"
+#include "../../../src/core/io/mapper/io_observer.h"
+#include "../../../src/core/io/device/io_controller.h"
+#include "../../../src/core/devexec.h"
+#include "../../../src/core/datatypes/forte_word.h"
+#include "../../../src/core/datatypes/forte_dword.h"
+#include <string.h>
+
+using namespace forte::core::io;
+
+namespace {
+  IOProcessImage::Location getLocation(CIEC_ANY::EDataTypeID paType, unsigned int paOffset, unsigned int paPosition = 0) {
+    IOProcessImage::Location location;
+    BOOST_REQUIRE(IOProcessImage::getLocation(paType, paOffset, paPosition, location));
+    return location;
+  }
+
+  /** Controller in the process image mode which is driven by the test instead of its own thread */
+  class CImageTestController : public IODeviceController {
+    public:
+      class TestHandleDescriptor : public HandleDescriptor {
+        public:
+          TestHandleDescriptor(CIEC_WSTRING const &paId, IOMapper::Direction paDirection, CIEC_ANY::EDataTypeID paType, unsigned int paOffset,
+              unsigned int paPosition) :
+              HandleDescriptor(paId, paDirection), mType(paType), mOffset(paOffset), mPosition(paPosition) {
+          }
+
+          CIEC_ANY::EDataTypeID mType;
+          unsigned int mOffset;
+          unsigned int mPosition;
+      };
+
+      explicit CImageTestController(CDeviceExecution &paDeviceExecution) :
+          IODeviceController(paDeviceExecution), mImage(4, 4), mTriggers(0) {
+        setProcessImage(&mImage);
+      }
+
+      virtual ~CImageTestController() {
+        deleteHandles(mInputHandles);
+        deleteHandles(mOutputHandles);
+      }
+
+      void setConfig(Config*) {
+      }
+
+      void addImageHandle(CIEC_WSTRING const &paId, IOMapper::Direction paDirection, CIEC_ANY::EDataTypeID paType, unsigned int paOffset,
+          unsigned int paPosition = 0) {
+        TestHandleDescriptor descriptor(paId, paDirection, paType, paOffset, paPosition);
+        IODeviceController::addHandle(&descriptor);
+      }
+
+      void scan(const TForteByte *paInputs) {
+        memcpy(mImage.beginInputScan(), paInputs, mImage.getInputSize());
+        commitInputImage();
+      }
+
+      void handleChangeEvent(IOHandle*) {
+        ++mTriggers;
+      }
+
+      IOProcessImage mImage;
+      unsigned int mTriggers;
+
+    protected:
+      const char* init() {
+        return 0;
+      }
+
+      void runLoop() {
+      }
+
+      void deInit() {
+      }
+
+      IOHandle* initHandle(HandleDescriptor *paHandleDescriptor) {
+        TestHandleDescriptor *descriptor = static_cast<TestHandleDescriptor*>(paHandleDescriptor);
+        return createImageHandle(descriptor->mDirection, descriptor->mType, descriptor->mOffset, descriptor->mPosition);
+      }
+
+    private:
+      static void deleteHandles(THandleList &paHandles) {
+        for(THandleList::Iterator it = paHandles.begin(); it != paHandles.end(); ++it) {
+          delete *it;
+        }
+        paHandles.clearAll();
+      }
+  };
+
+  /** Counts the changes it is notified about, never triggers an indication event */
+  class CCountingObserver : public IOObserver {
+    public:
+      CCountingObserver() :
+          mChanges(0) {
+      }
+
+      bool onChange() {
+        ++mChanges;
+        return false;
+      }
+
+      IOHandle* getHandle() {
+        return mHandle;
+      }
+
+      unsigned int mChanges;
+  };
+}
+
+BOOST_AUTO_TEST_SUITE(IOProcessImage_Test)
+
+  BOOST_AUTO_TEST_CASE(locations) {
+    IOProcessImage::Location location;
+    BOOST_CHECK(IOProcessImage::getLocation(CIEC_ANY::e_BOOL, 3, 7, location));
+    BOOST_CHECK_EQUAL(0x80, location.mMask);
+    BOOST_CHECK(!IOProcessImage::getLocation(CIEC_ANY::e_BOOL, 3, 8, location));
+    BOOST_CHECK(!IOProcessImage::getLocation(CIEC_ANY::e_STRING, 0, 0, location));
+    BOOST_CHECK(IOProcessImage::getLocation(CIEC_ANY::e_DWORD, 1, 0, location));
+    BOOST_CHECK_EQUAL(4U, location.mSize);
+
+    IOProcessImage image(4, 2);
+    BOOST_CHECK(!image.isInInputImage(location));
+    BOOST_CHECK(image.isInInputImage(getLocation(CIEC_ANY::e_DWORD, 0)));
+    BOOST_CHECK(!image.isInOutputImage(getLocation(CIEC_ANY::e_BOOL, 2, 0)));
+  }
+
+  BOOST_AUTO_TEST_CASE(readersSeeCommittedSnapshotOnly) {
+    IOProcessImage image(4, 0);
+    IOProcessImage::Location bit = getLocation(CIEC_ANY::e_BOOL, 0, 1);
+    IOProcessImage::Location word = getLocation(CIEC_ANY::e_WORD, 2);
+    CIEC_BOOL bitValue;
+    CIEC_WORD wordValue;
+
+    TForteByte *scan = image.beginInputScan();
+    scan[0] = 0x02;
+    TForteWord raw = 0x1234;
+    memcpy(scan + 2, &raw, sizeof(raw));
+    // the scan is not visible before it is committed
+    image.readInput(bit, bitValue);
+    image.readInput(word, wordValue);
+    BOOST_CHECK_EQUAL(false, static_cast<bool>(bitValue));
+    BOOST_CHECK_EQUAL(0, static_cast<TForteWord>(wordValue));
+
+    image.commitInputs();
+    image.readInput(bit, bitValue);
+    image.readInput(word, wordValue);
+    BOOST_CHECK_EQUAL(true, static_cast<bool>(bitValue));
+    BOOST_CHECK_EQUAL(0x1234, static_cast<TForteWord>(wordValue));
+    BOOST_CHECK(image.hasInputChanged(bit));
+    BOOST_CHECK(image.hasInputChanged(word));
+    BOOST_CHECK(!image.hasInputChanged(getLocation(CIEC_ANY::e_BOOL, 0, 0)));
+
+    // a partial scan keeps the values it does not touch
+    scan = image.beginInputScan();
+    scan[0] = 0x03;
+    image.commitInputs();
+    image.readInput(word, wordValue);
+    BOOST_CHECK_EQUAL(0x1234, static_cast<TForteWord>(wordValue));
+    BOOST_CHECK(!image.hasInputChanged(bit));
+    BOOST_CHECK(image.hasInputChanged(getLocation(CIEC_ANY::e_BOOL, 0, 0)));
+    BOOST_CHECK_EQUAL(2U, image.getNrOfInputCommits());
+
+    TForteByte snapshot[4];
+    image.copyInputImage(snapshot);
+    BOOST_CHECK_EQUAL(0x03, snapshot[0]);
+  }
+
+  BOOST_AUTO_TEST_CASE(outputsAreFlushedOncePerCycle) {
+    IOProcessImage image(0, 4);
+    TForteByte transfer[4] = { 0, 0, 0, 0 };
+    BOOST_CHECK(!image.flushOutputs(transfer));
+
+    BOOST_CHECK(image.stageOutput(getLocation(CIEC_ANY::e_BOOL, 0, 0), CIEC_BOOL(true)));
+    BOOST_CHECK(!image.stageOutput(getLocation(CIEC_ANY::e_BOOL, 0, 3), CIEC_BOOL(true)));
+    BOOST_CHECK(!image.stageOutput(getLocation(CIEC_ANY::e_BYTE, 1), CIEC_BYTE(0xAB)));
+    BOOST_CHECK_EQUAL(0, transfer[0]);
+
+    BOOST_CHECK(image.flushOutputs(transfer));
+    BOOST_CHECK_EQUAL(0x09, transfer[0]);
+    BOOST_CHECK_EQUAL(0xAB, transfer[1]);
+    BOOST_CHECK(!image.flushOutputs(transfer));
+    BOOST_CHECK_EQUAL(1U, image.getNrOfOutputFlushes());
+
+    BOOST_CHECK(image.resetOutput(getLocation(CIEC_ANY::e_BOOL, 0, 3)));
+    BOOST_CHECK(image.flushOutputs(transfer));
+    BOOST_CHECK_EQUAL(0x01, transfer[0]);
+    CIEC_BOOL staged;
+    image.readOutput(getLocation(CIEC_ANY::e_BOOL, 0, 0), staged);
+    BOOST_CHECK_EQUAL(true, static_cast<bool>(staged));
+  }
+
+  BOOST_AUTO_TEST_CASE(controllerNotifiesChangedInputsOnly) {
+    CDeviceExecution deviceExecution;
+    CImageTestController controller(deviceExecution);
+    controller.addImageHandle("ImageTest.IX0", IOMapper::In, CIEC_ANY::e_BOOL, 0, 0);
+    controller.addImageHandle("ImageTest.IX1", IOMapper::In, CIEC_ANY::e_BOOL, 0, 1);
+    controller.addImageHandle("ImageTest.IW1", IOMapper::In, CIEC_ANY::e_WORD, 2);
+    controller.addImageHandle("ImageTest.QX0", IOMapper::Out, CIEC_ANY::e_BOOL, 0, 0);
+    controller.addImageHandle("ImageTest.Invalid", IOMapper::In, CIEC_ANY::e_DWORD, 2);
+
+    CCountingObserver bit0;
+    CCountingObserver bit1;
+    CCountingObserver word;
+    CCountingObserver output;
+    CCountingObserver invalid;
+    IOMapper &mapper = IOMapper::getInstance();
+    BOOST_REQUIRE(mapper.registerObserver("ImageTest.IX0", &bit0));
+    BOOST_REQUIRE(mapper.registerObserver("ImageTest.IX1", &bit1));
+    BOOST_REQUIRE(mapper.registerObserver("ImageTest.IW1", &word));
+    BOOST_REQUIRE(mapper.registerObserver("ImageTest.QX0", &output));
+    BOOST_REQUIRE(mapper.registerObserver("ImageTest.Invalid", &invalid));
+    BOOST_REQUIRE(0 != bit0.getHandle());
+    BOOST_CHECK(0 == invalid.getHandle());
+
+    IOProcessImage::Location location;
+    BOOST_CHECK(&controller.mImage == bit0.getHandle()->getProcessImage(location));
+    BOOST_CHECK_EQUAL(0x01, location.mMask);
+
+    const TForteByte firstScan[] = { 0x02, 0, 0x34, 0x12 };
+    controller.scan(firstScan);
+    BOOST_CHECK_EQUAL(0U, bit0.mChanges);
+    BOOST_CHECK_EQUAL(1U, bit1.mChanges);
+    BOOST_CHECK_EQUAL(1U, word.mChanges);
+    controller.scan(firstScan);
+    BOOST_CHECK_EQUAL(1U, bit1.mChanges);
+    BOOST_CHECK_EQUAL(1U, word.mChanges);
+
+    CIEC_BOOL value;
+    bit1.getHandle()->get(value);
+    BOOST_CHECK_EQUAL(true, static_cast<bool>(value));
+
+    // writing outputs triggers the controller once per cycle
+    output.getHandle()->set(CIEC_BOOL(true));
+    output.getHandle()->set(CIEC_BOOL(false));
+    output.getHandle()->set(CIEC_BOOL(true));
+    BOOST_CHECK_EQUAL(1U, controller.mTriggers);
+    TForteByte transfer[4] = { 0, 0, 0, 0 };
+    BOOST_CHECK(controller.mImage.flushOutputs(transfer));
+    BOOST_CHECK_EQUAL(0x01, transfer[0]);
+
+    // a dropped output process interface resets its output
+    mapper.deregisterObserver(&output);
+    BOOST_CHECK_EQUAL(2U, controller.mTriggers);
+    BOOST_CHECK(controller.mImage.flushOutputs(transfer));
+    BOOST_CHECK_EQUAL(0x00, transfer[0]);
+  }
+
+  BOOST_AUTO_TEST_CASE(processImageRegistry) {
+    IOProcessImage image(1, 1);
+    IOMapper &mapper = IOMapper::getInstance();
+    BOOST_CHECK(mapper.registerProcessImage("ImageTest.Config", &image));
+    BOOST_CHECK(!mapper.registerProcessImage("ImageTest.Config", &image));
+    BOOST_CHECK(&image == mapper.getProcessImage("ImageTest.Config"));
+    mapper.deregisterProcessImage(&image);
+    BOOST_CHECK(0 == mapper.getProcessImage("ImageTest.Config"));
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,140 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include <boost/test/unit_test.hpp>
+#include "../../src/core/mgmresponse.h"
+#include <string>
+#include <stdio.h>
+#include <string.h>
+
+using namespace forte::core;
+
+namespace {
+  std::string getContent(const CMGMResponseBuffer &paBuffer){
+    std::string content(paBuffer.length(), ' ');
+    if(0 != paBuffer.length()){
+      paBuffer.copyTo(&content[0]);
+    }
+    return content;
+  }
+
+  //! writes the entries "<E0/>" ... as the list queries of a resource do
+  void writeEntries(CMGMResponseBuffer &paBuffer, unsigned int paNumEntries){
+    for(unsigned int i = 0; i < paNumEntries; ++i){
+      if(paBuffer.beginEntry("\n")){
+        char entry[16];
+        sprintf(entry, "<E%u/>", i);
+        paBuffer.append(entry);
+        paBuffer.endEntry();
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(MGMResponseBufferTests)
+
+  BOOST_AUTO_TEST_CASE(appendAcrossSegments){
+    CMGMResponseBuffer buffer;
+    BOOST_CHECK(buffer.isEmpty());
+
+    std::string expected;
+    for(unsigned int i = 0; i < 3 * CMGMResponseBuffer::scmSegmentSize / 10; ++i){
+      buffer.append("0123456789");
+      expected += "0123456789";
+    }
+    buffer.append("tail", 4);
+    expected += "tail";
+    BOOST_CHECK_EQUAL(expected.length(), buffer.length());
+    BOOST_CHECK_EQUAL(expected, getContent(buffer));
+
+    //the segments are reused for the next response
+    buffer.reset();
+    BOOST_CHECK(buffer.isEmpty());
+    buffer.append("next");
+    BOOST_CHECK_EQUAL("next", getContent(buffer));
+  }
+
+  BOOST_AUTO_TEST_CASE(reservedSpaceIsContiguous){
+    CMGMResponseBuffer buffer;
+    buffer.append(std::string(CMGMResponseBuffer::scmSegmentSize - 3, 'a').c_str());
+    char *space = buffer.reserve(10);
+    memcpy(space, "0123456789", 10);
+    buffer.commit(5);
+    buffer.append("!");
+    BOOST_CHECK_EQUAL(std::string(CMGMResponseBuffer::scmSegmentSize - 3, 'a') + "01234!", getContent(buffer));
+
+    //larger than a segment
+    buffer.reset();
+    space = buffer.reserve(3 * CMGMResponseBuffer::scmSegmentSize);
+    memset(space, 'b', 3 * CMGMResponseBuffer::scmSegmentSize);
+    buffer.commit(3 * CMGMResponseBuffer::scmSegmentSize);
+    BOOST_CHECK_EQUAL(std::string(3 * CMGMResponseBuffer::scmSegmentSize, 'b'), getContent(buffer));
+  }
+
+  BOOST_AUTO_TEST_CASE(entriesWithoutLimit){
+    CMGMResponseBuffer buffer;
+    writeEntries(buffer, 3);
+    BOOST_CHECK_EQUAL("<E0/>\n<E1/>\n<E2/>", getContent(buffer));
+    BOOST_CHECK_EQUAL(0U, buffer.getNextCursor());
+  }
+
+  BOOST_AUTO_TEST_CASE(pagesFollowTheCursor){
+    const unsigned int numEntries = 5000;
+    const size_t limit = 10000;
+    CMGMResponseBuffer buffer;
+    std::string all;
+    TForteUInt32 cursor = 0;
+    unsigned int pages = 0;
+    do{
+      buffer.reset(cursor, limit);
+      writeEntries(buffer, numEntries);
+      BOOST_CHECK(limit >= buffer.length());
+      if(!all.empty()){
+        all += "\n";
+      }
+      all += getContent(buffer);
+      BOOST_REQUIRE(0 == buffer.getNextCursor() || cursor < buffer.getNextCursor());
+      cursor = buffer.getNextCursor();
+      ++pages;
+    } while(0 != cursor);
+
+    CMGMResponseBuffer complete;
+    writeEntries(complete, numEntries);
+    BOOST_CHECK(1 < pages);
+    BOOST_CHECK_EQUAL(getContent(complete), all);
+  }
+
+  BOOST_AUTO_TEST_CASE(tooLargeFirstEntryIsTaken){
+    CMGMResponseBuffer buffer;
+    buffer.reset(1, 4);
+    writeEntries(buffer, 3);
+    BOOST_CHECK_EQUAL("<E1/>", getContent(buffer));
+    BOOST_CHECK_EQUAL(2U, buffer.getNextCursor());
+  }
+
+  BOOST_AUTO_TEST_CASE(appendToStringIsCutAtTheMaximumLength){
+    CMGMResponseBuffer buffer;
+    buffer.append("abc");
+    CIEC_STRING text("0");
+    buffer.appendTo(text);
+    BOOST_CHECK_EQUAL(std::string("0abc"), text.getValue());
+
+    buffer.reset();
+    for(unsigned int i = 0; i < 7000; ++i){
+      buffer.append("0123456789");
+    }
+    text = "";
+    buffer.appendTo(text);
+    BOOST_CHECK_EQUAL(65534U, text.length());
+    BOOST_CHECK_EQUAL('3', text.getValue()[65533]);
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
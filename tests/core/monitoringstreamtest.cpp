@@ -0,0 +1,327 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include <boost/test/unit_test.hpp>
+#include "../../src/core/monitoringring.h"
+#include "../../src/core/monitoringstream.h"
+#include "../../src/core/monitoringstreamserver.h"
+#include "../../src/core/cominfra/fbdkasn1layer.h"
+#include "../../src/core/device.h"
+#include "fbtests/fbtesterglobalfixture.h"
+#include <forte_int.h>
+#include <forte_dint.h>
+#include <forte_thread.h>
+#include <forte_string.h>
+#include <string>
+#include <sstream>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+using namespace forte::core;
+
+namespace {
+  const TForteUInt64 scmMilliSecond = 1000000ULL;
+
+  unsigned int countFrames(const CMonitoringStreamBuffer &paBuffer, char paType){
+    unsigned int count = 0;
+    for(unsigned int pos = 0; pos + CMonitoringStream::scmFrameHeaderSize <= paBuffer.getSize();){
+      const TForteByte *frame = paBuffer.getData() + pos;
+      unsigned int payloadSize = (static_cast<unsigned int>(frame[1]) << 24) | (static_cast<unsigned int>(frame[2]) << 16)
+          | (static_cast<unsigned int>(frame[3]) << 8) | frame[4];
+      if(paType == static_cast<char>(frame[0])){
+        ++count;
+      }
+      pos += CMonitoringStream::scmFrameHeaderSize + payloadSize;
+    }
+    return count;
+  }
+
+  /** Streams the frames of a stream in JSON like the stream server thread */
+  class CStreamConsumer : public CThread{
+    public:
+      explicit CStreamConsumer(CMonitoringStream &paStream) :
+          mStream(paStream){
+      }
+
+      std::string getFrames() const {
+        return std::string(reinterpret_cast<const char*>(mBuffer.getData()), mBuffer.getSize());
+      }
+
+    protected:
+      void run(){
+        while(isAlive()){
+          mStream.appendFrames(mBuffer, CMonitoringStream::e_JSON);
+          CThread::sleepThread(0);
+        }
+        mStream.appendFrames(mBuffer, CMonitoringStream::e_JSON);
+      }
+
+    private:
+      CMonitoringStream &mStream;
+      CMonitoringStreamBuffer mBuffer;
+  };
+}
+
+BOOST_AUTO_TEST_SUITE(MonitoringStreamTests)
+
+  BOOST_AUTO_TEST_CASE(ringWrapsAroundAndDropsWhenFull){
+    CMonitoringRing ring(64);
+    BOOST_CHECK_EQUAL(64U, ring.getCapacity());
+
+    TForteByte record[20];
+    TForteByte readBack[20];
+    for(TForteByte round = 0; round < 10; ++round){
+      memset(record, round, sizeof(record));
+      BOOST_CHECK(ring.write(record, sizeof(record)));
+      BOOST_CHECK(ring.write(record, sizeof(record)));
+      for(unsigned int i = 0; i < 2; ++i){
+        BOOST_REQUIRE_EQUAL(sizeof(record), ring.getNextSize());
+        BOOST_CHECK_EQUAL(sizeof(record), ring.read(readBack));
+        BOOST_CHECK(0 == memcmp(record, readBack, sizeof(record)));
+      }
+    }
+    BOOST_CHECK_EQUAL(0U, ring.getNextSize());
+
+    //each record needs 24 bytes, the third one does not fit anymore
+    BOOST_CHECK(ring.write(record, sizeof(record)));
+    BOOST_CHECK(ring.write(record, sizeof(record)));
+    BOOST_CHECK(!ring.write(record, sizeof(record)));
+    BOOST_CHECK(!ring.write(record, 0));
+    BOOST_CHECK_EQUAL(2U, ring.getNrOfDroppedRecords());
+  }
+
+  BOOST_AUTO_TEST_CASE(capturesOnlyAnnouncedSubscriptionsAndChangesBeyondDeadband){
+    CSyncObject dataSync;
+    CMonitoringStream stream(1024, dataSync);
+    CIEC_INT value(10);
+    stream.subscribe(3, "RES.FB.IN", value, 0, 5.0);
+
+    //nothing is captured before the client learned about the subscription
+    stream.capture(scmMilliSecond);
+    CMonitoringStreamBuffer buffer;
+    BOOST_CHECK_EQUAL(0U, stream.appendFrames(buffer, CMonitoringStream::e_Binary));
+    BOOST_CHECK_EQUAL(1U, countFrames(buffer, CMonitoringStream::e_Definition));
+
+    buffer.clear();
+    stream.capture(2 * scmMilliSecond);
+    BOOST_CHECK_EQUAL(1U, stream.appendFrames(buffer, CMonitoringStream::e_Binary));
+    BOOST_CHECK_EQUAL(0U, countFrames(buffer, CMonitoringStream::e_Definition));
+
+    TForteByte encodedValue[8];
+    int encodedSize = forte::com_infra::CFBDKASN1ComLayer::serializeDataPoint(encodedValue, sizeof(encodedValue), value);
+    BOOST_REQUIRE(0 < encodedSize);
+    BOOST_REQUIRE_EQUAL(CMonitoringStream::scmFrameHeaderSize + CMonitoringStream::scmSampleHeaderSize + static_cast<unsigned int>(encodedSize), buffer.getSize());
+    const TForteByte *frame = buffer.getData();
+    BOOST_CHECK_EQUAL('S', frame[0]);
+    BOOST_CHECK_EQUAL(CMonitoringStream::scmSampleHeaderSize + static_cast<unsigned int>(encodedSize), static_cast<unsigned int>(frame[4]));
+    BOOST_CHECK_EQUAL(3, frame[8]);
+    BOOST_CHECK_EQUAL(2 * scmMilliSecond, (static_cast<TForteUInt64>(frame[14]) << 16) | (static_cast<TForteUInt64>(frame[15]) << 8) | frame[16]);
+    BOOST_CHECK_EQUAL(0, frame[17]);
+    BOOST_CHECK(0 == memcmp(encodedValue, frame + CMonitoringStream::scmFrameHeaderSize + CMonitoringStream::scmSampleHeaderSize, encodedSize));
+
+    value = 14;
+    stream.capture(3 * scmMilliSecond);
+    buffer.clear();
+    BOOST_CHECK_EQUAL(0U, stream.appendFrames(buffer, CMonitoringStream::e_Binary));
+
+    value = 15;
+    stream.capture(4 * scmMilliSecond);
+    BOOST_CHECK_EQUAL(1U, stream.appendFrames(buffer, CMonitoringStream::e_Binary));
+
+    value.setForced(true);
+    stream.capture(5 * scmMilliSecond);
+    buffer.clear();
+    BOOST_CHECK_EQUAL(1U, stream.appendFrames(buffer, CMonitoringStream::e_Binary));
+    BOOST_CHECK_EQUAL(1, buffer.getData()[17]);
+
+    BOOST_CHECK(stream.unsubscribe(value));
+    BOOST_CHECK(!stream.unsubscribe(value));
+    BOOST_CHECK(!stream.hasSubscriptions());
+  }
+
+  BOOST_AUTO_TEST_CASE(samplingPeriodLimitsCaptures){
+    CSyncObject dataSync;
+    CMonitoringStream stream(1024, dataSync);
+    CIEC_INT value(1);
+    stream.subscribe(1, "RES.FB.IN", value, 100, 0.0);
+    CMonitoringStreamBuffer buffer;
+    stream.appendFrames(buffer, CMonitoringStream::e_Binary);
+
+    stream.capture(1000 * scmMilliSecond);
+    BOOST_CHECK_EQUAL(1U, stream.appendFrames(buffer, CMonitoringStream::e_Binary));
+
+    value = 2;
+    stream.capture(1050 * scmMilliSecond);
+    BOOST_CHECK_EQUAL(0U, stream.appendFrames(buffer, CMonitoringStream::e_Binary));
+    value = 3;
+    stream.capture(1100 * scmMilliSecond);
+    BOOST_CHECK_EQUAL(1U, stream.appendFrames(buffer, CMonitoringStream::e_Binary));
+
+    //unchanged values are not sent again
+    stream.capture(1200 * scmMilliSecond);
+    BOOST_CHECK_EQUAL(0U, stream.appendFrames(buffer, CMonitoringStream::e_Binary));
+  }
+
+  BOOST_AUTO_TEST_CASE(jsonFramesAreEscaped){
+    CSyncObject dataSync;
+    CMonitoringStream stream(1024, dataSync);
+    CIEC_STRING value("a\"b");
+    stream.subscribe(7, "RES.FB.S", value, 0, 0.0);
+    CMonitoringStreamBuffer buffer;
+    stream.appendFrames(buffer, CMonitoringStream::e_JSON);
+    stream.capture(42);
+    BOOST_CHECK_EQUAL(1U, stream.appendFrames(buffer, CMonitoringStream::e_JSON));
+
+    std::string frames(reinterpret_cast<const char*>(buffer.getData()), buffer.getSize());
+    BOOST_CHECK_EQUAL("{\"id\":7,\"name\":\"RES.FB.S\",\"period\":0}\n{\"id\":7,\"t\":42,\"v\":\"'a$\\\"b'\",\"forced\":false}\n", frames);
+  }
+
+  BOOST_AUTO_TEST_CASE(ringOverflowIsRetriedWithNextSample){
+    CSyncObject dataSync;
+    CMonitoringStream stream(64, dataSync);
+    CIEC_STRING value("a rather long string which does not fit into the small ring at all");
+    stream.subscribe(1, "RES.FB.S", value, 0, 0.0);
+    CMonitoringStreamBuffer buffer;
+    stream.appendFrames(buffer, CMonitoringStream::e_Binary);
+    stream.capture(1);
+    BOOST_CHECK_EQUAL(0U, stream.appendFrames(buffer, CMonitoringStream::e_Binary));
+    BOOST_CHECK_EQUAL(1U, stream.getNrOfDroppedSamples());
+
+    value = "short";
+    stream.capture(2);
+    BOOST_CHECK_EQUAL(1U, stream.appendFrames(buffer, CMonitoringStream::e_Binary));
+  }
+
+  BOOST_AUTO_TEST_CASE(deletingTheFBRemovesItsSubscriptions){
+    CSyncObject dataSync;
+    CMonitoringStream stream(1024, dataSync);
+    CFunctionBlock *fB = CFBTestDataGlobalFixture::getResource();
+    CIEC_INT inValue(1);
+    CIEC_INT outValue(2);
+    CIEC_INT otherValue(3);
+    stream.subscribe(1, "RES.FB.IN", inValue, 0, 0.0, fB);
+    stream.subscribe(2, "RES.FB.OUT", outValue, 0, 0.0, fB);
+    stream.subscribe(3, "RES.OTHER.IN", otherValue, 0, 0.0);
+    CMonitoringStreamBuffer buffer;
+    stream.appendFrames(buffer, CMonitoringStream::e_Binary);
+    stream.capture(1);
+    buffer.clear();
+    BOOST_CHECK_EQUAL(3U, stream.appendFrames(buffer, CMonitoringStream::e_Binary));
+
+    BOOST_CHECK_EQUAL(2U, stream.unsubscribe(*fB));
+    BOOST_CHECK_EQUAL(0U, stream.unsubscribe(*fB));
+    //the removed data points are not read anymore, also not by a capture still using the old subscription list
+    inValue = 10;
+    outValue = 20;
+    otherValue = 30;
+    stream.capture(2);
+    buffer.clear();
+    BOOST_CHECK_EQUAL(1U, stream.appendFrames(buffer, CMonitoringStream::e_Binary));
+    BOOST_CHECK(!stream.unsubscribe(inValue));
+    BOOST_CHECK(stream.unsubscribe(otherValue));
+  }
+
+  BOOST_AUTO_TEST_CASE(captureRunsConcurrentlyWithConsumerAndManagement){
+    const TForteInt32 nrOfRounds = 20000;
+    CSyncObject dataSync;
+    CMonitoringStream stream(256, dataSync);
+    CIEC_DINT value(0);
+    CIEC_DINT churnValue(0);
+    stream.subscribe(1, "RES.FB.OUT", value, 0, 0.0);
+    CStreamConsumer consumer(stream);
+    consumer.start();
+
+    TForteUInt32 churnId = 100;
+    for(TForteInt32 round = 1; round <= nrOfRounds; ++round){
+      value = round;
+      churnValue = round;
+      //the test thread acts as the execution thread of the resource
+      stream.capture(static_cast<TForteUInt64>(round));
+      if(0 == (round % 50)){
+        //subscriptions are replaced and removed while the execution thread captures them
+        stream.subscribe(++churnId, "RES.FB.CHURN", churnValue, 0, 0.0);
+      } else if(0 == (round % 75)){
+        stream.unsubscribe(churnValue);
+      }
+    }
+    //values dropped because the ring was full are captured again until the consumer got them
+    for(unsigned int i = 0; (i < 200) && (std::string::npos == consumer.getFrames().find("\"v\":\"20000\"")); ++i){
+      stream.capture(static_cast<TForteUInt64>(nrOfRounds + i + 1));
+      CThread::sleepThread(1);
+    }
+    consumer.end();
+
+    std::istringstream frames(consumer.getFrames());
+    std::string line;
+    long lastValue = 0;
+    unsigned int nrOfSamples = 0;
+    bool increasing = true;
+    while(std::getline(frames, line)){
+      if(0 == line.find("{\"id\":1,\"t\":")){
+        long sampledValue = strtol(line.c_str() + line.find("\"v\":\"") + 5, 0, 10);
+        increasing = increasing && (sampledValue > lastValue);
+        lastValue = sampledValue;
+        ++nrOfSamples;
+      }
+    }
+    BOOST_CHECK(increasing);
+    BOOST_CHECK(0U < nrOfSamples);
+    BOOST_CHECK_EQUAL(nrOfRounds, lastValue);
+    BOOST_CHECK(stream.unsubscribe(value));
+  }
+
+  BOOST_AUTO_TEST_CASE(serverStreamsToConnectedClient){
+    const unsigned short port = 61517;
+    CIEC_INT value(5);
+    CSyncObject dataSync;
+    CMonitoringStream stream(1024, dataSync);
+    stream.subscribe(9, "RES.FB.IN", value, 0, 0.0);
+
+    CMonitoringStreamServer *server = new CMonitoringStreamServer(CFBTestDataGlobalFixture::getResource()->getDevice().getDeviceExecution());
+    BOOST_REQUIRE(server->open(port));
+    server->registerStream(stream);
+
+    int client = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = inet_addr("127.0.0.1");
+    BOOST_REQUIRE_EQUAL(0, connect(client, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)));
+    BOOST_REQUIRE_EQUAL(1, send(client, "J", 1, 0));
+
+    std::string received;
+    for(unsigned int i = 0; (i < 200) && (std::string::npos == received.find("\"v\":\"5\"")); ++i){
+      //the test thread acts as the execution thread of the resource
+      stream.capture();
+      struct pollfd pollFd = { client, POLLIN, 0 };
+      if(0 < poll(&pollFd, 1, 10)){
+        char buffer[256];
+        ssize_t size = recv(client, buffer, sizeof(buffer), 0);
+        if(0 < size){
+          received.append(buffer, static_cast<size_t>(size));
+        }
+      }
+    }
+    BOOST_CHECK(std::string::npos != received.find("{\"id\":9,\"name\":\"RES.FB.IN\",\"period\":0}\n"));
+    BOOST_CHECK(std::string::npos != received.find("\"v\":\"5\""));
+    BOOST_CHECK(server->isClientConnected());
+
+    delete server;
+    close(client);
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,304 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include <boost/test/unit_test.hpp>
+#include "../../../src/core/utils/jsoncodec.h"
+#include "../../../src/core/datatypes/forte_struct.h"
+#include "../../../src/core/datatypes/forte_array.h"
+#include "../../../src/core/datatypes/forte_bool.h"
+#include "../../../src/core/datatypes/forte_int.h"
+#include "../../../src/core/datatypes/forte_udint.h"
+#include "../../../src/core/datatypes/forte_lreal.h"
+#include "../../../src/core/datatypes/forte_string.h"
+#include "../../../src/core/datatypes/forte_wstring.h"
+#include "../../../src/core/datatypes/forte_time.h"
+#include "../../../src/core/datatypes/forte_date_and_time.h"
+#include "../../../src/core/typelib.h"
+#include <string>
+#include <string.h>
+#include <time.h>
+
+#ifdef FORTE_ENABLE_GENERATED_SOURCE_CPP
+#include "jsoncodectest_gen.cpp"
+#endif
+
+using namespace forte::core::util;
+
+/***********************************************************/
+class CIEC_JSONTestStruct : public CIEC_STRUCT {
+  DECLARE_FIRMWARE_DATATYPE(JSONTestStruct)
+
+  public:
+    CIEC_JSONTestStruct();
+
+    virtual ~CIEC_JSONTestStruct() {
+    }
+
+    CIEC_STRING &name(){
+      return *static_cast<CIEC_STRING*>(&getMembers()[0]);
+    }
+
+    CIEC_BOOL &active(){
+      return *static_cast<CIEC_BOOL*>(&getMembers()[1]);
+    }
+
+    CIEC_INT &count(){
+      return *static_cast<CIEC_INT*>(&getMembers()[2]);
+    }
+
+    CIEC_ARRAY &values(){
+      return *static_cast<CIEC_ARRAY*>(&getMembers()[3]);
+    }
+
+    CIEC_INT &value(TForteUInt16 paIndex){
+      return *static_cast<CIEC_INT*>(values()[paIndex]);
+    }
+
+  private:
+    static const CStringDictionary::TStringId scmElementTypes[];
+    static const CStringDictionary::TStringId scmElementNames[];
+};
+
+const CStringDictionary::TStringId CIEC_JSONTestStruct::scmElementTypes[] = { g_nStringIdSTRING, g_nStringIdBOOL, g_nStringIdINT, g_nStringIdARRAY, 3, g_nStringIdINT };
+const CStringDictionary::TStringId CIEC_JSONTestStruct::scmElementNames[] = { g_nStringIdname, g_nStringIdactive, g_nStringIdcount, g_nStringIdvalues };
+
+DEFINE_FIRMWARE_DATATYPE(JSONTestStruct, g_nStringIdJSONTestStruct)
+
+CIEC_JSONTestStruct::CIEC_JSONTestStruct() :
+    CIEC_STRUCT(g_nStringIdJSONTestStruct, 4, scmElementTypes, scmElementNames, e_APPLICATION + e_CONSTRUCTED + 1) {
+}
+/***********************************************************/
+
+namespace {
+  std::string encodeToString(const CIEC_ANY &paValue){
+    CJSONEncoder encoder;
+    BOOST_REQUIRE(encoder.encode(paValue));
+    return std::string(encoder.getData(), encoder.getLength());
+  }
+
+  bool decodeFromString(const std::string &paText, CIEC_ANY &paTarget){
+    CJSONDecoder decoder;
+    return static_cast<int>(paText.length()) == decoder.decode(paText.c_str(), paText.length(), paTarget);
+  }
+
+  void fillTestStruct(CIEC_JSONTestStruct &paValue, TForteInt16 paBase){
+    paValue.name() = "sensor \"A\"";
+    paValue.active() = true;
+    paValue.count() = paBase;
+    for(TForteUInt16 i = 0; i < 3; ++i){
+      paValue.value(i) = static_cast<TForteInt16>(paBase * 10 + i);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(JSONCodecTests)
+
+  BOOST_AUTO_TEST_CASE(encodeElementaryValues){
+    BOOST_CHECK_EQUAL("true", encodeToString(CIEC_BOOL(true)));
+    BOOST_CHECK_EQUAL("-42", encodeToString(CIEC_INT(-42)));
+    BOOST_CHECK_EQUAL("4000000000", encodeToString(CIEC_UDINT(4000000000U)));
+    BOOST_CHECK_EQUAL("\"T#5ms\"", encodeToString(CIEC_TIME(5 * 1000000LL)));
+    BOOST_CHECK_EQUAL("\"a\\\"b\\\\c\\n\\u0001\"", encodeToString(CIEC_STRING("a\"b\\c\n\x01")));
+
+    //STRINGs are ISO 8859-1 encoded, JSON text is UTF-8
+    BOOST_CHECK_EQUAL("\"\xC3\xA4\"", encodeToString(CIEC_STRING("\xE4")));
+
+    CIEC_LREAL real(1.5);
+    BOOST_CHECK_EQUAL(1.5, atof(encodeToString(real).c_str()));
+
+    CIEC_DATE_AND_TIME dateAndTime;
+    dateAndTime.fromString("DT#2007-12-21-15:00:00.000");
+    BOOST_CHECK_EQUAL("\"2007-12-21T15:00:00.000Z\"", encodeToString(dateAndTime));
+  }
+
+  BOOST_AUTO_TEST_CASE(elementaryValuesRoundTrip){
+    CIEC_STRING stringValue;
+    BOOST_CHECK(decodeFromString(encodeToString(CIEC_STRING("tab\tquote\"\xE4")), stringValue));
+    BOOST_CHECK_EQUAL(std::string("tab\tquote\"\xE4"), stringValue.getValue());
+
+    CIEC_WSTRING wstringValue;
+    BOOST_CHECK(decodeFromString(encodeToString(CIEC_WSTRING("\xE2\x82\xAC 5")), wstringValue));
+    BOOST_CHECK_EQUAL(std::string("\xE2\x82\xAC 5"), wstringValue.getValue());
+
+    CIEC_INT intValue;
+    BOOST_CHECK(decodeFromString(" -1234 ", intValue));
+    BOOST_CHECK_EQUAL(-1234, static_cast<TForteInt16>(intValue));
+
+    CIEC_BOOL boolValue(true);
+    BOOST_CHECK(decodeFromString("false", boolValue));
+    BOOST_CHECK(!boolValue);
+
+    CIEC_TIME timeValue;
+    BOOST_CHECK(decodeFromString(encodeToString(CIEC_TIME(5 * 1000000LL)), timeValue));
+    BOOST_CHECK_EQUAL(5 * 1000000LL, static_cast<TForteInt64>(timeValue));
+
+    CIEC_DATE_AND_TIME dateAndTime;
+    CIEC_DATE_AND_TIME decodedDateAndTime;
+    dateAndTime.fromString("DT#2018-03-04-05:06:07.089");
+    BOOST_CHECK(decodeFromString(encodeToString(dateAndTime), decodedDateAndTime));
+    BOOST_CHECK_EQUAL(static_cast<TForteUInt64>(dateAndTime), static_cast<TForteUInt64>(decodedDateAndTime));
+
+    //null and empty strings leave non string values unchanged
+    intValue = 7;
+    BOOST_CHECK(decodeFromString("null", intValue));
+    BOOST_CHECK(decodeFromString("\"\"", intValue));
+    BOOST_CHECK_EQUAL(7, static_cast<TForteInt16>(intValue));
+  }
+
+  BOOST_AUTO_TEST_CASE(unicodeEscapes){
+    CIEC_WSTRING wstringValue;
+    BOOST_CHECK(decodeFromString("\"\\u00e4\\u20AC\\ud83d\\ude00\\/\"", wstringValue));
+    //WSTRINGs are limited to the basic multilingual plane
+    BOOST_CHECK_EQUAL(std::string("\xC3\xA4\xE2\x82\xAC?/"), wstringValue.getValue());
+
+    CIEC_STRING stringValue;
+    BOOST_CHECK(decodeFromString("\"\\u00e4\\u20ac\"", stringValue));
+    BOOST_CHECK_EQUAL(std::string("\xE4?"), stringValue.getValue());
+
+    BOOST_CHECK(!decodeFromString("\"\\ud83d\"", wstringValue));
+    BOOST_CHECK(!decodeFromString("\"\\u12\"", wstringValue));
+    //lone low surrogates and \0, which would cut the string, are rejected
+    BOOST_CHECK(!decodeFromString("\"\\ude00\"", wstringValue));
+    BOOST_CHECK(!decodeFromString("\"a\\u0000b\"", stringValue));
+    BOOST_CHECK_EQUAL(std::string("\xE4?"), stringValue.getValue());
+  }
+
+  BOOST_AUTO_TEST_CASE(structsAndArrays){
+    CIEC_JSONTestStruct value;
+    fillTestStruct(value, 3);
+    const std::string json = encodeToString(value);
+    BOOST_CHECK_EQUAL("{\"name\":\"sensor \\\"A\\\"\",\"active\":true,\"count\":3,\"values\":[30,31,32]}", json);
+
+    CIEC_JSONTestStruct decoded;
+    BOOST_CHECK(decodeFromString(json, decoded));
+    BOOST_CHECK_EQUAL(std::string("sensor \"A\""), decoded.name().getValue());
+    BOOST_CHECK(decoded.active());
+    BOOST_CHECK_EQUAL(3, static_cast<TForteInt16>(decoded.count()));
+    BOOST_CHECK_EQUAL(32, static_cast<TForteInt16>(decoded.value(2)));
+
+    CIEC_ARRAY array(2, g_nStringIdJSONTestStruct);
+    fillTestStruct(*static_cast<CIEC_JSONTestStruct*>(array[0]), 1);
+    fillTestStruct(*static_cast<CIEC_JSONTestStruct*>(array[1]), 2);
+    CIEC_ARRAY decodedArray(2, g_nStringIdJSONTestStruct);
+    BOOST_CHECK(decodeFromString(encodeToString(array), decodedArray));
+    BOOST_CHECK_EQUAL(encodeToString(array), encodeToString(decodedArray));
+  }
+
+  BOOST_AUTO_TEST_CASE(unknownMembersAndSurplusEntriesAreSkipped){
+    CIEC_JSONTestStruct decoded;
+    decoded.name() = "unchanged";
+    BOOST_CHECK(decodeFromString("{ \"id\" : 17, \"endOfValidity\": null,\r\n \"count\": 5, \"nested\": {\"a\": [1, {\"b\": \"}\"}]},"
+        " \"values\": [1, 2, 3, 4, 5], \"name\": null }", decoded));
+    BOOST_CHECK_EQUAL(std::string("unchanged"), decoded.name().getValue());
+    BOOST_CHECK_EQUAL(5, static_cast<TForteInt16>(decoded.count()));
+    BOOST_CHECK_EQUAL(1, static_cast<TForteInt16>(decoded.value(0)));
+    BOOST_CHECK_EQUAL(3, static_cast<TForteInt16>(decoded.value(2)));
+
+    //fewer entries keep the remaining elements
+    BOOST_CHECK(decodeFromString("{\"values\":[9]}", decoded));
+    BOOST_CHECK_EQUAL(9, static_cast<TForteInt16>(decoded.value(0)));
+    BOOST_CHECK_EQUAL(2, static_cast<TForteInt16>(decoded.value(1)));
+  }
+
+  BOOST_AUTO_TEST_CASE(objectIntoStringArray){
+    CIEC_ARRAY metadata(3, g_nStringIdSTRING);
+    BOOST_CHECK(decodeFromString("{\"security\":\"token\", \"version\": 2, \"x\": {\"y\": 1}, \"z\":\"-\"}", metadata));
+    BOOST_CHECK_EQUAL(std::string("security=token"), static_cast<CIEC_STRING*>(metadata[0])->getValue());
+    BOOST_CHECK_EQUAL(std::string("version=2"), static_cast<CIEC_STRING*>(metadata[1])->getValue());
+    BOOST_CHECK_EQUAL(std::string(""), static_cast<CIEC_STRING*>(metadata[2])->getValue());
+  }
+
+  BOOST_AUTO_TEST_CASE(invalidInput){
+    CIEC_JSONTestStruct structValue;
+    CIEC_INT intValue;
+    CJSONDecoder decoder;
+    const char *invalidTexts[] = { "", "{", "{\"count\" 1}", "{\"count\":1,}", "[1 2]", "\"open", "tru", "{\"count\":\"abc\"}",
+        "{\"count\":1.5}", "{\"count\":[1]}", "{\"name\":{}}", "{\"a\":\"b\nc\"}", "{\"a\":\"\\x\"}" };
+    for(size_t i = 0; i < sizeof(invalidTexts) / sizeof(invalidTexts[0]); ++i){
+      BOOST_TEST_MESSAGE("Invalid input: " << invalidTexts[i]);
+      BOOST_CHECK_EQUAL(-1, decoder.decode(invalidTexts[i], strlen(invalidTexts[i]), structValue));
+    }
+    BOOST_CHECK_EQUAL(-1, decoder.decode("{}", 2, intValue));
+
+    //nesting is limited
+    std::string deep(CJSONDecoder::scmMaxDepth + 1, '[');
+    deep += std::string(CJSONDecoder::scmMaxDepth + 1, ']');
+    BOOST_CHECK_EQUAL(-1, decoder.decode(deep.c_str(), deep.length(), intValue));
+
+    //the used length allows detecting trailing data
+    BOOST_CHECK_EQUAL(3, decoder.decode("12 x", 4, intValue));
+  }
+
+  BOOST_AUTO_TEST_CASE(multipleTargets){
+    //the members of a struct are stored one after the other as the data inputs and outputs of a FB
+    CIEC_JSONTestStruct values;
+    CIEC_ANY *targets = values.getMembers();
+    const char * const names[] = { "label", "on", "level" };
+    CJSONDecoder decoder;
+
+    const char positional[] = "[\"mm\", true, 12, [1]]";
+    BOOST_CHECK_EQUAL(static_cast<int>(sizeof(positional) - 1), decoder.decode(positional, sizeof(positional) - 1, targets, 3, names));
+    BOOST_CHECK_EQUAL(std::string("mm"), values.name().getValue());
+    BOOST_CHECK(values.active());
+    BOOST_CHECK_EQUAL(12, static_cast<TForteInt16>(values.count()));
+    BOOST_CHECK_EQUAL(0, static_cast<TForteInt16>(values.value(0)));
+
+    const char named[] = "{\"label\":\"cm\",\"other\":true,\"level\":7}";
+    BOOST_CHECK_EQUAL(static_cast<int>(sizeof(named) - 1), decoder.decode(named, sizeof(named) - 1, targets, 3, names));
+    BOOST_CHECK_EQUAL(std::string("cm"), values.name().getValue());
+    BOOST_CHECK_EQUAL(7, static_cast<TForteInt16>(values.count()));
+
+    BOOST_CHECK_EQUAL(-1, decoder.decode(named, sizeof(named) - 1, targets, 3, 0));
+  }
+
+  BOOST_AUTO_TEST_CASE(nanIsEncodedAsNull){
+    CIEC_LREAL value(0.0);
+    value = static_cast<TForteDFloat>(value) / static_cast<TForteDFloat>(value);
+    CJSONEncoder encoder;
+    encoder.beginArray();
+    BOOST_CHECK(encoder.encode(value));
+    BOOST_CHECK(encoder.encode(CIEC_INT(1)));
+    encoder.endArray();
+    BOOST_CHECK_EQUAL("[null,1]", std::string(encoder.getData(), encoder.getLength()));
+  }
+
+  BOOST_AUTO_TEST_CASE(throughput){
+    const TForteUInt16 numEntries = 1000;
+    const unsigned int numRounds = 50;
+    CIEC_ARRAY source(numEntries, g_nStringIdJSONTestStruct);
+    for(TForteUInt16 i = 0; i < numEntries; ++i){
+      fillTestStruct(*static_cast<CIEC_JSONTestStruct*>(source[i]), static_cast<TForteInt16>(i));
+    }
+    CIEC_ARRAY target(numEntries, g_nStringIdJSONTestStruct);
+
+    CJSONEncoder encoder;
+    CJSONDecoder decoder;
+    size_t bytes = 0;
+    clock_t encodeTime = 0;
+    clock_t decodeTime = 0;
+    for(unsigned int round = 0; round < numRounds; ++round){
+      clock_t start = clock();
+      encoder.clear();
+      BOOST_REQUIRE(encoder.encode(source));
+      clock_t encoded = clock();
+      BOOST_REQUIRE_EQUAL(static_cast<int>(encoder.getLength()), decoder.decode(encoder.getData(), encoder.getLength(), target));
+      decodeTime += clock() - encoded;
+      encodeTime += encoded - start;
+      bytes += encoder.getLength();
+    }
+    BOOST_CHECK_EQUAL(9992, static_cast<TForteInt16>(static_cast<CIEC_JSONTestStruct*>(target[999])->value(2)));
+
+    double megaBytes = static_cast<double>(bytes) / (1024.0 * 1024.0);
+    BOOST_TEST_MESSAGE("JSON encoding: " << megaBytes / ((static_cast<double>(encodeTime) + 1.0) / CLOCKS_PER_SEC) << " MB/s");
+    BOOST_TEST_MESSAGE("JSON decoding: " << megaBytes / ((static_cast<double>(decodeTime) + 1.0) / CLOCKS_PER_SEC) << " MB/s");
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
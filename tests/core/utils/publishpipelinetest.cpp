@@ -0,0 +1,170 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include <boost/test/unit_test.hpp>
+
+#include <publishpipeline.h>
+#include <string>
+#include <vector>
+
+#ifdef FORTE_ENABLE_GENERATED_SOURCE_CPP
+#include "publishpipelinetest_gen.cpp"
+#endif
+
+using namespace forte::core::util;
+
+namespace {
+  /** Sends like a com layer: directly while the window has a free slot, queued otherwise */
+  struct SPublisher{
+      explicit SPublisher(CPublishPipeline &paPipeline) :
+          mPipeline(paPipeline), mNow(0){
+      }
+
+      void send(unsigned int paValue){
+        if(mPipeline.isWindowFull()){
+          mPipeline.enqueue(&paValue, sizeof(paValue));
+        }
+        else{
+          transmit(paValue);
+        }
+      }
+
+      void acknowledge(bool paSuccess = true){
+        BOOST_REQUIRE(mPipeline.acknowledged(paSuccess, ++mNow));
+        for(const CPublishPipeline::SMessage *message = mPipeline.takeNext(); 0 != message; message = mPipeline.takeNext()){
+          BOOST_REQUIRE_EQUAL(sizeof(unsigned int), message->mSize);
+          transmit(*reinterpret_cast<const unsigned int*>(message->mData));
+        }
+      }
+
+      void transmit(unsigned int paValue){
+        mPipeline.sent(++mNow);
+        mSent.push_back(paValue);
+      }
+
+      CPublishPipeline &mPipeline;
+      uint_fast64_t mNow;
+      std::vector<unsigned int> mSent;
+  };
+}
+
+BOOST_AUTO_TEST_SUITE(PublishPipeline)
+
+  BOOST_AUTO_TEST_CASE(invalidSizes){
+    CPublishPipeline pipeline;
+    BOOST_CHECK(!pipeline.init(0, 1));
+    BOOST_CHECK(!pipeline.init(1, 0));
+    BOOST_CHECK(pipeline.init(1, 1));
+  }
+
+  BOOST_AUTO_TEST_CASE(windowLimitsMessagesInFlight){
+    CPublishPipeline pipeline;
+    BOOST_REQUIRE(pipeline.init(3, 10));
+    SPublisher publisher(pipeline);
+    for(unsigned int i = 0; i < 5; ++i){
+      publisher.send(i);
+    }
+    BOOST_CHECK_EQUAL(3U, publisher.mSent.size());
+    BOOST_CHECK_EQUAL(3U, pipeline.getStatistics().mInFlight);
+    BOOST_CHECK_EQUAL(2U, pipeline.getStatistics().mQueueDepth);
+
+    //every acknowledgment frees one slot for the oldest queued message
+    publisher.acknowledge();
+    BOOST_CHECK_EQUAL(4U, publisher.mSent.size());
+    publisher.acknowledge(false);
+    BOOST_REQUIRE_EQUAL(5U, publisher.mSent.size());
+    for(unsigned int i = 0; i < 5; ++i){
+      BOOST_CHECK_EQUAL(i, publisher.mSent[i]);
+    }
+    BOOST_CHECK_EQUAL(3U, pipeline.getStatistics().mInFlight);
+    BOOST_CHECK_EQUAL(0U, pipeline.getStatistics().mQueueDepth);
+
+    publisher.acknowledge();
+    publisher.acknowledge();
+    publisher.acknowledge();
+    BOOST_CHECK(!pipeline.acknowledged(true, 100));
+
+    const CPublishPipeline::SStatistics &statistics(pipeline.getStatistics());
+    BOOST_CHECK_EQUAL(0U, statistics.mInFlight);
+    BOOST_CHECK_EQUAL(5U, statistics.mSent);
+    BOOST_CHECK_EQUAL(4U, statistics.mAcknowledged);
+    BOOST_CHECK_EQUAL(1U, statistics.mFailed);
+    BOOST_CHECK_EQUAL(0U, statistics.mDropped);
+    BOOST_CHECK_EQUAL(2U, statistics.mMaxQueueDepth);
+  }
+
+  BOOST_AUTO_TEST_CASE(fullQueueCoalescesToNewestValues){
+    CPublishPipeline pipeline;
+    BOOST_REQUIRE(pipeline.init(1, 2));
+    SPublisher publisher(pipeline);
+    for(unsigned int i = 0; i < 10; ++i){
+      publisher.send(i);
+    }
+    //0 is in flight, the queue of two keeps the newest values
+    BOOST_CHECK_EQUAL(2U, pipeline.getStatistics().mQueueDepth);
+    BOOST_CHECK_EQUAL(7U, pipeline.getStatistics().mDropped);
+
+    publisher.acknowledge();
+    publisher.acknowledge();
+    publisher.acknowledge();
+    BOOST_REQUIRE_EQUAL(3U, publisher.mSent.size());
+    BOOST_CHECK_EQUAL(0U, publisher.mSent[0]);
+    BOOST_CHECK_EQUAL(8U, publisher.mSent[1]);
+    BOOST_CHECK_EQUAL(9U, publisher.mSent[2]);
+    BOOST_CHECK_EQUAL(2U, pipeline.getStatistics().mMaxQueueDepth);
+  }
+
+  BOOST_AUTO_TEST_CASE(queuedMessagesKeepTheirSize){
+    CPublishPipeline pipeline;
+    BOOST_REQUIRE(pipeline.init(1, 2));
+    pipeline.sent(0);
+    const char longMessage[] = "a longer message";
+    const char shortMessage[] = "short";
+    pipeline.enqueue(longMessage, sizeof(longMessage));
+    pipeline.enqueue(shortMessage, sizeof(shortMessage));
+    BOOST_CHECK(0 == pipeline.takeNext());
+
+    BOOST_REQUIRE(pipeline.acknowledged(true, 1));
+    const CPublishPipeline::SMessage *message = pipeline.takeNext();
+    BOOST_REQUIRE(0 != message);
+    BOOST_CHECK_EQUAL(std::string(longMessage), std::string(message->mData, message->mSize - 1));
+    pipeline.sent(2);
+    BOOST_REQUIRE(pipeline.acknowledged(true, 3));
+    message = pipeline.takeNext();
+    BOOST_REQUIRE(0 != message);
+    BOOST_CHECK_EQUAL(std::string(shortMessage), std::string(message->mData, message->mSize - 1));
+
+    pipeline.sent(4);
+    pipeline.enqueue(shortMessage, sizeof(shortMessage));
+    pipeline.clearQueue();
+    BOOST_REQUIRE(pipeline.acknowledged(true, 5));
+    BOOST_CHECK(0 == pipeline.takeNext());
+  }
+
+  BOOST_AUTO_TEST_CASE(latencyFollowsSendOrder){
+    CPublishPipeline pipeline;
+    BOOST_REQUIRE(pipeline.init(2, 1));
+    pipeline.sent(100);
+    pipeline.sent(150);
+    BOOST_CHECK(pipeline.isWindowFull());
+    BOOST_REQUIRE(pipeline.acknowledged(true, 130));
+    BOOST_CHECK_EQUAL(30U, pipeline.getStatistics().mLastAckLatency);
+    BOOST_REQUIRE(pipeline.acknowledged(true, 250));
+    BOOST_CHECK_EQUAL(100U, pipeline.getStatistics().mLastAckLatency);
+    BOOST_CHECK_EQUAL(100U, pipeline.getStatistics().mMaxAckLatency);
+    BOOST_CHECK_EQUAL(130U, pipeline.getStatistics().mSumAckLatency);
+
+    pipeline.sendFailed();
+    BOOST_CHECK_EQUAL(1U, pipeline.getStatistics().mFailed);
+    BOOST_CHECK_EQUAL(2U, pipeline.getStatistics().mSent);
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,213 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include <boost/test/unit_test.hpp>
+
+#include <requestcoalescer.h>
+#include <vector>
+
+#ifdef FORTE_ENABLE_GENERATED_SOURCE_CPP
+#include "requestcoalescertest_gen.cpp"
+#endif
+
+using namespace forte::core::util;
+
+namespace {
+  //! A read action of an FB, the nodes are consecutive numbers starting at mFirstNode
+  struct STestAction : public SCoalescedAction{
+      STestAction(unsigned int paFirstNode, size_t paNoOfNodes) :
+          SCoalescedAction(paNoOfNodes), mFirstNode(paFirstNode), mResponses(0){
+      }
+
+      unsigned int mFirstNode;
+      unsigned int mResponses;
+      std::vector<unsigned int> mValues;
+  };
+
+  //! Remote which answers a read of node n with the value 10 * n, counting the requests it receives
+  struct SRemote{
+      SRemote() :
+          mRequests(0){
+      }
+
+      void execute(CRequestCoalescer &paCoalescer, CCoalescedRequest &paRequest){
+        mRequests++;
+        //assemble the request from the actions' elements
+        std::vector<unsigned int> nodes;
+        for(size_t i = 0; i < paRequest.getNoOfParts(); i++){
+          const CCoalescedRequest::SPart &part(paRequest.getPart(i));
+          BOOST_REQUIRE_EQUAL(nodes.size(), part.mOffset);
+          const STestAction *action = static_cast<const STestAction*>(part.mAction);
+          for(size_t j = 0; j < part.mSize; j++){
+            nodes.push_back(action->mFirstNode + static_cast<unsigned int>(j));
+          }
+        }
+        BOOST_REQUIRE_EQUAL(paRequest.getNoOfElements(), nodes.size());
+        std::vector<unsigned int> results;
+        for(size_t i = 0; i < nodes.size(); i++){
+          results.push_back(10 * nodes[i]);
+        }
+        respond(paCoalescer, paRequest, results);
+      }
+
+      static void respond(CRequestCoalescer &paCoalescer, CCoalescedRequest &paRequest, const std::vector<unsigned int> &paResults){
+        for(size_t i = 0; i < paRequest.getNoOfParts(); i++){
+          const CCoalescedRequest::SPart &part(paRequest.getPart(i));
+          if(0 != part.mAction){
+            STestAction *action = static_cast<STestAction*>(part.mAction);
+            action->mResponses++;
+            action->mValues.assign(paResults.begin() + static_cast<std::ptrdiff_t>(part.mOffset),
+              paResults.begin() + static_cast<std::ptrdiff_t>(part.mOffset + part.mSize));
+          }
+        }
+        paCoalescer.finished(&paRequest);
+      }
+
+      unsigned int mRequests;
+  };
+
+  void checkValues(const STestAction &paAction){
+    BOOST_REQUIRE_EQUAL(paAction.mNoOfElements, paAction.mValues.size());
+    for(size_t i = 0; i < paAction.mValues.size(); i++){
+      BOOST_CHECK_EQUAL(10 * (paAction.mFirstNode + i), paAction.mValues[i]);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(RequestCoalescer)
+
+  BOOST_AUTO_TEST_CASE(actionsWithinWindowShareOneRequest){
+    CRequestCoalescer coalescer(1000);
+    SRemote remote;
+    STestAction fb1(100, 2);
+    STestAction fb2(200, 1);
+    STestAction fb3(300, 3);
+
+    BOOST_CHECK(coalescer.isEmpty());
+    BOOST_CHECK(0 == coalescer.take());
+    BOOST_CHECK(coalescer.queue(fb1, 5000));
+    BOOST_CHECK(coalescer.queue(fb2, 5200));
+    //an action triggered again before the request is sent is only read once
+    BOOST_CHECK(!coalescer.queue(fb1, 5400));
+    BOOST_CHECK(coalescer.queue(fb3, 5600));
+    BOOST_CHECK_EQUAL(400U, coalescer.getTimeToSend(5600));
+    BOOST_CHECK_EQUAL(0U, coalescer.getTimeToSend(6000));
+
+    CCoalescedRequest *request = coalescer.take();
+    BOOST_REQUIRE(0 != request);
+    BOOST_CHECK(coalescer.isEmpty());
+    BOOST_CHECK_EQUAL(3U, request->getNoOfParts());
+    BOOST_CHECK_EQUAL(6U, request->getNoOfElements());
+    BOOST_CHECK(&fb1 == request->getPart(0).mAction);
+    BOOST_CHECK(&fb2 == request->getPart(1).mAction);
+    BOOST_CHECK(&fb3 == request->getPart(2).mAction);
+    remote.execute(coalescer, *request);
+
+    BOOST_CHECK_EQUAL(1U, remote.mRequests);
+    BOOST_CHECK_EQUAL(1U, fb1.mResponses);
+    BOOST_CHECK_EQUAL(1U, fb2.mResponses);
+    BOOST_CHECK_EQUAL(1U, fb3.mResponses);
+    checkValues(fb1);
+    checkValues(fb2);
+    checkValues(fb3);
+  }
+
+  BOOST_AUTO_TEST_CASE(windowStartsWithOldestAction){
+    CRequestCoalescer coalescer(1000);
+    STestAction fb1(1, 1);
+    STestAction fb2(2, 1);
+    BOOST_CHECK_EQUAL(0U, coalescer.getTimeToSend(100));
+    coalescer.queue(fb1, 100);
+    coalescer.queue(fb2, 900);
+    BOOST_CHECK_EQUAL(200U, coalescer.getTimeToSend(900));
+
+    coalescer.finished(coalescer.take());
+    //a new window starts with the next queued action
+    coalescer.queue(fb2, 1500);
+    BOOST_CHECK_EQUAL(1000U, coalescer.getTimeToSend(1500));
+    coalescer.finished(coalescer.take());
+  }
+
+  BOOST_AUTO_TEST_CASE(actionsQueuedWhileInFlightGoToNextRequest){
+    CRequestCoalescer coalescer(0);
+    SRemote remote;
+    STestAction fb1(10, 1);
+    STestAction fb2(20, 2);
+
+    coalescer.queue(fb1, 0);
+    CCoalescedRequest *first = coalescer.take();
+    BOOST_REQUIRE(0 != first);
+    BOOST_CHECK(coalescer.queue(fb1, 1));
+    BOOST_CHECK(coalescer.queue(fb2, 1));
+    CCoalescedRequest *second = coalescer.take();
+    BOOST_REQUIRE(0 != second);
+
+    //responses may arrive in any order
+    remote.execute(coalescer, *second);
+    BOOST_CHECK_EQUAL(1U, fb1.mResponses);
+    BOOST_CHECK_EQUAL(1U, fb2.mResponses);
+    remote.execute(coalescer, *first);
+    BOOST_CHECK_EQUAL(2U, fb1.mResponses);
+    BOOST_CHECK_EQUAL(1U, fb2.mResponses);
+    BOOST_CHECK_EQUAL(2U, remote.mRequests);
+    checkValues(fb1);
+    checkValues(fb2);
+  }
+
+  BOOST_AUTO_TEST_CASE(removedActionsGetNoResponse){
+    CRequestCoalescer coalescer(0);
+    SRemote remote;
+    STestAction fb1(10, 2);
+    STestAction fb2(20, 1);
+    STestAction fb3(30, 1);
+
+    coalescer.queue(fb1, 0);
+    coalescer.queue(fb2, 0);
+    CCoalescedRequest *request = coalescer.take();
+    BOOST_REQUIRE(0 != request);
+    coalescer.queue(fb2, 0);
+    coalescer.queue(fb3, 0);
+
+    coalescer.remove(fb2);
+    BOOST_CHECK(!fb2.mQueued);
+    BOOST_CHECK(0 == request->getPart(1).mAction);
+    //the elements of the removed action stay in the request, the other actions keep their offsets
+    BOOST_CHECK_EQUAL(3U, request->getNoOfElements());
+    std::vector<unsigned int> results;
+    results.push_back(100);
+    results.push_back(110);
+    results.push_back(200);
+    SRemote::respond(coalescer, *request, results);
+    checkValues(fb1);
+    BOOST_CHECK_EQUAL(0U, fb2.mResponses);
+
+    request = coalescer.take();
+    BOOST_REQUIRE(0 != request);
+    BOOST_REQUIRE_EQUAL(1U, request->getNoOfParts());
+    BOOST_CHECK(&fb3 == request->getPart(0).mAction);
+    remote.execute(coalescer, *request);
+    checkValues(fb3);
+    BOOST_CHECK_EQUAL(0U, fb2.mResponses);
+    BOOST_CHECK(coalescer.isEmpty());
+  }
+
+  BOOST_AUTO_TEST_CASE(clearRequestsDropsRequestsInFlight){
+    CRequestCoalescer coalescer(0);
+    STestAction fb1(1, 1);
+    coalescer.queue(fb1, 0);
+    BOOST_REQUIRE(0 != coalescer.take());
+    coalescer.clearRequests();
+    //removing the action afterwards must not touch the deleted request
+    coalescer.remove(fb1);
+    BOOST_CHECK(coalescer.isEmpty());
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
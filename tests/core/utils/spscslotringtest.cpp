@@ -0,0 +1,125 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include <boost/test/unit_test.hpp>
+
+#include <spscslotring.h>
+#include <forte_atomic.h>
+#include <forte_thread.h>
+
+#ifdef FORTE_ENABLE_GENERATED_SOURCE_CPP
+#include "spscslotringtest_gen.cpp"
+#endif
+
+using namespace forte::core::util;
+
+namespace {
+  const unsigned int scmNrOfSlots = 4;
+  const unsigned int scmNrOfValues = 200000;
+  const unsigned int scmNrOfParts = 3;
+
+  //! Values written in parts, a slot that is read while being written shows different parts
+  struct SSlot{
+      unsigned int mParts[scmNrOfParts];
+  };
+
+  /** Writes increasing values to the slots without any lock, like an event chain writing the values of a node */
+  class CProducer : public CThread{
+    public:
+      CProducer(CSPSCSlotRing &paRing, SSlot *paSlots) :
+          mRing(paRing), mSlots(paSlots), mNrOfFullRing(0){
+      }
+
+      TForteUInt32 getNrOfFullRing() const {
+        return mNrOfFullRing.load();
+      }
+
+    protected:
+      void run(){
+        for(unsigned int value = 1; value <= scmNrOfValues; ++value){
+          while(mRing.isFull()){
+            mNrOfFullRing.fetchAdd(1);
+            CThread::sleepThread(0);
+          }
+          SSlot &slot = mSlots[mRing.getWriteSlot()];
+          for(unsigned int i = 0; i < scmNrOfParts; ++i){
+            slot.mParts[i] = value;
+          }
+          mRing.commitWrite();
+        }
+      }
+
+    private:
+      CSPSCSlotRing &mRing;
+      SSlot *mSlots;
+      forte::arch::CAtomicUInt32 mNrOfFullRing;
+  };
+}
+
+BOOST_AUTO_TEST_SUITE(SPSCSlotRing)
+
+  BOOST_AUTO_TEST_CASE(slotsAreHandedOutInOrder){
+    CSPSCSlotRing ring(3);
+    BOOST_CHECK_EQUAL(4U, ring.getNrOfSlots());
+    BOOST_CHECK(ring.isEmpty());
+    BOOST_CHECK(!ring.isFull());
+
+    for(unsigned int i = 0; i < ring.getNrOfSlots(); ++i){
+      BOOST_CHECK_EQUAL(i, ring.getWriteSlot());
+      ring.commitWrite();
+      BOOST_CHECK(!ring.isEmpty());
+    }
+    BOOST_CHECK(ring.isFull());
+
+    BOOST_CHECK_EQUAL(0U, ring.getReadSlot());
+    ring.commitRead();
+    BOOST_CHECK(!ring.isFull());
+    //the slot read last is the next one to be written
+    BOOST_CHECK_EQUAL(0U, ring.getWriteSlot());
+    ring.commitWrite();
+    BOOST_CHECK(ring.isFull());
+
+    for(unsigned int i = 1; i <= ring.getNrOfSlots(); ++i){
+      BOOST_CHECK_EQUAL(i % ring.getNrOfSlots(), ring.getReadSlot());
+      ring.commitRead();
+    }
+    BOOST_CHECK(ring.isEmpty());
+  }
+
+  BOOST_AUTO_TEST_CASE(consumerReadsWhileProducerWrites){
+    CSPSCSlotRing ring(scmNrOfSlots);
+    SSlot slots[scmNrOfSlots] = { { { 0 } } };
+    CProducer producer(ring, slots);
+    producer.start();
+
+    unsigned int expected = 1;
+    bool valid = true;
+    while(valid && expected <= scmNrOfValues){
+      if(ring.isEmpty()){
+        CThread::sleepThread(0);
+        continue;
+      }
+      const SSlot &slot = slots[ring.getReadSlot()];
+      for(unsigned int i = 0; i < scmNrOfParts; ++i){
+        valid = valid && (expected == slot.mParts[i]);
+      }
+      ring.commitRead();
+      ++expected;
+    }
+    producer.end();
+
+    BOOST_CHECK(valid);
+    BOOST_CHECK_EQUAL(scmNrOfValues + 1, expected);
+    BOOST_CHECK(ring.isEmpty());
+    BOOST_TEST_MESSAGE("producer found the ring full " << producer.getNrOfFullRing() << " times");
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
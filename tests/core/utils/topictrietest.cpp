@@ -0,0 +1,161 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include <boost/test/unit_test.hpp>
+
+#include <topictrie.h>
+#include <stdio.h>
+
+#ifdef FORTE_ENABLE_GENERATED_SOURCE_CPP
+#include "topictrietest_gen.cpp"
+#endif
+
+using namespace forte::core::util;
+
+namespace {
+  struct STestSubscriber {
+      unsigned int mReceived;
+  };
+
+  struct SCountingVisitor {
+      SCountingVisitor() : mCalls(0) {
+      }
+      void operator()(STestSubscriber *paSubscriber){
+        paSubscriber->mReceived++;
+        mCalls++;
+      }
+      unsigned int mCalls;
+  };
+
+  unsigned int countMatches(const CTopicTrie<STestSubscriber> &paTrie, const char *paTopic){
+    SCountingVisitor visitor;
+    paTrie.match(paTopic, visitor);
+    return visitor.mCalls;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE (TopicTrie)
+
+  BOOST_AUTO_TEST_CASE(exactMatch) {
+    CTopicTrie<STestSubscriber> trie;
+    STestSubscriber sub1 = STestSubscriber();
+    STestSubscriber sub2 = STestSubscriber();
+    trie.insert("plant/line1/temp", &sub1);
+    trie.insert("plant/line1/temp", &sub2);
+
+    BOOST_CHECK_EQUAL(2U, countMatches(trie, "plant/line1/temp"));
+    BOOST_CHECK_EQUAL(0U, countMatches(trie, "plant/line1"));
+    BOOST_CHECK_EQUAL(0U, countMatches(trie, "plant/line1/temp/raw"));
+    BOOST_CHECK_EQUAL(0U, countMatches(trie, "plant/line2/temp"));
+    BOOST_CHECK_EQUAL(1U, sub1.mReceived);
+    BOOST_CHECK_EQUAL(1U, sub2.mReceived);
+  }
+
+  BOOST_AUTO_TEST_CASE(singleLevelWildcard) {
+    CTopicTrie<STestSubscriber> trie;
+    STestSubscriber sub = STestSubscriber();
+    trie.insert("plant/+/temp", &sub);
+
+    BOOST_CHECK_EQUAL(1U, countMatches(trie, "plant/line1/temp"));
+    BOOST_CHECK_EQUAL(1U, countMatches(trie, "plant//temp"));
+    BOOST_CHECK_EQUAL(0U, countMatches(trie, "plant/line1/sub/temp"));
+    BOOST_CHECK_EQUAL(0U, countMatches(trie, "plant/temp"));
+  }
+
+  BOOST_AUTO_TEST_CASE(multiLevelWildcard) {
+    CTopicTrie<STestSubscriber> trie;
+    STestSubscriber sub = STestSubscriber();
+    STestSubscriber all = STestSubscriber();
+    trie.insert("plant/#", &sub);
+    trie.insert("#", &all);
+
+    BOOST_CHECK_EQUAL(2U, countMatches(trie, "plant/line1/temp"));
+    BOOST_CHECK_EQUAL(2U, countMatches(trie, "plant"));
+    BOOST_CHECK_EQUAL(1U, countMatches(trie, "factory/line1"));
+    //$ topics are not matched by wildcards on the first level
+    BOOST_CHECK_EQUAL(0U, countMatches(trie, "$SYS/broker/uptime"));
+  }
+
+  BOOST_AUTO_TEST_CASE(combinedWildcards) {
+    CTopicTrie<STestSubscriber> trie;
+    STestSubscriber anyPlant = STestSubscriber();
+    STestSubscriber twoLevels = STestSubscriber();
+    STestSubscriber system = STestSubscriber();
+    trie.insert("+/line1/#", &anyPlant);
+    trie.insert("plant/+/+", &twoLevels);
+    trie.insert("$SYS/#", &system);
+
+    BOOST_CHECK_EQUAL(2U, countMatches(trie, "plant/line1/temp"));
+    BOOST_CHECK_EQUAL(1U, countMatches(trie, "factory/line1"));
+    BOOST_CHECK_EQUAL(1U, countMatches(trie, "plant/line2/temp"));
+    BOOST_CHECK_EQUAL(0U, countMatches(trie, "plant/line2"));
+    //filters starting with $ still match $ topics
+    BOOST_CHECK_EQUAL(1U, countMatches(trie, "$SYS/line1/uptime"));
+    BOOST_CHECK_EQUAL(1U, system.mReceived);
+  }
+
+  BOOST_AUTO_TEST_CASE(sameEntryForSeveralFilters) {
+    CTopicTrie<STestSubscriber> trie;
+    STestSubscriber sub = STestSubscriber();
+    trie.insert("a/b", &sub);
+    trie.insert("a/+", &sub);
+
+    //the entry is visited once per matching filter
+    BOOST_CHECK_EQUAL(2U, countMatches(trie, "a/b"));
+    BOOST_CHECK(trie.remove("a/b", &sub));
+    BOOST_CHECK_EQUAL(1U, countMatches(trie, "a/b"));
+    BOOST_CHECK(!trie.isEmpty());
+    BOOST_CHECK(trie.remove("a/+", &sub));
+    BOOST_CHECK(trie.isEmpty());
+  }
+
+  BOOST_AUTO_TEST_CASE(removeEntries) {
+    CTopicTrie<STestSubscriber> trie;
+    STestSubscriber sub1 = STestSubscriber();
+    STestSubscriber sub2 = STestSubscriber();
+    trie.insert("a/b/c", &sub1);
+    trie.insert("a/+/c", &sub2);
+
+    BOOST_CHECK(!trie.remove("a/b", &sub1));
+    BOOST_CHECK(!trie.remove("a/b/c", &sub2));
+    BOOST_CHECK(trie.remove("a/b/c", &sub1));
+    BOOST_CHECK_EQUAL(1U, countMatches(trie, "a/b/c"));
+    BOOST_CHECK(trie.remove("a/+/c", &sub2));
+    BOOST_CHECK_EQUAL(0U, countMatches(trie, "a/b/c"));
+    BOOST_CHECK(trie.isEmpty());
+  }
+
+  BOOST_AUTO_TEST_CASE(manyTopicsDispatch) {
+    const unsigned int numTopics = 2000;
+    const unsigned int numRounds = 50;
+    CTopicTrie<STestSubscriber> trie;
+    STestSubscriber subs[numTopics];
+    char topic[64];
+
+    for(unsigned int i = 0; i < numTopics; i++){
+      subs[i].mReceived = 0;
+      snprintf(topic, sizeof(topic), "plant/line%u/sensor%u", i % 20, i);
+      trie.insert(topic, &subs[i]);
+    }
+
+    for(unsigned int round = 0; round < numRounds; round++){
+      for(unsigned int i = 0; i < numTopics; i++){
+        snprintf(topic, sizeof(topic), "plant/line%u/sensor%u", i % 20, i);
+        BOOST_REQUIRE_EQUAL(1U, countMatches(trie, topic));
+      }
+    }
+
+    for(unsigned int i = 0; i < numTopics; i++){
+      BOOST_CHECK_EQUAL(numRounds, subs[i].mReceived);
+    }
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
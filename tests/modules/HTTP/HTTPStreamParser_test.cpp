@@ -0,0 +1,137 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include <boost/test/unit_test.hpp>
+
+#include "../../../src/com/HTTP/httpstreamparser.h"
+#include <string.h>
+
+using forte::com_infra::CHttpStreamParser;
+
+BOOST_AUTO_TEST_SUITE (HTTPStreamParser_test)
+
+  BOOST_AUTO_TEST_CASE(getRequestWithParameters) {
+    CHttpStreamParser parser(CHttpStreamParser::e_Request);
+    const char* request = "GET /path/to/look?key1=val1&key2=val2 HTTP/1.1\r\nHost: 0.0.0.0\r\n\r\n";
+
+    BOOST_CHECK_EQUAL(CHttpStreamParser::e_MessageComplete, parser.append(request, strlen(request)));
+    BOOST_CHECK_EQUAL(forte::com_infra::CHttpComLayer::e_GET, parser.getRequestType());
+    BOOST_CHECK(parser.getPath().equals("/path/to/look"));
+    BOOST_CHECK(parser.getQuery().equals("key1=val1&key2=val2"));
+    BOOST_CHECK_EQUAL(0U, parser.getBody().mLength);
+    BOOST_CHECK(parser.isKeepAlive());
+
+    CHttpStreamParser::SSpan query = parser.getQuery();
+    CHttpStreamParser::SSpan name;
+    CHttpStreamParser::SSpan value;
+    BOOST_CHECK(CHttpStreamParser::getNextQueryParameter(query, name, value));
+    BOOST_CHECK(name.equals("key1"));
+    BOOST_CHECK(value.equals("val1"));
+    BOOST_CHECK(CHttpStreamParser::getNextQueryParameter(query, name, value));
+    BOOST_CHECK(name.equals("key2"));
+    BOOST_CHECK(value.equals("val2"));
+    BOOST_CHECK(!CHttpStreamParser::getNextQueryParameter(query, name, value));
+  }
+
+  BOOST_AUTO_TEST_CASE(partialReads) {
+    CHttpStreamParser parser(CHttpStreamParser::e_Request);
+    const char* request = "PUT /data HTTP/1.1\r\nHost: 0.0.0.0\r\nContent-Length: 19\r\n\r\nkey1=val1;key2=val2";
+    size_t length = strlen(request);
+
+    for(size_t i = 0; i < length - 1; i++) {
+      BOOST_REQUIRE_EQUAL(CHttpStreamParser::e_NeedMoreData, parser.append(request + i, 1));
+    }
+    BOOST_CHECK_EQUAL(CHttpStreamParser::e_MessageComplete, parser.append(request + length - 1, 1));
+    BOOST_CHECK_EQUAL(forte::com_infra::CHttpComLayer::e_PUT, parser.getRequestType());
+    BOOST_CHECK(parser.getPath().equals("/data"));
+    BOOST_CHECK(parser.getBody().equals("key1=val1;key2=val2"));
+  }
+
+  BOOST_AUTO_TEST_CASE(pipelinedRequests) {
+    CHttpStreamParser parser(CHttpStreamParser::e_Request);
+    const char* requests = "POST /first HTTP/1.1\r\ncontent-length: 3\r\n\r\nabcGET /second HTTP/1.1\r\n\r\nGET /third HTTP/1.1\r\nConnection: close\r\n\r\n";
+
+    BOOST_CHECK_EQUAL(CHttpStreamParser::e_MessageComplete, parser.append(requests, strlen(requests)));
+    BOOST_CHECK(parser.getPath().equals("/first"));
+    BOOST_CHECK(parser.getBody().equals("abc"));
+    parser.consumeMessage();
+    BOOST_CHECK(parser.hasBufferedData());
+
+    BOOST_CHECK_EQUAL(CHttpStreamParser::e_MessageComplete, parser.parse());
+    BOOST_CHECK(parser.getPath().equals("/second"));
+    BOOST_CHECK(parser.isKeepAlive());
+    parser.consumeMessage();
+
+    BOOST_CHECK_EQUAL(CHttpStreamParser::e_MessageComplete, parser.parse());
+    BOOST_CHECK(parser.getPath().equals("/third"));
+    BOOST_CHECK(!parser.isKeepAlive());
+    parser.consumeMessage();
+    BOOST_CHECK(!parser.hasBufferedData());
+    BOOST_CHECK_EQUAL(CHttpStreamParser::e_NeedMoreData, parser.parse());
+  }
+
+  BOOST_AUTO_TEST_CASE(chunkedResponse) {
+    CHttpStreamParser parser(CHttpStreamParser::e_Response);
+    const char* response1 = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n4\r\nWiki\r\n5;ext=1\r\npedia\r\n";
+    const char* response2 = "E\r\n in\r\n\r\nchunks.\r\n0\r\nTrailer: value\r\n\r\nHTTP/1.1 204 No Content\r\n\r\n";
+
+    BOOST_CHECK_EQUAL(CHttpStreamParser::e_NeedMoreData, parser.append(response1, strlen(response1)));
+    BOOST_CHECK_EQUAL(CHttpStreamParser::e_MessageComplete, parser.append(response2, strlen(response2)));
+    BOOST_CHECK(parser.getStatusCode().equals("200"));
+    BOOST_CHECK(parser.getBody().equals("Wikipedia in\r\n\r\nchunks."));
+    BOOST_CHECK(parser.isKeepAlive());
+    parser.consumeMessage();
+
+    BOOST_CHECK_EQUAL(CHttpStreamParser::e_MessageComplete, parser.parse());
+    BOOST_CHECK(parser.getStatusCode().equals("204"));
+    BOOST_CHECK_EQUAL(0U, parser.getBody().mLength);
+  }
+
+  BOOST_AUTO_TEST_CASE(responseUntilClose) {
+    CHttpStreamParser parser(CHttpStreamParser::e_Response);
+    const char* response = "HTTP/1.0 200 OK\r\nContent-Type: text/html\r\n\r\nkey1=val1";
+
+    BOOST_CHECK_EQUAL(CHttpStreamParser::e_NeedMoreData, parser.append(response, strlen(response)));
+    BOOST_CHECK_EQUAL(CHttpStreamParser::e_MessageComplete, parser.endOfStream());
+    BOOST_CHECK(parser.getBody().equals("key1=val1"));
+    BOOST_CHECK(!parser.isKeepAlive());
+  }
+
+  BOOST_AUTO_TEST_CASE(invalidMessages) {
+    CHttpStreamParser responseParser(CHttpStreamParser::e_Response);
+    const char* wrongStatusLine = "HTTP/1.1 200OK\r\nContent-Type: text/html\r\n\r\n";
+    BOOST_CHECK_EQUAL(CHttpStreamParser::e_ParseError, responseParser.append(wrongStatusLine, strlen(wrongStatusLine)));
+
+    CHttpStreamParser requestParser(CHttpStreamParser::e_Request);
+    const char* noVersion = "GET /path\r\n\r\n";
+    BOOST_CHECK_EQUAL(CHttpStreamParser::e_ParseError, requestParser.append(noVersion, strlen(noVersion)));
+
+    CHttpStreamParser chunkParser(CHttpStreamParser::e_Request);
+    const char* wrongChunk = "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\nxyz\r\n";
+    BOOST_CHECK_EQUAL(CHttpStreamParser::e_ParseError, chunkParser.append(wrongChunk, strlen(wrongChunk)));
+
+    CHttpStreamParser truncatedParser(CHttpStreamParser::e_Request);
+    const char* truncated = "PUT / HTTP/1.1\r\nContent-Length: 10\r\n\r\nabc";
+    BOOST_CHECK_EQUAL(CHttpStreamParser::e_NeedMoreData, truncatedParser.append(truncated, strlen(truncated)));
+    BOOST_CHECK_EQUAL(CHttpStreamParser::e_ParseError, truncatedParser.endOfStream());
+  }
+
+  BOOST_AUTO_TEST_CASE(messageTooLarge) {
+    CHttpStreamParser parser(CHttpStreamParser::e_Request, 64);
+    const char* request = "PUT / HTTP/1.1\r\nContent-Length: 100\r\n\r\n";
+    BOOST_CHECK_EQUAL(CHttpStreamParser::e_MessageTooLarge, parser.append(request, strlen(request)));
+
+    CHttpStreamParser headerParser(CHttpStreamParser::e_Request, 16);
+    const char* longHeader = "GET /a/very/long/path";
+    BOOST_CHECK_EQUAL(CHttpStreamParser::e_MessageTooLarge, headerParser.append(longHeader, strlen(longHeader)));
+  }
+
+  BOOST_AUTO_TEST_SUITE_END()
@@ -156,7 +156,7 @@ BOOST_AUTO_TEST_SUITE (HTTPParser_function_test)
   BOOST_AUTO_TEST_CASE(createResponse_test) {
 
     const char* validResult = "HTTP/1.1 200 OK\r\nContent-type: application/json\r\nContent-length: 29\r\n\r\n{\"key1\" : val1,\"key2\" : val2}";
-    const char* validResultNoBody = "HTTP/1.1 200 OK\r\n";
+    const char* validResultNoBody = "HTTP/1.1 200 OK\r\nContent-length: 0\r\n\r\n";
 
     CIEC_STRING dest;
     CIEC_STRING result = "HTTP/1.1 200 OK";
@@ -0,0 +1,154 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include <boost/test/unit_test.hpp>
+
+#include "../../../src/com/modbus/modbuspoll.h"
+#include <forte_thread.h>
+#include <string.h>
+#include <unistd.h>
+
+namespace {
+  const int scmServerPort = 15502;
+
+  /** Local Modbus TCP server answering the requests of one client from a register image */
+  class CModbusTestServer : public CThread {
+    public:
+      CModbusTestServer() :
+          mContext(modbus_new_tcp("127.0.0.1", scmServerPort)), mMapping(modbus_mapping_new(500, 0, 500, 0)), mListenSocket(-1), mNrOfRequests(0) {
+        mListenSocket = modbus_tcp_listen(mContext, 1);
+      }
+
+      ~CModbusTestServer() {
+        end();
+        modbus_mapping_free(mMapping);
+        modbus_free(mContext);
+        close(mListenSocket);
+      }
+
+      uint16_t *getRegisters() {
+        return mMapping->tab_registers;
+      }
+
+      uint8_t *getBits() {
+        return mMapping->tab_bits;
+      }
+
+      unsigned int getNrOfRequests() const {
+        return mNrOfRequests;
+      }
+
+    protected:
+      void run() {
+        if(modbus_tcp_accept(mContext, &mListenSocket) < 0) {
+          return;
+        }
+        uint8_t query[MODBUS_TCP_MAX_ADU_LENGTH];
+        while(isAlive()) {
+          int length = modbus_receive(mContext, query);
+          if(length > 0) {
+            mNrOfRequests++;
+            modbus_reply(mContext, query, length, mMapping);
+          } else if(length < 0) {
+            break; // client closed the connection
+          }
+        }
+        modbus_close(mContext);
+      }
+
+    private:
+      modbus_t *mContext;
+      modbus_mapping_t *mMapping;
+      int mListenSocket;
+      unsigned int mNrOfRequests;
+  };
+
+  struct SModbusPollFixture {
+      SModbusPollFixture() :
+          mClient(modbus_new_tcp("127.0.0.1", scmServerPort)) {
+        memset(mRecvBuffer, 0, sizeof(mRecvBuffer));
+        mServer.start();
+        BOOST_REQUIRE_EQUAL(0, modbus_connect(mClient));
+      }
+
+      ~SModbusPollFixture() {
+        modbus_close(mClient);
+        modbus_free(mClient);
+      }
+
+      CModbusTestServer mServer;
+      modbus_t *mClient;
+      uint8_t mRecvBuffer[512];
+  };
+}
+
+BOOST_FIXTURE_TEST_SUITE(ModbusPoll_test, SModbusPollFixture)
+
+  BOOST_AUTO_TEST_CASE(adjacentRangesAreReadWithOneRequest) {
+    for(uint16_t i = 0; i < 20; i++) {
+      mServer.getRegisters()[10 + i] = static_cast<uint16_t>(1000 + i);
+    }
+
+    // configured out of order, the receive buffer keeps the configuration order
+    CModbusPoll poll(100, 3, 20, 10, 0);
+    poll.addPollAddresses(10, 10, 20);
+
+    BOOST_CHECK_EQUAL(20, poll.executeEvent(mClient, mRecvBuffer));
+    BOOST_CHECK_EQUAL(1U, mServer.getNrOfRequests());
+    BOOST_CHECK(poll.hasChanged());
+
+    uint16_t values[20];
+    memcpy(values, mRecvBuffer, sizeof(values));
+    BOOST_CHECK_EQUAL(1010, values[0]);
+    BOOST_CHECK_EQUAL(1019, values[9]);
+    BOOST_CHECK_EQUAL(1000, values[10]);
+    BOOST_CHECK_EQUAL(1009, values[19]);
+  }
+
+  BOOST_AUTO_TEST_CASE(onlyChangedValuesAreNotified) {
+    CModbusPoll poll(100, 3, 0, 4, 0);
+    poll.addPollAddresses(200, 130, 8);
+
+    BOOST_CHECK_EQUAL(134, poll.executeEvent(mClient, mRecvBuffer));
+    BOOST_CHECK(poll.hasChanged());
+    // the second range exceeds the maximum number of registers of one request
+    BOOST_CHECK_EQUAL(3U, mServer.getNrOfRequests());
+
+    BOOST_CHECK_EQUAL(134, poll.executeEvent(mClient, mRecvBuffer));
+    BOOST_CHECK(!poll.hasChanged());
+
+    mServer.getRegisters()[329] = 42;
+    BOOST_CHECK_EQUAL(134, poll.executeEvent(mClient, mRecvBuffer));
+    BOOST_CHECK(poll.hasChanged());
+    uint16_t lastValue;
+    memcpy(&lastValue, &mRecvBuffer[8 + 129 * sizeof(uint16_t)], sizeof(lastValue));
+    BOOST_CHECK_EQUAL(42, lastValue);
+
+    BOOST_CHECK_EQUAL(134, poll.executeEvent(mClient, mRecvBuffer));
+    BOOST_CHECK(!poll.hasChanged());
+  }
+
+  BOOST_AUTO_TEST_CASE(coilsAreStoredAsBytes) {
+    mServer.getBits()[5] = 1;
+    mServer.getBits()[7] = 1;
+
+    CModbusPoll poll(100, 1, 4, 2, 0);
+    poll.addPollAddresses(6, 2, 2);
+
+    BOOST_CHECK_EQUAL(4, poll.executeEvent(mClient, mRecvBuffer));
+    BOOST_CHECK_EQUAL(1U, mServer.getNrOfRequests());
+    BOOST_CHECK_EQUAL(0, mRecvBuffer[0]);
+    BOOST_CHECK_EQUAL(1, mRecvBuffer[1]);
+    BOOST_CHECK_EQUAL(0, mRecvBuffer[2]);
+    BOOST_CHECK_EQUAL(1, mRecvBuffer[3]);
+  }
+
+  BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,107 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include <boost/test/unit_test.hpp>
+
+#include "../../../src/com/modbus/modbuspolloptimizer.h"
+
+BOOST_AUTO_TEST_SUITE (ModbusPollOptimizer_test)
+
+  BOOST_AUTO_TEST_CASE(mergeAdjacentAndOverlapping) {
+    CModbusPollOptimizer optimizer(0, 125);
+    unsigned int first = optimizer.addRange(10, 5);
+    unsigned int second = optimizer.addRange(15, 5);
+    unsigned int third = optimizer.addRange(12, 2);
+    unsigned int fourth = optimizer.addRange(0, 4);
+    optimizer.optimize();
+
+    BOOST_REQUIRE_EQUAL(2U, optimizer.getNrOfBlocks());
+    BOOST_CHECK_EQUAL(0U, optimizer.getBlock(0).m_nStartAddress);
+    BOOST_CHECK_EQUAL(4U, optimizer.getBlock(0).m_nNrAddresses);
+    BOOST_CHECK_EQUAL(10U, optimizer.getBlock(1).m_nStartAddress);
+    BOOST_CHECK_EQUAL(10U, optimizer.getBlock(1).m_nNrAddresses);
+    BOOST_CHECK_EQUAL(14U, optimizer.getNrOfReadValues());
+
+    BOOST_CHECK_EQUAL(4U, optimizer.getReadPosition(first));
+    BOOST_CHECK_EQUAL(9U, optimizer.getReadPosition(second));
+    BOOST_CHECK_EQUAL(6U, optimizer.getReadPosition(third));
+    BOOST_CHECK_EQUAL(0U, optimizer.getReadPosition(fourth));
+  }
+
+  BOOST_AUTO_TEST_CASE(mergeWithinGap) {
+    CModbusPollOptimizer optimizer(3, 125);
+    unsigned int first = optimizer.addRange(0, 2);
+    unsigned int second = optimizer.addRange(5, 2);
+    unsigned int third = optimizer.addRange(11, 2);
+    optimizer.optimize();
+
+    BOOST_REQUIRE_EQUAL(2U, optimizer.getNrOfBlocks());
+    BOOST_CHECK_EQUAL(0U, optimizer.getBlock(0).m_nStartAddress);
+    BOOST_CHECK_EQUAL(7U, optimizer.getBlock(0).m_nNrAddresses);
+    BOOST_CHECK_EQUAL(11U, optimizer.getBlock(1).m_nStartAddress);
+    BOOST_CHECK_EQUAL(2U, optimizer.getBlock(1).m_nNrAddresses);
+
+    BOOST_CHECK_EQUAL(0U, optimizer.getReadPosition(first));
+    BOOST_CHECK_EQUAL(5U, optimizer.getReadPosition(second));
+    BOOST_CHECK_EQUAL(7U, optimizer.getReadPosition(third));
+  }
+
+  BOOST_AUTO_TEST_CASE(splitAtMaximumBlockSize) {
+    CModbusPollOptimizer optimizer(0, 125);
+    unsigned int first = optimizer.addRange(100, 200);
+    unsigned int second = optimizer.addRange(300, 60);
+    optimizer.optimize();
+
+    BOOST_REQUIRE_EQUAL(3U, optimizer.getNrOfBlocks());
+    BOOST_CHECK_EQUAL(100U, optimizer.getBlock(0).m_nStartAddress);
+    BOOST_CHECK_EQUAL(125U, optimizer.getBlock(0).m_nNrAddresses);
+    BOOST_CHECK_EQUAL(225U, optimizer.getBlock(1).m_nStartAddress);
+    BOOST_CHECK_EQUAL(125U, optimizer.getBlock(1).m_nNrAddresses);
+    BOOST_CHECK_EQUAL(350U, optimizer.getBlock(2).m_nStartAddress);
+    BOOST_CHECK_EQUAL(10U, optimizer.getBlock(2).m_nNrAddresses);
+
+    BOOST_CHECK_EQUAL(0U, optimizer.getReadPosition(first));
+    BOOST_CHECK_EQUAL(200U, optimizer.getReadPosition(second));
+  }
+
+  BOOST_AUTO_TEST_CASE(gapNotBridgedIfMoreRequestsAreNeeded) {
+    CModbusPollOptimizer optimizer(10, 125);
+    optimizer.addRange(0, 125);
+    optimizer.addRange(130, 125);
+    optimizer.optimize();
+
+    BOOST_REQUIRE_EQUAL(2U, optimizer.getNrOfBlocks());
+    BOOST_CHECK_EQUAL(0U, optimizer.getBlock(0).m_nStartAddress);
+    BOOST_CHECK_EQUAL(130U, optimizer.getBlock(1).m_nStartAddress);
+    BOOST_CHECK_EQUAL(250U, optimizer.getNrOfReadValues());
+  }
+
+  BOOST_AUTO_TEST_CASE(reoptimizeAfterAddingRanges) {
+    CModbusPollOptimizer optimizer(0, 2000);
+    BOOST_CHECK_EQUAL(0U, optimizer.getNrOfBlocks());
+    optimizer.optimize();
+    BOOST_CHECK_EQUAL(0U, optimizer.getNrOfBlocks());
+
+    for(unsigned int i = 0; i < 20; i++) {
+      optimizer.addRange(i * 8, 8);
+    }
+    optimizer.optimize();
+    BOOST_REQUIRE_EQUAL(1U, optimizer.getNrOfBlocks());
+    BOOST_CHECK_EQUAL(160U, optimizer.getBlock(0).m_nNrAddresses);
+    BOOST_CHECK_EQUAL(80U, optimizer.getReadPosition(10));
+
+    optimizer.addRange(500, 1);
+    optimizer.optimize();
+    BOOST_CHECK_EQUAL(2U, optimizer.getNrOfBlocks());
+    BOOST_CHECK_EQUAL(160U, optimizer.getReadPosition(20));
+  }
+
+  BOOST_AUTO_TEST_SUITE_END()
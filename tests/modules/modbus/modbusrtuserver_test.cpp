@@ -0,0 +1,193 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include <boost/test/unit_test.hpp>
+
+#include "../../../src/com/modbus/modbusrtuserverconnection.h"
+#include <string.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace {
+  const unsigned int scmSlaveId = 17;
+
+  /** Builds a Modbus RTU request for function codes 1 - 6 into paBuffer and returns its size */
+  unsigned int buildRequest(TForteUInt8 *paBuffer, TForteUInt8 paSlaveId, TForteUInt8 paFunctionCode, TForteUInt16 paAddress, TForteUInt16 paValue) {
+    const TForteUInt8 request[] = { paSlaveId, paFunctionCode, static_cast<TForteUInt8>(paAddress >> 8), static_cast<TForteUInt8>(paAddress),
+      static_cast<TForteUInt8>(paValue >> 8), static_cast<TForteUInt8>(paValue) };
+    memcpy(paBuffer, request, sizeof(request));
+    TForteUInt16 crc = CModbusRtuServerConnection::calculateCrc(paBuffer, sizeof(request));
+    paBuffer[sizeof(request)] = static_cast<TForteUInt8>(crc);
+    paBuffer[sizeof(request) + 1] = static_cast<TForteUInt8>(crc >> 8);
+    return sizeof(request) + 2;
+  }
+
+  TForteUInt16 getRegister(const TForteUInt8 *paResponse, unsigned int paIndex) {
+    return static_cast<TForteUInt16>((paResponse[3 + 2 * paIndex] << 8) | paResponse[4 + 2 * paIndex]);
+  }
+
+  bool hasValidCrc(const TForteUInt8 *paFrame, unsigned int paSize) {
+    TForteUInt16 crc = CModbusRtuServerConnection::calculateCrc(paFrame, paSize - 2);
+    return (paFrame[paSize - 2] == static_cast<TForteUInt8>(crc)) && (paFrame[paSize - 1] == static_cast<TForteUInt8>(crc >> 8));
+  }
+
+  /** Pseudo terminal standing in for the serial line, the test is the master on the master side */
+  class CPseudoTerminal {
+    public:
+      CPseudoTerminal() :
+          mMaster(posix_openpt(O_RDWR | O_NOCTTY)) {
+        if(-1 != mMaster && (0 != grantpt(mMaster) || 0 != unlockpt(mMaster))) {
+          close(mMaster);
+          mMaster = -1;
+        }
+      }
+
+      ~CPseudoTerminal() {
+        if(-1 != mMaster) {
+          close(mMaster);
+        }
+      }
+
+      const char *getSlaveDevice() const {
+        return (-1 != mMaster) ? ptsname(mMaster) : "";
+      }
+
+      bool receiveAll(TForteUInt8 *paBuffer, unsigned int paSize) {
+        unsigned int received = 0;
+        while(received < paSize) {
+          struct pollfd descriptor = { mMaster, POLLIN, 0 };
+          if(1 != poll(&descriptor, 1, 5000)) {
+            return false;
+          }
+          ssize_t nrBytes = read(mMaster, &paBuffer[received], paSize - received);
+          if(nrBytes <= 0) {
+            return false;
+          }
+          received += static_cast<unsigned int>(nrBytes);
+        }
+        return true;
+      }
+
+      int mMaster;
+  };
+}
+
+BOOST_AUTO_TEST_SUITE (ModbusRtuServer_test)
+
+  BOOST_AUTO_TEST_CASE(crc) {
+    const TForteUInt8 frame[] = { 0x01, 0x03, 0x00, 0x00, 0x00, 0x0A };
+    BOOST_CHECK_EQUAL(0xCDC5, CModbusRtuServerConnection::calculateCrc(frame, sizeof(frame)));
+  }
+
+  BOOST_AUTO_TEST_CASE(requestSize) {
+    TForteUInt8 request[CModbusRtuServerConnection::scm_nMaxAduSize];
+    buildRequest(request, scmSlaveId, 3, 0, 1);
+    BOOST_CHECK_EQUAL(0U, CModbusRtuServerConnection::getRequestSize(request, 1));
+    BOOST_CHECK_EQUAL(8U, CModbusRtuServerConnection::getRequestSize(request, 2));
+
+    const TForteUInt8 writeRegisters[] = { scmSlaveId, 16, 0, 20, 0, 2, 4 };
+    BOOST_CHECK_EQUAL(0U, CModbusRtuServerConnection::getRequestSize(writeRegisters, 6));
+    BOOST_CHECK_EQUAL(13U, CModbusRtuServerConnection::getRequestSize(writeRegisters, 7));
+
+    // unknown function codes end with the silent interval
+    buildRequest(request, scmSlaveId, 43, 0, 0);
+    BOOST_CHECK_EQUAL(0U, CModbusRtuServerConnection::getRequestSize(request, 8));
+  }
+
+  BOOST_AUTO_TEST_CASE(processFrames) {
+    CModbusRtuServerConnection server("/dev/null", 19200, 'E', 8, 1, scmSlaveId);
+    const TForteUInt16 values[] = { 0x1234, 0xABCD };
+    server.getRegisterImage().write(CModbusRegisterImage::e_HoldingRegisters, 100, 2, values);
+
+    TForteUInt8 request[CModbusRtuServerConnection::scm_nMaxAduSize];
+    TForteUInt8 response[CModbusRtuServerConnection::scm_nMaxAduSize];
+
+    unsigned int size = buildRequest(request, scmSlaveId, 3, 100, 2);
+    BOOST_REQUIRE_EQUAL(9U, server.processFrame(request, size, response));
+    BOOST_CHECK_EQUAL(scmSlaveId, response[0]);
+    BOOST_CHECK_EQUAL(3, response[1]);
+    BOOST_CHECK_EQUAL(4, response[2]);
+    BOOST_CHECK_EQUAL(0x1234, getRegister(response, 0));
+    BOOST_CHECK_EQUAL(0xABCD, getRegister(response, 1));
+    BOOST_CHECK(hasValidCrc(response, 9));
+
+    // requests for other slaves and corrupted frames are not answered
+    size = buildRequest(request, scmSlaveId + 1, 3, 100, 2);
+    BOOST_CHECK_EQUAL(0U, server.processFrame(request, size, response));
+    size = buildRequest(request, scmSlaveId, 3, 100, 2);
+    request[size - 1] ^= 0x01;
+    BOOST_CHECK_EQUAL(0U, server.processFrame(request, size, response));
+    BOOST_CHECK_EQUAL(0U, server.processFrame(request, 3, response));
+
+    // broadcasts are executed without an answer
+    size = buildRequest(request, 0, 6, 7, 42);
+    BOOST_CHECK_EQUAL(0U, server.processFrame(request, size, response));
+    TForteUInt16 value = 0;
+    server.getRegisterImage().readRegisters(CModbusRegisterImage::e_HoldingRegisters, 7, 1, &value);
+    BOOST_CHECK_EQUAL(42, value);
+
+    size = buildRequest(request, scmSlaveId, 43, 0, 0);
+    BOOST_REQUIRE_EQUAL(5U, server.processFrame(request, size, response));
+    BOOST_CHECK_EQUAL(43 | 0x80, response[1]);
+    BOOST_CHECK_EQUAL(1, response[2]);
+  }
+
+  BOOST_AUTO_TEST_CASE(invalidSettings) {
+    CPseudoTerminal terminal;
+    BOOST_REQUIRE(-1 != terminal.mMaster);
+    CModbusRtuServerConnection invalidSlaveId(terminal.getSlaveDevice(), 19200, 'E', 8, 1, 248);
+    BOOST_CHECK_EQUAL(-1, invalidSlaveId.listen());
+    CModbusRtuServerConnection invalidBaud(terminal.getSlaveDevice(), 12345, 'E', 8, 1, scmSlaveId);
+    BOOST_CHECK_EQUAL(-1, invalidBaud.listen());
+    CModbusRtuServerConnection invalidParity(terminal.getSlaveDevice(), 19200, 'X', 8, 1, scmSlaveId);
+    BOOST_CHECK_EQUAL(-1, invalidParity.listen());
+    CModbusRtuServerConnection noSerialDevice("/dev/null", 19200, 'E', 8, 1, scmSlaveId);
+    BOOST_CHECK_EQUAL(-1, noSerialDevice.listen());
+  }
+
+  BOOST_AUTO_TEST_CASE(serveOnSerialDevice) {
+    CPseudoTerminal terminal;
+    BOOST_REQUIRE(-1 != terminal.mMaster);
+    CModbusRtuServerConnection server(terminal.getSlaveDevice(), 115200, 'N', 8, 1, scmSlaveId);
+    const TForteUInt16 values[] = { 11, 22 };
+    server.getRegisterImage().write(CModbusRegisterImage::e_InputRegisters, 0, 2, values);
+    BOOST_REQUIRE_EQUAL(0, server.listen());
+    BOOST_CHECK(server.isRtuDevice(terminal.getSlaveDevice()));
+    BOOST_CHECK(server.hasSettings(115200, 'N', 8, 1, scmSlaveId));
+    BOOST_CHECK(!server.hasSettings(115200, 'N', 8, 1, scmSlaveId + 1));
+
+    // two requests in one write are split by their size
+    TForteUInt8 requests[16];
+    buildRequest(requests, scmSlaveId, 4, 0, 1);
+    buildRequest(&requests[8], scmSlaveId, 4, 1, 1);
+    BOOST_REQUIRE_EQUAL(16, write(terminal.mMaster, requests, sizeof(requests)));
+
+    TForteUInt8 responses[14];
+    BOOST_REQUIRE(terminal.receiveAll(responses, sizeof(responses)));
+    BOOST_CHECK(hasValidCrc(responses, 7));
+    BOOST_CHECK_EQUAL(11, getRegister(responses, 0));
+    BOOST_CHECK(hasValidCrc(&responses[7], 7));
+    BOOST_CHECK_EQUAL(22, getRegister(&responses[7], 0));
+
+    // a request for another slave is skipped, the next one is answered
+    buildRequest(requests, scmSlaveId + 1, 4, 0, 1);
+    buildRequest(&requests[8], scmSlaveId, 6, 3, 33);
+    BOOST_REQUIRE_EQUAL(16, write(terminal.mMaster, requests, sizeof(requests)));
+    TForteUInt8 response[8];
+    BOOST_REQUIRE(terminal.receiveAll(response, sizeof(response)));
+    BOOST_CHECK_EQUAL(0, memcmp(&requests[8], response, sizeof(response)));
+
+    server.stop();
+  }
+
+  BOOST_AUTO_TEST_SUITE_END()
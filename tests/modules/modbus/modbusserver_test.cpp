@@ -0,0 +1,264 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include <boost/test/unit_test.hpp>
+
+#include "../../../src/com/modbus/modbustcpserverconnection.h"
+#include <forte_thread.h>
+#include <string.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+  const unsigned int scmServerPort = 15503;
+  const unsigned int scmNrOfRequestsPerClient = 500;
+
+  /** Builds a Modbus TCP request for function codes 1 - 6 into paBuffer and returns its size */
+  unsigned int buildRequest(TForteUInt8 *paBuffer, TForteUInt16 paTransactionId, TForteUInt8 paFunctionCode, TForteUInt16 paAddress, TForteUInt16 paValue) {
+    const TForteUInt8 request[] = { static_cast<TForteUInt8>(paTransactionId >> 8), static_cast<TForteUInt8>(paTransactionId), 0, 0, 0, 6, 1,
+      paFunctionCode, static_cast<TForteUInt8>(paAddress >> 8), static_cast<TForteUInt8>(paAddress), static_cast<TForteUInt8>(paValue >> 8),
+      static_cast<TForteUInt8>(paValue) };
+    memcpy(paBuffer, request, sizeof(request));
+    return sizeof(request);
+  }
+
+  TForteUInt16 getRegister(const TForteUInt8 *paResponse, unsigned int paIndex) {
+    return static_cast<TForteUInt16>((paResponse[9 + 2 * paIndex] << 8) | paResponse[10 + 2 * paIndex]);
+  }
+
+  int connectToServer() {
+    int clientSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(scmServerPort);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if(0 != connect(clientSocket, reinterpret_cast<struct sockaddr*>(&address), sizeof(address))) {
+      close(clientSocket);
+      return -1;
+    }
+    return clientSocket;
+  }
+
+  bool receiveAll(int paSocket, TForteUInt8 *paBuffer, unsigned int paSize) {
+    unsigned int received = 0;
+    while(received < paSize) {
+      ssize_t nrBytes = recv(paSocket, &paBuffer[received], paSize - received, 0);
+      if(nrBytes <= 0) {
+        return false;
+      }
+      received += static_cast<unsigned int>(nrBytes);
+    }
+    return true;
+  }
+
+  /** Modbus master reading one block of holding registers, which must always be consistent */
+  class CLoadTestClient : public CThread {
+    public:
+      CLoadTestClient() :
+          mNrOfResponses(0), mNrOfInconsistentResponses(0) {
+      }
+
+      unsigned int mNrOfResponses;
+      unsigned int mNrOfInconsistentResponses;
+
+    protected:
+      void run() {
+        int clientSocket = connectToServer();
+        if(-1 == clientSocket) {
+          return;
+        }
+        TForteUInt8 buffer[CModbusTcpServerConnection::scm_nMaxAduSize];
+        for(unsigned int i = 0; i < scmNrOfRequestsPerClient && isAlive(); i++) {
+          unsigned int size = buildRequest(buffer, static_cast<TForteUInt16>(i), 3, 0, CModbusRegisterImage::scm_nBlockSize);
+          if(send(clientSocket, buffer, size, 0) != static_cast<ssize_t>(size)
+            || !receiveAll(clientSocket, buffer, 9 + 2 * CModbusRegisterImage::scm_nBlockSize)) {
+            break;
+          }
+          mNrOfResponses++;
+          for(unsigned int j = 1; j < CModbusRegisterImage::scm_nBlockSize; j++) {
+            if(getRegister(buffer, j) != getRegister(buffer, 0)) {
+              mNrOfInconsistentResponses++;
+              break;
+            }
+          }
+        }
+        close(clientSocket);
+      }
+  };
+
+  /** Sets a block of holding registers to the same value again and again, until it is stopped */
+  class CLoadTestWriter : public CThread {
+    public:
+      explicit CLoadTestWriter(CModbusRegisterImage &paImage) :
+          mImage(paImage) {
+      }
+
+    protected:
+      void run() {
+        TForteUInt16 values[CModbusRegisterImage::scm_nBlockSize];
+        for(TForteUInt16 round = 1; isAlive(); round++) {
+          for(unsigned int i = 0; i < CModbusRegisterImage::scm_nBlockSize; i++) {
+            values[i] = round;
+          }
+          mImage.write(CModbusRegisterImage::e_HoldingRegisters, 0, CModbusRegisterImage::scm_nBlockSize, values);
+        }
+      }
+
+    private:
+      CModbusRegisterImage &mImage;
+  };
+}
+
+BOOST_AUTO_TEST_SUITE (ModbusServer_test)
+
+  BOOST_AUTO_TEST_CASE(registerImage) {
+    CModbusRegisterImage image;
+    const TForteUInt16 values[] = { 1, 2, 3, 0, 5 };
+    // crosses a block border
+    image.write(CModbusRegisterImage::e_HoldingRegisters, CModbusRegisterImage::scm_nBlockSize - 2, 5, values);
+    image.write(CModbusRegisterImage::e_Coils, 10, 5, values);
+
+    TForteUInt16 registers[5];
+    image.readRegisters(CModbusRegisterImage::e_HoldingRegisters, CModbusRegisterImage::scm_nBlockSize - 2, 5, registers);
+    BOOST_CHECK_EQUAL(0, memcmp(values, registers, sizeof(values)));
+    image.readRegisters(CModbusRegisterImage::e_InputRegisters, CModbusRegisterImage::scm_nBlockSize - 2, 5, registers);
+    BOOST_CHECK_EQUAL(0, registers[0]);
+
+    TForteUInt8 bits[5];
+    image.readBits(CModbusRegisterImage::e_Coils, 10, 5, bits);
+    BOOST_CHECK_EQUAL(1, bits[0]);
+    BOOST_CHECK_EQUAL(1, bits[2]);
+    BOOST_CHECK_EQUAL(0, bits[3]);
+    BOOST_CHECK_EQUAL(1, bits[4]);
+
+    BOOST_CHECK(CModbusRegisterImage::isValidRange(65535, 1));
+    BOOST_CHECK(!CModbusRegisterImage::isValidRange(65535, 2));
+  }
+
+  BOOST_AUTO_TEST_CASE(processRequests) {
+    CModbusTcpServerConnection server("127.0.0.1", scmServerPort);
+    const TForteUInt16 values[] = { 0x1234, 0xABCD };
+    server.getRegisterImage().write(CModbusRegisterImage::e_InputRegisters, 100, 2, values);
+
+    TForteUInt8 request[CModbusTcpServerConnection::scm_nMaxAduSize];
+    TForteUInt8 response[CModbusTcpServerConnection::scm_nMaxAduSize];
+
+    buildRequest(request, 0x4711, 4, 100, 2);
+    BOOST_REQUIRE_EQUAL(13U, server.processRequest(request, response));
+    BOOST_CHECK_EQUAL(0x47, response[0]);
+    BOOST_CHECK_EQUAL(0x11, response[1]);
+    BOOST_CHECK_EQUAL(7, response[5]);
+    BOOST_CHECK_EQUAL(4, response[7]);
+    BOOST_CHECK_EQUAL(4, response[8]);
+    BOOST_CHECK_EQUAL(0x1234, getRegister(response, 0));
+    BOOST_CHECK_EQUAL(0xABCD, getRegister(response, 1));
+
+    buildRequest(request, 1, 6, 7, 42);
+    BOOST_REQUIRE_EQUAL(12U, server.processRequest(request, response));
+    BOOST_CHECK_EQUAL(0, memcmp(request, response, 12));
+    TForteUInt16 value = 0;
+    server.getRegisterImage().readRegisters(CModbusRegisterImage::e_HoldingRegisters, 7, 1, &value);
+    BOOST_CHECK_EQUAL(42, value);
+
+    buildRequest(request, 2, 5, 3, 0xFF00);
+    BOOST_REQUIRE_EQUAL(12U, server.processRequest(request, response));
+    buildRequest(request, 3, 1, 0, 10);
+    BOOST_REQUIRE_EQUAL(11U, server.processRequest(request, response));
+    BOOST_CHECK_EQUAL(2, response[8]);
+    BOOST_CHECK_EQUAL(0x08, response[9]);
+    BOOST_CHECK_EQUAL(0x00, response[10]);
+
+    const TForteUInt8 writeRegisters[] = { 0, 4, 0, 0, 0, 11, 1, 16, 0, 20, 0, 2, 4, 0x00, 0x01, 0x00, 0x02 };
+    BOOST_REQUIRE_EQUAL(12U, server.processRequest(writeRegisters, response));
+    BOOST_CHECK_EQUAL(16, response[7]);
+    BOOST_CHECK_EQUAL(2, response[11]);
+    TForteUInt16 written[2];
+    server.getRegisterImage().readRegisters(CModbusRegisterImage::e_HoldingRegisters, 20, 2, written);
+    BOOST_CHECK_EQUAL(1, written[0]);
+    BOOST_CHECK_EQUAL(2, written[1]);
+  }
+
+  BOOST_AUTO_TEST_CASE(exceptionResponses) {
+    CModbusTcpServerConnection server("127.0.0.1", scmServerPort);
+    TForteUInt8 request[CModbusTcpServerConnection::scm_nMaxAduSize];
+    TForteUInt8 response[CModbusTcpServerConnection::scm_nMaxAduSize];
+
+    buildRequest(request, 1, 43, 0, 0);
+    BOOST_REQUIRE_EQUAL(9U, server.processRequest(request, response));
+    BOOST_CHECK_EQUAL(3, response[5]);
+    BOOST_CHECK_EQUAL(43 | 0x80, response[7]);
+    BOOST_CHECK_EQUAL(1, response[8]);
+
+    buildRequest(request, 1, 3, 65530, 10);
+    BOOST_REQUIRE_EQUAL(9U, server.processRequest(request, response));
+    BOOST_CHECK_EQUAL(3 | 0x80, response[7]);
+    BOOST_CHECK_EQUAL(2, response[8]);
+
+    buildRequest(request, 1, 3, 0, 126);
+    BOOST_REQUIRE_EQUAL(9U, server.processRequest(request, response));
+    BOOST_CHECK_EQUAL(3, response[8]);
+
+    buildRequest(request, 1, 5, 0, 0x1234);
+    BOOST_REQUIRE_EQUAL(9U, server.processRequest(request, response));
+    BOOST_CHECK_EQUAL(5 | 0x80, response[7]);
+    BOOST_CHECK_EQUAL(3, response[8]);
+  }
+
+  BOOST_AUTO_TEST_CASE(pipelinedRequestsOnOneConnection) {
+    CModbusTcpServerConnection server("127.0.0.1", scmServerPort);
+    const TForteUInt16 values[] = { 11, 22 };
+    server.getRegisterImage().write(CModbusRegisterImage::e_HoldingRegisters, 0, 2, values);
+    BOOST_REQUIRE_EQUAL(0, server.listen());
+
+    int clientSocket = connectToServer();
+    BOOST_REQUIRE(-1 != clientSocket);
+    TForteUInt8 requests[24];
+    buildRequest(requests, 1, 3, 0, 1);
+    buildRequest(&requests[12], 2, 3, 1, 1);
+    BOOST_REQUIRE_EQUAL(24, send(clientSocket, requests, sizeof(requests), 0));
+
+    TForteUInt8 responses[22];
+    BOOST_REQUIRE(receiveAll(clientSocket, responses, sizeof(responses)));
+    BOOST_CHECK_EQUAL(1, responses[1]);
+    BOOST_CHECK_EQUAL(11, getRegister(responses, 0));
+    BOOST_CHECK_EQUAL(2, responses[12]);
+    BOOST_CHECK_EQUAL(22, getRegister(&responses[11], 0));
+    close(clientSocket);
+  }
+
+  BOOST_AUTO_TEST_CASE(loadWithConcurrentMastersAndWriter) {
+    CModbusTcpServerConnection server("127.0.0.1", scmServerPort);
+    BOOST_REQUIRE_EQUAL(0, server.listen());
+
+    // the writer always sets the whole block to the same value, so a master must never see different values
+    CLoadTestWriter writer(server.getRegisterImage());
+    writer.start();
+
+    const unsigned int nrOfClients = 8;
+    CLoadTestClient clients[nrOfClients];
+    for(unsigned int i = 0; i < nrOfClients; i++) {
+      clients[i].start();
+    }
+    for(unsigned int i = 0; i < nrOfClients; i++) {
+      clients[i].join();
+    }
+    writer.end();
+
+    for(unsigned int i = 0; i < nrOfClients; i++) {
+      BOOST_CHECK_EQUAL(scmNrOfRequestsPerClient, clients[i].mNrOfResponses);
+      BOOST_CHECK_EQUAL(0U, clients[i].mNrOfInconsistentResponses);
+    }
+  }
+
+  BOOST_AUTO_TEST_SUITE_END()
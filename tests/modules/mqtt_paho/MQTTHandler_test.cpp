@@ -0,0 +1,220 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include <boost/test/unit_test.hpp>
+
+#include "../../../src/com/mqtt_paho/MQTTComLayer.h"
+#include "../../../src/com/mqtt_paho/MQTTHandler.h"
+#include "../../../src/core/cominfra/commfb.h"
+#include "../../core/fbtests/fbtesterglobalfixture.h"
+#include <forte_architecture_time.h>
+#include <forte_atomic.h>
+#include <forte_thread.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#ifdef FORTE_ENABLE_GENERATED_SOURCE_CPP
+#include "MQTTHandler_test_gen.cpp"
+#endif
+
+using namespace forte::com_infra;
+
+namespace {
+  const unsigned int scmNrOfSubscribers = 2000;
+  const unsigned int scmNrOfRounds = 5;
+  //messages on their way to the subscribers, below the size of the external event list of the event chain execution
+  const unsigned int scmWindowSize = 8;
+
+  const CStringDictionary::TStringId scmDataTypes[] = { g_nStringIdBOOL,
+#ifdef FORTE_USE_WSTRING_DATATYPE
+    g_nStringIdWSTRING
+#else
+    g_nStringIdSTRING
+#endif
+  };
+
+  /** Subscriber with only QI/ID and QO/STATUS */
+  class CMQTTTestCommFB : public CCommFB{
+    public:
+      CMQTTTestCommFB() :
+          CCommFB(CStringDictionary::scm_nInvalidStringId, CFBTestDataGlobalFixture::getResource(), e_Subscriber),
+          mMockFBInterface(){
+        memset(&mMockFBInterface, 0, sizeof(mMockFBInterface));
+        mMockFBInterface.m_nNumDIs = 2;
+        mMockFBInterface.m_aunDIDataTypeNames = scmDataTypes;
+        mMockFBInterface.m_nNumDOs = 2;
+        mMockFBInterface.m_aunDODataTypeNames = scmDataTypes;
+
+        mFBConnData = new TForteByte[genFBConnDataSize(0, 2, 2)];
+        mFBVarsData = new TForteByte[genFBVarsDataSize(2, 2)];
+        setupFBInterface(&mMockFBInterface, mFBConnData, mFBVarsData);
+        //new FBs are killed, only running FBs get external events
+        changeFBExecutionState(cg_nMGM_CMD_Reset);
+        changeFBExecutionState(cg_nMGM_CMD_Start);
+      }
+
+      virtual ~CMQTTTestCommFB(){
+        changeFBExecutionState(cg_nMGM_CMD_Stop);
+        freeAllData();
+        delete[] mFBConnData;
+        delete[] mFBVarsData;
+        m_pstInterfaceSpec = 0;
+      }
+
+    private:
+      SFBInterfaceSpec mMockFBInterface;
+      TForteByte *mFBConnData;
+      TForteByte *mFBVarsData;
+  };
+
+  /** Top layer counting the messages it receives, the received values have to increase */
+  class CMessageCounter : public CComLayer{
+    public:
+      CMessageCounter(CMQTTTestCommFB *paFB, forte::arch::CAtomicUInt32 &paTotal) :
+          CComLayer(0, paFB), mTotal(paTotal), mNrOfMessages(0), mLastValue(0), mInOrder(true){
+      }
+
+      EComResponse sendData(void *, unsigned int){
+        return e_ProcessDataSendFailed;
+      }
+
+      EComResponse recvData(const void *paData, unsigned int paSize){
+        TForteUInt32 value = 0;
+        if(sizeof(value) == paSize){
+          memcpy(&value, paData, sizeof(value));
+        }
+        if(0 != mNrOfMessages.load() && value <= mLastValue){
+          mInOrder = false;
+        }
+        mLastValue = value;
+        mNrOfMessages.fetchAdd(1);
+        mTotal.fetchAdd(1);
+        return e_ProcessDataOk;
+      }
+
+      TForteUInt32 getNrOfMessages() const {
+        return mNrOfMessages.load();
+      }
+
+      bool isInOrder() const {
+        return mInOrder;
+      }
+
+    private:
+      EComResponse openConnection(char *){
+        return e_InitOk;
+      }
+
+      void closeConnection(){
+      }
+
+      forte::arch::CAtomicUInt32 &mTotal;
+      forte::arch::CAtomicUInt32 mNrOfMessages;
+      TForteUInt32 mLastValue;
+      bool mInOrder;
+  };
+
+  /** Subscriber comm FB with its MQTT layer, the counter closes and deletes the layer */
+  struct SSubscriber {
+      explicit SSubscriber(forte::arch::CAtomicUInt32 &paTotal) :
+          mFB(), mCounter(&mFB, paTotal), mLayer(new MQTTComLayer(&mCounter, &mFB)){
+      }
+
+      CMQTTTestCommFB mFB;
+      CMessageCounter mCounter;
+      MQTTComLayer *mLayer;
+  };
+
+  void getTopic(char *paTopic, size_t paSize, unsigned int paSubscriber){
+    snprintf(paTopic, paSize, "forte/test/%u/value", paSubscriber);
+  }
+
+  //! Waits without sleeping, as sleeping would dominate the measured time
+  bool waitForMessages(const forte::arch::CAtomicUInt32 &paTotal, TForteUInt32 paNrOfMessages, uint_fast64_t paDeadline){
+    while(paTotal.load() < paNrOfMessages){
+      if(getNanoSecondsMonotonic() > paDeadline){
+        return false;
+      }
+      CThread::sleepThread(0);
+    }
+    return true;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(MQTTHandler_test)
+
+  BOOST_AUTO_TEST_CASE(throughputWithManySubscriptions){
+    forte::arch::CAtomicUInt32 total(0);
+    std::vector<SSubscriber*> subscribers;
+    char parameters[80];
+    for(unsigned int i = 0; i < scmNrOfSubscribers; ++i){
+      SSubscriber *subscriber = new SSubscriber(total);
+      subscribers.push_back(subscriber);
+      int size = snprintf(parameters, sizeof(parameters), "tcp://localhost:1883,forteSubscriber,");
+      getTopic(&parameters[size], sizeof(parameters) - static_cast<size_t>(size), i);
+      BOOST_REQUIRE_EQUAL(e_InitOk, static_cast<CComLayer*>(subscriber->mLayer)->openConnection(parameters));
+    }
+
+    //the handler subscribes one topic after the other
+    uint_fast64_t deadline = getNanoSecondsMonotonic() + 30000000000ULL;
+    while(scmNrOfSubscribers > MQTTAsyncStub_getNrOfSubscriptions() && getNanoSecondsMonotonic() < deadline){
+      CThread::sleepThread(1);
+    }
+    BOOST_REQUIRE_EQUAL(scmNrOfSubscribers, MQTTAsyncStub_getNrOfSubscriptions());
+    BOOST_REQUIRE_EQUAL(MQTTASYNC_SUCCESS, MQTTAsyncStub_waitUntilIdle(10000));
+
+    MQTTAsync publisher = 0;
+    BOOST_REQUIRE_EQUAL(MQTTASYNC_SUCCESS, MQTTAsync_create(&publisher, "tcp://localhost:1883", "fortePublisher", MQTTCLIENT_PERSISTENCE_NONE, 0));
+    MQTTAsync_connectOptions connectOptions = MQTTAsync_connectOptions_initializer;
+    BOOST_REQUIRE_EQUAL(MQTTASYNC_SUCCESS, MQTTAsync_connect(publisher, &connectOptions));
+
+    //nobody subscribed this topic, the handler must not deliver it
+    TForteUInt32 value = 0;
+    MQTTAsync_message message = MQTTAsync_message_initializer;
+    message.payload = &value;
+    message.payloadlen = sizeof(value);
+    BOOST_CHECK_EQUAL(MQTTASYNC_SUCCESS, MQTTAsync_sendMessage(publisher, "forte/test/value", &message, 0));
+
+    const TForteUInt32 nrOfMessages = scmNrOfSubscribers * scmNrOfRounds;
+    char topic[40];
+    deadline = getNanoSecondsMonotonic() + 60000000000ULL;
+    uint_fast64_t start = getNanoSecondsMonotonic();
+    for(value = 0; value < nrOfMessages; ++value){
+      if(value >= scmWindowSize && !waitForMessages(total, value - scmWindowSize + 1, deadline)){
+        break;
+      }
+      getTopic(topic, sizeof(topic), value % scmNrOfSubscribers);
+      BOOST_REQUIRE_EQUAL(MQTTASYNC_SUCCESS, MQTTAsync_sendMessage(publisher, topic, &message, 0));
+    }
+    BOOST_CHECK(waitForMessages(total, nrOfMessages, deadline));
+    uint_fast64_t duration = getNanoSecondsMonotonic() - start;
+    BOOST_TEST_MESSAGE(total.load() << " MQTT messages for " << scmNrOfSubscribers << " subscriptions in " << duration / 1000000 << " ms, "
+      << ((0 != duration) ? static_cast<unsigned long long>(total.load()) * 1000000000ULL / duration : 0) << " messages/s");
+
+    BOOST_REQUIRE_EQUAL(MQTTASYNC_SUCCESS, MQTTAsyncStub_waitUntilIdle(10000));
+    //let the event chains of the last messages end
+    CThread::sleepThread(50);
+    BOOST_CHECK_EQUAL(nrOfMessages, total.load());
+    for(unsigned int i = 0; i < scmNrOfSubscribers; ++i){
+      BOOST_CHECK_EQUAL(scmNrOfRounds, subscribers[i]->mCounter.getNrOfMessages());
+      BOOST_CHECK(subscribers[i]->mCounter.isInOrder());
+    }
+
+    MQTTAsync_destroy(&publisher);
+    for(unsigned int i = 0; i < scmNrOfSubscribers; ++i){
+      delete subscribers[i];
+    }
+    //the broker connection is deleted with its last layer
+    BOOST_CHECK_EQUAL(0U, MQTTAsyncStub_getNrOfSubscriptions());
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
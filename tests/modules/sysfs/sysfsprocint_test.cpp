@@ -0,0 +1,202 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include <boost/test/unit_test.hpp>
+#include "../../../src/modules/sysfs/sysfsprocint.h"
+#include "../../../src/core/typelib.h"
+#include "../../core/fbtests/fbtesterglobalfixture.h"
+#include <forte_bool.h>
+#include <forte_string.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#ifdef FORTE_ENABLE_GENERATED_SOURCE_CPP
+#include "sysfsprocint_test_gen.cpp"
+#else
+#include "stringlist.h"
+#endif
+
+namespace {
+
+  //! Fake sysfs gpio tree in a temporary directory, the process interface is redirected to it while the fixture lives
+  class CFakeSysFs {
+    public:
+      CFakeSysFs() {
+        char pathTemplate[] = "/tmp/forte_sysfsXXXXXX";
+        BOOST_REQUIRE(0 != mkdtemp(pathTemplate));
+        mRoot = std::string(pathTemplate) + "/";
+        addFile("export", "");
+        addFile("unexport", "");
+        CSysFsProcessInterface::setGPIOPath(mRoot.c_str());
+      }
+
+      ~CFakeSysFs() {
+        CSysFsProcessInterface::setGPIOPath("/sys/class/gpio/");
+        for(std::vector<std::string>::reverse_iterator it = mEntries.rbegin(); it != mEntries.rend(); ++it) {
+          remove(it->c_str());
+        }
+        rmdir(mRoot.c_str());
+      }
+
+      //! Adds a pin, pins without interrupt support get an edge entry which can not be written
+      void addPin(const std::string &paPin, bool paSupportsInterrupts, const char *paValue) {
+        std::string dir = mRoot + "gpio" + paPin;
+        BOOST_REQUIRE_EQUAL(0, mkdir(dir.c_str(), 0755));
+        mEntries.push_back(dir);
+        addFile("gpio" + paPin + "/direction", "");
+        addFile("gpio" + paPin + "/value", paValue);
+        if(paSupportsInterrupts) {
+          addFile("gpio" + paPin + "/edge", "none");
+        } else {
+          std::string edge = dir + "/edge";
+          BOOST_REQUIRE_EQUAL(0, mkdir(edge.c_str(), 0755));
+          mEntries.push_back(edge);
+        }
+      }
+
+      void setValue(const std::string &paPin, const char *paValue) {
+        std::ofstream file((mRoot + "gpio" + paPin + "/value").c_str());
+        file << paValue;
+      }
+
+      std::string read(const std::string &paFile) {
+        std::ifstream file((mRoot + paFile).c_str());
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+      }
+
+    private:
+      void addFile(const std::string &paFile, const char *paContent) {
+        std::string path = mRoot + paFile;
+        std::ofstream file(path.c_str());
+        file << paContent;
+        mEntries.push_back(path);
+      }
+
+      std::string mRoot;
+      std::vector<std::string> mEntries;
+  };
+
+  CFunctionBlock *createPin(CStringDictionary::TStringId paType, const char *paPin) {
+    CFunctionBlock *fb = CTypeLib::createFB(g_nStringIdInstanceName, paType, CFBTestDataGlobalFixture::getResource());
+    BOOST_REQUIRE(0 != fb);
+    fb->changeFBExecutionState(cg_nMGM_CMD_Start);
+    *static_cast<CIEC_STRING*>(fb->getDataInput(g_nStringIdPARAMS)) = paPin;
+    return fb;
+  }
+
+  bool initPin(CFunctionBlock *paFB, bool paQI) {
+    *static_cast<CIEC_BOOL*>(paFB->getDataInput(g_nStringIdQI)) = paQI;
+    paFB->receiveInputEvent(0, 0); //INIT
+    return *static_cast<CIEC_BOOL*>(paFB->getDataOutput(g_nStringIdQO));
+  }
+
+  bool getIn(CFunctionBlock *paFB) {
+    return *static_cast<CIEC_BOOL*>(paFB->getDataOutput(g_nStringIdIN));
+  }
+
+  unsigned long getTimeMs() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<unsigned long>(now.tv_sec) * 1000 + static_cast<unsigned long>(now.tv_nsec / 1000000);
+  }
+}
+
+BOOST_FIXTURE_TEST_SUITE(SysFsProcessInterface_Test, CFakeSysFs)
+
+  BOOST_AUTO_TEST_CASE(inputSetsUpInterruptAndReadsInitialValue) {
+    addPin("5", true, "1\n");
+    CFunctionBlock *ix = createPin(g_nStringIdIX, "5");
+
+    BOOST_CHECK(initPin(ix, true));
+    BOOST_CHECK_EQUAL("5", read("export"));
+    BOOST_CHECK_EQUAL("in", read("gpio5/direction"));
+    BOOST_CHECK_EQUAL("both", read("gpio5/edge"));
+    BOOST_CHECK(getIn(ix));
+
+    initPin(ix, false);
+    BOOST_CHECK_EQUAL("5", read("unexport"));
+    BOOST_CHECK(CTypeLib::deleteFB(ix));
+  }
+
+  BOOST_AUTO_TEST_CASE(outputIsWrittenToValueFile) {
+    addPin("6", true, "0");
+    CFunctionBlock *qx = createPin(g_nStringIdQX, "6");
+
+    BOOST_CHECK(initPin(qx, true));
+    BOOST_CHECK_EQUAL("out", read("gpio6/direction"));
+    BOOST_CHECK_EQUAL("none", read("gpio6/edge"));
+
+    *static_cast<CIEC_BOOL*>(qx->getDataInput(g_nStringIdOUT)) = true;
+    qx->receiveInputEvent(1, 0); //REQ
+    BOOST_CHECK_EQUAL("1", read("gpio6/value"));
+
+    initPin(qx, false);
+    BOOST_CHECK(CTypeLib::deleteFB(qx));
+  }
+
+  BOOST_AUTO_TEST_CASE(pinWithoutInterruptIsPolled) {
+    addPin("7", false, "0");
+    CFunctionBlock *ix = createPin(g_nStringIdIX, "7");
+
+    BOOST_CHECK(initPin(ix, true));
+    BOOST_CHECK(!getIn(ix));
+
+    setValue("7", "1");
+    unsigned long start = getTimeMs();
+    while(!getIn(ix) && getTimeMs() - start < 1000) {
+      usleep(1000);
+    }
+    BOOST_CHECK(getIn(ix));
+
+    initPin(ix, false);
+    usleep(50000); //let the resource process the IND before the FB is gone
+    BOOST_CHECK(CTypeLib::deleteFB(ix));
+  }
+
+  BOOST_AUTO_TEST_CASE(missingPinFailsInitialisation) {
+    CFunctionBlock *ix = createPin(g_nStringIdIX, "8");
+    BOOST_CHECK(!initPin(ix, true));
+    BOOST_CHECK(CTypeLib::deleteFB(ix));
+  }
+
+  BOOST_AUTO_TEST_CASE(pinsInitialiseWithoutFixedDelays) {
+    const unsigned int nrOfPins = 64;
+    std::vector<CFunctionBlock*> pins;
+    for(unsigned int i = 0; i < nrOfPins; ++i) {
+      std::stringstream pin;
+      pin << (100 + i);
+      addPin(pin.str(), true, "0");
+      pins.push_back(createPin(g_nStringIdIX, pin.str().c_str()));
+    }
+
+    unsigned long start = getTimeMs();
+    for(unsigned int i = 0; i < nrOfPins; ++i) {
+      BOOST_CHECK(initPin(pins[i], true));
+    }
+    //with the former fixed delays this took 500 ms per pin
+    BOOST_CHECK_LT(getTimeMs() - start, 1000UL);
+
+    for(unsigned int i = 0; i < nrOfPins; ++i) {
+      initPin(pins[i], false);
+      BOOST_CHECK(CTypeLib::deleteFB(pins[i]));
+    }
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,57 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include "../../core/fbtests/fbtestfixture.h"
+#include <forte_udint.h>
+#include <forte_time.h>
+#include <asyncworker.h>
+#include <extevhandlerhelper.h>
+
+#ifdef FORTE_ENABLE_GENERATED_SOURCE_CPP
+#include "ASYNC_WORKER_STATS_tester_gen.cpp"
+#endif
+
+struct ASYNC_WORKER_STATS_TestFixture : public CFBTestFixtureBase{
+
+    ASYNC_WORKER_STATS_TestFixture() :
+        CFBTestFixtureBase(g_nStringIdASYNC_WORKER_STATS){
+      SETUP_OUTPUTDATA(&mSubmitted, &mRejected, &mCompleted, &mAvgQueueTime, &mMaxQueueTime, &mAvgRunTime, &mMaxRunTime);
+      CFBTestFixtureBase::setup();
+    }
+
+    CIEC_UDINT mSubmitted;
+    CIEC_UDINT mRejected;
+    CIEC_UDINT mCompleted;
+    CIEC_TIME mAvgQueueTime;
+    CIEC_TIME mMaxQueueTime;
+    CIEC_TIME mAvgRunTime;
+    CIEC_TIME mMaxRunTime;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ASYNC_WORKER_STATS_Tests, ASYNC_WORKER_STATS_TestFixture)
+
+  BOOST_AUTO_TEST_CASE(outputsAreTheHandlersStatistics){
+    CAsyncWorkerHandler::SStatistics statistics;
+    getExtEvHandler<CAsyncWorkerHandler>(*this).getStatistics(statistics);
+
+    triggerEvent(0);
+    BOOST_CHECK(checkForSingleOutputEventOccurence(0));
+    //the jobs of other tests may still complete in between
+    BOOST_CHECK(static_cast<TForteUInt32>(mSubmitted) >= statistics.mSubmitted);
+    BOOST_CHECK(static_cast<TForteUInt32>(mRejected) >= statistics.mRejected);
+    BOOST_CHECK(static_cast<TForteUInt32>(mCompleted) >= statistics.mCompleted);
+    BOOST_CHECK(static_cast<TForteUInt32>(mCompleted) <= static_cast<TForteUInt32>(mSubmitted));
+    BOOST_CHECK(mAvgQueueTime.getInNanoSeconds() <= mMaxQueueTime.getInNanoSeconds());
+    BOOST_CHECK(mAvgRunTime.getInNanoSeconds() <= mMaxRunTime.getInNanoSeconds());
+    BOOST_CHECK(static_cast<CIEC_TIME::TValueType>(statistics.mMaxRunTime) <= mMaxRunTime.getInNanoSeconds());
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
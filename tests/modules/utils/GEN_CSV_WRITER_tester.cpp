@@ -0,0 +1,154 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include "../../core/fbtests/fbtestfixture.h"
+#include <forte_bool.h>
+#include <forte_dint.h>
+#include <forte_string.h>
+#include <forte_thread.h>
+#include <stdio.h>
+#include <string>
+
+#ifdef FORTE_ENABLE_GENERATED_SOURCE_CPP
+#include "GEN_CSV_WRITER_tester_gen.cpp"
+#endif
+
+namespace {
+  const char * const scmTestFileName = "GEN_CSV_WRITER_tester.csv";
+}
+
+struct GEN_CSV_WRITER_TestFixture : public CFBTestFixtureBase{
+
+    GEN_CSV_WRITER_TestFixture() :
+        CFBTestFixtureBase(g_nStringIdCSV_WRITER_1){
+      SETUP_INPUTDATA(&mQI, &mFileName, &mSD1);
+      SETUP_OUTPUTDATA(&mQO, &mStatus);
+      CFBTestFixtureBase::setup();
+      mFileName = scmTestFileName;
+    }
+
+    ~GEN_CSV_WRITER_TestFixture(){
+      remove(scmTestFileName);
+    }
+
+    //! The file operations are done by the workers, so the output event comes after triggerEvent returned
+    bool waitForSingleOutputEvent(int paExpectedEOId){
+      for(unsigned int i = 0; (i < 2000) && eventChainEmpty(); ++i){
+        CThread::sleepThread(1);
+      }
+      return checkForSingleOutputEventOccurence(paExpectedEOId);
+    }
+
+    static std::string readTestFile(){
+      std::string content;
+      FILE *file = fopen(scmTestFileName, "r");
+      if(0 != file){
+        char buffer[64];
+        size_t size;
+        while(0 != (size = fread(buffer, 1, sizeof(buffer), file))){
+          content.append(buffer, size);
+        }
+        fclose(file);
+      }
+      return content;
+    }
+
+    CIEC_BOOL mQI;
+    CIEC_STRING mFileName;
+    CIEC_DINT mSD1;
+
+    CIEC_BOOL mQO;
+    CIEC_STRING mStatus;
+};
+
+BOOST_FIXTURE_TEST_SUITE(GEN_CSV_WRITER_Tests, GEN_CSV_WRITER_TestFixture)
+
+  BOOST_AUTO_TEST_CASE(writeLines){
+    mQI = true;
+    triggerEvent(0);
+    BOOST_CHECK(waitForSingleOutputEvent(0));
+    BOOST_CHECK(mQO);
+    BOOST_CHECK_EQUAL(std::string("OK"), mStatus.getValue());
+
+    mSD1 = 5;
+    triggerEvent(1);
+    BOOST_CHECK(waitForSingleOutputEvent(1));
+    BOOST_CHECK(mQO);
+    mSD1 = -7;
+    triggerEvent(1);
+    BOOST_CHECK(waitForSingleOutputEvent(1));
+    BOOST_CHECK(mQO);
+
+    mQI = false;
+    triggerEvent(0);
+    BOOST_CHECK(waitForSingleOutputEvent(0));
+    BOOST_CHECK(!mQO);
+    BOOST_CHECK_EQUAL(std::string("OK"), mStatus.getValue());
+
+    BOOST_CHECK_EQUAL(std::string("5; \n-7; \n"), readTestFile());
+  }
+
+  BOOST_AUTO_TEST_CASE(requestsDuringAWriteArePending){
+    const unsigned int nrOfLines = 40;
+    mQI = true;
+    triggerEvent(0);
+    BOOST_CHECK(waitForSingleOutputEvent(0));
+    BOOST_REQUIRE(mQO);
+
+    std::string expected;
+    for(unsigned int i = 0; i < nrOfLines; ++i){
+      mSD1 = static_cast<TForteInt32>(i);
+      triggerEvent(1);
+      expected += std::to_string(i) + "; \n";
+    }
+    unsigned int nrOfConfirmations = 0;
+    for(unsigned int i = 0; (i < 2000) && (nrOfConfirmations < nrOfLines); ++i){
+      while(!eventChainEmpty()){
+        BOOST_CHECK_EQUAL(1, pullFirstChainEventID());
+        ++nrOfConfirmations;
+      }
+      CThread::sleepThread(1);
+    }
+    BOOST_CHECK_EQUAL(nrOfLines, nrOfConfirmations);
+    BOOST_CHECK(mQO);
+
+    //the last pending lines may still be written, closing is rejected until then
+    mQI = false;
+    for(unsigned int i = 0; i < 100; ++i){
+      triggerEvent(0);
+      BOOST_CHECK(waitForSingleOutputEvent(0));
+      if(std::string("Previous file operation still running") != mStatus.getValue()){
+        break;
+      }
+      CThread::sleepThread(1);
+    }
+    BOOST_CHECK_EQUAL(std::string("OK"), mStatus.getValue());
+    BOOST_CHECK_EQUAL(expected, readTestFile());
+  }
+
+  BOOST_AUTO_TEST_CASE(writeWithoutOpenFile){
+    mQI = true;
+    triggerEvent(1);
+    BOOST_CHECK(checkForSingleOutputEventOccurence(1));
+    BOOST_CHECK(!mQO);
+    BOOST_CHECK_EQUAL(std::string("File not opened"), mStatus.getValue());
+  }
+
+  BOOST_AUTO_TEST_CASE(openFailure){
+    mQI = true;
+    mFileName = "GEN_CSV_WRITER_tester_missing_dir/test.csv";
+    triggerEvent(0);
+    BOOST_CHECK(waitForSingleOutputEvent(0));
+    BOOST_CHECK(!mQO);
+    BOOST_CHECK(std::string("OK") != mStatus.getValue());
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
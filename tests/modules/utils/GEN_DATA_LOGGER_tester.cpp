@@ -0,0 +1,254 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include "../../core/fbtests/fbtestfixture.h"
+#include <forte_bool.h>
+#include <forte_dint.h>
+#include <forte_string.h>
+#include <forte_udint.h>
+#include <forte_usint.h>
+#include <forte_time.h>
+#include <forte_thread.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+#ifdef FORTE_ENABLE_GENERATED_SOURCE_CPP
+#include "GEN_DATA_LOGGER_tester_gen.cpp"
+#endif
+
+namespace {
+  const char * const scmTestFileName = "GEN_DATA_LOGGER_tester.log";
+
+  std::string readFile(const std::string &paFileName){
+    std::string content;
+    FILE *file = fopen(paFileName.c_str(), "rb");
+    if(0 != file){
+      char buffer[64];
+      size_t size;
+      while(0 != (size = fread(buffer, 1, sizeof(buffer), file))){
+        content.append(buffer, size);
+      }
+      fclose(file);
+    }
+    return content;
+  }
+
+  //! Removes the time stamps at the beginning of the lines
+  std::string stripTimeStamps(const std::string &paContent){
+    std::string result;
+    size_t lineStart = paContent.find('\n') + 1;
+    while(lineStart < paContent.size()){
+      size_t lineEnd = paContent.find('\n', lineStart);
+      size_t valueStart = paContent.find("; ", lineStart);
+      result.append(paContent, valueStart + 2, lineEnd + 1 - valueStart - 2);
+      lineStart = lineEnd + 1;
+    }
+    return result;
+  }
+
+  template<typename T>
+  T readValue(const std::string &paContent, size_t &paPos){
+    T value;
+    memcpy(&value, paContent.data() + paPos, sizeof(T));
+    paPos += sizeof(T);
+    return value;
+  }
+}
+
+struct GEN_DATA_LOGGER_TestFixture : public CFBTestFixtureBase{
+
+    GEN_DATA_LOGGER_TestFixture() :
+        CFBTestFixtureBase(g_nStringIdDATA_LOGGER_2){
+      SETUP_INPUTDATA(&mQI, &mFileName, &mFormat, &mSamples, &mRotateSize, &mRotateTime, &mSync, &mSD1, &mSD2);
+      SETUP_OUTPUTDATA(&mQO, &mStatus, &mDropped);
+      CFBTestFixtureBase::setup();
+      mFileName = scmTestFileName;
+    }
+
+    ~GEN_DATA_LOGGER_TestFixture(){
+      remove(scmTestFileName);
+      for(unsigned int i = 1; i < 4; ++i){
+        remove(getRotatedFileName(i).c_str());
+      }
+    }
+
+    static std::string getRotatedFileName(unsigned int paIndex){
+      return std::string(scmTestFileName) + "." + static_cast<char>('0' + paIndex);
+    }
+
+    //! The file operations are done by the workers, so INITO comes after triggerEvent returned
+    bool waitForInitO(){
+      for(unsigned int i = 0; (i < 2000) && eventChainEmpty(); ++i){
+        CThread::sleepThread(1);
+      }
+      return checkForSingleOutputEventOccurence(0);
+    }
+
+    void open(){
+      mQI = true;
+      triggerEvent(0);
+      BOOST_REQUIRE(waitForInitO());
+      BOOST_REQUIRE(mQO);
+    }
+
+    void close(){
+      mQI = false;
+      triggerEvent(0);
+      BOOST_CHECK(waitForInitO());
+      BOOST_CHECK(!mQO);
+      BOOST_CHECK_EQUAL(std::string("OK"), mStatus.getValue());
+    }
+
+    void log(TForteInt32 paSD1, bool paSD2){
+      mSD1 = paSD1;
+      mSD2 = paSD2;
+      triggerEvent(1);
+      BOOST_CHECK(checkForSingleOutputEventOccurence(1));
+      BOOST_CHECK(mQO);
+    }
+
+    CIEC_BOOL mQI;
+    CIEC_STRING mFileName;
+    CIEC_STRING mFormat;
+    CIEC_UDINT mSamples;
+    CIEC_UDINT mRotateSize;
+    CIEC_TIME mRotateTime;
+    CIEC_USINT mSync;
+    CIEC_DINT mSD1;
+    CIEC_BOOL mSD2;
+
+    CIEC_BOOL mQO;
+    CIEC_STRING mStatus;
+    CIEC_UDINT mDropped;
+};
+
+BOOST_FIXTURE_TEST_SUITE(GEN_DATA_LOGGER_Tests, GEN_DATA_LOGGER_TestFixture)
+
+  BOOST_AUTO_TEST_CASE(writeCSV){
+    open();
+    log(5, true);
+    log(-7, false);
+    log(2147483647, true);
+    close();
+    BOOST_CHECK_EQUAL(0U, static_cast<TForteUInt32>(mDropped));
+
+    std::string content = readFile(scmTestFileName);
+    BOOST_CHECK_EQUAL(std::string("TIME; SD_1; SD_2\n"), content.substr(0, content.find('\n') + 1));
+    BOOST_CHECK_EQUAL(std::string("5; TRUE\n-7; FALSE\n2147483647; TRUE\n"), stripTimeStamps(content));
+  }
+
+  BOOST_AUTO_TEST_CASE(writeBinary){
+    mFormat = "BIN";
+    mSync = 2;
+    open();
+    log(5, true);
+    log(-7, false);
+    close();
+
+    std::string content = readFile(scmTestFileName);
+    BOOST_REQUIRE_EQUAL(24U + 2U * 8U + 4U + 2U * (8U + 4U + sizeof(bool)), content.size());
+    BOOST_CHECK_EQUAL(std::string("FORTELOG"), content.substr(0, 8));
+    size_t pos = 8;
+    BOOST_CHECK_EQUAL(0x0102, readValue<TForteUInt16>(content, pos));
+    BOOST_CHECK_EQUAL(1, readValue<TForteUInt16>(content, pos));
+    BOOST_CHECK_EQUAL(2, readValue<TForteUInt16>(content, pos));
+    pos += 2 + 8; //reserved and start time
+
+    BOOST_CHECK_EQUAL(CIEC_ANY::e_DINT, readValue<TForteUInt16>(content, pos));
+    BOOST_CHECK_EQUAL(4, readValue<TForteUInt8>(content, pos));
+    BOOST_CHECK_EQUAL(4, readValue<TForteUInt8>(content, pos));
+    BOOST_CHECK_EQUAL(std::string("SD_1"), content.substr(pos, 4));
+    pos += 4;
+    BOOST_CHECK_EQUAL(CIEC_ANY::e_BOOL, readValue<TForteUInt16>(content, pos));
+    BOOST_CHECK_EQUAL(sizeof(bool), readValue<TForteUInt8>(content, pos));
+    BOOST_CHECK_EQUAL(4, readValue<TForteUInt8>(content, pos));
+    BOOST_CHECK_EQUAL(std::string("SD_2"), content.substr(pos, 4));
+    pos += 4;
+
+    //both samples are in one block with the columns one after the other
+    BOOST_CHECK_EQUAL(2U, readValue<TForteUInt32>(content, pos));
+    TForteUInt64 firstTime = readValue<TForteUInt64>(content, pos);
+    BOOST_CHECK(firstTime <= readValue<TForteUInt64>(content, pos));
+    BOOST_CHECK_EQUAL(5, readValue<TForteInt32>(content, pos));
+    BOOST_CHECK_EQUAL(-7, readValue<TForteInt32>(content, pos));
+    BOOST_CHECK(readValue<bool>(content, pos));
+    BOOST_CHECK(!readValue<bool>(content, pos));
+  }
+
+  BOOST_AUTO_TEST_CASE(samplesAreWrittenOrDropped){
+    mSamples = 2;
+    open();
+    const unsigned int nrOfSamples = 200;
+    for(unsigned int i = 0; i < nrOfSamples; ++i){
+      log(static_cast<TForteInt32>(i), true);
+    }
+    close();
+
+    //a full ring drops the samples while the worker is writing
+    std::string content = readFile(scmTestFileName);
+    size_t nrOfLines = 0;
+    for(size_t pos = content.find('\n'); std::string::npos != pos; pos = content.find('\n', pos + 1)){
+      ++nrOfLines;
+    }
+    BOOST_CHECK_EQUAL(nrOfSamples, nrOfLines - 1 + static_cast<TForteUInt32>(mDropped));
+  }
+
+  BOOST_AUTO_TEST_CASE(rotateBySize){
+    mSamples = 2;
+    mRotateSize = 1;
+    open();
+    log(1, true);
+    //give the worker the time to write the sample before the next one is logged
+    CThread::sleepThread(50);
+    log(2, false);
+    CThread::sleepThread(50);
+    close();
+
+    BOOST_CHECK_EQUAL(std::string("TIME; SD_1; SD_2\n"), readFile(scmTestFileName));
+    BOOST_CHECK_EQUAL(std::string("1; TRUE\n"), stripTimeStamps(readFile(getRotatedFileName(1))));
+    BOOST_CHECK_EQUAL(std::string("2; FALSE\n"), stripTimeStamps(readFile(getRotatedFileName(2))));
+    BOOST_CHECK(readFile(getRotatedFileName(3)).empty());
+  }
+
+  BOOST_AUTO_TEST_CASE(idleLoggerIsFlushedByTheTimer){
+    mSync = 2;
+    open();
+    log(1, true);
+    log(2, false);
+    BOOST_CHECK(stripTimeStamps(readFile(scmTestFileName)).empty());
+
+    //no further REQ arrives, the flush timer writes the samples once they are about one second old
+    const std::string expected("1; TRUE\n2; FALSE\n");
+    std::string content;
+    for(unsigned int i = 0; (i < 300) && (expected != stripTimeStamps(content)); ++i){
+      CThread::sleepThread(10);
+      content = readFile(scmTestFileName);
+    }
+    BOOST_CHECK_EQUAL(expected, stripTimeStamps(content));
+    close();
+  }
+
+  BOOST_AUTO_TEST_CASE(unknownFormat){
+    mQI = true;
+    mFormat = "XML";
+    triggerEvent(0);
+    BOOST_CHECK(checkForSingleOutputEventOccurence(0));
+    BOOST_CHECK(!mQO);
+    BOOST_CHECK_EQUAL(std::string("Unknown format"), mStatus.getValue());
+
+    triggerEvent(1);
+    BOOST_CHECK(checkForSingleOutputEventOccurence(1));
+    BOOST_CHECK(!mQO);
+    BOOST_CHECK_EQUAL(std::string("Logger not opened"), mStatus.getValue());
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,178 @@
+/*******************************************************************************
+ * Copyright (c) 2026 agent
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   agent - initial API and implementation and/or initial documentation
+ *******************************************************************************/
+#include "../../core/fbtests/fbtestfixture.h"
+#include "../../core/fbtests/fbtesterglobalfixture.h"
+#include <forte_bool.h>
+#include <forte_dint.h>
+#include <forte_string.h>
+#include <forte_udint.h>
+#include <forte_uint.h>
+#include <forte_usint.h>
+#include <device.h>
+#include <typelib.h>
+#include <ecet.h>
+#include <forte_thread.h>
+#include <vector>
+#include <string>
+
+#ifdef FORTE_ENABLE_GENERATED_SOURCE_CPP
+#include "HISTORY_tester_gen.cpp"
+#endif
+
+namespace {
+  const SFBInterfaceSpec scmDeviceSpec = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+}
+
+struct HISTORY_TestFixture : public CFBTestFixtureBase{
+
+    HISTORY_TestFixture() :
+        CFBTestFixtureBase(g_nStringIdHISTORY){
+      SETUP_INPUTDATA(&mQI, &mName, &mSamples, &mFactor, &mTiers, &mIn);
+      SETUP_OUTPUTDATA(&mQO, &mStatus);
+      CFBTestFixtureBase::setup();
+      mName = "HistoryTesterSignal";
+    }
+
+    void init(){
+      mQI = true;
+      triggerEvent(0);
+      BOOST_CHECK(checkForSingleOutputEventOccurence(0));
+    }
+
+    void add(TForteInt32 paValue){
+      mIn = paValue;
+      triggerEvent(1);
+      BOOST_CHECK(checkForSingleOutputEventOccurence(1));
+      BOOST_CHECK(mQO);
+    }
+
+    static EMGMResponse queryStore(const char *paParams, forte::core::CMGMResponseBuffer &paResponse){
+      return CFBTestDataGlobalFixture::getResource()->getDevice().getHistoryStore().query(
+          CStringDictionary::getInstance().getId("HistoryTesterSignal"), paParams, paResponse);
+    }
+
+    std::string query(const char *paParams){
+      forte::core::CMGMResponseBuffer response;
+      BOOST_CHECK_EQUAL(e_RDY, queryStore(paParams, response));
+      std::vector<char> text(response.length() + 1);
+      response.copyTo(&text[0]);
+      return std::string(&text[0], response.length());
+    }
+
+    CIEC_BOOL mQI;
+    CIEC_STRING mName;
+    CIEC_UDINT mSamples;
+    CIEC_UINT mFactor;
+    CIEC_USINT mTiers;
+    CIEC_DINT mIn;
+
+    CIEC_BOOL mQO;
+    CIEC_STRING mStatus;
+};
+
+BOOST_FIXTURE_TEST_SUITE(HISTORY_Tests, HISTORY_TestFixture)
+
+  BOOST_AUTO_TEST_CASE(addValues){
+    mSamples = 10;
+    mFactor = 2;
+    mTiers = 1;
+    init();
+    BOOST_REQUIRE(mQO);
+    BOOST_CHECK_EQUAL(std::string("OK"), mStatus.getValue());
+
+    add(5);
+    add(-7);
+    add(3);
+
+    std::string raw(query(""));
+    BOOST_CHECK(std::string::npos != raw.find("\"tier\":0,\"samples\":1,"));
+    BOOST_CHECK(std::string::npos != raw.find(",5],["));
+    BOOST_CHECK(std::string::npos != raw.find(",-7],["));
+    BOOST_CHECK(std::string::npos != raw.find(",3]]}"));
+
+    std::string buckets(query("1"));
+    BOOST_CHECK(std::string::npos != buckets.find("\"tier\":1,\"samples\":2,"));
+    BOOST_CHECK(std::string::npos != buckets.find(",-7,5,-1]]}"));
+
+    mQI = false;
+    triggerEvent(0);
+    BOOST_CHECK(checkForSingleOutputEventOccurence(0));
+    BOOST_CHECK(!mQO);
+    forte::core::CMGMResponseBuffer response;
+    BOOST_CHECK_EQUAL(e_NO_SUCH_OBJECT, queryStore("", response));
+  }
+
+  BOOST_AUTO_TEST_CASE(notInitialized){
+    mQI = true;
+    mIn = 1;
+    triggerEvent(1);
+    BOOST_CHECK(checkForSingleOutputEventOccurence(1));
+    BOOST_CHECK(!mQO);
+    BOOST_CHECK_EQUAL(std::string("History not initialized"), mStatus.getValue());
+  }
+
+  BOOST_AUTO_TEST_CASE(invalidConfiguration){
+    mFactor = 1;
+    mTiers = 2;
+    init();
+    BOOST_CHECK(!mQO);
+    BOOST_CHECK_EQUAL(std::string("Invalid history configuration"), mStatus.getValue());
+  }
+
+  BOOST_AUTO_TEST_CASE(memoryLimit){
+    mSamples = 4000000000U;
+    init();
+    BOOST_CHECK(!mQO);
+    BOOST_CHECK_EQUAL(std::string("History memory limit of the device exceeded"), mStatus.getValue());
+  }
+
+  BOOST_AUTO_TEST_CASE(reinitialize){
+    init();
+    BOOST_REQUIRE(mQO);
+    init();
+    BOOST_CHECK(!mQO);
+    BOOST_CHECK_EQUAL(std::string("History already initialized"), mStatus.getValue());
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(HISTORY_DeviceTests)
+
+  BOOST_AUTO_TEST_CASE(deleteDeviceWithStoppedHistory){
+    CDevice *device = new CDevice(&scmDeviceSpec, CStringDictionary::scm_nInvalidStringId, 0, 0);
+    device->changeFBExecutionState(cg_nMGM_CMD_Reset);
+    CResource *resource = static_cast<CResource*>(CTypeLib::createFB(g_nStringIdEMB_RES, g_nStringIdEMB_RES, device));
+    BOOST_REQUIRE(0 != resource);
+    device->addFB(resource);
+    device->startDevice();
+
+    CFunctionBlock *history = CTypeLib::createFB(CStringDictionary::getInstance().insert("DeviceHistory"), g_nStringIdHISTORY,
+        resource);
+    BOOST_REQUIRE(0 != history);
+    resource->addFB(history);
+    history->changeFBExecutionState(cg_nMGM_CMD_Start);
+    *static_cast<CIEC_BOOL*>(history->getDataInput(g_nStringIdQI)) = true;
+    SEventEntry entry(history, 0);
+    resource->getResourceEventExecution()->startEventChain(&entry);
+    do{
+      CThread::sleepThread(1);
+    } while(resource->getResourceEventExecution()->isProcessingEvents());
+    BOOST_REQUIRE(static_cast<bool>(*static_cast<CIEC_BOOL*>(history->getDataOutput(g_nStringIdQO))));
+    BOOST_CHECK(0 != device->getHistoryStore().getMemoryUsed());
+
+    //a stopped FB is not killed on shutdown, so it still holds its buffer when the device is deleted
+    device->changeFBExecutionState(cg_nMGM_CMD_Stop);
+    BOOST_CHECK_EQUAL(CFunctionBlock::e_STOPPED, history->getState());
+    delete device;
+  }
+
+BOOST_AUTO_TEST_SUITE_END()